@@ -0,0 +1,98 @@
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/AttributeDictionary.hpp"
+#include "SUAPI-CppWrapper/model/AttributeSnapshot.hpp"
+#include "SUAPI-CppWrapper/model/TypedValue.hpp"
+
+namespace {
+
+std::vector<std::string> attribute_keys(int64_t count) {
+  std::vector<std::string> keys;
+  for (int64_t i = 0; i < count; ++i) {
+    keys.push_back("attribute_" + std::to_string(i));
+  }
+  return keys;
+}
+
+CW::AttributeDictionary make_dictionary(const std::vector<std::string>& keys) {
+  CW::AttributeDictionary dict("Benchmark");
+  CW::AttributeSnapshot attributes;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    attributes.set(keys[i], CW::AttributeValue().double_value(double(i)));
+  }
+  dict.set_attributes(attributes);
+  return dict;
+}
+
+} // namespace
+
+
+static void BM_AttributeDictionary_GetValue(benchmark::State& state) {
+  CW::initialize();
+  const std::vector<std::string> keys = attribute_keys(state.range(0));
+  CW::AttributeDictionary dict = make_dictionary(keys);
+  for (auto _ : state) {
+    double total = 0.0;
+    for (const std::string& key : keys) {
+      total += dict.get_value(key).double_value();
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_AttributeDictionary_GetValue)->Arg(24);
+
+
+static void BM_AttributeDictionary_Snapshot(benchmark::State& state) {
+  CW::initialize();
+  const std::vector<std::string> keys = attribute_keys(state.range(0));
+  CW::AttributeDictionary dict = make_dictionary(keys);
+  CW::AttributeSnapshot attributes;
+  for (auto _ : state) {
+    dict.snapshot(attributes);
+    double total = 0.0;
+    for (const std::string& key : keys) {
+      total += attributes.find(key)->double_value();
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_AttributeDictionary_Snapshot)->Arg(24);
+
+
+static void BM_AttributeDictionary_SetAttribute(benchmark::State& state) {
+  CW::initialize();
+  const std::vector<std::string> keys = attribute_keys(state.range(0));
+  CW::AttributeDictionary dict("Benchmark");
+  for (auto _ : state) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      CW::TypedValue value;
+      value.double_value(double(i));
+      dict.set_attribute(keys[i], value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_AttributeDictionary_SetAttribute)->Arg(24);
+
+
+static void BM_AttributeDictionary_SetAttributes(benchmark::State& state) {
+  CW::initialize();
+  const std::vector<std::string> keys = attribute_keys(state.range(0));
+  CW::AttributeDictionary dict("Benchmark");
+  CW::AttributeSnapshot attributes;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    attributes.set(keys[i], CW::AttributeValue().double_value(double(i)));
+  }
+  for (auto _ : state) {
+    dict.set_attributes(attributes);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_AttributeDictionary_SetAttributes)->Arg(24);
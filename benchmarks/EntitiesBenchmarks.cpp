@@ -0,0 +1,151 @@
+#include "benchmark/benchmark.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/FrozenModel.hpp"
+#include "SUAPI-CppWrapper/model/Loop.hpp"
+#include "SUAPI-CppWrapper/model/MeshSnapshot.hpp"
+#include "SUAPI-CppWrapper/model/ModelCache.hpp"
+
+namespace {
+
+/**
+* Adds a grid of separate square faces to the model.
+*/
+void add_grid(CW::Model& model, size_t size) {
+  CW::Entities entities = model.entities();
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      std::vector<CW::Point3D> points = {
+        CW::Point3D(2.0 * i, 2.0 * j, 0.0),
+        CW::Point3D(2.0 * i + 1.0, 2.0 * j, 0.0),
+        CW::Point3D(2.0 * i + 1.0, 2.0 * j + 1.0, 0.0),
+        CW::Point3D(2.0 * i, 2.0 * j + 1.0, 0.0)
+      };
+      CW::Face face(points);
+      entities.add_face(face);
+    }
+  }
+}
+
+} // namespace
+
+
+static void BM_Entities_FacePoints(benchmark::State& state) {
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SUModelCreate(&su_model);
+  CW::Model model(su_model);
+  add_grid(model, state.range(0));
+  CW::Entities entities = model.entities();
+  for (auto _ : state) {
+    size_t num_points = 0;
+    for (const CW::Face& face : entities.faces()) {
+      num_points += face.outer_loop().points().size();
+    }
+    benchmark::DoNotOptimize(num_points);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_Entities_FacePoints)->Arg(32);
+
+
+static void BM_Entities_MeshSnapshot(benchmark::State& state) {
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SUModelCreate(&su_model);
+  CW::Model model(su_model);
+  add_grid(model, state.range(0));
+  CW::Entities entities = model.entities();
+  CW::MeshSnapshot snapshot;
+  for (auto _ : state) {
+    entities.mesh_snapshot(snapshot);
+    benchmark::DoNotOptimize(snapshot.positions.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_Entities_MeshSnapshot)->Arg(32);
+
+
+static void BM_FrozenModel_Freeze(benchmark::State& state) {
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SUModelCreate(&su_model);
+  CW::Model model(su_model);
+  add_grid(model, state.range(0));
+  size_t memory_size = 0;
+  for (auto _ : state) {
+    CW::FrozenModelPtr frozen = model.freeze();
+    memory_size = frozen->memory_size();
+    benchmark::DoNotOptimize(frozen.get());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+  state.counters["memory_size"] = double(memory_size);
+}
+BENCHMARK(BM_FrozenModel_Freeze)->Arg(32);
+
+
+static void BM_FrozenModel_FacePoints(benchmark::State& state) {
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SUModelCreate(&su_model);
+  CW::Model model(su_model);
+  add_grid(model, state.range(0));
+  CW::FrozenModelPtr frozen = model.freeze();
+  const CW::FrozenModel::Definition& root = frozen->definitions()[CW::FrozenModel::ROOT];
+  for (auto _ : state) {
+    size_t num_points = 0;
+    for (const CW::FrozenModel::Face& face : frozen->faces(root.faces)) {
+      num_points += frozen->loop_vertices(frozen->loops()[face.loops.begin]).size();
+    }
+    benchmark::DoNotOptimize(num_points);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_FrozenModel_FacePoints)->Arg(32);
+
+
+static void BM_ModelCache_Write(benchmark::State& state) {
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SUModelCreate(&su_model);
+  CW::Model model(su_model);
+  add_grid(model, state.range(0));
+  CW::FrozenModelPtr frozen = model.freeze();
+  const std::string path = "BM_ModelCache.cwcache";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CW::ModelCache::write(*frozen, 1, path));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_ModelCache_Write)->Arg(32);
+
+
+static void BM_ModelCache_Open(benchmark::State& state) {
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SUModelCreate(&su_model);
+  CW::Model model(su_model);
+  add_grid(model, state.range(0));
+  const std::string path = "BM_ModelCache.cwcache";
+  CW::ModelCache::write(*model.freeze(), 1, path);
+  size_t file_size = 0;
+  for (auto _ : state) {
+    CW::ModelCachePtr cache = CW::ModelCache::open(path, 1);
+    file_size = cache->file_size();
+    benchmark::DoNotOptimize(cache->faces().data());
+  }
+  state.counters["file_size"] = double(file_size);
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_ModelCache_Open)->Arg(32);
@@ -0,0 +1,207 @@
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <SketchUpAPI/geometry.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+
+namespace {
+
+/**
+* Replica of the previous CW::Point3D layout (wrapped struct, null flag and reference members), kept so the compact types can be compared against it.
+*/
+class LegacyPoint3D {
+  private:
+  SUPoint3D m_point;
+  bool null = false;
+
+  public:
+  double &x;
+  double &y;
+  double &z;
+
+  LegacyPoint3D(double x, double y, double z):
+    m_point(SUPoint3D{x, y, z}),
+    x(m_point.x),
+    y(m_point.y),
+    z(m_point.z)
+  {}
+
+  LegacyPoint3D(const LegacyPoint3D& other):
+    m_point(other.m_point),
+    null(other.null),
+    x(m_point.x),
+    y(m_point.y),
+    z(m_point.z)
+  {}
+
+  LegacyPoint3D &operator=(const LegacyPoint3D &other) {
+    x = other.x;
+    y = other.y;
+    z = other.z;
+    null = other.null;
+    return *this;
+  }
+
+  operator SUPoint3D() const { return m_point; }
+
+  LegacyPoint3D operator+(const LegacyPoint3D &other) const {
+    return LegacyPoint3D(x + other.x, y + other.y, z + other.z);
+  }
+};
+
+template <class PointType>
+std::vector<PointType> make_points(size_t count) {
+  std::vector<PointType> points;
+  points.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    points.push_back(PointType(double(i), double(i) * 0.5, double(i) * 0.25));
+  }
+  return points;
+}
+
+} // namespace
+
+
+static void BM_LegacyPoint3D_CopyToSUPoint3D(benchmark::State& state) {
+  const std::vector<LegacyPoint3D> points = make_points<LegacyPoint3D>(state.range(0));
+  std::vector<SUPoint3D> su_points(points.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      su_points[i] = points[i];
+    }
+    benchmark::DoNotOptimize(su_points.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * points.size() * sizeof(SUPoint3D));
+}
+BENCHMARK(BM_LegacyPoint3D_CopyToSUPoint3D)->Arg(1 << 16)->Arg(1 << 20);
+
+
+static void BM_Point3D_CopyToSUPoint3D(benchmark::State& state) {
+  const std::vector<CW::Point3D> points = make_points<CW::Point3D>(state.range(0));
+  std::vector<SUPoint3D> su_points(points.size());
+  for (auto _ : state) {
+    std::memcpy(su_points.data(), points.data(), points.size() * sizeof(SUPoint3D));
+    benchmark::DoNotOptimize(su_points.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * points.size() * sizeof(SUPoint3D));
+}
+BENCHMARK(BM_Point3D_CopyToSUPoint3D)->Arg(1 << 16)->Arg(1 << 20);
+
+
+static void BM_LegacyPoint3D_VectorCopy(benchmark::State& state) {
+  const std::vector<LegacyPoint3D> points = make_points<LegacyPoint3D>(state.range(0));
+  for (auto _ : state) {
+    std::vector<LegacyPoint3D> copy(points);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_LegacyPoint3D_VectorCopy)->Arg(1 << 16)->Arg(1 << 20);
+
+
+static void BM_Point3D_VectorCopy(benchmark::State& state) {
+  const std::vector<CW::Point3D> points = make_points<CW::Point3D>(state.range(0));
+  for (auto _ : state) {
+    std::vector<CW::Point3D> copy(points);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_Point3D_VectorCopy)->Arg(1 << 16)->Arg(1 << 20);
+
+
+static void BM_LegacyPoint3D_Sum(benchmark::State& state) {
+  const std::vector<LegacyPoint3D> points = make_points<LegacyPoint3D>(state.range(0));
+  for (auto _ : state) {
+    LegacyPoint3D sum(0.0, 0.0, 0.0);
+    for (const LegacyPoint3D& point : points) {
+      sum = sum + point;
+    }
+    benchmark::DoNotOptimize(sum.x);
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_LegacyPoint3D_Sum)->Arg(1 << 16);
+
+
+static void BM_Point3D_Sum(benchmark::State& state) {
+  const std::vector<CW::Point3D> points = make_points<CW::Point3D>(state.range(0));
+  for (auto _ : state) {
+    CW::Point3D sum(0.0, 0.0, 0.0);
+    for (const CW::Point3D& point : points) {
+      sum = sum + point;
+    }
+    benchmark::DoNotOptimize(sum.x);
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_Point3D_Sum)->Arg(1 << 16);
+
+
+static void BM_Vector3D_CrossDot(benchmark::State& state) {
+  const std::vector<CW::Vector3D> vectors = make_points<CW::Vector3D>(state.range(0));
+  for (auto _ : state) {
+    double total = 0.0;
+    for (size_t i = 1; i < vectors.size(); ++i) {
+      total += vectors[i].cross(vectors[i-1]).dot(vectors[i]);
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * vectors.size());
+}
+BENCHMARK(BM_Vector3D_CrossDot)->Arg(1 << 16);
+
+
+static void BM_Vector3D_Unit(benchmark::State& state) {
+  const std::vector<CW::Vector3D> vectors = make_points<CW::Vector3D>(state.range(0));
+  for (auto _ : state) {
+    CW::Vector3D sum(0.0, 0.0, 0.0);
+    for (size_t i = 1; i < vectors.size(); ++i) {
+      sum = sum + vectors[i].unit();
+    }
+    benchmark::DoNotOptimize(sum.x);
+  }
+  state.SetItemsProcessed(state.iterations() * vectors.size());
+}
+BENCHMARK(BM_Vector3D_Unit)->Arg(1 << 16);
+
+
+static void BM_Line3D_ClosestPoints(benchmark::State& state) {
+  std::vector<CW::Line3D> lines;
+  lines.reserve(state.range(0));
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    lines.push_back(CW::Line3D(CW::Point3D(double(i), 0.0, 1.0), CW::Vector3D(1.0, double(i % 7) + 1.0, 0.5)));
+  }
+  const CW::Line3D axis(CW::Point3D(0.0, 0.0, 0.0), CW::Vector3D(0.0, 0.0, 1.0));
+  for (auto _ : state) {
+    double total = 0.0;
+    for (const CW::Line3D& line : lines) {
+      total += axis.closest_points(line).first.z;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_Line3D_ClosestPoints)->Arg(1 << 12);
+
+
+static void BM_Plane3D_PlaneFromLoop(benchmark::State& state) {
+  // A regular polygon, tilted out of the axis planes.
+  std::vector<CW::Point3D> loop;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    const double angle = 2.0 * 3.14159265358979 * double(i) / double(state.range(0));
+    loop.push_back(CW::Point3D(std::cos(angle), std::sin(angle), 0.5 * std::cos(angle)));
+  }
+  for (auto _ : state) {
+    CW::Plane3D plane = CW::Plane3D::plane_from_loop(loop);
+    benchmark::DoNotOptimize(plane.d);
+  }
+  state.SetItemsProcessed(state.iterations() * loop.size());
+}
+BENCHMARK(BM_Plane3D_PlaneFromLoop)->Arg(4)->Arg(64)->Arg(1024);
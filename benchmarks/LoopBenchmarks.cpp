@@ -0,0 +1,65 @@
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/model/Loop.hpp"
+#include "SUAPI-CppWrapper/model/PreparedLoop.hpp"
+
+namespace {
+
+/**
+* Returns a wall shaped loop on the plane y = 0 with a notch cut into its top edge for each of num_notches windows.
+*/
+std::vector<CW::Point3D> notched_wall(size_t num_notches) {
+  std::vector<CW::Point3D> points;
+  points.push_back(CW::Point3D(0.0, 0.0, 0.0));
+  points.push_back(CW::Point3D(4.0 * num_notches, 0.0, 0.0));
+  points.push_back(CW::Point3D(4.0 * num_notches, 0.0, 100.0));
+  for (size_t i = num_notches; i-- > 0;) {
+    points.push_back(CW::Point3D(4.0 * i + 3.0, 0.0, 100.0));
+    points.push_back(CW::Point3D(4.0 * i + 3.0, 0.0, 50.0));
+    points.push_back(CW::Point3D(4.0 * i + 1.0, 0.0, 50.0));
+    points.push_back(CW::Point3D(4.0 * i + 1.0, 0.0, 100.0));
+  }
+  points.push_back(CW::Point3D(0.0, 0.0, 100.0));
+  return points;
+}
+
+std::vector<CW::Point3D> query_points(size_t num_notches, size_t count) {
+  std::vector<CW::Point3D> points;
+  points.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    points.push_back(CW::Point3D(std::fmod(0.37 * i, 4.0 * num_notches), 0.0, double(i % 97) + 0.5));
+  }
+  return points;
+}
+
+} // namespace
+
+
+static void BM_Loop_ClassifyPoint(benchmark::State& state) {
+  const std::vector<CW::Point3D> loop = notched_wall(state.range(0));
+  const std::vector<CW::Point3D> points = query_points(state.range(0), 1024);
+  for (auto _ : state) {
+    for (const CW::Point3D& point : points) {
+      benchmark::DoNotOptimize(CW::Loop::classify_point(loop, point));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_Loop_ClassifyPoint)->Arg(4)->Arg(64);
+
+
+static void BM_PreparedLoop_ClassifyPoint(benchmark::State& state) {
+  const CW::PreparedLoop loop(notched_wall(state.range(0)));
+  const std::vector<CW::Point3D> points = query_points(state.range(0), 1024);
+  for (auto _ : state) {
+    for (const CW::Point3D& point : points) {
+      benchmark::DoNotOptimize(loop.classify_point(point));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PreparedLoop_ClassifyPoint)->Arg(4)->Arg(64)->Arg(1024);
@@ -0,0 +1,130 @@
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+#include "SUAPI-CppWrapper/PixelConversion.hpp"
+
+namespace {
+
+const int64_t kPixels = 1 << 22; // a 2048 x 2048 texture
+
+std::vector<SUByte> make_bytes(size_t count) {
+  std::vector<SUByte> bytes(count);
+  for (size_t i = 0; i < count; ++i) {
+    bytes[i] = static_cast<SUByte>(i * 37 + 11);
+  }
+  return bytes;
+}
+
+} // namespace
+
+
+static void BM_Pixels_LoopBgraToRgba(benchmark::State& state) {
+  const std::vector<SUByte> in = make_bytes(state.range(0) * 4);
+  std::vector<SUByte> out(in.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < in.size(); i += 4) {
+      out[i] = in[i + 2];
+      out[i + 1] = in[i + 1];
+      out[i + 2] = in[i];
+      out[i + 3] = in[i + 3];
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * in.size());
+}
+BENCHMARK(BM_Pixels_LoopBgraToRgba)->Arg(kPixels);
+
+
+static void BM_Pixels_BgraToRgba(benchmark::State& state) {
+  const std::vector<SUByte> in = make_bytes(state.range(0) * 4);
+  std::vector<SUByte> out(in.size());
+  for (auto _ : state) {
+    CW::bgra_to_rgba(in, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * in.size());
+}
+BENCHMARK(BM_Pixels_BgraToRgba)->Arg(kPixels);
+
+
+static void BM_Pixels_LoopBgrToRgba(benchmark::State& state) {
+  const std::vector<SUByte> in = make_bytes(state.range(0) * 3);
+  std::vector<SUByte> out(state.range(0) * 4);
+  for (auto _ : state) {
+    for (size_t i = 0, j = 0; i < in.size(); i += 3, j += 4) {
+      out[j] = in[i + 2];
+      out[j + 1] = in[i + 1];
+      out[j + 2] = in[i];
+      out[j + 3] = 255;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_Pixels_LoopBgrToRgba)->Arg(kPixels);
+
+
+static void BM_Pixels_BgrToRgba(benchmark::State& state) {
+  const std::vector<SUByte> in = make_bytes(state.range(0) * 3);
+  std::vector<SUByte> out(state.range(0) * 4);
+  for (auto _ : state) {
+    CW::bgr_to_rgba(in, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_Pixels_BgrToRgba)->Arg(kPixels);
+
+
+static void BM_Pixels_LoopPremultiply(benchmark::State& state) {
+  const std::vector<SUByte> original = make_bytes(state.range(0) * 4);
+  std::vector<SUByte> pixels(original.size());
+  for (auto _ : state) {
+    pixels = original;
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+      const unsigned alpha = pixels[i + 3];
+      pixels[i] = SUByte((pixels[i] * alpha + 127) / 255);
+      pixels[i + 1] = SUByte((pixels[i + 1] * alpha + 127) / 255);
+      pixels[i + 2] = SUByte((pixels[i + 2] * alpha + 127) / 255);
+    }
+    benchmark::DoNotOptimize(pixels.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * pixels.size());
+}
+BENCHMARK(BM_Pixels_LoopPremultiply)->Arg(kPixels);
+
+
+static void BM_Pixels_Premultiply(benchmark::State& state) {
+  const std::vector<SUByte> original = make_bytes(state.range(0) * 4);
+  std::vector<SUByte> pixels(original.size());
+  for (auto _ : state) {
+    // Includes the same copy as the loop benchmark, so the two are comparable.
+    pixels = original;
+    CW::premultiply_alpha(pixels);
+    benchmark::DoNotOptimize(pixels.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * pixels.size());
+}
+BENCHMARK(BM_Pixels_Premultiply)->Arg(kPixels);
+
+
+static void BM_Pixels_StripRowPadding(benchmark::State& state) {
+  const size_t width = 2047; // 24 bit rows of an odd width are padded to 4 bytes
+  const size_t padding = (4 - (width * 3) % 4) % 4;
+  const std::vector<SUByte> in = make_bytes((width * 3 + padding) * width);
+  std::vector<SUByte> out(width * 3 * width);
+  for (auto _ : state) {
+    CW::strip_row_padding(in, out, width, width, 3, padding);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_Pixels_StripRowPadding);
@@ -0,0 +1,74 @@
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+
+namespace {
+
+std::vector<std::string> benchmark_strings(size_t count, size_t length) {
+  std::vector<std::string> strings;
+  strings.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    strings.push_back(std::string(length, char('a' + i % 26)) + std::to_string(i));
+  }
+  return strings;
+}
+
+} // namespace
+
+
+static void BM_String_RoundTrip(benchmark::State& state) {
+  CW::initialize();
+  const std::vector<std::string> strings = benchmark_strings(256, state.range(0));
+  for (auto _ : state) {
+    size_t total = 0;
+    for (const std::string& string : strings) {
+      CW::String su_string(string);
+      total += su_string.std_string().size();
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+BENCHMARK(BM_String_RoundTrip)->Arg(8)->Arg(256);
+
+
+static void BM_String_View(benchmark::State& state) {
+  CW::initialize();
+  const std::vector<std::string> strings = benchmark_strings(256, state.range(0));
+  std::vector<CW::String> su_strings(strings.begin(), strings.end());
+  for (auto _ : state) {
+    size_t total = 0;
+    for (const CW::String& su_string : su_strings) {
+      total += su_string.view().size();
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * su_strings.size());
+}
+BENCHMARK(BM_String_View)->Arg(8)->Arg(256);
+
+
+static void BM_String_Copy(benchmark::State& state) {
+  CW::initialize();
+  const CW::String su_string(std::string(state.range(0), 'x'));
+  for (auto _ : state) {
+    CW::String copy(su_string);
+    benchmark::DoNotOptimize(copy.ref());
+  }
+}
+BENCHMARK(BM_String_Copy)->Arg(8)->Arg(256);
+
+
+static void BM_String_Compare(benchmark::State& state) {
+  CW::initialize();
+  const CW::String lhs(std::string(state.range(0), 'x'));
+  const CW::String rhs(std::string(state.range(0), 'x'));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs == rhs);
+  }
+}
+BENCHMARK(BM_String_Compare)->Arg(8)->Arg(256);
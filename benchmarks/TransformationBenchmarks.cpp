@@ -0,0 +1,109 @@
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/geometry/point3d.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Transformation.hpp"
+
+namespace {
+
+CW::Transformation benchmark_transformation() {
+  SUTransformation transformation = {
+    0.0, 1.0, 0.0, 0.0,
+    -2.0, 0.0, 0.0, 0.0,
+    0.0, 0.0, 3.0, 0.0,
+    10.0, 20.0, 30.0, 1.0
+  };
+  return CW::Transformation(transformation);
+}
+
+std::vector<SUPoint3D> benchmark_points(size_t count) {
+  std::vector<SUPoint3D> points(count);
+  for (size_t i = 0; i < count; ++i) {
+    points[i] = SUPoint3D{double(i), double(i) * 0.5, double(i) * 0.25};
+  }
+  return points;
+}
+
+} // namespace
+
+
+static void BM_Transformation_PointOperator(benchmark::State& state) {
+  const CW::Transformation transformation = benchmark_transformation();
+  const std::vector<SUPoint3D> points = benchmark_points(state.range(0));
+  std::vector<SUPoint3D> transformed(points.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      transformed[i] = transformation * CW::Point3D(points[i]);
+    }
+    benchmark::DoNotOptimize(transformed.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_Transformation_PointOperator)->Arg(1 << 16);
+
+
+static void BM_Transformation_ApplyPoints(benchmark::State& state) {
+  const CW::Transformation transformation = benchmark_transformation();
+  const std::vector<SUPoint3D> points = benchmark_points(state.range(0));
+  std::vector<SUPoint3D> transformed(points.size());
+  for (auto _ : state) {
+    transformation.apply(points.data(), transformed.data(), points.size());
+    benchmark::DoNotOptimize(transformed.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_Transformation_ApplyPoints)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+
+static void BM_Transformation_ApplyVectors(benchmark::State& state) {
+  const CW::Transformation transformation = benchmark_transformation();
+  const std::vector<SUPoint3D> points = benchmark_points(state.range(0));
+  std::vector<SUVector3D> vectors(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    vectors[i] = SUVector3D{points[i].x, points[i].y, points[i].z};
+  }
+  for (auto _ : state) {
+    transformation.apply(vectors.data(), vectors.data(), vectors.size());
+    benchmark::DoNotOptimize(vectors.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vectors.size());
+}
+BENCHMARK(BM_Transformation_ApplyVectors)->Arg(1 << 16);
+
+
+static void BM_Transformation_ApplyNormals(benchmark::State& state) {
+  const CW::Transformation transformation = benchmark_transformation();
+  std::vector<SUVector3D> normals(state.range(0), SUVector3D{0.0, 0.6, 0.8});
+  std::vector<SUVector3D> transformed(normals.size());
+  for (auto _ : state) {
+    transformation.apply_normals(normals.data(), transformed.data(), normals.size());
+    benchmark::DoNotOptimize(transformed.data());
+  }
+  state.SetItemsProcessed(state.iterations() * normals.size());
+}
+BENCHMARK(BM_Transformation_ApplyNormals)->Arg(1 << 16);
+
+
+static void BM_Transformation_Multiply(benchmark::State& state) {
+  CW::Transformation transformation = benchmark_transformation();
+  const CW::Transformation step(CW::Point3D(1.0, 2.0, 3.0), CW::Vector3D(0.0, 0.0, 1.0), 0.1);
+  for (auto _ : state) {
+    CW::Transformation composed = transformation * step;
+    benchmark::DoNotOptimize(composed);
+  }
+}
+BENCHMARK(BM_Transformation_Multiply);
+
+
+static void BM_Transformation_Inverse(benchmark::State& state) {
+  const CW::Transformation transformation = benchmark_transformation();
+  for (auto _ : state) {
+    CW::Transformation inverse = transformation.inverse();
+    benchmark::DoNotOptimize(inverse);
+  }
+}
+BENCHMARK(BM_Transformation_Inverse);
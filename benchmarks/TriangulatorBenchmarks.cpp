@@ -0,0 +1,65 @@
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Triangulator.hpp"
+
+namespace {
+
+/**
+* Returns a wall shaped polygon of the given width on the plane y = 0, with a window hole in each unit of its width.
+*/
+std::vector<std::vector<CW::Point3D>> wall_with_windows(size_t num_windows) {
+  std::vector<std::vector<CW::Point3D>> loops;
+  loops.push_back({
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(4.0 * num_windows, 0.0, 0.0),
+    CW::Point3D(4.0 * num_windows, 0.0, 3.0),
+    CW::Point3D(0.0, 0.0, 3.0)
+  });
+  for (size_t i = 0; i < num_windows; ++i) {
+    loops.push_back({
+      CW::Point3D(4.0 * i + 1.0, 0.0, 1.0),
+      CW::Point3D(4.0 * i + 1.0, 0.0, 2.0),
+      CW::Point3D(4.0 * i + 3.0, 0.0, 2.0),
+      CW::Point3D(4.0 * i + 3.0, 0.0, 1.0)
+    });
+  }
+  return loops;
+}
+
+} // namespace
+
+
+static void BM_Triangulator_Quads(benchmark::State& state) {
+  const std::vector<std::vector<CW::Point3D>> quad = wall_with_windows(0);
+  const CW::Vector3D normal(0.0, -1.0, 0.0);
+  CW::Triangulator triangulator;
+  CW::TriangleMesh mesh;
+  for (auto _ : state) {
+    mesh.clear();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      triangulator.triangulate(quad, normal, mesh);
+    }
+    benchmark::DoNotOptimize(mesh.indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Triangulator_Quads)->Arg(1 << 12);
+
+
+static void BM_Triangulator_Holes(benchmark::State& state) {
+  const std::vector<std::vector<CW::Point3D>> wall = wall_with_windows(state.range(0));
+  const CW::Vector3D normal(0.0, -1.0, 0.0);
+  CW::Triangulator triangulator;
+  CW::TriangleMesh mesh;
+  for (auto _ : state) {
+    mesh.clear();
+    triangulator.triangulate(wall, normal, mesh);
+    benchmark::DoNotOptimize(mesh.indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * mesh.num_triangles());
+}
+BENCHMARK(BM_Triangulator_Holes)->Arg(4)->Arg(64);
@@ -0,0 +1,66 @@
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/TypedValue.hpp"
+
+
+static void BM_TypedValue_Double(benchmark::State& state) {
+  CW::initialize();
+  CW::TypedValue typed_value;
+  double total = 0.0;
+  for (auto _ : state) {
+    typed_value.double_value(total + 1.0);
+    total = typed_value.double_value();
+  }
+  benchmark::DoNotOptimize(total);
+}
+BENCHMARK(BM_TypedValue_Double);
+
+
+static void BM_TypedValue_String(benchmark::State& state) {
+  CW::initialize();
+  const std::string string(state.range(0), 'x');
+  for (auto _ : state) {
+    CW::TypedValue typed_value(string);
+    std::string value = typed_value.string_value();
+    benchmark::DoNotOptimize(value.data());
+  }
+}
+BENCHMARK(BM_TypedValue_String)->Arg(8)->Arg(256);
+
+
+static void BM_TypedValue_Vector(benchmark::State& state) {
+  CW::initialize();
+  CW::TypedValue typed_value;
+  const CW::Vector3D vector(1.0, 2.0, 3.0);
+  for (auto _ : state) {
+    typed_value.vector_value(vector);
+    CW::Vector3D value = typed_value.vector_value();
+    benchmark::DoNotOptimize(value.x);
+  }
+}
+BENCHMARK(BM_TypedValue_Vector);
+
+
+static void BM_TypedValue_Array(benchmark::State& state) {
+  CW::initialize();
+  std::vector<CW::TypedValue> values;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    CW::TypedValue value;
+    value.int32_value(static_cast<int32_t>(i));
+    values.push_back(value);
+  }
+  for (auto _ : state) {
+    CW::TypedValue typed_value;
+    typed_value.typed_value_array(values);
+    std::vector<CW::TypedValue> array = typed_value.typed_value_array();
+    benchmark::DoNotOptimize(array.data());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_TypedValue_Array)->Arg(16)->Arg(256);
@@ -0,0 +1,50 @@
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/VertexWelder.hpp"
+
+namespace {
+
+/**
+* The loop points of an n x n grid of quads, as a tessellated import passes them: each interior corner appears four times.
+*/
+std::vector<CW::Point3D> grid_loop_points(int64_t n) {
+  std::vector<CW::Point3D> points;
+  points.reserve(n * n * 4);
+  for (int64_t row = 0; row < n; ++row) {
+    for (int64_t column = 0; column < n; ++column) {
+      const double x = double(column) * 0.25;
+      const double y = double(row) * 0.25;
+      points.push_back(CW::Point3D(x, y, 0.0));
+      points.push_back(CW::Point3D(x + 0.25, y, 0.0));
+      points.push_back(CW::Point3D(x + 0.25, y + 0.25, 0.0));
+      points.push_back(CW::Point3D(x, y + 0.25, 0.0));
+    }
+  }
+  return points;
+}
+
+} // namespace
+
+
+static void BM_VertexWelder_WeldGrid(benchmark::State& state) {
+  const std::vector<CW::Point3D> points = grid_loop_points(state.range(0));
+  CW::VertexWelder welder;
+  size_t unique_points = 0;
+  for (auto _ : state) {
+    welder.clear();
+    welder.reserve(points.size());
+    unique_points = 0;
+    for (const CW::Point3D& point : points) {
+      if (welder.weld(point, unique_points) == unique_points) {
+        ++unique_points;
+      }
+    }
+    benchmark::DoNotOptimize(unique_points);
+  }
+  state.counters["unique_ratio"] = double(unique_points) / double(points.size());
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_VertexWelder_WeldGrid)->Arg(64)->Arg(512);
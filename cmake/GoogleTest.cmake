@@ -1,4 +1,13 @@
-include_directories(SYSTEM "${PROJECT_SOURCE_DIR}/third-party/googletest/googletest/include")
-include_directories("${PROJECT_SOURCE_DIR}/third-party/googletest/googletest")
+if ( EXISTS "${GOOGLETEST_PATH}/src/gtest-all.cc" )
+  include_directories(SYSTEM "${PROJECT_SOURCE_DIR}/third-party/googletest/googletest/include")
+  include_directories("${PROJECT_SOURCE_DIR}/third-party/googletest/googletest")
 
-add_library(GoogleTest STATIC third-party/googletest/googletest/src/gtest-all.cc)
+  add_library(GoogleTest STATIC third-party/googletest/googletest/src/gtest-all.cc)
+else()
+  # Without the googletest submodule, use the GoogleTest installed on the system.
+  find_package(GTest REQUIRED)
+  find_package(Threads REQUIRED)
+
+  add_library(GoogleTest INTERFACE)
+  target_link_libraries(GoogleTest INTERFACE GTest::GTest Threads::Threads)
+endif()
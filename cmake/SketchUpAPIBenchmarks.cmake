@@ -0,0 +1,51 @@
+set(CPP_API_BENCHMARKS_PATH "${PROJECT_SOURCE_DIR}/benchmarks")
+
+# The benchmarks are optional, and only built when Google Benchmark is available.
+find_package(benchmark QUIET)
+
+if ( benchmark_FOUND )
+  # Benchmarks of code that does not call the SketchUp API. They are built with
+  # the wrapper sources they measure, so they also run without the API binaries.
+  set(BENCHMARKS_GEOMETRY_SOURCES
+    "${CPP_API_BENCHMARKS_PATH}/GeometryBenchmarks.cpp"
+    "${CPP_API_BENCHMARKS_PATH}/PixelConversionBenchmarks.cpp"
+    "${CPP_API_BENCHMARKS_PATH}/TriangulatorBenchmarks.cpp"
+    "${CPP_API_BENCHMARKS_PATH}/VertexWelderBenchmarks.cpp"
+  )
+  set(CPP_API_GEOMETRY_SOURCES
+    "${CPP_API_SOURCE_PATH}/${CPP_API_BASENAME}/Geometry.cpp"
+    "${CPP_API_SOURCE_PATH}/${CPP_API_BASENAME}/PixelConversion.cpp"
+    "${CPP_API_SOURCE_PATH}/${CPP_API_BASENAME}/Triangulator.cpp"
+    "${CPP_API_SOURCE_PATH}/${CPP_API_BASENAME}/VertexWelder.cpp"
+  )
+
+  if ( SLAPI_AVAILABLE )
+    file(GLOB_RECURSE BENCHMARKS_SOURCES ${CPP_API_BENCHMARKS_PATH}/*.cpp)
+
+    add_executable(SketchUpAPIBenchmarks ${BENCHMARKS_SOURCES})
+
+    target_link_libraries(SketchUpAPIBenchmarks benchmark::benchmark benchmark::benchmark_main SketchUpAPICpp ${SLAPI_LIB})
+
+    if ( MSVC AND NOT CPP_API_MEMORY_BACKEND )
+      add_custom_command(TARGET SketchUpAPIBenchmarks POST_BUILD
+        COMMAND xcopy \"${SLAPI_BINARIES_PATH}\\sketchup\\x64\\SketchUpAPI.dll\" $(OutputPath) /D /Y
+        COMMAND xcopy \"${SLAPI_BINARIES_PATH}\\sketchup\\x64\\SketchUpCommonPreferences.dll\" $(OutputPath) /D /Y
+      )
+    endif()
+  else()
+    message(STATUS "SketchUp API not available - SketchUpAPIBenchmarks will only include the geometry benchmarks")
+
+    add_executable(SketchUpAPIBenchmarks ${BENCHMARKS_GEOMETRY_SOURCES} ${CPP_API_GEOMETRY_SOURCES})
+
+    target_include_directories(SketchUpAPIBenchmarks SYSTEM PRIVATE "${SLAPI_INCLUDE_PATH}")
+    target_include_directories(SketchUpAPIBenchmarks PRIVATE "${CPP_API_INCLUDE_PATH}")
+    target_link_libraries(SketchUpAPIBenchmarks benchmark::benchmark benchmark::benchmark_main)
+  endif()
+
+  source_group(
+    "Benchmarks"
+    REGULAR_EXPRESSION "${CPP_API_BENCHMARKS_PATH}/[^\//]+Benchmarks.cpp"
+  )
+else()
+  message(STATUS "Google Benchmark not found - SketchUpAPIBenchmarks will not be built")
+endif()
@@ -3,7 +3,7 @@ include_directories(SYSTEM "${SLAPI_INCLUDE_PATH}")
 include_directories("${CPP_API_INCLUDE_PATH}")
 
 file(GLOB_RECURSE CPP_API_HEADERS ${CPP_API_INCLUDE_PATH}/*.hpp)
-file(GLOB_RECURSE CPP_API_SOURCES ${CPP_API_SOURCE_PATH}/*.cpp)
+file(GLOB_RECURSE CPP_API_SOURCES ${CPP_API_SOURCE_PATH}/${CPP_API_BASENAME}/*.cpp)
 
 add_library(SketchUpAPICpp STATIC ${CPP_API_HEADERS} ${CPP_API_SOURCES})
 
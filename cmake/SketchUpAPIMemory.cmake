@@ -0,0 +1,26 @@
+# In-memory implementation of the SketchUp C API, linked in place of the SDK
+# binaries. It only implements the functions that the wrapper calls.
+set(CPP_API_MEMORY_BASENAME "SketchUpAPIMemory")
+
+file(GLOB CPP_API_MEMORY_HEADERS ${CPP_API_SOURCE_PATH}/${CPP_API_MEMORY_BASENAME}/*.hpp)
+file(GLOB CPP_API_MEMORY_SOURCES ${CPP_API_SOURCE_PATH}/${CPP_API_MEMORY_BASENAME}/*.cpp)
+
+add_library(SketchUpAPIMemory STATIC ${CPP_API_MEMORY_HEADERS} ${CPP_API_MEMORY_SOURCES})
+
+target_include_directories(SketchUpAPIMemory SYSTEM PRIVATE "${SLAPI_INCLUDE_PATH}")
+
+if ( MSVC )
+  target_compile_options(SketchUpAPIMemory PRIVATE "/W3")
+  target_compile_options(SketchUpAPIMemory PRIVATE "/WX")
+  target_compile_options(SketchUpAPIMemory PRIVATE "/MP")
+else()
+  target_compile_options(SketchUpAPIMemory PRIVATE "-Wall")
+  target_compile_options(SketchUpAPIMemory PRIVATE "-Wno-missing-braces")
+  target_compile_options(SketchUpAPIMemory PRIVATE "-Werror")
+endif()
+
+source_group(
+  TREE "${CPP_API_SOURCE_PATH}/${CPP_API_MEMORY_BASENAME}"
+  PREFIX "Source Files"
+  FILES ${CPP_API_MEMORY_HEADERS} ${CPP_API_MEMORY_SOURCES}
+)
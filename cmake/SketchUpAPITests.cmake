@@ -20,6 +20,13 @@ target_link_libraries(SketchUpAPITests GoogleTest SketchUpAPICpp ${SLAPI_LIB})
 
 set_target_properties(${SketchUpAPITests} PROPERTIES COMPILE_FLAGS "-Wall")
 
+if ( CPP_API_MEMORY_BACKEND )
+  # The in-memory backend can not open model files.
+  add_test(NAME SketchUpAPITests COMMAND SketchUpAPITests --gtest_filter=-TypedValue.get_mixed_array_items)
+else()
+  add_test(NAME SketchUpAPITests COMMAND SketchUpAPITests)
+endif()
+
 source_group(
   "Tests"
   REGULAR_EXPRESSION "${CPP_API_TESTS_PATH}/[^\//]+Tests.cpp"
@@ -31,7 +38,7 @@ source_group(
 )
 
 # TODO(thomthom): Set up per-platform post-build commands.
-if ( MSVC )
+if ( MSVC AND NOT CPP_API_MEMORY_BACKEND )
   add_custom_command(TARGET SketchUpAPITests POST_BUILD
     # xcopy seem to require at least one \ slash in the source path, otherwise it
     # appear to fail.
@@ -35,6 +35,9 @@
 #define Geometry_h
 
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <type_traits>
 #include <vector>
 
 #include <SketchUpAPI/geometry.h>
@@ -109,17 +112,14 @@ class Point3D;
 * Initialisation:
 * - Vector3D(SUVector3D vec)
 * - Vector3D(double x, double y, double z)
+*
+* Vector3D has the same memory layout as SUVector3D and is trivially copyable, so arrays of Vector3D objects can be copied straight into SUVector3D buffers.  A null Vector3D is represented by a NaN x value.
 */
 class Vector3D {
-
-  protected:
-  SUVector3D m_vector;
-  bool null = false; // Invalid flag
-
   public:
-  double &x;
-  double &y;
-  double &z;
+  double x;
+  double y;
+  double z;
   constexpr static double EPSILON = 0.0005; // Sketchup Tolerance is 1/1000"
   
   Vector3D();
@@ -150,7 +150,7 @@ class Vector3D {
   operator SUVector3D() const;
   
   /**
-  * Pointer to internal SUVector3D object
+  * Pointer to this object as a SUVector3D object
   */
   operator const SUVector3D*() const;
 
@@ -159,15 +159,6 @@ class Vector3D {
   */
   operator Point3D() const;
   
-   /*
-  * Copy constructor
-  */
-  Vector3D(const Vector3D &vector);
-  
-  /**
-  * Copy assignment operator
-  */
-  Vector3D &operator=(const Vector3D &vector);
   Vector3D &operator=(const SUVector3D &vector);
 
   /**
@@ -259,19 +250,14 @@ class Vector3D {
 * 
 * Class methods are given to allow easy vector mathematics.
 *
-* Point3D inherits from Vector3D, as the concept of a point and a vector is interchangeable in vector mathematics.
+* Like Vector3D, Point3D has the same memory layout as SUPoint3D and is trivially copyable.  A null Point3D is represented by a NaN x value.
 */
 class Point3D {
-  private:
-  SUPoint3D m_point;
-  bool null = false; // Invalid flag
-  //constexpr static double EPSILON = 0.001; // Sketchup Tolerance is 1/1000"
-
   public:
+  double x;
+  double y;
+  double z;
   constexpr static double EPSILON = 0.0005; // Sketchup Tolerance is 1/1000"
-  double &x;
-  double &y;
-  double &z;
 
   /**
   * Invaid, or NULL Point3D objects can be simulated with this constructor.
@@ -304,20 +290,10 @@ class Point3D {
   */
   Point3D(double x, double y, double z);
   
-  /**
-  * Copy Constructor
-  */
-  Point3D(const Point3D& other);
-
   /**
   * Allows conversion from Vector3D
   */
   explicit Point3D( const Vector3D& vector);
-  
-  /**
-  * Copy assignment operator
-  */
-  Point3D &operator=(const Point3D &point);
 
   /*
   * Cast to SUPoint3D struct
@@ -378,18 +354,17 @@ class Line3D;
 * Plane3D class is analagous to SUPlane3D struct, and holds the same variables.
 * 
 * Class methods are included to allow easy vector mathematics.
+* A plane with a NaN a value, or with a zero normal, is null.
 */
 class Plane3D {
   private:
-  SUPlane3D m_plane;
-  bool null = false; // Invalid flag
   constexpr static double EPSILON = 0.0005; // Sketchup Tolerance is 1/1000"
 
   public:
-  double &a;
-  double &b;
-  double &c;
-  double &d;
+  double a;
+  double b;
+  double c;
+  double d;
 
   Plane3D();
   Plane3D(const SUPlane3D plane);
@@ -407,12 +382,6 @@ class Plane3D {
   Plane3D(const Vector3D& normal, const Point3D& point);
   Plane3D(const Point3D& point, const Vector3D& normal);
 
-   // Copy constructor
-  Plane3D(const Plane3D &plane);
-  
-  // Overload copy assignment operator
-  Plane3D &operator=(const Plane3D &plane);
-  
   /**
   * Implicit conversion to SUPlane3D
   */
@@ -640,5 +609,72 @@ class Line3D {
   
 };
 
+/**
+* Frequently used Vector3D and Point3D methods are defined inline, as they are called for every point in bulk geometry operations.
+*/
+inline Vector3D::Vector3D( double x, double y, double z):
+  x(x),
+  y(y),
+  z(z)
+{}
+
+inline bool Vector3D::operator!() const {
+  return std::isnan(x);
+}
+
+inline Vector3D Vector3D::operator+(const Vector3D &vector) const {
+  assert(!!vector && !!(*this));
+  return Vector3D(x + vector.x, y + vector.y, z + vector.z);
+}
+
+inline Vector3D Vector3D::operator-() const {
+  return Vector3D(-x, -y, -z);
+}
+
+inline Vector3D Vector3D::operator-(const Vector3D &vector) const {
+  assert(!!vector && !!(*this));
+  return Vector3D(x - vector.x, y - vector.y, z - vector.z);
+}
+
+inline Vector3D Vector3D::operator*(const double &scalar) const {
+  assert(!!(*this));
+  return Vector3D( x * scalar, y * scalar, z * scalar);
+}
+
+inline Point3D::Point3D(double x, double y, double z):
+  x(x),
+  y(y),
+  z(z)
+{}
+
+inline bool Point3D::operator!() const {
+  return std::isnan(x);
+}
+
+inline Point3D Point3D::operator+(const Point3D &point) const {
+  assert(!!point && !!(*this));
+  return Point3D(x + point.x, y + point.y, z + point.z);
+}
+
+inline Point3D Point3D::operator+(const Vector3D &vector) const {
+  assert(!!vector && !!(*this));
+  return Point3D(x + vector.x, y + vector.y, z + vector.z);
+}
+
+inline Vector3D Point3D::operator-(const Point3D &point) const {
+  assert(!!point && !!(*this));
+  return Vector3D(x - point.x, y - point.y, z - point.z);
+}
+
+inline Point3D Point3D::operator*(const double &scalar) const {
+  assert(!!(*this));
+  return Point3D(x * scalar, y * scalar, z * scalar);
+}
+
+// Vector3D, Point3D and Plane3D must stay interchangeable with their C API equivalents.
+static_assert(sizeof(Vector3D) == sizeof(SUVector3D) && std::is_standard_layout<Vector3D>::value && std::is_trivially_copyable<Vector3D>::value, "CW::Vector3D must be layout compatible with SUVector3D");
+static_assert(sizeof(Point3D) == sizeof(SUPoint3D) && std::is_standard_layout<Point3D>::value && std::is_trivially_copyable<Point3D>::value, "CW::Point3D must be layout compatible with SUPoint3D");
+static_assert(sizeof(Plane3D) == sizeof(SUPlane3D) && std::is_standard_layout<Plane3D>::value && std::is_trivially_copyable<Plane3D>::value, "CW::Plane3D must be layout compatible with SUPlane3D");
+
 } /* namespace CW */
 #endif /* Geometry_h */
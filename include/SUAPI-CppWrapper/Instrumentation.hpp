@@ -0,0 +1,203 @@
+//
+//  Instrumentation.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef Instrumentation_hpp
+#define Instrumentation_hpp
+
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace CW {
+
+/**
+* What a counter measures: a SketchUp API function, a wrapper method, or the bytes of data copied in or out of the SketchUp API.
+*/
+enum class CounterKind {
+  SUFunction,
+  Method,
+  Bytes
+};
+
+/**
+* Running totals for one SketchUp API function or wrapper method.  Updated with relaxed atomics, so it can be shared between threads.
+*
+* Latencies are kept in a histogram of power-of-two buckets: bucket i counts the calls that took from 2^i to 2^(i+1)-1 nanoseconds, and bucket 0 also counts calls that took under a nanosecond.
+*/
+struct InstrumentationCounter {
+  static constexpr size_t NUM_BUCKETS = 40;
+
+  InstrumentationCounter(const char* counter_name, CounterKind counter_kind);
+
+  const char* name;
+  CounterKind kind;
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> total_ns;
+  std::atomic<uint64_t> max_ns;
+  std::atomic<uint64_t> bytes;
+  std::atomic<uint64_t> histogram[NUM_BUCKETS];
+
+  /**
+  * Records one call that took the given time.
+  */
+  void record(uint64_t duration_ns);
+
+  /**
+  * Records data of the given size copied through the counter.
+  */
+  void add_bytes(uint64_t num_bytes);
+
+  void reset();
+};
+
+
+/**
+* Call counts, latency histograms and marshalled bytes of the SketchUp API functions and wrapper methods, recorded when the library is compiled with CW_INSTRUMENTATION defined (the CMake option CPP_API_INSTRUMENTATION).
+*
+* Without CW_INSTRUMENTATION the CW_INSTRUMENT_* macros below expand to nothing, or to the plain SketchUp API call, so instrumentation costs nothing.  The functions of this class are still available, and report no counters.
+*
+* Reports are written as JSON, or as Chrome trace events (chrome://tracing, Perfetto) if tracing was started with start_trace().
+*/
+class Instrumentation {
+  public:
+  typedef std::chrono::steady_clock Clock;
+
+  /**
+  * The number of counters that storage is reserved for.  Calls to further counters are recorded in the last counter.
+  */
+  static constexpr size_t MAX_COUNTERS = 2048;
+
+  /**
+  * Returns true if the library was compiled with CW_INSTRUMENTATION.
+  */
+  static bool compiled_in();
+
+  /**
+  * Returns the counter with the given name, creating it on first use.  The counter lives until the program exits.  Storage for the counters is reserved up front, so this never allocates or throws, and can be used from destructors.
+  * @param name - a string literal, or other string that outlives the program.
+  */
+  static InstrumentationCounter* counter(const char* name, CounterKind kind) noexcept;
+
+  /**
+  * Returns the counters that have recorded anything since the last reset(), longest total time first.
+  */
+  static std::vector<const InstrumentationCounter*> counters();
+
+  /**
+  * Sets all of the counters back to zero, discards the trace events and restarts the elapsed time.
+  */
+  static void reset();
+
+  /**
+  * Starts recording a trace event for every instrumented call, keeping up to max_events of them.
+  */
+  static void start_trace(size_t max_events = 1 << 20);
+
+  /**
+  * Stops recording trace events.  The events already recorded are kept until reset().
+  */
+  static void stop_trace();
+
+  /**
+  * Records a finished call in the counter, and in the trace if tracing.  Each thread records its trace events into its own buffer.
+  */
+  static void record(InstrumentationCounter* counter, Clock::time_point start, Clock::time_point end) noexcept;
+
+  /**
+  * Writes the counters as a JSON object.  Each counter gives its share of the time elapsed since the last reset().
+  */
+  static void write_json(std::ostream& stream);
+
+  /**
+  * Writes the recorded trace events in the Chrome trace event format.
+  */
+  static void write_chrome_trace(std::ostream& stream);
+};
+
+
+/**
+* Times the scope it is declared in, and records it in a counter when it goes out of scope.
+*/
+class ScopedInstrumentation {
+  private:
+  InstrumentationCounter* m_counter;
+  Instrumentation::Clock::time_point m_start;
+
+  public:
+  explicit ScopedInstrumentation(InstrumentationCounter* counter):
+    m_counter(counter),
+    m_start(Instrumentation::Clock::now())
+  {}
+
+  ScopedInstrumentation(const ScopedInstrumentation&) = delete;
+  ScopedInstrumentation& operator=(const ScopedInstrumentation&) = delete;
+
+  ~ScopedInstrumentation() {
+    Instrumentation::record(m_counter, m_start, Instrumentation::Clock::now());
+  }
+};
+
+} /* namespace CW */
+
+
+/**
+* CW_INSTRUMENT_METHOD("CW::Class::method") at the top of a wrapper method times the method.
+* CW_INSTRUMENT_SU(SUFunction, args...) calls a SketchUp API function, timing the call.
+* CW_INSTRUMENT_BYTES("CW::Class", num_bytes) records data copied in or out of the SketchUp API.
+*/
+#ifdef CW_INSTRUMENTATION
+
+#define CW_INSTRUMENT_METHOD(name) \
+  static CW::InstrumentationCounter* const cw_method_counter = CW::Instrumentation::counter(name, CW::CounterKind::Method); \
+  CW::ScopedInstrumentation cw_method_instrumentation(cw_method_counter)
+
+#define CW_INSTRUMENT_SU(function, ...) \
+  ([&]() { \
+    static CW::InstrumentationCounter* const cw_su_counter = CW::Instrumentation::counter(#function, CW::CounterKind::SUFunction); \
+    CW::ScopedInstrumentation cw_su_instrumentation(cw_su_counter); \
+    return function(__VA_ARGS__); \
+  }())
+
+#define CW_INSTRUMENT_BYTES(name, num_bytes) \
+  do { \
+    static CW::InstrumentationCounter* const cw_bytes_counter = CW::Instrumentation::counter(name, CW::CounterKind::Bytes); \
+    cw_bytes_counter->add_bytes(num_bytes); \
+  } while (false)
+
+#else
+
+#define CW_INSTRUMENT_METHOD(name) ((void)0)
+#define CW_INSTRUMENT_SU(function, ...) function(__VA_ARGS__)
+#define CW_INSTRUMENT_BYTES(name, num_bytes) ((void)0)
+
+#endif /* CW_INSTRUMENTATION */
+
+#endif /* Instrumentation_hpp */
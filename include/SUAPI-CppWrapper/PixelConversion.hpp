@@ -0,0 +1,86 @@
+//
+//  PixelConversion.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef PixelConversion_hpp
+#define PixelConversion_hpp
+
+#include <stdio.h>
+
+#include <SketchUpAPI/color.h>
+
+#include "SUAPI-CppWrapper/Span.hpp"
+
+namespace CW {
+
+/**
+* Pixel format conversions for image data read from, or written to, an ImageRep.  They work on whole buffers and use SSE2, SSSE3 or AVX2 where the processor supports it, chosen once at startup.  None of them call the SketchUp API.
+*
+* 32 bit pixels are four bytes with alpha last: BGRA, the order used by the SketchUp API, or RGBA.  24 bit pixels are three bytes, BGR or RGB.
+*/
+
+/**
+* Swaps the first and third byte of each 32 bit pixel, converting BGRA to RGBA or RGBA to BGRA.
+* @param in - the source pixels.  Its size must be a multiple of 4.
+* @param out - the destination.  Must be at least as large as in, and may be the same buffer as in.
+* @throws std::invalid_argument if the sizes do not match.
+*/
+void bgra_to_rgba(Span<const SUByte> in, Span<SUByte> out);
+
+/**
+* Expands 24 bit BGR pixels to 32 bit BGRA pixels, keeping the byte order.
+* @param in - the source pixels.  Its size must be a multiple of 3.
+* @param out - the destination, which must hold in.size() / 3 * 4 bytes and must not overlap in.
+* @param alpha - the alpha value of every output pixel.
+* @throws std::invalid_argument if the sizes do not match.
+*/
+void bgr_to_bgra(Span<const SUByte> in, Span<SUByte> out, SUByte alpha = 255);
+
+/**
+* Expands 24 bit BGR pixels to 32 bit RGBA pixels, swapping the first and third byte.  Also converts RGB to BGRA.
+* @see bgr_to_bgra()
+*/
+void bgr_to_rgba(Span<const SUByte> in, Span<SUByte> out, SUByte alpha = 255);
+
+/**
+* Multiplies the colour channels of 32 bit pixels by their alpha, in place.  Each channel becomes round(channel * alpha / 255).
+* @param pixels - BGRA or RGBA pixels.  Its size must be a multiple of 4.
+* @throws std::invalid_argument if the size is not a multiple of 4.
+*/
+void premultiply_alpha(Span<SUByte> pixels);
+
+/**
+* Copies image rows, dropping the padding at the end of each row.
+* @param in - the padded image, height rows of width * bytes_per_pixel + row_padding bytes.
+* @param out - the destination, which must hold width * height * bytes_per_pixel bytes.  May be the same buffer as in.
+* @param row_padding - the padding at the end of each row, in bytes, as returned by ImageRep::row_padding().
+* @throws std::invalid_argument if either buffer is too small.
+*/
+void strip_row_padding(Span<const SUByte> in, Span<SUByte> out, size_t width, size_t height, size_t bytes_per_pixel, size_t row_padding);
+
+} /* namespace CW */
+
+#endif /* PixelConversion_hpp */
@@ -0,0 +1,164 @@
+//
+//  RefTracker.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef RefTracker_hpp
+#define RefTracker_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include <SketchUpAPI/model/defs.h>
+
+namespace CW {
+
+/**
+* The kinds of SketchUp objects whose ownership is tracked by RefTracker.
+*/
+enum class RefKind {
+  String,
+  TypedValue,
+  Model,
+  GeometryInput,
+  LoopInput,
+  ImageRep,
+  InstancePath,
+  Face,
+  Edge,
+  Material,
+  Layer,
+  ComponentDefinition,
+  ComponentInstance,
+  Group,
+  AttributeDictionary,
+  Axes,
+  Texture,
+  OtherEntity,
+  NUM_KINDS
+};
+
+/**
+* Counts of the SketchUp objects of one kind that have been owned by wrapper objects.
+*/
+struct RefCounts {
+  uint64_t acquired; // number of times a wrapper object took ownership of an object
+  uint64_t released; // number of times a wrapper object released an object, or gave up ownership by attaching it to a model
+  int64_t live; // acquired - released.  A negative count means an object was released twice.
+  int64_t high_water; // highest value of live since the last reset_high_water()
+};
+
+/**
+* The number of live objects of one kind acquired under one site label.
+*/
+struct RefSite {
+  RefKind kind;
+  const char* site;
+  size_t live;
+};
+
+/**
+* Accounts for the SketchUp objects that are owned by wrapper objects: those that were created, or handed over, unattached and that the wrapper must release.
+*
+* The wrapper classes report here when they take ownership of an object and when they release it, or give it up by attaching it to a model (Entity::attached()).  An object kind whose live count keeps growing is being leaked.  Each report updates a few relaxed atomic counters, so the accounting is always on.
+*
+* With track_sites(true), the tracker also remembers which site label each live object was acquired under, so that leaks can be traced to a part of a job.  Sites are labelled with RefTracker::Site objects; this costs a lock and a hash map update per object, so it is off by default.
+*/
+class RefTracker {
+  public:
+  /**
+  * Labels the objects acquired on this thread while it is in scope.  Labels nest, and should be string literals.
+  */
+  class Site {
+    private:
+    const char* m_previous;
+
+    public:
+    explicit Site(const char* label);
+    Site(const Site&) = delete;
+    Site& operator=(const Site&) = delete;
+    ~Site();
+  };
+
+  /**
+  * Returns a name for the kind of object, such as "Face".
+  */
+  static const char* kind_name(RefKind kind);
+
+  /**
+  * Returns the kind to report an entity of the given type as.
+  */
+  static RefKind entity_kind(SURefType type);
+
+  /**
+  * Records that a wrapper object has taken ownership of the SketchUp object with the given pointer.
+  */
+  static void acquired(RefKind kind, const void* ref);
+
+  /**
+  * Records that a wrapper object has released, or given up ownership of, the SketchUp object with the given pointer.
+  */
+  static void released(RefKind kind, const void* ref);
+
+  /**
+  * Returns the counts for one kind of object.
+  */
+  static RefCounts counts(RefKind kind);
+
+  /**
+  * Returns the number of objects of the given kind that are owned and have not been released.
+  */
+  static int64_t live(RefKind kind);
+
+  /**
+  * Returns the address of the counters of one kind.  Each kind's counters start a cache line of their own, so that threads working on different kinds do not contend.
+  */
+  static const void* counters_address(RefKind kind);
+
+  /**
+  * Sets the high-water mark of every kind to its current live count.
+  */
+  static void reset_high_water();
+
+  /**
+  * Turns recording of the site label of each live object on or off.  Turning it off discards the recorded sites.
+  */
+  static void track_sites(bool track);
+
+  /**
+  * Returns the number of live objects acquired under each site label since track_sites(true), most first.  Objects acquired outside of any Site are given the label "(no site)".
+  */
+  static std::vector<RefSite> live_sites();
+
+  /**
+  * Writes the counts of every kind that has been acquired, followed by the live objects by site if sites are tracked.
+  */
+  static void write_report(std::ostream& stream);
+};
+
+} /* namespace CW */
+#endif /* RefTracker_hpp */
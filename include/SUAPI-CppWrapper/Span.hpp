@@ -0,0 +1,94 @@
+//
+//  Span.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef Span_hpp
+#define Span_hpp
+
+#include <stdio.h>
+#include <type_traits>
+#include <vector>
+
+namespace CW {
+
+/**
+* A non-owning view of a contiguous array, like std::span in C++20.  Lets functions read or write memory owned by the caller - a std::vector, an array or a mapped buffer - without copying it.
+*/
+template <typename T>
+class Span {
+  private:
+  T* m_data;
+  size_t m_size;
+
+  public:
+  Span():
+    m_data(nullptr),
+    m_size(0)
+  {}
+
+  Span(T* data, size_t size):
+    m_data(data),
+    m_size(size)
+  {}
+
+  /** Views the contents of a vector.  A Span<const T> can view a const vector. */
+  template <typename Allocator>
+  Span(std::vector<typename std::remove_const<T>::type, Allocator>& vector):
+    m_data(vector.data()),
+    m_size(vector.size())
+  {}
+
+  template <typename Allocator, typename U = T, typename = typename std::enable_if<std::is_const<U>::value>::type>
+  Span(const std::vector<typename std::remove_const<T>::type, Allocator>& vector):
+    m_data(vector.data()),
+    m_size(vector.size())
+  {}
+
+  /** A Span<T> converts to a Span<const T>. */
+  template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+  Span(const Span<U>& other):
+    m_data(other.data()),
+    m_size(other.size())
+  {}
+
+  T* data() const { return m_data; }
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  T* begin() const { return m_data; }
+  T* end() const { return m_data + m_size; }
+
+  T& operator[](size_t i) const { return m_data[i]; }
+
+  /**
+  * Returns a view of count elements starting at offset.  The range must lie within this span.
+  */
+  Span subspan(size_t offset, size_t count) const { return Span(m_data + offset, count); }
+};
+
+} /* namespace CW */
+
+#endif /* Span_hpp */
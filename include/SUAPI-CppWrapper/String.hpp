@@ -29,11 +29,70 @@
 #define String_hpp
 
 #include <stdio.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
 #include <string>
 
 #include <SketchUpAPI/unicodestring.h>
 namespace CW {
 
+/**
+* Read-only view of UTF-8 characters owned by another object, in place of std::string_view which is not available in C++14.  The characters are followed by a null terminator.
+*/
+struct StringView {
+  const char* data;
+  size_t size;
+
+  /**
+  * Returns a std::string copy of the characters.
+  */
+  std::string str() const { return std::string(data, size); }
+
+  friend bool operator==(const StringView& lhs, const StringView& rhs) {
+    return lhs.size == rhs.size && std::memcmp(lhs.data, rhs.data, lhs.size) == 0;
+  }
+  friend bool operator==(const StringView& lhs, const std::string& rhs) {
+    return lhs.size == rhs.size() && std::memcmp(lhs.data, rhs.data(), lhs.size) == 0;
+  }
+};
+
+/**
+* A UTF-8 copy of a String, returned by String::view().  Strings shorter than INLINE_SIZE bytes are held inside the object, so copying them out does not allocate.  Each StringBuffer owns its characters, so any number of them can be alive at once.
+*/
+class StringBuffer {
+  public:
+  static constexpr size_t INLINE_SIZE = 64;
+
+  private:
+  char m_inline[INLINE_SIZE];
+  std::unique_ptr<char[]> m_heap;
+  size_t m_size;
+
+  public:
+  /**
+  * Makes room for a string of the given length and its null terminator.
+  * @throws std::length_error if size is SIZE_MAX, which leaves no room for the terminator.
+  */
+  explicit StringBuffer(size_t size);
+
+  StringBuffer(StringBuffer&& other) noexcept = default;
+  StringBuffer& operator=(StringBuffer&& other) noexcept = default;
+
+  char* data() { return m_heap ? m_heap.get() : m_inline; }
+  const char* data() const { return m_heap ? m_heap.get() : m_inline; }
+  size_t size() const { return m_size; }
+
+  /**
+  * Returns a view of the characters, valid for the lifetime of the StringBuffer.
+  */
+  StringView view() const { return StringView{this->data(), m_size}; }
+
+  std::string str() const { return std::string(this->data(), m_size); }
+};
+
 /*
 * StringRef wrapper
 */
@@ -44,8 +103,24 @@ enum class StringEncoding {
 
 class String {
   private:
+  static constexpr size_t NOT_CACHED = SIZE_MAX;
+
   SUStringRef m_string;
   StringEncoding m_encoding;
+  // Finding the length or hash means copying the characters out of the SUStringRef, so they are worked out once and kept.  They are forgotten when the SUStringRef is handed out for writing, through the non-const conversion operators.  They are atomic so that a const String can be read from several threads, any of which may fill them in.
+  mutable std::atomic<size_t> m_length;
+  mutable std::atomic<size_t> m_hash;
+  mutable std::atomic<bool> m_hash_cached;
+
+  void clear_cache() {
+    m_length.store(NOT_CACHED, std::memory_order_relaxed);
+    m_hash_cached.store(false, std::memory_order_relaxed);
+  }
+
+  /**
+  * Copies the cached length and hash of another string.
+  */
+  void copy_cache(const String& other);
   
   // Disallow copying for simplicity
   //String(const String& copy);
@@ -66,26 +141,57 @@ class String {
   /** Copy Constructor */
   String(const String& other);
   
+  /** Move Constructor.  Takes over the other string's SUStringRef, leaving the other string null. */
+  String(String&& other) noexcept;
+  
   /** Copy Assignment operator */
-  String& operator=(String& other);
+  String& operator=(const String& other);
+
+  /** Move Assignment operator.  The other string is left null. */
+  String& operator=(String&& other) noexcept;
   
   
   ~String();
   
-  operator SUStringRef&() {return m_string;}
-  operator SUStringRef*() {return &m_string;}
+  operator SUStringRef&() {clear_cache(); return m_string;}
+  operator SUStringRef*() {clear_cache(); return &m_string;}
   operator SUStringRef() const {return m_string;}
   
   /**
-  * Compares two strings for equality.
+  * Compares two strings for equality.  Strings of different lengths or hashes are told apart without comparing their characters.
   */
   friend bool operator==(const String &lhs, const String &rhs);
+  friend bool operator!=(const String &lhs, const String &rhs);
   
   /*
   * Convert to std::string
   */
   std::string std_string() const;
   operator std::string() const;
+
+  /**
+  * Copies the string into the given std::string, reusing its memory.
+  * @param out - the std::string to copy into.
+  */
+  void std_string(std::string& out) const;
+
+  /**
+  * Copies the string as null terminated UTF-8 into a buffer supplied by the caller.  Nothing is copied if the buffer is too small.
+  * @param buffer - the buffer to copy into.
+  * @param buffer_size - the size of the buffer, in bytes.  Must be at least size() + 1 for the string to be copied.
+  * @return the length of the string in bytes, without the null terminator.
+  */
+  size_t copy_utf8(char* buffer, size_t buffer_size) const;
+
+  /**
+  * Returns a copy of the string as UTF-8.  Short strings are copied without allocating.
+  */
+  StringBuffer view() const;
+
+  /**
+  * Returns a hash of the UTF-8 characters of the string.
+  */
+  size_t hash() const;
   
 //  char& operator [](size_t i);
 
@@ -95,7 +201,7 @@ class String {
   SUStringRef ref() const;
   
   /*
-  * Return the length of the string, in bytes. Including the null terminator at the end.
+  * Return the length of the string as UTF-8, in bytes. Not including the null terminator at the end.  A moved-from String has size 0.
   */
   size_t size() const;
   
@@ -108,5 +214,15 @@ class String {
 
 } /* namespace CW */
 
+namespace std {
+  template <> struct hash<CW::String>
+  {
+    size_t operator()(const CW::String& string) const
+    {
+      return string.hash();
+    }
+  };
+
+}
 
 #endif /* String_hpp */
@@ -30,6 +30,7 @@
 
 #include <stdio.h>
 #include <array>
+#include <vector>
 
 #include <SketchUpAPI/geometry/transformation.h>
 
@@ -199,6 +200,32 @@ class Transformation {
   */
   Transformation operator*(Transformation transform);
 
+  /**
+  * Transforms an array of points.  The input and output arrays may be the same array.
+  * The fastest kernel supported by the processor (AVX2, SSE2 or plain C++) is chosen at runtime.
+  * @param in - array of n points to transform.
+  * @param out - array of n points that will hold the transformed points.
+  * @param n - the number of points.
+  */
+  void apply(const SUPoint3D* in, SUPoint3D* out, size_t n) const;
+  void apply(std::vector<Point3D>& points) const;
+
+  /**
+  * Transforms an array of vectors.  The translation of the transformation is not applied to vectors.  The input and output arrays may be the same array.
+  */
+  void apply(const SUVector3D* in, SUVector3D* out, size_t n) const;
+  void apply(std::vector<Vector3D>& vectors) const;
+
+  /**
+  * Transforms an array of surface normals, so that they remain perpendicular to transformed surfaces even with non-uniform scaling.  The output normals are unit vectors.  The input and output arrays may be the same array.
+  */
+  void apply_normals(const SUVector3D* in, SUVector3D* out, size_t n) const;
+
+  /**
+  * Transforms an array of planes.  The input and output arrays may be the same array.
+  */
+  void apply(const SUPlane3D* in, SUPlane3D* out, size_t n) const;
+
   /**
   * Return transformed vectors.
   * @since SketchUp 2018, API v6.0
@@ -0,0 +1,138 @@
+//
+//  Triangulator.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef Triangulator_hpp
+#define Triangulator_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <vector>
+
+#include <SketchUpAPI/geometry.h>
+
+namespace CW {
+
+// Forward declarations
+class Point3D;
+class Vector3D;
+
+/**
+* Indexed triangle list, filled by Triangulator, Face::triangulate() and Entities::triangulate_all().  A TriangleMesh can be cleared and filled again without giving back its memory.
+*
+* Triangle t has the vertices positions[indices[3*t]], positions[indices[3*t+1]] and positions[indices[3*t+2]], wound counter-clockwise around the normal of its polygon.
+* Polygon p has the triangles polygon_offsets[p] to polygon_offsets[p+1] - 1.
+*/
+struct TriangleMesh {
+  std::vector<SUPoint3D> positions;
+  std::vector<uint32_t> indices;
+  std::vector<size_t> polygon_offsets;
+
+  /**
+  * Returns the number of triangles in the mesh.
+  */
+  size_t num_triangles() const;
+
+  /**
+  * Returns the number of polygons that have been triangulated into the mesh.
+  */
+  size_t num_polygons() const;
+
+  /**
+  * Empties the mesh, keeping the memory that has been allocated.
+  */
+  void clear();
+};
+
+/**
+* Ear clipping triangulator for planar polygons with holes.
+*
+* The polygon is projected onto the axis plane closest to its own plane, holes are joined to the outer loop by bridge edges, and ears are clipped from the resulting loop.  Polygons that are not simple are still triangulated, by splitting them into smaller polygons, although the result may overlap.
+* A Triangulator keeps its working memory between calls, so use one object to triangulate many polygons.  It does not call the SketchUp API.
+*/
+class Triangulator {
+  private:
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  struct Node {
+    uint32_t index; // index of the point in the mesh positions
+    double x;
+    double y;
+    uint32_t prev;
+    uint32_t next;
+    bool steiner;
+  };
+
+  // Working memory, kept between calls.
+  std::vector<Node> m_nodes;
+  std::vector<uint32_t> m_holes;
+  std::vector<double> m_coordinates;
+
+  uint32_t insert_node(uint32_t index, double x, double y, uint32_t last);
+  void remove_node(uint32_t node);
+  uint32_t linked_list(const double* coordinates, uint32_t first_index, size_t begin, size_t end, bool outer);
+  uint32_t filter_points(uint32_t start, uint32_t end = NONE);
+  uint32_t eliminate_hole(uint32_t hole, uint32_t outer_node);
+  uint32_t find_hole_bridge(uint32_t hole, uint32_t outer_node) const;
+  uint32_t split_polygon(uint32_t a, uint32_t b);
+  void earcut_linked(uint32_t ear, std::vector<uint32_t>& indices, int pass);
+  uint32_t cure_local_intersections(uint32_t start, std::vector<uint32_t>& indices);
+  void split_earcut(uint32_t start, std::vector<uint32_t>& indices);
+  bool is_ear(uint32_t ear) const;
+  bool is_valid_diagonal(uint32_t a, uint32_t b) const;
+  bool intersects_polygon(uint32_t a, uint32_t b) const;
+  bool locally_inside(uint32_t a, uint32_t b) const;
+  bool middle_inside(uint32_t a, uint32_t b) const;
+  bool sector_contains_sector(uint32_t m, uint32_t p) const;
+  uint32_t leftmost(uint32_t start) const;
+  double area(uint32_t p, uint32_t q, uint32_t r) const;
+  bool equals(uint32_t a, uint32_t b) const;
+  bool intersects(uint32_t p1, uint32_t q1, uint32_t p2, uint32_t q2) const;
+
+  public:
+  /**
+  * Triangulates a polygon and appends its points and triangles to the mesh.
+  * @param points - the points of all loops of the polygon, one loop after another.  The first loop is the outer loop.
+  * @param loop_offsets - loop i has the points points[loop_offsets[i]] to points[loop_offsets[i+1] - 1].  Must have num_loops + 1 values.
+  * @param num_loops - the number of loops in the polygon.
+  * @param normal - the normal of the polygon's plane.  Triangles are wound counter-clockwise around it.
+  * @param mesh - the TriangleMesh to append to.
+  * @return the number of triangles added.
+  */
+  size_t triangulate(const SUPoint3D* points, const size_t* loop_offsets, size_t num_loops, const Vector3D& normal, TriangleMesh& mesh);
+
+  /**
+  * Triangulates a polygon and appends its points and triangles to the mesh.
+  * @param loops - the loops of the polygon.  The first loop is the outer loop, and any others are holes.
+  * @param normal - the normal of the polygon's plane.  Triangles are wound counter-clockwise around it.
+  * @param mesh - the TriangleMesh to append to.
+  * @return the number of triangles added.
+  */
+  size_t triangulate(const std::vector<std::vector<Point3D>>& loops, const Vector3D& normal, TriangleMesh& mesh);
+};
+
+} /* namespace CW */
+#endif /* Triangulator_hpp */
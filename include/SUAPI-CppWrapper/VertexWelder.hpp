@@ -0,0 +1,136 @@
+//
+//  VertexWelder.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef VertexWelder_hpp
+#define VertexWelder_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+
+namespace CW {
+
+/**
+* Finds coincident vertices through a spatial hash, so that a point shared by several faces or edges is given one vertex index.
+*
+* Two points are coincident if they are within the tolerance of each other on every axis, the same test as Point3D::operator==.  Points are hashed into a grid of cells as wide as the tolerance, so a lookup only has to check the 27 cells around the point.  It does not call the SketchUp API.
+*/
+class VertexWelder {
+  public:
+  static constexpr size_t NOT_FOUND = SIZE_MAX;
+
+  private:
+  struct Cell {
+    int64_t x;
+    int64_t y;
+    int64_t z;
+
+    bool operator==(const Cell& other) const {
+      return x == other.x && y == other.y && z == other.z;
+    }
+  };
+
+  struct CellHash {
+    size_t operator()(const Cell& cell) const {
+      return static_cast<size_t>(
+        (static_cast<uint64_t>(cell.x) * 73856093u) ^
+        (static_cast<uint64_t>(cell.y) * 19349663u) ^
+        (static_cast<uint64_t>(cell.z) * 83492791u));
+    }
+  };
+
+  struct Entry {
+    Point3D point;
+    size_t index; // the vertex index given for the point
+    size_t next; // the next entry in the same cell, or NOT_FOUND
+  };
+
+  double m_tolerance;
+  std::unordered_map<Cell, size_t, CellHash> m_cells; // first entry in each cell
+  std::vector<Entry> m_entries;
+  size_t m_duplicates = 0;
+
+  Cell cell(const Point3D& point) const;
+
+  public:
+  /**
+  * @param tolerance - the largest distance, along each axis, between points that are welded together.
+  */
+  VertexWelder(double tolerance = Point3D::EPSILON);
+
+  /**
+  * Returns the vertex index of a point coincident with the given point, or NOT_FOUND if there is none.
+  */
+  size_t find(const Point3D& point) const;
+
+  /**
+  * Records a vertex, without checking for coincident points.
+  * @param point - the position of the vertex.  Points with a NaN or infinite coordinate are not recorded.
+  * @param index - the vertex index that find() and weld() return for points coincident with this one.
+  */
+  void add(const Point3D& point, size_t index);
+
+  /**
+  * Returns the vertex index of a point coincident with the given point.  If there is none, the point is recorded with the given index, which is returned.
+  * @param point - the position of the vertex.
+  * @param index - the index to give the point if it is new.
+  * @return the index of the vertex to use for the point.  The point is new if this equals index.
+  */
+  size_t weld(const Point3D& point, size_t index);
+
+  /**
+  * Returns the number of points recorded.
+  */
+  size_t size() const;
+
+  /**
+  * Returns the number of times weld() has found a coincident point, and so saved adding a duplicate vertex.
+  */
+  size_t duplicates() const;
+
+  /**
+  * Returns the tolerance within which points are welded.
+  */
+  double tolerance() const;
+
+  /**
+  * Allocates space for the given number of points.
+  */
+  void reserve(size_t num_points);
+
+  /**
+  * Forgets all points and resets the duplicate count.
+  */
+  void clear();
+};
+
+} /* namespace CW */
+
+#endif /* VertexWelder_hpp */
@@ -40,6 +40,7 @@ namespace CW {
 
 class TypedValue;
 class String;
+class AttributeSnapshot;
 
 /*
 * Entity object wrapper
@@ -83,6 +84,9 @@ class AttributeDictionary :public Entity {
 
   /** Copy constructor */
   AttributeDictionary(const AttributeDictionary& other);
+
+  /** Move constructor. The other object is left null. */
+  AttributeDictionary(AttributeDictionary&& other) noexcept;
   
   /**
   * Destructor
@@ -93,6 +97,9 @@ class AttributeDictionary :public Entity {
   /** Copy assignment operator */
   AttributeDictionary& operator=(const AttributeDictionary& other);
 
+  /** Move assignment operator. The other object is left null. */
+  AttributeDictionary& operator=(AttributeDictionary&& other) noexcept;
+
   /** Cast to native object **/
   SUAttributeDictionaryRef ref() const;
   operator SUAttributeDictionaryRef() const;
@@ -118,10 +125,31 @@ class AttributeDictionary :public Entity {
   */
   bool set_attribute(const std::string &key, const TypedValue &value);
 
+  /**
+  * Sets the values of all of the attributes in the given snapshot, reusing one SUTypedValueRef for all of them.
+  * @return true if every attribute was set.
+  */
+  bool set_attributes(const AttributeSnapshot& attributes);
+
+  /**
+  * Returns a copy of all of the keys and values in the Attribute Dictionary, read in one pass.  Lookups into the snapshot do not call the SketchUp API.
+  */
+  AttributeSnapshot snapshot() const;
+
+  /**
+  * Fills the given snapshot with the keys and values in the Attribute Dictionary, keeping the memory it has already allocated.
+  */
+  void snapshot(AttributeSnapshot& attributes) const;
+
   /**
   * Returns a vector array of keys in the Attribute Dictionary.
   */
   std::vector<std::string> get_keys() const;
+
+  /**
+  * Fills the given vector with the keys in the Attribute Dictionary.  Strings already in the vector are overwritten in place, keeping their memory.
+  */
+  void get_keys(std::vector<std::string>& keys) const;
   
   /**
   * Returns the name of the AttributeDictionary.
@@ -0,0 +1,264 @@
+//
+//  AttributeSnapshot.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef AttributeSnapshot_hpp
+#define AttributeSnapshot_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SketchUpAPI/color.h>
+#include <SketchUpAPI/model/typed_value.h>
+
+#include "SUAPI-CppWrapper/Color.hpp"
+#include "SUAPI-CppWrapper/Geometry.hpp"
+
+namespace CW {
+
+/**
+* A copy of the value of an attribute, held as a tagged union so that it can be read without calling the SketchUp API.
+*
+* Unlike TypedValue, AttributeValue does not own a SUTypedValueRef.  Strings, vectors and arrays are held out of line, behind a pointer to storage that is shared between copies, so that every value is 16 bytes and copying one never copies its data.
+*/
+class AttributeValue {
+  private:
+  // Out of line storage of a string, vector or array value, reference counted.
+  struct Shared;
+  template <class T>
+  struct SharedValue;
+
+  SUTypedValueType m_type;
+  union {
+    char m_byte;
+    int16_t m_int16;
+    int32_t m_int32;
+    float m_float;
+    double m_double;
+    bool m_bool;
+    SUColor m_color;
+    int64_t m_time;
+    Shared* m_shared;
+  };
+
+  void copy_data(const AttributeValue& other) noexcept;
+  void swap_data(AttributeValue& other) noexcept;
+
+  /**
+  * Returns true if the value is held out of line in m_shared.
+  */
+  bool is_shared() const;
+
+  /**
+  * Drops this value's reference to its shared storage, if it has any.
+  */
+  void release() noexcept;
+
+  template <class T>
+  const T& shared_value() const;
+
+  /**
+  * Replaces the value with the given value, held out of line.
+  */
+  template <class T>
+  void set_shared(SUTypedValueType type, T value);
+
+  void check_type(SUTypedValueType type, const char* method) const;
+
+  public:
+  /**
+  * Constructs an empty value (SUTypedValueType_Empty).
+  */
+  AttributeValue();
+
+  /**
+  * Constructs a string value.
+  */
+  AttributeValue(const char chars[]);
+  AttributeValue(std::string string);
+
+  /**
+  * Copies share the storage of string, vector and array values.
+  */
+  AttributeValue(const AttributeValue& other) noexcept;
+  AttributeValue(AttributeValue&& other) noexcept;
+
+  ~AttributeValue();
+
+  AttributeValue& operator=(const AttributeValue& other) noexcept;
+  AttributeValue& operator=(AttributeValue&& other) noexcept;
+
+  /**
+  * Returns the type of the value.
+  * @see enum SUTypedValueType for values
+  */
+  SUTypedValueType get_type() const;
+
+  /**
+  * Returns true if the value is of SUTypedValueType_Empty type.
+  */
+  bool empty() const;
+
+  /**
+  * Retrieves/Sets the value.  The getters throw std::logic_error if the value is of a different type, and the setters change the type of the value.
+  */
+  char byte_value() const;
+  AttributeValue& byte_value(char byte_val);
+
+  int16_t int16_value() const;
+  AttributeValue& int16_value(int16_t int16_val);
+
+  int32_t int32_value() const;
+  AttributeValue& int32_value(int32_t int32_val);
+
+  float float_value() const;
+  AttributeValue& float_value(float float_val);
+
+  double double_value() const;
+  AttributeValue& double_value(double double_val);
+
+  bool bool_value() const;
+  AttributeValue& bool_value(bool bool_val);
+
+  Color color_value() const;
+  AttributeValue& color_value(const Color& color_val);
+
+  /**
+  * The time value is in seconds since January 1, 1970.
+  */
+  int64_t time_value() const;
+  AttributeValue& time_value(int64_t time_val);
+
+  const std::string& string_value() const;
+  AttributeValue& string_value(std::string string_val);
+
+  Vector3D vector_value() const;
+  AttributeValue& vector_value(const Vector3D& vector_val);
+
+  const std::vector<AttributeValue>& array_value() const;
+  AttributeValue& array_value(std::vector<AttributeValue> array_val);
+
+  /**
+  * Returns the number of bytes of memory held out of line by the value, including the items of an array.  Storage that is shared with copies is counted in full.
+  */
+  size_t memory_size() const;
+
+  /**
+  * Comparison operator overloads.  Values of different types are never equal.
+  */
+  friend bool operator==(const AttributeValue& val1, const AttributeValue& val2);
+  friend bool operator!=(const AttributeValue& val1, const AttributeValue& val2);
+};
+
+static_assert(sizeof(AttributeValue) <= 16, "CW::AttributeValue must stay a 16 byte tag and union");
+
+
+/**
+* The keys and values of an AttributeDictionary, copied in one pass by AttributeDictionary::snapshot(), or gathered to be written in one pass by AttributeDictionary::set_attributes().
+*
+* Entries are held in insertion order in a single vector, and found through an open addressing table of indices into it, so a lookup is a hash and a short linear probe with no calls to the SketchUp API.
+*/
+class AttributeSnapshot {
+  public:
+  typedef std::pair<std::string, AttributeValue> value_type;
+  typedef std::vector<value_type>::const_iterator const_iterator;
+
+  private:
+  static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+  struct Slot {
+    uint32_t index; // index of the entry in m_entries, or EMPTY_SLOT
+    uint32_t hash; // low bits of the key's hash, to skip most string comparisons
+  };
+
+  std::vector<value_type> m_entries;
+  std::vector<Slot> m_slots; // size is zero or a power of two
+
+  static size_t hash_key(const std::string& key);
+
+  /**
+  * Returns the slot holding the key, or the empty slot where it would be inserted.
+  */
+  size_t find_slot(const std::string& key, size_t hash) const;
+
+  void rehash(size_t num_slots);
+
+  public:
+  AttributeSnapshot();
+
+  /**
+  * Returns the number of attributes held.
+  */
+  size_t size() const;
+
+  /**
+  * Returns true if no attributes are held.
+  */
+  bool empty() const;
+
+  /**
+  * Makes room for the given number of attributes without rehashing.
+  */
+  void reserve(size_t count);
+
+  /**
+  * Removes all of the attributes, keeping the memory that has been allocated so that the snapshot can be filled again.
+  */
+  void clear();
+
+  /**
+  * Returns a pointer to the value with the given key, or nullptr if there is none.  The pointer is invalidated when an attribute is added.
+  */
+  const AttributeValue* find(const std::string& key) const;
+
+  /**
+  * Returns true if there is an attribute with the given key.
+  */
+  bool contains(const std::string& key) const;
+
+  /**
+  * Returns the value with the given key, or the default value if there is none.
+  */
+  const AttributeValue& get(const std::string& key, const AttributeValue& default_value) const;
+
+  /**
+  * Sets the value of the attribute with the given key, adding it if it is not already held.
+  * @return reference to the stored value.
+  */
+  AttributeValue& set(const std::string& key, AttributeValue value);
+
+  /**
+  * Iterators over the (key, value) pairs, in the order in which they were added.
+  */
+  const_iterator begin() const;
+  const_iterator end() const;
+};
+
+} /* namespace CW */
+#endif /* AttributeSnapshot_hpp */
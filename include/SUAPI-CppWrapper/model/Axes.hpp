@@ -78,6 +78,9 @@ class Axes :public DrawingElement {
   
   /** Copy constructor */
   Axes(const Axes& other);
+
+  /** Move constructor. The other object is left null. */
+  Axes(Axes&& other) noexcept;
   
   /** Destructor */
   ~Axes();
@@ -89,6 +92,9 @@ class Axes :public DrawingElement {
   
   /** Copy assignment operator override */
   Axes& operator=(const Axes& other);
+
+  /** Move assignment operator. The other object is left null. */
+  Axes& operator=(Axes&& other) noexcept;
   
   /**
   * Operator overload signifies if this a valid object.
@@ -72,6 +72,9 @@ class ComponentDefinition :public DrawingElement {
   * Copy constructor.
   */
   ComponentDefinition(const ComponentDefinition& other);
+
+  /** Move constructor. The other object is left null. */
+  ComponentDefinition(ComponentDefinition&& other) noexcept;
   
   /**
   * Destructor will release the definition object if it had not been added to a model.
@@ -80,6 +83,9 @@ class ComponentDefinition :public DrawingElement {
   
   /** Copy assignment operator */
   ComponentDefinition& operator=(const ComponentDefinition& other);
+
+  /** Move assignment operator. The other object is left null. */
+  ComponentDefinition& operator=(ComponentDefinition&& other) noexcept;
   
   /** Cast to native objects */
   /**
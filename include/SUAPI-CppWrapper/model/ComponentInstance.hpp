@@ -54,6 +54,9 @@ class ComponentInstance :public DrawingElement {
   
   /** Copy constructor */
   ComponentInstance(const ComponentInstance& other);
+
+  /** Move constructor. The other object is left null. */
+  ComponentInstance(ComponentInstance&& other) noexcept;
   
   /** Copy constructor for derived classes (Group) */
   ComponentInstance(const ComponentInstance& other, SUComponentInstanceRef instance_ref);
@@ -63,6 +66,9 @@ class ComponentInstance :public DrawingElement {
 
   /** Copy assignment operator */
   ComponentInstance& operator=(const ComponentInstance& other);
+
+  /** Move assignment operator. The other object is left null. */
+  ComponentInstance& operator=(ComponentInstance&& other) noexcept;
   
   /**
   * Returns the raw SUComponentInstance object.
@@ -0,0 +1,170 @@
+//
+//  DefinitionGeometryCache.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef DefinitionGeometryCache_hpp
+#define DefinitionGeometryCache_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/component_definition.h>
+#include <SketchUpAPI/model/material.h>
+
+namespace CW {
+
+// Forward declarations
+class ComponentDefinition;
+
+/**
+* Triangulated mesh of the faces held directly in a component definition.  Nested instances and groups are not included; they are exported as instances of their own definitions.
+*
+* Triangle t has the vertices indices[3*t], indices[3*t+1] and indices[3*t+2], and the front material materials[material_ids[t]] (or none if the id is NO_ID).
+*/
+struct DefinitionMesh {
+  /** Id given to triangles that have no front material. */
+  static constexpr uint32_t NO_ID = UINT32_MAX;
+
+  std::vector<SUPoint3D> positions;
+  std::vector<SUVector3D> normals;
+  std::vector<uint32_t> indices;
+  std::vector<uint32_t> material_ids;
+  std::vector<SUMaterialRef> materials;
+
+  /**
+  * Returns the number of triangles in the mesh.
+  */
+  size_t num_triangles() const;
+
+  /**
+  * Returns the number of bytes of memory held by the mesh.
+  */
+  size_t memory_size() const;
+};
+
+/** Shared, immutable handle to a cached DefinitionMesh.  A handle stays valid after its mesh is evicted from the cache. */
+using DefinitionMeshPtr = std::shared_ptr<const DefinitionMesh>;
+
+/**
+* Opt-in cache of the triangulated geometry of component definitions, so that the geometry of a definition placed many times is extracted only once.  Exporters can ask for the mesh of each instance's definition and emit instance transformations instead of duplicating the vertex data.
+*
+* The memory held by the cache can be limited, in which case the least recently used meshes are evicted first.  The cache is not thread safe.
+*/
+class DefinitionGeometryCache {
+  private:
+  struct Entry {
+    void* definition;
+    DefinitionMeshPtr mesh;
+  };
+
+  // Most recently used entry first.
+  std::list<Entry> m_entries;
+  std::unordered_map<void*, std::list<Entry>::iterator> m_index;
+  size_t m_max_memory_size;
+  size_t m_memory_size = 0;
+  size_t m_hits = 0;
+  size_t m_misses = 0;
+  size_t m_evictions = 0;
+
+  /**
+  * Removes least recently used entries until the memory held is under the limit.
+  */
+  void evict();
+
+  public:
+  /**
+  * Constructs a cache.
+  * @param max_memory_size - the maximum number of bytes of mesh data to keep.  If 0, the size of the cache is not limited.
+  */
+  DefinitionGeometryCache(size_t max_memory_size = 0);
+
+  /**
+  * Returns the mesh of the definition, extracting it from the model if it is not already in the cache.
+  * @param definition - the ComponentDefinition to get the mesh of.
+  * @return shared handle to the mesh.
+  */
+  DefinitionMeshPtr get(const ComponentDefinition& definition);
+  DefinitionMeshPtr get(SUComponentDefinitionRef definition);
+
+  /**
+  * Returns true if the mesh of the definition is in the cache.  Does not count as a use of the entry.
+  */
+  bool contains(const ComponentDefinition& definition) const;
+
+  /**
+  * Removes the mesh of the definition from the cache, so that it is extracted again next time.  Call this when the definition has been changed.
+  */
+  void invalidate(const ComponentDefinition& definition);
+
+  /**
+  * Removes all meshes from the cache.  Counters are not reset.
+  */
+  void clear();
+
+  /**
+  * Returns the number of meshes in the cache.
+  */
+  size_t size() const;
+
+  /**
+  * Returns the number of bytes of mesh data held by the cache.
+  */
+  size_t memory_size() const;
+
+  /**
+  * Returns and sets the maximum number of bytes of mesh data the cache keeps.  0 means no limit.  Lowering the limit evicts meshes straight away.
+  */
+  size_t max_memory_size() const;
+  void max_memory_size(size_t max_memory_size);
+
+  /**
+  * Returns the number of calls to get() that were served from the cache.
+  */
+  size_t hits() const;
+
+  /**
+  * Returns the number of calls to get() that extracted the mesh from the model.
+  */
+  size_t misses() const;
+
+  /**
+  * Returns the number of meshes that have been evicted to stay within the memory limit.
+  */
+  size_t evictions() const;
+
+  /**
+  * Sets the hit, miss and eviction counters to zero.
+  */
+  void reset_counters();
+};
+
+} /* namespace CW */
+#endif /* DefinitionGeometryCache_hpp */
@@ -58,6 +58,9 @@ class DrawingElement :public Entity {
   * @param element_ref - SUDrawingElementRef object to assign to the copied object.
   */
   DrawingElement(const DrawingElement& other, SUDrawingElementRef element_ref = SU_INVALID);
+
+  /** Move constructor. The other object is left null. */
+  DrawingElement(DrawingElement&& other) noexcept;
   
   /**
   * Constructor representing a null object.
@@ -66,6 +69,9 @@ class DrawingElement :public Entity {
   
   /** Copy assignment operator */
   DrawingElement& operator=(const DrawingElement& other);
+
+  /** Move assignment operator. The other object is left null. */
+  DrawingElement& operator=(DrawingElement&& other) noexcept;
   
   /** Cast to native objects */
   SUDrawingElementRef ref() const;
@@ -84,10 +84,16 @@ class Edge :public DrawingElement {
   
   /** Copy Constructor */
   Edge(const Edge& other);
+
+  /** Move constructor. The other object is left null. */
+  Edge(Edge&& other) noexcept;
   
   ~Edge();
   
   Edge& operator=(const Edge& other);
+
+  /** Move assignment operator. The other object is left null. */
+  Edge& operator=(Edge&& other) noexcept;
   
   /**
   * Returns SUEdgeRef object for the Edge.
@@ -128,6 +134,11 @@ class Edge :public DrawingElement {
   * Return the faces connected to this edge.
   */
   std::vector<Face> faces() const;
+
+  /*
+  * Fills the given vector with the faces connected to this edge, reusing its memory.
+  */
+  void faces(std::vector<Face>& faces) const;
   
   /*
   * Gets the SUResult of the create edge operation.
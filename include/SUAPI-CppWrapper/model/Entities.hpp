@@ -34,6 +34,7 @@
 #include <SketchUpAPI/model/entities.h>
 
 #include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/EntityHandle.hpp"
 
 namespace CW {
 
@@ -49,6 +50,8 @@ class GeometryInput;
 class Transformation;
 class String;
 class BoundingBox3D;
+struct MeshSnapshot;
+struct TriangleMesh;
 
 /*
 * Entities wrapper
@@ -79,7 +82,61 @@ class Entities {
   std::vector<Face> faces() const;
   std::vector<Edge> edges(bool stray_only = true) const;
   std::vector<ComponentInstance> instances() const;
+
+  /**
+  * Fill the given vector with the faces, edges or instances of the Entities object.  The vector's memory is reused, so a traversal can keep one vector per thread instead of allocating a new one for each Entities object.
+  */
+  void faces(std::vector<Face>& faces) const;
+  void edges(std::vector<Edge>& edges, bool stray_only = true) const;
+  void instances(std::vector<ComponentInstance>& instances) const;
   std::vector<Group> groups() const;
+
+  /**
+  * Returns handles to the faces in the Entities object, in the same order as faces().  No wrapper objects are created, and the C API writes the references straight into the returned vector.
+  */
+  std::vector<FaceHandle> face_handles() const;
+
+  /**
+  * Fills the given vector with handles to the faces in the Entities object.  Its memory is reused.
+  */
+  void face_handles(std::vector<FaceHandle>& handles) const;
+
+  /**
+  * Returns handles to the edges in the Entities object, in the same order as edges().
+  * @param stray_only - if true, only edges that are not attached to a face are returned.
+  */
+  std::vector<EdgeHandle> edge_handles(bool stray_only = true) const;
+  void edge_handles(std::vector<EdgeHandle>& handles, bool stray_only = true) const;
+
+  /**
+  * Returns handles to the component instances in the Entities object, in the same order as instances().
+  */
+  std::vector<InstanceHandle> instance_handles() const;
+  void instance_handles(std::vector<InstanceHandle>& handles) const;
+
+  /**
+  * Returns the positions of every loop of every face in the Entities object, in a single structure-of-arrays buffer.  No Face, Loop or Vertex objects are created.
+  * @see MeshSnapshot for the layout of the returned data.
+  */
+  MeshSnapshot mesh_snapshot() const;
+
+  /**
+  * Fills the given snapshot with the face geometry of the Entities object.  Any previous contents of the snapshot are cleared, but its memory is reused.
+  * @param snapshot - the MeshSnapshot object to fill.
+  */
+  void mesh_snapshot(MeshSnapshot& snapshot) const;
+
+  /**
+  * Triangulates every face in the Entities object, including holes, without calling the SketchUp mesh helper.
+  * @return TriangleMesh with one polygon per face, in the same order as faces().
+  */
+  TriangleMesh triangulate_all() const;
+
+  /**
+  * Fills the given mesh with the triangulated faces of the Entities object.  Any previous contents of the mesh are cleared, but its memory is reused.
+  * @param mesh - the TriangleMesh object to fill.
+  */
+  void triangulate_all(TriangleMesh& mesh) const;
   
   /**
   * Return the BoundingBox of the Entities object.
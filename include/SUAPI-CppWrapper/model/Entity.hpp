@@ -63,6 +63,16 @@ class Entity {
   */
   bool m_attached;
 
+  /**
+  * @brief Reports to RefTracker that this object owns its unattached entity.
+  */
+  void track_owned() const;
+
+  /**
+  * @brief Reports to RefTracker that this object is about to release its entity, or has handed it to a model.  Call before the entity is released.
+  */
+  void track_released() const;
+
   public:
   /**
   * @brief Constructor representing a null objject.
@@ -85,6 +95,11 @@ class Entity {
   */
   Entity(const Entity& other, SUEntityRef entity_ref = SU_INVALID);
 
+  /**
+  * @brief Move constructor.  Takes over the reference and whether it is attached, leaving the other object null, so nothing is copied or released.
+  */
+  Entity(Entity&& other) noexcept;
+
   /**
   * @brief Destructor
   *
@@ -95,6 +110,11 @@ class Entity {
   /** @brief Copy assignment operator */
   Entity& operator=(const Entity& other);
 
+  /**
+  * @brief Move assignment operator.  Derived classes that own their reference release it before calling this.
+  */
+  Entity& operator=(Entity&& other) noexcept;
+
   /*
   * @brief Returns a copy of the wrapped SUEntityRef. USE WITH CAUTION.
   *
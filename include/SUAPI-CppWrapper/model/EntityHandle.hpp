@@ -0,0 +1,124 @@
+//
+//  EntityHandle.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef EntityHandle_hpp
+#define EntityHandle_hpp
+
+#include <stdio.h>
+#include <functional>
+#include <type_traits>
+
+#include <SketchUpAPI/model/component_instance.h>
+#include <SketchUpAPI/model/edge.h>
+#include <SketchUpAPI/model/face.h>
+
+namespace CW {
+
+// Forward declarations
+class Face;
+class Edge;
+class ComponentInstance;
+
+/**
+* A non-owning handle to an entity that belongs to a model: just the C API reference, with no ownership bookkeeping or conversion to SUEntityRef.  Handles are trivially copyable and the same size as a pointer, so millions of them can be held in vectors, sets or hash maps cheaply.  They are compared and hashed by the entity they point to.
+*
+* A handle is not checked against the entity being deleted, and it is up to the caller to only use it while the entity exists.  get() creates the full wrapper object when one is needed.
+*/
+template <typename Ref, typename Wrapper>
+class EntityHandle {
+  private:
+  Ref m_ref;
+
+  public:
+  /** Null handle. */
+  EntityHandle():
+    m_ref(SU_INVALID)
+  {}
+
+  explicit EntityHandle(Ref ref):
+    m_ref(ref)
+  {}
+
+  /** Handle to the entity that a wrapper object refers to. */
+  explicit EntityHandle(const Wrapper& wrapper):
+    m_ref(wrapper.ref())
+  {}
+
+  Ref ref() const {
+    return m_ref;
+  }
+
+  /**
+  * Returns the wrapper object for the entity.  The wrapper treats the entity as attached, so it never releases it.
+  */
+  Wrapper get() const {
+    return Wrapper(m_ref, true);
+  }
+
+  /** Returns true if the handle is null. */
+  bool operator!() const {
+    return SUIsInvalid(m_ref);
+  }
+
+  friend bool operator==(const EntityHandle& lhs, const EntityHandle& rhs) {
+    return lhs.m_ref.ptr == rhs.m_ref.ptr;
+  }
+
+  friend bool operator!=(const EntityHandle& lhs, const EntityHandle& rhs) {
+    return lhs.m_ref.ptr != rhs.m_ref.ptr;
+  }
+
+  /** Orders handles by address, for use in sorted containers. */
+  friend bool operator<(const EntityHandle& lhs, const EntityHandle& rhs) {
+    return std::less<void*>()(lhs.m_ref.ptr, rhs.m_ref.ptr);
+  }
+};
+
+typedef EntityHandle<SUFaceRef, Face> FaceHandle;
+typedef EntityHandle<SUEdgeRef, Edge> EdgeHandle;
+typedef EntityHandle<SUComponentInstanceRef, ComponentInstance> InstanceHandle;
+
+// Handles have the layout of the references they hold, so the C API can write arrays of references straight into arrays of handles.
+static_assert(sizeof(FaceHandle) == sizeof(SUFaceRef) && std::is_standard_layout<FaceHandle>::value && std::is_trivially_copyable<FaceHandle>::value, "CW::FaceHandle must be layout compatible with SUFaceRef");
+static_assert(sizeof(EdgeHandle) == sizeof(SUEdgeRef) && std::is_standard_layout<EdgeHandle>::value && std::is_trivially_copyable<EdgeHandle>::value, "CW::EdgeHandle must be layout compatible with SUEdgeRef");
+static_assert(sizeof(InstanceHandle) == sizeof(SUComponentInstanceRef) && std::is_standard_layout<InstanceHandle>::value && std::is_trivially_copyable<InstanceHandle>::value, "CW::InstanceHandle must be layout compatible with SUComponentInstanceRef");
+
+} /* namespace CW */
+
+namespace std {
+  template <typename Ref, typename Wrapper> struct hash<CW::EntityHandle<Ref, Wrapper>>
+  {
+    size_t operator()(const CW::EntityHandle<Ref, Wrapper>& handle) const
+    {
+      // Entities are allocated with at least 8 byte alignment, so the low bits of the address carry no information.  Mix in the high bits before dropping them.
+      const size_t address = reinterpret_cast<size_t>(handle.ref().ptr);
+      return (address >> 3) ^ (address >> 17);
+    }
+  };
+}
+
+#endif /* EntityHandle_hpp */
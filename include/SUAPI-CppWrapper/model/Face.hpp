@@ -58,9 +58,27 @@ class Vertex;
 class Loop;
 class LoopInput;
 class Edge;
+class Triangulator;
+struct TriangleMesh;
 
 class Face :public DrawingElement {
+  public:
+  /**
+  * Working memory for Face::triangulate().  Passing the same buffers for many faces avoids allocating per face.
+  */
+  struct TriangulationBuffers {
+    std::vector<SULoopRef> loops;
+    std::vector<SUVertexRef> vertices;
+    std::vector<SUPoint3D> points;
+    std::vector<size_t> loop_offsets;
+  };
+
   private:
+  /**
+  * Appends the inner loops of the face to the given vector.
+  */
+  void append_inner_loops(std::vector<Loop>& loops) const;
+
   /**
   * Creates a SUFaceRef object from an array of points that represent the outer loop.
   * @param outer_loop vector of points for the vertices in the outer loop.
@@ -109,12 +127,18 @@ class Face :public DrawingElement {
 
   /** Copy constructor */
   Face(const Face& other);
+
+  /** Move constructor. The other object is left null. */
+  Face(Face&& other) noexcept;
   
   /** Destructor */
   ~Face();
 
   /** Copy assignment operator */
   Face& operator=(const Face& other);
+
+  /** Move assignment operator. The other object is left null. */
+  Face& operator=(Face&& other) noexcept;
   
   /*
   * Returns the C-style face_ref object
@@ -202,16 +226,40 @@ class Face :public DrawingElement {
   * Gets an array of all of the inner loops that bound the face.
   */
   std::vector<Loop> inner_loops() const;
+
+  /**
+  * Fills the given vector with the inner loops of the face.  The vector's memory is reused, so a caller walking many faces can keep one vector for all of them.
+  */
+  void inner_loops(std::vector<Loop>& loops) const;
   
   /*
   * Gets an array of all of the loops that bound the face.  The first Loop is the outer loop.
   */
   std::vector<Loop> loops() const;
+  void loops(std::vector<Loop>& loops) const;
   
-  /*
-  // TODO
-  PolygonMesh mesh();
+  /**
+  * Triangulates the face, including its holes, without calling the SketchUp mesh helper.
+  * @return TriangleMesh holding the points of the face's loops and its triangles, wound counter-clockwise around the face normal.
+  */
+  TriangleMesh triangulate() const;
+
+  /**
+  * Triangulates the face and appends its points and triangles to the given mesh.
+  * @param mesh - the TriangleMesh to append to.
+  * @param triangulator - the Triangulator to use, so that its working memory is reused across faces.
+  * @return the number of triangles added.
+  */
+  size_t triangulate(TriangleMesh& mesh, Triangulator& triangulator) const;
+
+  /**
+  * Triangulates the face and appends its points and triangles to the given mesh, gathering the loops of the face into the given buffers.
+  * @param mesh - the TriangleMesh to append to.
+  * @param triangulator - the Triangulator to use, so that its working memory is reused across faces.
+  * @param buffers - the buffers to gather the loops of the face into, so that their memory is reused across faces.
+  * @return the number of triangles added.
   */
+  size_t triangulate(TriangleMesh& mesh, Triangulator& triangulator, TriangulationBuffers& buffers) const;
   
   /*
   * Retrieve the 3D vector normal to the face in the front direction.
@@ -259,6 +307,7 @@ class Face :public DrawingElement {
   * @return std::vector array of Vertex objects.
   */
   std::vector<Vertex> vertices() const;
+  void vertices(std::vector<Vertex>& vertices) const;
   
 };
 
@@ -0,0 +1,156 @@
+//
+//  FaceBVH.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef FaceBVH_hpp
+#define FaceBVH_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <vector>
+
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/component_instance.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/ComponentInstance.hpp"
+
+namespace CW {
+
+// Forward declarations
+class Entities;
+class InstancePath;
+class Transformation;
+
+/**
+* Result of a ray test.  A RayTestResult with a null face means nothing was hit.
+*/
+struct RayTestResult {
+  /** The face that was hit. */
+  Face face;
+  /** The distance along the ray from its origin to the hit point. */
+  double distance = 0.0;
+  /** The hit point, in the coordinates of the Entities object the FaceBVH was built from. */
+  Point3D point;
+  /** The component instances and groups containing the face, starting with the outermost. */
+  std::vector<ComponentInstance> instances;
+
+  /**
+  * Returns true if nothing was hit.
+  */
+  bool operator!() const;
+
+  /**
+  * Creates the InstancePath object of the hit, with the face set as its leaf.
+  */
+  InstancePath instance_path() const;
+};
+
+/**
+* A bounding volume hierarchy over every face of an Entities object, including the faces nested in its groups and component instances.
+*
+* The face geometry is copied and transformed to the coordinates of the Entities object when the FaceBVH is built, so ray tests do not call the C API. A FaceBVH object is not modified by ray tests, so raytest() can be called from several threads at once.  The FaceBVH must be rebuilt if the model is changed.
+*/
+class FaceBVH {
+  private:
+  struct Node {
+    SUBoundingBox3D bounds;
+    // For leaf nodes the index of the first face in m_face_order, otherwise the index of the second child node.  The first child node always follows its parent.
+    uint32_t index;
+    // Number of faces in a leaf node.  0 for interior nodes.
+    uint32_t count;
+  };
+
+  struct FaceRecord {
+    SUFaceRef face;
+    Plane3D plane;
+    SUBoundingBox3D bounds;
+    // Loops of the face are m_loop_offsets[first_loop] to m_loop_offsets[last_loop]
+    size_t first_loop;
+    size_t last_loop;
+    // Index in m_paths of the instances that contain this face.
+    uint32_t path;
+  };
+
+  std::vector<Node> m_nodes;
+  std::vector<FaceRecord> m_faces;
+  std::vector<uint32_t> m_face_order;
+  std::vector<SUPoint3D> m_points;
+  std::vector<size_t> m_loop_offsets;
+  std::vector<std::vector<SUComponentInstanceRef>> m_paths;
+
+  /**
+  * Copies the faces of the entities, and those nested within, into the face and point arrays.
+  */
+  void add_entities(const Entities& entities, const Transformation& transform, uint32_t path);
+
+  /**
+  * Creates the node for the faces between first and last in m_face_order, and splits them further if needed.
+  */
+  void build_node(uint32_t first, uint32_t last);
+
+  /**
+  * Returns the distance along the ray to the face, or a negative value if the ray does not hit the face.
+  */
+  double intersect_face(const FaceRecord& face, const Point3D& origin, const Vector3D& direction, double max_distance) const;
+  
+  public:
+  /** Maximum number of faces in a leaf node. */
+  static constexpr uint32_t LEAF_SIZE = 4;
+
+  /**
+  * Constructs an empty FaceBVH object, which will never return a hit.
+  */
+  FaceBVH();
+
+  /**
+  * Builds the hierarchy over the faces of the entities object, recursing into groups and component instances.
+  */
+  FaceBVH(const Entities& entities);
+
+  /**
+  * Returns the closest face that a ray drawn from the point in the given direction hits.
+  * @param origin - the point from which the ray is drawn.
+  * @param direction - the direction of the ray.  It does not need to be a unit vector.
+  * @return the RayTestResult of the closest hit.  If nothing is hit, the face of the result will be null.
+  */
+  RayTestResult raytest(const Point3D& origin, const Vector3D& direction) const;
+
+  /**
+  * Returns the number of faces held in the hierarchy.
+  */
+  size_t num_faces() const;
+
+  /**
+  * Returns the bounding box of all the faces held in the hierarchy.
+  */
+  BoundingBox3D bounding_box() const;
+};
+
+} /* namespace CW */
+#endif /* FaceBVH_hpp */
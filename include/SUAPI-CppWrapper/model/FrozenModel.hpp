@@ -0,0 +1,278 @@
+//
+//  FrozenModel.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef FrozenModel_hpp
+#define FrozenModel_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SketchUpAPI/color.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/entity.h>
+#include <SketchUpAPI/model/material.h>
+
+#include "SUAPI-CppWrapper/Span.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/Transformation.hpp"
+#include "SUAPI-CppWrapper/model/AttributeSnapshot.hpp"
+
+namespace CW {
+
+// Forward declarations
+class Model;
+
+/**
+* Immutable copy of a model's definitions, instances, faces, edges, loops, layers, materials and attributes, read from the SDK in one pass by Model::freeze().
+*
+* Every kind of object is held in one flat array, and objects refer to each other by their index in those arrays.  The objects of each definition are contiguous, so a definition refers to its faces, edges and instances by a Range of indices.  Names, dictionary names and attribute keys are interned: each distinct string is stored once, and referred to by its string index.
+*
+* A FrozenModel makes no calls to the SketchUp API once it has been built, and none of its methods modify it, so any number of threads can query it at the same time.  It is not updated when the model changes; freeze the model again to see the changes.
+*/
+class FrozenModel {
+  public:
+  typedef uint32_t Index;
+
+  /** Index given to a missing material, layer or name. */
+  static constexpr Index NO_INDEX = UINT32_MAX;
+
+  /** Index of the definition that holds the model's own entities. */
+  static constexpr Index ROOT = 0;
+
+  /**
+  * The indices [begin, end) of a run of objects in one of the arrays.
+  */
+  struct Range {
+    Index begin;
+    Index end;
+
+    size_t size() const { return end - begin; }
+    bool empty() const { return begin == end; }
+  };
+
+  /**
+  * An attribute of an entity.  The attributes of an entity are grouped by dictionary.
+  */
+  struct Attribute {
+    Index dictionary; // string index of the dictionary name
+    Index key; // string index of the key
+    AttributeValue value;
+  };
+
+  struct Layer {
+    Index name;
+    Range attributes;
+  };
+
+  struct Material {
+    Index name;
+    SUMaterialType type;
+    SUColor color;
+    double opacity;
+    bool use_opacity;
+    Range attributes;
+  };
+
+  /**
+  * A component definition or the definition of a group.  The definition at index ROOT holds the model's own entities, and has an empty name.
+  */
+  struct Definition {
+    Index name;
+    bool group;
+    Range faces;
+    Range edges;
+    Range instances; // the instances and groups placed in this definition's entities
+    Range attributes;
+  };
+
+  /**
+  * A component instance or group.
+  */
+  struct Instance {
+    Index definition; // the definition that is placed
+    Index parent; // the definition whose entities hold the instance
+    Index name;
+    Index layer;
+    Index material;
+    bool hidden;
+    Transformation transformation; // relative to the parent's entities
+    Range attributes;
+  };
+
+  /**
+  * A loop of a face.  Vertex i of the loop is loop_vertices()[i], and edge i joins it to the next vertex.
+  */
+  struct Loop {
+    Range vertices; // indices into the loop vertex and loop edge arrays
+  };
+
+  struct Face {
+    Range loops; // the first loop is the outer loop
+    Index front_material;
+    Index back_material;
+    Index layer;
+    bool hidden;
+    SUVector3D normal;
+    Range attributes;
+  };
+
+  struct Edge {
+    Index start; // vertex index
+    Index end; // vertex index
+    Index layer;
+    Index material;
+    bool hidden;
+    bool soft;
+    bool smooth;
+    Range attributes;
+  };
+
+  private:
+  class Builder;
+  friend class Builder;
+  friend class ModelCache;
+
+  std::vector<Definition> m_definitions;
+  std::vector<Instance> m_instances;
+  std::vector<Face> m_faces;
+  std::vector<Loop> m_loops;
+  std::vector<Index> m_loop_vertices;
+  std::vector<Index> m_loop_edges;
+  std::vector<Edge> m_edges;
+  std::vector<SUPoint3D> m_vertices;
+  std::vector<Layer> m_layers;
+  std::vector<Material> m_materials;
+  std::vector<Attribute> m_attributes;
+  Range m_model_attributes;
+
+  // Interned strings, each followed by a null terminator.  String i is at m_characters[m_string_offsets[i]], and has m_string_offsets[i+1] - m_string_offsets[i] - 1 characters.
+  std::vector<char> m_characters;
+  std::vector<uint32_t> m_string_offsets;
+  // Open addressing table of string indices, by hash of the string.  The size is a power of two.
+  std::vector<Index> m_string_slots;
+
+  // Definitions, layers and materials sorted by the string index of their name, for the find_*() methods.
+  std::vector<Index> m_definitions_by_name;
+  std::vector<Index> m_layers_by_name;
+  std::vector<Index> m_materials_by_name;
+
+  static size_t hash_string(const char* data, size_t size);
+
+  /**
+  * Returns the slot holding the string, or the empty slot where it would be inserted.
+  */
+  size_t find_slot(const char* data, size_t size) const;
+
+  public:
+  /**
+  * Reads the whole model.  Model::freeze() is the usual way to build a FrozenModel.
+  * @param model - the model to copy.  Must not be null.
+  */
+  explicit FrozenModel(const Model& model);
+
+  FrozenModel(const FrozenModel&) = delete;
+  FrozenModel& operator=(const FrozenModel&) = delete;
+
+  /**
+  * Returns the arrays of objects.  The objects of each definition are the subspan of its Range.
+  */
+  Span<const Definition> definitions() const;
+  Span<const Instance> instances() const;
+  Span<const Face> faces() const;
+  Span<const Loop> loops() const;
+  Span<const Edge> edges() const;
+  Span<const Layer> layers() const;
+  Span<const Material> materials() const;
+
+  /**
+  * Returns the positions of the vertices.  Vertices are shared by the faces and edges of a definition.
+  */
+  Span<const SUPoint3D> vertices() const;
+
+  /**
+  * Returns the objects in a range of the matching array, for example faces(definitions()[i].faces).
+  */
+  Span<const Face> faces(const Range& range) const;
+  Span<const Edge> edges(const Range& range) const;
+  Span<const Instance> instances(const Range& range) const;
+  Span<const Loop> loops(const Range& range) const;
+  Span<const Attribute> attributes(const Range& range) const;
+
+  /**
+  * Returns the vertex indices, and the edge indices, of a loop.
+  */
+  Span<const Index> loop_vertices(const Loop& loop) const;
+  Span<const Index> loop_edges(const Loop& loop) const;
+
+  /**
+  * Returns the attributes of the model itself.
+  */
+  Range model_attributes() const;
+
+  /**
+  * Returns the value of an attribute in a range of attributes, or nullptr if there is none.
+  * @param attributes - the attributes of an object, for example faces()[i].attributes.
+  */
+  const AttributeValue* attribute(const Range& attributes, const std::string& dictionary, const std::string& key) const;
+
+  /**
+  * Returns an interned string.  The view stays valid for the lifetime of the FrozenModel.
+  */
+  StringView string(Index index) const;
+
+  /**
+  * Returns the index of an interned string, or NO_INDEX if no object has that name or key.
+  */
+  Index find_string(const std::string& string) const;
+
+  /**
+  * Returns the number of interned strings.
+  */
+  size_t num_strings() const;
+
+  /**
+  * Finds a definition, layer or material by its name.
+  * @return the index of the object, or NO_INDEX if there is none.
+  */
+  Index find_definition(const std::string& name) const;
+  Index find_layer(const std::string& name) const;
+  Index find_material(const std::string& name) const;
+
+  /**
+  * Returns the number of bytes of memory held by the FrozenModel.  Attribute strings and arrays are included; allocator overhead is not.
+  */
+  size_t memory_size() const;
+};
+
+/** Shared handle to a FrozenModel, which can be passed to any number of threads. */
+using FrozenModelPtr = std::shared_ptr<const FrozenModel>;
+
+} /* namespace CW */
+#endif /* FrozenModel_hpp */
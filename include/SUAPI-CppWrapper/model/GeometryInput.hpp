@@ -30,15 +30,20 @@
 
 #include <stdio.h>
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <array>
+#include <memory>
 #include <unordered_map>
 #include <cmath>
+#include <cstdint>
 
 #include <SketchUpAPI/geometry.h>
 #include <SketchUpAPI/model/entities.h>
 
 #include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Span.hpp"
+#include "SUAPI-CppWrapper/VertexWelder.hpp"
 
 namespace CW {
 
@@ -52,6 +57,17 @@ class MaterialInput;
 class Layer;
 class LoopInput;
 
+/**
+* Optional per-face properties for GeometryInput::add_indexed_mesh().  Each span is either empty, or holds one entry for every face of the mesh.  Null materials and layers are skipped.
+*/
+struct IndexedMeshFaceProperties {
+  Span<const Material> front_materials;
+  Span<const Material> back_materials;
+  Span<const Layer> layers;
+  // Non-zero entries make all edges of the face's loop soft and smooth.
+  Span<const uint8_t> smooth_edges;
+};
+
 /**
 * Geometry Input class is an abstraction of Sketchup C API's SUGeometryInputRef object.  It allows a much easier way for programmers to build Sketchup geometry within this class, before exporting it into a built SUGeometryInputRef object.
 * See below for an example of GeometryInput operates:
@@ -62,21 +78,34 @@ std::vector<std::vector<SUPoint3D>> inner_loops{{SUPoint3D(0.1,0.1,0.0), SUPoint
 GIFace* face = geom_input.add_face(outer_loop, inner_loops); // GeometryInput handles the interface with Sketchup C API when creating geometry.
 SUResult result = entities.fill(geom_input); // the geometry must be output into a SUEntitiesRef object.
 
+* Copies of a GeometryInput object share the same SUGeometryInputRef, which is released when the last copy is destroyed.  Copying, moving and destroying GeometryInput objects is thread safe, so geometry can be built on worker threads and handed to the thread that calls Entities::fill().  A single GeometryInput must still only be modified by one thread at a time.
 */
 class GeometryInput {
   friend class Entities;
   
 private:
+  /**
+  * State shared by all copies of a GeometryInput object, with an intrusive reference count.  The last copy to let go of it releases the SUGeometryInputRef.
+  */
+  struct Shared {
+    SUGeometryInputRef geometry_input;
+    std::atomic<size_t> ref_count;
+    // The index the next added vertex will get.  Kept here so all copies agree on it.
+    size_t vertex_index;
+    // Set while vertex welding is on.
+    std::unique_ptr<VertexWelder> welder;
+  };
+
+  Shared* m_shared;
   SUGeometryInputRef m_geometry_input;
   
-  bool m_attached;
   // GeometryInput objects require that the target model (for inputting information) be known, to ensure that materials and layers assigned to geometry exists in the target model.
   SUModelRef m_target_model;
-  
-  size_t m_vertex_index = 0;
 
-  // Tracks the number of GeometrryInput objects have been allocated, to allow the destructor to release an object only at the right time.
-  static std::unordered_map<SUGeometryInputRef, size_t> num_objects_;
+  /**
+  * Drops this object's reference to the shared state, releasing the SUGeometryInputRef if it was the last one.
+  */
+  void release() noexcept;
 
   /**
   * Creates and returns new SUGeometryInputRef object, used for initializing m_geometry_input. The SUGeometryInputRef object must be released with SUGeometryInputRelease() before this class is destroyed.
@@ -91,7 +120,10 @@ public:
   GeometryInput(SUModelRef target_model);
 
   /** Copy Constructor **/
-  GeometryInput(const GeometryInput& other);
+  GeometryInput(const GeometryInput& other) noexcept;
+
+  /** Move Constructor. The other object is left null. **/
+  GeometryInput(GeometryInput&& other) noexcept;
   
   /** Destructor  */
   ~GeometryInput();
@@ -99,7 +131,12 @@ public:
   /**
   * Copy assignment operator.
   */
-  GeometryInput& operator=(const GeometryInput& other);
+  GeometryInput& operator=(const GeometryInput& other) noexcept;
+
+  /**
+  * Move assignment operator. The other object is left null.
+  */
+  GeometryInput& operator=(GeometryInput&& other) noexcept;
    
   /**
   * Returns Raw SUGeometryInputRef that is stored.
@@ -138,11 +175,27 @@ public:
   bool empty() const;
   
   /**
-  * Adds a vertex to the GeometryInput object.
+  * Adds a vertex to the GeometryInput object.  If vertex welding is on and a coincident vertex has already been added, no vertex is added and the index of the existing one is returned.
   * @param point - the Point3D location of the vertex to add.
   * @return the index number of the added vertex
   */
   size_t add_vertex(const Point3D& point);
+
+  /**
+  * Returns true if vertex welding is on.
+  */
+  bool weld_vertices() const;
+
+  /**
+  * Turns vertex welding on or off.  While it is on, add_vertex() - and so add_face() and add_edge() - reuse the index of any vertex already added within Point3D::EPSILON of the new one, so that corners shared by several faces are only passed to SketchUp once.  Only vertices added while welding is on are welded together.
+  * @param weld - true to turn welding on.  Turning it off forgets the vertices seen so far.
+  */
+  void weld_vertices(bool weld);
+
+  /**
+  * Returns the number of vertices that welding has merged into existing ones, so were not added.
+  */
+  size_t welded_vertices() const;
   
   /**
   * Sets all vertices of a geometry input object. Any existing vertices will be overridden.
@@ -150,6 +203,18 @@ public:
   */
   void set_vertices(const std::vector<SUPoint3D>& points);
   void set_vertices(const std::vector<Point3D>& points);
+
+  /**
+  * Adds a whole indexed polygon mesh, as read by STL, OBJ or point cloud importers, in one call.  The vertices are passed to SketchUp with a single SUGeometryInputSetVertices() call when nothing has been added to this object yet (and vertex welding is off); otherwise they are appended and the indices offset to match.
+  * Faces whose loops SketchUp rejects - typically degenerate triangles, or faces that collapse once their vertices are welded - are skipped.
+  * @param vertices - the mesh vertices.
+  * @param indices - the vertex indices of every face loop, one face after another.
+  * @param face_offsets - the position in indices of the first index of each face.  A face ends where the next one starts, and the last face at the end of indices.
+  * @param properties - (optional) per-face materials, layers and smoothing.
+  * @return the number of faces added.
+  * @throws std::invalid_argument if the offsets are not ascending, a face has fewer than three indices, an index is out of range or a property span has the wrong size.
+  */
+  size_t add_indexed_mesh(Span<const SUPoint3D> vertices, Span<const uint32_t> indices, Span<const uint32_t> face_offsets, const IndexedMeshFaceProperties& properties = IndexedMeshFaceProperties());
   
   /**
   * Adds an edge to a geometry input object. This method is intended for specifying edges which are not associated with loop inputs. For specifying edge properties on a face use the SULoopInput interface. More...
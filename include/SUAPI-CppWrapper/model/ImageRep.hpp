@@ -33,6 +33,7 @@
 
 #include <SketchUpAPI/model/image_rep.h>
 
+#include "SUAPI-CppWrapper/Span.hpp"
 #include "SUAPI-CppWrapper/model/Entity.hpp"
 
 namespace CW {
@@ -58,12 +59,18 @@ class ImageRep  {
   
   /** Copy constructor */
   ImageRep(const ImageRep& other);
+
+  /** Move constructor. The other object is left null. */
+  ImageRep(ImageRep&& other) noexcept;
   
   /** Destructor */
   ~ImageRep();
 
   /** Copy assignment operator */
   ImageRep& operator=(const ImageRep& other);
+
+  /** Move assignment operator. The other object is left null. */
+  ImageRep& operator=(ImageRep&& other) noexcept;
   
   /**
   * Returns whether this is a valid object.
@@ -84,8 +91,10 @@ class ImageRep  {
   
   /**
   * Sets the image data for the given image. Makes a copy of the data rather than taking ownership.
+  * @param pixel_data - the pixels, height rows of width * bits_per_pixel / 8 + row_padding bytes.  A std::vector<SUByte> can be passed directly.
+  * @throws std::invalid_argument if pixel_data is too small for the given size.
   */
-  void set_data(size_t width, size_t height, size_t bits_per_pixel, size_t row_padding, std::vector<SUByte> pixel_data);
+  void set_data(size_t width, size_t height, size_t bits_per_pixel, size_t row_padding, Span<const SUByte> pixel_data);
   
   /**
   * Loads an image from a file path.
@@ -134,9 +143,23 @@ class ImageRep  {
   size_t bits_per_pixel() const;
   
   /**
-  * Returns the pixel data for an image.
+  * Returns the pixel data for an image.  To avoid allocating a new vector on every call, use read_pixels() with a buffer that is reused.
   */
   std::vector<SUByte> pixel_data() const;
+
+  /**
+  * Copies the pixel data of the image into a buffer supplied by the caller.
+  * @param pixels - the buffer to copy into.  Must hold at least data_size() bytes.
+  * @throws std::invalid_argument if the buffer is too small.
+  */
+  void read_pixels(Span<SUByte> pixels) const;
+
+  /**
+  * Replaces the pixel data of the image, keeping its width, height, bits per pixel and row padding.
+  * @param pixels - the new pixel data.  Must hold at least data_size() bytes.
+  * @throws std::invalid_argument if the buffer is too small.
+  */
+  void write_pixels(Span<const SUByte> pixels);
 };
 
 } // END namespace CW
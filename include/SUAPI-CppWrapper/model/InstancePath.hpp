@@ -66,12 +66,18 @@ class InstancePath {
 
   /** Copy constructor */
   InstancePath(const InstancePath& other);
+
+  /** Move constructor. The other object is left null. */
+  InstancePath(InstancePath&& other) noexcept;
   
   /** Destructor */
   ~InstancePath();
 
   /** Copy assignment operator */
   InstancePath& operator=(const InstancePath& other);
+
+  /** Move assignment operator. The other object is left null. */
+  InstancePath& operator=(InstancePath&& other) noexcept;
   
   /*
   * The class object can be converted to a SUInstancePathRef without loss of data.
@@ -60,12 +60,18 @@ class Layer :public Entity {
   
   /** Copy Constructor */
   Layer(const Layer& other);
+
+  /** Move constructor. The other object is left null. */
+  Layer(Layer&& other) noexcept;
   
   /** Destructor */
   ~Layer();
   
   /** Copy assignment operator */
   Layer& operator=(const Layer& other);
+
+  /** Move assignment operator. The other object is left null. */
+  Layer& operator=(Layer&& other) noexcept;
   
   /**
   * Returns the SULayerRef object that this class wraps
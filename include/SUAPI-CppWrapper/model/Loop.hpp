@@ -96,15 +96,26 @@ class Loop :public Entity {
   */
   std::vector<Edge> edges() const;
 
+  /**
+  * Fills the given vector with the Edges in the Loop, reusing its memory.
+  */
+  void edges(std::vector<Edge>& edges) const;
+
   /**
   * Returns the Vertices in the Loop
   */
   std::vector<Vertex> vertices() const;
+  void vertices(std::vector<Vertex>& vertices) const;
   
   /**
   * Returns the points representing the vertices in the Loop
   */
   std::vector<Point3D> points() const;
+
+  /**
+  * Fills the given vector with the points of the vertices in the Loop, reusing its memory.  No Vertex objects are created.
+  */
+  void points(std::vector<Point3D>& points) const;
   
   /**
   * Determine where on the loop a point lies.  @see PointLoopClassify.
@@ -118,7 +129,7 @@ class Loop :public Entity {
   size_t size() const;
   
   /**
-  * Returns whether a point is within a loop, given by the vector of points.
+  * Returns whether a point is within a loop, given by the vector of points.  To classify many points against the same loop, use PreparedLoop instead.
   * @param loop_points - a vector of points representing the vertices of a loop.
   * @param test_point - the point to test within the loop.
   * @return PointLoopClassify object describing the location of the point relative to the loop.
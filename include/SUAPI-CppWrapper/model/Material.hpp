@@ -57,9 +57,15 @@ class Material :public Entity {
   
   /** Copy constructor */
   Material(const Material& other);
+
+  /** Move constructor. The other object is left null. */
+  Material(Material&& other) noexcept;
   
   /** Copy assigment operator */
   Material& operator=(const Material& other);
+
+  /** Move assignment operator. The other object is left null. */
+  Material& operator=(Material&& other) noexcept;
   
   /**
   * Destructor
@@ -0,0 +1,80 @@
+//
+//  MeshSnapshot.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MeshSnapshot_hpp
+#define MeshSnapshot_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <vector>
+
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/material.h>
+#include <SketchUpAPI/model/layer.h>
+
+namespace CW {
+
+/**
+* Structure-of-arrays copy of the face geometry of an Entities object, filled in a single pass by Entities::mesh_snapshot().
+*
+* Loop i of the snapshot has the positions positions[loop_offsets[i]] to positions[loop_offsets[i+1] - 1].
+* Face f of the snapshot has the loops face_loop_offsets[f] to face_loop_offsets[f+1] - 1, the first of which is the outer loop.
+* Materials and layers are stored once each, and faces refer to them by their index in the materials and layers arrays.
+*/
+struct MeshSnapshot {
+  /** Id given to faces that have no material or layer. */
+  static constexpr uint32_t NO_ID = UINT32_MAX;
+
+  std::vector<SUPoint3D> positions;
+  std::vector<size_t> loop_offsets;
+  std::vector<size_t> face_loop_offsets;
+  std::vector<SUFaceRef> faces;
+  std::vector<uint32_t> front_material_ids;
+  std::vector<uint32_t> back_material_ids;
+  std::vector<uint32_t> layer_ids;
+  std::vector<SUMaterialRef> materials;
+  std::vector<SULayerRef> layers;
+
+  /**
+  * Returns the number of faces held in the snapshot.
+  */
+  size_t num_faces() const;
+
+  /**
+  * Returns the number of loops held in the snapshot.
+  */
+  size_t num_loops() const;
+
+  /**
+  * Empties the snapshot, keeping the memory that has been allocated so that it can be filled again.
+  */
+  void clear();
+};
+
+} /* namespace CW */
+#endif /* MeshSnapshot_hpp */
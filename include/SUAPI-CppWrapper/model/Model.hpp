@@ -29,6 +29,7 @@
 #define Model_hpp
 
 #include <stdio.h>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,11 @@ namespace CW {
   class ShadowInfo;
   class OptionsManager;
   class InstancePath;
+  class Point3D;
+  class Vector3D;
+  struct RayTestResult;
+  class ModelRegistry;
+  class FrozenModel;
 
   
 class Model {
@@ -165,6 +171,11 @@ class Model {
   */
   std::vector<ComponentDefinition> definitions() const;
 
+  /*
+  * Fills the given vector with the ComponentDefinitions in this model, reusing its memory.
+  */
+  void definitions(std::vector<ComponentDefinition>& definitions) const;
+
   /*
   * Returns the list of Group ComponentDefinitions in this model
   * @return definitions vector array of definitions.
@@ -211,6 +222,7 @@ class Model {
   * @return layers a vector array of Layer objects in the model.
   */
   std::vector<Layer> layers() const;
+  void layers(std::vector<Layer>& layers) const;
    
   /**
   * Add layers to the model.
@@ -219,7 +231,7 @@ class Model {
   void add_layers(std::vector<Layer>& layers);
 
   /**
-  * Checks if the given layer is in the list of layers in this model.  This is an expensive method, and is recommended to be used only in debugging.
+  * Checks if the given layer is in the list of layers in this model.  The lookup goes through the model's ModelRegistry, so only the first call after the layers are edited has to fetch the list of layers.  Edits made through the C API may need ModelRegistry::invalidate(), as described there.
   * @param layer - the layer object to check
   * @return true if the layer is in the model.
   */
@@ -236,6 +248,7 @@ class Model {
   * @return materials vector array of Material objects in the model.
   */
   std::vector<Material> materials() const;
+  void materials(std::vector<Material>& materials) const;
 
   /**
   * Add materials to the model.
@@ -244,11 +257,16 @@ class Model {
   void add_materials(std::vector<Material>& materials);
   
   /**
-  * Checks if the given material is in the list of materials in this model.  This is a very expensive method, and is recommended to be used only in debugging.
+  * Checks if the given material is in the list of materials in this model.  The lookup goes through the model's ModelRegistry, so only the first call after the materials are edited has to fetch the list of materials.  Edits made through the C API may need ModelRegistry::invalidate(), as described there.
   * @param material - the material object to check
   * @return true if the material is in the model.
   */
   bool material_exists(const Material& material) const;
+
+  /**
+  * Returns the hashed indexes of the materials, layers and component definitions of the model, shared by all Model objects wrapping the same SUModelRef.
+  */
+  std::shared_ptr<ModelRegistry> registry() const;
   
   /*
   * Returns the name of the model
@@ -282,9 +300,19 @@ class Model {
   //std::string path() const;
   
   /*
-  * Returns the first Entity object that a ray from a given point and direction vector will hit.
+  * Copies the definitions, instances, geometry, layers, materials and attributes of the model into an immutable FrozenModel, in one pass.  The FrozenModel can then be queried from any number of threads without calling the SketchUp API.
+  * @return shared handle to the FrozenModel.
+  */
+  std::shared_ptr<const FrozenModel> freeze() const;
+
+  /*
+  * Returns the first Face that a ray from a given point and direction vector will hit, searching through all groups and component instances.
+  * Note that this builds a FaceBVH over the whole model on every call.  To cast many rays, build a FaceBVH once and use FaceBVH::raytest().
+  * @param point - the point from which the ray is drawn.
+  * @param vector - the direction of the ray.
+  * @return RayTestResult of the hit.  If nothing is hit, the face of the result is null.
   */
-  //Entity raytest(Point3D point, Vector3D vector);
+  RayTestResult raytest(const Point3D& point, const Vector3D& vector) const;
   
   /*
   * Saves the model in the file path given.
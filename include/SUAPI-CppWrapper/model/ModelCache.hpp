@@ -0,0 +1,255 @@
+//
+//  ModelCache.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef ModelCache_hpp
+#define ModelCache_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <SketchUpAPI/color.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/typed_value.h>
+
+#include "SUAPI-CppWrapper/Span.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/AttributeSnapshot.hpp"
+#include "SUAPI-CppWrapper/model/FrozenModel.hpp"
+
+namespace CW {
+
+/**
+* A FrozenModel saved to a binary file and mapped back into memory, so that tools that only read a model's geometry can skip loading the .skp file through the SDK.
+*
+* The file holds a header and a table of sections, then one section for each array of the FrozenModel, together with a triangulation of every face.  Each section is the array's elements exactly as they are laid out in memory, so opening the file only checks the header and the ranges of each definition, and maps the file: the arrays are read in place, and the operating system pages in each section when it is first touched.
+*
+* A cache file is keyed by the hash of the .skp file it was made from.  open() refuses a file whose key, version or memory layout does not match, or whose definitions or model attributes reach past the end of a section, and the caller then reads the model again and writes a new cache.  The other indices in the sections, such as those of loops, vertices and strings, are not checked, so a cache file is trusted: it must only be read by the build that wrote it, or one with the same VERSION on the same platform, and must not be edited or truncated by anything else.
+*
+* The objects have the same indices, and are queried in the same way, as those of the FrozenModel that was written.  A ModelCache is never modified, so any number of threads can query it at the same time.
+*/
+class ModelCache {
+  public:
+  typedef FrozenModel::Index Index;
+  typedef FrozenModel::Range Range;
+  typedef FrozenModel::Definition Definition;
+  typedef FrozenModel::Instance Instance;
+  typedef FrozenModel::Face Face;
+  typedef FrozenModel::Loop Loop;
+  typedef FrozenModel::Edge Edge;
+  typedef FrozenModel::Layer Layer;
+  typedef FrozenModel::Material Material;
+
+  /** Version of the file format.  Raised whenever the layout of the file or of the stored objects changes. */
+  static constexpr uint32_t VERSION = 1;
+
+  static constexpr Index NO_INDEX = FrozenModel::NO_INDEX;
+  static constexpr Index ROOT = FrozenModel::ROOT;
+
+  /**
+  * The value of an attribute, as it is stored in the file.  value() converts it to an AttributeValue.
+  */
+  struct Value {
+    SUTypedValueType type;
+    union {
+      int64_t integer; // byte, int16, int32, bool and time values
+      double real; // float and double values
+      SUColor color;
+      double vector[3];
+      Range characters; // string values: indices into the value characters, without the null terminator
+      Range items; // array values: indices of the item Values
+    };
+  };
+
+  /**
+  * An attribute of an entity.  The attributes of an entity are grouped by dictionary.
+  */
+  struct Attribute {
+    Index dictionary; // string index of the dictionary name
+    Index key; // string index of the key
+    Index value; // index of the Value
+  };
+
+  private:
+  struct Header;
+  struct Section;
+  enum SectionId: uint32_t;
+
+  // The mapped file.  m_file and m_mapping are only used on Windows.
+  const char* m_data;
+  size_t m_size;
+  void* m_file;
+  void* m_mapping;
+
+  const Header* m_header;
+
+  ModelCache();
+
+  /**
+  * Returns the size of the elements of a section, which a file must match to be read.
+  */
+  static uint32_t element_size(SectionId id);
+
+  /**
+  * Returns the elements of a section.
+  */
+  template <class T>
+  Span<const T> section(SectionId id) const;
+
+  /**
+  * Returns the slot holding the string, or the empty slot where it would be inserted.
+  */
+  size_t find_slot(const char* data, size_t size) const;
+
+  public:
+  ~ModelCache();
+
+  ModelCache(const ModelCache&) = delete;
+  ModelCache& operator=(const ModelCache&) = delete;
+
+  /**
+  * Returns the hash of a file's contents, used as the key of the cache made from it.
+  * @throws std::invalid_argument if the file cannot be read.
+  */
+  static uint64_t hash_file(const std::string& file_path);
+
+  /**
+  * Writes a FrozenModel to a cache file.  The file is written under a temporary name unique to this process and call, and then renamed, so a reader never sees a file that is only partly written.
+  * @param model - the model to write.
+  * @param source_hash - the key of the cache, usually hash_file() of the .skp file that the model was read from.
+  * @param cache_path - the path of the cache file, which is replaced if it exists.
+  * @return true if the file was written, false if it could not be.
+  */
+  static bool write(const FrozenModel& model, uint64_t source_hash, const std::string& cache_path);
+
+  /**
+  * Maps a cache file into memory.
+  * @param cache_path - the path of the cache file.
+  * @param source_hash - the key that the cache must have been written with.
+  * @return the cache, or nullptr if the file does not exist, has a different key, was written with a different VERSION or memory layout, or has a definition or model attribute range outside its section.
+  */
+  static std::shared_ptr<const ModelCache> open(const std::string& cache_path, uint64_t source_hash);
+
+  /**
+  * Returns the key that the cache was written with.
+  */
+  uint64_t source_hash() const;
+
+  /**
+  * Returns the size of the cache file in bytes.
+  */
+  size_t file_size() const;
+
+  /**
+  * Returns the arrays of objects.  The objects of each definition are the subspan of its Range.
+  */
+  Span<const Definition> definitions() const;
+  Span<const Instance> instances() const;
+  Span<const Face> faces() const;
+  Span<const Loop> loops() const;
+  Span<const Edge> edges() const;
+  Span<const Layer> layers() const;
+  Span<const Material> materials() const;
+
+  /**
+  * Returns the positions of the vertices.  Vertices are shared by the faces and edges of a definition.
+  */
+  Span<const SUPoint3D> vertices() const;
+
+  /**
+  * Returns the objects in a range of the matching array, for example faces(definitions()[i].faces).
+  */
+  Span<const Face> faces(const Range& range) const;
+  Span<const Edge> edges(const Range& range) const;
+  Span<const Instance> instances(const Range& range) const;
+  Span<const Loop> loops(const Range& range) const;
+  Span<const Attribute> attributes(const Range& range) const;
+
+  /**
+  * Returns the vertex indices, and the edge indices, of a loop.
+  */
+  Span<const Index> loop_vertices(const Loop& loop) const;
+  Span<const Index> loop_edges(const Loop& loop) const;
+
+  /**
+  * Returns the triangles of a run of faces, as three vertex indices per triangle wound counter-clockwise around the face normal.  The triangles of a definition, triangles(definitions()[i].faces), make one index buffer over vertices().
+  * @param faces - a range of face indices.
+  */
+  Span<const Index> triangles(const Range& faces) const;
+
+  /**
+  * Returns the attributes of the model itself.
+  */
+  Range model_attributes() const;
+
+  /**
+  * Returns the value of an attribute in a range of attributes, or an empty value if there is none.
+  * @param attributes - the attributes of an object, for example faces()[i].attributes.
+  */
+  AttributeValue attribute(const Range& attributes, const std::string& dictionary, const std::string& key) const;
+
+  /**
+  * Returns the stored values, and converts one of them to an AttributeValue.
+  */
+  Span<const Value> values() const;
+  AttributeValue value(Index index) const;
+
+  /**
+  * Returns the characters of a string value.  The view stays valid for the lifetime of the ModelCache.
+  */
+  StringView string_value(const Value& value) const;
+
+  /**
+  * Returns an interned string.  The view stays valid for the lifetime of the ModelCache.
+  */
+  StringView string(Index index) const;
+
+  /**
+  * Returns the index of an interned string, or NO_INDEX if no object has that name or key.
+  */
+  Index find_string(const std::string& string) const;
+
+  /**
+  * Returns the number of interned strings.
+  */
+  size_t num_strings() const;
+
+  /**
+  * Finds a definition, layer or material by its name.
+  * @return the index of the object, or NO_INDEX if there is none.
+  */
+  Index find_definition(const std::string& name) const;
+  Index find_layer(const std::string& name) const;
+  Index find_material(const std::string& name) const;
+};
+
+/** Shared handle to a ModelCache, which can be passed to any number of threads. */
+using ModelCachePtr = std::shared_ptr<const ModelCache>;
+
+} /* namespace CW */
+#endif /* ModelCache_hpp */
@@ -0,0 +1,147 @@
+//
+//  ModelRegistry.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef ModelRegistry_hpp
+#define ModelRegistry_hpp
+
+#include <stdio.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <SketchUpAPI/model/model.h>
+#include <SketchUpAPI/model/component_definition.h>
+#include <SketchUpAPI/model/layer.h>
+#include <SketchUpAPI/model/material.h>
+
+namespace CW {
+
+// Forward declarations
+class ComponentDefinition;
+class Layer;
+class Material;
+
+/**
+* Hashed indexes of the materials, layers and component definitions of a model, by reference and by name.
+*
+* Model::material_exists(), Model::layer_exists() and the name lookups below go through here instead of fetching and scanning the full list from the SDK on every call.  Each index is built lazily on first use, and is checked against the SDK on every use rather than trusted until an edit through the wrapper: it is rebuilt when the number of objects in the model has changed, and an object found by name is only returned if the SDK still gives it that name.  Two kinds of edit made through the C API, rather than the wrapper, are not noticed:
+* - renaming an object to a name that is then looked up;
+* - removing objects and adding as many others between two lookups, which leaves the number unchanged, so lookups by reference such as Model::material_exists() and contains() answer from the old set.
+*
+* Call invalidate(), or the invalidate method for the kind of object, after making such edits.
+*
+* There is one registry per SUModelRef, shared by every Model object wrapping that reference, so temporary Model objects such as Model(ref, false) reuse the same indexes.  All methods are thread safe.
+*/
+class ModelRegistry {
+  private:
+  struct Index {
+    std::unordered_set<const void*> refs;
+    std::unordered_map<std::string, const void*> names;
+    size_t count = 0; // number of objects the SDK reported when the index was built
+    bool dirty = true;
+    size_t name_generation = 0;
+  };
+
+  SUModelRef m_model;
+  mutable std::mutex m_mutex;
+  Index m_materials;
+  Index m_layers;
+  Index m_definitions;
+  size_t m_rebuilds = 0;
+
+  explicit ModelRegistry(SUModelRef model);
+
+  /**
+  * Brings the given index up to date, rebuilding it if it has been invalidated.  Must be called with m_mutex held.
+  * @param names - if true, also rebuild it if any object has been renamed since it was built.
+  */
+  void update_materials(bool names);
+  void update_layers(bool names);
+  void update_definitions(bool names);
+
+  public:
+  ModelRegistry(const ModelRegistry&) = delete;
+  ModelRegistry& operator=(const ModelRegistry&) = delete;
+
+  /**
+  * Returns the registry for the given model, creating it on first use.
+  * @param model - the model the registry belongs to.  Must not be invalid.
+  */
+  static std::shared_ptr<ModelRegistry> get(SUModelRef model);
+
+  /**
+  * Discards the registry for the given model.  Called when the model is released, as the SDK may hand out the same reference for a later model.  A registry that is still held is detached from the model, and from then on finds nothing.
+  */
+  static void release(SUModelRef model);
+
+  /**
+  * Records that a material, layer or definition has been renamed, so every registry rebuilds its indexes on the next lookup by name.
+  */
+  static void names_changed();
+
+  /**
+  * Marks the indexes as stale, so they are rebuilt on their next use.
+  */
+  void invalidate();
+  void invalidate_materials();
+  void invalidate_layers();
+  void invalidate_definitions();
+
+  /**
+  * Returns true if the object belongs to this model.
+  */
+  bool contains(const Material& material);
+  bool contains(const Layer& layer);
+  bool contains(const ComponentDefinition& definition);
+
+  /**
+  * Finds an object by its name.
+  * @param name - the internal name of the material, layer or component definition.
+  * @return the object with the given name, or an invalid object if there is none.
+  */
+  Material material(const std::string& name);
+  Layer layer(const std::string& name);
+  ComponentDefinition definition(const std::string& name);
+
+  /**
+  * Returns the number of indexed objects.
+  */
+  size_t num_materials();
+  size_t num_layers();
+  size_t num_definitions();
+
+  /**
+  * Returns the number of times an index has been rebuilt.  Useful to check that a workload does not keep invalidating the registry.
+  */
+  size_t rebuilds() const;
+};
+
+} /* namespace CW */
+
+#endif /* ModelRegistry_hpp */
@@ -0,0 +1,146 @@
+//
+//  ModelWalker.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef ModelWalker_hpp
+#define ModelWalker_hpp
+
+#include <stdio.h>
+#include <functional>
+#include <vector>
+
+#include <SketchUpAPI/model/component_instance.h>
+
+#include "SUAPI-CppWrapper/Transformation.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/model/ComponentInstance.hpp"
+
+namespace CW {
+
+// Forward declarations
+class Model;
+class InstancePath;
+
+/**
+* ModelWalker visits every Entities object reachable from a model's entities, through groups and component instances, on a pool of threads.
+*
+* The hierarchy of definitions is read from the model once, on the calling thread, when the ModelWalker is constructed.  walk() then visits:
+* - the Entities of each definition (and of the model itself) exactly once, however many times the definition is placed.
+* - every placement of every Entities object, with its accumulated Transformation and path of instances.
+*
+* Each visit is a task on a work-stealing thread pool: every thread has its own queue, and a thread that runs out of tasks takes tasks from the other threads' queues.  Visitor functions are therefore called concurrently and must be thread safe.  The model must not be changed while it is walked.
+*/
+class ModelWalker {
+  public:
+  /**
+  * A placement of an Entities object in the model.
+  */
+  struct Placement {
+    /** The Entities object that is placed. */
+    Entities entities;
+    /** The definition of the entities.  This is SU_INVALID for the model's own entities, as wrapping an invalid reference in a ComponentDefinition would create a new definition when copied. */
+    SUComponentDefinitionRef definition_ref;
+    /** The transformation from the coordinates of the entities to model coordinates. */
+    Transformation transformation;
+    /** The component instances and groups leading to this placement, starting with the outermost. */
+    std::vector<ComponentInstance> instances;
+
+    Placement(const Entities& entities, SUComponentDefinitionRef definition, const Transformation& transformation, const std::vector<ComponentInstance>& instances);
+
+    /**
+    * Returns true if the entities belong to a definition, and false for the model's own entities.
+    */
+    bool has_definition() const;
+
+    /**
+    * Returns the definition of the entities.
+    * @throws std::logic_error if the entities are the model's own entities.
+    */
+    ComponentDefinition definition() const;
+
+    /**
+    * Creates the InstancePath object of this placement.
+    */
+    InstancePath instance_path() const;
+  };
+
+  /**
+  * Function called once for each definition.  The definition is a null pointer for the model's own entities.
+  */
+  typedef std::function<void(const Entities& entities, const ComponentDefinition* definition)> DefinitionVisitor;
+
+  /**
+  * Function called once for each placement of an Entities object.
+  */
+  typedef std::function<void(const Placement& placement)> PlacementVisitor;
+
+  private:
+  struct Child {
+    size_t definition;
+    SUComponentInstanceRef instance;
+    SUTransformation transformation;
+  };
+
+  struct DefinitionNode {
+    Entities entities;
+    // Kept as a C API reference, as copying a null ComponentDefinition would create a new definition.
+    SUComponentDefinitionRef definition;
+    std::vector<Child> children;
+  };
+
+  // The model's entities are the first node.
+  std::vector<DefinitionNode> m_definitions;
+  size_t m_num_threads;
+
+  public:
+  /**
+  * Reads the hierarchy of definitions in the model.
+  * @param model - the model to walk.
+  * @param num_threads - the number of threads to walk the model with.  If 0, the number of hardware threads is used.
+  */
+  ModelWalker(const Model& model, size_t num_threads = 0);
+
+  /**
+  * Visits the definitions and placements of the model, and returns once every visit has finished.  If a visitor throws an exception, the remaining visits are abandoned and the exception is rethrown from walk().
+  * @param definition_visitor - function called once for each definition.  May be empty.
+  * @param placement_visitor - function called once for each placement.  May be empty.
+  */
+  void walk(const DefinitionVisitor& definition_visitor, const PlacementVisitor& placement_visitor) const;
+
+  /**
+  * Returns the number of unique Entities objects in the model, including the model's own entities.
+  */
+  size_t num_definitions() const;
+
+  /**
+  * Returns the number of threads used by walk().
+  */
+  size_t num_threads() const;
+};
+
+} /* namespace CW */
+#endif /* ModelWalker_hpp */
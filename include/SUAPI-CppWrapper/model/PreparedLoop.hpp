@@ -0,0 +1,118 @@
+//
+//  PreparedLoop.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef PreparedLoop_hpp
+#define PreparedLoop_hpp
+
+#include <stdio.h>
+#include <cstdint>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/model/Loop.hpp"
+
+namespace CW {
+
+/**
+* A loop prepared for classifying many points against it.
+*
+* The plane of the loop is found once, and the loop is projected to 2D on the axis plane closest to it.  Loops with more than a few edges are also indexed into horizontal slabs, each holding the edges that cross it sorted from left to right, so that a point is classified with two binary searches.  classify_point() does not allocate memory.
+* The loop is expected to be simple (no self-intersections), as the loops of faces are.  Points are on a vertex when they are equal to it (@see Point3D::operator==), and on an edge when they are closer to it than Point3D::EPSILON.
+*/
+class PreparedLoop {
+  private:
+  // Loops with this many edges or fewer are not indexed, as a linear scan is faster.
+  static constexpr size_t MAX_LINEAR_EDGES = 16;
+
+  struct Point2D {
+    double x;
+    double y;
+  };
+
+  Plane3D m_plane;
+  std::vector<Point3D> m_points;
+  // Edge i is from point i to point i+1, and the last edge joins the last point to the first.
+  std::vector<Point2D> m_points_2d;
+  int m_u_axis;
+  int m_v_axis;
+  double m_u_sign;
+
+  // Slab i is between m_slab_ys[i] and m_slab_ys[i+1], and crosses the edges m_slab_edges[m_slab_offsets[i]] to m_slab_edges[m_slab_offsets[i+1] - 1].
+  std::vector<double> m_slab_ys;
+  std::vector<uint32_t> m_slab_offsets;
+  std::vector<uint32_t> m_slab_edges;
+  // Points sorted by their 2D y coordinate, to find the vertices near a point.
+  std::vector<uint32_t> m_points_by_y;
+
+  void prepare(const std::vector<Point3D>& loop_points);
+  void build_index();
+  Point2D project(const Point3D& point) const;
+  double x_at(uint32_t edge, double y) const;
+  bool on_vertex(uint32_t index, const Point3D& point) const;
+  bool on_edge(uint32_t edge, const Point3D& point) const;
+  PointLoopClassify classify_linear(const Point3D& point, const Point2D& point_2d) const;
+  PointLoopClassify classify_indexed(const Point3D& point, const Point2D& point_2d) const;
+
+  public:
+  /**
+  * Prepares a loop given by its points.
+  * @param loop_points - the points of the loop, in order.
+  * @throws std::invalid_argument if fewer than 3 distinct points are given or they do not form a planar loop.
+  */
+  PreparedLoop(const std::vector<Point3D>& loop_points);
+
+  /**
+  * Prepares the loop of a face.
+  * @param loop - the Loop to prepare.
+  */
+  PreparedLoop(const Loop& loop);
+
+  /**
+  * Determines where a point lies relative to the loop.  @see PointLoopClassify.
+  * @param point - the Point3D object to check.
+  * @return PointLoopClassify object describing the location of the point relative to the loop.
+  */
+  PointLoopClassify classify_point(const Point3D& point) const;
+
+  /**
+  * Returns the plane of the loop.
+  */
+  const Plane3D& plane() const;
+
+  /**
+  * Returns the number of edges/vertices in the loop.
+  */
+  size_t size() const;
+
+  /**
+  * Returns true if the loop has been indexed into slabs.
+  */
+  bool indexed() const;
+};
+
+} /* namespace CW */
+#endif /* PreparedLoop_hpp */
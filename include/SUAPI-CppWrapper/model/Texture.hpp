@@ -29,6 +29,7 @@
 #define Texture_hpp
 
 #include <stdio.h>
+#include <vector>
 
 #include <SketchUpAPI/model/texture.h>
 
@@ -38,6 +39,7 @@ namespace CW {
 
 // Forward declarations
 class ImageRep;
+class Material;
 class String;
 
 /*
@@ -56,6 +58,11 @@ class Texture :public Entity {
   static SUTextureRef create_texture(const std::string file_path, double s_scale = 1.0, double t_scale = 1.0);
   
   static SUTextureRef copy_reference(const Texture& other);
+
+  /**
+  * Copies the texture by writing it to a uniquely named temporary image file and loading it back with its s and t scale.  Used as a last resort, when the pixels of the texture cannot be copied with its scale.
+  */
+  Texture copy_through_file() const;
   public:
   /** Constructor for null Texture value */
   Texture();
@@ -105,9 +112,26 @@ class Texture :public Entity {
   
   /**
   * Returns a copy of the texture object - note that a Texture object can only be assigned to one Material object.  So this method is useful for copying Textures to new Material objects.
+  *
+  * The copy is built from the pixel data of the texture's ImageRep.  The C API cannot set the scale of a texture built from an ImageRep, so when the original's s and t scale differ from those the pixels give by default, the pixels are written to an uncompressed bitmap in the temporary directory and loaded back with the original scale.  Only a texture at its default scale is copied without disk I/O.
   * @since SU 2017, API 5.0
   */
   Texture copy() const;
+
+  /**
+  * Returns a copy of the texture object, using the given buffer for the pixel data.  Reusing one buffer avoids an allocation per texture when copying many textures.  As with copy(), a scaled texture goes through a temporary bitmap file.
+  * @param scratch - buffer to hold the pixel data. It is resized as needed and its contents are overwritten.
+  * @since SU 2017, API 5.0
+  */
+  Texture copy(std::vector<SUByte>& scratch) const;
+
+  /**
+  * Copies the textures of the given materials, reusing one pixel buffer for all of them.  Each scaled texture is written to and loaded from a temporary bitmap file, as in copy().
+  * @param materials - the materials whose textures to copy.
+  * @return the copied textures, in the same order as the materials.  A material with no texture gives a null Texture.
+  * @since SU 2017, API 5.0
+  */
+  static std::vector<Texture> copy_textures(const std::vector<Material>& materials);
   
   /**
   * Returns whether the alpha channel is used by the texture image.
@@ -60,9 +60,15 @@ class TypedValue {
   
   /** Copy constructor */
   TypedValue(const TypedValue& other);
+
+  /** Move constructor. The other object is left null. */
+  TypedValue(TypedValue&& other) noexcept;
   
   /** Copy Assignment Operator */
   TypedValue& operator= (const TypedValue& other);
+
+  /** Move assignment operator. The other object is left null. */
+  TypedValue& operator=(TypedValue&& other) noexcept;
   
   ~TypedValue();
   
@@ -27,6 +27,7 @@
 
 #include <stdio.h>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
 #include <cassert>
 
@@ -34,9 +35,6 @@
 
 #include "SUAPI-CppWrapper/Geometry.hpp"
 
-#include "SUAPI-CppWrapper/model/Face.hpp"
-#include "SUAPI-CppWrapper/model/Edge.hpp"
-
 //#include "SUAPI-CppWrapper/Plane.h"
 //#include "SUAPI-CppWrapper/Line.h"
 //#include "SUAPI-CppWrapper/float3.h"
@@ -134,110 +132,52 @@ Vector3D::Vector3D():
 {}
 
 Vector3D::Vector3D(SUVector3D su_vector):
-  m_vector(su_vector),
-  x(m_vector.x),
-  y(m_vector.y),
-  z(m_vector.z)
-{}
-
-Vector3D::Vector3D( double x, double y, double z):
-  m_vector(SUVector3D{x,y,z}),
-  x(m_vector.x),
-  y(m_vector.y),
-  z(m_vector.z)
+  x(su_vector.x),
+  y(su_vector.y),
+  z(su_vector.z)
 {}
 
 Vector3D::Vector3D(bool valid):
-  m_vector(SUVector3D{0.0,0.0,0.0}),
-  null(!valid),
-  x(m_vector.x),
-  y(m_vector.y),
-  z(m_vector.z)
-{}
-
-
-Vector3D::Vector3D(const Edge &edge):
-  Vector3D(edge.vector())
-{}
-
-Vector3D::Vector3D(const Vector3D &vector):
-  m_vector(vector.m_vector),
-  null(vector.null),
-  x(m_vector.x),
-  y(m_vector.y),
-  z(m_vector.z)
+  x(valid ? 0.0 : std::numeric_limits<double>::quiet_NaN()),
+  y(0.0),
+  z(0.0)
 {}
 
 
 Vector3D::Vector3D(const Point3D& point):
-  Vector3D(SUVector3D{point.x, point.y, point.z})
-{
-  null = !point;
-}
+  Vector3D(point.x, point.y, point.z)
+{}
 
 
-Vector3D& Vector3D::operator=(const Vector3D &vector) {
-  if (this == &vector) {
-    return *this;
-  }
-  x = vector.x;
-  y = vector.y;
-  z = vector.z;
-  null = vector.null;
-  return *this;
-}
-
 Vector3D& Vector3D::operator=(const SUVector3D &vector) {
   x = vector.x;
   y = vector.y;
   z = vector.z;
-  null = false;
   return *this;
 }
 
 // Casting
 Vector3D::operator SUVector3D() const {
-  assert(!null);
-  return m_vector;
+  assert(!!(*this));
+  return SUVector3D{x, y, z};
 }
 
 Vector3D::operator const SUVector3D*() const {
-  assert(!null);
-  return &m_vector;
+  assert(!!(*this));
+  return reinterpret_cast<const SUVector3D*>(this);
 }
 
 Vector3D::operator Point3D() const {
-  Point3D point(!this->null);
-  point.x = x;
-  point.y = y;
-  point.z = z;
-  return point;
+  return Point3D(x, y, z);
 }
 
 // Operator overloads
-Vector3D Vector3D::operator+(const Vector3D &vector) const {
-  assert(!!vector && !null);
-  return Vector3D(m_vector.x + vector.x, m_vector.y + vector.y, m_vector.z + vector.z);
-}
-
 Point3D operator+(const Vector3D &lhs, const Point3D& rhs) {
   return rhs + lhs;
 }
 
-Vector3D Vector3D::operator-() const {
-  return Vector3D(-x, -y, -z);
-}
-
-Vector3D Vector3D::operator-(const Vector3D &vector) const {
-  assert(!!vector && !null);
-  return Vector3D(x - vector.x, y - vector.y, z - vector.z);
-}
-Vector3D Vector3D::operator*(const double &scalar) const {
-  assert(!null);
-  return Vector3D( x * scalar, y * scalar, z * scalar);
-}
 Vector3D Vector3D::operator/(const double &scalar) const {
-  assert(!null);
+  assert(!!(*this));
   if (std::abs(scalar) < EPSILON) {
     throw std::invalid_argument("CW::Vector3D::operator/() - cannot divide by zero");
   }
@@ -266,42 +206,34 @@ bool operator!=(const Vector3D &lhs, const Vector3D &rhs) {
 }
 
 
-bool Vector3D::operator!() const {
-  if (this->null) {
-    return true;
-  }
-  return false;
-}
-
-
 double Vector3D::length() const {
-  assert(!null);
+  assert(!!(*this));
   return sqrt(pow(x,2) + pow(y,2) + pow(z,2));
 }
 
 Vector3D Vector3D::unit() const {
-  assert(!null);
+  assert(!!(*this));
   return *this / length();
 }
 
 double Vector3D::angle(const Vector3D& vector_b) const {
-  assert(!null);
+  assert(!!(*this));
   return acos(unit().dot(vector_b.unit()));
 }
 
 double Vector3D::dot(const Vector3D& vector2) const {
-  assert(!!vector2 && !null);
+  assert(!!vector2 && !!(*this));
   return (x * vector2.x) + (y * vector2.y) + (z * vector2.z);
 }
 
 double Vector3D::dot(const Point3D& point) const {
-  assert(!!point && !null);
+  assert(!!point && !!(*this));
   return (x * point.x) + (y * point.y) + (z * point.z);
 }
 
 
 Vector3D Vector3D::cross(const Vector3D& vector2) const {
-  assert(!!vector2 && !null);
+  assert(!!vector2 && !!(*this));
   return Vector3D{y * vector2.z - z * vector2.y,
                 z * vector2.x - x * vector2.z,
                 x * vector2.y - y * vector2.x};
@@ -350,115 +282,65 @@ Point3D::Point3D():
 {}
 
 Point3D::Point3D(bool valid):
-  m_point(SUPoint3D{0.0,0.0,0.0}),
-  null(!valid),
-  x(m_point.x),
-  y(m_point.y),
-  z(m_point.z)
+  x(valid ? 0.0 : std::numeric_limits<double>::quiet_NaN()),
+  y(0.0),
+  z(0.0)
 {}
 
 Point3D::Point3D( SUPoint3D su_point):
-  m_point(su_point),
-  x(m_point.x),
-  y(m_point.y),
-  z(m_point.z)
+  x(su_point.x),
+  y(su_point.y),
+  z(su_point.z)
 {}
 
 Point3D::Point3D( SUVector3D su_vector):
-  Point3D(SUPoint3D{su_vector.x, su_vector.y, su_vector.z})
-{}
-
-Point3D::Point3D(double x, double y, double z):
-  Point3D(SUPoint3D{x, y, z})
+  x(su_vector.x),
+  y(su_vector.y),
+  z(su_vector.z)
 {}
 
-Point3D::Point3D(const Point3D& other):
-  Point3D(other.x, other.y, other.z)
-{
-  null = other.null;
-}
-
 
 Point3D::Point3D( const Vector3D& vector):
-  Point3D(SUPoint3D{vector.x, vector.y, vector.z})
+  Point3D(vector.x, vector.y, vector.z)
 {}
 
-Point3D& Point3D::operator=(const Point3D &point) {
-  if (this == &point) {
-    return *this;
-  }
-  x = point.x;
-  y = point.y;
-  z = point.z;
-  null = point.null;
-  return *this;
-}
 
-
-Point3D::operator SUPoint3D() const { return SUPoint3D {m_point.x, m_point.y, m_point.z}; }
+Point3D::operator SUPoint3D() const { return SUPoint3D {x, y, z}; }
 
 
 Point3D::operator const SUPoint3D*() const{
-  //m_point = SUPoint3D{m_point.x, m_point.y, m_point.z};
-  return &m_point;
+  return reinterpret_cast<const SUPoint3D*>(this);
 }
 
-Point3D::operator Vector3D() const { return Vector3D(m_point.x, m_point.y, m_point.z); }
+Point3D::operator Vector3D() const { return Vector3D(x, y, z); }
 
 // Operator overloads
-Point3D Point3D::operator+(const Point3D &point) const {
-  assert(!!point && !null);
-  return Point3D(m_point.x + point.x, m_point.y + point.y, m_point.z + point.z);
-}
-
-Point3D Point3D::operator+(const Vector3D &vector) const {
-  assert(!!vector && !null);
-  return Point3D(m_point.x + vector.x, m_point.y + vector.y, m_point.z + vector.z);
-}
-
 Point3D Point3D::operator+(const SUPoint3D &point) const {
-  assert(!null);
+  assert(!!(*this));
   return (*this) + Point3D(point);
 }
 
-Vector3D Point3D::operator-(const Point3D &point) const {
-  assert(!!point && !null);
-  return Vector3D(m_point.x - point.x, m_point.y - point.y, m_point.z - point.z);
-}
-
 Point3D Point3D::operator-(const Vector3D &vector) const {
-  assert(!!vector && !null);
+  assert(!!vector && !!(*this));
   return (*this) - static_cast<Point3D>(vector);
 }
 
 Point3D Point3D::operator-(const SUPoint3D &point) const  {
-  assert(!null);
+  assert(!!(*this));
   return (*this) - Point3D(point);
 }
 
-Point3D Point3D::operator*(const double &scalar) const {
-  assert(!null);
-  return Point3D(m_point.x * scalar, m_point.y * scalar, m_point.z * scalar);
-}
-
 Point3D Point3D::operator/(const double &scalar) const {
-  assert(!null);
+  assert(!!(*this));
   if (std::abs(scalar) < EPSILON) {
     throw std::invalid_argument("Point3D::operator/: cannot divide by zero");
   }
-  return Point3D(m_point.x / scalar, m_point.y / scalar, m_point.z / scalar);
+  return Point3D(x / scalar, y / scalar, z / scalar);
 }
 
 /**
 * Comparative operators
 */
-bool Point3D::operator!() const {
-  if (null) {
-    return true;
-  }
-  return false;
-}
-
 bool operator==(const Point3D &lhs, const Point3D &rhs) {
   if (!lhs && !rhs) {
     return true;
@@ -669,32 +551,18 @@ Plane3D::Plane3D():
 {}
 
 Plane3D::Plane3D(SUPlane3D plane):
-  m_plane(plane),
-  null((m_plane.a == 0.0 && m_plane.b == 0.0 && m_plane.c == 0.0)),
-  a(m_plane.a),
-  b(m_plane.b),
-  c(m_plane.c),
-  d(m_plane.d)
+  a(plane.a),
+  b(plane.b),
+  c(plane.c),
+  d(plane.d)
 {}
 
 
 Plane3D::Plane3D(double a, double b, double c, double d):
-  Plane3D(SUPlane3D{a,b,c,d})
-{}
-
-
-Plane3D::Plane3D(const Face &face):
-  Plane3D(face.plane())
-{}
-
-
-Plane3D::Plane3D(const Plane3D &plane):
-  m_plane(plane.m_plane),
-  null(plane.null),
-  a(m_plane.a),
-  b(m_plane.b),
-  c(m_plane.c),
-  d(m_plane.d)
+  a(a),
+  b(b),
+  c(c),
+  d(d)
 {}
 
 
@@ -708,29 +576,15 @@ Plane3D::Plane3D(const Point3D& point, const Vector3D& normal):
 
 
 Plane3D::Plane3D(bool valid):
-  m_plane(SUPlane3D{1.0,0.0,0.0,0.0}),
-  null(!valid),
-  a(m_plane.a),
-  b(m_plane.b),
-  c(m_plane.c),
-  d(m_plane.d)
+  a(valid ? 1.0 : std::numeric_limits<double>::quiet_NaN()),
+  b(0.0),
+  c(0.0),
+  d(0.0)
 {}
 
 
-
-Plane3D& Plane3D::operator=(const Plane3D &plane) {
-  if (this == &plane)
-    return *this;
-  a = plane.a;
-  b = plane.b;
-  c = plane.c;
-  d = plane.d;
-  null = plane.null;
-  return *this;
-}
-
 bool Plane3D::operator!() const {
-  if (null) {
+  if (std::isnan(a) || (a == 0.0 && b == 0.0 && c == 0.0)) {
     return true;
   }
   return false;
@@ -878,7 +732,7 @@ double Plane3D::angle_with(const Plane3D& plane2) const {
 }
 
 
-Plane3D::operator SUPlane3D() const { return m_plane; }
+Plane3D::operator SUPlane3D() const { return SUPlane3D{a, b, c, d}; }
 
 
 Plane3D Plane3D::plane_from_loop(const std::vector<Point3D>& loop_points) {
@@ -946,11 +800,11 @@ Plane3D Plane3D::plane_from_loop(const std::vector<Point3D>& loop_points) {
 */
 
 BoundingBox3D::BoundingBox3D():
-  BoundingBox3D(SUBoundingBox3D{Point3D(), Point3D()})
+  BoundingBox3D(SUBoundingBox3D{Point3D(true), Point3D(true)})
 {}
 
 BoundingBox3D::BoundingBox3D(bool valid):
-  m_bounding_box(SUBoundingBox3D{Point3D(), Point3D()}),
+  m_bounding_box(SUBoundingBox3D{Point3D(true), Point3D(true)}),
   null(!valid)
 {}
 
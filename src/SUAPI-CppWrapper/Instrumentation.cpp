@@ -0,0 +1,396 @@
+//
+//  Instrumentation.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+
+namespace CW {
+
+namespace {
+
+struct TraceEvent {
+  const InstrumentationCounter* counter;
+  uint32_t thread;
+  int64_t start_ns;
+  int64_t duration_ns;
+};
+
+/**
+* The trace events recorded by one thread.  The mutex is only contended while the events are written out or reset.
+*/
+struct ThreadTrace {
+  std::mutex mutex;
+  std::vector<TraceEvent> events;
+  // Whether a running thread records into this trace.  Guarded by the registry mutex.
+  bool in_use = true;
+};
+
+/**
+* All of the counters, and the trace events.  Counters are placed in storage that is reserved up front, so that they never move, and so that registering a counter never allocates or throws, even from a destructor.
+*/
+struct Registry {
+  typedef std::aligned_storage<sizeof(InstrumentationCounter), alignof(InstrumentationCounter)>::type CounterStorage;
+
+  std::mutex mutex;
+  CounterStorage counters[Instrumentation::MAX_COUNTERS];
+  std::atomic<size_t> num_counters;
+  std::atomic<int64_t> start_ns;
+  std::atomic<bool> tracing;
+  std::atomic<size_t> max_events;
+  std::atomic<size_t> num_events;
+  // The traces of exited threads are kept for their events, and handed to new threads.
+  std::vector<std::unique_ptr<ThreadTrace>> traces;
+
+  Registry():
+    num_counters(0),
+    start_ns(Instrumentation::Clock::now().time_since_epoch() / std::chrono::nanoseconds(1)),
+    tracing(false),
+    max_events(0),
+    num_events(0)
+  {}
+
+  InstrumentationCounter& counter(size_t index) {
+    return *reinterpret_cast<InstrumentationCounter*>(&counters[index]);
+  }
+};
+
+Registry& registry() {
+  // Never destroyed, so counters can be recorded from static destructors.
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+int64_t to_ns(Instrumentation::Clock::time_point time) {
+  return time.time_since_epoch() / std::chrono::nanoseconds(1);
+}
+
+uint32_t thread_number() {
+  static std::atomic<uint32_t> next_thread(1);
+  thread_local uint32_t thread = next_thread.fetch_add(1);
+  return thread;
+}
+
+/**
+* Hands the trace of a thread back to the registry when the thread exits.
+*/
+struct ThreadTraceOwner {
+  ThreadTrace* trace = nullptr;
+
+  ~ThreadTraceOwner();
+};
+
+// Trivially destructible, so they can still be read while thread_local objects are destroyed.
+thread_local ThreadTrace* t_trace = nullptr;
+thread_local bool t_trace_released = false;
+
+ThreadTraceOwner::~ThreadTraceOwner() {
+  if (trace != nullptr) {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    trace->in_use = false;
+  }
+  t_trace = nullptr;
+  t_trace_released = true;
+}
+
+/**
+* Returns the trace of the calling thread, taking one that is no longer in use or creating one.  Returns nullptr if a trace could not be created, or if the thread is exiting.
+*/
+ThreadTrace* thread_trace() noexcept {
+  if (t_trace != nullptr || t_trace_released) {
+    return t_trace;
+  }
+  Registry& reg = registry();
+  try {
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const std::unique_ptr<ThreadTrace>& trace : reg.traces) {
+      if (!trace->in_use) {
+        trace->in_use = true;
+        t_trace = trace.get();
+        break;
+      }
+    }
+    if (t_trace == nullptr) {
+      reg.traces.emplace_back(new ThreadTrace());
+      t_trace = reg.traces.back().get();
+    }
+  }
+  catch (...) {
+    return nullptr;
+  }
+  thread_local ThreadTraceOwner owner;
+  owner.trace = t_trace;
+  return t_trace;
+}
+
+const char* kind_name(CounterKind kind) {
+  switch (kind) {
+    case CounterKind::SUFunction:
+      return "su_function";
+    case CounterKind::Method:
+      return "method";
+    case CounterKind::Bytes:
+      return "bytes";
+  }
+  return "";
+}
+
+void write_json_string(std::ostream& stream, const char* string) {
+  stream << '"';
+  for (const char* c = string; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      stream << '\\';
+    }
+    stream << *c;
+  }
+  stream << '"';
+}
+
+} // namespace
+
+
+/***************************
+* InstrumentationCounter **
+****************************/
+constexpr size_t InstrumentationCounter::NUM_BUCKETS;
+
+
+InstrumentationCounter::InstrumentationCounter(const char* counter_name, CounterKind counter_kind):
+  name(counter_name),
+  kind(counter_kind)
+{
+  reset();
+}
+
+
+void InstrumentationCounter::record(uint64_t duration_ns) {
+  calls.fetch_add(1, std::memory_order_relaxed);
+  total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+  uint64_t max = max_ns.load(std::memory_order_relaxed);
+  while (duration_ns > max && !max_ns.compare_exchange_weak(max, duration_ns, std::memory_order_relaxed)) {}
+  size_t bucket = 0;
+  for (uint64_t remaining = duration_ns >> 1; remaining != 0 && bucket < NUM_BUCKETS - 1; remaining >>= 1) {
+    ++bucket;
+  }
+  histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void InstrumentationCounter::add_bytes(uint64_t num_bytes) {
+  calls.fetch_add(1, std::memory_order_relaxed);
+  bytes.fetch_add(num_bytes, std::memory_order_relaxed);
+}
+
+
+void InstrumentationCounter::reset() {
+  calls.store(0, std::memory_order_relaxed);
+  total_ns.store(0, std::memory_order_relaxed);
+  max_ns.store(0, std::memory_order_relaxed);
+  bytes.store(0, std::memory_order_relaxed);
+  for (std::atomic<uint64_t>& bucket : histogram) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+
+/********************
+* Instrumentation **
+*********************/
+constexpr size_t Instrumentation::MAX_COUNTERS;
+
+
+bool Instrumentation::compiled_in() {
+#ifdef CW_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+InstrumentationCounter* Instrumentation::counter(const char* name, CounterKind kind) noexcept {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  const size_t num_counters = reg.num_counters.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < num_counters; ++i) {
+    InstrumentationCounter& counter = reg.counter(i);
+    if (counter.kind == kind && std::strcmp(counter.name, name) == 0) {
+      return &counter;
+    }
+  }
+  if (num_counters == MAX_COUNTERS) {
+    // Out of space, so the call is recorded in the last counter, which is named as such.
+    return &reg.counter(MAX_COUNTERS - 1);
+  }
+  const bool last = num_counters == MAX_COUNTERS - 1;
+  InstrumentationCounter* counter = new (&reg.counters[num_counters]) InstrumentationCounter(last ? "(other counters)" : name, kind);
+  reg.num_counters.store(num_counters + 1, std::memory_order_release);
+  return counter;
+}
+
+
+std::vector<const InstrumentationCounter*> Instrumentation::counters() {
+  Registry& reg = registry();
+  std::vector<const InstrumentationCounter*> counters;
+  const size_t num_counters = reg.num_counters.load(std::memory_order_acquire);
+  for (size_t i = 0; i < num_counters; ++i) {
+    const InstrumentationCounter& counter = reg.counter(i);
+    if (counter.calls.load(std::memory_order_relaxed) != 0) {
+      counters.push_back(&counter);
+    }
+  }
+  std::stable_sort(counters.begin(), counters.end(),
+    [](const InstrumentationCounter* a, const InstrumentationCounter* b) {
+      return a->total_ns.load(std::memory_order_relaxed) > b->total_ns.load(std::memory_order_relaxed);
+    });
+  return counters;
+}
+
+
+void Instrumentation::reset() {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  const size_t num_counters = reg.num_counters.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < num_counters; ++i) {
+    reg.counter(i).reset();
+  }
+  for (const std::unique_ptr<ThreadTrace>& trace : reg.traces) {
+    std::lock_guard<std::mutex> trace_lock(trace->mutex);
+    trace->events.clear();
+  }
+  reg.num_events.store(0, std::memory_order_relaxed);
+  reg.start_ns.store(to_ns(Clock::now()), std::memory_order_relaxed);
+}
+
+
+void Instrumentation::start_trace(size_t max_events) {
+  Registry& reg = registry();
+  reg.max_events.store(max_events, std::memory_order_relaxed);
+  reg.tracing.store(true, std::memory_order_relaxed);
+}
+
+
+void Instrumentation::stop_trace() {
+  registry().tracing.store(false, std::memory_order_relaxed);
+}
+
+
+void Instrumentation::record(InstrumentationCounter* counter, Clock::time_point start, Clock::time_point end) noexcept {
+  const int64_t start_ns = to_ns(start);
+  const int64_t duration_ns = to_ns(end) - start_ns;
+  counter->record(static_cast<uint64_t>(duration_ns));
+  Registry& reg = registry();
+  if (!reg.tracing.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (reg.num_events.fetch_add(1, std::memory_order_relaxed) >= reg.max_events.load(std::memory_order_relaxed)) {
+    return;
+  }
+  ThreadTrace* trace = thread_trace();
+  if (trace == nullptr) {
+    return;
+  }
+  // Events that cannot be stored are dropped, as this is called from destructors.
+  try {
+    std::lock_guard<std::mutex> lock(trace->mutex);
+    trace->events.push_back(TraceEvent{counter, thread_number(), start_ns, duration_ns});
+  }
+  catch (...) {}
+}
+
+
+void Instrumentation::write_json(std::ostream& stream) {
+  const int64_t elapsed_ns = to_ns(Clock::now()) - registry().start_ns.load(std::memory_order_relaxed);
+  stream << "{\n  \"elapsed_ns\": " << elapsed_ns << ",\n  \"counters\": [";
+  bool first = true;
+  for (const InstrumentationCounter* counter : counters()) {
+    const uint64_t calls = counter->calls.load(std::memory_order_relaxed);
+    const uint64_t total_ns = counter->total_ns.load(std::memory_order_relaxed);
+    stream << (first ? "\n" : ",\n") << "    {\"name\": ";
+    first = false;
+    write_json_string(stream, counter->name);
+    stream << ", \"kind\": \"" << kind_name(counter->kind) << "\", \"calls\": " << calls;
+    if (counter->kind == CounterKind::Bytes) {
+      stream << ", \"bytes\": " << counter->bytes.load(std::memory_order_relaxed) << "}";
+      continue;
+    }
+    const double percent = elapsed_ns > 0 ? 100.0 * double(total_ns) / double(elapsed_ns) : 0.0;
+    stream << ", \"total_ns\": " << total_ns
+           << ", \"mean_ns\": " << (calls > 0 ? total_ns / calls : 0)
+           << ", \"max_ns\": " << counter->max_ns.load(std::memory_order_relaxed)
+           << ", \"percent_of_elapsed\": " << percent
+           << ", \"histogram\": [";
+    // Each non-empty bucket is written as [lowest duration in ns, number of calls].
+    bool first_bucket = true;
+    for (size_t i = 0; i < InstrumentationCounter::NUM_BUCKETS; ++i) {
+      const uint64_t count = counter->histogram[i].load(std::memory_order_relaxed);
+      if (count == 0) {
+        continue;
+      }
+      stream << (first_bucket ? "" : ", ") << "[" << (i == 0 ? 0 : uint64_t(1) << i) << ", " << count << "]";
+      first_bucket = false;
+    }
+    stream << "]}";
+  }
+  stream << "\n  ]\n}\n";
+}
+
+
+void Instrumentation::write_chrome_trace(std::ostream& stream) {
+  Registry& reg = registry();
+  std::vector<TraceEvent> events;
+  {
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const std::unique_ptr<ThreadTrace>& trace : reg.traces) {
+      std::lock_guard<std::mutex> trace_lock(trace->mutex);
+      events.insert(events.end(), trace->events.begin(), trace->events.end());
+    }
+  }
+  std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+    return a.start_ns < b.start_ns;
+  });
+  const int64_t start_ns = reg.start_ns.load(std::memory_order_relaxed);
+  stream << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+  for (size_t i = 0; i < events.size(); ++i) {
+    const TraceEvent& event = events[i];
+    // Chrome trace event times are in microseconds.
+    stream << (i == 0 ? "\n" : ",\n") << "  {\"name\": ";
+    write_json_string(stream, event.counter->name);
+    stream << ", \"cat\": \"" << kind_name(event.counter->kind) << "\", \"ph\": \"X\""
+           << ", \"ts\": " << double(event.start_ns - start_ns) / 1000.0
+           << ", \"dur\": " << double(event.duration_ns) / 1000.0
+           << ", \"pid\": 1, \"tid\": " << event.thread << "}";
+  }
+  stream << "\n]}\n";
+}
+
+} /* namespace CW */
@@ -0,0 +1,327 @@
+//
+//  PixelConversion.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "SUAPI-CppWrapper/PixelConversion.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define CW_PIXELS_SSE2
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #include <immintrin.h>
+  #define CW_PIXELS_AVX2
+#endif
+
+namespace CW {
+
+namespace {
+
+/**
+* Pixel kernels.  Each one converts num_pixels pixels from in to out.
+*/
+typedef void (*PixelKernel)(const SUByte* in, SUByte* out, size_t num_pixels);
+typedef void (*ExpandKernel)(const SUByte* in, SUByte* out, size_t num_pixels, SUByte alpha);
+typedef void (*PremultiplyKernel)(SUByte* pixels, size_t num_pixels);
+
+void swap_red_blue_scalar(const SUByte* in, SUByte* out, size_t num_pixels) {
+  for (size_t i = 0; i < num_pixels; ++i, in += 4, out += 4) {
+    const SUByte first = in[0];
+    const SUByte third = in[2];
+    out[0] = third;
+    out[1] = in[1];
+    out[2] = first;
+    out[3] = in[3];
+  }
+}
+
+void expand_scalar(const SUByte* in, SUByte* out, size_t num_pixels, SUByte alpha) {
+  for (size_t i = 0; i < num_pixels; ++i, in += 3, out += 4) {
+    out[0] = in[0];
+    out[1] = in[1];
+    out[2] = in[2];
+    out[3] = alpha;
+  }
+}
+
+void expand_swap_scalar(const SUByte* in, SUByte* out, size_t num_pixels, SUByte alpha) {
+  for (size_t i = 0; i < num_pixels; ++i, in += 3, out += 4) {
+    out[0] = in[2];
+    out[1] = in[1];
+    out[2] = in[0];
+    out[3] = alpha;
+  }
+}
+
+/**
+* round(value * alpha / 255) without a division, exact for all 8 bit inputs.
+*/
+inline SUByte multiply_alpha(unsigned value, unsigned alpha) {
+  const unsigned t = value * alpha + 128;
+  return static_cast<SUByte>((t + (t >> 8)) >> 8);
+}
+
+void premultiply_scalar(SUByte* pixels, size_t num_pixels) {
+  for (size_t i = 0; i < num_pixels; ++i, pixels += 4) {
+    const unsigned alpha = pixels[3];
+    pixels[0] = multiply_alpha(pixels[0], alpha);
+    pixels[1] = multiply_alpha(pixels[1], alpha);
+    pixels[2] = multiply_alpha(pixels[2], alpha);
+  }
+}
+
+#ifdef CW_PIXELS_SSE2
+void swap_red_blue_sse2(const SUByte* in, SUByte* out, size_t num_pixels) {
+  // Each pixel is a 32 bit lane: keep bytes 1 and 3, and exchange bytes 0 and 2 with shifts.
+  const __m128i odd_bytes = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+  const __m128i even_bytes = _mm_set1_epi32(0x00FF00FF);
+  size_t i = 0;
+  for (; i + 4 <= num_pixels; i += 4) {
+    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+    const __m128i red_blue = _mm_and_si128(pixels, even_bytes);
+    __m128i result = _mm_and_si128(pixels, odd_bytes);
+    result = _mm_or_si128(result, _mm_slli_epi32(red_blue, 16));
+    result = _mm_or_si128(result, _mm_srli_epi32(red_blue, 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), result);
+  }
+  swap_red_blue_scalar(in + i * 4, out + i * 4, num_pixels - i);
+}
+
+/**
+* Multiplies the colour channels of two pixels, widened to 16 bits, by their alpha.
+*/
+inline __m128i premultiply_two_sse2(__m128i pixels) {
+  const __m128i alpha_lanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+  __m128i alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+  alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+  __m128i t = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(128));
+  t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+  return _mm_or_si128(_mm_andnot_si128(alpha_lanes, t), _mm_and_si128(alpha_lanes, pixels));
+}
+
+void premultiply_sse2(SUByte* pixels, size_t num_pixels) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 <= num_pixels; i += 4) {
+    __m128i* address = reinterpret_cast<__m128i*>(pixels + i * 4);
+    const __m128i values = _mm_loadu_si128(address);
+    const __m128i low = premultiply_two_sse2(_mm_unpacklo_epi8(values, zero));
+    const __m128i high = premultiply_two_sse2(_mm_unpackhi_epi8(values, zero));
+    _mm_storeu_si128(address, _mm_packus_epi16(low, high));
+  }
+  premultiply_scalar(pixels + i * 4, num_pixels - i);
+}
+#endif
+
+#ifdef CW_PIXELS_AVX2
+/**
+* Expands pixels with a byte shuffle.  Four pixels are read with one 16 byte load, of which the last 4 bytes are unused, so the loop stops while at least 16 bytes remain.
+*/
+__attribute__((target("ssse3")))
+void expand_ssse3(const SUByte* in, SUByte* out, size_t num_pixels, SUByte alpha, const __m128i shuffle, ExpandKernel tail) {
+  const __m128i alpha_bytes = _mm_set1_epi32(static_cast<int>(static_cast<unsigned>(alpha) << 24));
+  size_t i = 0;
+  for (; i + 6 <= num_pixels; i += 4) {
+    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 3));
+    const __m128i result = _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha_bytes);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), result);
+  }
+  tail(in + i * 3, out + i * 4, num_pixels - i, alpha);
+}
+
+__attribute__((target("ssse3")))
+void expand_keep_ssse3(const SUByte* in, SUByte* out, size_t num_pixels, SUByte alpha) {
+  const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  expand_ssse3(in, out, num_pixels, alpha, shuffle, expand_scalar);
+}
+
+__attribute__((target("ssse3")))
+void expand_swap_ssse3(const SUByte* in, SUByte* out, size_t num_pixels, SUByte alpha) {
+  const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+  expand_ssse3(in, out, num_pixels, alpha, shuffle, expand_swap_scalar);
+}
+
+/**
+* As expand_ssse3(), eight pixels at a time: two 16 byte loads, 12 bytes apart, fill the two lanes.
+*/
+__attribute__((target("avx2")))
+void expand_avx2(const SUByte* in, SUByte* out, size_t num_pixels, SUByte alpha, const __m256i shuffle, ExpandKernel tail) {
+  const __m256i alpha_bytes = _mm256_set1_epi32(static_cast<int>(static_cast<unsigned>(alpha) << 24));
+  size_t i = 0;
+  for (; i + 10 <= num_pixels; i += 8) {
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 3));
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 3 + 12));
+    const __m256i pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+    const __m256i result = _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), alpha_bytes);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), result);
+  }
+  tail(in + i * 3, out + i * 4, num_pixels - i, alpha);
+}
+
+__attribute__((target("avx2")))
+void expand_keep_avx2(const SUByte* in, SUByte* out, size_t num_pixels, SUByte alpha) {
+  const __m256i shuffle = _mm256_setr_epi8(
+    0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+    0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  expand_avx2(in, out, num_pixels, alpha, shuffle, expand_scalar);
+}
+
+__attribute__((target("avx2")))
+void expand_swap_avx2(const SUByte* in, SUByte* out, size_t num_pixels, SUByte alpha) {
+  const __m256i shuffle = _mm256_setr_epi8(
+    2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+    2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+  expand_avx2(in, out, num_pixels, alpha, shuffle, expand_swap_scalar);
+}
+
+__attribute__((target("avx2")))
+void swap_red_blue_avx2(const SUByte* in, SUByte* out, size_t num_pixels) {
+  const __m256i shuffle = _mm256_setr_epi8(
+    2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+    2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  size_t i = 0;
+  for (; i + 8 <= num_pixels; i += 8) {
+    const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 4));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), _mm256_shuffle_epi8(pixels, shuffle));
+  }
+  swap_red_blue_scalar(in + i * 4, out + i * 4, num_pixels - i);
+}
+
+__attribute__((target("avx2")))
+inline __m256i premultiply_two_avx2(__m256i pixels) {
+  const __m256i alpha_lanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+  __m256i alpha = _mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+  alpha = _mm256_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+  __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(pixels, alpha), _mm256_set1_epi16(128));
+  t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+  return _mm256_blendv_epi8(t, pixels, alpha_lanes);
+}
+
+__attribute__((target("avx2")))
+void premultiply_avx2(SUByte* pixels, size_t num_pixels) {
+  // The unpacks and the pack both work within each 128 bit lane, so the pixels come back in their original order.
+  const __m256i zero = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= num_pixels; i += 8) {
+    __m256i* address = reinterpret_cast<__m256i*>(pixels + i * 4);
+    const __m256i values = _mm256_loadu_si256(address);
+    const __m256i low = premultiply_two_avx2(_mm256_unpacklo_epi8(values, zero));
+    const __m256i high = premultiply_two_avx2(_mm256_unpackhi_epi8(values, zero));
+    _mm256_storeu_si256(address, _mm256_packus_epi16(low, high));
+  }
+  premultiply_scalar(pixels + i * 4, num_pixels - i);
+}
+#endif
+
+struct PixelKernels {
+  PixelKernel swap_red_blue = swap_red_blue_scalar;
+  ExpandKernel expand = expand_scalar;
+  ExpandKernel expand_swap = expand_swap_scalar;
+  PremultiplyKernel premultiply = premultiply_scalar;
+};
+
+PixelKernels select_pixel_kernels() {
+  PixelKernels kernels;
+#ifdef CW_PIXELS_SSE2
+  kernels.swap_red_blue = swap_red_blue_sse2;
+  kernels.premultiply = premultiply_sse2;
+#endif
+#ifdef CW_PIXELS_AVX2
+  if (__builtin_cpu_supports("ssse3")) {
+    kernels.expand = expand_keep_ssse3;
+    kernels.expand_swap = expand_swap_ssse3;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    kernels.swap_red_blue = swap_red_blue_avx2;
+    kernels.expand = expand_keep_avx2;
+    kernels.expand_swap = expand_swap_avx2;
+    kernels.premultiply = premultiply_avx2;
+  }
+#endif
+  return kernels;
+}
+
+const PixelKernels pixel_kernels = select_pixel_kernels();
+
+void check_expand_sizes(Span<const SUByte> in, Span<SUByte> out, const char* error) {
+  if (in.size() % 3 != 0 || out.size() < in.size() / 3 * 4) {
+    throw std::invalid_argument(error);
+  }
+}
+
+} // namespace
+
+
+void bgra_to_rgba(Span<const SUByte> in, Span<SUByte> out) {
+  if (in.size() % 4 != 0 || out.size() < in.size()) {
+    throw std::invalid_argument("CW::bgra_to_rgba(): in must hold whole 32 bit pixels, and out must be at least as large as in");
+  }
+  pixel_kernels.swap_red_blue(in.data(), out.data(), in.size() / 4);
+}
+
+
+void bgr_to_bgra(Span<const SUByte> in, Span<SUByte> out, SUByte alpha) {
+  check_expand_sizes(in, out, "CW::bgr_to_bgra(): in must hold whole 24 bit pixels, and out must hold the same number of 32 bit pixels");
+  pixel_kernels.expand(in.data(), out.data(), in.size() / 3, alpha);
+}
+
+
+void bgr_to_rgba(Span<const SUByte> in, Span<SUByte> out, SUByte alpha) {
+  check_expand_sizes(in, out, "CW::bgr_to_rgba(): in must hold whole 24 bit pixels, and out must hold the same number of 32 bit pixels");
+  pixel_kernels.expand_swap(in.data(), out.data(), in.size() / 3, alpha);
+}
+
+
+void premultiply_alpha(Span<SUByte> pixels) {
+  if (pixels.size() % 4 != 0) {
+    throw std::invalid_argument("CW::premultiply_alpha(): pixels must hold whole 32 bit pixels");
+  }
+  pixel_kernels.premultiply(pixels.data(), pixels.size() / 4);
+}
+
+
+void strip_row_padding(Span<const SUByte> in, Span<SUByte> out, size_t width, size_t height, size_t bytes_per_pixel, size_t row_padding) {
+  const size_t row_size = width * bytes_per_pixel;
+  const size_t padded_row_size = row_size + row_padding;
+  if (in.size() < padded_row_size * height || out.size() < row_size * height) {
+    throw std::invalid_argument("CW::strip_row_padding(): buffer is too small for the given image size");
+  }
+  if (row_padding == 0) {
+    if (in.data() != out.data()) {
+      std::memmove(out.data(), in.data(), row_size * height);
+    }
+    return;
+  }
+  // Rows only ever move towards the start of the buffer, so stripping in place is safe.
+  for (size_t row = 0; row < height; ++row) {
+    std::memmove(out.data() + row * row_size, in.data() + row * padded_row_size, row_size);
+  }
+}
+
+} /* namespace CW */
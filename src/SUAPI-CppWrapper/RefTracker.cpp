@@ -0,0 +1,250 @@
+//
+//  RefTracker.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "SUAPI-CppWrapper/RefTracker.hpp"
+
+namespace CW {
+
+namespace {
+
+const size_t NUM_KINDS = static_cast<size_t>(RefKind::NUM_KINDS);
+
+/**
+* The counters of one kind, each on its own cache line so that threads working on different kinds do not contend.
+*/
+struct alignas(64) KindCounters {
+  std::atomic<uint64_t> acquired;
+  std::atomic<uint64_t> released;
+  std::atomic<int64_t> live;
+  std::atomic<int64_t> high_water;
+};
+
+struct SiteEntry {
+  RefKind kind;
+  const char* site;
+};
+
+struct Tracker {
+  KindCounters kinds[NUM_KINDS];
+  std::atomic<bool> tracking_sites;
+  std::mutex sites_mutex;
+  std::unordered_map<const void*, SiteEntry> sites;
+
+  Tracker():
+    tracking_sites(false)
+  {
+    for (KindCounters& counters : kinds) {
+      counters.acquired.store(0);
+      counters.released.store(0);
+      counters.live.store(0);
+      counters.high_water.store(0);
+    }
+  }
+};
+
+Tracker& tracker() {
+  // Never destroyed, so wrapper objects that outlive main() can still report their release.  Built in static storage rather than by operator new, which in C++14 does not honour the cache line alignment of KindCounters.
+  static std::aligned_storage<sizeof(Tracker), alignof(Tracker)>::type storage;
+  static Tracker* tracker = new (&storage) Tracker();
+  return *tracker;
+}
+
+const char* NO_SITE = "(no site)";
+
+thread_local const char* current_site = nullptr;
+
+} // namespace
+
+
+RefTracker::Site::Site(const char* label):
+  m_previous(current_site)
+{
+  current_site = label;
+}
+
+
+RefTracker::Site::~Site() {
+  current_site = m_previous;
+}
+
+
+const char* RefTracker::kind_name(RefKind kind) {
+  switch (kind) {
+    case RefKind::String: return "String";
+    case RefKind::TypedValue: return "TypedValue";
+    case RefKind::Model: return "Model";
+    case RefKind::GeometryInput: return "GeometryInput";
+    case RefKind::LoopInput: return "LoopInput";
+    case RefKind::ImageRep: return "ImageRep";
+    case RefKind::InstancePath: return "InstancePath";
+    case RefKind::Face: return "Face";
+    case RefKind::Edge: return "Edge";
+    case RefKind::Material: return "Material";
+    case RefKind::Layer: return "Layer";
+    case RefKind::ComponentDefinition: return "ComponentDefinition";
+    case RefKind::ComponentInstance: return "ComponentInstance";
+    case RefKind::Group: return "Group";
+    case RefKind::AttributeDictionary: return "AttributeDictionary";
+    case RefKind::Axes: return "Axes";
+    case RefKind::Texture: return "Texture";
+    case RefKind::OtherEntity: return "OtherEntity";
+    case RefKind::NUM_KINDS: break;
+  }
+  return "";
+}
+
+
+RefKind RefTracker::entity_kind(SURefType type) {
+  switch (type) {
+    case SURefType_Face: return RefKind::Face;
+    case SURefType_Edge: return RefKind::Edge;
+    case SURefType_Material: return RefKind::Material;
+    case SURefType_Layer: return RefKind::Layer;
+    case SURefType_ComponentDefinition: return RefKind::ComponentDefinition;
+    case SURefType_ComponentInstance: return RefKind::ComponentInstance;
+    case SURefType_Group: return RefKind::Group;
+    case SURefType_AttributeDictionary: return RefKind::AttributeDictionary;
+    case SURefType_Axes: return RefKind::Axes;
+    case SURefType_Texture: return RefKind::Texture;
+    default: return RefKind::OtherEntity;
+  }
+}
+
+
+void RefTracker::acquired(RefKind kind, const void* ref) {
+  Tracker& t = tracker();
+  KindCounters& counters = t.kinds[static_cast<size_t>(kind)];
+  counters.acquired.fetch_add(1, std::memory_order_relaxed);
+  const int64_t live = counters.live.fetch_add(1, std::memory_order_relaxed) + 1;
+  int64_t high_water = counters.high_water.load(std::memory_order_relaxed);
+  while (live > high_water && !counters.high_water.compare_exchange_weak(high_water, live, std::memory_order_relaxed)) {}
+  if (t.tracking_sites.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(t.sites_mutex);
+    t.sites[ref] = SiteEntry{kind, current_site != nullptr ? current_site : NO_SITE};
+  }
+}
+
+
+void RefTracker::released(RefKind kind, const void* ref) {
+  Tracker& t = tracker();
+  KindCounters& counters = t.kinds[static_cast<size_t>(kind)];
+  counters.released.fetch_add(1, std::memory_order_relaxed);
+  counters.live.fetch_sub(1, std::memory_order_relaxed);
+  if (t.tracking_sites.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(t.sites_mutex);
+    t.sites.erase(ref);
+  }
+}
+
+
+RefCounts RefTracker::counts(RefKind kind) {
+  const KindCounters& counters = tracker().kinds[static_cast<size_t>(kind)];
+  RefCounts ref_counts;
+  ref_counts.acquired = counters.acquired.load(std::memory_order_relaxed);
+  ref_counts.released = counters.released.load(std::memory_order_relaxed);
+  ref_counts.live = counters.live.load(std::memory_order_relaxed);
+  ref_counts.high_water = counters.high_water.load(std::memory_order_relaxed);
+  return ref_counts;
+}
+
+
+int64_t RefTracker::live(RefKind kind) {
+  return tracker().kinds[static_cast<size_t>(kind)].live.load(std::memory_order_relaxed);
+}
+
+
+const void* RefTracker::counters_address(RefKind kind) {
+  return &tracker().kinds[static_cast<size_t>(kind)];
+}
+
+
+void RefTracker::reset_high_water() {
+  for (KindCounters& counters : tracker().kinds) {
+    counters.high_water.store(counters.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+}
+
+
+void RefTracker::track_sites(bool track) {
+  Tracker& t = tracker();
+  std::lock_guard<std::mutex> lock(t.sites_mutex);
+  t.tracking_sites.store(track, std::memory_order_relaxed);
+  if (!track) {
+    t.sites.clear();
+  }
+}
+
+
+std::vector<RefSite> RefTracker::live_sites() {
+  Tracker& t = tracker();
+  std::map<std::pair<RefKind, const char*>, size_t> totals;
+  {
+    std::lock_guard<std::mutex> lock(t.sites_mutex);
+    for (const auto& site : t.sites) {
+      ++totals[std::make_pair(site.second.kind, site.second.site)];
+    }
+  }
+  std::vector<RefSite> sites;
+  sites.reserve(totals.size());
+  for (const auto& total : totals) {
+    sites.push_back(RefSite{total.first.first, total.first.second, total.second});
+  }
+  std::stable_sort(sites.begin(), sites.end(), [](const RefSite& a, const RefSite& b) {
+    return a.live > b.live;
+  });
+  return sites;
+}
+
+
+void RefTracker::write_report(std::ostream& stream) {
+  stream << "kind acquired released live high_water\n";
+  for (size_t i = 0; i < NUM_KINDS; ++i) {
+    const RefKind kind = static_cast<RefKind>(i);
+    const RefCounts ref_counts = counts(kind);
+    if (ref_counts.acquired == 0 && ref_counts.released == 0) {
+      continue;
+    }
+    stream << kind_name(kind) << " " << ref_counts.acquired << " " << ref_counts.released << " " << ref_counts.live << " " << ref_counts.high_water << "\n";
+  }
+  if (tracker().tracking_sites.load(std::memory_order_relaxed)) {
+    stream << "live by site:\n";
+    for (const RefSite& site : live_sites()) {
+      stream << kind_name(site.kind) << " " << site.site << " " << site.live << "\n";
+    }
+  }
+}
+
+} /* namespace CW */
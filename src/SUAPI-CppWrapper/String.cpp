@@ -29,81 +29,187 @@
 #define _unused(x) ((void)(x))
 
 #include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
 
 #include <cassert>
+#include <cstring>
+#include <stdexcept>
 #include <vector>
 
 namespace CW {
 
+constexpr size_t StringBuffer::INLINE_SIZE;
+
+StringBuffer::StringBuffer(size_t size):
+  m_size(size)
+{
+  if (size == SIZE_MAX) {
+    throw std::length_error("CW::StringBuffer::StringBuffer(): size leaves no room for the null terminator");
+  }
+  if (size < INLINE_SIZE) {
+    m_inline[size] = '\0';
+  }
+  else {
+    m_heap.reset(new char[size + 1]);
+    m_heap[size] = '\0';
+  }
+}
+
+constexpr size_t String::NOT_CACHED;
+
 SUStringRef m_string;
 
 String::String():
   m_string(create_string_ref()),
-  m_encoding(StringEncoding::UTF8)
+  m_encoding(StringEncoding::UTF8),
+  m_length(NOT_CACHED),
+  m_hash(0),
+  m_hash_cached(false)
 {}
 
 
 String::String(SUStringRef string_ref):
   m_string(string_ref),
-  m_encoding(StringEncoding::UTF8)
-{}
+  m_encoding(StringEncoding::UTF8),
+  m_length(NOT_CACHED),
+  m_hash(0),
+  m_hash_cached(false)
+{
+  // The String takes over the reference, and releases it when destroyed.
+  if (SUIsValid(m_string)) {
+    RefTracker::acquired(RefKind::String, m_string.ptr);
+  }
+}
 
 
 String::String(const std::string &string_input, StringEncoding enc):
   m_string(create_string_ref(string_input, enc)),
-  m_encoding(enc)
+  m_encoding(enc),
+  m_length(NOT_CACHED),
+  m_hash(0),
+  m_hash_cached(false)
 {}
 
 
 String::String(const char string_input[]):
   m_string(create_string_ref(&string_input[0])),
-  m_encoding(StringEncoding::UTF8)
+  m_encoding(StringEncoding::UTF8),
+  m_length(NOT_CACHED),
+  m_hash(0),
+  m_hash_cached(false)
 {}
 
 
 String::String(const unichar string_input[]):
   m_string(create_string_ref(&string_input[0])),
-  m_encoding(StringEncoding::UTF16)
+  m_encoding(StringEncoding::UTF16),
+  m_length(NOT_CACHED),
+  m_hash(0),
+  m_hash_cached(false)
 {}
 
 
 String::String(const String& other):
-  m_string(create_string_ref(other.std_string(), StringEncoding::UTF8))
+  m_string(create_string_ref(other.view().data())),
+  m_encoding(other.m_encoding),
+  m_length(NOT_CACHED),
+  m_hash(0),
+  m_hash_cached(false)
 {
   // TODO support UTF16
+  copy_cache(other);
 }
 
 
-String& String::operator=(String& other) {
+String::String(String&& other) noexcept:
+  m_string(other.m_string),
+  m_encoding(other.m_encoding),
+  m_length(NOT_CACHED),
+  m_hash(0),
+  m_hash_cached(false)
+{
+  copy_cache(other);
+  other.m_string = SU_INVALID;
+  other.clear_cache();
+}
+
+
+String& String::operator=(const String& other) {
+  if (this == &other) {
+    return *this;
+  }
   // Release old string and create new
   if (SUIsValid(m_string)) {
-    SUResult res = SUStringRelease(&m_string);
+    RefTracker::released(RefKind::String, m_string.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUStringRelease, &m_string);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
   m_string = SU_INVALID;
-  m_string = create_string_ref(other.std_string(), StringEncoding::UTF8);
+  m_string = create_string_ref(other.view().data());
+  m_encoding = other.m_encoding;
+  copy_cache(other);
   return *this;
 }
 
 
+String& String::operator=(String&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (SUIsValid(m_string)) {
+    RefTracker::released(RefKind::String, m_string.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUStringRelease, &m_string);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  m_string = other.m_string;
+  m_encoding = other.m_encoding;
+  copy_cache(other);
+  other.m_string = SU_INVALID;
+  other.clear_cache();
+  return *this;
+}
+
+
+void String::copy_cache(const String& other) {
+  m_length.store(other.m_length.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  const bool hash_cached = other.m_hash_cached.load(std::memory_order_acquire);
+  m_hash.store(other.m_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  m_hash_cached.store(hash_cached, std::memory_order_release);
+}
+
+
 bool operator==(const String &lhs, const String &rhs) {
-  // Check validity
   // Check type
   if (lhs.m_encoding != rhs.m_encoding) {
     return false;
   }
-  // Check value
-  if (lhs.std_string() == rhs.std_string()) {
-    return true;
+  // Cheap checks first, using the cached length and hash.
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  if (lhs.m_hash_cached.load(std::memory_order_acquire) && rhs.m_hash_cached.load(std::memory_order_acquire) &&
+      lhs.m_hash.load(std::memory_order_relaxed) != rhs.m_hash.load(std::memory_order_relaxed)) {
+    return false;
   }
-  return false;
+  // Check value
+  int result = 0;
+  SUResult res = CW_INSTRUMENT_SU(SUStringCompare, lhs.m_string, rhs.m_string, &result);
+  assert(res == SU_ERROR_NONE); _unused(res);
+  return result == 0;
+}
+
+
+bool operator!=(const String &lhs, const String &rhs) {
+  return !(lhs == rhs);
 }
 
 
 SUStringRef String::create_string_ref() {
   SUStringRef string_ref = SU_INVALID;
-  SUResult res = SUStringCreate(&string_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUStringCreate, &string_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
+  RefTracker::acquired(RefKind::String, string_ref.ptr);
   return string_ref;
 }
 
@@ -113,7 +219,9 @@ SUStringRef String::create_string_ref(std::string string_input, StringEncoding e
   if (enc == StringEncoding::UTF8) {
     
     // TODO: to reduce code, use String::create_string_ref(const char* string_input[]).
-    SUStringCreateFromUTF8(&string_ref, &string_input[0]);
+    CW_INSTRUMENT_SU(SUStringCreateFromUTF8, &string_ref, &string_input[0]);
+    CW_INSTRUMENT_BYTES("CW::String", string_input.size());
+    RefTracker::acquired(RefKind::String, string_ref.ptr);
   }
   else {
     // TODO UTF16 to be supported.
@@ -125,7 +233,9 @@ SUStringRef String::create_string_ref(std::string string_input, StringEncoding e
 
 SUStringRef String::create_string_ref(const char string_input[]) {
   SUStringRef string_ref = SU_INVALID;
-  SUStringCreateFromUTF8(&string_ref, &string_input[0]);
+  CW_INSTRUMENT_SU(SUStringCreateFromUTF8, &string_ref, &string_input[0]);
+  CW_INSTRUMENT_BYTES("CW::String", std::strlen(string_input));
+  RefTracker::acquired(RefKind::String, string_ref.ptr);
   return string_ref;
 }
 
@@ -140,7 +250,8 @@ SUStringRef String::create_string_ref(const unichar string_input[]) {
 
 String::~String() {
   if (SUIsValid(m_string)) {
-    SUResult res = SUStringRelease(&m_string);
+    RefTracker::released(RefKind::String, m_string.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUStringRelease, &m_string);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
@@ -152,15 +263,9 @@ SUStringRef String::ref() const {
 
 
 std::string String::std_string() const {
-  size_t out_length = 0;
-  SUResult res = SUStringGetUTF8Length(m_string, &out_length);
-  assert(res == SU_ERROR_NONE);
-  out_length++; // Allow for null terminated string
-  std::vector<char> char_array(out_length, 0);
-  res = SUStringGetUTF8(m_string, out_length, char_array.data(), &out_length);
-  assert(res == SU_ERROR_NONE); _unused(res);
-  std::string str(char_array.data());
-  return str;
+  std::string string;
+  this->std_string(string);
+  return string;
 }
 
 
@@ -169,20 +274,82 @@ String::operator std::string() const {
 }
 
 
-size_t String::size() const {
-  size_t out_length = 0;
-  SUResult res = SUStringGetUTF8Length(m_string, &out_length);
+void String::std_string(std::string& out) const {
+  // Copied straight into the std::string, whose memory is reused when it is large enough.
+  const size_t length = size();
+  out.resize(length);
+  if (length > 0) {
+    size_t copied = 0;
+    SUResult res = CW_INSTRUMENT_SU(SUStringGetUTF8, m_string, length + 1, &out[0], &copied);
+    assert(res == SU_ERROR_NONE); _unused(res);
+    CW_INSTRUMENT_BYTES("CW::String", length);
+  }
+}
+
+
+size_t String::copy_utf8(char* buffer, size_t buffer_size) const {
+  const size_t length = size();
+  if (buffer == nullptr || buffer_size <= length) {
+    return length;
+  }
+  size_t copied = 0;
+  SUResult res = CW_INSTRUMENT_SU(SUStringGetUTF8, m_string, length + 1, buffer, &copied);
   assert(res == SU_ERROR_NONE); _unused(res);
-  return out_length;
+  CW_INSTRUMENT_BYTES("CW::String", length);
+  buffer[length] = '\0';
+  return length;
 }
 
 
-bool String::empty() const {
-  // size of 1 is empty due to the \n character at the end.
-  if (size() == 1) {
-    return true;
+StringBuffer String::view() const {
+  const size_t length = size();
+  StringBuffer buffer(length);
+  if (length > 0) {
+    this->copy_utf8(buffer.data(), length + 1);
+  }
+  return buffer;
+}
+
+
+size_t String::hash() const {
+  if (!m_hash_cached.load(std::memory_order_acquire)) {
+    // FNV-1a.  Threads that race here work out the same value.
+    const StringBuffer buffer = view();
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < buffer.size(); ++i) {
+      hash ^= static_cast<unsigned char>(buffer.data()[i]);
+      hash *= 1099511628211ULL;
+    }
+    m_hash.store(static_cast<size_t>(hash), std::memory_order_relaxed);
+    m_hash_cached.store(true, std::memory_order_release);
+    return static_cast<size_t>(hash);
   }
-  return false;
+  return m_hash.load(std::memory_order_relaxed);
+}
+
+
+size_t String::size() const {
+  size_t length = m_length.load(std::memory_order_relaxed);
+  if (length == NOT_CACHED) {
+    if (SUIsInvalid(m_string)) {
+      // A moved-from String has no SUStringRef, and reads as empty.
+      m_length.store(0, std::memory_order_relaxed);
+      return 0;
+    }
+    length = 0;
+    SUResult res = CW_INSTRUMENT_SU(SUStringGetUTF8Length, m_string, &length);
+    assert(res == SU_ERROR_NONE);
+    if (res != SU_ERROR_NONE || length == NOT_CACHED) {
+      return 0;
+    }
+    m_length.store(length, std::memory_order_relaxed);
+  }
+  return length;
+}
+
+
+bool String::empty() const {
+  return size() == 0;
 }
 
 
@@ -28,8 +28,19 @@
 // Macro for getting rid of unused variables commonly for assert checking
 #define _unused(x) ((void)(x))
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define CW_TRANSFORM_SSE2
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #include <immintrin.h>
+  #define CW_TRANSFORM_AVX2
+#endif
 
 #include "SUAPI-CppWrapper/Transformation.hpp"
 
@@ -43,9 +54,96 @@
 #include "SUAPI-CppWrapper/model/LoopInput.hpp"
 #include "SUAPI-CppWrapper/model/Vertex.hpp"
 #include "SUAPI-CppWrapper/model/Material.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 
+namespace {
+
+/**
+* Batch transformation kernels.  Each one computes out = m * (x, y, z, 1) for an array of 3D coordinates.  The matrix is column-major, the same as SUTransformation::values.
+*/
+typedef void (*TransformKernel)(const double* m, const double* in, double* out, size_t n);
+
+/**
+* Applies the whole matrix, dividing by the w coordinate as SUPoint3DTransform() does.  Used for matrices whose bottom row is not (0, 0, 0, 1), and where no SIMD kernel is available.
+*/
+void transform_scalar(const double* m, const double* in, double* out, size_t n) {
+  for (size_t i = 0; i < n; ++i, in += 3, out += 3) {
+    const double x = in[0];
+    const double y = in[1];
+    const double z = in[2];
+    const double w = m[3] * x + m[7] * y + m[11] * z + m[15];
+    const double scale = (w != 1.0 && w != 0.0) ? 1.0 / w : 1.0;
+    out[0] = (m[0] * x + m[4] * y + m[8] * z + m[12]) * scale;
+    out[1] = (m[1] * x + m[5] * y + m[9] * z + m[13]) * scale;
+    out[2] = (m[2] * x + m[6] * y + m[10] * z + m[14]) * scale;
+  }
+}
+
+/**
+* Returns true if the bottom row of the matrix is (0, 0, 0, 1), so that the SIMD kernels, which ignore it, can be used.
+*/
+bool is_affine(const double* m) {
+  return m[3] == 0.0 && m[7] == 0.0 && m[11] == 0.0 && m[15] == 1.0;
+}
+
+#ifdef CW_TRANSFORM_SSE2
+void transform_sse2(const double* m, const double* in, double* out, size_t n) {
+  // The x and y rows are computed together, and the z row separately.
+  const __m128d column0 = _mm_loadu_pd(m);
+  const __m128d column1 = _mm_loadu_pd(m + 4);
+  const __m128d column2 = _mm_loadu_pd(m + 8);
+  const __m128d column3 = _mm_loadu_pd(m + 12);
+  for (size_t i = 0; i < n; ++i, in += 3, out += 3) {
+    const double x = in[0];
+    const double y = in[1];
+    const double z = in[2];
+    __m128d xy = _mm_add_pd(_mm_mul_pd(column0, _mm_set1_pd(x)), column3);
+    xy = _mm_add_pd(xy, _mm_mul_pd(column1, _mm_set1_pd(y)));
+    xy = _mm_add_pd(xy, _mm_mul_pd(column2, _mm_set1_pd(z)));
+    out[2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+    _mm_storeu_pd(out, xy);
+  }
+}
+#endif
+
+#ifdef CW_TRANSFORM_AVX2
+__attribute__((target("avx2,fma")))
+void transform_avx2(const double* m, const double* in, double* out, size_t n) {
+  const __m256d column0 = _mm256_loadu_pd(m);
+  const __m256d column1 = _mm256_loadu_pd(m + 4);
+  const __m256d column2 = _mm256_loadu_pd(m + 8);
+  const __m256d column3 = _mm256_loadu_pd(m + 12);
+  for (size_t i = 0; i < n; ++i, in += 3, out += 3) {
+    __m256d result = _mm256_fmadd_pd(column2, _mm256_broadcast_sd(in + 2), column3);
+    result = _mm256_fmadd_pd(column1, _mm256_broadcast_sd(in + 1), result);
+    result = _mm256_fmadd_pd(column0, _mm256_broadcast_sd(in), result);
+    // Only the x, y and z lanes are written to the output.  Plain stores are used rather than a masked store, as masked stores stall later loads from the same memory when transforming in place.
+    _mm_storeu_pd(out, _mm256_castpd256_pd128(result));
+    _mm_store_sd(out + 2, _mm256_extractf128_pd(result, 1));
+  }
+}
+#endif
+
+TransformKernel select_transform_kernel() {
+#ifdef CW_TRANSFORM_AVX2
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return transform_avx2;
+  }
+#endif
+#ifdef CW_TRANSFORM_SSE2
+  return transform_sse2;
+#else
+  return transform_scalar;
+#endif
+}
+
+const TransformKernel transform_kernel = select_transform_kernel();
+
+} // namespace
+
+
 Transformation::Transformation():
   Transformation(1.0)
 {}
@@ -62,7 +160,7 @@ Transformation::Transformation(const Axes& axes, const Vector3D& translation, do
 Transformation::  Transformation(const Point3D& origin, const Vector3D& x_axis, const Vector3D& y_axis, const Vector3D& z_axis, double scalar):
   m_transformation(SU_INVALID)
 {
-  SUResult res = SUTransformationSetFromPointAndAxes(&m_transformation, origin, x_axis, y_axis, z_axis);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationSetFromPointAndAxes, &m_transformation, origin, x_axis, y_axis, z_axis);
   assert(res == SU_ERROR_NONE); _unused(res);
   if (scalar != 1.0) {
     // TODO:
@@ -73,7 +171,7 @@ Transformation::  Transformation(const Point3D& origin, const Vector3D& x_axis,
 Transformation::Transformation(double scalar):
   m_transformation(SU_INVALID)
 {
-  SUResult res = SUTransformationScale(&m_transformation, scalar);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationScale, &m_transformation, scalar);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -81,7 +179,7 @@ Transformation::Transformation(double scalar):
 Transformation::Transformation(double x_scale, double y_scale, double z_scale):
   m_transformation(SU_INVALID)
 {
-  SUResult res = SUTransformationNonUniformScale(&m_transformation, x_scale, y_scale, z_scale);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationNonUniformScale, &m_transformation, x_scale, y_scale, z_scale);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -89,7 +187,7 @@ Transformation::Transformation(double x_scale, double y_scale, double z_scale):
 Transformation::Transformation(const Vector3D& translation):
   m_transformation(SU_INVALID)
 {
-  SUResult res = SUTransformationTranslation(&m_transformation, translation);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationTranslation, &m_transformation, translation);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -97,7 +195,7 @@ Transformation::Transformation(const Vector3D& translation):
 Transformation::Transformation(const Point3D& translation, double scalar):
   m_transformation(SU_INVALID)
 {
-  SUResult res = SUTransformationScaleAboutPoint(&m_transformation, translation, scalar);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationScaleAboutPoint, &m_transformation, translation, scalar);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -105,7 +203,7 @@ Transformation::Transformation(const Point3D& translation, double scalar):
 Transformation::Transformation(const Point3D& translation, const Vector3D& normal):
   m_transformation(SU_INVALID)
 {
-  SUResult res = SUTransformationSetFromPointAndNormal(&m_transformation, translation, normal);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationSetFromPointAndNormal, &m_transformation, translation, normal);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -113,7 +211,7 @@ Transformation::Transformation(const Point3D& translation, const Vector3D& norma
 Transformation::Transformation(const Point3D& point, const Vector3D& vector, double angle):
   m_transformation(SU_INVALID)
 {
-  SUResult res = SUTransformationRotation(&m_transformation, point, vector, angle);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationRotation, &m_transformation, point, vector, angle);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -121,7 +219,7 @@ Transformation::Transformation(const Point3D& point, const Vector3D& vector, dou
 Transformation::Transformation(const Transformation& transform1, const Transformation& transform2, double weight):
   m_transformation(SU_INVALID)
 {
-  SUResult res = SUTransformationInterpolate(&m_transformation, transform1, transform2, weight);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationInterpolate, &m_transformation, transform1, transform2, weight);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -190,7 +288,7 @@ Transformation::operator const SUTransformation*() const {
 
 bool Transformation::is_identity() const {
   bool is_identity;
-  SUResult res = SUTransformationIsIdentity(&m_transformation, &is_identity);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationIsIdentity, &m_transformation, &is_identity);
   assert(res == SU_ERROR_NONE); _unused(res);
   return is_identity;
 }
@@ -198,7 +296,7 @@ bool Transformation::is_identity() const {
 
 Transformation Transformation::inverse() const {
   SUTransformation inverse = SU_INVALID;
-  SUResult res = SUTransformationGetInverse(&m_transformation, &inverse);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationGetInverse, &m_transformation, &inverse);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Transformation(inverse);
 }
@@ -206,7 +304,7 @@ Transformation Transformation::inverse() const {
 
 Vector3D Transformation::x_axis() const {
   SUVector3D x_axis = SU_INVALID;
-  SUResult res = SUTransformationGetXAxis(&m_transformation, &x_axis);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationGetXAxis, &m_transformation, &x_axis);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Vector3D(x_axis);
 }
@@ -214,7 +312,7 @@ Vector3D Transformation::x_axis() const {
 
 Vector3D Transformation::y_axis() const {
   SUVector3D y_axis = SU_INVALID;
-  SUResult res = SUTransformationGetYAxis(&m_transformation, &y_axis);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationGetYAxis, &m_transformation, &y_axis);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Vector3D(y_axis);
 }
@@ -222,7 +320,7 @@ Vector3D Transformation::y_axis() const {
 
 Vector3D Transformation::z_axis() const {
   SUVector3D z_axis = SU_INVALID;
-  SUResult res = SUTransformationGetZAxis(&m_transformation, &z_axis);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationGetZAxis, &m_transformation, &z_axis);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Vector3D(z_axis);
 }
@@ -230,7 +328,7 @@ Vector3D Transformation::z_axis() const {
 
 double Transformation::z_rotation() const {
   double z_rotation;
-  SUResult res = SUTransformationGetZRotation(&m_transformation, &z_rotation);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationGetZRotation, &m_transformation, &z_rotation);
   assert(res == SU_ERROR_NONE); _unused(res);
   return z_rotation;
 }
@@ -252,7 +350,7 @@ Transformation& Transformation::normalize() {
 
 Point3D Transformation::origin() const {
   SUPoint3D origin = SU_INVALID;
-  SUResult res = SUTransformationGetOrigin(&m_transformation, &origin);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationGetOrigin, &m_transformation, &origin);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Point3D(origin);
 }
@@ -268,12 +366,103 @@ Vector3D Transformation::translation() const {
   
 Transformation Transformation::operator*(Transformation transform) {
   SUTransformation out_transform = SU_INVALID;
-  SUResult res = SUTransformationMultiply(&m_transformation, &transform.m_transformation, &out_transform);
+  SUResult res = CW_INSTRUMENT_SU(SUTransformationMultiply, &m_transformation, &transform.m_transformation, &out_transform);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Transformation(out_transform);
 }
 
 
+void Transformation::apply(const SUPoint3D* in, SUPoint3D* out, size_t n) const {
+  static_assert(sizeof(SUPoint3D) == 3 * sizeof(double), "SUPoint3D must be three packed doubles");
+  if (n == 0) {
+    return;
+  }
+  const double* m = m_transformation.values;
+  // Projective transformations need the w coordinate of each point.
+  const TransformKernel kernel = is_affine(m) ? transform_kernel : transform_scalar;
+  kernel(m, &in[0].x, &out[0].x, n);
+}
+
+
+void Transformation::apply(std::vector<Point3D>& points) const {
+  SUPoint3D* su_points = reinterpret_cast<SUPoint3D*>(points.data());
+  this->apply(su_points, su_points, points.size());
+}
+
+
+void Transformation::apply(const SUVector3D* in, SUVector3D* out, size_t n) const {
+  static_assert(sizeof(SUVector3D) == 3 * sizeof(double), "SUVector3D must be three packed doubles");
+  if (n == 0) {
+    return;
+  }
+  double m[16];
+  std::copy(m_transformation.values, m_transformation.values + 16, m);
+  // Vectors are not translated, and have no w coordinate for the projective row to act on, but are scaled by m[15] as SUVector3DTransform() does.
+  m[12] = m[13] = m[14] = 0.0;
+  m[3] = m[7] = m[11] = 0.0;
+  const TransformKernel kernel = is_affine(m) ? transform_kernel : transform_scalar;
+  kernel(m, &in[0].x, &out[0].x, n);
+}
+
+
+void Transformation::apply(std::vector<Vector3D>& vectors) const {
+  SUVector3D* su_vectors = reinterpret_cast<SUVector3D*>(vectors.data());
+  this->apply(su_vectors, su_vectors, vectors.size());
+}
+
+
+void Transformation::apply_normals(const SUVector3D* in, SUVector3D* out, size_t n) const {
+  if (n == 0) {
+    return;
+  }
+  // Normals are transformed by the cofactor matrix of the upper 3x3 matrix, which is the inverse transpose multiplied by the determinant.  This keeps normals of mirrored faces consistent with their loops.
+  const double* t = m_transformation.values;
+  double m[16] = {
+    t[5] * t[10] - t[6] * t[9], t[6] * t[8] - t[4] * t[10], t[4] * t[9] - t[5] * t[8], 0.0,
+    t[9] * t[2] - t[10] * t[1], t[10] * t[0] - t[8] * t[2], t[8] * t[1] - t[9] * t[0], 0.0,
+    t[1] * t[6] - t[2] * t[5], t[2] * t[4] - t[0] * t[6], t[0] * t[5] - t[1] * t[4], 0.0,
+    0.0, 0.0, 0.0, 1.0
+  };
+  transform_kernel(m, &in[0].x, &out[0].x, n);
+  for (size_t i = 0; i < n; ++i) {
+    const double length = std::sqrt(out[i].x * out[i].x + out[i].y * out[i].y + out[i].z * out[i].z);
+    if (length > 0.0) {
+      out[i].x /= length;
+      out[i].y /= length;
+      out[i].z /= length;
+    }
+  }
+}
+
+
+void Transformation::apply(const SUPlane3D* in, SUPlane3D* out, size_t n) const {
+  if (n == 0) {
+    return;
+  }
+  // Planes are transformed by the inverse transpose of the transformation.
+  const SUTransformation inverse_transform = this->inverse().ref();
+  const double* v = inverse_transform.values;
+  for (size_t i = 0; i < n; ++i) {
+    const double a = in[i].a;
+    const double b = in[i].b;
+    const double c = in[i].c;
+    const double d = in[i].d;
+    double out_a = v[0] * a + v[1] * b + v[2] * c + v[3] * d;
+    double out_b = v[4] * a + v[5] * b + v[6] * c + v[7] * d;
+    double out_c = v[8] * a + v[9] * b + v[10] * c + v[11] * d;
+    double out_d = v[12] * a + v[13] * b + v[14] * c + v[15] * d;
+    const double length = std::sqrt(out_a * out_a + out_b * out_b + out_c * out_c);
+    if (length > 0.0) {
+      out_a /= length;
+      out_b /= length;
+      out_c /= length;
+      out_d /= length;
+    }
+    out[i] = SUPlane3D{out_a, out_b, out_c, out_d};
+  }
+}
+
+
 /**
 * Friend Functions of class Transformation
 */
@@ -282,7 +471,7 @@ Vector3D operator*(const Transformation &lhs, const Vector3D &rhs) {
     throw std::invalid_argument("CW::Transformation::operator*(const Vector3D &lhs, const Transformation &rhs): Vector3D given is null");
   }
   SUVector3D transformed = rhs;
-  SUResult res = SUVector3DTransform(&lhs.m_transformation, &transformed);
+  SUResult res = CW_INSTRUMENT_SU(SUVector3DTransform, &lhs.m_transformation, &transformed);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Vector3D(transformed);
 }
@@ -300,7 +489,7 @@ Point3D operator*(const Transformation &lhs, const Point3D &rhs) {
     throw std::invalid_argument("CW::Transformation::operator*(const Point3D &lhs, const Transformation &rhs): Point3D given is null");
   }
   SUPoint3D transformed = rhs;
-  SUResult res = SUPoint3DTransform(&lhs.m_transformation, &transformed);
+  SUResult res = CW_INSTRUMENT_SU(SUPoint3DTransform, &lhs.m_transformation, &transformed);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Vector3D(transformed);
 }
@@ -320,7 +509,7 @@ Plane3D operator*(const Transformation &lhs, const Plane3D &rhs) {
     throw std::invalid_argument("CW::Transformation::operator*(const Transformation &lhs, const Plane3D &rhs): Plane3D given is null");
   }
   SUPlane3D transformed = rhs;
-  SUResult res = SUPlane3DTransform(&lhs.m_transformation, &transformed);
+  SUResult res = CW_INSTRUMENT_SU(SUPlane3DTransform, &lhs.m_transformation, &transformed);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Plane3D(transformed);
 }
@@ -0,0 +1,527 @@
+//
+//  Triangulator.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "SUAPI-CppWrapper/Triangulator.hpp"
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+
+namespace CW {
+
+/**************************
+* TriangleMesh
+**************************/
+size_t TriangleMesh::num_triangles() const {
+  return indices.size() / 3;
+}
+
+
+size_t TriangleMesh::num_polygons() const {
+  if (polygon_offsets.empty()) {
+    return 0;
+  }
+  return polygon_offsets.size() - 1;
+}
+
+
+void TriangleMesh::clear() {
+  positions.clear();
+  indices.clear();
+  polygon_offsets.clear();
+}
+
+
+/**************************
+* Triangulator
+* The algorithm follows the earcut library by Mapbox (ISC License), with the linked list of points held in an array of nodes.
+**************************/
+constexpr uint32_t Triangulator::NONE;
+
+size_t Triangulator::triangulate(const std::vector<std::vector<Point3D>>& loops, const Vector3D& normal, TriangleMesh& mesh) {
+  std::vector<SUPoint3D> points;
+  std::vector<size_t> loop_offsets(1, 0);
+  loop_offsets.reserve(loops.size() + 1);
+  for (const std::vector<Point3D>& loop : loops) {
+    points.insert(points.end(), loop.begin(), loop.end());
+    loop_offsets.push_back(points.size());
+  }
+  return this->triangulate(points.data(), loop_offsets.data(), loops.size(), normal, mesh);
+}
+
+
+size_t Triangulator::triangulate(const SUPoint3D* points, const size_t* loop_offsets, size_t num_loops, const Vector3D& normal, TriangleMesh& mesh) {
+  if (mesh.polygon_offsets.empty()) {
+    mesh.polygon_offsets.push_back(mesh.num_triangles());
+  }
+  const size_t num_triangles = mesh.num_triangles();
+  const size_t num_points = num_loops == 0 ? 0 : loop_offsets[num_loops] - loop_offsets[0];
+  const uint32_t first_index = static_cast<uint32_t>(mesh.positions.size());
+  mesh.positions.insert(mesh.positions.end(), points + loop_offsets[0], points + loop_offsets[0] + num_points);
+
+  // Project onto the axis plane that the normal is closest to, keeping the winding around the normal.
+  const double normal_x = std::fabs(normal.x);
+  const double normal_y = std::fabs(normal.y);
+  const double normal_z = std::fabs(normal.z);
+  int u_axis = 0;
+  int v_axis = 1;
+  double direction = normal.z;
+  if (normal_x > normal_y && normal_x > normal_z) {
+    u_axis = 1;
+    v_axis = 2;
+    direction = normal.x;
+  }
+  else if (normal_y > normal_z) {
+    u_axis = 2;
+    v_axis = 0;
+    direction = normal.y;
+  }
+  const double u_sign = direction < 0.0 ? -1.0 : 1.0;
+  auto coordinate = [](const SUPoint3D& point, int axis) {
+    return axis == 0 ? point.x : axis == 1 ? point.y : point.z;
+  };
+  m_coordinates.resize(num_points * 2);
+  for (size_t i = 0; i < num_points; ++i) {
+    const SUPoint3D& point = points[loop_offsets[0] + i];
+    m_coordinates[2 * i] = u_sign * coordinate(point, u_axis);
+    m_coordinates[2 * i + 1] = coordinate(point, v_axis);
+  }
+
+  m_nodes.clear();
+  m_nodes.reserve(num_points + 2 * num_loops);
+  m_holes.clear();
+  if (num_points >= 3) {
+    const size_t outer_end = loop_offsets[1] - loop_offsets[0];
+    uint32_t outer_node = this->linked_list(m_coordinates.data(), first_index, 0, outer_end, true);
+    if (outer_node != NONE && m_nodes[outer_node].next != m_nodes[outer_node].prev) {
+      for (size_t i = 1; i < num_loops; ++i) {
+        uint32_t hole = this->linked_list(m_coordinates.data(), first_index, loop_offsets[i] - loop_offsets[0], loop_offsets[i + 1] - loop_offsets[0], false);
+        if (hole == NONE) {
+          continue;
+        }
+        if (m_nodes[hole].next == hole) {
+          m_nodes[hole].steiner = true;
+        }
+        m_holes.push_back(this->leftmost(hole));
+      }
+      std::sort(m_holes.begin(), m_holes.end(), [this](uint32_t a, uint32_t b) {
+        return m_nodes[a].x < m_nodes[b].x;
+      });
+      for (uint32_t hole : m_holes) {
+        outer_node = this->eliminate_hole(hole, outer_node);
+      }
+      this->earcut_linked(outer_node, mesh.indices, 0);
+    }
+  }
+  mesh.polygon_offsets.push_back(mesh.num_triangles());
+  return mesh.num_triangles() - num_triangles;
+}
+
+
+uint32_t Triangulator::insert_node(uint32_t index, double x, double y, uint32_t last) {
+  const uint32_t node = static_cast<uint32_t>(m_nodes.size());
+  m_nodes.push_back(Node{index, x, y, node, node, false});
+  if (last != NONE) {
+    Node& p = m_nodes[node];
+    p.next = m_nodes[last].next;
+    p.prev = last;
+    m_nodes[p.next].prev = node;
+    m_nodes[last].next = node;
+  }
+  return node;
+}
+
+
+void Triangulator::remove_node(uint32_t node) {
+  const Node& p = m_nodes[node];
+  m_nodes[p.next].prev = p.prev;
+  m_nodes[p.prev].next = p.next;
+}
+
+
+uint32_t Triangulator::linked_list(const double* coordinates, uint32_t first_index, size_t begin, size_t end, bool outer) {
+  if (end <= begin) {
+    return NONE;
+  }
+  // Twice the signed area; positive for counter-clockwise loops.
+  double signed_area = 0.0;
+  for (size_t i = begin, j = end - 1; i < end; j = i++) {
+    signed_area += (coordinates[2 * j] - coordinates[2 * i]) * (coordinates[2 * i + 1] + coordinates[2 * j + 1]);
+  }
+  // The outer loop is linked counter-clockwise, and holes clockwise.
+  uint32_t last = NONE;
+  if (outer == (signed_area > 0.0)) {
+    for (size_t i = begin; i < end; ++i) {
+      last = this->insert_node(first_index + static_cast<uint32_t>(i), coordinates[2 * i], coordinates[2 * i + 1], last);
+    }
+  }
+  else {
+    for (size_t i = end; i-- > begin;) {
+      last = this->insert_node(first_index + static_cast<uint32_t>(i), coordinates[2 * i], coordinates[2 * i + 1], last);
+    }
+  }
+  if (last != NONE && this->equals(last, m_nodes[last].next)) {
+    this->remove_node(last);
+    last = m_nodes[last].next;
+  }
+  return last;
+}
+
+
+uint32_t Triangulator::filter_points(uint32_t start, uint32_t end) {
+  if (start == NONE) {
+    return start;
+  }
+  if (end == NONE) {
+    end = start;
+  }
+  uint32_t p = start;
+  bool again;
+  do {
+    again = false;
+    const Node& node = m_nodes[p];
+    if (!node.steiner && (this->equals(p, node.next) || this->area(node.prev, p, node.next) == 0.0)) {
+      this->remove_node(p);
+      p = end = node.prev;
+      if (p == m_nodes[p].next) {
+        break;
+      }
+      again = true;
+    }
+    else {
+      p = node.next;
+    }
+  } while (again || p != end);
+  return end;
+}
+
+
+void Triangulator::earcut_linked(uint32_t ear, std::vector<uint32_t>& indices, int pass) {
+  if (ear == NONE) {
+    return;
+  }
+  uint32_t stop = ear;
+  while (m_nodes[ear].prev != m_nodes[ear].next) {
+    const uint32_t prev = m_nodes[ear].prev;
+    const uint32_t next = m_nodes[ear].next;
+    if (this->is_ear(ear)) {
+      indices.push_back(m_nodes[prev].index);
+      indices.push_back(m_nodes[ear].index);
+      indices.push_back(m_nodes[next].index);
+      this->remove_node(ear);
+      // Skipping the next vertex leads to less sliver triangles.
+      ear = m_nodes[next].next;
+      stop = ear;
+      continue;
+    }
+    ear = next;
+    if (ear == stop) {
+      // No ear was found in a whole pass over the loop; clean up the loop and try again.
+      if (pass == 0) {
+        this->earcut_linked(this->filter_points(ear), indices, 1);
+      }
+      else if (pass == 1) {
+        ear = this->cure_local_intersections(this->filter_points(ear), indices);
+        this->earcut_linked(ear, indices, 2);
+      }
+      else if (pass == 2) {
+        this->split_earcut(ear, indices);
+      }
+      break;
+    }
+  }
+}
+
+
+bool Triangulator::is_ear(uint32_t ear) const {
+  const Node& a = m_nodes[m_nodes[ear].prev];
+  const Node& b = m_nodes[ear];
+  const Node& c = m_nodes[b.next];
+  if (this->area(b.prev, ear, b.next) >= 0.0) {
+    return false; // reflex
+  }
+  const double min_x = std::min(a.x, std::min(b.x, c.x));
+  const double min_y = std::min(a.y, std::min(b.y, c.y));
+  const double max_x = std::max(a.x, std::max(b.x, c.x));
+  const double max_y = std::max(a.y, std::max(b.y, c.y));
+  // No other point may lie inside the ear.
+  for (uint32_t p = c.next; p != b.prev; p = m_nodes[p].next) {
+    const Node& node = m_nodes[p];
+    if (node.x >= min_x && node.x <= max_x && node.y >= min_y && node.y <= max_y &&
+        (c.x - node.x) * (a.y - node.y) >= (a.x - node.x) * (c.y - node.y) &&
+        (a.x - node.x) * (b.y - node.y) >= (b.x - node.x) * (a.y - node.y) &&
+        (b.x - node.x) * (c.y - node.y) >= (c.x - node.x) * (b.y - node.y) &&
+        this->area(node.prev, p, node.next) >= 0.0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+uint32_t Triangulator::cure_local_intersections(uint32_t start, std::vector<uint32_t>& indices) {
+  uint32_t p = start;
+  do {
+    const uint32_t a = m_nodes[p].prev;
+    const uint32_t p_next = m_nodes[p].next;
+    const uint32_t b = m_nodes[p_next].next;
+    if (!this->equals(a, b) && this->intersects(a, p, p_next, b) && this->locally_inside(a, b) && this->locally_inside(b, a)) {
+      indices.push_back(m_nodes[a].index);
+      indices.push_back(m_nodes[p].index);
+      indices.push_back(m_nodes[b].index);
+      this->remove_node(p);
+      this->remove_node(p_next);
+      p = start = b;
+    }
+    p = m_nodes[p].next;
+  } while (p != start);
+  return this->filter_points(p);
+}
+
+
+void Triangulator::split_earcut(uint32_t start, std::vector<uint32_t>& indices) {
+  // Look for a valid diagonal that divides the polygon into two, and triangulate each.
+  uint32_t a = start;
+  do {
+    uint32_t b = m_nodes[m_nodes[a].next].next;
+    while (b != m_nodes[a].prev) {
+      if (m_nodes[a].index != m_nodes[b].index && this->is_valid_diagonal(a, b)) {
+        uint32_t c = this->split_polygon(a, b);
+        a = this->filter_points(a, m_nodes[a].next);
+        c = this->filter_points(c, m_nodes[c].next);
+        this->earcut_linked(a, indices, 0);
+        this->earcut_linked(c, indices, 0);
+        return;
+      }
+      b = m_nodes[b].next;
+    }
+    a = m_nodes[a].next;
+  } while (a != start);
+}
+
+
+uint32_t Triangulator::eliminate_hole(uint32_t hole, uint32_t outer_node) {
+  const uint32_t bridge = this->find_hole_bridge(hole, outer_node);
+  if (bridge == NONE) {
+    return outer_node;
+  }
+  const uint32_t bridge_reverse = this->split_polygon(bridge, hole);
+  this->filter_points(bridge_reverse, m_nodes[bridge_reverse].next);
+  return this->filter_points(bridge, m_nodes[bridge].next);
+}
+
+
+uint32_t Triangulator::find_hole_bridge(uint32_t hole, uint32_t outer_node) const {
+  const double hx = m_nodes[hole].x;
+  const double hy = m_nodes[hole].y;
+  double qx = -std::numeric_limits<double>::infinity();
+  uint32_t m = NONE;
+  // Find the segment of the outer loop to the left of the hole point, closest to it along a horizontal ray.
+  uint32_t p = outer_node;
+  do {
+    const Node& node = m_nodes[p];
+    const Node& next = m_nodes[node.next];
+    if (hy <= node.y && hy >= next.y && next.y != node.y) {
+      const double x = node.x + (hy - node.y) * (next.x - node.x) / (next.y - node.y);
+      if (x <= hx && x > qx) {
+        qx = x;
+        m = node.x < next.x ? p : node.next;
+        if (x == hx) {
+          return m; // the hole touches the outer segment
+        }
+      }
+    }
+    p = node.next;
+  } while (p != outer_node);
+  if (m == NONE) {
+    return NONE;
+  }
+
+  // Look for points inside the triangle of the hole point, the segment intersection and its endpoint, and pick the one with the smallest angle to the ray.
+  const uint32_t stop = m;
+  const double mx = m_nodes[m].x;
+  const double my = m_nodes[m].y;
+  double tan_min = std::numeric_limits<double>::infinity();
+  p = m;
+  do {
+    const Node& node = m_nodes[p];
+    const double ax = hy < my ? hx : qx;
+    const double cx = hy < my ? qx : hx;
+    if (hx >= node.x && node.x >= mx && hx != node.x &&
+        (cx - node.x) * (hy - node.y) >= (ax - node.x) * (hy - node.y) &&
+        (ax - node.x) * (my - node.y) >= (mx - node.x) * (hy - node.y) &&
+        (mx - node.x) * (hy - node.y) >= (cx - node.x) * (my - node.y)) {
+      const double tan = std::fabs(hy - node.y) / (hx - node.x);
+      if (this->locally_inside(p, hole) &&
+          (tan < tan_min || (tan == tan_min && (node.x > m_nodes[m].x || (node.x == m_nodes[m].x && this->sector_contains_sector(m, p)))))) {
+        m = p;
+        tan_min = tan;
+      }
+    }
+    p = node.next;
+  } while (p != stop);
+  return m;
+}
+
+
+bool Triangulator::sector_contains_sector(uint32_t m, uint32_t p) const {
+  return this->area(m_nodes[m].prev, m, m_nodes[p].prev) < 0.0 && this->area(m_nodes[p].next, m, m_nodes[m].next) < 0.0;
+}
+
+
+uint32_t Triangulator::split_polygon(uint32_t a, uint32_t b) {
+  // Links a to b with a new pair of nodes, splitting the loop in two.
+  const uint32_t a2 = this->insert_node(m_nodes[a].index, m_nodes[a].x, m_nodes[a].y, NONE);
+  const uint32_t b2 = this->insert_node(m_nodes[b].index, m_nodes[b].x, m_nodes[b].y, NONE);
+  const uint32_t an = m_nodes[a].next;
+  const uint32_t bp = m_nodes[b].prev;
+  m_nodes[a].next = b;
+  m_nodes[b].prev = a;
+  m_nodes[a2].next = an;
+  m_nodes[an].prev = a2;
+  m_nodes[b2].next = a2;
+  m_nodes[a2].prev = b2;
+  m_nodes[bp].next = b2;
+  m_nodes[b2].prev = bp;
+  return b2;
+}
+
+
+uint32_t Triangulator::leftmost(uint32_t start) const {
+  uint32_t p = start;
+  uint32_t left = start;
+  do {
+    if (m_nodes[p].x < m_nodes[left].x || (m_nodes[p].x == m_nodes[left].x && m_nodes[p].y < m_nodes[left].y)) {
+      left = p;
+    }
+    p = m_nodes[p].next;
+  } while (p != start);
+  return left;
+}
+
+
+bool Triangulator::is_valid_diagonal(uint32_t a, uint32_t b) const {
+  const Node& node_a = m_nodes[a];
+  const Node& node_b = m_nodes[b];
+  if (m_nodes[node_a.next].index == node_b.index || m_nodes[node_a.prev].index == node_b.index || this->intersects_polygon(a, b)) {
+    return false;
+  }
+  if (this->locally_inside(a, b) && this->locally_inside(b, a) && this->middle_inside(a, b) &&
+      (this->area(node_a.prev, a, node_b.prev) != 0.0 || this->area(a, node_b.prev, b) != 0.0)) {
+    return true;
+  }
+  return this->equals(a, b) && this->area(node_a.prev, a, node_a.next) > 0.0 && this->area(node_b.prev, b, node_b.next) > 0.0;
+}
+
+
+bool Triangulator::intersects_polygon(uint32_t a, uint32_t b) const {
+  const uint32_t index_a = m_nodes[a].index;
+  const uint32_t index_b = m_nodes[b].index;
+  uint32_t p = a;
+  do {
+    const uint32_t next = m_nodes[p].next;
+    if (m_nodes[p].index != index_a && m_nodes[next].index != index_a &&
+        m_nodes[p].index != index_b && m_nodes[next].index != index_b &&
+        this->intersects(p, next, a, b)) {
+      return true;
+    }
+    p = next;
+  } while (p != a);
+  return false;
+}
+
+
+bool Triangulator::locally_inside(uint32_t a, uint32_t b) const {
+  const Node& node = m_nodes[a];
+  if (this->area(node.prev, a, node.next) < 0.0) {
+    return this->area(a, b, node.next) >= 0.0 && this->area(a, node.prev, b) >= 0.0;
+  }
+  return this->area(a, b, node.prev) < 0.0 || this->area(a, node.next, b) < 0.0;
+}
+
+
+bool Triangulator::middle_inside(uint32_t a, uint32_t b) const {
+  // Even-odd test of the midpoint of the diagonal.
+  bool inside = false;
+  const double px = (m_nodes[a].x + m_nodes[b].x) / 2.0;
+  const double py = (m_nodes[a].y + m_nodes[b].y) / 2.0;
+  uint32_t p = a;
+  do {
+    const Node& node = m_nodes[p];
+    const Node& next = m_nodes[node.next];
+    if (((node.y > py) != (next.y > py)) && next.y != node.y &&
+        (px < (next.x - node.x) * (py - node.y) / (next.y - node.y) + node.x)) {
+      inside = !inside;
+    }
+    p = node.next;
+  } while (p != a);
+  return inside;
+}
+
+
+double Triangulator::area(uint32_t p, uint32_t q, uint32_t r) const {
+  const Node& node_p = m_nodes[p];
+  const Node& node_q = m_nodes[q];
+  const Node& node_r = m_nodes[r];
+  return (node_q.y - node_p.y) * (node_r.x - node_q.x) - (node_q.x - node_p.x) * (node_r.y - node_q.y);
+}
+
+
+bool Triangulator::equals(uint32_t a, uint32_t b) const {
+  return m_nodes[a].x == m_nodes[b].x && m_nodes[a].y == m_nodes[b].y;
+}
+
+
+bool Triangulator::intersects(uint32_t p1, uint32_t q1, uint32_t p2, uint32_t q2) const {
+  auto sign = [](double value) {
+    return value > 0.0 ? 1 : value < 0.0 ? -1 : 0;
+  };
+  // True if q lies within the bounding box of segment p-r.
+  auto on_segment = [this](uint32_t p, uint32_t q, uint32_t r) {
+    const Node& node_p = m_nodes[p];
+    const Node& node_q = m_nodes[q];
+    const Node& node_r = m_nodes[r];
+    return node_q.x <= std::max(node_p.x, node_r.x) && node_q.x >= std::min(node_p.x, node_r.x) &&
+      node_q.y <= std::max(node_p.y, node_r.y) && node_q.y >= std::min(node_p.y, node_r.y);
+  };
+  const int o1 = sign(this->area(p1, q1, p2));
+  const int o2 = sign(this->area(p1, q1, q2));
+  const int o3 = sign(this->area(p2, q2, p1));
+  const int o4 = sign(this->area(p2, q2, q1));
+  if (o1 != o2 && o3 != o4) {
+    return true;
+  }
+  return (o1 == 0 && on_segment(p1, p2, q1)) ||
+    (o2 == 0 && on_segment(p1, q2, q1)) ||
+    (o3 == 0 && on_segment(p2, p1, q2)) ||
+    (o4 == 0 && on_segment(p2, q1, q2));
+}
+
+} /* namespace CW */
@@ -0,0 +1,141 @@
+//
+//  VertexWelder.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "SUAPI-CppWrapper/VertexWelder.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace CW {
+
+constexpr size_t VertexWelder::NOT_FOUND;
+
+
+VertexWelder::VertexWelder(double tolerance):
+  m_tolerance(tolerance)
+{
+  if (!(tolerance > 0.0)) {
+    throw std::invalid_argument("CW::VertexWelder::VertexWelder(): tolerance must be greater than 0");
+  }
+}
+
+
+VertexWelder::Cell VertexWelder::cell(const Point3D& point) const {
+  return Cell{
+    static_cast<int64_t>(std::floor(point.x / m_tolerance)),
+    static_cast<int64_t>(std::floor(point.y / m_tolerance)),
+    static_cast<int64_t>(std::floor(point.z / m_tolerance))};
+}
+
+
+size_t VertexWelder::find(const Point3D& point) const {
+  if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+    return NOT_FOUND;
+  }
+  // A coincident point is at most one cell away along each axis.  The earliest recorded match is returned, so the result does not depend on the order the cells are visited in.
+  const Cell centre = cell(point);
+  size_t found = NOT_FOUND;
+  size_t found_entry = NOT_FOUND;
+  for (int64_t dx = -1; dx <= 1; ++dx) {
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+      for (int64_t dz = -1; dz <= 1; ++dz) {
+        auto it = m_cells.find(Cell{centre.x + dx, centre.y + dy, centre.z + dz});
+        if (it == m_cells.end()) {
+          continue;
+        }
+        for (size_t i = it->second; i != NOT_FOUND; i = m_entries[i].next) {
+          const Point3D& other = m_entries[i].point;
+          if (i < found_entry &&
+              std::abs(other.x - point.x) < m_tolerance &&
+              std::abs(other.y - point.y) < m_tolerance &&
+              std::abs(other.z - point.z) < m_tolerance) {
+            found_entry = i;
+            found = m_entries[i].index;
+          }
+        }
+      }
+    }
+  }
+  return found;
+}
+
+
+void VertexWelder::add(const Point3D& point, size_t index) {
+  if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+    return;
+  }
+  const size_t entry = m_entries.size();
+  // Entries are pushed at the front of their cell's list, so each list runs from the newest entry to the oldest.
+  auto inserted = m_cells.emplace(cell(point), entry);
+  size_t next = NOT_FOUND;
+  if (!inserted.second) {
+    next = inserted.first->second;
+    inserted.first->second = entry;
+  }
+  m_entries.push_back(Entry{point, index, next});
+}
+
+
+size_t VertexWelder::weld(const Point3D& point, size_t index) {
+  const size_t existing = find(point);
+  if (existing != NOT_FOUND) {
+    ++m_duplicates;
+    return existing;
+  }
+  add(point, index);
+  return index;
+}
+
+
+size_t VertexWelder::size() const {
+  return m_entries.size();
+}
+
+
+size_t VertexWelder::duplicates() const {
+  return m_duplicates;
+}
+
+
+double VertexWelder::tolerance() const {
+  return m_tolerance;
+}
+
+
+void VertexWelder::reserve(size_t num_points) {
+  m_entries.reserve(num_points);
+  m_cells.reserve(num_points);
+}
+
+
+void VertexWelder::clear() {
+  m_entries.clear();
+  m_cells.clear();
+  m_duplicates = 0;
+}
+
+} /* namespace CW */
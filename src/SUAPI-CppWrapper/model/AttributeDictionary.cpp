@@ -34,13 +34,174 @@
 
 #include "SUAPI-CppWrapper/model/AttributeDictionary.hpp"
 
+#include "SUAPI-CppWrapper/model/AttributeSnapshot.hpp"
 #include "SUAPI-CppWrapper/model/TypedValue.hpp"
 #include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 
 extern size_t SU_VERSION_MAJOR;
 
+namespace {
+
+/**
+* Copies the value held by a SUTypedValueRef into an AttributeValue.  The string object is reused to read string values.
+*/
+void read_typed_value(SUTypedValueRef typed_value, String& string, AttributeValue& value) {
+  SUTypedValueType type = SUTypedValueType_Empty;
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetType, typed_value, &type);
+  assert(res == SU_ERROR_NONE);
+  switch (type) {
+    case SUTypedValueType_Empty:
+      value = AttributeValue();
+      break;
+    case SUTypedValueType_Byte: {
+      char byte_val = 0;
+      res = CW_INSTRUMENT_SU(SUTypedValueGetByte, typed_value, &byte_val);
+      value.byte_value(byte_val);
+      break;
+    }
+    case SUTypedValueType_Short: {
+      int16_t int16_val = 0;
+      res = CW_INSTRUMENT_SU(SUTypedValueGetInt16, typed_value, &int16_val);
+      value.int16_value(int16_val);
+      break;
+    }
+    case SUTypedValueType_Int32: {
+      int32_t int32_val = 0;
+      res = CW_INSTRUMENT_SU(SUTypedValueGetInt32, typed_value, &int32_val);
+      value.int32_value(int32_val);
+      break;
+    }
+    case SUTypedValueType_Float: {
+      float float_val = 0.0f;
+      res = CW_INSTRUMENT_SU(SUTypedValueGetFloat, typed_value, &float_val);
+      value.float_value(float_val);
+      break;
+    }
+    case SUTypedValueType_Double: {
+      double double_val = 0.0;
+      res = CW_INSTRUMENT_SU(SUTypedValueGetDouble, typed_value, &double_val);
+      value.double_value(double_val);
+      break;
+    }
+    case SUTypedValueType_Bool: {
+      bool bool_val = false;
+      res = CW_INSTRUMENT_SU(SUTypedValueGetBool, typed_value, &bool_val);
+      value.bool_value(bool_val);
+      break;
+    }
+    case SUTypedValueType_Color: {
+      SUColor color_val = SUColor{0, 0, 0, 0};
+      res = CW_INSTRUMENT_SU(SUTypedValueGetColor, typed_value, &color_val);
+      value.color_value(Color(color_val));
+      break;
+    }
+    case SUTypedValueType_Time: {
+      int64_t time_val = 0;
+      res = CW_INSTRUMENT_SU(SUTypedValueGetTime, typed_value, &time_val);
+      value.time_value(time_val);
+      break;
+    }
+    case SUTypedValueType_String: {
+      res = CW_INSTRUMENT_SU(SUTypedValueGetString, typed_value, string);
+      std::string string_val;
+      string.std_string(string_val);
+      value.string_value(std::move(string_val));
+      break;
+    }
+    case SUTypedValueType_Vector3D: {
+      double vector_val[3] = {0.0, 0.0, 0.0};
+      res = CW_INSTRUMENT_SU(SUTypedValueGetVector3d, typed_value, vector_val);
+      value.vector_value(Vector3D(vector_val[0], vector_val[1], vector_val[2]));
+      break;
+    }
+    case SUTypedValueType_Array: {
+      size_t count = 0;
+      res = CW_INSTRUMENT_SU(SUTypedValueGetNumArrayItems, typed_value, &count);
+      assert(res == SU_ERROR_NONE);
+      // The items belong to the array, and are not released.
+      std::vector<SUTypedValueRef> item_refs(count, SUTypedValueRef());
+      res = CW_INSTRUMENT_SU(SUTypedValueGetArrayItems, typed_value, count, item_refs.data(), &count);
+      std::vector<AttributeValue> items(count);
+      for (size_t i = 0; i < count; ++i) {
+        read_typed_value(item_refs[i], string, items[i]);
+      }
+      value.array_value(std::move(items));
+      break;
+    }
+  }
+  assert(res == SU_ERROR_NONE); _unused(res);
+}
+
+
+/**
+* Sets a SUTypedValueRef to hold a copy of an AttributeValue.  Empty values are not written.
+*/
+void write_typed_value(const AttributeValue& value, SUTypedValueRef typed_value) {
+  SUResult res = SU_ERROR_NONE;
+  switch (value.get_type()) {
+    case SUTypedValueType_Empty:
+      break;
+    case SUTypedValueType_Byte:
+      res = CW_INSTRUMENT_SU(SUTypedValueSetByte, typed_value, value.byte_value());
+      break;
+    case SUTypedValueType_Short:
+      res = CW_INSTRUMENT_SU(SUTypedValueSetInt16, typed_value, value.int16_value());
+      break;
+    case SUTypedValueType_Int32:
+      res = CW_INSTRUMENT_SU(SUTypedValueSetInt32, typed_value, value.int32_value());
+      break;
+    case SUTypedValueType_Float:
+      res = CW_INSTRUMENT_SU(SUTypedValueSetFloat, typed_value, value.float_value());
+      break;
+    case SUTypedValueType_Double:
+      res = CW_INSTRUMENT_SU(SUTypedValueSetDouble, typed_value, value.double_value());
+      break;
+    case SUTypedValueType_Bool:
+      res = CW_INSTRUMENT_SU(SUTypedValueSetBool, typed_value, value.bool_value());
+      break;
+    case SUTypedValueType_Color: {
+      SUColor color_val = value.color_value();
+      res = CW_INSTRUMENT_SU(SUTypedValueSetColor, typed_value, &color_val);
+      break;
+    }
+    case SUTypedValueType_Time:
+      res = CW_INSTRUMENT_SU(SUTypedValueSetTime, typed_value, value.time_value());
+      break;
+    case SUTypedValueType_String:
+      res = CW_INSTRUMENT_SU(SUTypedValueSetString, typed_value, value.string_value().c_str());
+      CW_INSTRUMENT_BYTES("CW::TypedValue", value.string_value().size());
+      break;
+    case SUTypedValueType_Vector3D: {
+      const Vector3D vector_val = value.vector_value();
+      const double vector_array[3] = {vector_val.x, vector_val.y, vector_val.z};
+      res = CW_INSTRUMENT_SU(SUTypedValueSetVector3d, typed_value, vector_array);
+      break;
+    }
+    case SUTypedValueType_Array: {
+      const std::vector<AttributeValue>& items = value.array_value();
+      std::vector<SUTypedValueRef> item_refs(items.size(), SUTypedValueRef());
+      for (size_t i = 0; i < items.size(); ++i) {
+        res = CW_INSTRUMENT_SU(SUTypedValueCreate, &item_refs[i]);
+        assert(res == SU_ERROR_NONE);
+        write_typed_value(items[i], item_refs[i]);
+      }
+      // The items are copied into the array, so they are released here.
+      res = CW_INSTRUMENT_SU(SUTypedValueSetArrayItems, typed_value, item_refs.size(), item_refs.data());
+      for (SUTypedValueRef& item_ref : item_refs) {
+        SUResult release_res = CW_INSTRUMENT_SU(SUTypedValueRelease, &item_ref);
+        assert(release_res == SU_ERROR_NONE); _unused(release_res);
+      }
+      break;
+    }
+  }
+  assert(res == SU_ERROR_NONE); _unused(res);
+}
+
+} // namespace
+
 /******************
 * Private Static methods
 *******************/
@@ -49,7 +210,7 @@ SUAttributeDictionaryRef AttributeDictionary::create_attribute_dictionary(const
     throw std::logic_error("AttributeDictionary::create_attribute_dictionary(): Cannot use function prior to SU version 2018");
   }
   SUAttributeDictionaryRef dict = SU_INVALID;
-  SUResult res = SUAttributeDictionaryCreate(&dict, name.c_str());
+  SUResult res = CW_INSTRUMENT_SU(SUAttributeDictionaryCreate, &dict, name.c_str());
   assert(res == SU_ERROR_NONE);
   _unused(res);
   return dict;
@@ -93,19 +254,22 @@ AttributeDictionary::AttributeDictionary(const AttributeDictionary& other):
 {
   if (!other.m_attached && SUIsValid(other.m_entity)) {
     // Create a copy of the keys and values
-    std::vector<std::string> keys = other.get_keys();
-    for (size_t i=0; i < keys.size(); i++) {
-      this->set_attribute(keys[i], other.get_value(keys[i]));
-    }
+    this->set_attributes(other.snapshot());
   }
 }
 
 
+AttributeDictionary::AttributeDictionary(AttributeDictionary&& other) noexcept:
+  Entity(std::move(other))
+{}
+
+
 AttributeDictionary::~AttributeDictionary() {
   if (SU_VERSION_MAJOR >= 18) {
     if (!m_attached && SUIsValid(m_entity)) {
+      track_released();
       SUAttributeDictionaryRef dict = this->ref();
-      SUResult res = SUAttributeDictionaryRelease(&dict);
+      SUResult res = CW_INSTRUMENT_SU(SUAttributeDictionaryRelease, &dict);
       assert(res == SU_ERROR_NONE);
       _unused(res);
     }
@@ -118,8 +282,9 @@ AttributeDictionary::~AttributeDictionary() {
 /** Copy assignment operator */
 AttributeDictionary& AttributeDictionary::operator=(const AttributeDictionary& other) {
   if (SU_VERSION_MAJOR >= 18 && !m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUAttributeDictionaryRef dict = this->ref();
-    SUResult res = SUAttributeDictionaryRelease(&dict);
+    SUResult res = CW_INSTRUMENT_SU(SUAttributeDictionaryRelease, &dict);
     assert(res == SU_ERROR_NONE);
     _unused(res);
   }
@@ -130,6 +295,22 @@ AttributeDictionary& AttributeDictionary::operator=(const AttributeDictionary& o
 }
 
 
+AttributeDictionary& AttributeDictionary::operator=(AttributeDictionary&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (SU_VERSION_MAJOR >= 18 && !m_attached && SUIsValid(m_entity)) {
+    track_released();
+    SUAttributeDictionaryRef dict = this->ref();
+    SUResult res = CW_INSTRUMENT_SU(SUAttributeDictionaryRelease, &dict);
+    assert(res == SU_ERROR_NONE);
+    _unused(res);
+  }
+  Entity::operator=(std::move(other));
+  return *this;
+}
+
+
 SUAttributeDictionaryRef AttributeDictionary::ref() const {
   return SUAttributeDictionaryFromEntity(m_entity);
 }
@@ -141,15 +322,18 @@ AttributeDictionary::operator SUAttributeDictionaryRef() const {
 
 
 TypedValue AttributeDictionary::get_attribute(const std::string &key, const TypedValue &default_value) const {
+  CW_INSTRUMENT_METHOD("CW::AttributeDictionary::get_attribute");
   if (!(*this)) {
     throw std::logic_error("CW::AttributeDictionary::get_attribute(): AttributeDictionary is null");
   }
   SUTypedValueRef val = SU_INVALID;
-  SUResult res = SUTypedValueCreate(&val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueCreate, &val);
   assert(res == SU_ERROR_NONE);
   const char* key_char = key.c_str();
-  res = SUAttributeDictionaryGetValue(this->ref(), &key_char[0], &val);
+  res = CW_INSTRUMENT_SU(SUAttributeDictionaryGetValue, this->ref(), &key_char[0], &val);
   if (res == SU_ERROR_NO_DATA) {
+    res = CW_INSTRUMENT_SU(SUTypedValueRelease, &val);
+    assert(res == SU_ERROR_NONE);
     return default_value;
   }
   assert(res == SU_ERROR_NONE); _unused(res);
@@ -157,10 +341,11 @@ TypedValue AttributeDictionary::get_attribute(const std::string &key, const Type
 }
 
 bool AttributeDictionary::set_attribute(const std::string &key, const TypedValue &value) {
+  CW_INSTRUMENT_METHOD("CW::AttributeDictionary::set_attribute");
   if (!(*this)) {
     throw std::logic_error("CW::AttributeDictionary::set_attribute(): AttributeDictionary is null");
   }
-  SUResult res = SUAttributeDictionarySetValue(this->ref(), key.data(), value.ref());
+  SUResult res = CW_INSTRUMENT_SU(SUAttributeDictionarySetValue, this->ref(), key.data(), value.ref());
   if (res == SU_ERROR_NONE) {
     return true;
   }
@@ -169,27 +354,113 @@ bool AttributeDictionary::set_attribute(const std::string &key, const TypedValue
   }
 }
 
+bool AttributeDictionary::set_attributes(const AttributeSnapshot& attributes) {
+  CW_INSTRUMENT_METHOD("CW::AttributeDictionary::set_attributes");
+  if (!(*this)) {
+    throw std::logic_error("CW::AttributeDictionary::set_attributes(): AttributeDictionary is null");
+  }
+  if (attributes.empty()) {
+    return true;
+  }
+  SUTypedValueRef value_ref = SU_INVALID;
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueCreate, &value_ref);
+  assert(res == SU_ERROR_NONE);
+  SUTypedValueRef empty_ref = SU_INVALID;
+  bool all_set = true;
+  for (const AttributeSnapshot::value_type& attribute : attributes) {
+    SUTypedValueRef set_ref = value_ref;
+    if (attribute.second.empty()) {
+      // A typed value cannot be set back to empty, so empty values are written from a new one.
+      if (SUIsInvalid(empty_ref)) {
+        res = CW_INSTRUMENT_SU(SUTypedValueCreate, &empty_ref);
+        assert(res == SU_ERROR_NONE);
+      }
+      set_ref = empty_ref;
+    }
+    else {
+      write_typed_value(attribute.second, value_ref);
+    }
+    res = CW_INSTRUMENT_SU(SUAttributeDictionarySetValue, this->ref(), attribute.first.c_str(), set_ref);
+    if (res != SU_ERROR_NONE) {
+      all_set = false;
+    }
+  }
+  res = CW_INSTRUMENT_SU(SUTypedValueRelease, &value_ref);
+  assert(res == SU_ERROR_NONE);
+  if (SUIsValid(empty_ref)) {
+    res = CW_INSTRUMENT_SU(SUTypedValueRelease, &empty_ref);
+    assert(res == SU_ERROR_NONE);
+  }
+  _unused(res);
+  return all_set;
+}
+
+
+AttributeSnapshot AttributeDictionary::snapshot() const {
+  AttributeSnapshot attributes;
+  this->snapshot(attributes);
+  return attributes;
+}
+
+
+void AttributeDictionary::snapshot(AttributeSnapshot& attributes) const {
+  CW_INSTRUMENT_METHOD("CW::AttributeDictionary::snapshot");
+  if (!(*this)) {
+    throw std::logic_error("CW::AttributeDictionary::snapshot(): AttributeDictionary is null");
+  }
+  thread_local std::vector<std::string> keys;
+  this->get_keys(keys);
+  attributes.clear();
+  attributes.reserve(keys.size());
+  // One typed value and one string are reused to read all of the values.
+  SUTypedValueRef value_ref = SU_INVALID;
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueCreate, &value_ref);
+  assert(res == SU_ERROR_NONE);
+  String string;
+  for (const std::string& key : keys) {
+    res = CW_INSTRUMENT_SU(SUAttributeDictionaryGetValue, this->ref(), key.c_str(), &value_ref);
+    if (res != SU_ERROR_NONE) {
+      continue;
+    }
+    read_typed_value(value_ref, string, attributes.set(key, AttributeValue()));
+  }
+  res = CW_INSTRUMENT_SU(SUTypedValueRelease, &value_ref);
+  assert(res == SU_ERROR_NONE); _unused(res);
+}
+
+
 std::vector<std::string> AttributeDictionary::get_keys() const {
+  std::vector<std::string> keys;
+  this->get_keys(keys);
+  return keys;
+}
+
+
+void AttributeDictionary::get_keys(std::vector<std::string>& keys) const {
+  CW_INSTRUMENT_METHOD("CW::AttributeDictionary::get_keys");
   if (!(*this)) {
     throw std::logic_error("CW::AttributeDictionary::get_keys(): AttributeDictionary is null");
   }
   size_t num_keys = 0;
-  SUResult res = SUAttributeDictionaryGetNumKeys(this->ref(), &num_keys);
+  SUResult res = CW_INSTRUMENT_SU(SUAttributeDictionaryGetNumKeys, this->ref(), &num_keys);
   assert(res == SU_ERROR_NONE);
-  std::vector<SUStringRef> keys_ref(num_keys, SU_INVALID);
-  std::for_each(keys_ref.begin(), keys_ref.end(),
-  [](SUStringRef& value) {
-    SUResult res = SUStringCreate(&value);
-    assert(res == SU_ERROR_NONE); _unused(res);
-  });
-  res = SUAttributeDictionaryGetKeys(this->ref(), num_keys, keys_ref.data(), &num_keys);
+  thread_local std::vector<SUStringRef> keys_ref;
+  keys_ref.assign(num_keys, SUStringRef());
+  for (SUStringRef& key_ref : keys_ref) {
+    res = CW_INSTRUMENT_SU(SUStringCreate, &key_ref);
+    assert(res == SU_ERROR_NONE);
+  }
+  res = CW_INSTRUMENT_SU(SUAttributeDictionaryGetKeys, this->ref(), num_keys, keys_ref.data(), &num_keys);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<std::string> keys(num_keys);
-  std::transform(keys_ref.begin(), keys_ref.end(), keys.begin(),
-  [](const SUStringRef& value) {
-    return String(value).std_string();
-  });
-  return keys;
+  // Strings already in the vector keep their memory, and are overwritten in place.
+  keys.resize(num_keys);
+  for (size_t i = 0; i < keys_ref.size(); ++i) {
+    // The String object releases the SUStringRef.
+    String key(keys_ref[i]);
+    if (i < num_keys) {
+      key.std_string(keys[i]);
+    }
+  }
 }
 
 TypedValue AttributeDictionary::get_value(const std::string &key) const {
@@ -199,7 +470,7 @@ TypedValue AttributeDictionary::get_value(const std::string &key) const {
 std::string AttributeDictionary::get_name() const {
   String string;
   SUStringRef *string_ref = string;
-  SUResult res = SUAttributeDictionaryGetName(this->ref(), string_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUAttributeDictionaryGetName, this->ref(), string_ref);
   assert(res == SU_ERROR_NONE);
   _unused(res);
   return string;
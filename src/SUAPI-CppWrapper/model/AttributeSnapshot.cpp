@@ -0,0 +1,534 @@
+//
+//  AttributeSnapshot.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+#include "SUAPI-CppWrapper/model/AttributeSnapshot.hpp"
+
+namespace CW {
+
+/******************
+* AttributeValue **
+*******************/
+struct AttributeValue::Shared {
+  std::atomic<size_t> refs;
+
+  Shared():
+    refs(1)
+  {}
+
+  Shared(const Shared&) = delete;
+  Shared& operator=(const Shared&) = delete;
+
+  virtual ~Shared() {}
+};
+
+
+template <class T>
+struct AttributeValue::SharedValue : AttributeValue::Shared {
+  explicit SharedValue(T val):
+    value(std::move(val))
+  {}
+
+  T value;
+};
+
+
+AttributeValue::AttributeValue():
+  m_type(SUTypedValueType_Empty),
+  m_double(0.0)
+{}
+
+
+AttributeValue::AttributeValue(const char chars[]):
+  AttributeValue(std::string(chars))
+{}
+
+
+AttributeValue::AttributeValue(std::string string):
+  m_type(SUTypedValueType_Empty),
+  m_double(0.0)
+{
+  set_shared(SUTypedValueType_String, std::move(string));
+}
+
+
+AttributeValue::AttributeValue(const AttributeValue& other) noexcept:
+  m_type(other.m_type)
+{
+  copy_data(other);
+  if (is_shared()) {
+    m_shared->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+
+AttributeValue::AttributeValue(AttributeValue&& other) noexcept:
+  m_type(other.m_type)
+{
+  copy_data(other);
+  if (is_shared()) {
+    other.m_type = SUTypedValueType_Empty;
+    other.m_double = 0.0;
+  }
+}
+
+
+AttributeValue::~AttributeValue() {
+  release();
+}
+
+
+// Both assignments take the new value before the old one is released, as the new value may be held by the old one, as an item of its array.
+AttributeValue& AttributeValue::operator=(const AttributeValue& other) noexcept {
+  AttributeValue copy(other);
+  swap_data(copy);
+  return *this;
+}
+
+
+AttributeValue& AttributeValue::operator=(AttributeValue&& other) noexcept {
+  AttributeValue taken(std::move(other));
+  swap_data(taken);
+  return *this;
+}
+
+
+void AttributeValue::copy_data(const AttributeValue& other) noexcept {
+  // The union is copied as bytes, whichever member it holds.
+  static_assert(sizeof(m_double) >= sizeof(m_shared) && sizeof(m_double) >= sizeof(m_time), "m_double must span the union");
+  std::memcpy(&m_double, &other.m_double, sizeof(m_double));
+}
+
+
+void AttributeValue::swap_data(AttributeValue& other) noexcept {
+  std::swap(m_type, other.m_type);
+  double data;
+  std::memcpy(&data, &m_double, sizeof(m_double));
+  std::memcpy(&m_double, &other.m_double, sizeof(m_double));
+  std::memcpy(&other.m_double, &data, sizeof(m_double));
+}
+
+
+bool AttributeValue::is_shared() const {
+  return m_type == SUTypedValueType_String || m_type == SUTypedValueType_Vector3D || m_type == SUTypedValueType_Array;
+}
+
+
+void AttributeValue::release() noexcept {
+  if (is_shared() && m_shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete m_shared;
+  }
+  m_type = SUTypedValueType_Empty;
+  m_double = 0.0;
+}
+
+
+template <class T>
+const T& AttributeValue::shared_value() const {
+  return static_cast<const SharedValue<T>*>(m_shared)->value;
+}
+
+
+template <class T>
+void AttributeValue::set_shared(SUTypedValueType type, T value) {
+  // Allocated before the old value is released, so the value is unchanged if this throws.
+  Shared* shared = new SharedValue<T>(std::move(value));
+  release();
+  m_type = type;
+  m_shared = shared;
+}
+
+
+void AttributeValue::check_type(SUTypedValueType type, const char* method) const {
+  if (m_type != type) {
+    throw std::logic_error(std::string("CW::AttributeValue::") + method + "(): AttributeValue is not of the requested type");
+  }
+}
+
+
+SUTypedValueType AttributeValue::get_type() const {
+  return m_type;
+}
+
+
+bool AttributeValue::empty() const {
+  return m_type == SUTypedValueType_Empty;
+}
+
+
+char AttributeValue::byte_value() const {
+  check_type(SUTypedValueType_Byte, "byte_value");
+  return m_byte;
+}
+
+
+AttributeValue& AttributeValue::byte_value(char byte_val) {
+  *this = AttributeValue();
+  m_type = SUTypedValueType_Byte;
+  m_byte = byte_val;
+  return *this;
+}
+
+
+int16_t AttributeValue::int16_value() const {
+  check_type(SUTypedValueType_Short, "int16_value");
+  return m_int16;
+}
+
+
+AttributeValue& AttributeValue::int16_value(int16_t int16_val) {
+  *this = AttributeValue();
+  m_type = SUTypedValueType_Short;
+  m_int16 = int16_val;
+  return *this;
+}
+
+
+int32_t AttributeValue::int32_value() const {
+  check_type(SUTypedValueType_Int32, "int32_value");
+  return m_int32;
+}
+
+
+AttributeValue& AttributeValue::int32_value(int32_t int32_val) {
+  *this = AttributeValue();
+  m_type = SUTypedValueType_Int32;
+  m_int32 = int32_val;
+  return *this;
+}
+
+
+float AttributeValue::float_value() const {
+  check_type(SUTypedValueType_Float, "float_value");
+  return m_float;
+}
+
+
+AttributeValue& AttributeValue::float_value(float float_val) {
+  *this = AttributeValue();
+  m_type = SUTypedValueType_Float;
+  m_float = float_val;
+  return *this;
+}
+
+
+double AttributeValue::double_value() const {
+  check_type(SUTypedValueType_Double, "double_value");
+  return m_double;
+}
+
+
+AttributeValue& AttributeValue::double_value(double double_val) {
+  *this = AttributeValue();
+  m_type = SUTypedValueType_Double;
+  m_double = double_val;
+  return *this;
+}
+
+
+bool AttributeValue::bool_value() const {
+  check_type(SUTypedValueType_Bool, "bool_value");
+  return m_bool;
+}
+
+
+AttributeValue& AttributeValue::bool_value(bool bool_val) {
+  *this = AttributeValue();
+  m_type = SUTypedValueType_Bool;
+  m_bool = bool_val;
+  return *this;
+}
+
+
+Color AttributeValue::color_value() const {
+  check_type(SUTypedValueType_Color, "color_value");
+  return Color(m_color);
+}
+
+
+AttributeValue& AttributeValue::color_value(const Color& color_val) {
+  *this = AttributeValue();
+  m_type = SUTypedValueType_Color;
+  m_color = color_val;
+  return *this;
+}
+
+
+int64_t AttributeValue::time_value() const {
+  check_type(SUTypedValueType_Time, "time_value");
+  return m_time;
+}
+
+
+AttributeValue& AttributeValue::time_value(int64_t time_val) {
+  *this = AttributeValue();
+  m_type = SUTypedValueType_Time;
+  m_time = time_val;
+  return *this;
+}
+
+
+const std::string& AttributeValue::string_value() const {
+  check_type(SUTypedValueType_String, "string_value");
+  return shared_value<std::string>();
+}
+
+
+AttributeValue& AttributeValue::string_value(std::string string_val) {
+  if (m_type == SUTypedValueType_String && m_shared->refs.load(std::memory_order_acquire) == 1) {
+    // Not shared with a copy, so the string is reused.
+    static_cast<SharedValue<std::string>*>(m_shared)->value = std::move(string_val);
+    return *this;
+  }
+  set_shared(SUTypedValueType_String, std::move(string_val));
+  return *this;
+}
+
+
+Vector3D AttributeValue::vector_value() const {
+  check_type(SUTypedValueType_Vector3D, "vector_value");
+  return shared_value<Vector3D>();
+}
+
+
+AttributeValue& AttributeValue::vector_value(const Vector3D& vector_val) {
+  set_shared(SUTypedValueType_Vector3D, vector_val);
+  return *this;
+}
+
+
+const std::vector<AttributeValue>& AttributeValue::array_value() const {
+  check_type(SUTypedValueType_Array, "array_value");
+  return shared_value<std::vector<AttributeValue>>();
+}
+
+
+AttributeValue& AttributeValue::array_value(std::vector<AttributeValue> array_val) {
+  set_shared(SUTypedValueType_Array, std::move(array_val));
+  return *this;
+}
+
+
+size_t AttributeValue::memory_size() const {
+  switch (m_type) {
+    case SUTypedValueType_String: {
+      // Short strings are held in the std::string itself.
+      static const size_t inline_capacity = std::string().capacity();
+      const size_t capacity = shared_value<std::string>().capacity();
+      return sizeof(SharedValue<std::string>) + (capacity > inline_capacity ? capacity + 1 : 0);
+    }
+    case SUTypedValueType_Vector3D:
+      return sizeof(SharedValue<Vector3D>);
+    case SUTypedValueType_Array: {
+      const std::vector<AttributeValue>& items = shared_value<std::vector<AttributeValue>>();
+      size_t size = sizeof(SharedValue<std::vector<AttributeValue>>) + items.capacity() * sizeof(AttributeValue);
+      for (const AttributeValue& item : items) {
+        size += item.memory_size();
+      }
+      return size;
+    }
+    default:
+      return 0;
+  }
+}
+
+
+bool operator==(const AttributeValue& val1, const AttributeValue& val2) {
+  if (val1.m_type != val2.m_type) {
+    return false;
+  }
+  switch (val1.m_type) {
+    case SUTypedValueType_Empty:
+      return true;
+    case SUTypedValueType_Byte:
+      return val1.m_byte == val2.m_byte;
+    case SUTypedValueType_Short:
+      return val1.m_int16 == val2.m_int16;
+    case SUTypedValueType_Int32:
+      return val1.m_int32 == val2.m_int32;
+    case SUTypedValueType_Float:
+      return val1.m_float == val2.m_float;
+    case SUTypedValueType_Double:
+      return val1.m_double == val2.m_double;
+    case SUTypedValueType_Bool:
+      return val1.m_bool == val2.m_bool;
+    case SUTypedValueType_Color:
+      return val1.m_color.red == val2.m_color.red && val1.m_color.green == val2.m_color.green &&
+        val1.m_color.blue == val2.m_color.blue && val1.m_color.alpha == val2.m_color.alpha;
+    case SUTypedValueType_Time:
+      return val1.m_time == val2.m_time;
+    case SUTypedValueType_String:
+      return val1.m_shared == val2.m_shared || val1.shared_value<std::string>() == val2.shared_value<std::string>();
+    case SUTypedValueType_Vector3D: {
+      const Vector3D& vector1 = val1.shared_value<Vector3D>();
+      const Vector3D& vector2 = val2.shared_value<Vector3D>();
+      return vector1.x == vector2.x && vector1.y == vector2.y && vector1.z == vector2.z;
+    }
+    case SUTypedValueType_Array:
+      return val1.m_shared == val2.m_shared || val1.shared_value<std::vector<AttributeValue>>() == val2.shared_value<std::vector<AttributeValue>>();
+  }
+  return false;
+}
+
+
+bool operator!=(const AttributeValue& val1, const AttributeValue& val2) {
+  return !(val1 == val2);
+}
+
+
+/*********************
+* AttributeSnapshot **
+**********************/
+constexpr uint32_t AttributeSnapshot::EMPTY_SLOT;
+
+
+AttributeSnapshot::AttributeSnapshot()
+{}
+
+
+size_t AttributeSnapshot::hash_key(const std::string& key) {
+  return std::hash<std::string>()(key);
+}
+
+
+size_t AttributeSnapshot::find_slot(const std::string& key, size_t hash) const {
+  assert(!m_slots.empty());
+  const size_t mask = m_slots.size() - 1;
+  const uint32_t short_hash = static_cast<uint32_t>(hash);
+  size_t slot = hash & mask;
+  // The table is never more than half full, so the probe always reaches an empty slot.
+  while (m_slots[slot].index != EMPTY_SLOT) {
+    if (m_slots[slot].hash == short_hash && m_entries[m_slots[slot].index].first == key) {
+      return slot;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+
+void AttributeSnapshot::rehash(size_t num_slots) {
+  m_slots.assign(num_slots, Slot{EMPTY_SLOT, 0});
+  const size_t mask = num_slots - 1;
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    const size_t hash = hash_key(m_entries[i].first);
+    size_t slot = hash & mask;
+    while (m_slots[slot].index != EMPTY_SLOT) {
+      slot = (slot + 1) & mask;
+    }
+    m_slots[slot] = Slot{static_cast<uint32_t>(i), static_cast<uint32_t>(hash)};
+  }
+}
+
+
+size_t AttributeSnapshot::size() const {
+  return m_entries.size();
+}
+
+
+bool AttributeSnapshot::empty() const {
+  return m_entries.empty();
+}
+
+
+void AttributeSnapshot::reserve(size_t count) {
+  m_entries.reserve(count);
+  size_t num_slots = m_slots.empty() ? 16 : m_slots.size();
+  while (num_slots < count * 2) {
+    num_slots *= 2;
+  }
+  if (num_slots != m_slots.size()) {
+    rehash(num_slots);
+  }
+}
+
+
+void AttributeSnapshot::clear() {
+  m_entries.clear();
+  std::fill(m_slots.begin(), m_slots.end(), Slot{EMPTY_SLOT, 0});
+}
+
+
+const AttributeValue* AttributeSnapshot::find(const std::string& key) const {
+  if (m_entries.empty()) {
+    return nullptr;
+  }
+  const size_t slot = find_slot(key, hash_key(key));
+  if (m_slots[slot].index == EMPTY_SLOT) {
+    return nullptr;
+  }
+  return &m_entries[m_slots[slot].index].second;
+}
+
+
+bool AttributeSnapshot::contains(const std::string& key) const {
+  return find(key) != nullptr;
+}
+
+
+const AttributeValue& AttributeSnapshot::get(const std::string& key, const AttributeValue& default_value) const {
+  const AttributeValue* value = find(key);
+  if (value == nullptr) {
+    return default_value;
+  }
+  return *value;
+}
+
+
+AttributeValue& AttributeSnapshot::set(const std::string& key, AttributeValue value) {
+  if (m_slots.size() < (m_entries.size() + 1) * 2) {
+    rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+  }
+  const size_t hash = hash_key(key);
+  const size_t slot = find_slot(key, hash);
+  if (m_slots[slot].index != EMPTY_SLOT) {
+    AttributeValue& stored = m_entries[m_slots[slot].index].second;
+    stored = std::move(value);
+    return stored;
+  }
+  m_slots[slot] = Slot{static_cast<uint32_t>(m_entries.size()), static_cast<uint32_t>(hash)};
+  m_entries.emplace_back(key, std::move(value));
+  return m_entries.back().second;
+}
+
+
+AttributeSnapshot::const_iterator AttributeSnapshot::begin() const {
+  return m_entries.begin();
+}
+
+
+AttributeSnapshot::const_iterator AttributeSnapshot::end() const {
+  return m_entries.end();
+}
+
+} /* namespace CW */
@@ -29,8 +29,10 @@
 #define _unused(x) ((void)(x))
 
 #include "SUAPI-CppWrapper/model/Axes.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 #include <cassert>
+#include <stdexcept>
 
 namespace CW {
 
@@ -39,7 +41,7 @@ namespace CW {
 ***************************/
 SUAxesRef Axes::create_axes() {
   SUAxesRef axes = SU_INVALID;
-  SUResult res = SUAxesCreate(&axes);
+  SUResult res = CW_INSTRUMENT_SU(SUAxesCreate, &axes);
   assert(res == SU_ERROR_NONE);
   _unused(res);
   return axes;
@@ -47,11 +49,11 @@ SUAxesRef Axes::create_axes() {
 
 SUAxesRef Axes::create_custom_axes(const SUPoint3D& origin, const SUVector3D& xaxis, const SUVector3D& yaxis, const SUVector3D& zaxis) {
   SUAxesRef axes = SU_INVALID;
-  SUResult res = SUAxesCreateCustom(&axes, &origin, &xaxis, &yaxis, &zaxis);
+  SUResult res = CW_INSTRUMENT_SU(SUAxesCreateCustom, &axes, &origin, &xaxis, &yaxis, &zaxis);
   if(res != SU_ERROR_NONE) {
     // There is a problem with this axis, so return an invalid one
     if (SUIsValid(axes)) {
-      SUAxesRelease(&axes);
+      CW_INSTRUMENT_SU(SUAxesRelease, &axes);
     }
     return SU_INVALID;
   }
@@ -91,10 +93,16 @@ Axes::Axes(const Axes& other):
 {}
 
 
+Axes::Axes(Axes&& other) noexcept:
+  DrawingElement(std::move(other))
+{}
+
+
 Axes::~Axes() {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUAxesRef axes = this->ref();
-    SUResult res = SUAxesRelease(&axes);
+    SUResult res = CW_INSTRUMENT_SU(SUAxesRelease, &axes);
     assert(res == SU_ERROR_NONE);
     _unused(res);
   }
@@ -107,9 +115,10 @@ Axes::~Axes() {
 
 /** Copy assignment operator */
 Axes& Axes::operator=(const Axes& other) {
-  if (m_attached && SUIsValid(m_entity)) {
+  if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUAxesRef axes = this->ref();
-    SUResult res = SUAxesRelease(&axes);
+    SUResult res = CW_INSTRUMENT_SU(SUAxesRelease, &axes);
     assert(res == SU_ERROR_NONE);
     _unused(res);
   }
@@ -119,6 +128,22 @@ Axes& Axes::operator=(const Axes& other) {
 }
 
 
+Axes& Axes::operator=(Axes&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
+    SUAxesRef axes = this->ref();
+    SUResult res = CW_INSTRUMENT_SU(SUAxesRelease, &axes);
+    assert(res == SU_ERROR_NONE);
+    _unused(res);
+  }
+  DrawingElement::operator=(std::move(other));
+  return *this;
+}
+
+
 bool Axes::operator!() const {
   if (SUIsInvalid(m_entity)) {
     return true;
@@ -138,7 +163,7 @@ Vector3D Axes::x_axis() const {
     throw std::logic_error("CW::Axes::x_axis(): Axes is null");
   }
   SUVector3D axis;
-  SUResult res = SUAxesGetXAxis(this->ref(), &axis);
+  SUResult res = CW_INSTRUMENT_SU(SUAxesGetXAxis, this->ref(), &axis);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Vector3D(axis);
 }
@@ -148,7 +173,7 @@ Vector3D Axes::y_axis() const {
     throw std::logic_error("CW::Axes::x_axis(): Axes is null");
   }
   SUVector3D axis;
-  SUResult res = SUAxesGetYAxis(this->ref(), &axis);
+  SUResult res = CW_INSTRUMENT_SU(SUAxesGetYAxis, this->ref(), &axis);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Vector3D(axis);
 }
@@ -158,7 +183,7 @@ Vector3D Axes::z_axis() const {
     throw std::logic_error("CW::Axes::x_axis(): Axes is null");
   }
   SUVector3D axis;
-  SUResult res = SUAxesGetZAxis(this->ref(), &axis);
+  SUResult res = CW_INSTRUMENT_SU(SUAxesGetZAxis, this->ref(), &axis);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Vector3D(axis);
 }
@@ -169,7 +194,7 @@ Point3D Axes::origin() const {
     throw std::logic_error("CW::Axes::x_axis(): Axes is null");
   }
   SUPoint3D origin;
-  SUResult res = SUAxesGetOrigin(this->ref(), &origin);
+  SUResult res = CW_INSTRUMENT_SU(SUAxesGetOrigin, this->ref(), &origin);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Point3D(origin);
 }
@@ -180,7 +205,7 @@ Transformation Axes::transformation() const {
     throw std::logic_error("CW::Axes::x_axis(): Axes is null");
   }
   SUTransformation transform;
-  SUResult res = SUAxesGetTransform(this->ref(), &transform);
+  SUResult res = CW_INSTRUMENT_SU(SUAxesGetTransform, this->ref(), &transform);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Transformation(transform);
 }
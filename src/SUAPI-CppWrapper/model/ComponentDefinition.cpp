@@ -35,6 +35,8 @@
 #include "SUAPI-CppWrapper/model/ComponentInstance.hpp"
 #include "SUAPI-CppWrapper/model/Group.hpp"
 #include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/ModelRegistry.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 
@@ -43,7 +45,7 @@ namespace CW {
 *******************************/
 SUComponentDefinitionRef ComponentDefinition::create_definition() {
   SUComponentDefinitionRef definition = SU_INVALID;
-  SUResult res = SUComponentDefinitionCreate(&definition);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionCreate, &definition);
   assert(res == SU_ERROR_NONE); _unused(res);
   return definition;
 }
@@ -57,7 +59,7 @@ SUComponentDefinitionRef ComponentDefinition::copy_reference(const ComponentDefi
   if (SUIsValid(other.m_entity)) {
     // Copy across all nested geometry
     SUEntitiesRef new_entities_ref = SU_INVALID;
-    SUResult res = SUComponentDefinitionGetEntities(new_definition, &new_entities_ref);
+    SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionGetEntities, new_definition, &new_entities_ref);
     assert(res == SU_ERROR_NONE); _unused(res);
     Entities new_entities(new_entities_ref, other.model().ref());
     new_entities.add(other.entities());
@@ -88,10 +90,16 @@ ComponentDefinition::ComponentDefinition(const ComponentDefinition& other):
 {}
 
 
+ComponentDefinition::ComponentDefinition(ComponentDefinition&& other) noexcept:
+  DrawingElement(std::move(other))
+{}
+
+
 ComponentDefinition::~ComponentDefinition() {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUComponentDefinitionRef definition = this->ref();
-    SUComponentDefinitionRelease(&definition);
+    CW_INSTRUMENT_SU(SUComponentDefinitionRelease, &definition);
   }
 }
 
@@ -101,8 +109,9 @@ ComponentDefinition::~ComponentDefinition() {
 */
 ComponentDefinition& ComponentDefinition::operator=(const ComponentDefinition& other) {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUComponentDefinitionRef definition = this->ref();
-    SUResult res = SUComponentDefinitionRelease(&definition);
+    SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionRelease, &definition);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
   m_entity = SUComponentDefinitionToEntity(copy_reference(other));
@@ -114,6 +123,21 @@ ComponentDefinition& ComponentDefinition::operator=(const ComponentDefinition& o
 }
 
 
+ComponentDefinition& ComponentDefinition::operator=(ComponentDefinition&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
+    SUComponentDefinitionRef definition = this->ref();
+    SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionRelease, &definition);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  DrawingElement::operator=(std::move(other));
+  return *this;
+}
+
+
 SUComponentDefinitionRef ComponentDefinition::ref() const {
   return SUComponentDefinitionFromEntity(m_entity);
 }
@@ -129,7 +153,7 @@ ComponentInstance ComponentDefinition::create_instance() const {
     throw std::logic_error("CW::ComponentDefinition::create_instance(): ComponentDefinition is null");
   }
   SUComponentInstanceRef instance = SU_INVALID;
-  SUResult res = SUComponentDefinitionCreateInstance(this->ref(), &instance);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionCreateInstance, this->ref(), &instance);
   assert(res == SU_ERROR_NONE); _unused(res);
   return ComponentInstance(instance, false);
 }
@@ -151,7 +175,7 @@ Entities ComponentDefinition::entities() const {
     throw std::logic_error("CW::ComponentDefinition::entities(): ComponentDefinition is null");
   }
   SUEntitiesRef entities = SU_INVALID;
-  SUResult res = SUComponentDefinitionGetEntities(this->ref(), &entities);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionGetEntities, this->ref(), &entities);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Entities(entities, this->model().ref());
 }
@@ -162,9 +186,9 @@ String ComponentDefinition::name() const {
     throw std::logic_error("CW::ComponentDefinition::name(): ComponentDefinition is null");
   }
   SUStringRef name_string = SU_INVALID;
-  SUResult res = SUStringCreate(&name_string);
+  SUResult res = CW_INSTRUMENT_SU(SUStringCreate, &name_string);
   assert(res == SU_ERROR_NONE);
-  res = SUComponentDefinitionGetName(this->ref(), &name_string);
+  res = CW_INSTRUMENT_SU(SUComponentDefinitionGetName, this->ref(), &name_string);
   assert(res == SU_ERROR_NONE); _unused(res);
   return String(name_string);
 }
@@ -174,8 +198,9 @@ bool ComponentDefinition::name(String name) {
   if (!(*this)) {
     throw std::logic_error("CW::ComponentDefinition::name(): ComponentDefinition is null");
   }
-  SUResult res = SUComponentDefinitionSetName(this->ref(), std::string(name).c_str());
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionSetName, this->ref(), std::string(name).c_str());
   if (res == SU_ERROR_NONE) {
+    ModelRegistry::names_changed();
     return true;
   }
   return false;
@@ -187,7 +212,7 @@ bool ComponentDefinition::is_group() const {
     throw std::logic_error("CW::ComponentDefinition::is_group(): ComponentDefinition is null");
   }
   SUComponentType type;
-  SUResult res = SUComponentDefinitionGetType(this->ref(), &type);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionGetType, this->ref(), &type);
   assert(res == SU_ERROR_NONE); _unused(res);
   if (type == SUComponentType_Group) {
     return true;
@@ -203,7 +228,7 @@ Behavior ComponentDefinition::behavior() const {
     throw std::logic_error("CW::ComponentDefinition::behavior(): ComponentDefinition is null");
   }
   SUComponentBehavior behavior;
-  SUResult res = SUComponentDefinitionGetBehavior(this->ref(), &behavior);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionGetBehavior, this->ref(), &behavior);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Behavior(behavior);
 }
@@ -213,14 +238,14 @@ void ComponentDefinition::behavior(const Behavior& behavior) const {
     throw std::logic_error("CW::ComponentDefinition::behavior(): ComponentDefinition is null");
   }
   SUComponentBehavior behavior_ref = behavior.ref();
-  SUResult res = SUComponentDefinitionSetBehavior(this->ref(), &behavior_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionSetBehavior, this->ref(), &behavior_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
 
 size_t ComponentDefinition::num_used_instances() const {
   size_t num = 0;
-  SUResult res = SUComponentDefinitionGetNumUsedInstances(this->ref(), &num);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionGetNumUsedInstances, this->ref(), &num);
   assert(res == SU_ERROR_NONE); _unused(res);
   return num;
 }
@@ -228,7 +253,7 @@ size_t ComponentDefinition::num_used_instances() const {
 
 size_t ComponentDefinition::num_instances() const {
   size_t num = 0;
-  SUResult res = SUComponentDefinitionGetNumInstances(this->ref(), &num);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionGetNumInstances, this->ref(), &num);
   assert(res == SU_ERROR_NONE); _unused(res);
   return num;
 }
@@ -243,7 +268,7 @@ std::vector<ComponentInstance> ComponentDefinition::instances() const {
     return std::vector<ComponentInstance>{};
   }
   std::vector<SUComponentInstanceRef> instance_refs(count, SU_INVALID);
-  SUResult res = SUComponentDefinitionGetInstances(this->ref(), count, instance_refs.data(), &count);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionGetInstances, this->ref(), count, instance_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::vector<ComponentInstance> instances(count);
   std::transform(instance_refs.begin(), instance_refs.end(), instances.begin(),
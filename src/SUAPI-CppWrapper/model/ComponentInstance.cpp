@@ -29,12 +29,14 @@
 #define _unused(x) ((void)(x))
 
 #include <cassert>
+#include <stdexcept>
 
 #include "SUAPI-CppWrapper/model/ComponentInstance.hpp"
 
 #include <SketchUpAPI/model/group.h>
 
 #include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 
@@ -71,6 +73,11 @@ ComponentInstance::ComponentInstance(const ComponentInstance& other):
 {}
 
 
+ComponentInstance::ComponentInstance(ComponentInstance&& other) noexcept:
+  DrawingElement(std::move(other))
+{}
+
+
 ComponentInstance::ComponentInstance(const ComponentInstance& other, SUComponentInstanceRef instance_ref):
   DrawingElement(other, SUComponentInstanceToDrawingElement(instance_ref))
 {}
@@ -78,8 +85,9 @@ ComponentInstance::ComponentInstance(const ComponentInstance& other, SUComponent
 
 ComponentInstance::~ComponentInstance() {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUComponentInstanceRef instance = SUComponentInstanceFromEntity(m_entity);
-    SUResult res = SUComponentInstanceRelease(&instance);
+    SUResult res = CW_INSTRUMENT_SU(SUComponentInstanceRelease, &instance);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
@@ -90,6 +98,7 @@ ComponentInstance::~ComponentInstance() {
 /** Copy assignment operator */
 ComponentInstance& ComponentInstance::operator=(const ComponentInstance& other) {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUComponentInstanceRef instance;
     // Workaround for bug in Sketchup API which prevents an entity that is a group to be cast directly into ComponentInstance
     if (SUEntityGetType(m_entity) == SURefType_Group) {
@@ -99,7 +108,7 @@ ComponentInstance& ComponentInstance::operator=(const ComponentInstance& other)
     else {
       instance = SUComponentInstanceFromEntity(m_entity);
     }
-    SUResult res = SUComponentInstanceRelease(&instance);
+    SUResult res = CW_INSTRUMENT_SU(SUComponentInstanceRelease, &instance);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
   m_entity = SUComponentInstanceToEntity(copy_reference(other));
@@ -108,6 +117,21 @@ ComponentInstance& ComponentInstance::operator=(const ComponentInstance& other)
 }
 
 
+ComponentInstance& ComponentInstance::operator=(ComponentInstance&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
+    SUComponentInstanceRef instance = this->ref();
+    SUResult res = CW_INSTRUMENT_SU(SUComponentInstanceRelease, &instance);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  DrawingElement::operator=(std::move(other));
+  return *this;
+}
+
+
 SUComponentInstanceRef ComponentInstance::ref() const {
   // TODO: Due to a bug in the C API, SUComponentInstanceFromEntity returns null if the reference object is a Group. The workaround is cast to group then to a ComponentInstance.
   SURefType type = this->entity_type();
@@ -129,7 +153,7 @@ Transformation ComponentInstance::transformation() const {
     throw std::logic_error("CW::ComponentInstance::transformation(): ComponentInstance is null");
   }
   SUTransformation transform;
-  SUResult res = SUComponentInstanceGetTransform(this->ref(), &transform);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentInstanceGetTransform, this->ref(), &transform);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Transformation(transform);
 }
@@ -140,7 +164,7 @@ void ComponentInstance::transformation(const Transformation& transform) {
     throw std::logic_error("CW::ComponentInstance::transformation(): ComponentInstance is null");
   }
   SUTransformation su_transform = transform.ref();
-  SUResult res = SUComponentInstanceSetTransform(this->ref(), &su_transform);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentInstanceSetTransform, this->ref(), &su_transform);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -150,7 +174,7 @@ ComponentDefinition ComponentInstance::definition() const{
     throw std::logic_error("CW::ComponentInstance::definition(): ComponentInstance is null");
   }
   SUComponentDefinitionRef component = SU_INVALID;
-  SUResult res = SUComponentInstanceGetDefinition(this->ref(), &component);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentInstanceGetDefinition, this->ref(), &component);
   assert(res == SU_ERROR_NONE); _unused(res);
   return ComponentDefinition(component);
 }
@@ -162,7 +186,7 @@ String ComponentInstance::name() const {
   }
   String string;
   SUStringRef * const string_ref = string;
-  SUResult res = SUComponentInstanceGetName(this->ref(), string_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentInstanceGetName, this->ref(), string_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return string;
 }
@@ -173,7 +197,7 @@ void ComponentInstance::name(const String& string) {
     throw std::logic_error("CW::ComponentInstance::name(): ComponentInstance is null");
   }
   std::string name_string = string.std_string();
-  SUResult res = SUComponentInstanceSetName(this->ref(), name_string.c_str());
+  SUResult res = CW_INSTRUMENT_SU(SUComponentInstanceSetName, this->ref(), name_string.c_str());
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -33,6 +33,7 @@
 #include <stdexcept>
 
 #include "SUAPI-CppWrapper/model/Curve.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 
@@ -55,7 +56,7 @@ SUCurveRef Curve::create_curve(std::vector<Edge>& edges, SUResult &result) {
   std::vector<SUEdgeRef> refs(edges.size(), SU_INVALID);
   
   std::transform(edges.begin(), edges.end(), refs.begin(), [](const CW::Edge& edge) {return edge.ref(); });
-  result = SUCurveCreateWithEdges(&curve_ref, refs.data(), refs.size());
+  result = CW_INSTRUMENT_SU(SUCurveCreateWithEdges, &curve_ref, refs.data(), refs.size());
   return curve_ref;
 }
 
@@ -70,10 +71,10 @@ std::vector<Edge> Curve::get_edges() const{
     throw std::logic_error("CW::Curve::get_edges(): Curve is null");
   }
   size_t num_edges = 0;
-  SUResult res = SUCurveGetNumEdges(this->ref(), &num_edges);
+  SUResult res = CW_INSTRUMENT_SU(SUCurveGetNumEdges, this->ref(), &num_edges);
   assert(res == SU_ERROR_NONE);
   std::vector<SUEdgeRef> ref_edges(num_edges, SU_INVALID);
-  res = SUCurveGetEdges(this->ref(), num_edges, ref_edges.data(), &num_edges);
+  res = CW_INSTRUMENT_SU(SUCurveGetEdges, this->ref(), num_edges, ref_edges.data(), &num_edges);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::vector<Edge> edges(num_edges);
   std::transform(ref_edges.begin(), ref_edges.end(), edges.begin(),
@@ -88,7 +89,7 @@ SUCurveType Curve::get_type() {
   if (!(*this)) {
     throw std::logic_error("CW::Curve::get_type(): Curve is null");
   }
-  SUCurveGetType(this->ref(), &m_curve_type);
+  CW_INSTRUMENT_SU(SUCurveGetType, this->ref(), &m_curve_type);
   return m_curve_type;
 }
  
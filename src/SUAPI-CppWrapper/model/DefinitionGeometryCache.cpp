@@ -0,0 +1,252 @@
+//
+//  DefinitionGeometryCache.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// Macro for getting rid of unused variables commonly for assert checking
+#define _unused(x) ((void)(x))
+
+#include <cassert>
+#include <stdexcept>
+
+#include "SUAPI-CppWrapper/model/DefinitionGeometryCache.hpp"
+
+#include <SketchUpAPI/model/entities.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/mesh_helper.h>
+
+#include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+
+namespace CW {
+
+namespace {
+
+/**
+* Triangulates the faces held in the definition's entities with SUMeshHelper.
+*/
+DefinitionMeshPtr extract_mesh(SUComponentDefinitionRef definition) {
+  std::shared_ptr<DefinitionMesh> mesh = std::make_shared<DefinitionMesh>();
+  SUEntitiesRef entities = SU_INVALID;
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionGetEntities, definition, &entities);
+  assert(res == SU_ERROR_NONE);
+  size_t num_faces = 0;
+  res = CW_INSTRUMENT_SU(SUEntitiesGetNumFaces, entities, &num_faces);
+  assert(res == SU_ERROR_NONE);
+  if (num_faces == 0) {
+    return mesh;
+  }
+  std::vector<SUFaceRef> faces(num_faces, SU_INVALID);
+  res = CW_INSTRUMENT_SU(SUEntitiesGetFaces, entities, num_faces, faces.data(), &num_faces);
+  assert(res == SU_ERROR_NONE);
+
+  std::unordered_map<void*, uint32_t> material_ids;
+  std::vector<size_t> face_indices;
+  for (size_t i = 0; i < num_faces; ++i) {
+    SUMeshHelperRef helper = SU_INVALID;
+    res = CW_INSTRUMENT_SU(SUMeshHelperCreate, &helper, faces[i]);
+    assert(res == SU_ERROR_NONE);
+    size_t num_vertices = 0;
+    size_t num_triangles = 0;
+    res = CW_INSTRUMENT_SU(SUMeshHelperGetNumVertices, helper, &num_vertices);
+    assert(res == SU_ERROR_NONE);
+    res = CW_INSTRUMENT_SU(SUMeshHelperGetNumTriangles, helper, &num_triangles);
+    assert(res == SU_ERROR_NONE);
+    if (num_vertices == 0 || num_triangles == 0) {
+      CW_INSTRUMENT_SU(SUMeshHelperRelease, &helper);
+      continue;
+    }
+    const size_t first_vertex = mesh->positions.size();
+    mesh->positions.resize(first_vertex + num_vertices);
+    mesh->normals.resize(first_vertex + num_vertices);
+    res = CW_INSTRUMENT_SU(SUMeshHelperGetVertices, helper, num_vertices, &mesh->positions[first_vertex], &num_vertices);
+    assert(res == SU_ERROR_NONE);
+    res = CW_INSTRUMENT_SU(SUMeshHelperGetNormals, helper, num_vertices, &mesh->normals[first_vertex], &num_vertices);
+    assert(res == SU_ERROR_NONE);
+    size_t num_indices = 0;
+    face_indices.resize(num_triangles * 3);
+    res = CW_INSTRUMENT_SU(SUMeshHelperGetVertexIndices, helper, face_indices.size(), face_indices.data(), &num_indices);
+    assert(res == SU_ERROR_NONE);
+    res = CW_INSTRUMENT_SU(SUMeshHelperRelease, &helper);
+    assert(res == SU_ERROR_NONE); _unused(res);
+    for (size_t j = 0; j < num_indices; ++j) {
+      mesh->indices.push_back(static_cast<uint32_t>(first_vertex + face_indices[j]));
+    }
+
+    uint32_t material_id = DefinitionMesh::NO_ID;
+    SUMaterialRef material = SU_INVALID;
+    if (CW_INSTRUMENT_SU(SUFaceGetFrontMaterial, faces[i], &material) == SU_ERROR_NONE && SUIsValid(material)) {
+      auto inserted = material_ids.emplace(material.ptr, static_cast<uint32_t>(mesh->materials.size()));
+      if (inserted.second) {
+        mesh->materials.push_back(material);
+      }
+      material_id = inserted.first->second;
+    }
+    mesh->material_ids.insert(mesh->material_ids.end(), num_indices / 3, material_id);
+  }
+  mesh->positions.shrink_to_fit();
+  mesh->normals.shrink_to_fit();
+  mesh->indices.shrink_to_fit();
+  mesh->material_ids.shrink_to_fit();
+  return mesh;
+}
+
+} // namespace
+
+
+/**************************
+* DefinitionMesh
+**************************/
+constexpr uint32_t DefinitionMesh::NO_ID;
+
+size_t DefinitionMesh::num_triangles() const {
+  return indices.size() / 3;
+}
+
+
+size_t DefinitionMesh::memory_size() const {
+  return sizeof(DefinitionMesh) +
+    positions.capacity() * sizeof(SUPoint3D) +
+    normals.capacity() * sizeof(SUVector3D) +
+    indices.capacity() * sizeof(uint32_t) +
+    material_ids.capacity() * sizeof(uint32_t) +
+    materials.capacity() * sizeof(SUMaterialRef);
+}
+
+
+/**************************
+* DefinitionGeometryCache
+**************************/
+DefinitionGeometryCache::DefinitionGeometryCache(size_t max_memory_size):
+  m_max_memory_size(max_memory_size)
+{}
+
+
+DefinitionMeshPtr DefinitionGeometryCache::get(const ComponentDefinition& definition) {
+  return this->get(definition.ref());
+}
+
+
+DefinitionMeshPtr DefinitionGeometryCache::get(SUComponentDefinitionRef definition) {
+  if (SUIsInvalid(definition)) {
+    throw std::invalid_argument("CW::DefinitionGeometryCache::get(): ComponentDefinition is null");
+  }
+  auto found = m_index.find(definition.ptr);
+  if (found != m_index.end()) {
+    ++m_hits;
+    // Move the entry to the front of the list, as the most recently used.
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    return found->second->mesh;
+  }
+  ++m_misses;
+  DefinitionMeshPtr mesh = extract_mesh(definition);
+  m_entries.push_front(Entry{definition.ptr, mesh});
+  m_index.emplace(definition.ptr, m_entries.begin());
+  m_memory_size += mesh->memory_size();
+  this->evict();
+  return mesh;
+}
+
+
+bool DefinitionGeometryCache::contains(const ComponentDefinition& definition) const {
+  return m_index.find(definition.ref().ptr) != m_index.end();
+}
+
+
+void DefinitionGeometryCache::invalidate(const ComponentDefinition& definition) {
+  auto found = m_index.find(definition.ref().ptr);
+  if (found == m_index.end()) {
+    return;
+  }
+  m_memory_size -= found->second->mesh->memory_size();
+  m_entries.erase(found->second);
+  m_index.erase(found);
+}
+
+
+void DefinitionGeometryCache::evict() {
+  if (m_max_memory_size == 0) {
+    return;
+  }
+  while (m_memory_size > m_max_memory_size && !m_entries.empty()) {
+    const Entry& last = m_entries.back();
+    m_memory_size -= last.mesh->memory_size();
+    m_index.erase(last.definition);
+    m_entries.pop_back();
+    ++m_evictions;
+  }
+}
+
+
+void DefinitionGeometryCache::clear() {
+  m_entries.clear();
+  m_index.clear();
+  m_memory_size = 0;
+}
+
+
+size_t DefinitionGeometryCache::size() const {
+  return m_entries.size();
+}
+
+
+size_t DefinitionGeometryCache::memory_size() const {
+  return m_memory_size;
+}
+
+
+size_t DefinitionGeometryCache::max_memory_size() const {
+  return m_max_memory_size;
+}
+
+
+void DefinitionGeometryCache::max_memory_size(size_t max_memory_size) {
+  m_max_memory_size = max_memory_size;
+  this->evict();
+}
+
+
+size_t DefinitionGeometryCache::hits() const {
+  return m_hits;
+}
+
+
+size_t DefinitionGeometryCache::misses() const {
+  return m_misses;
+}
+
+
+size_t DefinitionGeometryCache::evictions() const {
+  return m_evictions;
+}
+
+
+void DefinitionGeometryCache::reset_counters() {
+  m_hits = 0;
+  m_misses = 0;
+  m_evictions = 0;
+}
+
+} /* namespace CW */
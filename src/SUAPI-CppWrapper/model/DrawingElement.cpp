@@ -36,6 +36,7 @@
 #include "SUAPI-CppWrapper/model/Layer.hpp"
 #include "SUAPI-CppWrapper/model/Material.hpp"
 #include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 
 namespace CW {
@@ -49,6 +50,11 @@ DrawingElement::DrawingElement(const DrawingElement& other, SUDrawingElementRef
   Entity(other, SUDrawingElementToEntity(element_ref))
 {}
 
+DrawingElement::DrawingElement(DrawingElement&& other) noexcept:
+  Entity(std::move(other))
+{}
+
+
 DrawingElement::DrawingElement():
   Entity()
 {}
@@ -64,6 +70,12 @@ DrawingElement& DrawingElement::operator=(const DrawingElement& other) {
 }
 
 
+DrawingElement& DrawingElement::operator=(DrawingElement&& other) noexcept {
+  Entity::operator=(std::move(other));
+  return (*this);
+}
+
+
 SUDrawingElementRef DrawingElement::ref() const {
   return SUDrawingElementFromEntity(m_entity);
 }
@@ -79,7 +91,7 @@ BoundingBox3D DrawingElement::bounds() {
     throw std::logic_error("CW::DrawingElement::bounds(): DrawingElement is null");
   }
   SUBoundingBox3D box = SU_INVALID;
-  SUResult res = SUDrawingElementGetBoundingBox(this->ref(), &box);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementGetBoundingBox, this->ref(), &box);
   assert(res == SU_ERROR_NONE); _unused(res);
   return BoundingBox3D(box);
 }
@@ -112,7 +124,7 @@ bool DrawingElement::casts_shadows() const {
     throw std::logic_error("CW::DrawingElement::casts_shadows(): DrawingElement is null");
   }
   bool cast_shadows_flag;
-  SUResult res = SUDrawingElementGetCastsShadows(this->ref(), &cast_shadows_flag);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementGetCastsShadows, this->ref(), &cast_shadows_flag);
   assert(res == SU_ERROR_NONE); _unused(res);
   return cast_shadows_flag;
 }
@@ -122,7 +134,7 @@ bool DrawingElement::casts_shadows(bool casts_shadows) {
   if (SUIsInvalid(m_entity)) {
     throw std::logic_error("CW::DrawingElement::casts_shadows(): DrawingElement is null");
   }
-  SUResult res = SUDrawingElementSetCastsShadows(this->ref(), casts_shadows);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementSetCastsShadows, this->ref(), casts_shadows);
   if (res == SU_ERROR_NONE) {
     return true;
   }
@@ -135,7 +147,7 @@ bool DrawingElement::hidden() const {
     throw std::logic_error("CW::DrawingElement::hidden(): DrawingElement is null");
   }
   bool hide_flag;
-  SUDrawingElementGetHidden(this->ref(), &hide_flag);
+  CW_INSTRUMENT_SU(SUDrawingElementGetHidden, this->ref(), &hide_flag);
   return hide_flag;
 }
 
@@ -144,7 +156,7 @@ bool DrawingElement::hidden(bool hidden) {
   if (SUIsInvalid(m_entity)) {
     throw std::logic_error("CW::DrawingElement::hidden(): DrawingElement is null");
   }
-  SUResult res = SUDrawingElementSetHidden(this->ref(), hidden);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementSetHidden, this->ref(), hidden);
   if (res == SU_ERROR_NONE) {
     return true;
   }
@@ -157,7 +169,7 @@ Layer DrawingElement::layer() const {
     throw std::logic_error("CW::DrawingElement::layer(): DrawingElement is null");
   }
   SULayerRef layer_ref = SU_INVALID;
-  SUResult res = SUDrawingElementGetLayer(this->ref(), &layer_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementGetLayer, this->ref(), &layer_ref);
   if (res == SU_ERROR_NULL_POINTER_OUTPUT || res == SU_ERROR_NO_DATA) {
     return Layer();
   }
@@ -170,7 +182,7 @@ bool DrawingElement::layer(Layer& layer){
   if (SUIsInvalid(m_entity)) {
     throw std::logic_error("CW::DrawingElement::layer(): DrawingElement is null");
   }
-  SUResult res = SUDrawingElementSetLayer(this->ref(), layer);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementSetLayer, this->ref(), layer);
   if (res == SU_ERROR_NONE) {
     layer.attached(true);
     return true;
@@ -184,7 +196,7 @@ Material DrawingElement::material() const {
     throw std::logic_error("CW::DrawingElement::material(): DrawingElement is null");
   }
   SUMaterialRef material_ref = SU_INVALID;
-  SUResult res = SUDrawingElementGetMaterial(this->ref(), &material_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementGetMaterial, this->ref(), &material_ref);
   if (res == SU_ERROR_NO_DATA || res == SU_ERROR_NULL_POINTER_OUTPUT) {
     return Material();
   }
@@ -197,7 +209,7 @@ bool DrawingElement::material(const Material& material) {
   if (SUIsInvalid(m_entity)) {
     throw std::logic_error("CW::DrawingElement::material(): DrawingElement is null");
   }
-  SUResult res = SUDrawingElementSetMaterial(this->ref(), material);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementSetMaterial, this->ref(), material);
   if (res == SU_ERROR_NONE) {
     return true;
   }
@@ -210,7 +222,7 @@ bool DrawingElement::receive_shadows() const {
     throw std::logic_error("CW::DrawingElement::receive_shadows(): DrawingElement is null");
   }
   bool receives_shadows_flag;
-  SUResult res = SUDrawingElementGetReceivesShadows(this->ref(), &receives_shadows_flag);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementGetReceivesShadows, this->ref(), &receives_shadows_flag);
   assert (res == SU_ERROR_NONE); _unused(res);
   return receives_shadows_flag;
 }
@@ -220,7 +232,7 @@ bool DrawingElement::receive_shadows(bool receives_shadows_flag) {
   if (SUIsInvalid(m_entity)) {
     throw std::logic_error("CW::DrawingElement::receive_shadows(): DrawingElement is null");
   }
-  SUResult res = SUDrawingElementSetReceivesShadows(this->ref(), receives_shadows_flag);
+  SUResult res = CW_INSTRUMENT_SU(SUDrawingElementSetReceivesShadows, this->ref(), receives_shadows_flag);
   if (res == SU_ERROR_NONE) {
     return true;
   }
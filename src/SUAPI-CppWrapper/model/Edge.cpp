@@ -36,6 +36,7 @@
 #include "SUAPI-CppWrapper/Color.hpp"
 #include "SUAPI-CppWrapper/model/Vertex.hpp"
 #include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 /**************************
@@ -51,7 +52,7 @@ SUEdgeRef Edge::create_edge(const Point3D& start, const Point3D& end) {
   SUEdgeRef edge = SU_INVALID;
   SUPoint3D start_ref = start;
   SUPoint3D end_ref = end;
-  SUResult res = SUEdgeCreate(&edge, &start_ref, &end_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUEdgeCreate, &edge, &start_ref, &end_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return edge;
 }
@@ -104,10 +105,16 @@ Edge::Edge(const Edge& other):
 }
 
 
+Edge::Edge(Edge&& other) noexcept:
+  DrawingElement(std::move(other))
+{}
+
+
 Edge::~Edge() {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUEdgeRef edge = this->ref();
-    SUResult res = SUEdgeRelease(&edge);
+    SUResult res = CW_INSTRUMENT_SU(SUEdgeRelease, &edge);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
@@ -117,8 +124,9 @@ Edge::~Edge() {
 *******************/
 Edge& Edge::operator=(const Edge& other) {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUEdgeRef edge = this->ref();
-    SUResult res = SUEdgeRelease(&edge);
+    SUResult res = CW_INSTRUMENT_SU(SUEdgeRelease, &edge);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
   m_entity = SUEdgeToEntity(copy_reference(other));
@@ -132,6 +140,21 @@ Edge& Edge::operator=(const Edge& other) {
 }
 
 
+Edge& Edge::operator=(Edge&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
+    SUEdgeRef edge = this->ref();
+    SUResult res = CW_INSTRUMENT_SU(SUEdgeRelease, &edge);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  DrawingElement::operator=(std::move(other));
+  return *this;
+}
+
+
 SUEdgeRef Edge::ref() const {
   return SUEdgeFromEntity(m_entity);
 }
@@ -150,11 +173,12 @@ bool Edge::operator!() const {
 
 
 Color Edge::color() const {
+  CW_INSTRUMENT_METHOD("CW::Edge::color");
   if (!(*this)) {
     throw std::logic_error("CW::Edge::color(): Edge is null");
   }
   SUColor color = SU_INVALID;
-  SUEdgeGetColor(this->ref(), &color);
+  CW_INSTRUMENT_SU(SUEdgeGetColor, this->ref(), &color);
   return Color(color);
 }
 
@@ -164,7 +188,7 @@ bool Edge::color(const Color& input_color) {
     throw std::logic_error("CW::Edge::color(): Edge is null");
   }
   SUColor color = input_color.ref();
-  SUResult result = SUEdgeSetColor(this->ref(), &color);
+  SUResult result = CW_INSTRUMENT_SU(SUEdgeSetColor, this->ref(), &color);
   if (result == SU_ERROR_NONE) {
     return true;
   }
@@ -173,37 +197,47 @@ bool Edge::color(const Color& input_color) {
 
 
 Vertex Edge::end() const {
+  CW_INSTRUMENT_METHOD("CW::Edge::end");
   if (!(*this)) {
     throw std::logic_error("CW::Edge::end(): Edge is null");
   }
   SUVertexRef vertex = SU_INVALID;
-  SUEdgeGetEndVertex(this->ref(), &vertex);
+  CW_INSTRUMENT_SU(SUEdgeGetEndVertex, this->ref(), &vertex);
   return Vertex(vertex);
 }
 
 
 std::vector<Face> Edge::faces() const {
+  std::vector<Face> faces;
+  this->faces(faces);
+  return faces;
+}
+
+
+void Edge::faces(std::vector<Face>& faces) const {
+  CW_INSTRUMENT_METHOD("CW::Edge::faces");
   if (!(*this)) {
     throw std::logic_error("CW::Edge::faces(): Edge is null");
   }
   size_t count = 0;
-  SUResult res = SUEdgeGetNumFaces(this->ref(), &count);
+  SUResult res = CW_INSTRUMENT_SU(SUEdgeGetNumFaces, this->ref(), &count);
   assert(res == SU_ERROR_NONE);
+  faces.clear();
   if (count == 0) {
-    return std::vector<Face>();
+    return;
   }
-  std::vector<SUFaceRef> face_refs(count, SU_INVALID);
-  res = SUEdgeGetFaces(this->ref(), count, face_refs.data(), &count);
+  thread_local std::vector<SUFaceRef> face_refs;
+  face_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SUEdgeGetFaces, this->ref(), count, face_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<Face> faces(count);
-  std::transform(face_refs.begin(), face_refs.end(), faces.begin(),
-  [](const SUFaceRef& value) {
-    return Face(value);
-  });
-  return faces;
+  faces.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    faces.emplace_back(face_refs[i]);
+  }
 }
 
 Vector3D Edge::vector() const {
+  CW_INSTRUMENT_METHOD("CW::Edge::vector");
   if (!(*this)) {
     throw std::logic_error("CW::Edge::vector(): Edge is null");
   }
@@ -211,12 +245,19 @@ Vector3D Edge::vector() const {
 }
 
 
+// Defined here rather than in Geometry.cpp, so that the geometry classes can be built without the model classes.
+Vector3D::Vector3D(const Edge &edge):
+  Vector3D(edge.vector())
+{}
+
+
 bool Edge::smooth() const {
+  CW_INSTRUMENT_METHOD("CW::Edge::smooth");
   if (!(*this)) {
     throw std::logic_error("CW::Edge::smooth(): Edge is null");
   }
   bool smooth_flag;
-  SUEdgeGetSmooth(this->ref(), &smooth_flag);
+  CW_INSTRUMENT_SU(SUEdgeGetSmooth, this->ref(), &smooth_flag);
   return smooth_flag;
 }
 
@@ -225,7 +266,7 @@ bool Edge::smooth(bool smooth) {
   if (!(*this)) {
     throw std::logic_error("CW::Edge::smooth(): Edge is null");
   }
-  SUResult result = SUEdgeSetSmooth(this->ref(), smooth);
+  SUResult result = CW_INSTRUMENT_SU(SUEdgeSetSmooth, this->ref(), smooth);
   if (result == SU_ERROR_NONE) {
     return true;
   }
@@ -234,11 +275,12 @@ bool Edge::smooth(bool smooth) {
 
 
 bool Edge::soft() const {
+  CW_INSTRUMENT_METHOD("CW::Edge::soft");
   if (!(*this)) {
     throw std::logic_error("CW::Edge::soft(): Edge is null");
   }
   bool soft_flag;
-  SUEdgeGetSoft(this->ref(), &soft_flag);
+  CW_INSTRUMENT_SU(SUEdgeGetSoft, this->ref(), &soft_flag);
   return soft_flag;
 }
 
@@ -247,7 +289,7 @@ bool Edge::soft(bool soft) {
   if (!(*this)) {
     throw std::logic_error("CW::Edge::soft(): Edge is null");
   }
-  SUResult result = SUEdgeSetSoft(this->ref(), soft);
+  SUResult result = CW_INSTRUMENT_SU(SUEdgeSetSoft, this->ref(), soft);
   if (result == SU_ERROR_NONE) {
     return true;
   }
@@ -256,11 +298,12 @@ bool Edge::soft(bool soft) {
 
 
 Vertex Edge::start() const {
+  CW_INSTRUMENT_METHOD("CW::Edge::start");
   if (!(*this)) {
     throw std::logic_error("CW::Edge::start(): Edge is null");
   }
   SUVertexRef vertex = SU_INVALID;
-  SUEdgeGetStartVertex(this->ref(), &vertex);
+  CW_INSTRUMENT_SU(SUEdgeGetStartVertex, this->ref(), &vertex);
   return Vertex(vertex);
 }
 
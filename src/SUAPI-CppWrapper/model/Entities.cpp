@@ -29,9 +29,11 @@
 #define _unused(x) ((void)(x))
 
 #include <cassert>
+#include <unordered_map>
 
 #include "SUAPI-CppWrapper/model/Entities.hpp"
 
+#include "SUAPI-CppWrapper/Geometry.hpp"
 #include "SUAPI-CppWrapper/model/GeometryInput.hpp"
 #include "SUAPI-CppWrapper/model/Vertex.hpp"
 #include "SUAPI-CppWrapper/model/Loop.hpp"
@@ -43,6 +45,9 @@
 #include "SUAPI-CppWrapper/model/Edge.hpp"
 #include "SUAPI-CppWrapper/model/Model.hpp"
 #include "SUAPI-CppWrapper/model/Material.hpp"
+#include "SUAPI-CppWrapper/model/MeshSnapshot.hpp"
+#include "SUAPI-CppWrapper/Triangulator.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 
@@ -59,83 +64,108 @@ Entities::Entities():
 
 
 std::vector<Face> Entities::faces() const {
+  std::vector<Face> faces;
+  this->faces(faces);
+  return faces;
+}
+
+
+void Entities::faces(std::vector<Face>& faces) const {
+  CW_INSTRUMENT_METHOD("CW::Entities::faces");
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::faces(): Entities is null");
   }
   size_t count = 0;
-  SUResult res = SUEntitiesGetNumFaces(m_entities, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumFaces, m_entities, &count);
   assert(res == SU_ERROR_NONE);
+  faces.clear();
   if (count == 0) {
-    return std::vector<Face>(0);
+    return;
   }
-  std::vector<SUFaceRef> face_refs(count, SU_INVALID);
-  res = SUEntitiesGetFaces(m_entities, count, face_refs.data(), &count);
+  thread_local std::vector<SUFaceRef> face_refs;
+  face_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SUEntitiesGetFaces, m_entities, count, face_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<Face> faces(count);
-  std::transform(face_refs.begin(), face_refs.end(), faces.begin(),
-  [](const SUFaceRef& value) {
-    return Face(value);
-  });
-  return faces;
+  faces.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    faces.emplace_back(face_refs[i]);
+  }
 }
 
 
 std::vector<Edge> Entities::edges(bool stray_only) const {
+  std::vector<Edge> edges;
+  this->edges(edges, stray_only);
+  return edges;
+}
+
+
+void Entities::edges(std::vector<Edge>& edges, bool stray_only) const {
+  CW_INSTRUMENT_METHOD("CW::Entities::edges");
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::edges(): Entities is null");
   }
   size_t count = 0;
-  SUResult res = SUEntitiesGetNumEdges(m_entities, stray_only, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumEdges, m_entities, stray_only, &count);
   assert(res == SU_ERROR_NONE);
+  edges.clear();
   if (count == 0) {
-    return std::vector<Edge>(0);
+    return;
   }
-  std::vector<SUEdgeRef> edge_refs(count, SU_INVALID);
-  res = SUEntitiesGetEdges(m_entities, stray_only, count, edge_refs.data(), &count);
+  thread_local std::vector<SUEdgeRef> edge_refs;
+  edge_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SUEntitiesGetEdges, m_entities, stray_only, count, edge_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<Edge> edges(count);
-  std::transform(edge_refs.begin(), edge_refs.end(), edges.begin(),
-  [](const SUEdgeRef& value) {
-    return Edge(value);
-  });
-  return edges;
+  edges.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    edges.emplace_back(edge_refs[i]);
+  }
 }
 
 
 std::vector<ComponentInstance> Entities::instances() const {
+  std::vector<ComponentInstance> instances;
+  this->instances(instances);
+  return instances;
+}
+
+
+void Entities::instances(std::vector<ComponentInstance>& instances) const {
+  CW_INSTRUMENT_METHOD("CW::Entities::instances");
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::instances(): Entities is null");
   }
   size_t count = 0;
-  SUResult res = SUEntitiesGetNumInstances(m_entities, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumInstances, m_entities, &count);
   assert(res == SU_ERROR_NONE);
+  instances.clear();
   if (count == 0) {
-    return std::vector<ComponentInstance>{};
+    return;
   }
-  std::vector<SUComponentInstanceRef> instance_refs(count, SU_INVALID);
-  res = SUEntitiesGetInstances(m_entities, count, instance_refs.data(), &count);
+  thread_local std::vector<SUComponentInstanceRef> instance_refs;
+  instance_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SUEntitiesGetInstances, m_entities, count, instance_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<ComponentInstance> instances(count);
-  std::transform(instance_refs.begin(), instance_refs.end(), instances.begin(),
-  [](const SUComponentInstanceRef& value) {
-    return ComponentInstance(value);
-  });;
-  return instances;
+  instances.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    instances.emplace_back(instance_refs[i]);
+  }
 }
 
 
 std::vector<Group> Entities::groups() const {
+  CW_INSTRUMENT_METHOD("CW::Entities::groups");
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::groups(): Entities is null");
   }
   size_t count = 0;
-  SUResult res = SUEntitiesGetNumGroups(m_entities, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumGroups, m_entities, &count);
   assert(res == SU_ERROR_NONE);
   if (count == 0) {
     return std::vector<Group>(0);
   }
   std::vector<SUGroupRef> group_refs(count);
-  res = SUEntitiesGetGroups(m_entities, count, &group_refs[0], &count);
+  res = CW_INSTRUMENT_SU(SUEntitiesGetGroups, m_entities, count, &group_refs[0], &count);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::vector<Group> groups;
   groups.reserve(count);
@@ -146,12 +176,228 @@ std::vector<Group> Entities::groups() const {
 }
 
 
+std::vector<FaceHandle> Entities::face_handles() const {
+  std::vector<FaceHandle> handles;
+  this->face_handles(handles);
+  return handles;
+}
+
+
+void Entities::face_handles(std::vector<FaceHandle>& handles) const {
+  CW_INSTRUMENT_METHOD("CW::Entities::face_handles");
+  if (!SUIsValid(m_entities)) {
+    throw std::logic_error("CW::Entities::face_handles(): Entities is null");
+  }
+  size_t count = 0;
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumFaces, m_entities, &count);
+  assert(res == SU_ERROR_NONE);
+  handles.resize(count);
+  if (count == 0) {
+    return;
+  }
+  res = CW_INSTRUMENT_SU(SUEntitiesGetFaces, m_entities, count, reinterpret_cast<SUFaceRef*>(handles.data()), &count);
+  assert(res == SU_ERROR_NONE); _unused(res);
+  handles.resize(count);
+}
+
+
+std::vector<EdgeHandle> Entities::edge_handles(bool stray_only) const {
+  std::vector<EdgeHandle> handles;
+  this->edge_handles(handles, stray_only);
+  return handles;
+}
+
+
+void Entities::edge_handles(std::vector<EdgeHandle>& handles, bool stray_only) const {
+  CW_INSTRUMENT_METHOD("CW::Entities::edge_handles");
+  if (!SUIsValid(m_entities)) {
+    throw std::logic_error("CW::Entities::edge_handles(): Entities is null");
+  }
+  size_t count = 0;
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumEdges, m_entities, stray_only, &count);
+  assert(res == SU_ERROR_NONE);
+  handles.resize(count);
+  if (count == 0) {
+    return;
+  }
+  res = CW_INSTRUMENT_SU(SUEntitiesGetEdges, m_entities, stray_only, count, reinterpret_cast<SUEdgeRef*>(handles.data()), &count);
+  assert(res == SU_ERROR_NONE); _unused(res);
+  handles.resize(count);
+}
+
+
+std::vector<InstanceHandle> Entities::instance_handles() const {
+  std::vector<InstanceHandle> handles;
+  this->instance_handles(handles);
+  return handles;
+}
+
+
+void Entities::instance_handles(std::vector<InstanceHandle>& handles) const {
+  CW_INSTRUMENT_METHOD("CW::Entities::instance_handles");
+  if (!SUIsValid(m_entities)) {
+    throw std::logic_error("CW::Entities::instance_handles(): Entities is null");
+  }
+  size_t count = 0;
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumInstances, m_entities, &count);
+  assert(res == SU_ERROR_NONE);
+  handles.resize(count);
+  if (count == 0) {
+    return;
+  }
+  res = CW_INSTRUMENT_SU(SUEntitiesGetInstances, m_entities, count, reinterpret_cast<SUComponentInstanceRef*>(handles.data()), &count);
+  assert(res == SU_ERROR_NONE); _unused(res);
+  handles.resize(count);
+}
+
+
+MeshSnapshot Entities::mesh_snapshot() const {
+  MeshSnapshot snapshot;
+  this->mesh_snapshot(snapshot);
+  return snapshot;
+}
+
+
+void Entities::mesh_snapshot(MeshSnapshot& snapshot) const {
+  CW_INSTRUMENT_METHOD("CW::Entities::mesh_snapshot");
+  if (!SUIsValid(m_entities)) {
+    throw std::logic_error("CW::Entities::mesh_snapshot(): Entities is null");
+  }
+  snapshot.clear();
+  snapshot.loop_offsets.push_back(0);
+  snapshot.face_loop_offsets.push_back(0);
+  size_t count = 0;
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumFaces, m_entities, &count);
+  assert(res == SU_ERROR_NONE);
+  if (count == 0) {
+    return;
+  }
+  snapshot.faces.resize(count, SU_INVALID);
+  res = CW_INSTRUMENT_SU(SUEntitiesGetFaces, m_entities, count, snapshot.faces.data(), &count);
+  assert(res == SU_ERROR_NONE); _unused(res);
+  snapshot.faces.resize(count);
+  snapshot.face_loop_offsets.reserve(count + 1);
+  snapshot.front_material_ids.reserve(count);
+  snapshot.back_material_ids.reserve(count);
+  snapshot.layer_ids.reserve(count);
+
+  // Materials and layers are given an id the first time they are found.
+  std::unordered_map<void*, uint32_t> material_ids;
+  std::unordered_map<void*, uint32_t> layer_ids;
+  auto material_id = [&snapshot, &material_ids](SUMaterialRef material) {
+    if (SUIsInvalid(material)) {
+      return MeshSnapshot::NO_ID;
+    }
+    auto inserted = material_ids.emplace(material.ptr, static_cast<uint32_t>(snapshot.materials.size()));
+    if (inserted.second) {
+      snapshot.materials.push_back(material);
+    }
+    return inserted.first->second;
+  };
+  auto layer_id = [&snapshot, &layer_ids](SULayerRef layer) {
+    if (SUIsInvalid(layer)) {
+      return MeshSnapshot::NO_ID;
+    }
+    auto inserted = layer_ids.emplace(layer.ptr, static_cast<uint32_t>(snapshot.layers.size()));
+    if (inserted.second) {
+      snapshot.layers.push_back(layer);
+    }
+    return inserted.first->second;
+  };
+
+  // Scratch buffers are reused for every face.
+  std::vector<SULoopRef> loop_refs;
+  std::vector<SUVertexRef> vertex_refs;
+  for (const SUFaceRef& face : snapshot.faces) {
+    size_t num_inner_loops = 0;
+    res = CW_INSTRUMENT_SU(SUFaceGetNumInnerLoops, face, &num_inner_loops);
+    assert(res == SU_ERROR_NONE);
+    loop_refs.assign(num_inner_loops + 1, SU_INVALID);
+    res = CW_INSTRUMENT_SU(SUFaceGetOuterLoop, face, &loop_refs[0]);
+    assert(res == SU_ERROR_NONE);
+    if (num_inner_loops > 0) {
+      res = CW_INSTRUMENT_SU(SUFaceGetInnerLoops, face, num_inner_loops, &loop_refs[1], &num_inner_loops);
+      assert(res == SU_ERROR_NONE);
+    }
+    for (size_t i = 0; i < num_inner_loops + 1; ++i) {
+      size_t num_vertices = 0;
+      res = CW_INSTRUMENT_SU(SULoopGetNumVertices, loop_refs[i], &num_vertices);
+      assert(res == SU_ERROR_NONE);
+      vertex_refs.assign(num_vertices, SU_INVALID);
+      if (num_vertices > 0) {
+        res = CW_INSTRUMENT_SU(SULoopGetVertices, loop_refs[i], num_vertices, vertex_refs.data(), &num_vertices);
+        assert(res == SU_ERROR_NONE);
+      }
+      for (size_t j = 0; j < num_vertices; ++j) {
+        SUPoint3D position;
+        res = CW_INSTRUMENT_SU(SUVertexGetPosition, vertex_refs[j], &position);
+        assert(res == SU_ERROR_NONE);
+        snapshot.positions.push_back(position);
+      }
+      snapshot.loop_offsets.push_back(snapshot.positions.size());
+    }
+    snapshot.face_loop_offsets.push_back(snapshot.loop_offsets.size() - 1);
+
+    SUMaterialRef material = SU_INVALID;
+    if (CW_INSTRUMENT_SU(SUFaceGetFrontMaterial, face, &material) != SU_ERROR_NONE) {
+      material = SU_INVALID;
+    }
+    snapshot.front_material_ids.push_back(material_id(material));
+    material = SU_INVALID;
+    if (CW_INSTRUMENT_SU(SUFaceGetBackMaterial, face, &material) != SU_ERROR_NONE) {
+      material = SU_INVALID;
+    }
+    snapshot.back_material_ids.push_back(material_id(material));
+    SULayerRef layer = SU_INVALID;
+    if (CW_INSTRUMENT_SU(SUDrawingElementGetLayer, SUFaceToDrawingElement(face), &layer) != SU_ERROR_NONE) {
+      layer = SU_INVALID;
+    }
+    snapshot.layer_ids.push_back(layer_id(layer));
+  }
+  _unused(res);
+}
+
+
+TriangleMesh Entities::triangulate_all() const {
+  TriangleMesh mesh;
+  this->triangulate_all(mesh);
+  return mesh;
+}
+
+
+void Entities::triangulate_all(TriangleMesh& mesh) const {
+  CW_INSTRUMENT_METHOD("CW::Entities::triangulate_all");
+  if (!SUIsValid(m_entities)) {
+    throw std::logic_error("CW::Entities::triangulate_all(): Entities is null");
+  }
+  mesh.clear();
+  MeshSnapshot snapshot;
+  this->mesh_snapshot(snapshot);
+  mesh.positions.reserve(snapshot.positions.size());
+  mesh.indices.reserve(3 * (snapshot.positions.size() + 2 * snapshot.num_loops()));
+  mesh.polygon_offsets.reserve(snapshot.num_faces() + 1);
+  Triangulator triangulator;
+  for (size_t i = 0; i < snapshot.num_faces(); ++i) {
+    SUPlane3D plane;
+    SUResult res = CW_INSTRUMENT_SU(SUFaceGetPlane, snapshot.faces[i], &plane);
+    assert(res == SU_ERROR_NONE); _unused(res);
+    const size_t first_loop = snapshot.face_loop_offsets[i];
+    const size_t num_loops = snapshot.face_loop_offsets[i + 1] - first_loop;
+    triangulator.triangulate(snapshot.positions.data(), &snapshot.loop_offsets[first_loop], num_loops, Plane3D(plane).normal(), mesh);
+  }
+  if (mesh.polygon_offsets.empty()) {
+    mesh.polygon_offsets.push_back(0);
+  }
+}
+
+
 BoundingBox3D Entities::bounding_box() const {
+  CW_INSTRUMENT_METHOD("CW::Entities::bounding_box");
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::groups(): Entities is null");
   }
   SUBoundingBox3D box = SU_INVALID;
-  SUResult res = SUEntitiesGetBoundingBox(m_entities, &box);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetBoundingBox, m_entities, &box);
   assert(res == SU_ERROR_NONE); _unused(res);
   return BoundingBox3D(box);
 }
@@ -163,19 +409,19 @@ size_t Entities::size() const {
   }
   size_t total_count = 0;
   size_t count = 0;
-  SUResult res = SUEntitiesGetNumFaces(m_entities, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumFaces, m_entities, &count);
   assert(res == SU_ERROR_NONE);
   total_count += count;
   count = 0;
-  res = SUEntitiesGetNumEdges(m_entities, true, &count);
+  res = CW_INSTRUMENT_SU(SUEntitiesGetNumEdges, m_entities, true, &count);
   assert(res == SU_ERROR_NONE);
   total_count += count;
   count = 0;
-  res = SUEntitiesGetNumInstances(m_entities, &count);
+  res = CW_INSTRUMENT_SU(SUEntitiesGetNumInstances, m_entities, &count);
   assert(res == SU_ERROR_NONE);
   total_count += count;
   count = 0;
-  res = SUEntitiesGetNumGroups(m_entities, &count);
+  res = CW_INSTRUMENT_SU(SUEntitiesGetNumGroups, m_entities, &count);
   assert(res == SU_ERROR_NONE); _unused(res);
   total_count += count;
   return total_count;
@@ -207,6 +453,7 @@ void Entities::add(const Entities& other) {
 
 
 SUResult Entities::fill(GeometryInput &geom_input) {
+  CW_INSTRUMENT_METHOD("CW::Entities::fill");
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::fill(): Entities is null");
   }
@@ -217,10 +464,10 @@ SUResult Entities::fill(GeometryInput &geom_input) {
 
   // For the indexes of the GeometryInputRef to make sense after we fill the Entities object with its contents, we need to know how many of each entitity currently exists in the Entities object
   size_t num_faces_before = 0;
-  SUResult res = SUEntitiesGetNumFaces(m_entities, &num_faces_before);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumFaces, m_entities, &num_faces_before);
   assert(res == SU_ERROR_NONE); _unused(res);
 
-  SUResult fill_res = SUEntitiesFill(m_entities, geom_input.m_geometry_input, true);
+  SUResult fill_res = CW_INSTRUMENT_SU(SUEntitiesFill, m_entities, geom_input.m_geometry_input, true);
   assert(fill_res == SU_ERROR_NONE); _unused(fill_res);
   /**
   // Now add other data that SUEntitiesFill cannot add to the entities.
@@ -265,13 +512,14 @@ SUResult Entities::fill(GeometryInput &geom_input) {
 }
 
 std::vector<Face> Entities::add_faces(std::vector<Face>& faces) {
+  CW_INSTRUMENT_METHOD("CW::Entities::add_faces");
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::add_faces(): Entities is null");
   }
   std::vector<SUFaceRef> refs(faces.size(), SU_INVALID);
   std::transform(faces.begin(), faces.end(), refs.begin(), [](const CW::Face& face) {return face.ref(); });
 
-  SUResult res = SUEntitiesAddFaces(m_entities, refs.size(), refs.data());
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesAddFaces, m_entities, refs.size(), refs.data());
   assert(res == SU_ERROR_NONE); _unused(res);
 
   // Transfer ownership of each face
@@ -282,13 +530,14 @@ std::vector<Face> Entities::add_faces(std::vector<Face>& faces) {
 }
 
 std::vector<Edge> Entities::add_edges(std::vector<Edge>& edges) {
+  CW_INSTRUMENT_METHOD("CW::Entities::add_edges");
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::add_edges(): Entities is null");
   }
   std::vector<SUEdgeRef> refs(edges.size(), SU_INVALID);
   std::transform(edges.begin(), edges.end(), refs.begin(), [](const CW::Edge& edge) {return edge.ref(); });
 
-  SUResult res = SUEntitiesAddEdges(m_entities, refs.size(), refs.data());
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesAddEdges, m_entities, refs.size(), refs.data());
   assert(res == SU_ERROR_NONE); _unused(res);
 
   // Transfer ownership of each edge
@@ -299,12 +548,24 @@ std::vector<Edge> Entities::add_edges(std::vector<Edge>& edges) {
 }
 
 
+Face Entities::add_face(Face& face) {
+  if (!SUIsValid(m_entities)) {
+    throw std::logic_error("CW::Entities::add_face(): Entities is null");
+  }
+  SUFaceRef face_ref = face.ref();
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesAddFaces, m_entities, 1, &face_ref);
+  assert(res == SU_ERROR_NONE); _unused(res);
+  face.attached(true);
+  return face;
+}
+
+
 Edge Entities::add_edge(Edge& edge) {
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::add_edge(): Entities is null");
   }
   SUEdgeRef edge_ref = edge.ref();
-  SUResult res = SUEntitiesAddEdges(m_entities, 1, &edge_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesAddEdges, m_entities, 1, &edge_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   edge.attached(true);
   return edge;
@@ -312,13 +573,14 @@ Edge Entities::add_edge(Edge& edge) {
 
 
 void Entities::add_instance(ComponentInstance& instance) {
+  CW_INSTRUMENT_METHOD("CW::Entities::add_instance");
   if (!SUIsValid(m_entities)) {
     throw std::logic_error("CW::Entities::add_instance(): Entities is null");
   }
   if (!instance) {
     throw std::invalid_argument("CW::Entities::add_instance(): ComponentInstance argument is invalid");
   }
-  SUResult res = SUEntitiesAddInstance(m_entities, instance, nullptr);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesAddInstance, m_entities, instance, nullptr);
   assert(res == SU_ERROR_NONE); _unused(res);
   instance.attached(true);
 }
@@ -332,17 +594,17 @@ ComponentInstance Entities::add_instance(const ComponentDefinition& definition,
     throw std::invalid_argument("CW::Entities::add_instance(): ComponentDefinition argument is invalid");
   }
   SUComponentInstanceRef instance = SU_INVALID;
-  SUResult res = SUComponentDefinitionCreateInstance(definition.ref(), &instance);
+  SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionCreateInstance, definition.ref(), &instance);
   assert(res == SU_ERROR_NONE);
   SUTransformation transform = transformation.ref();
-  res = SUComponentInstanceSetTransform(instance, &transform);
+  res = CW_INSTRUMENT_SU(SUComponentInstanceSetTransform, instance, &transform);
   assert(res == SU_ERROR_NONE);
   if (name.empty()) {
-    res = SUEntitiesAddInstance(m_entities, instance, NULL);
+    res = CW_INSTRUMENT_SU(SUEntitiesAddInstance, m_entities, instance, NULL);
   }
   else {
     SUStringRef name_ref = name.ref();
-    res = SUEntitiesAddInstance(m_entities, instance, &name_ref);
+    res = CW_INSTRUMENT_SU(SUEntitiesAddInstance, m_entities, instance, &name_ref);
   }
   assert(res == SU_ERROR_NONE); _unused(res);
   return ComponentInstance(instance, true);
@@ -401,10 +663,10 @@ Group Entities::add_group() {
     throw std::logic_error("CW::Entities::add_group(): Entities is null");
   }
   SUGroupRef group = SU_INVALID;
-  SUResult res = SUGroupCreate(&group);
+  SUResult res = CW_INSTRUMENT_SU(SUGroupCreate, &group);
   assert(res == SU_ERROR_NONE);
   // Add group to the entities object before populating it.
-  res = SUEntitiesAddGroup(m_entities, group);
+  res = CW_INSTRUMENT_SU(SUEntitiesAddGroup, m_entities, group);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Group(group);
 }
@@ -415,7 +677,7 @@ bool Entities::transform_entities(std::vector<Entity>& elems, const Transformati
     throw std::logic_error("CW::Entities::transform_entities(): Entities is null");
   }
   SUTransformation trans_ref = transform.ref();
-  SUResult res = SUEntitiesTransform(m_entities, elems.size(), elems[0], &trans_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesTransform, m_entities, elems.size(), elems[0], &trans_ref);
   assert(res == SU_ERROR_NONE || res == SU_ERROR_GENERIC); _unused(res);
   if (res == SU_ERROR_UNSUPPORTED) {
     throw std::invalid_argument("CW::Entities::transform_entities(): One of the elements given in the Entity vector is not contained by this Entities object.");
@@ -435,7 +697,7 @@ bool Entities::transform_entities(std::vector<Entity>& elems, std::vector<Transf
     throw std::invalid_argument("CW::Entities::transform_entities(): different number of elements to transformation objects given - the same number must be given.");
   }
   assert(elems.size() == transforms.size());
-  SUResult res = SUEntitiesTransformMultiple(m_entities, elems.size(), elems[0], transforms[0]);
+  SUResult res = CW_INSTRUMENT_SU(SUEntitiesTransformMultiple, m_entities, elems.size(), elems[0], transforms[0]);
   if (res == SU_ERROR_UNSUPPORTED) {
     throw std::invalid_argument("CW::Entities::transform_entities(): One of the elements given in the Entity vector is not contained by this Entities object.");
   }
@@ -38,6 +38,8 @@
 #include "SUAPI-CppWrapper/model/AttributeDictionary.hpp"
 #include "SUAPI-CppWrapper/model/Model.hpp"
 #include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
 
 
 namespace CW {
@@ -54,13 +56,31 @@ Entity::Entity():
 Entity::Entity(SUEntityRef entity, bool attached):
   m_entity(entity),
   m_attached(attached)
-{}
+{
+  if (!m_attached && SUIsValid(m_entity)) {
+    track_owned();
+  }
+}
 
 
 Entity::Entity(const Entity& other, SUEntityRef entity_ref):
   m_entity(entity_ref),
   m_attached(other.m_attached)
-{}
+{
+  // Only a new object is owned: some classes share the other object's reference.
+  if (!m_attached && SUIsValid(m_entity) && !SUAreEqual(m_entity, other.m_entity)) {
+    track_owned();
+  }
+}
+
+
+Entity::Entity(Entity&& other) noexcept:
+  m_entity(other.m_entity),
+  m_attached(other.m_attached)
+{
+  other.m_entity = SU_INVALID;
+  other.m_attached = false;
+}
 
 
 Entity::~Entity() {
@@ -76,12 +96,26 @@ Entity& Entity::operator=(const Entity& other) {
      m_entity = other.m_entity;
   }
   else if (!other.m_attached) {
+    if (SUIsValid(m_entity) && !SUAreEqual(m_entity, other.m_entity)) {
+      track_owned();
+    }
     this->copy_attributes_from(other);
   }
   return (*this);
 }
 
 
+Entity& Entity::operator=(Entity&& other) noexcept {
+  if (this != &other) {
+    m_entity = other.m_entity;
+    m_attached = other.m_attached;
+    other.m_entity = SU_INVALID;
+    other.m_attached = false;
+  }
+  return (*this);
+}
+
+
 Entity::operator SUEntityRef() const {
   return ref();
 }
@@ -103,22 +137,32 @@ bool Entity::attached() const {
 
 
 void Entity::attached(bool attach) {
+  if (attach != m_attached && SUIsValid(m_entity)) {
+    // The model takes over ownership when the entity is attached to it.
+    if (attach) {
+      track_released();
+    }
+    else {
+      track_owned();
+    }
+  }
   m_attached = attach;
 }
 
 
 std::vector<AttributeDictionary>  Entity::attribute_dictionaries() const {
+  CW_INSTRUMENT_METHOD("CW::Entity::attribute_dictionaries");
   if (!(*this)) {
     throw std::logic_error("CW::Entity::attribute_dictionaries(): Entity is null");
   }
   size_t num_dicts = 0;
-  SUResult res = SUEntityGetNumAttributeDictionaries(m_entity, &num_dicts);
+  SUResult res = CW_INSTRUMENT_SU(SUEntityGetNumAttributeDictionaries, m_entity, &num_dicts);
   assert(res == SU_ERROR_NONE);
   if (num_dicts == 0) {
     return std::vector<AttributeDictionary>{};
   }
   std::vector<SUAttributeDictionaryRef> dicts_ref(num_dicts, SU_INVALID);
-  res = SUEntityGetAttributeDictionaries(m_entity, num_dicts, dicts_ref.data(), &num_dicts);
+  res = CW_INSTRUMENT_SU(SUEntityGetAttributeDictionaries, m_entity, num_dicts, dicts_ref.data(), &num_dicts);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::vector<AttributeDictionary> dicts(num_dicts);
   std::transform(dicts_ref.begin(), dicts_ref.end(), dicts.begin(),
@@ -129,12 +173,13 @@ std::vector<AttributeDictionary>  Entity::attribute_dictionaries() const {
 }
 
 AttributeDictionary Entity::attribute_dictionary(const std::string& name) const {
+  CW_INSTRUMENT_METHOD("CW::Entity::attribute_dictionary");
   if (!(*this)) {
     throw std::logic_error("CW::Entity::attribute_dictionary(): Entity is null");
   }
   char const *c_name = name.c_str();
   SUAttributeDictionaryRef dict_ref = SU_INVALID;
-  SUResult res = SUEntityGetAttributeDictionary(m_entity, &c_name[0], &dict_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUEntityGetAttributeDictionary, m_entity, &c_name[0], &dict_ref);
   if (res == SU_ERROR_NONE) {
     return AttributeDictionary(dict_ref);
   }
@@ -144,7 +189,7 @@ AttributeDictionary Entity::attribute_dictionary(const std::string& name) const
 
 
 bool Entity::add_dictionary(AttributeDictionary& dict) {
-  SUResult res = SUEntityAddAttributeDictionary(m_entity, dict.ref());
+  SUResult res = CW_INSTRUMENT_SU(SUEntityAddAttributeDictionary, m_entity, dict.ref());
   if (res == SU_ERROR_NONE) {
     dict.attached(true);
     return true;
@@ -172,6 +217,16 @@ bool Entity::copy_attributes_from(const Entity& entity) {
 void delete_attribute(AttributeDictionary &dict, std::string key);
 */
 
+void Entity::track_owned() const {
+  RefTracker::acquired(RefTracker::entity_kind(CW_INSTRUMENT_SU(SUEntityGetType, m_entity)), m_entity.ptr);
+}
+
+
+void Entity::track_released() const {
+  RefTracker::released(RefTracker::entity_kind(CW_INSTRUMENT_SU(SUEntityGetType, m_entity)), m_entity.ptr);
+}
+
+
 bool Entity::is_valid() const {
   return !!(*this);
 }
@@ -187,7 +242,7 @@ int32_t Entity::entityID() const{
     throw std::logic_error("CW::Entity::entityID(): Entity is null");
   }
   int32_t entity_id = SU_INVALID;
-  SUEntityGetID(m_entity, &entity_id);
+  CW_INSTRUMENT_SU(SUEntityGetID, m_entity, &entity_id);
   return entity_id;
 }
 
@@ -202,6 +257,7 @@ TypedValue Entity::get_attribute(const std::string& dict_name, const std::string
 
 
 TypedValue Entity::get_attribute(const AttributeDictionary& dict, const std::string& key, const TypedValue& default_value) const {
+  CW_INSTRUMENT_METHOD("CW::Entity::get_attribute");
   if (!(*this)) {
     throw std::logic_error("CW::Entity::get_attribute(): Entity is null");
   }
@@ -224,6 +280,7 @@ bool Entity::set_attribute(const std::string& dict_name, const std::string& key,
 
 
 bool Entity::set_attribute(AttributeDictionary& dict, const std::string& key, const TypedValue& value) {
+  CW_INSTRUMENT_METHOD("CW::Entity::set_attribute");
   if (!(*this)) {
     throw std::logic_error("CW::Entity::set_attribute(): Entity is null");
   }
@@ -235,7 +292,7 @@ enum SURefType Entity::entity_type() const{
   if (!(*this)) {
     throw std::logic_error("CW::Entity::entity_type(): Entity is null");
   }
-  return SUEntityGetType(m_entity);
+  return CW_INSTRUMENT_SU(SUEntityGetType, m_entity);
 }
 
 Model Entity::model() const {
@@ -243,7 +300,7 @@ Model Entity::model() const {
     throw std::logic_error("CW::Entity::parent(): Entity is null");
   }
   SUModelRef model = SU_INVALID;
-  SUResult res = SUEntityGetModel(m_entity, &model);
+  SUResult res = CW_INSTRUMENT_SU(SUEntityGetModel, m_entity, &model);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Model(model, false);
 }
@@ -253,15 +310,16 @@ Entities Entity::parent() const {
     throw std::logic_error("CW::Entity::parent(): Entity is null");
   }
   SUEntitiesRef entities = SU_INVALID;
-  SUResult res = SUEntityGetParentEntities(m_entity, &entities);
+  SUResult res = CW_INSTRUMENT_SU(SUEntityGetParentEntities, m_entity, &entities);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Entities(entities, this->model().ref());
 }
 
 
 int64_t Entity::persistent_id() const {
+  CW_INSTRUMENT_METHOD("CW::Entity::persistent_id");
   int64_t pid;
-  SUResult res = SUEntityGetPersistentID(m_entity, &pid);
+  SUResult res = CW_INSTRUMENT_SU(SUEntityGetPersistentID, m_entity, &pid);
   assert(res == SU_ERROR_NONE); _unused(res);
   return pid;
 }
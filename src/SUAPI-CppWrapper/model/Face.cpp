@@ -36,11 +36,14 @@
 #include "SUAPI-CppWrapper/model/Face.hpp"
 
 #include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Triangulator.hpp"
 #include "SUAPI-CppWrapper/model/Material.hpp"
 #include "SUAPI-CppWrapper/model/Vertex.hpp"
 #include "SUAPI-CppWrapper/model/Edge.hpp"
 #include "SUAPI-CppWrapper/model/Loop.hpp"
 #include "SUAPI-CppWrapper/model/LoopInput.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
 
 namespace CW {
 
@@ -64,11 +67,12 @@ SUFaceRef Face::create_face(std::vector<Point3D>& outer_points, LoopInput& loop_
     [](const Point3D& value){
       return (SUPoint3D)value;
     });
-  SUResult res = SUFaceCreate(&face, su_points.data(), &loop_input_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUFaceCreate, &face, su_points.data(), &loop_input_ref);
   if (res != SU_ERROR_NONE) {
     // The points cannot be made into a face: either the points do not lie in a plane, or is somehow problematic.
     return SU_INVALID;
   }
+  RefTracker::released(RefKind::LoopInput, loop_input_ref.ptr);
   loop_input.m_attached = true;
   return face;
 }
@@ -129,10 +133,16 @@ Face::Face(const Face& other):
 }
 
 
+Face::Face(Face&& other) noexcept:
+  DrawingElement(std::move(other))
+{}
+
+
 Face::~Face() {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUFaceRef face = this->ref();
-    SUResult res = SUFaceRelease(&face);
+    SUResult res = CW_INSTRUMENT_SU(SUFaceRelease, &face);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
@@ -143,8 +153,9 @@ Face::~Face() {
 /** Copy assignment operator */
 Face& Face::operator=(const Face& other) {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUFaceRef face = this->ref();
-    SUResult res = SUFaceRelease(&face);
+    SUResult res = CW_INSTRUMENT_SU(SUFaceRelease, &face);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
   m_entity = SUFaceToEntity(copy_reference(other));
@@ -156,6 +167,21 @@ Face& Face::operator=(const Face& other) {
   return *this;
 }
 
+
+Face& Face::operator=(Face&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
+    SUFaceRef face = this->ref();
+    SUResult res = CW_INSTRUMENT_SU(SUFaceRelease, &face);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  DrawingElement::operator=(std::move(other));
+  return *this;
+}
+
   
 SUFaceRef Face::ref() const {  return SUFaceFromEntity(m_entity); }
 
@@ -163,6 +189,11 @@ SUFaceRef Face::ref() const {  return SUFaceFromEntity(m_entity); }
 Face::operator SUFaceRef() const {  return this->ref();}
 
 
+Face::operator bool() const {
+  return !(!(*this));
+}
+
+
 bool Face::operator!() const {
   if (SUIsInvalid(m_entity)) {
     return true;
@@ -172,11 +203,12 @@ bool Face::operator!() const {
 
 
 double Face::area() const {
+  CW_INSTRUMENT_METHOD("CW::Face::area");
   if (!(*this)) {
     throw std::logic_error("CW::Face::area(): Face is null");
   }
   double area;
-  SUResult res = SUFaceGetArea(this->ref(), &area);
+  SUResult res = CW_INSTRUMENT_SU(SUFaceGetArea, this->ref(), &area);
   assert(res == SU_ERROR_NONE); _unused(res);
   return area;
 }
@@ -189,20 +221,24 @@ void Face::add_inner_loop(std::vector<Point3D>& points, LoopInput &loop_input) {
   if (points.size() != loop_input.m_edge_num) {
     throw std::invalid_argument("CW::Face::add_inner_loop(): Unequal number of vertices between given Point3D vector and LoopInput object");
   }
-  SUResult res = SUFaceAddInnerLoop(this->ref(), points[0], loop_input);
+  // The face takes over the loop input, and invalidates its reference.
+  const void* loop_input_ptr = loop_input.ref().ptr;
+  SUResult res = CW_INSTRUMENT_SU(SUFaceAddInnerLoop, this->ref(), points[0], loop_input);
   if (res == SU_ERROR_INVALID_INPUT) {
     throw std::invalid_argument("CW::Face::add_inner_loop(): Arguments are invalid");
   }
   assert(res == SU_ERROR_NONE); _unused(res);
+  RefTracker::released(RefKind::LoopInput, loop_input_ptr);
 }
 
 
 Material Face::back_material() const {
+  CW_INSTRUMENT_METHOD("CW::Face::back_material");
   if (!(*this)) {
     throw std::logic_error("CW::Face::back_material(): Face is null");
   }
   SUMaterialRef material = SU_INVALID;
-  SUResult res = SUFaceGetBackMaterial(this->ref(), &material);
+  SUResult res = CW_INSTRUMENT_SU(SUFaceGetBackMaterial, this->ref(), &material);
   if (res == SU_ERROR_NO_DATA) {
     return Material();
   }
@@ -215,7 +251,7 @@ Material Face::back_material(const Material& material) {
   if (!(*this)) {
     throw std::logic_error("CW::Face::back_material(): Face is null");
   }
-  SUResult res = SUFaceSetBackMaterial(this->ref(), material.ref());
+  SUResult res = CW_INSTRUMENT_SU(SUFaceSetBackMaterial, this->ref(), material.ref());
   assert(res == SU_ERROR_NONE); _unused(res);
   return material;
 }
@@ -278,6 +314,7 @@ FacePointClass Face::classify_point(const Point3D& point) {
 
 
 std::vector<Edge> Face::edges() {
+  CW_INSTRUMENT_METHOD("CW::Face::edges");
   if (!(*this)) {
     throw std::logic_error("CW::Face::edges(): Face is null");
   }
@@ -311,41 +348,113 @@ UVHelper Face::get_UVHelper(bool front, bool back, TextureWriter tex_writer) {
 
 
 std::vector<Loop> Face::inner_loops() const {
+  std::vector<Loop> loops;
+  this->inner_loops(loops);
+  return loops;
+}
+
+
+void Face::inner_loops(std::vector<Loop>& loops) const {
+  CW_INSTRUMENT_METHOD("CW::Face::inner_loops");
+  loops.clear();
+  this->append_inner_loops(loops);
+}
+
+
+void Face::append_inner_loops(std::vector<Loop>& loops) const {
   if (!(*this)) {
     throw std::logic_error("CW::Face::inner_loops(): Face is null");
   }
   size_t num_loops = 0;
-  SUFaceGetNumInnerLoops(this->ref(), &num_loops);
-  std::vector<SULoopRef> inner_loops(num_loops, SU_INVALID);
-  SUFaceGetInnerLoops(this->ref(), num_loops, inner_loops.data(), &num_loops);
-  std::vector<Loop> loops(num_loops);
-  std::transform(inner_loops.begin(), inner_loops.end(), loops.begin(),
-    [](const SULoopRef& value){
-      return Loop(value);
-    });
-  return loops;
+  SUResult res = CW_INSTRUMENT_SU(SUFaceGetNumInnerLoops, this->ref(), &num_loops);
+  assert(res == SU_ERROR_NONE);
+  if (num_loops == 0) {
+    return;
+  }
+  thread_local std::vector<SULoopRef> loop_refs;
+  loop_refs.resize(num_loops);
+  res = CW_INSTRUMENT_SU(SUFaceGetInnerLoops, this->ref(), num_loops, loop_refs.data(), &num_loops);
+  assert(res == SU_ERROR_NONE); _unused(res);
+  loops.reserve(loops.size() + num_loops);
+  for (size_t i = 0; i < num_loops; ++i) {
+    loops.emplace_back(loop_refs[i]);
+  }
 }
 
 
 std::vector<Loop> Face::loops() const {
+  std::vector<Loop> all_loops;
+  this->loops(all_loops);
+  return all_loops;
+}
+
+
+void Face::loops(std::vector<Loop>& loops) const {
+  CW_INSTRUMENT_METHOD("CW::Face::loops");
   if (!(*this)) {
     throw std::logic_error("CW::Face::loops(): Face is null");
   }
-  std::vector<Loop> all_loops;
-  all_loops.push_back(outer_loop());
-  std::vector<Loop> inner_ls = inner_loops();
-  all_loops.reserve(all_loops.size() + inner_ls.size());
-  all_loops.insert(all_loops.end(), inner_ls.begin(), inner_ls.end());
-  return all_loops;
+  loops.clear();
+  loops.push_back(outer_loop());
+  this->append_inner_loops(loops);
 }
 
-/*
-// TODO another day.
-PolygonMesh mesh();
-*/
+TriangleMesh Face::triangulate() const {
+  TriangleMesh mesh;
+  Triangulator triangulator;
+  this->triangulate(mesh, triangulator);
+  return mesh;
+}
+
+
+size_t Face::triangulate(TriangleMesh& mesh, Triangulator& triangulator) const {
+  thread_local TriangulationBuffers buffers;
+  return this->triangulate(mesh, triangulator, buffers);
+}
+
+
+size_t Face::triangulate(TriangleMesh& mesh, Triangulator& triangulator, TriangulationBuffers& buffers) const {
+  CW_INSTRUMENT_METHOD("CW::Face::triangulate");
+  if (!(*this)) {
+    throw std::logic_error("CW::Face::triangulate(): Face is null");
+  }
+  // The positions are read straight from the loop and vertex references, without creating Loop, Vertex or Point3D objects.
+  size_t num_loops = 0;
+  SUResult res = CW_INSTRUMENT_SU(SUFaceGetNumInnerLoops, this->ref(), &num_loops);
+  assert(res == SU_ERROR_NONE);
+  buffers.loops.resize(num_loops + 1);
+  res = CW_INSTRUMENT_SU(SUFaceGetOuterLoop, this->ref(), &buffers.loops[0]);
+  assert(res == SU_ERROR_NONE);
+  if (num_loops > 0) {
+    res = CW_INSTRUMENT_SU(SUFaceGetInnerLoops, this->ref(), num_loops, &buffers.loops[1], &num_loops);
+    assert(res == SU_ERROR_NONE);
+    buffers.loops.resize(num_loops + 1);
+  }
+  buffers.points.clear();
+  buffers.loop_offsets.clear();
+  buffers.loop_offsets.push_back(0);
+  for (SULoopRef loop : buffers.loops) {
+    size_t num_vertices = 0;
+    res = CW_INSTRUMENT_SU(SULoopGetNumVertices, loop, &num_vertices);
+    assert(res == SU_ERROR_NONE);
+    buffers.vertices.resize(num_vertices);
+    res = CW_INSTRUMENT_SU(SULoopGetVertices, loop, num_vertices, buffers.vertices.data(), &num_vertices);
+    assert(res == SU_ERROR_NONE);
+    for (size_t i = 0; i < num_vertices; ++i) {
+      SUPoint3D position;
+      res = CW_INSTRUMENT_SU(SUVertexGetPosition, buffers.vertices[i], &position);
+      assert(res == SU_ERROR_NONE);
+      buffers.points.push_back(position);
+    }
+    buffers.loop_offsets.push_back(buffers.points.size());
+  }
+  _unused(res);
+  return triangulator.triangulate(buffers.points.data(), buffers.loop_offsets.data(), buffers.loops.size(), this->normal(), mesh);
+}
 
 
 Vector3D Face::normal() const {
+  CW_INSTRUMENT_METHOD("CW::Face::normal");
   if (!(*this)) {
     throw std::logic_error("CW::Face::normal(): Face is null");
   }
@@ -355,26 +464,34 @@ Vector3D Face::normal() const {
 
 
 Loop Face::outer_loop() const {
+  CW_INSTRUMENT_METHOD("CW::Face::outer_loop");
   if (!(*this)) {
     throw std::logic_error("CW::Face::outer_loop(): Face is null");
   }
   SULoopRef lp = SU_INVALID;
-  SUResult res = SUFaceGetOuterLoop(this->ref(), &lp);
+  SUResult res = CW_INSTRUMENT_SU(SUFaceGetOuterLoop, this->ref(), &lp);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Loop(lp);
 }
 
 
 Plane3D Face::plane() const {
+  CW_INSTRUMENT_METHOD("CW::Face::plane");
   if (!(*this)) {
     throw std::logic_error("CW::Face::plane(): Face is null");
   }
   SUPlane3D plane = SU_INVALID;
-  SUFaceGetPlane(this->ref(), &plane);
+  CW_INSTRUMENT_SU(SUFaceGetPlane, this->ref(), &plane);
   return Plane3D(plane);
 }
 
 
+// Defined here rather than in Geometry.cpp, so that the geometry classes can be built without the model classes.
+Plane3D::Plane3D(const Face &face):
+  Plane3D(face.plane())
+{}
+
+
 /** NOT POSSIBLE WITH C API - @see class MaterialInput **/
 //bool Face::position_material(const Material& material, const std::vector<Point3D>& pt_array, bool o_front) {}
 
@@ -383,7 +500,7 @@ Face& Face::reverse() {
   if (!(*this)) {
     throw std::logic_error("CW::Face::reverse(): Face is null");
   }
-  SUResult res = SUFaceReverse(this->ref());
+  SUResult res = CW_INSTRUMENT_SU(SUFaceReverse, this->ref());
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -404,19 +521,29 @@ bool Face::set_texture_projection(bool remove, bool frontside) {}
 
 
 std::vector<Vertex> Face::vertices() const {
+  std::vector<Vertex> vertices;
+  this->vertices(vertices);
+  return vertices;
+}
+
+
+void Face::vertices(std::vector<Vertex>& vertices) const {
+  CW_INSTRUMENT_METHOD("CW::Face::vertices");
   if (!(*this)) {
     throw std::logic_error("CW::Face::vertices(): Face is null");
   }
   size_t num_vertices = 0;
-  SUFaceGetNumVertices(this->ref(), &num_vertices);
-  std::vector<SUVertexRef> vertex_refs(num_vertices, SU_INVALID);
-  SUFaceGetVertices(this->ref(), num_vertices, vertex_refs.data(), &num_vertices);
-  std::vector<Vertex> vertices(num_vertices);
-  std::transform(vertex_refs.begin(), vertex_refs.end(), vertices.begin(),
-    [](const SUVertexRef& value){
-      return Vertex(value);
-    });
-  return vertices;
+  SUResult res = CW_INSTRUMENT_SU(SUFaceGetNumVertices, this->ref(), &num_vertices);
+  assert(res == SU_ERROR_NONE);
+  vertices.clear();
+  thread_local std::vector<SUVertexRef> vertex_refs;
+  vertex_refs.resize(num_vertices);
+  res = CW_INSTRUMENT_SU(SUFaceGetVertices, this->ref(), num_vertices, vertex_refs.data(), &num_vertices);
+  assert(res == SU_ERROR_NONE); _unused(res);
+  vertices.reserve(num_vertices);
+  for (size_t i = 0; i < num_vertices; ++i) {
+    vertices.emplace_back(vertex_refs[i]);
+  }
 }
   
 } /* namespace CW */
@@ -0,0 +1,372 @@
+//
+//  FaceBVH.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// Macro for getting rid of unused variables commonly for assert checking
+#define _unused(x) ((void)(x))
+
+#include <cassert>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "SUAPI-CppWrapper/model/FaceBVH.hpp"
+
+#include <SketchUpAPI/geometry/point3d.h>
+#include <SketchUpAPI/model/group.h>
+
+#include "SUAPI-CppWrapper/Transformation.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Group.hpp"
+#include "SUAPI-CppWrapper/model/InstancePath.hpp"
+#include "SUAPI-CppWrapper/model/MeshSnapshot.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+
+namespace CW {
+
+namespace {
+
+double coordinate(const SUPoint3D& point, int axis) {
+  return axis == 0 ? point.x : (axis == 1 ? point.y : point.z);
+}
+
+
+void expand(SUBoundingBox3D& bounds, const SUBoundingBox3D& other) {
+  bounds.min_point.x = std::min(bounds.min_point.x, other.min_point.x);
+  bounds.min_point.y = std::min(bounds.min_point.y, other.min_point.y);
+  bounds.min_point.z = std::min(bounds.min_point.z, other.min_point.z);
+  bounds.max_point.x = std::max(bounds.max_point.x, other.max_point.x);
+  bounds.max_point.y = std::max(bounds.max_point.y, other.max_point.y);
+  bounds.max_point.z = std::max(bounds.max_point.z, other.max_point.z);
+}
+
+
+SUBoundingBox3D empty_bounds() {
+  const double inf = std::numeric_limits<double>::infinity();
+  return SUBoundingBox3D{SUPoint3D{inf, inf, inf}, SUPoint3D{-inf, -inf, -inf}};
+}
+
+
+/**
+* Slab test of a ray against a bounding box, for distances between 0 and max_distance along the ray.
+*/
+bool ray_hits_box(const SUBoundingBox3D& bounds, const SUPoint3D& origin, const SUVector3D& inverse, double max_distance) {
+  double t_min = 0.0;
+  double t_max = max_distance;
+  const double inverse_values[3] = {inverse.x, inverse.y, inverse.z};
+  for (int axis = 0; axis < 3; ++axis) {
+    double start = coordinate(origin, axis);
+    double box_min = coordinate(bounds.min_point, axis);
+    double box_max = coordinate(bounds.max_point, axis);
+    if (std::isinf(inverse_values[axis])) {
+      // The ray is parallel to this slab
+      if (start < box_min || start > box_max) {
+        return false;
+      }
+      continue;
+    }
+    double t0 = (box_min - start) * inverse_values[axis];
+    double t1 = (box_max - start) * inverse_values[axis];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    t_min = std::max(t_min, t0);
+    t_max = std::min(t_max, t1);
+    if (t_min > t_max) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+
+bool RayTestResult::operator!() const {
+  return !face;
+}
+
+
+InstancePath RayTestResult::instance_path() const {
+  InstancePath path;
+  for (const ComponentInstance& instance : instances) {
+    path.push(instance);
+  }
+  if (!!face) {
+    path.set_leaf(face);
+  }
+  return path;
+}
+
+
+constexpr uint32_t FaceBVH::LEAF_SIZE;
+
+FaceBVH::FaceBVH():
+  m_loop_offsets(1, 0),
+  m_paths(1)
+{}
+
+
+FaceBVH::FaceBVH(const Entities& entities):
+  FaceBVH()
+{
+  add_entities(entities, Transformation(), 0);
+  if (m_faces.empty()) {
+    return;
+  }
+  m_face_order.resize(m_faces.size());
+  for (uint32_t i = 0; i < m_face_order.size(); ++i) {
+    m_face_order[i] = i;
+  }
+  m_nodes.reserve(2 * (m_faces.size() / LEAF_SIZE + 1));
+  build_node(0, static_cast<uint32_t>(m_face_order.size()));
+}
+
+
+void FaceBVH::add_entities(const Entities& entities, const Transformation& transform, uint32_t path) {
+  MeshSnapshot snapshot;
+  entities.mesh_snapshot(snapshot);
+  const bool transformed = !transform.is_identity();
+  const size_t point_offset = m_points.size();
+  const size_t loop_offset = m_loop_offsets.size() - 1;
+  m_points.reserve(m_points.size() + snapshot.positions.size());
+  for (SUPoint3D point : snapshot.positions) {
+    if (transformed) {
+      SUResult res = CW_INSTRUMENT_SU(SUPoint3DTransform, transform, &point);
+      assert(res == SU_ERROR_NONE); _unused(res);
+    }
+    m_points.push_back(point);
+  }
+  for (size_t i = 1; i < snapshot.loop_offsets.size(); ++i) {
+    m_loop_offsets.push_back(point_offset + snapshot.loop_offsets[i]);
+  }
+  std::vector<Point3D> outer_points;
+  for (size_t i = 0; i < snapshot.num_faces(); ++i) {
+    FaceRecord record;
+    record.face = snapshot.faces[i];
+    record.first_loop = loop_offset + snapshot.face_loop_offsets[i];
+    record.last_loop = loop_offset + snapshot.face_loop_offsets[i+1];
+    record.path = path;
+    const size_t outer_start = m_loop_offsets[record.first_loop];
+    const size_t outer_end = m_loop_offsets[record.first_loop + 1];
+    if (outer_end - outer_start < 3) {
+      continue;
+    }
+    outer_points.assign(m_points.begin() + outer_start, m_points.begin() + outer_end);
+    record.plane = Plane3D::plane_from_loop(outer_points);
+    if (!record.plane) {
+      continue;
+    }
+    record.bounds = empty_bounds();
+    for (size_t j = outer_start; j < outer_end; ++j) {
+      expand(record.bounds, SUBoundingBox3D{m_points[j], m_points[j]});
+    }
+    // Pad the bounds so that faces aligned with an axis do not have a zero thickness.
+    const double pad = Point3D::EPSILON;
+    record.bounds.min_point = SUPoint3D{record.bounds.min_point.x - pad, record.bounds.min_point.y - pad, record.bounds.min_point.z - pad};
+    record.bounds.max_point = SUPoint3D{record.bounds.max_point.x + pad, record.bounds.max_point.y + pad, record.bounds.max_point.z + pad};
+    m_faces.push_back(record);
+  }
+
+  // Recurse into the groups and component instances.
+  auto add_instance = [this, &transform, path](SUComponentInstanceRef instance_ref, const Entities& child_entities, const Transformation& child_transform) {
+    std::vector<SUComponentInstanceRef> child_path = m_paths[path];
+    child_path.push_back(instance_ref);
+    m_paths.push_back(child_path);
+    Transformation combined = transform;
+    combined = combined * child_transform;
+    add_entities(child_entities, combined, static_cast<uint32_t>(m_paths.size() - 1));
+  };
+  for (const ComponentInstance& instance : entities.instances()) {
+    add_instance(instance.ref(), instance.definition().entities(), instance.transformation());
+  }
+  for (const Group& group : entities.groups()) {
+    add_instance(SUGroupToComponentInstance(group.ref()), group.entities(), group.transformation());
+  }
+}
+
+
+void FaceBVH::build_node(uint32_t first, uint32_t last) {
+  const uint32_t node_index = static_cast<uint32_t>(m_nodes.size());
+  Node node;
+  node.bounds = empty_bounds();
+  SUBoundingBox3D centroid_bounds = empty_bounds();
+  for (uint32_t i = first; i < last; ++i) {
+    const SUBoundingBox3D& face_bounds = m_faces[m_face_order[i]].bounds;
+    expand(node.bounds, face_bounds);
+    SUPoint3D centroid{(face_bounds.min_point.x + face_bounds.max_point.x) / 2,
+                       (face_bounds.min_point.y + face_bounds.max_point.y) / 2,
+                       (face_bounds.min_point.z + face_bounds.max_point.z) / 2};
+    expand(centroid_bounds, SUBoundingBox3D{centroid, centroid});
+  }
+  node.index = first;
+  node.count = last - first;
+  m_nodes.push_back(node);
+  if (last - first <= LEAF_SIZE) {
+    return;
+  }
+  // Split the faces at the median centroid along the longest axis of the centroids.
+  int axis = 0;
+  double extent = 0.0;
+  for (int i = 0; i < 3; ++i) {
+    double axis_extent = coordinate(centroid_bounds.max_point, i) - coordinate(centroid_bounds.min_point, i);
+    if (axis_extent > extent) {
+      extent = axis_extent;
+      axis = i;
+    }
+  }
+  if (extent < Point3D::EPSILON) {
+    // The faces cannot be separated, so keep them in one leaf.
+    return;
+  }
+  const uint32_t middle = first + (last - first) / 2;
+  std::nth_element(m_face_order.begin() + first, m_face_order.begin() + middle, m_face_order.begin() + last,
+  [this, axis](uint32_t lhs, uint32_t rhs) {
+    const SUBoundingBox3D& lhs_bounds = m_faces[lhs].bounds;
+    const SUBoundingBox3D& rhs_bounds = m_faces[rhs].bounds;
+    return coordinate(lhs_bounds.min_point, axis) + coordinate(lhs_bounds.max_point, axis) <
+           coordinate(rhs_bounds.min_point, axis) + coordinate(rhs_bounds.max_point, axis);
+  });
+  m_nodes[node_index].count = 0;
+  build_node(first, middle);
+  m_nodes[node_index].index = static_cast<uint32_t>(m_nodes.size());
+  build_node(middle, last);
+}
+
+
+double FaceBVH::intersect_face(const FaceRecord& face, const Point3D& origin, const Vector3D& direction, double max_distance) const {
+  const Plane3D& plane = face.plane;
+  const double denominator = plane.a * direction.x + plane.b * direction.y + plane.c * direction.z;
+  if (std::abs(denominator) < std::numeric_limits<double>::epsilon()) {
+    // The ray is parallel to the face
+    return -1.0;
+  }
+  const double distance = -(plane.a * origin.x + plane.b * origin.y + plane.c * origin.z + plane.d) / denominator;
+  if (distance < 0.0 || distance > max_distance) {
+    return -1.0;
+  }
+  const Point3D hit_point = origin + (direction * distance);
+  // Project the face onto the axis plane that its normal is most aligned with, and count edge crossings. Counting the crossings of all loops together takes care of the holes.
+  const double abs_a = std::abs(plane.a);
+  const double abs_b = std::abs(plane.b);
+  const double abs_c = std::abs(plane.c);
+  const int dropped_axis = (abs_a >= abs_b && abs_a >= abs_c) ? 0 : (abs_b >= abs_c ? 1 : 2);
+  const int u_axis = (dropped_axis + 1) % 3;
+  const int v_axis = (dropped_axis + 2) % 3;
+  const SUPoint3D hit = hit_point;
+  const double u = coordinate(hit, u_axis);
+  const double v = coordinate(hit, v_axis);
+  bool inside = false;
+  for (size_t loop = face.first_loop; loop < face.last_loop; ++loop) {
+    const size_t start = m_loop_offsets[loop];
+    const size_t end = m_loop_offsets[loop + 1];
+    for (size_t i = start, j = end - 1; i < end; j = i++) {
+      const double u_i = coordinate(m_points[i], u_axis);
+      const double v_i = coordinate(m_points[i], v_axis);
+      const double u_j = coordinate(m_points[j], u_axis);
+      const double v_j = coordinate(m_points[j], v_axis);
+      if ((v_i > v) != (v_j > v) &&
+          u < (u_j - u_i) * (v - v_i) / (v_j - v_i) + u_i) {
+        inside = !inside;
+      }
+    }
+  }
+  return inside ? distance : -1.0;
+}
+
+
+RayTestResult FaceBVH::raytest(const Point3D& origin, const Vector3D& direction) const {
+  if (!origin) {
+    throw std::invalid_argument("CW::FaceBVH::raytest(): given origin is null");
+  }
+  if (!direction || direction.length() < Vector3D::EPSILON) {
+    throw std::invalid_argument("CW::FaceBVH::raytest(): given direction is null or has zero length");
+  }
+  RayTestResult result;
+  if (m_nodes.empty()) {
+    return result;
+  }
+  const Vector3D unit_direction = direction.unit();
+  const SUPoint3D ray_origin = origin;
+  const SUVector3D inverse{1.0 / unit_direction.x, 1.0 / unit_direction.y, 1.0 / unit_direction.z};
+  double closest = std::numeric_limits<double>::infinity();
+  const FaceRecord* closest_face = nullptr;
+
+  // The depth of the hierarchy is bounded by the median split, so a fixed size stack is enough.
+  std::array<uint32_t, 64> stack;
+  size_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size > 0) {
+    const uint32_t node_index = stack[--stack_size];
+    const Node& node = m_nodes[node_index];
+    if (!ray_hits_box(node.bounds, ray_origin, inverse, closest)) {
+      continue;
+    }
+    if (node.count > 0) {
+      for (uint32_t i = node.index; i < node.index + node.count; ++i) {
+        const FaceRecord& face = m_faces[m_face_order[i]];
+        double distance = intersect_face(face, origin, unit_direction, closest);
+        if (distance >= 0.0 && distance < closest) {
+          closest = distance;
+          closest_face = &face;
+        }
+      }
+    }
+    else {
+      assert(stack_size + 2 <= stack.size());
+      stack[stack_size++] = node.index;
+      stack[stack_size++] = node_index + 1;
+    }
+  }
+  if (closest_face == nullptr) {
+    return result;
+  }
+  result.face = Face(closest_face->face);
+  result.distance = closest;
+  result.point = origin + (unit_direction * closest);
+  const std::vector<SUComponentInstanceRef>& path = m_paths[closest_face->path];
+  result.instances.reserve(path.size());
+  for (const SUComponentInstanceRef& instance : path) {
+    result.instances.push_back(ComponentInstance(instance));
+  }
+  return result;
+}
+
+
+size_t FaceBVH::num_faces() const {
+  return m_faces.size();
+}
+
+
+BoundingBox3D FaceBVH::bounding_box() const {
+  if (m_nodes.empty()) {
+    return BoundingBox3D(false);
+  }
+  return BoundingBox3D(m_nodes[0].bounds);
+}
+
+} /* namespace CW */
@@ -0,0 +1,673 @@
+//
+//  FrozenModel.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// Macro for getting rid of unused variables commonly for assert checking
+#define _unused(x) ((void)(x))
+
+#include <cassert>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "SUAPI-CppWrapper/model/FrozenModel.hpp"
+
+#include <SketchUpAPI/model/attribute_dictionary.h>
+#include <SketchUpAPI/model/component_definition.h>
+#include <SketchUpAPI/model/component_instance.h>
+#include <SketchUpAPI/model/drawing_element.h>
+#include <SketchUpAPI/model/edge.h>
+#include <SketchUpAPI/model/entities.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/group.h>
+#include <SketchUpAPI/model/layer.h>
+#include <SketchUpAPI/model/loop.h>
+#include <SketchUpAPI/model/model.h>
+#include <SketchUpAPI/model/vertex.h>
+
+#include "SUAPI-CppWrapper/model/AttributeDictionary.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+
+namespace CW {
+
+constexpr FrozenModel::Index FrozenModel::NO_INDEX;
+constexpr FrozenModel::Index FrozenModel::ROOT;
+
+namespace {
+
+template <class T>
+size_t vector_memory_size(const std::vector<T>& vector) {
+  return vector.capacity() * sizeof(T);
+}
+
+} // namespace
+
+
+/**
+* Reads a model into a FrozenModel.  The SketchUp objects met along the way are given their index in the FrozenModel's arrays through the maps below, which are discarded once the model has been read.
+*/
+class FrozenModel::Builder {
+  private:
+  FrozenModel& m_frozen;
+  std::vector<SUEntitiesRef> m_definition_entities;
+  std::unordered_map<const void*, Index> m_definition_indices;
+  std::unordered_map<const void*, Index> m_layer_indices;
+  std::unordered_map<const void*, Index> m_material_indices;
+  // Vertices and edges are only shared within a definition, so these are cleared for each definition.
+  std::unordered_map<const void*, Index> m_vertex_indices;
+  std::unordered_map<const void*, Index> m_edge_indices;
+  // Reused to read every name and attribute dictionary.
+  String m_string;
+  AttributeSnapshot m_snapshot;
+
+  void rehash_strings(size_t num_slots) {
+    m_frozen.m_string_slots.assign(num_slots, NO_INDEX);
+    for (Index i = 0; i < m_frozen.num_strings(); ++i) {
+      const StringView string = m_frozen.string(i);
+      m_frozen.m_string_slots[m_frozen.find_slot(string.data, string.size)] = i;
+    }
+  }
+
+  Index intern(const char* data, size_t size) {
+    if (2 * (m_frozen.num_strings() + 1) > m_frozen.m_string_slots.size()) {
+      this->rehash_strings(std::max<size_t>(64, 2 * m_frozen.m_string_slots.size()));
+    }
+    const size_t slot = m_frozen.find_slot(data, size);
+    Index& index = m_frozen.m_string_slots[slot];
+    if (index == NO_INDEX) {
+      index = static_cast<Index>(m_frozen.num_strings());
+      m_frozen.m_characters.insert(m_frozen.m_characters.end(), data, data + size);
+      m_frozen.m_characters.push_back('\0');
+      m_frozen.m_string_offsets.push_back(static_cast<uint32_t>(m_frozen.m_characters.size()));
+    }
+    return index;
+  }
+
+  /**
+  * Interns the string just read into m_string, or the empty string if it could not be read.
+  */
+  Index intern_read(SUResult res) {
+    if (res != SU_ERROR_NONE) {
+      return this->intern("", 0);
+    }
+    const StringBuffer buffer = m_string.view();
+    return this->intern(buffer.data(), buffer.size());
+  }
+
+  static Index find(const std::unordered_map<const void*, Index>& indices, const void* ptr) {
+    auto found = indices.find(ptr);
+    return found == indices.end() ? NO_INDEX : found->second;
+  }
+
+  Range read_attributes(const std::vector<SUAttributeDictionaryRef>& dictionaries) {
+    const Index begin = static_cast<Index>(m_frozen.m_attributes.size());
+    for (SUAttributeDictionaryRef dictionary_ref : dictionaries) {
+      const Index dictionary = this->intern_read(CW_INSTRUMENT_SU(SUAttributeDictionaryGetName, dictionary_ref, m_string));
+      AttributeDictionary(dictionary_ref).snapshot(m_snapshot);
+      for (const AttributeSnapshot::value_type& entry : m_snapshot) {
+        m_frozen.m_attributes.push_back(Attribute{dictionary, this->intern(entry.first.data(), entry.first.size()), entry.second});
+      }
+    }
+    return Range{begin, static_cast<Index>(m_frozen.m_attributes.size())};
+  }
+
+  Range read_attributes(SUEntityRef entity) {
+    size_t count = 0;
+    SUResult res = CW_INSTRUMENT_SU(SUEntityGetNumAttributeDictionaries, entity, &count);
+    assert(res == SU_ERROR_NONE);
+    std::vector<SUAttributeDictionaryRef> dictionaries(count, SU_INVALID);
+    if (count > 0) {
+      res = CW_INSTRUMENT_SU(SUEntityGetAttributeDictionaries, entity, count, dictionaries.data(), &count);
+      assert(res == SU_ERROR_NONE);
+      dictionaries.resize(count);
+    }
+    _unused(res);
+    return this->read_attributes(dictionaries);
+  }
+
+  void read_drawing_element(SUDrawingElementRef element, Index& layer, Index& material, bool& hidden) {
+    SULayerRef layer_ref = SU_INVALID;
+    layer = CW_INSTRUMENT_SU(SUDrawingElementGetLayer, element, &layer_ref) == SU_ERROR_NONE ? find(m_layer_indices, layer_ref.ptr) : NO_INDEX;
+    SUMaterialRef material_ref = SU_INVALID;
+    material = CW_INSTRUMENT_SU(SUDrawingElementGetMaterial, element, &material_ref) == SU_ERROR_NONE ? find(m_material_indices, material_ref.ptr) : NO_INDEX;
+    hidden = false;
+    SUResult res = CW_INSTRUMENT_SU(SUDrawingElementGetHidden, element, &hidden);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+
+  void read_layers(SUModelRef model) {
+    size_t count = 0;
+    SUResult res = CW_INSTRUMENT_SU(SUModelGetNumLayers, model, &count);
+    assert(res == SU_ERROR_NONE);
+    std::vector<SULayerRef> layers(count, SU_INVALID);
+    if (count > 0) {
+      res = CW_INSTRUMENT_SU(SUModelGetLayers, model, count, layers.data(), &count);
+      assert(res == SU_ERROR_NONE);
+      layers.resize(count);
+    }
+    _unused(res);
+    m_frozen.m_layers.reserve(layers.size());
+    for (SULayerRef layer : layers) {
+      m_layer_indices.emplace(layer.ptr, static_cast<Index>(m_frozen.m_layers.size()));
+      const Index name = this->intern_read(CW_INSTRUMENT_SU(SULayerGetName, layer, m_string));
+      m_frozen.m_layers.push_back(Layer{name, this->read_attributes(SULayerToEntity(layer))});
+    }
+  }
+
+  void read_materials(SUModelRef model) {
+    size_t count = 0;
+    SUResult res = CW_INSTRUMENT_SU(SUModelGetNumMaterials, model, &count);
+    assert(res == SU_ERROR_NONE);
+    std::vector<SUMaterialRef> materials(count, SU_INVALID);
+    if (count > 0) {
+      res = CW_INSTRUMENT_SU(SUModelGetMaterials, model, count, materials.data(), &count);
+      assert(res == SU_ERROR_NONE);
+      materials.resize(count);
+    }
+    _unused(res);
+    m_frozen.m_materials.reserve(materials.size());
+    for (SUMaterialRef material_ref : materials) {
+      m_material_indices.emplace(material_ref.ptr, static_cast<Index>(m_frozen.m_materials.size()));
+      Material material;
+      material.name = this->intern_read(CW_INSTRUMENT_SU(SUMaterialGetName, material_ref, m_string));
+      material.type = SUMaterialType_Colored;
+      CW_INSTRUMENT_SU(SUMaterialGetType, material_ref, &material.type);
+      // Materials without a color of their own keep opaque black.
+      material.color = SUColor{0, 0, 0, 255};
+      CW_INSTRUMENT_SU(SUMaterialGetColor, material_ref, &material.color);
+      material.opacity = 1.0;
+      CW_INSTRUMENT_SU(SUMaterialGetOpacity, material_ref, &material.opacity);
+      material.use_opacity = false;
+      CW_INSTRUMENT_SU(SUMaterialGetUseOpacity, material_ref, &material.use_opacity);
+      material.attributes = this->read_attributes(SUMaterialToEntity(material_ref));
+      m_frozen.m_materials.push_back(material);
+    }
+  }
+
+  /**
+  * Returns the index of a definition, adding it to the definitions to read if it has not been met before.
+  */
+  Index definition_index(SUComponentDefinitionRef definition_ref, bool group) {
+    auto inserted = m_definition_indices.emplace(definition_ref.ptr, static_cast<Index>(m_frozen.m_definitions.size()));
+    if (inserted.second) {
+      Definition definition = {};
+      definition.name = this->intern_read(CW_INSTRUMENT_SU(SUComponentDefinitionGetName, definition_ref, m_string));
+      definition.group = group;
+      definition.attributes = this->read_attributes(SUComponentDefinitionToEntity(definition_ref));
+      m_frozen.m_definitions.push_back(definition);
+      SUEntitiesRef entities = SU_INVALID;
+      SUResult res = CW_INSTRUMENT_SU(SUComponentDefinitionGetEntities, definition_ref, &entities);
+      assert(res == SU_ERROR_NONE); _unused(res);
+      m_definition_entities.push_back(entities);
+    }
+    return inserted.first->second;
+  }
+
+  Index vertex_index(SUVertexRef vertex) {
+    auto inserted = m_vertex_indices.emplace(vertex.ptr, static_cast<Index>(m_frozen.m_vertices.size()));
+    if (inserted.second) {
+      SUPoint3D position;
+      SUResult res = CW_INSTRUMENT_SU(SUVertexGetPosition, vertex, &position);
+      assert(res == SU_ERROR_NONE); _unused(res);
+      m_frozen.m_vertices.push_back(position);
+    }
+    return inserted.first->second;
+  }
+
+  void read_edges(SUEntitiesRef entities, Definition& definition) {
+    definition.edges.begin = static_cast<Index>(m_frozen.m_edges.size());
+    size_t count = 0;
+    SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumEdges, entities, false, &count);
+    assert(res == SU_ERROR_NONE);
+    std::vector<SUEdgeRef> edges(count, SU_INVALID);
+    if (count > 0) {
+      res = CW_INSTRUMENT_SU(SUEntitiesGetEdges, entities, false, count, edges.data(), &count);
+      assert(res == SU_ERROR_NONE);
+      edges.resize(count);
+    }
+    for (SUEdgeRef edge_ref : edges) {
+      m_edge_indices.emplace(edge_ref.ptr, static_cast<Index>(m_frozen.m_edges.size()));
+      Edge edge;
+      SUVertexRef vertex = SU_INVALID;
+      res = CW_INSTRUMENT_SU(SUEdgeGetStartVertex, edge_ref, &vertex);
+      assert(res == SU_ERROR_NONE);
+      edge.start = this->vertex_index(vertex);
+      res = CW_INSTRUMENT_SU(SUEdgeGetEndVertex, edge_ref, &vertex);
+      assert(res == SU_ERROR_NONE);
+      edge.end = this->vertex_index(vertex);
+      this->read_drawing_element(SUEdgeToDrawingElement(edge_ref), edge.layer, edge.material, edge.hidden);
+      edge.soft = false;
+      edge.smooth = false;
+      res = CW_INSTRUMENT_SU(SUEdgeGetSoft, edge_ref, &edge.soft);
+      assert(res == SU_ERROR_NONE);
+      res = CW_INSTRUMENT_SU(SUEdgeGetSmooth, edge_ref, &edge.smooth);
+      assert(res == SU_ERROR_NONE);
+      edge.attributes = this->read_attributes(SUEdgeToEntity(edge_ref));
+      m_frozen.m_edges.push_back(edge);
+    }
+    _unused(res);
+    definition.edges.end = static_cast<Index>(m_frozen.m_edges.size());
+  }
+
+  void read_faces(SUEntitiesRef entities, Definition& definition) {
+    definition.faces.begin = static_cast<Index>(m_frozen.m_faces.size());
+    size_t count = 0;
+    SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumFaces, entities, &count);
+    assert(res == SU_ERROR_NONE);
+    std::vector<SUFaceRef> faces(count, SU_INVALID);
+    if (count > 0) {
+      res = CW_INSTRUMENT_SU(SUEntitiesGetFaces, entities, count, faces.data(), &count);
+      assert(res == SU_ERROR_NONE);
+      faces.resize(count);
+    }
+    // Scratch buffers are reused for every face.
+    std::vector<SULoopRef> loop_refs;
+    std::vector<SUVertexRef> vertex_refs;
+    std::vector<SUEdgeRef> edge_refs;
+    for (SUFaceRef face_ref : faces) {
+      Face face;
+      size_t num_inner_loops = 0;
+      res = CW_INSTRUMENT_SU(SUFaceGetNumInnerLoops, face_ref, &num_inner_loops);
+      assert(res == SU_ERROR_NONE);
+      loop_refs.assign(num_inner_loops + 1, SU_INVALID);
+      res = CW_INSTRUMENT_SU(SUFaceGetOuterLoop, face_ref, &loop_refs[0]);
+      assert(res == SU_ERROR_NONE);
+      if (num_inner_loops > 0) {
+        res = CW_INSTRUMENT_SU(SUFaceGetInnerLoops, face_ref, num_inner_loops, &loop_refs[1], &num_inner_loops);
+        assert(res == SU_ERROR_NONE);
+      }
+      face.loops.begin = static_cast<Index>(m_frozen.m_loops.size());
+      for (size_t i = 0; i < num_inner_loops + 1; ++i) {
+        size_t num_vertices = 0;
+        res = CW_INSTRUMENT_SU(SULoopGetNumVertices, loop_refs[i], &num_vertices);
+        assert(res == SU_ERROR_NONE);
+        vertex_refs.assign(num_vertices, SU_INVALID);
+        edge_refs.assign(num_vertices, SU_INVALID);
+        if (num_vertices > 0) {
+          res = CW_INSTRUMENT_SU(SULoopGetVertices, loop_refs[i], num_vertices, vertex_refs.data(), &num_vertices);
+          assert(res == SU_ERROR_NONE);
+          size_t num_edges = 0;
+          res = CW_INSTRUMENT_SU(SULoopGetEdges, loop_refs[i], num_vertices, edge_refs.data(), &num_edges);
+          assert(res == SU_ERROR_NONE && num_edges == num_vertices);
+        }
+        Loop loop;
+        loop.vertices.begin = static_cast<Index>(m_frozen.m_loop_vertices.size());
+        for (size_t j = 0; j < num_vertices; ++j) {
+          m_frozen.m_loop_vertices.push_back(this->vertex_index(vertex_refs[j]));
+          m_frozen.m_loop_edges.push_back(find(m_edge_indices, edge_refs[j].ptr));
+        }
+        loop.vertices.end = static_cast<Index>(m_frozen.m_loop_vertices.size());
+        m_frozen.m_loops.push_back(loop);
+      }
+      face.loops.end = static_cast<Index>(m_frozen.m_loops.size());
+
+      this->read_drawing_element(SUFaceToDrawingElement(face_ref), face.layer, face.front_material, face.hidden);
+      SUMaterialRef material = SU_INVALID;
+      face.back_material = CW_INSTRUMENT_SU(SUFaceGetBackMaterial, face_ref, &material) == SU_ERROR_NONE ? find(m_material_indices, material.ptr) : NO_INDEX;
+      SUPlane3D plane = {0.0, 0.0, 1.0, 0.0};
+      res = CW_INSTRUMENT_SU(SUFaceGetPlane, face_ref, &plane);
+      assert(res == SU_ERROR_NONE);
+      face.normal = SUVector3D{plane.a, plane.b, plane.c};
+      face.attributes = this->read_attributes(SUFaceToEntity(face_ref));
+      m_frozen.m_faces.push_back(face);
+    }
+    _unused(res);
+    definition.faces.end = static_cast<Index>(m_frozen.m_faces.size());
+  }
+
+  void add_instance(SUComponentInstanceRef instance_ref, Index definition, Index parent) {
+    Instance instance;
+    instance.definition = definition;
+    instance.parent = parent;
+    instance.name = this->intern_read(CW_INSTRUMENT_SU(SUComponentInstanceGetName, instance_ref, m_string));
+    this->read_drawing_element(SUComponentInstanceToDrawingElement(instance_ref), instance.layer, instance.material, instance.hidden);
+    SUTransformation transformation;
+    SUResult res = CW_INSTRUMENT_SU(SUComponentInstanceGetTransform, instance_ref, &transformation);
+    assert(res == SU_ERROR_NONE); _unused(res);
+    instance.transformation = Transformation(transformation);
+    instance.attributes = this->read_attributes(SUComponentInstanceToEntity(instance_ref));
+    m_frozen.m_instances.push_back(instance);
+  }
+
+  void read_instances(SUEntitiesRef entities, Index parent) {
+    const Index begin = static_cast<Index>(m_frozen.m_instances.size());
+    size_t count = 0;
+    SUResult res = CW_INSTRUMENT_SU(SUEntitiesGetNumInstances, entities, &count);
+    assert(res == SU_ERROR_NONE);
+    std::vector<SUComponentInstanceRef> instances(count, SU_INVALID);
+    if (count > 0) {
+      res = CW_INSTRUMENT_SU(SUEntitiesGetInstances, entities, count, instances.data(), &count);
+      assert(res == SU_ERROR_NONE);
+      instances.resize(count);
+    }
+    for (SUComponentInstanceRef instance : instances) {
+      SUComponentDefinitionRef definition = SU_INVALID;
+      res = CW_INSTRUMENT_SU(SUComponentInstanceGetDefinition, instance, &definition);
+      assert(res == SU_ERROR_NONE);
+      this->add_instance(instance, this->definition_index(definition, false), parent);
+    }
+    count = 0;
+    res = CW_INSTRUMENT_SU(SUEntitiesGetNumGroups, entities, &count);
+    assert(res == SU_ERROR_NONE);
+    std::vector<SUGroupRef> groups(count, SU_INVALID);
+    if (count > 0) {
+      res = CW_INSTRUMENT_SU(SUEntitiesGetGroups, entities, count, groups.data(), &count);
+      assert(res == SU_ERROR_NONE);
+      groups.resize(count);
+    }
+    for (SUGroupRef group : groups) {
+      SUComponentDefinitionRef definition = SU_INVALID;
+      res = CW_INSTRUMENT_SU(SUGroupGetDefinition, group, &definition);
+      assert(res == SU_ERROR_NONE);
+      this->add_instance(SUGroupToComponentInstance(group), this->definition_index(definition, true), parent);
+    }
+    _unused(res);
+    // Reading the instances may have added definitions, so the definition is only looked up now.
+    m_frozen.m_definitions[parent].instances = Range{begin, static_cast<Index>(m_frozen.m_instances.size())};
+  }
+
+  template <class NameFunction>
+  static void sort_by_name(std::vector<Index>& sorted, size_t count, const NameFunction& name) {
+    sorted.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      sorted[i] = static_cast<Index>(i);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [&name](Index a, Index b) { return name(a) < name(b); });
+  }
+
+  public:
+  explicit Builder(FrozenModel& frozen):
+    m_frozen(frozen)
+  {}
+
+  void build(SUModelRef model) {
+    m_frozen.m_string_offsets.push_back(0);
+    this->read_layers(model);
+    this->read_materials(model);
+
+    size_t count = 0;
+    SUResult res = CW_INSTRUMENT_SU(SUModelGetNumAttributeDictionaries, model, &count);
+    assert(res == SU_ERROR_NONE);
+    std::vector<SUAttributeDictionaryRef> dictionaries(count, SU_INVALID);
+    if (count > 0) {
+      res = CW_INSTRUMENT_SU(SUModelGetAttributeDictionaries, model, count, dictionaries.data(), &count);
+      assert(res == SU_ERROR_NONE);
+      dictionaries.resize(count);
+    }
+    m_frozen.m_model_attributes = this->read_attributes(dictionaries);
+
+    // The model's own entities are the root definition.  Every component definition is read, including those that are not placed; group definitions are found through their groups.
+    Definition root = {};
+    root.name = this->intern("", 0);
+    m_frozen.m_definitions.push_back(root);
+    SUEntitiesRef entities = SU_INVALID;
+    res = CW_INSTRUMENT_SU(SUModelGetEntities, model, &entities);
+    assert(res == SU_ERROR_NONE);
+    m_definition_entities.push_back(entities);
+    count = 0;
+    res = CW_INSTRUMENT_SU(SUModelGetNumComponentDefinitions, model, &count);
+    assert(res == SU_ERROR_NONE);
+    std::vector<SUComponentDefinitionRef> definitions(count, SU_INVALID);
+    if (count > 0) {
+      res = CW_INSTRUMENT_SU(SUModelGetComponentDefinitions, model, count, definitions.data(), &count);
+      assert(res == SU_ERROR_NONE);
+      definitions.resize(count);
+    }
+    _unused(res);
+    for (SUComponentDefinitionRef definition : definitions) {
+      this->definition_index(definition, false);
+    }
+    // Definitions are appended as new groups are found, so this loop reads each definition once.
+    for (Index i = 0; i < m_frozen.m_definitions.size(); ++i) {
+      m_vertex_indices.clear();
+      m_edge_indices.clear();
+      Definition definition = m_frozen.m_definitions[i];
+      this->read_edges(m_definition_entities[i], definition);
+      this->read_faces(m_definition_entities[i], definition);
+      m_frozen.m_definitions[i].edges = definition.edges;
+      m_frozen.m_definitions[i].faces = definition.faces;
+      this->read_instances(m_definition_entities[i], i);
+    }
+
+    const FrozenModel& frozen = m_frozen;
+    this->sort_by_name(m_frozen.m_definitions_by_name, frozen.m_definitions.size(), [&frozen](Index i) { return frozen.m_definitions[i].name; });
+    this->sort_by_name(m_frozen.m_layers_by_name, frozen.m_layers.size(), [&frozen](Index i) { return frozen.m_layers[i].name; });
+    this->sort_by_name(m_frozen.m_materials_by_name, frozen.m_materials.size(), [&frozen](Index i) { return frozen.m_materials[i].name; });
+  }
+};
+
+
+FrozenModel::FrozenModel(const Model& model):
+  m_model_attributes(Range{0, 0})
+{
+  CW_INSTRUMENT_METHOD("CW::FrozenModel::FrozenModel");
+  if (!model) {
+    throw std::invalid_argument("CW::FrozenModel::FrozenModel(): given Model is null");
+  }
+  Builder(*this).build(model.ref());
+}
+
+
+size_t FrozenModel::hash_string(const char* data, size_t size) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return static_cast<size_t>(hash);
+}
+
+
+size_t FrozenModel::find_slot(const char* data, size_t size) const {
+  const size_t mask = m_string_slots.size() - 1;
+  size_t slot = hash_string(data, size) & mask;
+  while (m_string_slots[slot] != NO_INDEX) {
+    const StringView string = this->string(m_string_slots[slot]);
+    if (string.size == size && std::memcmp(string.data, data, size) == 0) {
+      break;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+
+Span<const FrozenModel::Definition> FrozenModel::definitions() const {
+  return m_definitions;
+}
+
+
+Span<const FrozenModel::Instance> FrozenModel::instances() const {
+  return m_instances;
+}
+
+
+Span<const FrozenModel::Face> FrozenModel::faces() const {
+  return m_faces;
+}
+
+
+Span<const FrozenModel::Loop> FrozenModel::loops() const {
+  return m_loops;
+}
+
+
+Span<const FrozenModel::Edge> FrozenModel::edges() const {
+  return m_edges;
+}
+
+
+Span<const FrozenModel::Layer> FrozenModel::layers() const {
+  return m_layers;
+}
+
+
+Span<const FrozenModel::Material> FrozenModel::materials() const {
+  return m_materials;
+}
+
+
+Span<const SUPoint3D> FrozenModel::vertices() const {
+  return m_vertices;
+}
+
+
+Span<const FrozenModel::Face> FrozenModel::faces(const Range& range) const {
+  return this->faces().subspan(range.begin, range.size());
+}
+
+
+Span<const FrozenModel::Edge> FrozenModel::edges(const Range& range) const {
+  return this->edges().subspan(range.begin, range.size());
+}
+
+
+Span<const FrozenModel::Instance> FrozenModel::instances(const Range& range) const {
+  return this->instances().subspan(range.begin, range.size());
+}
+
+
+Span<const FrozenModel::Loop> FrozenModel::loops(const Range& range) const {
+  return this->loops().subspan(range.begin, range.size());
+}
+
+
+Span<const FrozenModel::Attribute> FrozenModel::attributes(const Range& range) const {
+  return Span<const Attribute>(m_attributes).subspan(range.begin, range.size());
+}
+
+
+Span<const FrozenModel::Index> FrozenModel::loop_vertices(const Loop& loop) const {
+  return Span<const Index>(m_loop_vertices).subspan(loop.vertices.begin, loop.vertices.size());
+}
+
+
+Span<const FrozenModel::Index> FrozenModel::loop_edges(const Loop& loop) const {
+  return Span<const Index>(m_loop_edges).subspan(loop.vertices.begin, loop.vertices.size());
+}
+
+
+FrozenModel::Range FrozenModel::model_attributes() const {
+  return m_model_attributes;
+}
+
+
+const AttributeValue* FrozenModel::attribute(const Range& attributes, const std::string& dictionary, const std::string& key) const {
+  const Index dictionary_index = this->find_string(dictionary);
+  const Index key_index = this->find_string(key);
+  if (dictionary_index == NO_INDEX || key_index == NO_INDEX) {
+    return nullptr;
+  }
+  for (const Attribute& attribute : this->attributes(attributes)) {
+    if (attribute.dictionary == dictionary_index && attribute.key == key_index) {
+      return &attribute.value;
+    }
+  }
+  return nullptr;
+}
+
+
+StringView FrozenModel::string(Index index) const {
+  if (index >= this->num_strings()) {
+    throw std::out_of_range("CW::FrozenModel::string(): index is out of range");
+  }
+  return StringView{&m_characters[m_string_offsets[index]], m_string_offsets[index + 1] - m_string_offsets[index] - 1};
+}
+
+
+FrozenModel::Index FrozenModel::find_string(const std::string& string) const {
+  if (m_string_slots.empty()) {
+    return NO_INDEX;
+  }
+  return m_string_slots[this->find_slot(string.data(), string.size())];
+}
+
+
+size_t FrozenModel::num_strings() const {
+  return m_string_offsets.empty() ? 0 : m_string_offsets.size() - 1;
+}
+
+
+namespace {
+
+template <class T>
+FrozenModel::Index find_by_name(const std::vector<FrozenModel::Index>& sorted, const std::vector<T>& objects, FrozenModel::Index name) {
+  if (name == FrozenModel::NO_INDEX) {
+    return FrozenModel::NO_INDEX;
+  }
+  auto found = std::lower_bound(sorted.begin(), sorted.end(), name, [&objects](FrozenModel::Index index, FrozenModel::Index value) {
+    return objects[index].name < value;
+  });
+  return found != sorted.end() && objects[*found].name == name ? *found : FrozenModel::NO_INDEX;
+}
+
+} // namespace
+
+
+FrozenModel::Index FrozenModel::find_definition(const std::string& name) const {
+  return find_by_name(m_definitions_by_name, m_definitions, this->find_string(name));
+}
+
+
+FrozenModel::Index FrozenModel::find_layer(const std::string& name) const {
+  return find_by_name(m_layers_by_name, m_layers, this->find_string(name));
+}
+
+
+FrozenModel::Index FrozenModel::find_material(const std::string& name) const {
+  return find_by_name(m_materials_by_name, m_materials, this->find_string(name));
+}
+
+
+size_t FrozenModel::memory_size() const {
+  size_t size = sizeof(FrozenModel) +
+    vector_memory_size(m_definitions) +
+    vector_memory_size(m_instances) +
+    vector_memory_size(m_faces) +
+    vector_memory_size(m_loops) +
+    vector_memory_size(m_loop_vertices) +
+    vector_memory_size(m_loop_edges) +
+    vector_memory_size(m_edges) +
+    vector_memory_size(m_vertices) +
+    vector_memory_size(m_layers) +
+    vector_memory_size(m_materials) +
+    vector_memory_size(m_attributes) +
+    vector_memory_size(m_characters) +
+    vector_memory_size(m_string_offsets) +
+    vector_memory_size(m_string_slots) +
+    vector_memory_size(m_definitions_by_name) +
+    vector_memory_size(m_layers_by_name) +
+    vector_memory_size(m_materials_by_name);
+  for (const Attribute& attribute : m_attributes) {
+    size += attribute.value.memory_size();
+  }
+  return size;
+}
+
+} /* namespace CW */
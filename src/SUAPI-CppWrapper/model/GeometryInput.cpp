@@ -33,7 +33,7 @@
 
 #include "SUAPI-CppWrapper/model/GeometryInput.hpp"
 
-#include <SketchupAPI/sketchup_info.h>
+#include <SketchUpAPI/sketchup_info.h>
 
 #include "SUAPI-CppWrapper/Initialize.hpp"
 #include "SUAPI-CppWrapper/model/Model.hpp"
@@ -46,17 +46,17 @@
 #include "SUAPI-CppWrapper/model/Face.hpp"
 #include "SUAPI-CppWrapper/model/Edge.hpp"
 #include "SUAPI-CppWrapper/model/MaterialInput.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
 
 namespace CW {
 
-std::unordered_map<SUGeometryInputRef, size_t> GeometryInput::num_objects_ = {};
-
 /***************************
 ** Private Static Methods **
 ****************************/
 SUGeometryInputRef GeometryInput::create_geometry_input() {
   SUGeometryInputRef geom_input = SU_INVALID;
-  SUResult res = SUGeometryInputCreate(&geom_input);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputCreate, &geom_input);
   assert(res == SU_ERROR_NONE); _unused(res);
   return geom_input;
 }
@@ -81,60 +81,83 @@ SUResult GeometryInput::add_loop(LoopInput &loop) {
 ** Constructors / Destructor **
 *******************************/
 GeometryInput::GeometryInput(SUModelRef target_model):
-  m_geometry_input(create_geometry_input()),
-  m_attached(false),
+  m_shared(new Shared{create_geometry_input(), {1}, 0, nullptr}),
+  m_geometry_input(m_shared->geometry_input),
   m_target_model(target_model)
 {
-  num_objects_[m_geometry_input] = 1;
+  RefTracker::acquired(RefKind::GeometryInput, m_geometry_input.ptr);
 }
 
 
-GeometryInput::~GeometryInput() {
-  if (SUIsValid(m_geometry_input) && !m_attached && num_objects_[m_geometry_input] == 1) {
-    num_objects_.erase(m_geometry_input);
-    SUResult res = SUGeometryInputRelease(&m_geometry_input);
-    assert(res == SU_ERROR_NONE); _unused(res);
-  }
-  else {
-    --num_objects_[m_geometry_input];
+GeometryInput::GeometryInput(const GeometryInput& other) noexcept:
+  m_shared(other.m_shared),
+  m_geometry_input(other.m_geometry_input),
+  m_target_model(other.m_target_model)
+{
+  if (m_shared != nullptr) {
+    // A new reference can only be taken from an existing one, so no ordering is needed.
+    m_shared->ref_count.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
 
-GeometryInput::GeometryInput(const GeometryInput& other):
+GeometryInput::GeometryInput(GeometryInput&& other) noexcept:
+  m_shared(other.m_shared),
+  m_geometry_input(other.m_geometry_input),
   m_target_model(other.m_target_model)
 {
-  if (SUIsValid(m_geometry_input) && !m_attached && num_objects_[m_geometry_input] == 1) {
-    num_objects_.erase(m_geometry_input);
-    SUResult res = SUGeometryInputRelease(&m_geometry_input);
-    assert(res == SU_ERROR_NONE); _unused(res);
-  }
-  else {
-    --num_objects_[m_geometry_input];
-  }
-  m_geometry_input = other.m_geometry_input;
-  m_attached = other.m_attached;
-  ++num_objects_[m_geometry_input];
+  other.m_shared = nullptr;
+  other.m_geometry_input = SU_INVALID;
 }
-  
-  
-GeometryInput& GeometryInput::operator=(const GeometryInput& other) {
-  if (SUIsValid(m_geometry_input) && !m_attached && num_objects_[m_geometry_input] == 1) {
-    num_objects_.erase(m_geometry_input);
-    SUResult res = SUGeometryInputRelease(&m_geometry_input);
+
+
+GeometryInput::~GeometryInput() {
+  release();
+}
+
+
+void GeometryInput::release() noexcept {
+  if (m_shared == nullptr) {
+    return;
+  }
+  // The release order makes this copy's changes visible to the thread that frees the geometry input.
+  if (m_shared->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    RefTracker::released(RefKind::GeometryInput, m_shared->geometry_input.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUGeometryInputRelease, &m_shared->geometry_input);
     assert(res == SU_ERROR_NONE); _unused(res);
+    delete m_shared;
   }
-  else {
-    --num_objects_[m_geometry_input];
+  m_shared = nullptr;
+  m_geometry_input = SU_INVALID;
+}
+
+
+GeometryInput& GeometryInput::operator=(const GeometryInput& other) noexcept {
+  if (m_shared != other.m_shared) {
+    if (other.m_shared != nullptr) {
+      other.m_shared->ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    release();
+    m_shared = other.m_shared;
+    m_geometry_input = other.m_geometry_input;
   }
-  m_geometry_input = other.m_geometry_input;
-  m_attached = other.m_attached;
   m_target_model = other.m_target_model;
-  ++num_objects_[m_geometry_input];
   return (*this);
 }
 
 
+GeometryInput& GeometryInput::operator=(GeometryInput&& other) noexcept {
+  if (this != &other) {
+    release();
+    m_shared = other.m_shared;
+    m_geometry_input = other.m_geometry_input;
+    m_target_model = other.m_target_model;
+    other.m_shared = nullptr;
+    other.m_geometry_input = SU_INVALID;
+  }
+  return (*this);
+}
+
 
 SUGeometryInputRef GeometryInput::ref() const {
   return m_geometry_input;
@@ -155,6 +178,7 @@ size_t GeometryInput::num_faces() const {
 
 
 size_t GeometryInput::add_face(const Face &face, bool copy_material_layer) {
+  CW_INSTRUMENT_METHOD("CW::GeometryInput::add_face");
   if(!(*this)) {
     throw std::logic_error("CW::GeometryInput::add_face(): GeometryInput is null");
   }
@@ -168,14 +192,15 @@ size_t GeometryInput::add_face(const Face &face, bool copy_material_layer) {
   for (size_t i=0; i < outer_points.size(); ++i) {
     size_t v_index = this->add_vertex(outer_points[i]);
     outer_loop_input.add_vertex_index(v_index);
+    // Edge properties are indexed by the edge's position in the loop, not by vertex index.
     if (outer_edges[i].hidden()) {
-      outer_loop_input.set_edge_hidden(v_index, true);
+      outer_loop_input.set_edge_hidden(i, true);
     }
     if (outer_edges[i].smooth()) {
-      outer_loop_input.set_edge_smooth(v_index, true);
+      outer_loop_input.set_edge_smooth(i, true);
     }
     if (outer_edges[i].soft()) {
-      outer_loop_input.set_edge_soft(v_index, true);
+      outer_loop_input.set_edge_soft(i, true);
     }
     // TODO: set layer and material
   }
@@ -187,16 +212,16 @@ size_t GeometryInput::add_face(const Face &face, bool copy_material_layer) {
     std::vector<Point3D> inner_points = inner_loops[i].points();
     std::vector<Edge> inner_edges = inner_loops[i].edges();
     for (size_t j=0; j < inner_points.size(); ++j) {
-      size_t v_index = this->add_vertex(inner_points[i]);
+      size_t v_index = this->add_vertex(inner_points[j]);
       inner_loop_input.add_vertex_index(v_index);
-      if (inner_edges[i].hidden()) {
-        inner_loop_input.set_edge_hidden(v_index, true);
+      if (inner_edges[j].hidden()) {
+        inner_loop_input.set_edge_hidden(j, true);
       }
-      if (inner_edges[i].smooth()) {
-        inner_loop_input.set_edge_smooth(v_index, true);
+      if (inner_edges[j].smooth()) {
+        inner_loop_input.set_edge_smooth(j, true);
       }
-      if (inner_edges[i].soft()) {
-        inner_loop_input.set_edge_soft(v_index, true);
+      if (inner_edges[j].soft()) {
+        inner_loop_input.set_edge_soft(j, true);
       }
       // TODO: set layer and material
     }
@@ -242,6 +267,7 @@ size_t GeometryInput::add_faces(const std::vector<Face>& faces, bool copy_materi
 
 
 size_t GeometryInput::add_edge(const Edge &edge) {
+  CW_INSTRUMENT_METHOD("CW::GeometryInput::add_edge");
   if(!edge) {
     throw std::invalid_argument("CW::GeometryInput::add_edge(): Edge argument is null");
   }
@@ -295,20 +321,70 @@ bool GeometryInput::empty() const {
 
 
 size_t GeometryInput::add_vertex(const Point3D& point) {
-  SUResult res = SUGeometryInputAddVertex(m_geometry_input, point);
+  CW_INSTRUMENT_METHOD("CW::GeometryInput::add_vertex");
+  if(!(*this)) {
+    throw std::logic_error("CW::GeometryInput::add_vertex(): GeometryInput is null");
+  }
+  if (m_shared->welder) {
+    const size_t index = m_shared->welder->weld(point, m_shared->vertex_index);
+    if (index != m_shared->vertex_index) {
+      return index;
+    }
+  }
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputAddVertex, m_geometry_input, point);
   assert(res == SU_ERROR_NONE); _unused(res);
-  m_vertex_index++;
-  return m_vertex_index-1;
+  return m_shared->vertex_index++;
+}
+
+
+bool GeometryInput::weld_vertices() const {
+  if(!(*this)) {
+    throw std::logic_error("CW::GeometryInput::weld_vertices(): GeometryInput is null");
+  }
+  return m_shared->welder != nullptr;
+}
+
+
+void GeometryInput::weld_vertices(bool weld) {
+  if(!(*this)) {
+    throw std::logic_error("CW::GeometryInput::weld_vertices(): GeometryInput is null");
+  }
+  if (!weld) {
+    m_shared->welder.reset();
+  }
+  else if (!m_shared->welder) {
+    m_shared->welder.reset(new VertexWelder());
+  }
+}
+
+
+size_t GeometryInput::welded_vertices() const {
+  if(!(*this)) {
+    throw std::logic_error("CW::GeometryInput::welded_vertices(): GeometryInput is null");
+  }
+  return m_shared->welder ? m_shared->welder->duplicates() : 0;
 }
 
 
 void GeometryInput::set_vertices(const std::vector<SUPoint3D>& points) {
+  CW_INSTRUMENT_METHOD("CW::GeometryInput::set_vertices");
+  if(!(*this)) {
+    throw std::logic_error("CW::GeometryInput::set_vertices(): GeometryInput is null");
+  }
   assert(this->counts()[1] == 0); // Undefined behaviour when overwriting vertices
   assert(this->counts()[2] == 0); // Undefined behaviour when overwriting vertices
-  SUResult res = SUGeometryInputSetVertices(m_geometry_input, points.size(), points.data());
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputSetVertices, m_geometry_input, points.size(), points.data());
   assert(res == SU_ERROR_NONE); _unused(res);
   // Overwrite the existing vertex count
-  m_vertex_index = points.size();
+  m_shared->vertex_index = points.size();
+  if (m_shared->welder) {
+    // Vertices added later are welded to these, but these keep the indices they were given.
+    m_shared->welder->clear();
+    m_shared->welder->reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      m_shared->welder->add(Point3D(points[i]), i);
+    }
+  }
 }
 
 
@@ -322,41 +398,154 @@ void GeometryInput::set_vertices(const std::vector<Point3D>& points) {
 }
 
 
+size_t GeometryInput::add_indexed_mesh(Span<const SUPoint3D> vertices, Span<const uint32_t> indices, Span<const uint32_t> face_offsets, const IndexedMeshFaceProperties& properties) {
+  CW_INSTRUMENT_METHOD("CW::GeometryInput::add_indexed_mesh");
+  if(!(*this)) {
+    throw std::logic_error("CW::GeometryInput::add_indexed_mesh(): GeometryInput is null");
+  }
+  const size_t num_faces = face_offsets.size();
+  auto per_face = [num_faces](size_t size) {
+    return size == 0 || size == num_faces;
+  };
+  if (!per_face(properties.front_materials.size()) || !per_face(properties.back_materials.size()) ||
+      !per_face(properties.layers.size()) || !per_face(properties.smooth_edges.size())) {
+    throw std::invalid_argument("CW::GeometryInput::add_indexed_mesh(): face properties must be empty or have one entry per face");
+  }
+  // Check everything before passing anything to SketchUp, so bad input leaves this object untouched.
+  for (size_t i = 0; i < num_faces; ++i) {
+    const size_t end = i + 1 < num_faces ? face_offsets[i + 1] : indices.size();
+    if (end < size_t(face_offsets[i]) + 3 || end > indices.size()) {
+      throw std::invalid_argument("CW::GeometryInput::add_indexed_mesh(): face_offsets must be ascending, with at least three indices per face");
+    }
+  }
+  for (uint32_t index : indices) {
+    if (index >= vertices.size()) {
+      throw std::invalid_argument("CW::GeometryInput::add_indexed_mesh(): vertex index out of range");
+    }
+  }
+
+  // Welded vertices need their indices mapped one by one.  Otherwise mesh indices are offset by the number of vertices already added.
+  std::vector<size_t> vertex_map;
+  size_t base_index = 0;
+  if (m_shared->welder) {
+    m_shared->welder->reserve(m_shared->welder->size() + vertices.size());
+    vertex_map.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      vertex_map[i] = add_vertex(Point3D(vertices[i]));
+    }
+  }
+  else if (this->counts()[0] == 0) {
+    SUResult res = CW_INSTRUMENT_SU(SUGeometryInputSetVertices, m_geometry_input, vertices.size(), vertices.data());
+    assert(res == SU_ERROR_NONE); _unused(res);
+    m_shared->vertex_index = vertices.size();
+  }
+  else {
+    base_index = m_shared->vertex_index;
+    for (const SUPoint3D& vertex : vertices) {
+      SUResult res = CW_INSTRUMENT_SU(SUGeometryInputAddVertex, m_geometry_input, &vertex);
+      assert(res == SU_ERROR_NONE); _unused(res);
+    }
+    m_shared->vertex_index += vertices.size();
+  }
+
+  // Reused for every face, so the loop of each face does not need its own allocation.
+  std::vector<size_t> loop;
+  size_t faces_added = 0;
+  for (size_t i = 0; i < num_faces; ++i) {
+    const size_t end = i + 1 < num_faces ? face_offsets[i + 1] : indices.size();
+    loop.clear();
+    for (size_t j = face_offsets[i]; j < end; ++j) {
+      const size_t index = vertex_map.empty() ? base_index + indices[j] : vertex_map[indices[j]];
+      // SketchUp rejects a loop that repeats a vertex, so drop zero length edges.
+      if (loop.empty() || loop.back() != index) {
+        loop.push_back(index);
+      }
+    }
+    while (loop.size() > 1 && loop.back() == loop.front()) {
+      loop.pop_back();
+    }
+    if (loop.size() < 3) {
+      continue;
+    }
+    SULoopInputRef loop_input = SU_INVALID;
+    SUResult res = CW_INSTRUMENT_SU(SULoopInputCreate, &loop_input);
+    assert(res == SU_ERROR_NONE); _unused(res);
+    bool valid = true;
+    for (size_t j = 0; j < loop.size() && valid; ++j) {
+      valid = CW_INSTRUMENT_SU(SULoopInputAddVertexIndex, loop_input, loop[j]) == SU_ERROR_NONE;
+    }
+    if (valid && !properties.smooth_edges.empty() && properties.smooth_edges[i] != 0) {
+      for (size_t j = 0; j < loop.size(); ++j) {
+        res = CW_INSTRUMENT_SU(SULoopInputEdgeSetSoft, loop_input, j, true);
+        assert(res == SU_ERROR_NONE); _unused(res);
+        res = CW_INSTRUMENT_SU(SULoopInputEdgeSetSmooth, loop_input, j, true);
+        assert(res == SU_ERROR_NONE); _unused(res);
+      }
+    }
+    size_t face_index;
+    // On success SketchUp takes ownership of the loop input.
+    if (!valid || CW_INSTRUMENT_SU(SUGeometryInputAddFace, m_geometry_input, &loop_input, &face_index) != SU_ERROR_NONE) {
+      res = CW_INSTRUMENT_SU(SULoopInputRelease, &loop_input);
+      assert(res == SU_ERROR_NONE); _unused(res);
+      continue;
+    }
+    if (!properties.front_materials.empty() && !!properties.front_materials[i]) {
+      SUMaterialInput material_input{};
+      material_input.material = properties.front_materials[i].ref();
+      res = CW_INSTRUMENT_SU(SUGeometryInputFaceSetFrontMaterial, m_geometry_input, face_index, &material_input);
+      assert(res == SU_ERROR_NONE); _unused(res);
+    }
+    if (!properties.back_materials.empty() && !!properties.back_materials[i]) {
+      SUMaterialInput material_input{};
+      material_input.material = properties.back_materials[i].ref();
+      res = CW_INSTRUMENT_SU(SUGeometryInputFaceSetBackMaterial, m_geometry_input, face_index, &material_input);
+      assert(res == SU_ERROR_NONE); _unused(res);
+    }
+    if (!properties.layers.empty() && !!properties.layers[i]) {
+      res = CW_INSTRUMENT_SU(SUGeometryInputFaceSetLayer, m_geometry_input, face_index, properties.layers[i].ref());
+      assert(res == SU_ERROR_NONE); _unused(res);
+    }
+    ++faces_added;
+  }
+  return faces_added;
+}
+
+
 size_t GeometryInput::add_edge(size_t vertex0_index, size_t vertex1_index) {
   size_t added_edge_index;
-  SUResult res = SUGeometryInputAddEdge(m_geometry_input, vertex0_index, vertex1_index, &added_edge_index);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputAddEdge, m_geometry_input, vertex0_index, vertex1_index, &added_edge_index);
   assert(res == SU_ERROR_NONE); _unused(res);
   return added_edge_index;
 }
 
 
 void GeometryInput::edge_hidden(size_t edge_index, bool hidden) {
-  SUResult res = SUGeometryInputEdgeSetHidden(m_geometry_input, edge_index, hidden);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputEdgeSetHidden, m_geometry_input, edge_index, hidden);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
 
 void GeometryInput::edge_soft(size_t edge_index, bool soft) {
-  SUResult res = SUGeometryInputEdgeSetSoft(m_geometry_input, edge_index, soft);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputEdgeSetSoft, m_geometry_input, edge_index, soft);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
 
 void GeometryInput::edge_smooth(size_t edge_index, bool smooth) {
-  SUResult res = SUGeometryInputEdgeSetSmooth(m_geometry_input, edge_index, smooth);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputEdgeSetSmooth, m_geometry_input, edge_index, smooth);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
 
 void GeometryInput::edge_material(size_t edge_index, const Material& material) {
-  SUResult res = SUGeometryInputEdgeSetMaterial(m_geometry_input, edge_index, material.ref());
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputEdgeSetMaterial, m_geometry_input, edge_index, material.ref());
   assert(res == SU_ERROR_NONE); _unused(res);
   // TODO: check that material exists in target model.
 }
 
 
 void GeometryInput::edge_layer(size_t edge_index, const Layer& layer) {
-  SUResult res = SUGeometryInputEdgeSetLayer(m_geometry_input, edge_index, layer.ref());
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputEdgeSetLayer, m_geometry_input, edge_index, layer.ref());
   assert(res == SU_ERROR_NONE); _unused(res);
   // TODO: check that layer exists in target model.
 }
@@ -364,7 +553,7 @@ void GeometryInput::edge_layer(size_t edge_index, const Layer& layer) {
 
 size_t GeometryInput::add_curve(const std::vector<size_t>& edge_indices) {
   size_t added_curve_index;
-  SUResult res = SUGeometryInputAddCurve(m_geometry_input, edge_indices.size(), edge_indices.data(), &added_curve_index);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputAddCurve, m_geometry_input, edge_indices.size(), edge_indices.data(), &added_curve_index);
   assert(res == SU_ERROR_NONE); _unused(res);
   return added_curve_index;
 }
@@ -373,45 +562,48 @@ size_t GeometryInput::add_curve(const std::vector<size_t>& edge_indices) {
 std::pair<size_t, size_t> GeometryInput::add_arc_curve(size_t start_point, size_t end_point, const Point3D& center, const Vector3D& normal, size_t num_segments) {
   size_t added_curve_index;
   size_t control_edge_index;
-  SUResult res = SUGeometryInputAddArcCurve(m_geometry_input, start_point, end_point, center, normal, num_segments, &added_curve_index, &control_edge_index);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputAddArcCurve, m_geometry_input, start_point, end_point, center, normal, num_segments, &added_curve_index, &control_edge_index);
   assert(res == SU_ERROR_NONE); _unused(res);
   return std::pair<size_t, size_t> {added_curve_index, control_edge_index};
 }
 
 
 size_t GeometryInput::add_face(LoopInput& loop_input) {
+  CW_INSTRUMENT_METHOD("CW::GeometryInput::add_face");
   size_t added_face_index;
   SULoopInputRef loop_ref = loop_input.ref();
-  SUResult res = SUGeometryInputAddFace(m_geometry_input, &loop_ref, &added_face_index);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputAddFace, m_geometry_input, &loop_ref, &added_face_index);
   assert(res == SU_ERROR_NONE); _unused(res);
+  RefTracker::released(RefKind::LoopInput, loop_ref.ptr);
   loop_input.m_attached = true;
   return added_face_index;
 }
 
 
 void GeometryInput::face_reverse(size_t face_index, bool reverse) {
-  SUResult res = SUGeometryInputFaceSetReverse(m_geometry_input, face_index, reverse);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputFaceSetReverse, m_geometry_input, face_index, reverse);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
 
 void GeometryInput::face_layer(size_t face_index, const Layer& layer) {
-  SUResult res = SUGeometryInputFaceSetLayer(m_geometry_input, face_index, layer.ref());
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputFaceSetLayer, m_geometry_input, face_index, layer.ref());
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
 
 void GeometryInput::face_add_inner_loop(size_t face_index, LoopInput& inner_loop) {
   SULoopInputRef loop_ref = inner_loop.ref();
-  SUResult res = SUGeometryInputFaceAddInnerLoop(m_geometry_input, face_index, &loop_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputFaceAddInnerLoop, m_geometry_input, face_index, &loop_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
+  RefTracker::released(RefKind::LoopInput, loop_ref.ptr);
   inner_loop.m_attached = true;
 }
 
 
 void GeometryInput::face_front_material(size_t face_index, MaterialInput& material_input) {
   SUMaterialInput material_ref = material_input.ref();
-  SUResult res = SUGeometryInputFaceSetFrontMaterial(m_geometry_input, face_index, &material_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputFaceSetFrontMaterial, m_geometry_input, face_index, &material_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   // TODO: assert MateriealRef in the MaterialInput is not attached to a different model from the one it will be added to.
 }
@@ -426,14 +618,14 @@ void GeometryInput::face_back_material(size_t face_index, MaterialInput& materia
 
 
 void GeometryInput::face_hidden(size_t face_index, bool hidden) {
-  SUResult res = SUGeometryInputFaceSetHidden(m_geometry_input, face_index, hidden);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputFaceSetHidden, m_geometry_input, face_index, hidden);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
 
 std::array<size_t, 5> GeometryInput::counts() const {
   std::array<size_t, 5> count_arr;
-  SUResult res = SUGeometryInputGetCounts(m_geometry_input, &count_arr[0], &count_arr[1], &count_arr[2], &count_arr[3], &count_arr[4]);
+  SUResult res = CW_INSTRUMENT_SU(SUGeometryInputGetCounts, m_geometry_input, &count_arr[0], &count_arr[1], &count_arr[2], &count_arr[3], &count_arr[4]);
   assert(res == SU_ERROR_NONE); _unused(res);
   return count_arr;
 }
@@ -31,6 +31,7 @@
 #include "SUAPI-CppWrapper/model/Group.hpp"
 
 #include <cassert>
+#include <stdexcept>
 
 #include "SUAPI-CppWrapper/String.hpp"
 #include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
@@ -38,6 +39,7 @@
 #include "SUAPI-CppWrapper/model/ComponentInstance.hpp"
 #include "SUAPI-CppWrapper/model/Entities.hpp"
 #include "SUAPI-CppWrapper/Transformation.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 
 namespace CW {
@@ -47,7 +49,7 @@ namespace CW {
 ***************************/
 SUGroupRef Group::create_group() {
   SUGroupRef group_ref = SU_INVALID;
-  SUResult res = SUGroupCreate(&group_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUGroupCreate, &group_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return group_ref;
 }
@@ -119,7 +121,7 @@ ComponentDefinition Group::definition() const {
     throw std::logic_error("CW::Group::definition(): Group is null");
   }
   SUComponentDefinitionRef def_ref = SU_INVALID;
-  SUResult res = SUGroupGetDefinition(this->ref(), &def_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUGroupGetDefinition, this->ref(), &def_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return ComponentDefinition(def_ref);
 }
@@ -130,7 +132,7 @@ Entities Group::entities() const {
     throw std::logic_error("CW::Group::entities(): Group is null");
   }
   SUEntitiesRef entities = SU_INVALID;
-  SUGroupGetEntities(this->ref(), &entities);
+  CW_INSTRUMENT_SU(SUGroupGetEntities, this->ref(), &entities);
   return Entities(entities, this->model().ref());
 }
 
@@ -141,7 +143,7 @@ String Group::name() const {
   }
   String string;
   SUStringRef * const string_ref = string;
-  SUResult res = SUGroupGetName(this->ref(), string_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUGroupGetName, this->ref(), string_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return string;
 }
@@ -152,7 +154,7 @@ void Group::name(const String& string) {
     throw std::logic_error("CW::Group::name(): Group is null");
   }
   std::string name_string = string.std_string();
-  SUResult res = SUGroupSetName(this->ref(), name_string.c_str());
+  SUResult res = CW_INSTRUMENT_SU(SUGroupSetName, this->ref(), name_string.c_str());
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -162,7 +164,7 @@ Transformation Group::transformation() const {
     throw std::logic_error("CW::Group::transformation(): Group is null");
   }
   SUTransformation transform{};
-  SUGroupGetTransform(this->ref(), &transform);
+  CW_INSTRUMENT_SU(SUGroupGetTransform, this->ref(), &transform);
   return Transformation(transform);
 }
 
@@ -172,7 +174,7 @@ void Group::transformation(const Transformation& transform) {
     throw std::logic_error("CW::Group::transformation(): Group is null");
   }
   SUTransformation transform_ref = transform.ref();
-  SUResult res = SUGroupSetTransform(this->ref(), &transform_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUGroupSetTransform, this->ref(), &transform_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
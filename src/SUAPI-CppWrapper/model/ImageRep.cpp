@@ -33,6 +33,9 @@
 #include <cassert>
 #include <stdexcept>
 
+#include "SUAPI-CppWrapper/RefTracker.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+
 namespace CW {
 
 /*************************
@@ -44,6 +47,7 @@ SUImageRepRef ImageRep::copy_reference(const ImageRep& other) {
   }
   ImageRep new_copy = other.copy();
   new_copy.m_attached = true; // Ensures that the object will not be destroyed at the end this scope.
+  RefTracker::released(RefKind::ImageRep, new_copy.m_image_rep.ptr); // The new owner reports it again.
   return new_copy.ref();
 }
 
@@ -59,7 +63,11 @@ ImageRep::ImageRep():
 ImageRep::ImageRep(SUImageRepRef image_rep, bool attached):
   m_image_rep(image_rep),
   m_attached(attached)
-{}
+{
+  if (!m_attached && SUIsValid(m_image_rep)) {
+    RefTracker::acquired(RefKind::ImageRep, m_image_rep.ptr);
+  }
+}
   
 
 ImageRep::ImageRep(const ImageRep& other):
@@ -69,19 +77,50 @@ ImageRep::ImageRep(const ImageRep& other):
 
 ImageRep::~ImageRep() {
   if (SUIsValid(m_image_rep) && !m_attached) {
-    SUResult res = SUImageRepRelease(&m_image_rep);
+    RefTracker::released(RefKind::ImageRep, m_image_rep.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUImageRepRelease, &m_image_rep);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
 
 
+ImageRep::ImageRep(ImageRep&& other) noexcept:
+  m_image_rep(other.m_image_rep),
+  m_attached(other.m_attached)
+{
+  other.m_image_rep = SU_INVALID;
+  other.m_attached = false;
+}
+
+
 ImageRep& ImageRep::operator=(const ImageRep& other) {
   if (!m_attached && SUIsValid(m_image_rep)) {
-    SUResult res = SUImageRepRelease(&m_image_rep);
+    RefTracker::released(RefKind::ImageRep, m_image_rep.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUImageRepRelease, &m_image_rep);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
   m_image_rep = copy_reference(other);
   m_attached = other.m_attached;
+  if (!m_attached && SUIsValid(m_image_rep)) {
+    RefTracker::acquired(RefKind::ImageRep, m_image_rep.ptr);
+  }
+  return (*this);
+}
+
+
+ImageRep& ImageRep::operator=(ImageRep&& other) noexcept {
+  if (this == &other) {
+    return (*this);
+  }
+  if (!m_attached && SUIsValid(m_image_rep)) {
+    RefTracker::released(RefKind::ImageRep, m_image_rep.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUImageRepRelease, &m_image_rep);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  m_image_rep = other.m_image_rep;
+  m_attached = other.m_attached;
+  other.m_image_rep = SU_INVALID;
+  other.m_attached = false;
   return (*this);
 }
   
@@ -111,19 +150,22 @@ ImageRep ImageRep::copy() const {
     throw std::logic_error("CW::ImageRep::copy(): ImageRep is null");
   }
   SUImageRepRef copy_image = SU_INVALID;
-  SUResult res = SUImageRepCreate(&copy_image);
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepCreate, &copy_image);
   assert(res == SU_ERROR_NONE);
-  res = SUImageRepCopy(copy_image, m_image_rep);
+  res = CW_INSTRUMENT_SU(SUImageRepCopy, copy_image, m_image_rep);
   assert(res == SU_ERROR_NONE); _unused(res);
   return ImageRep(copy_image, false);
 }
 
 
-void ImageRep::set_data(size_t width, size_t height, size_t bits_per_pixel, size_t row_padding, const std::vector<SUByte> pixel_data) {
+void ImageRep::set_data(size_t width, size_t height, size_t bits_per_pixel, size_t row_padding, Span<const SUByte> pixel_data) {
   if(!(*this)) {
     throw std::logic_error("CW::ImageRep::set_data(): ImageRep is null");
   }
-  SUResult res = SUImageRepSetData(m_image_rep, width, height, bits_per_pixel, row_padding, &pixel_data[0]);
+  if (pixel_data.size() < (width * bits_per_pixel / 8 + row_padding) * height) {
+    throw std::invalid_argument("CW::ImageRep::set_data(): pixel_data is too small for the given width, height and bits_per_pixel");
+  }
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepSetData, m_image_rep, width, height, bits_per_pixel, row_padding, pixel_data.data());
   if (res == SU_ERROR_OUT_OF_RANGE) {
     if (width == 0 || height == 0) {
       throw std::invalid_argument("CW::ImageRep::set_data(): given width or height is 0 - it must be greater than 0");
@@ -140,7 +182,7 @@ void ImageRep::load_file(const std::string file_path) {
   if(!(*this)) {
     throw std::logic_error("CW::ImageRep::load_file(): ImageRep is null");
   }
-  SUResult res = SUImageRepLoadFile(m_image_rep, file_path.c_str());
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepLoadFile, m_image_rep, file_path.c_str());
   if (res == SU_ERROR_SERIALIZATION) {
     throw std::invalid_argument("CW::ImageRep::load_file(): Loading file failed. Probably invalid file path given.");
   }
@@ -152,7 +194,7 @@ SUResult ImageRep::save_to_file(const std::string file_path) const {
   if(!(*this)) {
     throw std::logic_error("CW::ImageRep::save_to_file(): ImageRep is null");
   }
-  SUResult res = SUImageRepSaveToFile(m_image_rep, file_path.c_str());
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepSaveToFile, m_image_rep, file_path.c_str());
   if (res == SU_ERROR_SERIALIZATION) {
     throw std::invalid_argument("CW::ImageRep::save_to_file(): Saving file failed. Probably invalid file path given.");
   }
@@ -170,7 +212,7 @@ size_t ImageRep::width() const {
   }
   size_t width;
   size_t height;
-  SUResult res = SUImageRepGetPixelDimensions(m_image_rep, &width, &height);
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepGetPixelDimensions, m_image_rep, &width, &height);
   assert(res == SU_ERROR_NONE); _unused(res);
   return width;
 }
@@ -182,7 +224,7 @@ size_t ImageRep::height() const {
   }
   size_t width;
   size_t height;
-  SUResult res = SUImageRepGetPixelDimensions(m_image_rep, &width, &height);
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepGetPixelDimensions, m_image_rep, &width, &height);
   assert(res == SU_ERROR_NONE); _unused(res);
   return height;
 }
@@ -193,7 +235,7 @@ size_t ImageRep::row_padding() const {
     throw std::logic_error("CW::ImageRep::row_padding(): ImageRep is null");
   }
   size_t padding;
-  SUResult res =  SUImageRepGetRowPadding(m_image_rep, &padding);
+  SUResult res =  CW_INSTRUMENT_SU(SUImageRepGetRowPadding, m_image_rep, &padding);
   assert(res == SU_ERROR_NONE); _unused(res);
   return padding;
 }
@@ -203,7 +245,7 @@ void ImageRep::resize(size_t width, size_t height) {
   if(!(*this)) {
     throw std::logic_error("CW::ImageRep::resize(): ImageRep is null");
   }
-  SUResult res = SUImageRepResize(m_image_rep, width, height);
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepResize, m_image_rep, width, height);
   if (res == SU_ERROR_OUT_OF_RANGE) {
     throw std::invalid_argument("CW::ImageRep::resize(): width and height must be greater than 0.");
   }
@@ -215,7 +257,7 @@ void ImageRep::convert_to_32bits() {
   if(!(*this)) {
     throw std::logic_error("CW::ImageRep::convert_to_32bits(): ImageRep is null");
   }
-  SUResult res = SUImageRepConvertTo32BitsPerPixel(m_image_rep);
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepConvertTo32BitsPerPixel, m_image_rep);
   if (res == SU_ERROR_NO_DATA) {
     throw std::logic_error("CW::ImageRep::convert_to_32bits(): Image contains no data.");
   }
@@ -229,7 +271,7 @@ size_t ImageRep::data_size() const {
   }
   size_t data_size;
   size_t bits_per_pixel;
-  SUResult res = SUImageRepGetDataSize(m_image_rep, &data_size, &bits_per_pixel);
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepGetDataSize, m_image_rep, &data_size, &bits_per_pixel);
   assert(res == SU_ERROR_NONE); _unused(res);
   return data_size;
 }
@@ -241,7 +283,7 @@ size_t ImageRep::bits_per_pixel() const {
   }
   size_t data_size;
   size_t bits_per_pixel;
-  SUResult res = SUImageRepGetDataSize(m_image_rep, &data_size, &bits_per_pixel);
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepGetDataSize, m_image_rep, &data_size, &bits_per_pixel);
   assert(res == SU_ERROR_NONE); _unused(res);
   return bits_per_pixel;
 }
@@ -251,12 +293,48 @@ std::vector<SUByte> ImageRep::pixel_data() const {
   if(!(*this)) {
     throw std::logic_error("CW::ImageRep::pixel_data(): ImageRep is null");
   }
-  std::vector<SUByte> pixel_data;
+  std::vector<SUByte> pixel_data(this->data_size());
+  read_pixels(pixel_data);
+  return pixel_data;
+}
+
+
+void ImageRep::read_pixels(Span<SUByte> pixels) const {
+  if(!(*this)) {
+    throw std::logic_error("CW::ImageRep::read_pixels(): ImageRep is null");
+  }
   size_t data_size = this->data_size();
-  pixel_data.reserve(this->data_size());
-  SUResult res = SUImageRepGetData(m_image_rep, data_size, &pixel_data[0]);
+  if (pixels.size() < data_size) {
+    throw std::invalid_argument("CW::ImageRep::read_pixels(): buffer is smaller than data_size()");
+  }
+  if (data_size == 0) {
+    return;
+  }
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepGetData, m_image_rep, data_size, pixels.data());
+  assert(res == SU_ERROR_NONE); _unused(res);
+}
+
+
+void ImageRep::write_pixels(Span<const SUByte> pixels) {
+  if(!(*this)) {
+    throw std::logic_error("CW::ImageRep::write_pixels(): ImageRep is null");
+  }
+  size_t data_size = 0;
+  size_t bits_per_pixel = 0;
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepGetDataSize, m_image_rep, &data_size, &bits_per_pixel);
+  assert(res == SU_ERROR_NONE);
+  if (pixels.size() < data_size) {
+    throw std::invalid_argument("CW::ImageRep::write_pixels(): buffer is smaller than data_size()");
+  }
+  size_t width = 0;
+  size_t height = 0;
+  res = CW_INSTRUMENT_SU(SUImageRepGetPixelDimensions, m_image_rep, &width, &height);
+  assert(res == SU_ERROR_NONE);
+  size_t row_padding = 0;
+  res = CW_INSTRUMENT_SU(SUImageRepGetRowPadding, m_image_rep, &row_padding);
+  assert(res == SU_ERROR_NONE);
+  res = CW_INSTRUMENT_SU(SUImageRepSetData, m_image_rep, width, height, bits_per_pixel, row_padding, pixels.data());
   assert(res == SU_ERROR_NONE); _unused(res);
-  return pixel_data;
 }
   
 } // END namespace CW
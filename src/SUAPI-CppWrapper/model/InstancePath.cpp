@@ -34,6 +34,8 @@
 #include "SUAPI-CppWrapper/model/Entity.hpp"
 #include "SUAPI-CppWrapper/Transformation.hpp"
 #include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 #include <cassert>
 
@@ -41,7 +43,7 @@ namespace CW {
 
 SUInstancePathRef InstancePath::create_instance_path() {
   SUInstancePathRef instance_path_ref = SU_INVALID;
-  SUResult res = SUInstancePathCreate(&instance_path_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathCreate, &instance_path_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return instance_path_ref;
 }
@@ -49,7 +51,7 @@ SUInstancePathRef InstancePath::create_instance_path() {
 
 SUInstancePathRef InstancePath::copy_reference(const InstancePath& other) {
   SUInstancePathRef instance_path_ref = SU_INVALID;
-  SUResult res = SUInstancePathCreateCopy(&instance_path_ref, other.ref());
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathCreateCopy, &instance_path_ref, other.ref());
   assert(res == SU_ERROR_NONE); _unused(res);
   return instance_path_ref;
 }
@@ -57,12 +59,18 @@ SUInstancePathRef InstancePath::copy_reference(const InstancePath& other) {
 
 InstancePath::InstancePath():
   m_instance_path(create_instance_path())
-{}
+{
+  RefTracker::acquired(RefKind::InstancePath, m_instance_path.ptr);
+}
 
 
 InstancePath::InstancePath(SUInstancePathRef instance_path):
   m_instance_path(instance_path)
-{}
+{
+  if (SUIsValid(m_instance_path)) {
+    RefTracker::acquired(RefKind::InstancePath, m_instance_path.ptr);
+  }
+}
 
 
 InstancePath::InstancePath(const InstancePath& other):
@@ -70,16 +78,49 @@ InstancePath::InstancePath(const InstancePath& other):
 {}
 
 
+InstancePath::InstancePath(InstancePath&& other) noexcept:
+  m_instance_path(other.m_instance_path)
+{
+  other.m_instance_path = SU_INVALID;
+}
+
+
 InstancePath::~InstancePath() {
-  SUResult res = SUInstancePathRelease(&m_instance_path);
-  assert(res == SU_ERROR_NONE); _unused(res);
+  // Moved from objects hold no instance path.
+  if (SUIsValid(m_instance_path)) {
+    RefTracker::released(RefKind::InstancePath, m_instance_path.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUInstancePathRelease, &m_instance_path);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
 }
 
 
 InstancePath& InstancePath::operator=(const InstancePath& other) {
-  SUResult res = SUInstancePathRelease(&m_instance_path);
-  assert(res == SU_ERROR_NONE); _unused(res);
+  if (this == &other) {
+    return *this;
+  }
+  if (SUIsValid(m_instance_path)) {
+    RefTracker::released(RefKind::InstancePath, m_instance_path.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUInstancePathRelease, &m_instance_path);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
   m_instance_path = copy_reference(other);
+  RefTracker::acquired(RefKind::InstancePath, m_instance_path.ptr);
+  return *this;
+}
+
+
+InstancePath& InstancePath::operator=(InstancePath&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (SUIsValid(m_instance_path)) {
+    RefTracker::released(RefKind::InstancePath, m_instance_path.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUInstancePathRelease, &m_instance_path);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  m_instance_path = other.m_instance_path;
+  other.m_instance_path = SU_INVALID;
   return *this;
 }
 
@@ -100,21 +141,21 @@ InstancePath::operator SUInstancePathRef*() {
 
 
 InstancePath& InstancePath::push(const ComponentInstance& instance) {
-  SUResult res = SUInstancePathPushInstance(m_instance_path, instance.ref());
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathPushInstance, m_instance_path, instance.ref());
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
 
 
 InstancePath& InstancePath::pop() {
-  SUResult res = SUInstancePathPopInstance(m_instance_path);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathPopInstance, m_instance_path);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
 
 
 InstancePath& InstancePath::set_leaf(const Entity& entity) {
-  SUResult res = SUInstancePathSetLeaf(m_instance_path, entity.ref());
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathSetLeaf, m_instance_path, entity.ref());
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -122,7 +163,7 @@ InstancePath& InstancePath::set_leaf(const Entity& entity) {
 
 size_t InstancePath::depth() const {
   size_t depth = 0;
-  SUResult res = SUInstancePathGetPathDepth(m_instance_path, &depth);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathGetPathDepth, m_instance_path, &depth);
   assert(res == SU_ERROR_NONE); _unused(res);
   return depth;
 }
@@ -130,7 +171,7 @@ size_t InstancePath::depth() const {
 
 size_t InstancePath::full_depth() const {
   size_t depth = 0;
-  SUResult res = SUInstancePathGetFullDepth(m_instance_path, &depth);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathGetFullDepth, m_instance_path, &depth);
   assert(res == SU_ERROR_NONE); _unused(res);
   return depth;
 }
@@ -138,7 +179,7 @@ size_t InstancePath::full_depth() const {
 
 Transformation InstancePath::total_transformation() const {
   SUTransformation transform;
-  SUResult res = SUInstancePathGetTransform(m_instance_path, &transform);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathGetTransform, m_instance_path, &transform);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Transformation(transform);
 }
@@ -146,7 +187,7 @@ Transformation InstancePath::total_transformation() const {
 
 Transformation InstancePath::transformation_at_depth(size_t depth) const {
   SUTransformation transform;
-  SUResult res = SUInstancePathGetTransformAtDepth(m_instance_path, depth, &transform);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathGetTransformAtDepth, m_instance_path, depth, &transform);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Transformation(transform);
 }
@@ -155,7 +196,7 @@ Transformation InstancePath::transformation_at_depth(size_t depth) const {
 ComponentInstance InstancePath::instance_at_depth(size_t depth) const {
   assert(this->valid());
   SUComponentInstanceRef instance = SU_INVALID;
-  SUResult res = SUInstancePathGetInstanceAtDepth(m_instance_path, depth, &instance);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathGetInstanceAtDepth, m_instance_path, depth, &instance);
   assert(res == SU_ERROR_NONE); _unused(res);
   return ComponentInstance(instance);
 }
@@ -163,7 +204,7 @@ ComponentInstance InstancePath::instance_at_depth(size_t depth) const {
 
 Entity InstancePath::leaf_entity() const {
   SUEntityRef entity = SU_INVALID;
-  SUResult res = SUInstancePathGetLeafAsEntity(m_instance_path, &entity);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathGetLeafAsEntity, m_instance_path, &entity);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Entity(entity);
 }
@@ -171,7 +212,7 @@ Entity InstancePath::leaf_entity() const {
 
 DrawingElement InstancePath::leaf() const {
   SUDrawingElementRef element = SU_INVALID;
-  SUResult res = SUInstancePathGetLeaf(m_instance_path, &element);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathGetLeaf, m_instance_path, &element);
   assert(res == SU_ERROR_NONE); _unused(res);
   return DrawingElement(element);
 }
@@ -179,7 +220,7 @@ DrawingElement InstancePath::leaf() const {
 
 bool InstancePath::valid() const {
   bool valid;
-  SUResult res = SUInstancePathIsValid(m_instance_path, &valid);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathIsValid, m_instance_path, &valid);
   assert(res == SU_ERROR_NONE); _unused(res);
   return valid;
 }
@@ -187,7 +228,7 @@ bool InstancePath::valid() const {
 
 bool InstancePath::empty() const {
   bool empty;
-  SUResult res = SUInstancePathIsEmpty(m_instance_path, &empty);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathIsEmpty, m_instance_path, &empty);
   assert(res == SU_ERROR_NONE); _unused(res);
   return empty;
 }
@@ -195,7 +236,7 @@ bool InstancePath::empty() const {
 
 bool InstancePath::contains(const Entity& entity) const {
   bool contains;
-  SUResult res = SUInstancePathContains(m_instance_path, entity.ref(), &contains);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathContains, m_instance_path, entity.ref(), &contains);
   assert(res == SU_ERROR_NONE); _unused(res);
   return contains;
 }
@@ -203,9 +244,9 @@ bool InstancePath::contains(const Entity& entity) const {
 
 String InstancePath::persistent_id() const {
   SUStringRef pid = SU_INVALID;
-  SUResult res = SUStringCreate(&pid);
+  SUResult res = CW_INSTRUMENT_SU(SUStringCreate, &pid);
   assert(res == SU_ERROR_NONE);
-  res = SUInstancePathGetPersistentID(m_instance_path, &pid);
+  res = CW_INSTRUMENT_SU(SUInstancePathGetPersistentID, m_instance_path, &pid);
   assert(res == SU_ERROR_NONE); _unused(res);
   return String(pid);
 }
@@ -213,9 +254,9 @@ String InstancePath::persistent_id() const {
 
 String InstancePath::persistent_id_at_depth(size_t depth) const {
   SUStringRef pid = SU_INVALID;
-  SUResult res = SUStringCreate(&pid);
+  SUResult res = CW_INSTRUMENT_SU(SUStringCreate, &pid);
   assert(res == SU_ERROR_NONE);
-  res = SUInstancePathGetPersistentIDAtDepth(m_instance_path, depth, &pid);
+  res = CW_INSTRUMENT_SU(SUInstancePathGetPersistentIDAtDepth, m_instance_path, depth, &pid);
   assert(res == SU_ERROR_NONE); _unused(res);
   return String(pid);
 }
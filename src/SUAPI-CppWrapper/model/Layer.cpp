@@ -34,6 +34,8 @@
 #include <stdexcept>
 
 #include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/ModelRegistry.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 
 namespace CW {
@@ -42,7 +44,7 @@ namespace CW {
 ****************************/
 SULayerRef Layer::create_layer() {
   SULayerRef layer = SU_INVALID;
-  SUResult res = SULayerCreate(&layer);
+  SUResult res = CW_INSTRUMENT_SU(SULayerCreate, &layer);
   assert(res == SU_ERROR_NONE); _unused(res);
   return layer;
 }
@@ -78,10 +80,16 @@ Layer::Layer(const Layer& other):
 }
 
 
+Layer::Layer(Layer&& other) noexcept:
+  Entity(std::move(other))
+{}
+
+
 Layer::~Layer() {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SULayerRef layer = this->ref();
-    SUResult res = SULayerRelease(&layer);
+    SUResult res = CW_INSTRUMENT_SU(SULayerRelease, &layer);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
@@ -92,8 +100,9 @@ Layer::~Layer() {
 ********************/
 Layer& Layer::operator=(const Layer& other) {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SULayerRef layer = this->ref();
-    SUResult res = SULayerRelease(&layer);
+    SUResult res = CW_INSTRUMENT_SU(SULayerRelease, &layer);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
   m_entity = SULayerToEntity(copy_reference(other));
@@ -106,6 +115,21 @@ Layer& Layer::operator=(const Layer& other) {
 }
 
 
+Layer& Layer::operator=(Layer&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
+    SULayerRef layer = this->ref();
+    SUResult res = CW_INSTRUMENT_SU(SULayerRelease, &layer);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  Entity::operator=(std::move(other));
+  return *this;
+}
+
+
 SULayerRef Layer::ref() const {
   return SULayerFromEntity(m_entity);
 }
@@ -120,7 +144,7 @@ bool Layer::operator!() const {
     return true;
   }
   String name;
-  SUResult res = SULayerGetName(this->ref(), name);
+  SUResult res = CW_INSTRUMENT_SU(SULayerGetName, this->ref(), name);
   if (res == SU_ERROR_NULL_POINTER_OUTPUT) {
     return true;
   }
@@ -143,7 +167,7 @@ String Layer::name() const {
     throw std::logic_error("CW::Layer::name(): Layer is null");
   }
   String string;
-  SUResult res = SULayerGetName(this->ref(), string);
+  SUResult res = CW_INSTRUMENT_SU(SULayerGetName, this->ref(), string);
   assert(res == SU_ERROR_NONE); _unused(res);
   return string;
 }
@@ -153,8 +177,9 @@ void Layer::name(const String& string) {
   if(!(*this)) {
     throw std::logic_error("CW::Layer::name(): Layer is null");
   }
-  SUResult res = SULayerSetName(this->ref(), string.std_string().c_str());
+  SUResult res = CW_INSTRUMENT_SU(SULayerSetName, this->ref(), string.std_string().c_str());
   assert(res == SU_ERROR_NONE); _unused(res);
+  ModelRegistry::names_changed();
 }
 
 
@@ -162,8 +187,9 @@ void Layer::name(const std::string& string) {
   if(!(*this)) {
     throw std::logic_error("CW::Layer::name(): Layer is null");
   }
-  SUResult res = SULayerSetName(this->ref(), string.c_str());
+  SUResult res = CW_INSTRUMENT_SU(SULayerSetName, this->ref(), string.c_str());
   assert(res == SU_ERROR_NONE); _unused(res);
+  ModelRegistry::names_changed();
 }
 
 
@@ -35,6 +35,7 @@
 #include "SUAPI-CppWrapper/model/Edge.hpp"
 #include "SUAPI-CppWrapper/model/Material.hpp"
 #include "SUAPI-CppWrapper/model/Layer.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 #include <cassert>
 #include <stdexcept>
@@ -71,6 +72,7 @@ SULoopRef Loop::ref() const {
 
 
 LoopInput Loop::loop_input() const {
+  CW_INSTRUMENT_METHOD("CW::Loop::loop_input");
   if(!(*this)) {
     throw std::logic_error("CW::Loop::loop_input(): Loop is null");
   }
@@ -91,54 +93,86 @@ LoopInput Loop::loop_input() const {
 
 
 std::vector<Edge> Loop::edges() const {
+  std::vector<Edge> edges;
+  this->edges(edges);
+  return edges;
+}
+
+
+void Loop::edges(std::vector<Edge>& edges) const {
+  CW_INSTRUMENT_METHOD("CW::Loop::edges");
   if(!(*this)) {
     throw std::logic_error("CW::Loop::edges(): Loop is null");
   }
   size_t count = 0;
-  SUResult res = SULoopGetNumVertices(this->ref(), &count);
+  SUResult res = CW_INSTRUMENT_SU(SULoopGetNumVertices, this->ref(), &count);
   assert(res == SU_ERROR_NONE);
-  std::vector<SUEdgeRef> edge_refs(count, SU_INVALID);
-  res = SULoopGetEdges(this->ref(), count, edge_refs.data(), &count);
+  edges.clear();
+  thread_local std::vector<SUEdgeRef> edge_refs;
+  edge_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SULoopGetEdges, this->ref(), count, edge_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<Edge> edges(count);
-  std::transform(edge_refs.begin(), edge_refs.end(), edges.begin(),
-    [](const SUEdgeRef& value){
-      return Edge(value);
-    });
-  return edges;
+  edges.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    edges.emplace_back(edge_refs[i]);
+  }
 }
 
 
 std::vector<Vertex> Loop::vertices() const {
+  std::vector<Vertex> vertices;
+  this->vertices(vertices);
+  return vertices;
+}
+
+
+void Loop::vertices(std::vector<Vertex>& vertices) const {
+  CW_INSTRUMENT_METHOD("CW::Loop::vertices");
   if(!(*this)) {
     throw std::logic_error("CW::Loop::vertices(): Loop is null");
   }
   size_t count = 0;
-  SUResult res = SULoopGetNumVertices(this->ref(), &count);
+  SUResult res = CW_INSTRUMENT_SU(SULoopGetNumVertices, this->ref(), &count);
   assert(res == SU_ERROR_NONE);
-  std::vector<SUVertexRef> verts_array(count, SU_INVALID);
-  res = SULoopGetVertices(this->ref(), count, verts_array.data(), &count);
+  vertices.clear();
+  thread_local std::vector<SUVertexRef> vertex_refs;
+  vertex_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SULoopGetVertices, this->ref(), count, vertex_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<Vertex> vertices(count);
-  std::transform(verts_array.begin(), verts_array.end(), vertices.begin(),
-    [](const SUVertexRef& value){
-      return Vertex(value);
-    });
-  return vertices;
+  vertices.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    vertices.emplace_back(vertex_refs[i]);
+  }
 }
 
 
 std::vector<Point3D> Loop::points() const {
+  std::vector<Point3D> points;
+  this->points(points);
+  return points;
+}
+
+
+void Loop::points(std::vector<Point3D>& points) const {
+  CW_INSTRUMENT_METHOD("CW::Loop::points");
   if(!(*this)) {
     throw std::logic_error("CW::Loop::points(): Loop is null");
   }
-  std::vector<Vertex> verts = vertices();
-  std::vector<Point3D> points;
-  points.reserve(verts.size());
-  for (size_t i=0; i < verts.size(); ++i) {
-    points.push_back(verts[i].position());
+  size_t count = 0;
+  SUResult res = CW_INSTRUMENT_SU(SULoopGetNumVertices, this->ref(), &count);
+  assert(res == SU_ERROR_NONE);
+  // The positions are read straight from the vertex references, without creating Vertex objects.
+  thread_local std::vector<SUVertexRef> vertex_refs;
+  vertex_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SULoopGetVertices, this->ref(), count, vertex_refs.data(), &count);
+  assert(res == SU_ERROR_NONE);
+  points.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    SUPoint3D position;
+    res = CW_INSTRUMENT_SU(SUVertexGetPosition, vertex_refs[i], &position);
+    assert(res == SU_ERROR_NONE); _unused(res);
+    points[i] = Point3D(position);
   }
-  return points;
 }
 
 
@@ -158,7 +192,7 @@ size_t Loop::size() const {
     throw std::logic_error("CW::Loop::size(): Loop is null");
   }
   size_t count = 0;
-  SUResult res = SULoopGetNumVertices(this->ref(), &count);
+  SUResult res = CW_INSTRUMENT_SU(SULoopGetNumVertices, this->ref(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
   return count;
 }
@@ -263,7 +297,7 @@ PointLoopClassify Loop::classify_point(const std::vector<Point3D>& loop_points,
 
 bool Loop::is_outer_loop() const {
   bool is_outer;
-  SUResult res = SULoopIsOuterLoop(this->ref(), &is_outer);
+  SUResult res = CW_INSTRUMENT_SU(SULoopIsOuterLoop, this->ref(), &is_outer);
   assert(res == SU_ERROR_NONE); _unused(res);
   return is_outer;
 }
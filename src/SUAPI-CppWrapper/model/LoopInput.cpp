@@ -39,12 +39,15 @@
 #include "SUAPI-CppWrapper/model/GeometryInput.hpp"
 #include "SUAPI-CppWrapper/model/Material.hpp"
 #include "SUAPI-CppWrapper/model/Layer.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 
 SULoopInputRef LoopInput::create_loop_input_ref() {
   SULoopInputRef loop_input = SU_INVALID;
-  SULoopInputCreate(&loop_input);
+  CW_INSTRUMENT_SU(SULoopInputCreate, &loop_input);
+  RefTracker::acquired(RefKind::LoopInput, loop_input.ptr);
   return loop_input;
 }
 
@@ -52,14 +55,19 @@ SULoopInputRef LoopInput::create_loop_input_ref() {
 ** Constructors / Destructor **
 *******************************/
 LoopInput::LoopInput():
-  m_loop_input(create_loop_input_ref())
+  m_loop_input(create_loop_input_ref()),
+  m_attached(false)
 {}
 
 
 LoopInput::LoopInput(SULoopInputRef loop_input, bool attached):
   m_loop_input(loop_input),
   m_attached(attached)
-{}
+{
+  if (!m_attached && SUIsValid(m_loop_input)) {
+    RefTracker::acquired(RefKind::LoopInput, m_loop_input.ptr);
+  }
+}
 
 /*
 LoopInput::LoopInput(std::vector<Edge> loop_edges,  size_t vertex_index):
@@ -109,7 +117,8 @@ LoopInput::LoopInput(const std::vector<InputEdgeProperties>& loop_edge_propertie
 
 
 LoopInput::LoopInput(const LoopInput& other):
-  m_loop_input(create_loop_input_ref())
+  m_loop_input(create_loop_input_ref()),
+  m_attached(false)
 {
   // LoopInputRef cannot be copied across at this stage. If it is important, something can be done.
   assert(false);
@@ -117,7 +126,8 @@ LoopInput::LoopInput(const LoopInput& other):
 
 LoopInput::~LoopInput() {
   if (!m_attached && SUIsValid(m_loop_input)) {
-    SUResult res = SULoopInputRelease(&m_loop_input);
+    RefTracker::released(RefKind::LoopInput, m_loop_input.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SULoopInputRelease, &m_loop_input);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
@@ -167,7 +177,7 @@ LoopInput& LoopInput::add_vertex_index(const size_t index) {
   if(!(*this)) {
     throw std::logic_error("CW::LoopInput::add_vertex_index(): LoopInput is null");
   }
-  SUResult res = SULoopInputAddVertexIndex(m_loop_input, index);
+  SUResult res = CW_INSTRUMENT_SU(SULoopInputAddVertexIndex, m_loop_input, index);
   assert(res == SU_ERROR_NONE); _unused(res);
   m_edge_num++;
   return (*this);
@@ -178,7 +188,7 @@ LoopInput& LoopInput::set_edge_hidden(const size_t edge_index, const bool hidden
   if(!(*this)) {
     throw std::logic_error("CW::LoopInput::set_edge_hidden(): LoopInput is null");
   }
-  SUResult res = SULoopInputEdgeSetHidden(m_loop_input, edge_index, hidden);
+  SUResult res = CW_INSTRUMENT_SU(SULoopInputEdgeSetHidden, m_loop_input, edge_index, hidden);
   if(res == SU_ERROR_OUT_OF_RANGE) {
     throw std::invalid_argument("CW::LoopInput::set_edge_hidden(): edge_index is larger than the number of vertices in the LoopInput");
   }
@@ -190,7 +200,7 @@ LoopInput& LoopInput::set_edge_soft(const size_t edge_index, const bool soft) {
   if(!(*this)) {
     throw std::logic_error("CW::LoopInput::set_edge_soft(): LoopInput is null");
   }
-  SUResult res = SULoopInputEdgeSetSoft(m_loop_input, edge_index, soft);
+  SUResult res = CW_INSTRUMENT_SU(SULoopInputEdgeSetSoft, m_loop_input, edge_index, soft);
   if(res == SU_ERROR_OUT_OF_RANGE) {
     throw std::invalid_argument("CW::LoopInput::set_edge_soft(): edge_index is larger than the number of vertices in the LoopInput");
   }
@@ -202,7 +212,7 @@ LoopInput& LoopInput::set_edge_smooth(const size_t edge_index, const bool smooth
   if(!(*this)) {
     throw std::logic_error("CW::LoopInput::set_edge_smooth(): LoopInput is null");
   }
-  SUResult res = SULoopInputEdgeSetSoft(m_loop_input, edge_index, smooth);
+  SUResult res = CW_INSTRUMENT_SU(SULoopInputEdgeSetSoft, m_loop_input, edge_index, smooth);
   if(res == SU_ERROR_OUT_OF_RANGE) {
     throw std::invalid_argument("CW::LoopInput::set_edge_smooth(): edge_index is larger than the number of vertices in the LoopInput");
   }
@@ -214,7 +224,7 @@ LoopInput& LoopInput::set_edge_material(const size_t edge_index, const Material&
   if(!(*this)) {
     throw std::logic_error("CW::LoopInput::set_edge_material(): LoopInput is null");
   }
-  SUResult res = SULoopInputEdgeSetMaterial(m_loop_input, edge_index, material.ref());
+  SUResult res = CW_INSTRUMENT_SU(SULoopInputEdgeSetMaterial, m_loop_input, edge_index, material.ref());
   if(res == SU_ERROR_OUT_OF_RANGE) {
     throw std::invalid_argument("CW::LoopInput::set_edge_material(): edge_index is larger than the number of vertices in the LoopInput");
   }
@@ -225,7 +235,7 @@ LoopInput& LoopInput::set_edge_layer(const size_t edge_index, const Layer& layer
   if(!(*this)) {
     throw std::logic_error("CW::LoopInput::set_edge_layer(): LoopInput is null");
   }
-  SUResult res = SULoopInputEdgeSetLayer(m_loop_input, edge_index, layer.ref());
+  SUResult res = CW_INSTRUMENT_SU(SULoopInputEdgeSetLayer, m_loop_input, edge_index, layer.ref());
   if(res == SU_ERROR_OUT_OF_RANGE) {
     throw std::invalid_argument("CW::LoopInput::set_edge_layer(): edge_index is larger than the number of vertices in the LoopInput");
   }
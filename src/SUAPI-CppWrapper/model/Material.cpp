@@ -36,6 +36,9 @@
 #include "SUAPI-CppWrapper/String.hpp"
 #include "SUAPI-CppWrapper/Color.hpp"
 #include "SUAPI-CppWrapper/model/Texture.hpp"
+#include "SUAPI-CppWrapper/model/ModelRegistry.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 
@@ -45,7 +48,7 @@ namespace CW {
 
 SUMaterialRef Material::create_material() {
   SUMaterialRef material = SU_INVALID;
-  SUResult res = SUMaterialCreate(&material);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialCreate, &material);
   assert(res == SU_ERROR_NONE); _unused(res);
   return material;
 }
@@ -85,10 +88,16 @@ Material::Material(const Material& other):
 }
 
 
+Material::Material(Material&& other) noexcept:
+  Entity(std::move(other))
+{}
+
+
 Material& Material::operator=(const Material& other) {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUMaterialRef material = this->ref();
-    SUResult res = SUMaterialRelease(&material);
+    SUResult res = CW_INSTRUMENT_SU(SUMaterialRelease, &material);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
   m_entity = SUMaterialToEntity(copy_reference(other));
@@ -106,10 +115,26 @@ Material& Material::operator=(const Material& other) {
 }
 
 
+Material& Material::operator=(Material&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
+    SUMaterialRef material = this->ref();
+    SUResult res = CW_INSTRUMENT_SU(SUMaterialRelease, &material);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  Entity::operator=(std::move(other));
+  return *this;
+}
+
+
 Material::~Material() {
   if (!m_attached && SUIsValid(m_entity)) {
+    track_released();
     SUMaterialRef material = this->ref();
-    SUResult res = SUMaterialRelease(&material);
+    SUResult res = CW_INSTRUMENT_SU(SUMaterialRelease, &material);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
@@ -151,7 +176,7 @@ Color Material::color() const {
     return Color();
   }
   SUColor new_color = SU_INVALID;
-  SUResult res =  SUMaterialGetColor(this->ref(), &new_color);
+  SUResult res =  CW_INSTRUMENT_SU(SUMaterialGetColor, this->ref(), &new_color);
   if (res == SU_ERROR_NONE) {
     return Color(new_color);
   }
@@ -164,7 +189,7 @@ void Material::color(const Color& color) {
     throw std::logic_error("CW::Material::color(): Material is null");
   }
   SUColor set_color = color.ref();
-  SUResult res = SUMaterialSetColor(this->ref(), &set_color);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialSetColor, this->ref(), &set_color);
   assert(res != SU_ERROR_INVALID_INPUT); _unused(res);
 }
 
@@ -174,9 +199,9 @@ String Material::name() const {
     return String();
   }
   SUStringRef name_ref = SU_INVALID;
-  SUResult res = SUStringCreate(&name_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUStringCreate, &name_ref);
   assert(res == SU_ERROR_NONE);
-  res = SUMaterialGetName(this->ref(), &name_ref);
+  res = CW_INSTRUMENT_SU(SUMaterialGetName, this->ref(), &name_ref);
   assert(res != SU_ERROR_INVALID_OUTPUT);
   if (res == SU_ERROR_NONE) {
     return String(name_ref);
@@ -193,9 +218,9 @@ String Material::display_name() const {
     return String();
   }
   SUStringRef name_ref = SU_INVALID;
-  SUResult res = SUStringCreate(&name_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUStringCreate, &name_ref);
   assert(res == SU_ERROR_NONE);
-  res = SUMaterialGetNameLegacyBehavior(this->ref(), &name_ref);
+  res = CW_INSTRUMENT_SU(SUMaterialGetNameLegacyBehavior, this->ref(), &name_ref);
   assert(res != SU_ERROR_INVALID_OUTPUT);
   if (res == SU_ERROR_NONE) {
     return String(name_ref);
@@ -210,8 +235,9 @@ void Material::name(const String& string) {
     throw std::logic_error("CW::Material::name(): Material is null");
   }
   const char *cstr = string.std_string().c_str();
-  SUResult res = SUMaterialSetName(this->ref(), cstr);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialSetName, this->ref(), cstr);
   assert(res == SU_ERROR_NONE); _unused(res);
+  ModelRegistry::names_changed();
   return;
 }
 
@@ -221,7 +247,7 @@ double Material::opacity() const {
     throw std::logic_error("CW::Material::opacity(): Material is null");
   }
   double alpha;
-  SUResult res = SUMaterialGetOpacity(this->ref(), &alpha);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialGetOpacity, this->ref(), &alpha);
   if (res == SU_ERROR_NONE) {
     return alpha;
   }
@@ -240,7 +266,7 @@ void Material::opacity(const double alpha) {
   else if (alpha < 0.0) {
     input_alpha = 0.0;
   }
-  SUResult res = SUMaterialSetOpacity(this->ref(), input_alpha);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialSetOpacity, this->ref(), input_alpha);
   assert(res != SU_ERROR_OUT_OF_RANGE); _unused(res);
 }
   
@@ -250,7 +276,7 @@ Texture Material::texture() const {
     throw std::logic_error("CW::Material::TEXTURE(): Material is null");
   }
   SUTextureRef get_texture = SU_INVALID;
-  SUResult res = SUMaterialGetTexture(this->ref(), &get_texture);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialGetTexture, this->ref(), &get_texture);
   if (res != SU_ERROR_NONE) {
     return Texture();
   }
@@ -270,8 +296,10 @@ void Material::texture(const Texture& texture) {
     return this->texture(texture.copy());
   }
   SUTextureRef texture_ref = texture.ref();
-  SUResult res = SUMaterialSetTexture(this->ref(), texture_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialSetTexture, this->ref(), texture_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
+  // The material takes over the texture.
+  RefTracker::released(RefKind::Texture, texture_ref.ptr);
 }
   
   
@@ -280,7 +308,7 @@ SUMaterialType Material::type() const {
     throw std::logic_error("CW::Material::type(): Material is null");
   }
   SUMaterialType mat_type;
-  SUResult res = SUMaterialGetType(this->ref(), &mat_type);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialGetType, this->ref(), &mat_type);
   assert(res == SU_ERROR_NONE); _unused(res);
   return mat_type;
 }
@@ -290,7 +318,7 @@ void Material::type(const SUMaterialType& material_type) {
   if(!(*this)) {
     throw std::logic_error("CW::Material::type(): Material is null");
   }
-  SUResult res = SUMaterialSetType(this->ref(), material_type);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialSetType, this->ref(), material_type);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -300,7 +328,7 @@ bool Material::use_alpha() const {
     throw std::logic_error("CW::Material::use_alpha(): Material is null");
   }
   bool flag;
-  SUResult res = SUMaterialGetUseOpacity(this->ref(), &flag);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialGetUseOpacity, this->ref(), &flag);
   assert(res == SU_ERROR_NONE); _unused(res);
   return flag;
 }
@@ -311,7 +339,7 @@ void Material::use_alpha(bool flag) {
     throw std::logic_error("CW::Material::use_alpha(): Material is null");
   }
   assert(!!(*this));
-  SUResult res = SUMaterialSetUseOpacity(this->ref(), flag);
+  SUResult res = CW_INSTRUMENT_SU(SUMaterialSetUseOpacity, this->ref(), flag);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
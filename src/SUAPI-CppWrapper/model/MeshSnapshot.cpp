@@ -0,0 +1,59 @@
+//
+//  MeshSnapshot.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "SUAPI-CppWrapper/model/MeshSnapshot.hpp"
+
+namespace CW {
+
+constexpr uint32_t MeshSnapshot::NO_ID;
+
+size_t MeshSnapshot::num_faces() const {
+  return faces.size();
+}
+
+
+size_t MeshSnapshot::num_loops() const {
+  if (loop_offsets.empty()) {
+    return 0;
+  }
+  return loop_offsets.size() - 1;
+}
+
+
+void MeshSnapshot::clear() {
+  positions.clear();
+  loop_offsets.clear();
+  face_loop_offsets.clear();
+  faces.clear();
+  front_material_ids.clear();
+  back_material_ids.clear();
+  layer_ids.clear();
+  materials.clear();
+  layers.clear();
+}
+
+} /* namespace CW */
@@ -38,13 +38,18 @@
 //#include "SUAPI-CppWrapper/Behavior.hpp"
 //#include "SUAPI-CppWrapper/model/Classifications.hpp"
 #include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/model/FaceBVH.hpp"
+#include "SUAPI-CppWrapper/model/FrozenModel.hpp"
 #include "SUAPI-CppWrapper/model/InstancePath.hpp"
 #include "SUAPI-CppWrapper/model/Material.hpp"
+#include "SUAPI-CppWrapper/model/ModelRegistry.hpp"
 #include "SUAPI-CppWrapper/model/AttributeDictionary.hpp"
 #include "SUAPI-CppWrapper/model/TypedValue.hpp"
 #include "SUAPI-CppWrapper/model/OptionsManager.hpp"
 #include "SUAPI-CppWrapper/model/RenderingOptions.hpp"
 #include "SUAPI-CppWrapper/model/ShadowInfo.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
 
 
 namespace CW {
@@ -52,8 +57,9 @@ namespace CW {
 
 SUModelRef Model::create_model() {
   SUModelRef model = SU_INVALID;
-  SUResult res = SUModelCreate(&model);
+  SUResult res = CW_INSTRUMENT_SU(SUModelCreate, &model);
   assert(res == SU_ERROR_NONE); _unused(res);
+  RefTracker::acquired(RefKind::Model, model.ptr);
   return model;
 }
 
@@ -67,13 +73,21 @@ Model::Model():
 Model::Model(SUModelRef model_ref, bool release_on_destroy):
   m_model(model_ref),
   m_release_on_destroy(release_on_destroy)
-{}
+{
+  if (m_release_on_destroy && SUIsValid(m_model)) {
+    RefTracker::acquired(RefKind::Model, m_model.ptr);
+  }
+}
 
 Model::Model(std::string file_path):
   m_model(SU_INVALID),
   m_release_on_destroy(true),
-  m_result(SUModelCreateFromFile(&m_model, file_path.c_str()))
-{}
+  m_result(CW_INSTRUMENT_SU(SUModelCreateFromFile, &m_model, file_path.c_str()))
+{
+  if (SUIsValid(m_model)) {
+    RefTracker::acquired(RefKind::Model, m_model.ptr);
+  }
+}
 
 Model::Model(const Model& other):
   m_model(other.m_model),
@@ -82,7 +96,9 @@ Model::Model(const Model& other):
 
 Model::~Model() {
   if (m_release_on_destroy && SUIsValid(m_model)) {
-    SUResult res = SUModelRelease(&m_model);
+    ModelRegistry::release(m_model);
+    RefTracker::released(RefKind::Model, m_model.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUModelRelease, &m_model);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
@@ -118,7 +134,7 @@ bool Model::operator!() const {
 std::string Model::version_string() const
 {
   int major = 0, minor = 0, build = 0;
-  SUResult res = SUModelGetVersion(m_model, &major, &minor, &build);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetVersion, m_model, &major, &minor, &build);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::string version = std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(build);
   return version;
@@ -130,7 +146,7 @@ Layer Model::active_layer() const {
     throw std::logic_error("CW::Model::active_layer(): Model is null");
   }
   SULayerRef layer = SU_INVALID;
-  SUResult res = SUModelGetDefaultLayer(m_model, &layer);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetDefaultLayer, m_model, &layer);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Layer(layer);
 }
@@ -163,7 +179,8 @@ bool Model::add_definitions(std::vector<ComponentDefinition>& definitions) {
       return definition.ref();
     }
   );
-  SUResult res = SUModelAddComponentDefinitions(m_model, definitions.size(), defs.data());
+  SUResult res = CW_INSTRUMENT_SU(SUModelAddComponentDefinitions, m_model, definitions.size(), defs.data());
+  registry()->invalidate_definitions();
   if (res == SU_ERROR_NONE) {
     return true;
   }
@@ -176,10 +193,10 @@ std::vector<AttributeDictionary>  Model::attribute_dictionaries() const {
     throw std::logic_error("CW::Model::attribute_dictionaries(): Model is null");
   }
   size_t count = 0;
-  SUResult res = SUModelGetNumAttributeDictionaries(m_model, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetNumAttributeDictionaries, m_model, &count);
   assert(res == SU_ERROR_NONE);
   std::vector<SUAttributeDictionaryRef> dict_refs(count, SU_INVALID);
-  res = SUModelGetAttributeDictionaries(m_model, count, dict_refs.data(), &count);
+  res = CW_INSTRUMENT_SU(SUModelGetAttributeDictionaries, m_model, count, dict_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::vector<AttributeDictionary> dicts(count);
   std::transform(dict_refs.begin(), dict_refs.end(), dicts.begin(),
@@ -195,7 +212,7 @@ AttributeDictionary Model::attribute_dictionary(const std::string& dict_name) co
     throw std::logic_error("CW::Model::attribute_dictionary(): Model is null");
   }
   SUAttributeDictionaryRef dict = SU_INVALID;
-  SUResult res = SUModelGetAttributeDictionary(m_model, dict_name.c_str(), &dict);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetAttributeDictionary, m_model, dict_name.c_str(), &dict);
   assert(res == SU_ERROR_NONE); _unused(res);
   return AttributeDictionary(dict);
 }
@@ -207,7 +224,7 @@ Axes Model::axes() const {
     throw std::logic_error("CW::Model::axes(): Model is null");
   }
   SUAxesRef axes = SU_INVALID;
-  SUResult res = SUModelGetAxes(m_model, &axes);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetAxes, m_model, &axes);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Axes(axes);
 }
@@ -236,21 +253,29 @@ Classifications Model::classifications() const {
 
 
 std::vector<ComponentDefinition> Model::definitions() const {
+  std::vector<ComponentDefinition> defs;
+  this->definitions(defs);
+  return defs;
+}
+
+
+void Model::definitions(std::vector<ComponentDefinition>& definitions) const {
+  CW_INSTRUMENT_METHOD("CW::Model::definitions");
   if(!(*this)) {
     throw std::logic_error("CW::Model::definitions(): Model is null");
   }
   size_t count = 0;
-  SUResult res = SUModelGetNumComponentDefinitions(m_model, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetNumComponentDefinitions, m_model, &count);
   assert(res == SU_ERROR_NONE);
-  std::vector<SUComponentDefinitionRef> def_refs(count, SU_INVALID);
-  res = SUModelGetComponentDefinitions(m_model, count, def_refs.data(), &count);
+  definitions.clear();
+  thread_local std::vector<SUComponentDefinitionRef> def_refs;
+  def_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SUModelGetComponentDefinitions, m_model, count, def_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<ComponentDefinition> defs(count);
-  std::transform(def_refs.begin(), def_refs.end(), defs.begin(),
-    [](const SUComponentDefinitionRef& value){
-      return ComponentDefinition(value);
-    });
-  return defs;
+  definitions.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    definitions.emplace_back(def_refs[i]);
+  }
 }
 
 
@@ -259,10 +284,10 @@ std::vector<ComponentDefinition> Model::group_definitions() const {
     throw std::logic_error("CW::Model::group_definitions(): Model is null");
   }
   size_t count = 0;
-  SUResult res = SUModelGetNumGroupDefinitions(m_model, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetNumGroupDefinitions, m_model, &count);
   assert(res == SU_ERROR_NONE);
   std::vector<SUComponentDefinitionRef> def_refs(count, SU_INVALID);
-  res = SUModelGetGroupDefinitions(m_model, count, def_refs.data(), &count);
+  res = CW_INSTRUMENT_SU(SUModelGetGroupDefinitions, m_model, count, def_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::vector<ComponentDefinition> defs(count);
   std::transform(def_refs.begin(), def_refs.end(), defs.begin(),
@@ -275,9 +300,9 @@ std::vector<ComponentDefinition> Model::group_definitions() const {
 
 InstancePath Model::instance_path(const String& persistent_id) const {
   SUInstancePathRef instance_path_ref = SU_INVALID;
-  SUResult res = SUInstancePathCreate(&instance_path_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUInstancePathCreate, &instance_path_ref);
   assert(res == SU_ERROR_NONE);
-  res = SUModelGetInstancePathByPid(m_model, persistent_id.ref(), &instance_path_ref);
+  res = CW_INSTRUMENT_SU(SUModelGetInstancePathByPid, m_model, persistent_id.ref(), &instance_path_ref);
   if (res == SU_ERROR_GENERIC) {
     // Probably passed an empty or invalid string - return an empty instance path
     return InstancePath();
@@ -292,7 +317,7 @@ Entities Model::entities() const {
     throw std::logic_error("CW::Model::entities(): Model is null");
   }
   SUEntitiesRef entities = SU_INVALID;
-  SUResult res = SUModelGetEntities(m_model, &entities);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetEntities, m_model, &entities);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Entities(entities, m_model);
 }
@@ -341,25 +366,34 @@ TypedValue Model::get_attribute(const std::string& dict_name, const std::string&
 * @return layers a vector array of Layer objects in the model.
 */
 std::vector<Layer> Model::layers() const {
+  std::vector<Layer> layers;
+  this->layers(layers);
+  return layers;
+}
+
+
+void Model::layers(std::vector<Layer>& layers) const {
+  CW_INSTRUMENT_METHOD("CW::Model::layers");
   if (!(*this)) {
     throw std::logic_error("CW::Model::layers(): Model is null");
   }
   size_t count = 0;
-  SUResult res = SUModelGetNumLayers(m_model, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetNumLayers, m_model, &count);
   assert(res == SU_ERROR_NONE);
-  std::vector<SULayerRef> layer_refs(count, SU_INVALID);
-  res = SUModelGetLayers(m_model, count, layer_refs.data(), &count);
+  layers.clear();
+  thread_local std::vector<SULayerRef> layer_refs;
+  layer_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SUModelGetLayers, m_model, count, layer_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<Layer> layers(count);
-  std::transform(layer_refs.begin(), layer_refs.end(), layers.begin(),
-    [](const SULayerRef& value){
-      return Layer(value);
-    });
-  return layers;
+  layers.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    layers.emplace_back(layer_refs[i]);
+  }
 }
 
 
 void Model::add_layers(std::vector<Layer>& layers) {
+  CW_INSTRUMENT_METHOD("CW::Model::add_layers");
   for (size_t i=0; i < layers.size(); i++) {
     // Check that each material is not attached to another model
     if (layers[i].attached()) {
@@ -371,8 +405,9 @@ void Model::add_layers(std::vector<Layer>& layers) {
     [](const Layer& value){
       return value.ref();
     });
-  SUResult res = SUModelAddLayers(m_model, layers.size(), layer_refs.data());
+  SUResult res = CW_INSTRUMENT_SU(SUModelAddLayers, m_model, layers.size(), layer_refs.data());
   assert(res == SU_ERROR_NONE); _unused(res);
+  registry()->invalidate_layers();
   for (size_t i=0; i < layers.size(); i++) {
     layers[i].attached(true);
   }
@@ -380,13 +415,7 @@ void Model::add_layers(std::vector<Layer>& layers) {
 
 
 bool Model::layer_exists(const Layer& layer) const {
-  std::vector<Layer> layers = this->layers();
-  for (auto& lay : layers) {
-    if (lay == layer) {
-      return true;
-    }
-  }
-  return false;
+  return registry()->contains(layer);
 }
 
 /*
@@ -397,28 +426,37 @@ bool Model::layer_exists(const Layer& layer) const {
 
 
 std::vector<Material> Model::materials() const {
+  std::vector<Material> materials;
+  this->materials(materials);
+  return materials;
+}
+
+
+void Model::materials(std::vector<Material>& materials) const {
+  CW_INSTRUMENT_METHOD("CW::Model::materials");
   if (!(*this)) {
     throw std::logic_error("CW::Model::materials(): Model is null");
   }
   size_t count = 0;
-  SUResult res = SUModelGetNumMaterials(m_model, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetNumMaterials, m_model, &count);
   assert(res == SU_ERROR_NONE);
+  materials.clear();
   if (count == 0) {
-    return std::vector<Material> {};
+    return;
   }
-  std::vector<SUMaterialRef> material_refs(count, SU_INVALID);
-  res = SUModelGetMaterials(m_model, count, material_refs.data(), &count);
+  thread_local std::vector<SUMaterialRef> material_refs;
+  material_refs.resize(count);
+  res = CW_INSTRUMENT_SU(SUModelGetMaterials, m_model, count, material_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
-  std::vector<Material> materials(count);
-  std::transform(material_refs.begin(), material_refs.end(), materials.begin(),
-    [](const SUMaterialRef& value){
-      return Material(value);
-    });
-  return materials;
+  materials.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    materials.emplace_back(material_refs[i]);
+  }
 }
 
 
 void Model::add_materials(std::vector<Material>& materials) {
+  CW_INSTRUMENT_METHOD("CW::Model::add_materials");
   for (size_t i=0; i < materials.size(); i++) {
     // Check that each material is not attached to another model
     if (materials[i].attached()) {
@@ -430,8 +468,9 @@ void Model::add_materials(std::vector<Material>& materials) {
     [](const Material& value){
       return value.ref();
     });
-  SUResult res = SUModelAddMaterials(m_model, materials.size(), material_refs.data());
+  SUResult res = CW_INSTRUMENT_SU(SUModelAddMaterials, m_model, materials.size(), material_refs.data());
   assert(res == SU_ERROR_NONE); _unused(res);
+  registry()->invalidate_materials();
   for (size_t i=0; i < materials.size(); i++) {
     materials[i].attached(true);
   }
@@ -439,13 +478,15 @@ void Model::add_materials(std::vector<Material>& materials) {
 
 
 bool Model::material_exists(const Material& material) const {
-  std::vector<Material> materials = this->materials();
-  for (auto& mat : materials) {
-    if (mat == material) {
-      return true;
-    }
+  return registry()->contains(material);
+}
+
+
+std::shared_ptr<ModelRegistry> Model::registry() const {
+  if (!(*this)) {
+    throw std::logic_error("CW::Model::registry(): Model is null");
   }
-  return false;
+  return ModelRegistry::get(m_model);
 }
 
 
@@ -454,7 +495,7 @@ String Model::name() const {
     throw std::logic_error("CW::Model::name(): Model is null");
   }
   SUStringRef name = SU_INVALID;
-  SUModelGetName(m_model, &name);
+  CW_INSTRUMENT_SU(SUModelGetName, m_model, &name);
   return String(name);
 }
 
@@ -464,7 +505,7 @@ bool Model::name(const String& name_string) {
     throw std::logic_error("CW::Model::name(): Model is null");
   }
   std::string std_string = name_string;
-  SUResult res = SUModelSetName(m_model, std_string.c_str());
+  SUResult res = CW_INSTRUMENT_SU(SUModelSetName, m_model, std_string.c_str());
   if (res == SU_ERROR_NONE) {
     return true;
   }
@@ -473,6 +514,7 @@ bool Model::name(const String& name_string) {
 
 
 size_t Model::num_faces() const {
+  CW_INSTRUMENT_METHOD("CW::Model::num_faces");
   if (!(*this)) {
     throw std::logic_error("CW::Model::num_faces(): Model is null");
   }
@@ -483,7 +525,7 @@ size_t Model::num_faces() const {
 OptionsManager Model::options()
 {
   SUOptionsManagerRef options_manager = SU_INVALID;
-  SUResult res = SUModelGetOptionsManager(m_model, &options_manager);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetOptionsManager, m_model, &options_manager);
   assert(res == SU_ERROR_NONE); _unused(res);
   return OptionsManager(options_manager);
 }
@@ -500,18 +542,30 @@ OptionsManager Model::options()
 // TODO - probably delete this, as there is no way to get the path of the model through the API.
 // std::string Model::path() const {}
 
-/*
-* Returns the first Entity object that a ray from a given point and direction vector will hit.
-*/
-//Entity raytest(Point3D point, Vector3D vector);
+std::shared_ptr<const FrozenModel> Model::freeze() const {
+  if (!(*this)) {
+    throw std::logic_error("CW::Model::freeze(): Model is null");
+  }
+  return std::make_shared<const FrozenModel>(*this);
+}
+
+
+RayTestResult Model::raytest(const Point3D& point, const Vector3D& vector) const {
+  if (!(*this)) {
+    throw std::logic_error("CW::Model::raytest(): Model is null");
+  }
+  FaceBVH bvh(entities());
+  return bvh.raytest(point, vector);
+}
 
 
 SUResult Model::save(const std::string& file_path) {
+  CW_INSTRUMENT_METHOD("CW::Model::save");
   if (!(*this)) {
     throw std::logic_error("CW::Model::save(): Model is null");
   }
   const char * c_string = file_path.c_str();
-  SUResult res = SUModelSaveToFile(m_model, c_string);
+  SUResult res = CW_INSTRUMENT_SU(SUModelSaveToFile, m_model, c_string);
   return res;
 }
 
@@ -520,7 +574,7 @@ bool Model::save_with_version(const std::string& file_path, SUModelVersion versi
   if (!(*this)) {
     throw std::logic_error("CW::Model::save_with_version(): Model is null");
   }
-  SUResult res = SUModelSaveToFileWithVersion(m_model, file_path.c_str(), version);
+  SUResult res = CW_INSTRUMENT_SU(SUModelSaveToFileWithVersion, m_model, file_path.c_str(), version);
   if (res == SU_ERROR_NONE) {
     return true;
   }
@@ -553,7 +607,7 @@ bool Model::set_attribute(const std::string& dict_name, const std::string& key,
 RenderingOptions Model::rendering_options()
 {
   SURenderingOptionsRef ref = SU_INVALID;
-  SUResult res = SUModelGetRenderingOptions(m_model, &ref);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetRenderingOptions, m_model, &ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return RenderingOptions(ref);
 }
@@ -561,7 +615,7 @@ RenderingOptions Model::rendering_options()
 ShadowInfo Model::shadow_info()
 {
   SUShadowInfoRef ref = SU_INVALID;
-  SUResult res = SUModelGetShadowInfo(m_model, &ref);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetShadowInfo, m_model, &ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return ShadowInfo(ref);
 }
@@ -596,7 +650,7 @@ ModelStatistics::ModelStatistics(SUModelStatistics model_statistics):
 ModelStatistics::ModelStatistics(const Model& model):
   m_model_statistics(SUModelStatistics{})
 {
-  SUResult res = SUModelGetStatistics(model, &m_model_statistics);
+  SUResult res = CW_INSTRUMENT_SU(SUModelGetStatistics, model, &m_model_statistics);
   assert(res == SU_ERROR_NONE); _unused(res);
 }
   
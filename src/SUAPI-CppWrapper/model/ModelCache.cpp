@@ -0,0 +1,755 @@
+//
+//  ModelCache.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// Macro for getting rid of unused variables commonly for assert checking
+#define _unused(x) ((void)(x))
+
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "SUAPI-CppWrapper/model/ModelCache.hpp"
+
+#include "SUAPI-CppWrapper/Color.hpp"
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Triangulator.hpp"
+
+namespace CW {
+
+constexpr uint32_t ModelCache::VERSION;
+constexpr ModelCache::Index ModelCache::NO_INDEX;
+constexpr ModelCache::Index ModelCache::ROOT;
+
+// The objects are written to the file as they are laid out in memory.
+static_assert(std::is_trivially_copyable<ModelCache::Definition>::value, "CW::ModelCache::Definition must be trivially copyable");
+static_assert(std::is_trivially_copyable<ModelCache::Instance>::value, "CW::ModelCache::Instance must be trivially copyable");
+static_assert(std::is_trivially_copyable<ModelCache::Face>::value, "CW::ModelCache::Face must be trivially copyable");
+static_assert(std::is_trivially_copyable<ModelCache::Loop>::value, "CW::ModelCache::Loop must be trivially copyable");
+static_assert(std::is_trivially_copyable<ModelCache::Edge>::value, "CW::ModelCache::Edge must be trivially copyable");
+static_assert(std::is_trivially_copyable<ModelCache::Layer>::value, "CW::ModelCache::Layer must be trivially copyable");
+static_assert(std::is_trivially_copyable<ModelCache::Material>::value, "CW::ModelCache::Material must be trivially copyable");
+static_assert(std::is_trivially_copyable<ModelCache::Value>::value, "CW::ModelCache::Value must be trivially copyable");
+static_assert(std::is_trivially_copyable<ModelCache::Attribute>::value, "CW::ModelCache::Attribute must be trivially copyable");
+
+enum ModelCache::SectionId: uint32_t {
+  SECTION_DEFINITIONS,
+  SECTION_INSTANCES,
+  SECTION_FACES,
+  SECTION_LOOPS,
+  SECTION_LOOP_VERTICES,
+  SECTION_LOOP_EDGES,
+  SECTION_EDGES,
+  SECTION_VERTICES,
+  SECTION_FACE_TRIANGLES, // face i has the triangle indices [face_triangles[i], face_triangles[i+1])
+  SECTION_TRIANGLES,
+  SECTION_LAYERS,
+  SECTION_MATERIALS,
+  SECTION_ATTRIBUTES,
+  SECTION_VALUES,
+  SECTION_VALUE_CHARACTERS,
+  SECTION_CHARACTERS,
+  SECTION_STRING_OFFSETS,
+  SECTION_STRING_SLOTS,
+  SECTION_DEFINITIONS_BY_NAME,
+  SECTION_LAYERS_BY_NAME,
+  SECTION_MATERIALS_BY_NAME,
+  NUM_SECTIONS
+};
+
+/**
+* A run of elements in the file.
+*/
+struct ModelCache::Section {
+  uint32_t id;
+  uint32_t element_size;
+  uint64_t offset; // from the start of the file, a multiple of SECTION_ALIGNMENT
+  uint64_t count;
+};
+
+/**
+* The start of the file.
+*/
+struct ModelCache::Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order; // BYTE_ORDER_MARK as written by the machine that wrote the file
+  uint64_t source_hash;
+  uint64_t file_size;
+  Range model_attributes;
+  uint32_t num_sections;
+  uint32_t reserved;
+  Section sections[NUM_SECTIONS];
+};
+
+namespace {
+
+const char MAGIC[8] = {'C', 'W', 'M', 'C', 'A', 'C', 'H', 'E'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+// Sections start on a cache line, which is more than the alignment of any element.
+const uint64_t SECTION_ALIGNMENT = 64;
+
+uint64_t align(uint64_t offset) {
+  return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+/**
+* Returns a path next to the cache file that is unique to this process and this call, so tools writing the same cache at once never share a temporary file.  It is in the same directory so that it can be renamed over the cache.
+*/
+std::string temporary_cache_path(const std::string& cache_path) {
+  static std::atomic<unsigned long> counter(0);
+#ifdef _WIN32
+  const unsigned long process_id = static_cast<unsigned long>(_getpid());
+#else
+  const unsigned long process_id = static_cast<unsigned long>(getpid());
+#endif
+  return cache_path + "." + std::to_string(process_id) + "_" + std::to_string(counter++) + ".tmp";
+}
+
+/**
+* Whether a range lies within a section of count elements.
+*/
+bool within(const ModelCache::Range& range, uint64_t count) {
+  return range.begin <= range.end && range.end <= count;
+}
+
+
+
+
+/**
+* Stores an attribute value at values[index].  The items of an array are stored together at the end of values, and the characters of a string at the end of characters.
+*/
+void store_value(const AttributeValue& value, size_t index, std::vector<ModelCache::Value>& values, std::vector<char>& characters) {
+  ModelCache::Value stored;
+  std::memset(&stored, 0, sizeof(stored));
+  stored.type = value.get_type();
+  switch (stored.type) {
+    case SUTypedValueType_Byte:
+      stored.integer = value.byte_value();
+      break;
+    case SUTypedValueType_Short:
+      stored.integer = value.int16_value();
+      break;
+    case SUTypedValueType_Int32:
+      stored.integer = value.int32_value();
+      break;
+    case SUTypedValueType_Bool:
+      stored.integer = value.bool_value() ? 1 : 0;
+      break;
+    case SUTypedValueType_Time:
+      stored.integer = value.time_value();
+      break;
+    case SUTypedValueType_Float:
+      stored.real = value.float_value();
+      break;
+    case SUTypedValueType_Double:
+      stored.real = value.double_value();
+      break;
+    case SUTypedValueType_Color:
+      stored.color = value.color_value();
+      break;
+    case SUTypedValueType_Vector3D: {
+      const Vector3D vector = value.vector_value();
+      stored.vector[0] = vector.x;
+      stored.vector[1] = vector.y;
+      stored.vector[2] = vector.z;
+      break;
+    }
+    case SUTypedValueType_String: {
+      const std::string& string = value.string_value();
+      stored.characters.begin = static_cast<ModelCache::Index>(characters.size());
+      characters.insert(characters.end(), string.begin(), string.end());
+      stored.characters.end = static_cast<ModelCache::Index>(characters.size());
+      characters.push_back('\0');
+      break;
+    }
+    case SUTypedValueType_Array: {
+      const std::vector<AttributeValue>& items = value.array_value();
+      stored.items.begin = static_cast<ModelCache::Index>(values.size());
+      stored.items.end = static_cast<ModelCache::Index>(values.size() + items.size());
+      values.resize(values.size() + items.size());
+      for (size_t i = 0; i < items.size(); ++i) {
+        store_value(items[i], stored.items.begin + i, values, characters);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  values[index] = stored;
+}
+
+
+template <class T>
+ModelCache::Index find_by_name(Span<const ModelCache::Index> sorted, Span<const T> objects, ModelCache::Index name) {
+  if (name == ModelCache::NO_INDEX) {
+    return ModelCache::NO_INDEX;
+  }
+  auto found = std::lower_bound(sorted.begin(), sorted.end(), name, [&objects](ModelCache::Index index, ModelCache::Index value) {
+    return objects[index].name < value;
+  });
+  return found != sorted.end() && objects[*found].name == name ? *found : ModelCache::NO_INDEX;
+}
+
+} // namespace
+
+
+uint32_t ModelCache::element_size(SectionId id) {
+  switch (id) {
+    case SECTION_DEFINITIONS:
+      return sizeof(Definition);
+    case SECTION_INSTANCES:
+      return sizeof(Instance);
+    case SECTION_FACES:
+      return sizeof(Face);
+    case SECTION_LOOPS:
+      return sizeof(Loop);
+    case SECTION_EDGES:
+      return sizeof(Edge);
+    case SECTION_VERTICES:
+      return sizeof(SUPoint3D);
+    case SECTION_LAYERS:
+      return sizeof(Layer);
+    case SECTION_MATERIALS:
+      return sizeof(Material);
+    case SECTION_ATTRIBUTES:
+      return sizeof(Attribute);
+    case SECTION_VALUES:
+      return sizeof(Value);
+    case SECTION_VALUE_CHARACTERS:
+    case SECTION_CHARACTERS:
+      return sizeof(char);
+    default:
+      return sizeof(Index);
+  }
+}
+
+
+ModelCache::ModelCache():
+  m_data(nullptr),
+  m_size(0),
+  m_file(nullptr),
+  m_mapping(nullptr),
+  m_header(nullptr)
+{}
+
+
+ModelCache::~ModelCache() {
+  if (m_data == nullptr) {
+    return;
+  }
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mapping);
+  CloseHandle(m_file);
+#else
+  munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
+
+uint64_t ModelCache::hash_file(const std::string& file_path) {
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file) {
+    throw std::invalid_argument("CW::ModelCache::hash_file(): cannot read file " + file_path);
+  }
+  // FNV-1a, over the file read in large blocks.
+  std::vector<char> buffer(1 << 20);
+  uint64_t hash = 14695981039346656037ULL;
+  while (file) {
+    file.read(buffer.data(), buffer.size());
+    const size_t count = static_cast<size_t>(file.gcount());
+    for (size_t i = 0; i < count; ++i) {
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 1099511628211ULL;
+    }
+  }
+  if (!file.eof()) {
+    throw std::invalid_argument("CW::ModelCache::hash_file(): cannot read file " + file_path);
+  }
+  return hash;
+}
+
+
+bool ModelCache::write(const FrozenModel& model, uint64_t source_hash, const std::string& cache_path) {
+  // Attribute values, converted to the stored form.  The top level values have the same indices as the attributes.
+  std::vector<Attribute> attributes(model.m_attributes.size());
+  std::vector<Value> values(model.m_attributes.size());
+  std::vector<char> value_characters;
+  for (size_t i = 0; i < model.m_attributes.size(); ++i) {
+    const FrozenModel::Attribute& attribute = model.m_attributes[i];
+    attributes[i] = Attribute{attribute.dictionary, attribute.key, static_cast<Index>(i)};
+    store_value(attribute.value, i, values, value_characters);
+  }
+
+  // Triangulate each face into indices of the definition's vertices.
+  std::vector<Index> face_triangles;
+  std::vector<Index> triangles;
+  face_triangles.reserve(model.m_faces.size() + 1);
+  face_triangles.push_back(0);
+  Triangulator triangulator;
+  TriangleMesh mesh;
+  std::vector<SUPoint3D> points;
+  std::vector<Index> point_vertices;
+  std::vector<size_t> loop_offsets;
+  for (const Face& face : model.m_faces) {
+    points.clear();
+    point_vertices.clear();
+    loop_offsets.assign(1, 0);
+    for (const Loop& loop : model.loops(face.loops)) {
+      for (Index vertex : model.loop_vertices(loop)) {
+        points.push_back(model.m_vertices[vertex]);
+        point_vertices.push_back(vertex);
+      }
+      loop_offsets.push_back(points.size());
+    }
+    mesh.clear();
+    triangulator.triangulate(points.data(), loop_offsets.data(), face.loops.size(), Vector3D(face.normal), mesh);
+    for (uint32_t index : mesh.indices) {
+      triangles.push_back(point_vertices[index]);
+    }
+    face_triangles.push_back(static_cast<Index>(triangles.size()));
+  }
+
+  struct SectionData {
+    const void* data;
+    size_t count;
+  };
+  const SectionData sections[NUM_SECTIONS] = {
+    {model.m_definitions.data(), model.m_definitions.size()},
+    {model.m_instances.data(), model.m_instances.size()},
+    {model.m_faces.data(), model.m_faces.size()},
+    {model.m_loops.data(), model.m_loops.size()},
+    {model.m_loop_vertices.data(), model.m_loop_vertices.size()},
+    {model.m_loop_edges.data(), model.m_loop_edges.size()},
+    {model.m_edges.data(), model.m_edges.size()},
+    {model.m_vertices.data(), model.m_vertices.size()},
+    {face_triangles.data(), face_triangles.size()},
+    {triangles.data(), triangles.size()},
+    {model.m_layers.data(), model.m_layers.size()},
+    {model.m_materials.data(), model.m_materials.size()},
+    {attributes.data(), attributes.size()},
+    {values.data(), values.size()},
+    {value_characters.data(), value_characters.size()},
+    {model.m_characters.data(), model.m_characters.size()},
+    {model.m_string_offsets.data(), model.m_string_offsets.size()},
+    {model.m_string_slots.data(), model.m_string_slots.size()},
+    {model.m_definitions_by_name.data(), model.m_definitions_by_name.size()},
+    {model.m_layers_by_name.data(), model.m_layers_by_name.size()},
+    {model.m_materials_by_name.data(), model.m_materials_by_name.size()}
+  };
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byte_order = BYTE_ORDER_MARK;
+  header.source_hash = source_hash;
+  header.model_attributes = model.m_model_attributes;
+  header.num_sections = NUM_SECTIONS;
+  uint64_t offset = align(sizeof(Header));
+  for (uint32_t id = 0; id < NUM_SECTIONS; ++id) {
+    const uint32_t size = element_size(static_cast<SectionId>(id));
+    header.sections[id] = Section{id, size, offset, sections[id].count};
+    offset = align(offset + size * sections[id].count);
+  }
+  header.file_size = offset;
+
+  const std::string temporary_path = temporary_cache_path(cache_path);
+  {
+    std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return false;
+    }
+    static const char padding[SECTION_ALIGNMENT] = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t position = sizeof(header);
+    for (uint32_t id = 0; id < NUM_SECTIONS; ++id) {
+      const Section& section = header.sections[id];
+      file.write(padding, static_cast<std::streamsize>(section.offset - position));
+      file.write(static_cast<const char*>(sections[id].data), static_cast<std::streamsize>(section.element_size * section.count));
+      position = section.offset + section.element_size * section.count;
+    }
+    file.write(padding, static_cast<std::streamsize>(header.file_size - position));
+    file.close();
+    if (!file) {
+      std::remove(temporary_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(temporary_path.c_str(), cache_path.c_str()) != 0) {
+    // Windows does not rename over an existing file.
+    std::remove(cache_path.c_str());
+    if (std::rename(temporary_path.c_str(), cache_path.c_str()) != 0) {
+      std::remove(temporary_path.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+
+std::shared_ptr<const ModelCache> ModelCache::open(const std::string& cache_path, uint64_t source_hash) {
+  std::shared_ptr<ModelCache> cache(new ModelCache());
+#ifdef _WIN32
+  HANDLE file = CreateFileA(cache_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart < LONGLONG(sizeof(Header))) {
+    CloseHandle(file);
+    return nullptr;
+  }
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    CloseHandle(file);
+    return nullptr;
+  }
+  const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == nullptr) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return nullptr;
+  }
+  cache->m_file = file;
+  cache->m_mapping = mapping;
+  cache->m_size = static_cast<size_t>(size.QuadPart);
+#else
+  const int file = ::open(cache_path.c_str(), O_RDONLY);
+  if (file < 0) {
+    return nullptr;
+  }
+  struct stat status;
+  if (fstat(file, &status) != 0 || status.st_size < off_t(sizeof(Header))) {
+    close(file);
+    return nullptr;
+  }
+  void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+  // The mapping keeps the file open.
+  close(file);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  cache->m_size = static_cast<size_t>(status.st_size);
+#endif
+  cache->m_data = static_cast<const char*>(data);
+  cache->m_header = reinterpret_cast<const Header*>(cache->m_data);
+
+  // Only the header and the ranges of each definition are checked: the sections are paged in when they are first read.
+  const Header& header = *cache->m_header;
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION ||
+      header.byte_order != BYTE_ORDER_MARK ||
+      header.source_hash != source_hash ||
+      header.file_size != cache->m_size ||
+      header.num_sections != NUM_SECTIONS) {
+    return nullptr;
+  }
+  for (uint32_t id = 0; id < NUM_SECTIONS; ++id) {
+    const Section& section = header.sections[id];
+    if (section.id != id ||
+        section.element_size != element_size(static_cast<SectionId>(id)) ||
+        section.offset % SECTION_ALIGNMENT != 0 ||
+        section.offset > cache->m_size ||
+        section.count > (cache->m_size - section.offset) / section.element_size) {
+      return nullptr;
+    }
+  }
+  if (header.sections[SECTION_FACE_TRIANGLES].count != header.sections[SECTION_FACES].count + 1) {
+    return nullptr;
+  }
+  const uint64_t num_attributes = header.sections[SECTION_ATTRIBUTES].count;
+  if (!within(header.model_attributes, num_attributes)) {
+    return nullptr;
+  }
+  for (const Definition& definition : cache->definitions()) {
+    if (!within(definition.faces, header.sections[SECTION_FACES].count) ||
+        !within(definition.edges, header.sections[SECTION_EDGES].count) ||
+        !within(definition.instances, header.sections[SECTION_INSTANCES].count) ||
+        !within(definition.attributes, num_attributes)) {
+      return nullptr;
+    }
+  }
+  return cache;
+}
+
+
+template <class T>
+Span<const T> ModelCache::section(SectionId id) const {
+  const Section& section = m_header->sections[id];
+  return Span<const T>(reinterpret_cast<const T*>(m_data + section.offset), static_cast<size_t>(section.count));
+}
+
+
+size_t ModelCache::find_slot(const char* data, size_t size) const {
+  const Span<const Index> slots = this->section<Index>(SECTION_STRING_SLOTS);
+  const size_t mask = slots.size() - 1;
+  size_t slot = FrozenModel::hash_string(data, size) & mask;
+  while (slots[slot] != NO_INDEX) {
+    const StringView string = this->string(slots[slot]);
+    if (string.size == size && std::memcmp(string.data, data, size) == 0) {
+      break;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+
+uint64_t ModelCache::source_hash() const {
+  return m_header->source_hash;
+}
+
+
+size_t ModelCache::file_size() const {
+  return m_size;
+}
+
+
+Span<const ModelCache::Definition> ModelCache::definitions() const {
+  return this->section<Definition>(SECTION_DEFINITIONS);
+}
+
+
+Span<const ModelCache::Instance> ModelCache::instances() const {
+  return this->section<Instance>(SECTION_INSTANCES);
+}
+
+
+Span<const ModelCache::Face> ModelCache::faces() const {
+  return this->section<Face>(SECTION_FACES);
+}
+
+
+Span<const ModelCache::Loop> ModelCache::loops() const {
+  return this->section<Loop>(SECTION_LOOPS);
+}
+
+
+Span<const ModelCache::Edge> ModelCache::edges() const {
+  return this->section<Edge>(SECTION_EDGES);
+}
+
+
+Span<const ModelCache::Layer> ModelCache::layers() const {
+  return this->section<Layer>(SECTION_LAYERS);
+}
+
+
+Span<const ModelCache::Material> ModelCache::materials() const {
+  return this->section<Material>(SECTION_MATERIALS);
+}
+
+
+Span<const SUPoint3D> ModelCache::vertices() const {
+  return this->section<SUPoint3D>(SECTION_VERTICES);
+}
+
+
+Span<const ModelCache::Face> ModelCache::faces(const Range& range) const {
+  return this->faces().subspan(range.begin, range.size());
+}
+
+
+Span<const ModelCache::Edge> ModelCache::edges(const Range& range) const {
+  return this->edges().subspan(range.begin, range.size());
+}
+
+
+Span<const ModelCache::Instance> ModelCache::instances(const Range& range) const {
+  return this->instances().subspan(range.begin, range.size());
+}
+
+
+Span<const ModelCache::Loop> ModelCache::loops(const Range& range) const {
+  return this->loops().subspan(range.begin, range.size());
+}
+
+
+Span<const ModelCache::Attribute> ModelCache::attributes(const Range& range) const {
+  return this->section<Attribute>(SECTION_ATTRIBUTES).subspan(range.begin, range.size());
+}
+
+
+Span<const ModelCache::Index> ModelCache::loop_vertices(const Loop& loop) const {
+  return this->section<Index>(SECTION_LOOP_VERTICES).subspan(loop.vertices.begin, loop.vertices.size());
+}
+
+
+Span<const ModelCache::Index> ModelCache::loop_edges(const Loop& loop) const {
+  return this->section<Index>(SECTION_LOOP_EDGES).subspan(loop.vertices.begin, loop.vertices.size());
+}
+
+
+Span<const ModelCache::Index> ModelCache::triangles(const Range& faces) const {
+  const Span<const Index> face_triangles = this->section<Index>(SECTION_FACE_TRIANGLES);
+  const Index begin = face_triangles[faces.begin];
+  return this->section<Index>(SECTION_TRIANGLES).subspan(begin, face_triangles[faces.end] - begin);
+}
+
+
+ModelCache::Range ModelCache::model_attributes() const {
+  return m_header->model_attributes;
+}
+
+
+AttributeValue ModelCache::attribute(const Range& attributes, const std::string& dictionary, const std::string& key) const {
+  const Index dictionary_index = this->find_string(dictionary);
+  const Index key_index = this->find_string(key);
+  if (dictionary_index == NO_INDEX || key_index == NO_INDEX) {
+    return AttributeValue();
+  }
+  for (const Attribute& attribute : this->attributes(attributes)) {
+    if (attribute.dictionary == dictionary_index && attribute.key == key_index) {
+      return this->value(attribute.value);
+    }
+  }
+  return AttributeValue();
+}
+
+
+Span<const ModelCache::Value> ModelCache::values() const {
+  return this->section<Value>(SECTION_VALUES);
+}
+
+
+AttributeValue ModelCache::value(Index index) const {
+  const Value& stored = this->values()[index];
+  AttributeValue value;
+  switch (stored.type) {
+    case SUTypedValueType_Byte:
+      value.byte_value(static_cast<char>(stored.integer));
+      break;
+    case SUTypedValueType_Short:
+      value.int16_value(static_cast<int16_t>(stored.integer));
+      break;
+    case SUTypedValueType_Int32:
+      value.int32_value(static_cast<int32_t>(stored.integer));
+      break;
+    case SUTypedValueType_Bool:
+      value.bool_value(stored.integer != 0);
+      break;
+    case SUTypedValueType_Time:
+      value.time_value(stored.integer);
+      break;
+    case SUTypedValueType_Float:
+      value.float_value(static_cast<float>(stored.real));
+      break;
+    case SUTypedValueType_Double:
+      value.double_value(stored.real);
+      break;
+    case SUTypedValueType_Color:
+      value.color_value(Color(stored.color));
+      break;
+    case SUTypedValueType_Vector3D:
+      value.vector_value(Vector3D(stored.vector[0], stored.vector[1], stored.vector[2]));
+      break;
+    case SUTypedValueType_String:
+      value.string_value(this->string_value(stored).str());
+      break;
+    case SUTypedValueType_Array: {
+      std::vector<AttributeValue> items;
+      items.reserve(stored.items.size());
+      for (Index item = stored.items.begin; item < stored.items.end; ++item) {
+        items.push_back(this->value(item));
+      }
+      value.array_value(std::move(items));
+      break;
+    }
+    default:
+      break;
+  }
+  return value;
+}
+
+
+StringView ModelCache::string_value(const Value& value) const {
+  if (value.type != SUTypedValueType_String) {
+    throw std::logic_error("CW::ModelCache::string_value(): value is not a string");
+  }
+  return StringView{this->section<char>(SECTION_VALUE_CHARACTERS).data() + value.characters.begin, value.characters.size()};
+}
+
+
+StringView ModelCache::string(Index index) const {
+  if (index >= this->num_strings()) {
+    throw std::out_of_range("CW::ModelCache::string(): index is out of range");
+  }
+  const Span<const uint32_t> offsets = this->section<uint32_t>(SECTION_STRING_OFFSETS);
+  return StringView{this->section<char>(SECTION_CHARACTERS).data() + offsets[index], offsets[index + 1] - offsets[index] - 1};
+}
+
+
+ModelCache::Index ModelCache::find_string(const std::string& string) const {
+  const Span<const Index> slots = this->section<Index>(SECTION_STRING_SLOTS);
+  if (slots.empty()) {
+    return NO_INDEX;
+  }
+  return slots[this->find_slot(string.data(), string.size())];
+}
+
+
+size_t ModelCache::num_strings() const {
+  const size_t num_offsets = static_cast<size_t>(m_header->sections[SECTION_STRING_OFFSETS].count);
+  return num_offsets == 0 ? 0 : num_offsets - 1;
+}
+
+
+ModelCache::Index ModelCache::find_definition(const std::string& name) const {
+  return find_by_name(this->section<Index>(SECTION_DEFINITIONS_BY_NAME), this->definitions(), this->find_string(name));
+}
+
+
+ModelCache::Index ModelCache::find_layer(const std::string& name) const {
+  return find_by_name(this->section<Index>(SECTION_LAYERS_BY_NAME), this->layers(), this->find_string(name));
+}
+
+
+ModelCache::Index ModelCache::find_material(const std::string& name) const {
+  return find_by_name(this->section<Index>(SECTION_MATERIALS_BY_NAME), this->materials(), this->find_string(name));
+}
+
+} /* namespace CW */
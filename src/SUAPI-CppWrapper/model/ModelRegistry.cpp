@@ -0,0 +1,308 @@
+//
+//  ModelRegistry.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// Macro for getting rid of unused variables commonly for assert checking
+#define _unused(x) ((void)(x))
+
+#include "SUAPI-CppWrapper/model/ModelRegistry.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/model/Layer.hpp"
+#include "SUAPI-CppWrapper/model/Material.hpp"
+
+namespace CW {
+
+namespace {
+
+std::mutex& registries_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<const void*, std::shared_ptr<ModelRegistry>>& registries() {
+  static std::unordered_map<const void*, std::shared_ptr<ModelRegistry>> map;
+  return map;
+}
+
+std::atomic<size_t>& name_generation() {
+  static std::atomic<size_t> generation(0);
+  return generation;
+}
+
+/**
+* Brings an index up to date with the SDK.  It is rebuilt if it has been invalidated, if the number of objects in the model has changed, or if names are needed and an object has been renamed through the wrapper since it was built.
+* @return true if the index was rebuilt.
+*/
+template <typename IndexType, typename RefType>
+bool update_index(IndexType& index, SUModelRef model, bool names, SUResult (*get_count)(SUModelRef, size_t*), SUResult (*get_refs)(SUModelRef, size_t, RefType*, size_t*), SUResult (*get_name)(RefType, SUStringRef*)) {
+  const size_t generation = name_generation();
+  size_t count = 0;
+  if (SUIsValid(model)) {
+    SUResult res = get_count(model, &count);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  if (!index.dirty && index.count == count && (!names || index.name_generation == generation)) {
+    return false;
+  }
+  RefType invalid = SU_INVALID;
+  std::vector<RefType> refs(count, invalid);
+  if (count > 0) {
+    SUResult res = get_refs(model, count, refs.data(), &count);
+    assert(res == SU_ERROR_NONE); _unused(res);
+    refs.resize(count);
+  }
+  index.refs.clear();
+  index.names.clear();
+  index.refs.reserve(refs.size());
+  index.names.reserve(refs.size());
+  String name;
+  std::string name_string;
+  for (const RefType& ref : refs) {
+    index.refs.insert(ref.ptr);
+    if (get_name(ref, name) == SU_ERROR_NONE) {
+      name.std_string(name_string);
+      // Names are unique within a model, but keep the first object should the SDK ever return duplicates.
+      index.names.emplace(name_string, ref.ptr);
+    }
+  }
+  index.count = count;
+  index.dirty = false;
+  index.name_generation = generation;
+  return true;
+}
+
+
+/**
+* Looks up a name in an index, brought up to date by update().  The object found is checked against the name the SDK gives it now, as it may have been renamed without the wrapper knowing, in which case the index is rebuilt and searched again.
+*/
+template <typename RefType, typename IndexType, typename Update>
+RefType find_name(IndexType& index, Update update, SUResult (*get_name)(RefType, SUStringRef*), const std::string& name) {
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    update();
+    auto it = index.names.find(name);
+    if (it == index.names.end()) {
+      break;
+    }
+    RefType found = SU_INVALID;
+    found.ptr = const_cast<void*>(it->second);
+    String current_name;
+    if (get_name(found, current_name) == SU_ERROR_NONE && current_name.std_string() == name) {
+      return found;
+    }
+    index.dirty = true;
+  }
+  RefType invalid = SU_INVALID;
+  return invalid;
+}
+
+} // namespace
+
+
+ModelRegistry::ModelRegistry(SUModelRef model):
+  m_model(model)
+{}
+
+
+std::shared_ptr<ModelRegistry> ModelRegistry::get(SUModelRef model) {
+  if (SUIsInvalid(model)) {
+    throw std::invalid_argument("CW::ModelRegistry::get(): SUModelRef is invalid");
+  }
+  std::lock_guard<std::mutex> lock(registries_mutex());
+  std::shared_ptr<ModelRegistry>& registry = registries()[model.ptr];
+  if (!registry) {
+    registry.reset(new ModelRegistry(model));
+  }
+  return registry;
+}
+
+
+void ModelRegistry::release(SUModelRef model) {
+  std::shared_ptr<ModelRegistry> registry;
+  {
+    std::lock_guard<std::mutex> lock(registries_mutex());
+    auto it = registries().find(model.ptr);
+    if (it == registries().end()) {
+      return;
+    }
+    registry = std::move(it->second);
+    registries().erase(it);
+  }
+  // Anyone still holding the registry must not reach the released model through it.
+  std::lock_guard<std::mutex> lock(registry->m_mutex);
+  registry->m_model = SU_INVALID;
+  registry->m_materials.dirty = true;
+  registry->m_layers.dirty = true;
+  registry->m_definitions.dirty = true;
+}
+
+
+void ModelRegistry::names_changed() {
+  ++name_generation();
+}
+
+
+void ModelRegistry::invalidate() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_materials.dirty = true;
+  m_layers.dirty = true;
+  m_definitions.dirty = true;
+}
+
+
+void ModelRegistry::invalidate_materials() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_materials.dirty = true;
+}
+
+
+void ModelRegistry::invalidate_layers() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_layers.dirty = true;
+}
+
+
+void ModelRegistry::invalidate_definitions() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_definitions.dirty = true;
+}
+
+
+void ModelRegistry::update_materials(bool names) {
+  if (update_index(m_materials, m_model, names, &SUModelGetNumMaterials, &SUModelGetMaterials, &SUMaterialGetName)) {
+    ++m_rebuilds;
+  }
+}
+
+
+void ModelRegistry::update_layers(bool names) {
+  if (update_index(m_layers, m_model, names, &SUModelGetNumLayers, &SUModelGetLayers, &SULayerGetName)) {
+    ++m_rebuilds;
+  }
+}
+
+
+void ModelRegistry::update_definitions(bool names) {
+  if (update_index(m_definitions, m_model, names, &SUModelGetNumComponentDefinitions, &SUModelGetComponentDefinitions, &SUComponentDefinitionGetName)) {
+    ++m_rebuilds;
+  }
+}
+
+
+bool ModelRegistry::contains(const Material& material) {
+  if (!material) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  update_materials(false);
+  return m_materials.refs.count(material.ref().ptr) > 0;
+}
+
+
+bool ModelRegistry::contains(const Layer& layer) {
+  if (!layer) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  update_layers(false);
+  return m_layers.refs.count(layer.ref().ptr) > 0;
+}
+
+
+bool ModelRegistry::contains(const ComponentDefinition& definition) {
+  if (!definition) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  update_definitions(false);
+  return m_definitions.refs.count(definition.ref().ptr) > 0;
+}
+
+
+Material ModelRegistry::material(const std::string& name) {
+  SUMaterialRef ref = SU_INVALID;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ref = find_name(m_materials, [this]() { this->update_materials(true); }, &SUMaterialGetName, name);
+  }
+  return Material(ref);
+}
+
+
+Layer ModelRegistry::layer(const std::string& name) {
+  SULayerRef ref = SU_INVALID;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ref = find_name(m_layers, [this]() { this->update_layers(true); }, &SULayerGetName, name);
+  }
+  return Layer(ref);
+}
+
+
+ComponentDefinition ModelRegistry::definition(const std::string& name) {
+  SUComponentDefinitionRef ref = SU_INVALID;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ref = find_name(m_definitions, [this]() { this->update_definitions(true); }, &SUComponentDefinitionGetName, name);
+  }
+  return ComponentDefinition(ref);
+}
+
+
+size_t ModelRegistry::num_materials() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  update_materials(false);
+  return m_materials.refs.size();
+}
+
+
+size_t ModelRegistry::num_layers() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  update_layers(false);
+  return m_layers.refs.size();
+}
+
+
+size_t ModelRegistry::num_definitions() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  update_definitions(false);
+  return m_definitions.refs.size();
+}
+
+
+size_t ModelRegistry::rebuilds() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_rebuilds;
+}
+
+} /* namespace CW */
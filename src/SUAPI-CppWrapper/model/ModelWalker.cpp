@@ -0,0 +1,303 @@
+//
+//  ModelWalker.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// Macro for getting rid of unused variables commonly for assert checking
+#define _unused(x) ((void)(x))
+
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include "SUAPI-CppWrapper/model/ModelWalker.hpp"
+
+#include <SketchUpAPI/model/group.h>
+
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/Group.hpp"
+#include "SUAPI-CppWrapper/model/InstancePath.hpp"
+
+namespace CW {
+
+namespace {
+
+/**
+* Thread pool where each thread has its own task queue.  Threads take tasks from the back of their own queue, and steal from the front of other threads' queues when their own is empty.  Tasks may submit further tasks.  A thread that finds no task to take sleeps until a task is submitted or all tasks have finished.
+*/
+class WorkStealingPool {
+  public:
+  typedef std::function<void(size_t worker)> Task;
+
+  private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  // Number of tasks that have been submitted but not finished.
+  std::atomic<size_t> m_pending;
+  // Number of tasks waiting in the queues.
+  std::atomic<size_t> m_queued;
+  std::atomic<bool> m_abort;
+  std::mutex m_idle_mutex;
+  std::condition_variable m_idle;
+  std::mutex m_exception_mutex;
+  std::exception_ptr m_exception;
+
+  bool pop(size_t worker, Task& task) {
+    {
+      Queue& own = *m_queues[worker];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        --m_queued;
+        return true;
+      }
+    }
+    for (size_t i = 1; i < m_queues.size(); ++i) {
+      Queue& other = *m_queues[(worker + i) % m_queues.size()];
+      std::lock_guard<std::mutex> lock(other.mutex);
+      if (!other.tasks.empty()) {
+        task = std::move(other.tasks.front());
+        other.tasks.pop_front();
+        --m_queued;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+  * Wakes the threads waiting for a task.  The mutex is taken so that a thread that has just found nothing to do is either already waiting, or will see the change before it waits.
+  */
+  void wake(bool all) {
+    std::lock_guard<std::mutex> lock(m_idle_mutex);
+    if (all) {
+      m_idle.notify_all();
+    }
+    else {
+      m_idle.notify_one();
+    }
+  }
+
+  void work(size_t worker) {
+    Task task;
+    while (true) {
+      if (!pop(worker, task)) {
+        std::unique_lock<std::mutex> lock(m_idle_mutex);
+        m_idle.wait_for(lock, std::chrono::milliseconds(100), [this]() { return m_queued.load() > 0 || m_pending.load() == 0; });
+        if (m_pending.load() == 0) {
+          return;
+        }
+        continue;
+      }
+      if (!m_abort.load()) {
+        try {
+          task(worker);
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> lock(m_exception_mutex);
+          if (!m_exception) {
+            m_exception = std::current_exception();
+          }
+          m_abort.store(true);
+        }
+      }
+      task = nullptr;
+      if (--m_pending == 0) {
+        wake(true);
+      }
+    }
+  }
+
+  public:
+  explicit WorkStealingPool(size_t num_threads):
+    m_pending(0),
+    m_queued(0),
+    m_abort(false)
+  {
+    assert(num_threads > 0);
+    for (size_t i = 0; i < num_threads; ++i) {
+      m_queues.emplace_back(new Queue());
+    }
+  }
+
+  /**
+  * Adds a task to the queue of the given worker.
+  */
+  void submit(size_t worker, Task task) {
+    ++m_pending;
+    {
+      Queue& queue = *m_queues[worker];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    ++m_queued;
+    wake(false);
+  }
+
+  /**
+  * Runs the submitted tasks until all of them, and the tasks they submit, have finished.  The calling thread is used as the first worker.
+  */
+  void run() {
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < m_queues.size(); ++i) {
+      threads.emplace_back(&WorkStealingPool::work, this, i);
+    }
+    work(0);
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    if (m_exception) {
+      std::rethrow_exception(m_exception);
+    }
+  }
+};
+
+} // namespace
+
+
+ModelWalker::Placement::Placement(const Entities& entities, SUComponentDefinitionRef definition, const Transformation& transformation, const std::vector<ComponentInstance>& instances):
+  entities(entities),
+  definition_ref(definition),
+  transformation(transformation),
+  instances(instances)
+{}
+
+
+bool ModelWalker::Placement::has_definition() const {
+  return SUIsValid(definition_ref);
+}
+
+
+ComponentDefinition ModelWalker::Placement::definition() const {
+  if (!has_definition()) {
+    throw std::logic_error("CW::ModelWalker::Placement::definition(): the model's own entities have no definition");
+  }
+  return ComponentDefinition(definition_ref);
+}
+
+
+InstancePath ModelWalker::Placement::instance_path() const {
+  InstancePath path;
+  for (const ComponentInstance& instance : instances) {
+    path.push(instance);
+  }
+  return path;
+}
+
+
+ModelWalker::ModelWalker(const Model& model, size_t num_threads):
+  m_num_threads(num_threads > 0 ? num_threads : std::max<size_t>(1, std::thread::hardware_concurrency()))
+{
+  if (!model) {
+    throw std::invalid_argument("CW::ModelWalker::ModelWalker(): given Model is null");
+  }
+  std::unordered_map<void*, size_t> definition_indexes;
+  SUComponentDefinitionRef no_definition = SU_INVALID;
+  m_definitions.push_back(DefinitionNode{model.entities(), no_definition, {}});
+  // Nodes are appended as new definitions are found, so this loop reads each definition once.
+  for (size_t i = 0; i < m_definitions.size(); ++i) {
+    auto add_child = [this, i, &definition_indexes](const ComponentDefinition& definition, SUComponentInstanceRef instance, const Transformation& transformation) {
+      auto inserted = definition_indexes.emplace(definition.ref().ptr, m_definitions.size());
+      if (inserted.second) {
+        m_definitions.push_back(DefinitionNode{definition.entities(), definition.ref(), {}});
+      }
+      m_definitions[i].children.push_back(Child{inserted.first->second, instance, transformation.ref()});
+    };
+    const Entities entities = m_definitions[i].entities;
+    for (const ComponentInstance& instance : entities.instances()) {
+      add_child(instance.definition(), instance.ref(), instance.transformation());
+    }
+    for (const Group& group : entities.groups()) {
+      add_child(group.definition(), SUGroupToComponentInstance(group.ref()), group.transformation());
+    }
+  }
+}
+
+
+void ModelWalker::walk(const DefinitionVisitor& definition_visitor, const PlacementVisitor& placement_visitor) const {
+  WorkStealingPool pool(m_num_threads);
+  if (definition_visitor) {
+    for (size_t i = 0; i < m_definitions.size(); ++i) {
+      pool.submit(i % m_num_threads, [this, i, &definition_visitor](size_t) {
+        if (SUIsInvalid(m_definitions[i].definition)) {
+          definition_visitor(m_definitions[i].entities, nullptr);
+          return;
+        }
+        const ComponentDefinition definition(m_definitions[i].definition);
+        definition_visitor(m_definitions[i].entities, &definition);
+      });
+    }
+  }
+  // Each placement task visits its placement, then submits a task for each child placement to its own queue, from which idle threads can steal.
+  typedef std::shared_ptr<const Placement> PlacementPtr;
+  std::function<void(size_t, const PlacementPtr&, size_t)> visit =
+  [this, &pool, &placement_visitor, &visit](size_t worker, const PlacementPtr& placement, size_t definition) {
+    placement_visitor(*placement);
+    for (const Child& child : m_definitions[definition].children) {
+      const DefinitionNode& child_node = m_definitions[child.definition];
+      Transformation parent_transformation = placement->transformation;
+      std::vector<ComponentInstance> child_instances = placement->instances;
+      child_instances.push_back(ComponentInstance(child.instance));
+      PlacementPtr child_placement = std::make_shared<const Placement>(child_node.entities, child_node.definition, parent_transformation * Transformation(child.transformation), child_instances);
+      const size_t child_definition = child.definition;
+      pool.submit(worker, [&visit, child_placement, child_definition](size_t child_worker) {
+        visit(child_worker, child_placement, child_definition);
+      });
+    }
+  };
+  if (placement_visitor) {
+    PlacementPtr root = std::make_shared<const Placement>(m_definitions[0].entities, m_definitions[0].definition, Transformation(), std::vector<ComponentInstance>());
+    pool.submit(0, [&visit, root](size_t worker) {
+      visit(worker, root, 0);
+    });
+  }
+  pool.run();
+}
+
+
+size_t ModelWalker::num_definitions() const {
+  return m_definitions.size();
+}
+
+
+size_t ModelWalker::num_threads() const {
+  return m_num_threads;
+}
+
+} /* namespace CW */
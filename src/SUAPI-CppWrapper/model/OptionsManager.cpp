@@ -31,6 +31,7 @@
 #include <cassert>
 
 #include "SUAPI-CppWrapper/model/OptionsManager.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
 
@@ -44,13 +45,13 @@ std::vector<std::string> OptionsManager::get_provider_names() const
 {
   size_t num_requested = 0;
   size_t num_returned = 0;
-  SUResult res = SUOptionsManagerGetNumOptionsProviders(m_options_manager, &num_requested);
+  SUResult res = CW_INSTRUMENT_SU(SUOptionsManagerGetNumOptionsProviders, m_options_manager, &num_requested);
   std::vector<SUStringRef> refs(num_requested);
   for(auto i = 0; i < num_requested; i++) {
-    res = SUStringCreate(&refs[i]);
+    res = CW_INSTRUMENT_SU(SUStringCreate, &refs[i]);
     assert(res == SU_ERROR_NONE);
   }
-  res = SUOptionsManagerGetOptionsProviderNames(m_options_manager, num_requested, &refs[0], &num_returned);
+  res = CW_INSTRUMENT_SU(SUOptionsManagerGetOptionsProviderNames, m_options_manager, num_requested, &refs[0], &num_returned);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::vector<std::string> keys;
   for(auto i = 0; i < refs.size(); i++) {
@@ -62,7 +63,7 @@ std::vector<std::string> OptionsManager::get_provider_names() const
 OptionsProvider OptionsManager::get_provider(const std::string& name)
 {
   SUOptionsProviderRef provider = SU_INVALID;
-  SUResult res = SUOptionsManagerGetOptionsProviderByName(m_options_manager, &name[0], &provider);
+  SUResult res = CW_INSTRUMENT_SU(SUOptionsManagerGetOptionsProviderByName, m_options_manager, &name[0], &provider);
   assert(res == SU_ERROR_NONE); _unused(res);
   return OptionsProvider(provider);
 }
@@ -84,7 +85,7 @@ std::vector<std::string> OptionsProvider::keys() const
 {
   std::vector<std::string> keys;
   size_t num_requested = 0;
-  SUResult res = SUOptionsProviderGetNumKeys(m_options_provider, &num_requested);
+  SUResult res = CW_INSTRUMENT_SU(SUOptionsProviderGetNumKeys, m_options_provider, &num_requested);
   assert(res == SU_ERROR_NONE);
   if(num_requested == 0)
     return keys;
@@ -92,10 +93,10 @@ std::vector<std::string> OptionsProvider::keys() const
   size_t num_returned = 0;
   std::vector<SUStringRef> refs(num_requested);
   for(auto i = 0; i < num_requested; i++) {
-    res = SUStringCreate(&refs[i]);
+    res = CW_INSTRUMENT_SU(SUStringCreate, &refs[i]);
     assert(res == SU_ERROR_NONE);
   }
-  res = SUOptionsProviderGetKeys(m_options_provider, num_requested, &refs[0], &num_returned);
+  res = CW_INSTRUMENT_SU(SUOptionsProviderGetKeys, m_options_provider, num_requested, &refs[0], &num_returned);
   assert(res == SU_ERROR_NONE); _unused(res);
 
   for(auto i = 0; i < refs.size(); i++) {
@@ -110,7 +111,7 @@ TypedValue OptionsProvider::get_value(std::string key) const
   const char* key_char = key.c_str();
   TypedValue tval;
   SUTypedValueRef *t = tval;
-  SUResult res = SUOptionsProviderGetValue(m_options_provider, key_char, t);
+  SUResult res = CW_INSTRUMENT_SU(SUOptionsProviderGetValue, m_options_provider, key_char, t);
   assert(res == SU_ERROR_NONE); _unused(res);
   return tval;
 }
@@ -118,7 +119,7 @@ TypedValue OptionsProvider::get_value(std::string key) const
 bool OptionsProvider::set_value(std::string key, const TypedValue& tval)
 {
   SUTypedValueRef t = tval.ref();
-  SUResult res = SUOptionsProviderSetValue(m_options_provider, key.c_str(), t);
+  SUResult res = CW_INSTRUMENT_SU(SUOptionsProviderSetValue, m_options_provider, key.c_str(), t);
   if(res == SU_ERROR_NONE)
     return true;
   else
@@ -0,0 +1,315 @@
+//
+//  PreparedLoop.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "SUAPI-CppWrapper/model/PreparedLoop.hpp"
+
+namespace CW {
+
+constexpr size_t PreparedLoop::MAX_LINEAR_EDGES;
+
+PreparedLoop::PreparedLoop(const std::vector<Point3D>& loop_points) {
+  this->prepare(loop_points);
+}
+
+
+PreparedLoop::PreparedLoop(const Loop& loop) {
+  if (!loop) {
+    throw std::invalid_argument("CW::PreparedLoop::PreparedLoop(): Loop given is null");
+  }
+  this->prepare(loop.points());
+}
+
+
+void PreparedLoop::prepare(const std::vector<Point3D>& loop_points) {
+  if (loop_points.size() < 3) {
+    throw std::invalid_argument("CW::PreparedLoop::PreparedLoop(): Fewer than 3 points given - not a valid loop.");
+  }
+  // Repeated points would give zero length edges.
+  m_points.reserve(loop_points.size());
+  for (const Point3D& point : loop_points) {
+    if (m_points.empty() || !(m_points.back() == point)) {
+      m_points.push_back(point);
+    }
+  }
+  if (m_points.size() > 1 && m_points.back() == m_points.front()) {
+    m_points.pop_back();
+  }
+  if (m_points.size() < 3) {
+    throw std::invalid_argument("CW::PreparedLoop::PreparedLoop(): Fewer than 3 points given - not a valid loop.");
+  }
+  m_plane = Plane3D::plane_from_loop(m_points);
+  if (!m_plane) {
+    throw std::invalid_argument("CW::PreparedLoop::PreparedLoop(): Points given does not form a  valid loop.");
+  }
+
+  // Project onto the axis plane that the loop's plane is closest to.
+  const Vector3D normal = m_plane.normal();
+  const double normal_x = std::fabs(normal.x);
+  const double normal_y = std::fabs(normal.y);
+  const double normal_z = std::fabs(normal.z);
+  m_u_axis = 0;
+  m_v_axis = 1;
+  double direction = normal.z;
+  if (normal_x > normal_y && normal_x > normal_z) {
+    m_u_axis = 1;
+    m_v_axis = 2;
+    direction = normal.x;
+  }
+  else if (normal_y > normal_z) {
+    m_u_axis = 2;
+    m_v_axis = 0;
+    direction = normal.y;
+  }
+  m_u_sign = direction < 0.0 ? -1.0 : 1.0;
+  m_points_2d.reserve(m_points.size());
+  for (const Point3D& point : m_points) {
+    m_points_2d.push_back(this->project(point));
+  }
+  if (m_points.size() > MAX_LINEAR_EDGES) {
+    this->build_index();
+  }
+}
+
+
+void PreparedLoop::build_index() {
+  const size_t num_edges = m_points_2d.size();
+  m_slab_ys.reserve(num_edges);
+  for (const Point2D& point : m_points_2d) {
+    m_slab_ys.push_back(point.y);
+  }
+  std::sort(m_slab_ys.begin(), m_slab_ys.end());
+  m_slab_ys.erase(std::unique(m_slab_ys.begin(), m_slab_ys.end()), m_slab_ys.end());
+  if (m_slab_ys.size() < 2) {
+    m_slab_ys.clear();
+    return;
+  }
+  const size_t num_slabs = m_slab_ys.size() - 1;
+  auto slab_of = [this](double y) {
+    return static_cast<size_t>(std::lower_bound(m_slab_ys.begin(), m_slab_ys.end(), y) - m_slab_ys.begin());
+  };
+
+  // Count the edges crossing each slab.  Horizontal edges cross none.
+  m_slab_offsets.assign(num_slabs + 1, 0);
+  size_t total = 0;
+  for (size_t i = 0; i < num_edges; ++i) {
+    const Point2D& a = m_points_2d[i];
+    const Point2D& b = m_points_2d[(i + 1) % num_edges];
+    if (a.y == b.y) {
+      continue;
+    }
+    const size_t first = slab_of(std::min(a.y, b.y));
+    const size_t last = slab_of(std::max(a.y, b.y));
+    for (size_t slab = first; slab < last; ++slab) {
+      ++m_slab_offsets[slab + 1];
+    }
+    total += last - first;
+  }
+  // Loops with long edges spanning most slabs use memory quadratic in their size; leave those unindexed.
+  if (total > 32 * num_edges) {
+    m_slab_ys.clear();
+    m_slab_offsets.clear();
+    return;
+  }
+  for (size_t slab = 0; slab < num_slabs; ++slab) {
+    m_slab_offsets[slab + 1] += m_slab_offsets[slab];
+  }
+  m_slab_edges.resize(total);
+  std::vector<uint32_t> fill(m_slab_offsets.begin(), m_slab_offsets.end() - 1);
+  for (size_t i = 0; i < num_edges; ++i) {
+    const Point2D& a = m_points_2d[i];
+    const Point2D& b = m_points_2d[(i + 1) % num_edges];
+    if (a.y == b.y) {
+      continue;
+    }
+    const size_t first = slab_of(std::min(a.y, b.y));
+    const size_t last = slab_of(std::max(a.y, b.y));
+    for (size_t slab = first; slab < last; ++slab) {
+      m_slab_edges[fill[slab]++] = static_cast<uint32_t>(i);
+    }
+  }
+  // Edges of a simple loop do not cross inside a slab, so their order along the middle of the slab holds for the whole slab.
+  for (size_t slab = 0; slab < num_slabs; ++slab) {
+    const double middle = (m_slab_ys[slab] + m_slab_ys[slab + 1]) / 2.0;
+    std::sort(m_slab_edges.begin() + m_slab_offsets[slab], m_slab_edges.begin() + m_slab_offsets[slab + 1],
+      [this, middle](uint32_t lhs, uint32_t rhs) {
+        return this->x_at(lhs, middle) < this->x_at(rhs, middle);
+      });
+  }
+
+  m_points_by_y.resize(num_edges);
+  for (size_t i = 0; i < num_edges; ++i) {
+    m_points_by_y[i] = static_cast<uint32_t>(i);
+  }
+  std::sort(m_points_by_y.begin(), m_points_by_y.end(), [this](uint32_t lhs, uint32_t rhs) {
+    return m_points_2d[lhs].y < m_points_2d[rhs].y;
+  });
+}
+
+
+PreparedLoop::Point2D PreparedLoop::project(const Point3D& point) const {
+  auto coordinate = [&point](int axis) {
+    return axis == 0 ? point.x : axis == 1 ? point.y : point.z;
+  };
+  return Point2D{m_u_sign * coordinate(m_u_axis), coordinate(m_v_axis)};
+}
+
+
+double PreparedLoop::x_at(uint32_t edge, double y) const {
+  const Point2D& a = m_points_2d[edge];
+  const Point2D& b = m_points_2d[(edge + 1) % m_points_2d.size()];
+  if (a.y == b.y) {
+    return std::min(a.x, b.x);
+  }
+  return a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+}
+
+
+bool PreparedLoop::on_vertex(uint32_t index, const Point3D& point) const {
+  return m_points[index] == point;
+}
+
+
+bool PreparedLoop::on_edge(uint32_t edge, const Point3D& point) const {
+  const Point3D& a = m_points[edge];
+  const Point3D& b = m_points[(edge + 1) % m_points.size()];
+  const double ab_x = b.x - a.x;
+  const double ab_y = b.y - a.y;
+  const double ab_z = b.z - a.z;
+  const double ap_x = point.x - a.x;
+  const double ap_y = point.y - a.y;
+  const double ap_z = point.z - a.z;
+  const double length_squared = ab_x * ab_x + ab_y * ab_y + ab_z * ab_z;
+  double t = (ap_x * ab_x + ap_y * ab_y + ap_z * ab_z) / length_squared;
+  t = std::max(0.0, std::min(1.0, t));
+  const double d_x = ap_x - t * ab_x;
+  const double d_y = ap_y - t * ab_y;
+  const double d_z = ap_z - t * ab_z;
+  return d_x * d_x + d_y * d_y + d_z * d_z < Point3D::EPSILON * Point3D::EPSILON;
+}
+
+
+PointLoopClassify PreparedLoop::classify_point(const Point3D& point) const {
+  if (!point) {
+    throw std::invalid_argument("CW::PreparedLoop::classify_point(): Point3D given is null");
+  }
+  if (!m_plane.on_plane(point)) {
+    return PointLoopClassify::PointNotOnPlane;
+  }
+  const Point2D point_2d = this->project(point);
+  if (this->indexed()) {
+    return this->classify_indexed(point, point_2d);
+  }
+  return this->classify_linear(point, point_2d);
+}
+
+
+PointLoopClassify PreparedLoop::classify_linear(const Point3D& point, const Point2D& point_2d) const {
+  const uint32_t num_edges = static_cast<uint32_t>(m_points.size());
+  for (uint32_t i = 0; i < num_edges; ++i) {
+    if (this->on_vertex(i, point)) {
+      return PointLoopClassify::PointOnVertex;
+    }
+  }
+  for (uint32_t i = 0; i < num_edges; ++i) {
+    if (this->on_edge(i, point)) {
+      return PointLoopClassify::PointOnEdge;
+    }
+  }
+  // Count the edges crossed by a ray from the point in the -x direction.
+  size_t num_crossings = 0;
+  for (uint32_t i = 0; i < num_edges; ++i) {
+    const Point2D& a = m_points_2d[i];
+    const Point2D& b = m_points_2d[(i + 1) % num_edges];
+    if ((a.y <= point_2d.y) != (b.y <= point_2d.y) && this->x_at(i, point_2d.y) < point_2d.x) {
+      ++num_crossings;
+    }
+  }
+  return num_crossings % 2 == 0 ? PointLoopClassify::PointOutside : PointLoopClassify::PointInside;
+}
+
+
+PointLoopClassify PreparedLoop::classify_indexed(const Point3D& point, const Point2D& point_2d) const {
+  const uint32_t num_edges = static_cast<uint32_t>(m_points.size());
+  // Only vertices within tolerance of the point's height can be equal to it, or be the ends of horizontal edges it lies on.
+  auto band_begin = std::partition_point(m_points_by_y.begin(), m_points_by_y.end(), [this, &point_2d](uint32_t index) {
+    return m_points_2d[index].y <= point_2d.y - Point3D::EPSILON;
+  });
+  auto band_end = std::partition_point(band_begin, m_points_by_y.end(), [this, &point_2d](uint32_t index) {
+    return m_points_2d[index].y < point_2d.y + Point3D::EPSILON;
+  });
+  for (auto it = band_begin; it != band_end; ++it) {
+    if (this->on_vertex(*it, point)) {
+      return PointLoopClassify::PointOnVertex;
+    }
+  }
+  for (auto it = band_begin; it != band_end; ++it) {
+    if (this->on_edge(*it, point) || this->on_edge((*it + num_edges - 1) % num_edges, point)) {
+      return PointLoopClassify::PointOnEdge;
+    }
+  }
+
+  if (point_2d.y < m_slab_ys.front() || point_2d.y >= m_slab_ys.back()) {
+    return PointLoopClassify::PointOutside;
+  }
+  const size_t slab = std::upper_bound(m_slab_ys.begin(), m_slab_ys.end(), point_2d.y) - m_slab_ys.begin() - 1;
+  const auto edges_begin = m_slab_edges.begin() + m_slab_offsets[slab];
+  const auto edges_end = m_slab_edges.begin() + m_slab_offsets[slab + 1];
+  // The edges left of the point are the ones crossed by a ray in the -x direction.
+  const auto crossing_end = std::partition_point(edges_begin, edges_end, [this, &point_2d](uint32_t edge) {
+    return this->x_at(edge, point_2d.y) < point_2d.x;
+  });
+  // The edges nearest to the point are either side of it in the slab.
+  for (auto it = crossing_end - std::min<ptrdiff_t>(2, crossing_end - edges_begin); it != edges_end && it < crossing_end + 2; ++it) {
+    if (this->on_edge(*it, point)) {
+      return PointLoopClassify::PointOnEdge;
+    }
+  }
+  const size_t num_crossings = crossing_end - edges_begin;
+  return num_crossings % 2 == 0 ? PointLoopClassify::PointOutside : PointLoopClassify::PointInside;
+}
+
+
+const Plane3D& PreparedLoop::plane() const {
+  return m_plane;
+}
+
+
+size_t PreparedLoop::size() const {
+  return m_points.size();
+}
+
+
+bool PreparedLoop::indexed() const {
+  return !m_slab_ys.empty();
+}
+
+} /* namespace CW */
@@ -30,6 +30,7 @@
 #include "SUAPI-CppWrapper/model/RenderingOptions.hpp"
 #include "SUAPI-CppWrapper/String.hpp"
 #include "SUAPI-CppWrapper/model/TypedValue.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 #include <cassert>
 
 
@@ -55,16 +56,16 @@ std::vector<std::string> RenderingOptions::get_keys() const
   size_t len = 0, count = 0;
   SUResult res = SU_ERROR_NONE;
 
-  res = SURenderingOptionsGetNumKeys(m_rendering_options, &len);
+  res = CW_INSTRUMENT_SU(SURenderingOptionsGetNumKeys, m_rendering_options, &len);
   assert(res == SU_ERROR_NONE);
   assert(len > 0);
 
   std::vector<SUStringRef> refs(len, SU_INVALID);
   for(auto i = 0; i < len; i++) {
-    res = SUStringCreate(&refs[i]);
+    res = CW_INSTRUMENT_SU(SUStringCreate, &refs[i]);
     assert(res == SU_ERROR_NONE);
   }
-  res = SURenderingOptionsGetKeys(m_rendering_options, len, &refs[0], &count);
+  res = CW_INSTRUMENT_SU(SURenderingOptionsGetKeys, m_rendering_options, len, &refs[0], &count);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::vector<std::string> keys;
   for(auto ref : refs) {
@@ -78,9 +79,9 @@ TypedValue RenderingOptions::get_value(const std::string& key) const
   SUResult res = SU_ERROR_NONE;
   SUTypedValueRef tval = SU_INVALID;
   SUTypedValueRef* pTval = &tval;
-  res = SUTypedValueCreate(pTval);
+  res = CW_INSTRUMENT_SU(SUTypedValueCreate, pTval);
   assert(res == SU_ERROR_NONE);
-  res = SURenderingOptionsGetValue(m_rendering_options, key.c_str(), pTval);
+  res = CW_INSTRUMENT_SU(SURenderingOptionsGetValue, m_rendering_options, key.c_str(), pTval);
   assert(res == SU_ERROR_NONE); _unused(res);
   return TypedValue(*pTval);
 }
@@ -89,7 +90,7 @@ bool CW::RenderingOptions::set_value(const std::string& key, const TypedValue& t
 {
   SUResult res = SU_ERROR_NONE;
   SUTypedValueRef tref = tval.ref();
-  res = SURenderingOptionsSetValue(m_rendering_options, key.c_str(), tref);
+  res = CW_INSTRUMENT_SU(SURenderingOptionsSetValue, m_rendering_options, key.c_str(), tref);
   if(res == SU_ERROR_NONE)
     return true;
   else
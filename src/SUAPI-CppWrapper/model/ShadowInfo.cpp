@@ -30,6 +30,7 @@
 #include "SUAPI-CppWrapper/model/ShadowInfo.hpp"
 #include "SUAPI-CppWrapper/String.hpp"
 #include "SUAPI-CppWrapper/model/TypedValue.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 #include <cassert>
 
 
@@ -57,16 +58,16 @@ std::vector<std::string> ShadowInfo::get_keys()
   size_t len = 0, count = 0;
   SUResult res = SU_ERROR_NONE;
 
-  res = SUShadowInfoGetNumKeys(m_shadow_info, &len);
+  res = CW_INSTRUMENT_SU(SUShadowInfoGetNumKeys, m_shadow_info, &len);
   assert(res == SU_ERROR_NONE);
   assert(len > 0);
 
   std::vector<SUStringRef> refs(len, SU_INVALID);
   for(auto i = 0; i < len; i++) {
-    res = SUStringCreate(&refs[i]);
+    res = CW_INSTRUMENT_SU(SUStringCreate, &refs[i]);
     assert(res == SU_ERROR_NONE);
   }
-  res = SUShadowInfoGetKeys(m_shadow_info, len, &refs[0], &count);
+  res = CW_INSTRUMENT_SU(SUShadowInfoGetKeys, m_shadow_info, len, &refs[0], &count);
   assert(res == SU_ERROR_NONE); _unused(res);
   std::vector<std::string> keys;
   for(auto ref : refs) {
@@ -80,9 +81,9 @@ TypedValue ShadowInfo::get_value(const std::string& key)
   SUResult res = SU_ERROR_NONE;
   SUTypedValueRef tval = SU_INVALID;
   SUTypedValueRef* pTval = &tval;
-  res = SUTypedValueCreate(pTval);
+  res = CW_INSTRUMENT_SU(SUTypedValueCreate, pTval);
   assert(res == SU_ERROR_NONE);
-  res = SUShadowInfoGetValue(m_shadow_info, key.c_str(), pTval);
+  res = CW_INSTRUMENT_SU(SUShadowInfoGetValue, m_shadow_info, key.c_str(), pTval);
   assert(res == SU_ERROR_NONE); _unused(res);
   return TypedValue(*pTval);
 }
@@ -91,7 +92,7 @@ bool ShadowInfo::set_value(const std::string& key, const TypedValue& tval)
 {
   SUResult res = SU_ERROR_NONE;
   SUTypedValueRef tref = tval.ref();
-  res = SUShadowInfoSetValue(m_shadow_info, key.c_str(), tref);
+  res = CW_INSTRUMENT_SU(SUShadowInfoSetValue, m_shadow_info, key.c_str(), tref);
   if(res == SU_ERROR_NONE)
     return true;
   else
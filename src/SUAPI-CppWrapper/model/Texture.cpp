@@ -29,14 +29,75 @@
 #define _unused(x) ((void)(x))
 
 #include "SUAPI-CppWrapper/model/Texture.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
 #include <stdexcept>
 #include <stdio.h>
+#include <string>
+#ifdef WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "SUAPI-CppWrapper/model/ImageRep.hpp"
+#include "SUAPI-CppWrapper/model/Material.hpp"
 #include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 namespace CW {
+
+namespace {
+
+/**
+* Returns a temporary file path that is unique to this process and this call, so concurrent copies never share a file.
+*/
+std::string temporary_texture_path(const char* extension) {
+  static std::atomic<unsigned long> counter(0);
+#ifdef WIN32
+  const char* directory = std::getenv("TEMP");
+  const unsigned long process_id = static_cast<unsigned long>(_getpid());
+  const char separator = '\\';
+  const char* fallback_directory = ".";
+#else
+  const char* directory = std::getenv("TMPDIR");
+  const unsigned long process_id = static_cast<unsigned long>(getpid());
+  const char separator = '/';
+  const char* fallback_directory = "/tmp";
+#endif
+  std::string path = (directory != nullptr && directory[0] != '\0') ? directory : fallback_directory;
+  if (path.back() != separator) {
+    path += separator;
+  }
+  return path + "cw_texture_" + std::to_string(process_id) + "_" + std::to_string(counter++) + extension;
+}
+
+bool same_scale(double a, double b) {
+  return std::abs(a - b) <= 1.0e-12 * std::max(1.0, std::abs(a));
+}
+
+/**
+* Creates a texture with the given scale from the pixels of an image.  The C API only takes a scale when a texture is loaded from a file, so the pixels go through an uncompressed bitmap, which needs no image encoding.  Returns SU_INVALID if the bitmap could not be written or loaded.
+*/
+SUTextureRef create_scaled_texture(SUImageRepRef image, double s_scale, double t_scale) {
+  std::string file_path = temporary_texture_path(".bmp");
+  SUTextureRef texture = SU_INVALID;
+  if (CW_INSTRUMENT_SU(SUImageRepSaveToFile, image, file_path.c_str()) != SU_ERROR_NONE) {
+    std::remove(file_path.c_str());
+    return texture;
+  }
+  if (CW_INSTRUMENT_SU(SUTextureCreateFromFile, &texture, file_path.c_str(), s_scale, t_scale) != SU_ERROR_NONE) {
+    texture = SU_INVALID;
+  }
+  std::remove(file_path.c_str());
+  return texture;
+}
+
+} // namespace
+
 /******************************
 ** Private Static Methods *****
 *******************************/
@@ -44,14 +105,14 @@ namespace CW {
 SUTextureRef Texture::create_texture(ImageRep& image_rep) {
   SUImageRepRef image = image_rep.ref();
   SUTextureRef texture = SU_INVALID;
-  SUResult res = SUTextureCreateFromImageRep(&texture, image);
+  SUResult res = CW_INSTRUMENT_SU(SUTextureCreateFromImageRep, &texture, image);
   assert(res == SU_ERROR_NONE); _unused(res);
   return texture;
 }
 
 SUTextureRef Texture::create_texture(const std::string file_path, double s_scale, double t_scale) {
   SUTextureRef texture = SU_INVALID;
-  SUResult res = SUTextureCreateFromFile(&texture, file_path.c_str(), s_scale,t_scale);
+  SUResult res = CW_INSTRUMENT_SU(SUTextureCreateFromFile, &texture, file_path.c_str(), s_scale,t_scale);
   if (res != SU_ERROR_NONE) {
     return SU_INVALID;
   }
@@ -114,25 +175,96 @@ Texture::operator SUTextureRef() const {
 
 
 Texture Texture::copy() const {
-  // First create the file.
-  std::string file_path = "/tmp/tmptexture";
+  std::vector<SUByte> scratch;
+  return copy(scratch);
+}
+
+
+Texture Texture::copy(std::vector<SUByte>& scratch) const {
+  if (!(*this)) {
+    throw std::logic_error("CW::Texture::copy(): Texture is null");
+  }
+  size_t width = 0;
+  size_t height = 0;
+  double s_scale = 1.0;
+  double t_scale = 1.0;
+  SUResult res = CW_INSTRUMENT_SU(SUTextureGetDimensions, this->ref(), &width, &height, &s_scale, &t_scale);
+  assert(res == SU_ERROR_NONE);
+  // Read the pixels of the original image into the scratch buffer.
+  SUImageRepRef source_image = SU_INVALID;
+  res = CW_INSTRUMENT_SU(SUImageRepCreate, &source_image);
+  assert(res == SU_ERROR_NONE);
+  res = CW_INSTRUMENT_SU(SUTextureGetImageRep, this->ref(), &source_image);
+  assert(res == SU_ERROR_NONE);
+  size_t data_size = 0;
+  size_t bits_per_pixel = 0;
+  size_t row_padding = 0;
+  res = CW_INSTRUMENT_SU(SUImageRepGetDataSize, source_image, &data_size, &bits_per_pixel);
+  assert(res == SU_ERROR_NONE);
+  res = CW_INSTRUMENT_SU(SUImageRepGetRowPadding, source_image, &row_padding);
+  assert(res == SU_ERROR_NONE);
+  scratch.resize(data_size);
+  res = CW_INSTRUMENT_SU(SUImageRepGetData, source_image, data_size, scratch.data());
+  assert(res == SU_ERROR_NONE);
+  res = CW_INSTRUMENT_SU(SUImageRepRelease, &source_image);
+  assert(res == SU_ERROR_NONE);
+  // Build the new texture from a fresh image holding the same pixels.
+  SUImageRepRef new_image = SU_INVALID;
+  res = CW_INSTRUMENT_SU(SUImageRepCreate, &new_image);
+  assert(res == SU_ERROR_NONE);
+  res = CW_INSTRUMENT_SU(SUImageRepSetData, new_image, width, height, bits_per_pixel, row_padding, scratch.data());
+  assert(res == SU_ERROR_NONE);
+  SUTextureRef texture = SU_INVALID;
+  res = CW_INSTRUMENT_SU(SUTextureCreateFromImageRep, &texture, new_image);
+  assert(res == SU_ERROR_NONE);
+  double new_s_scale = 1.0;
+  double new_t_scale = 1.0;
+  res = CW_INSTRUMENT_SU(SUTextureGetDimensions, texture, &width, &height, &new_s_scale, &new_t_scale);
+  assert(res == SU_ERROR_NONE);
+  if (!same_scale(new_s_scale, s_scale) || !same_scale(new_t_scale, t_scale)) {
+    // @developers_notes There is no SUTextureSetDimensions() in the C API, and SUTextureCreateFromImageRep() takes no scale, so the scale is carried by loading the same pixels from a bitmap.
+    res = CW_INSTRUMENT_SU(SUTextureRelease, &texture);
+    assert(res == SU_ERROR_NONE);
+    texture = create_scaled_texture(new_image, s_scale, t_scale);
+  }
+  res = CW_INSTRUMENT_SU(SUImageRepRelease, &new_image);
+  assert(res == SU_ERROR_NONE); _unused(res);
+  if (SUIsInvalid(texture)) {
+    return copy_through_file();
+  }
+  Texture new_texture(texture, false);
+  new_texture.file_name(this->file_name());
+  return new_texture;
+}
+
+
+Texture Texture::copy_through_file() const {
+  std::string file_path = temporary_texture_path(".png");
   SUResult res = this->save(file_path);
   assert(res == SU_ERROR_NONE); _unused(res);
   Texture new_texture(file_path, s_scale(), t_scale());
   // Delete the temporary file
-  const char *file_path_c = file_path.c_str();
-  int ret = std::remove(file_path_c);
+  int ret = std::remove(file_path.c_str());
   assert(ret == 0); _unused(ret);
   // Reset the file name
   new_texture.file_name(this->file_name());
   return new_texture;
-  // @developers_notes Method below is efficient and simple, but fails to transfer the scale of the texture, due to the lack of SUTextureSetDimensions() function in the C API.  A workaround method is used for now shown above.
-  /*
-  ImageRep image_rep = this->image_rep().copy();
-  Texture new_texture(image_rep);
-  new_texture.file_name(this->file_name());
-  return new_texture;
-  */
+}
+
+
+std::vector<Texture> Texture::copy_textures(const std::vector<Material>& materials) {
+  std::vector<Texture> textures;
+  textures.reserve(materials.size());
+  std::vector<SUByte> scratch;
+  for (const Material& material : materials) {
+    Texture texture = material.texture();
+    if (!texture) {
+      textures.push_back(Texture());
+      continue;
+    }
+    textures.push_back(texture.copy(scratch));
+  }
+  return textures;
 }
 
 
@@ -141,7 +273,7 @@ bool Texture::alpha_used() const {
     throw std::logic_error("CW::Texture::alpha_used(): Texture is null");
   }
   bool alpha_channel_used;
-  SUResult res = SUTextureGetUseAlphaChannel(this->ref(), &alpha_channel_used);
+  SUResult res = CW_INSTRUMENT_SU(SUTextureGetUseAlphaChannel, this->ref(), &alpha_channel_used);
   assert(res == SU_ERROR_NONE); _unused(res);
   return alpha_channel_used;
 }
@@ -152,9 +284,9 @@ ImageRep Texture::image_rep() const {
     throw std::logic_error("CW::Texture::alpha_used(): Texture is null");
   }
   SUImageRepRef image_rep = SU_INVALID;
-  SUResult res = SUImageRepCreate(&image_rep);
+  SUResult res = CW_INSTRUMENT_SU(SUImageRepCreate, &image_rep);
   assert(res == SU_ERROR_NONE);
-  res = SUTextureGetImageRep(this->ref(), &image_rep);
+  res = CW_INSTRUMENT_SU(SUTextureGetImageRep, this->ref(), &image_rep);
   assert(res == SU_ERROR_NONE); _unused(res);
   return ImageRep(image_rep);
 }
@@ -163,15 +295,15 @@ ImageRep Texture::image_rep() const {
 String Texture::file_name() const {
   String name;
   SUStringRef file_ref = name.ref();
-  SUResult res = SUTextureGetFileName(this->ref(), &file_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUTextureGetFileName, this->ref(), &file_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return name;
 }
 
 
 void Texture::file_name(const String& string) const {
-  const char* chars = string.std_string().c_str();
-  SUResult res = SUTextureSetFileName(this->ref(), chars);
+  std::string chars = string.std_string();
+  SUResult res = CW_INSTRUMENT_SU(SUTextureSetFileName, this->ref(), chars.c_str());
   assert(res == SU_ERROR_NONE); _unused(res);
 }
 
@@ -184,7 +316,7 @@ size_t Texture::width() const {
   size_t height;
   double s_scale;
   double t_scale;
-  SUResult res = SUTextureGetDimensions(this->ref(), &width, &height, &s_scale, &t_scale);
+  SUResult res = CW_INSTRUMENT_SU(SUTextureGetDimensions, this->ref(), &width, &height, &s_scale, &t_scale);
   assert(res == SU_ERROR_NONE); _unused(res);
   return width;
 }
@@ -198,7 +330,7 @@ size_t Texture::height() const {
   size_t height;
   double s_scale;
   double t_scale;
-  SUResult res = SUTextureGetDimensions(this->ref(), &width, &height, &s_scale, &t_scale);
+  SUResult res = CW_INSTRUMENT_SU(SUTextureGetDimensions, this->ref(), &width, &height, &s_scale, &t_scale);
   assert(res == SU_ERROR_NONE); _unused(res);
   return height;
 }
@@ -212,7 +344,7 @@ double Texture::s_scale() const {
   size_t height;
   double s_scale;
   double t_scale;
-  SUResult res = SUTextureGetDimensions(this->ref(), &width, &height, &s_scale, &t_scale);
+  SUResult res = CW_INSTRUMENT_SU(SUTextureGetDimensions, this->ref(), &width, &height, &s_scale, &t_scale);
   assert(res == SU_ERROR_NONE); _unused(res);
   return s_scale;
 }
@@ -226,7 +358,7 @@ double Texture::t_scale() const {
   size_t height;
   double s_scale;
   double t_scale;
-  SUResult res = SUTextureGetDimensions(this->ref(), &width, &height, &s_scale, &t_scale);
+  SUResult res = CW_INSTRUMENT_SU(SUTextureGetDimensions, this->ref(), &width, &height, &s_scale, &t_scale);
   assert(res == SU_ERROR_NONE); _unused(res);
   return t_scale;
 }
@@ -234,7 +366,7 @@ double Texture::t_scale() const {
 
 SUResult Texture::save(const std::string& file_path) const {
   const char *cstr = file_path.c_str();
-  SUResult res = SUTextureWriteToFile(this->ref(), cstr);
+  SUResult res = CW_INSTRUMENT_SU(SUTextureWriteToFile, this->ref(), cstr);
   return res;
 }
 
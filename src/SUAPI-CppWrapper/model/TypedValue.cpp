@@ -35,6 +35,8 @@
 #include "SUAPI-CppWrapper/Color.hpp"
 #include "SUAPI-CppWrapper/Geometry.hpp"
 #include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
 
 namespace CW {
 
@@ -47,7 +49,11 @@ TypedValue::TypedValue():
 TypedValue::TypedValue(SUTypedValueRef typed_val, bool attached):
   m_typed_value(typed_val),
   m_attached(attached)
-{}
+{
+  if (!m_attached && SUIsValid(m_typed_value)) {
+    RefTracker::acquired(RefKind::TypedValue, m_typed_value.ptr);
+  }
+}
  
  
 TypedValue::TypedValue(const char chars[]):
@@ -72,6 +78,15 @@ TypedValue::TypedValue(const TypedValue& other):
 }
 
 
+TypedValue::TypedValue(TypedValue&& other) noexcept:
+  m_typed_value(other.m_typed_value),
+  m_attached(other.m_attached)
+{
+  other.m_typed_value = SU_INVALID;
+  other.m_attached = false;
+}
+
+
 TypedValue& TypedValue::operator= (const TypedValue& other) {
   switch (other.get_type()) {
     case SUTypedValueType_Array:
@@ -119,6 +134,23 @@ TypedValue& TypedValue::operator= (const TypedValue& other) {
 }
 
 
+TypedValue& TypedValue::operator= (TypedValue&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (SUIsValid(m_typed_value) && !m_attached) {
+    RefTracker::released(RefKind::TypedValue, m_typed_value.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUTypedValueRelease, &m_typed_value);
+    assert(res == SU_ERROR_NONE); _unused(res);
+  }
+  m_typed_value = other.m_typed_value;
+  m_attached = other.m_attached;
+  other.m_typed_value = SU_INVALID;
+  other.m_attached = false;
+  return *this;
+}
+
+
 SUTypedValueRef TypedValue::ref() const {
   return m_typed_value;
 }
@@ -156,15 +188,17 @@ bool TypedValue::empty() const {
 */
 SUTypedValueRef TypedValue::create_typed_value() {
   SUTypedValueRef typed_value = SU_INVALID;
-  SUResult res = SUTypedValueCreate(&typed_value);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueCreate, &typed_value);
   assert(res == SU_ERROR_NONE); _unused(res);
+  RefTracker::acquired(RefKind::TypedValue, typed_value.ptr);
   return typed_value;
 }
 
 
 TypedValue::~TypedValue() {
   if (SUIsValid(m_typed_value) && !m_attached) {
-    SUResult res = SUTypedValueRelease(&m_typed_value);
+    RefTracker::released(RefKind::TypedValue, m_typed_value.ptr);
+    SUResult res = CW_INSTRUMENT_SU(SUTypedValueRelease, &m_typed_value);
     assert(res == SU_ERROR_NONE); _unused(res);
   }
 }
@@ -175,7 +209,7 @@ SUTypedValueType TypedValue::get_type() const {
     throw std::logic_error("CW::TypedValue::get_type(): TypedValue is null");
   }
   SUTypedValueType type;
-  SUResult res = SUTypedValueGetType(m_typed_value, &type);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetType, m_typed_value, &type);
   assert(res == SU_ERROR_NONE); _unused(res);
   return type;
 }
@@ -189,7 +223,7 @@ char TypedValue::byte_value() const {
     throw std::logic_error("CW::TypedValue::byte_value(): TypedValue is not SUTypedValueType_Byte type");
   }
   char byte_val;
-  SUResult res = SUTypedValueGetByte(m_typed_value, &byte_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetByte, m_typed_value, &byte_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return byte_val;
 }
@@ -199,7 +233,7 @@ TypedValue& TypedValue::byte_value(const char byte_val) {
   if (!(*this)) {
     m_typed_value = create_typed_value();
   }
-  SUResult res = SUTypedValueSetByte(m_typed_value, byte_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetByte, m_typed_value, byte_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -218,7 +252,7 @@ int16_t TypedValue::int16_value() const {
     throw std::logic_error("CW::TypedValue::int16_value(): TypedValue is not SUTypedValueType_Short (Int16) type");
   }
   int16_t int16_val;
-  SUResult res = SUTypedValueGetInt16(m_typed_value, &int16_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetInt16, m_typed_value, &int16_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return int16_val;
 }
@@ -228,7 +262,7 @@ TypedValue& TypedValue::int16_value(const int16_t int16_val) {
   if (!(*this)) {
     m_typed_value = create_typed_value();
   }
-  SUResult res = SUTypedValueSetInt16(m_typed_value, int16_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetInt16, m_typed_value, int16_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -247,7 +281,7 @@ int32_t TypedValue::int32_value() const {
     throw std::logic_error("CW::TypedValue::int32_value(): TypedValue is not SUTypedValueType_Int32 type");
   }
   int32_t int32_val;
-  SUResult res = SUTypedValueGetInt32(m_typed_value, &int32_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetInt32, m_typed_value, &int32_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return int32_val;
 }
@@ -257,7 +291,7 @@ TypedValue& TypedValue::int32_value(const int32_t int32_val) {
   if (!(*this)) {
     m_typed_value = create_typed_value();
   }
-  SUResult res = SUTypedValueSetInt32(m_typed_value, int32_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetInt32, m_typed_value, int32_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -276,7 +310,7 @@ float TypedValue::float_value() const{
     throw std::logic_error("CW::TypedValue::float_value(): TypedValue is not SUTypedValueType_Float type");
   }
   float float_val;
-  SUResult res = SUTypedValueGetFloat(m_typed_value, &float_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetFloat, m_typed_value, &float_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return float_val;
 }
@@ -286,7 +320,7 @@ TypedValue& TypedValue::float_value(const float float_val) {
   if (!(*this)) {
     m_typed_value = create_typed_value();
   }
-  SUResult res = SUTypedValueSetFloat(m_typed_value, float_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetFloat, m_typed_value, float_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -305,7 +339,7 @@ double TypedValue::double_value() const {
     throw std::logic_error("CW::TypedValue::double_value(): TypedValue is not SUTypedValueType_Double type");
   }
   double double_val;
-  SUResult res = SUTypedValueGetDouble(m_typed_value, &double_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetDouble, m_typed_value, &double_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return double_val;
 }
@@ -315,7 +349,7 @@ TypedValue& TypedValue::double_value(const double double_val) {
   if (!(*this)) {
     m_typed_value = create_typed_value();
   }
-  SUResult res = SUTypedValueSetDouble(m_typed_value, double_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetDouble, m_typed_value, double_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -334,7 +368,7 @@ bool TypedValue::bool_value() const {
     throw std::logic_error("CW::TypedValue::bool_value(): TypedValue is not SUTypedValueType_Bool type");
   }
   bool bool_val;
-  SUResult res = SUTypedValueGetBool(m_typed_value, &bool_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetBool, m_typed_value, &bool_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return bool_val;
 }
@@ -344,7 +378,7 @@ TypedValue& TypedValue::bool_value(const bool bool_val) {
   if (!(*this)) {
     m_typed_value = create_typed_value();
   }
-  SUResult res = SUTypedValueSetBool(m_typed_value, bool_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetBool, m_typed_value, bool_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -363,7 +397,7 @@ Color TypedValue::color_value() const {
     throw std::logic_error("CW::TypedValue::color_value(): TypedValue is not SUTypedValueType_Color type");
   }
   SUColor color_val;
-  SUResult res = SUTypedValueGetColor(m_typed_value, &color_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetColor, m_typed_value, &color_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Color(color_val);
 }
@@ -374,7 +408,7 @@ TypedValue& TypedValue::color_value(const Color &color_val) {
     m_typed_value = create_typed_value();
   }
   SUColor color = color_val.ref();
-  SUResult res = SUTypedValueSetColor(m_typed_value, &color);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetColor, m_typed_value, &color);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -393,7 +427,7 @@ int64_t TypedValue::time_value() const {
     throw std::logic_error("CW::TypedValue::time_value(): TypedValue is not SUTypedValueType_Time type");
   }
   int64_t time_val;
-  SUResult res = SUTypedValueGetTime(m_typed_value, &time_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetTime, m_typed_value, &time_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return time_val;
 }
@@ -403,7 +437,7 @@ TypedValue& TypedValue::time_value(const int64_t time_val) {
   if (!(*this)) {
     m_typed_value = create_typed_value();
   }
-  SUResult res = SUTypedValueSetTime(m_typed_value, time_val);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetTime, m_typed_value, time_val);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -423,7 +457,7 @@ String TypedValue::string_value() const {
   }
   String string;
   SUStringRef &string_ref = string;
-  SUResult res = SUTypedValueGetString(m_typed_value, &string_ref);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetString, m_typed_value, &string_ref);
   assert(res == SU_ERROR_NONE); _unused(res);
   return string;
 }
@@ -434,8 +468,9 @@ TypedValue& TypedValue::string_value(const String &string_val) {
     m_typed_value = create_typed_value();
   }
   std::string std_string = string_val;
-  SUResult res = SUTypedValueSetString(m_typed_value, std_string.c_str());
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetString, m_typed_value, std_string.c_str());
   assert(res == SU_ERROR_NONE); _unused(res);
+  CW_INSTRUMENT_BYTES("CW::TypedValue", std_string.size());
   return *this;
 }
 
@@ -463,7 +498,7 @@ Vector3D TypedValue::vector_value() const {
     throw std::logic_error("CW::TypedValue::vector_value(): TypedValue is not SUTypedValueType_Vector3D type");
   }
   double vector3d_value[3];
-  SUResult res = SUTypedValueGetVector3d(m_typed_value, &vector3d_value[0]);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetVector3d, m_typed_value, &vector3d_value[0]);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Vector3D(vector3d_value[0], vector3d_value[1], vector3d_value[2]);
 }
@@ -474,7 +509,7 @@ TypedValue& TypedValue::vector_value(const Vector3D &vector_val) {
     m_typed_value = create_typed_value();
   }
   double vector3d_value[3] = {vector_val.x, vector_val.y, vector_val.z};
-  SUResult res = SUTypedValueSetVector3d(m_typed_value, &vector3d_value[0]);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueSetVector3d, m_typed_value, &vector3d_value[0]);
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -493,10 +528,10 @@ std::vector<TypedValue> TypedValue::typed_value_array() const {
     throw std::logic_error("CW::TypedValue::typed_value_array(): TypedValue is not SUTypedValueType_Array type");
   }
   size_t count = 0;
-  SUResult res = SUTypedValueGetNumArrayItems(m_typed_value, &count);
+  SUResult res = CW_INSTRUMENT_SU(SUTypedValueGetNumArrayItems, m_typed_value, &count);
   assert(res == SU_ERROR_NONE);
   std::vector<SUTypedValueRef> value_refs(count, SU_INVALID);
-  res = SUTypedValueGetArrayItems(m_typed_value, count, value_refs.data(), &count);
+  res = CW_INSTRUMENT_SU(SUTypedValueGetArrayItems, m_typed_value, count, value_refs.data(), &count);
   assert(res == SU_ERROR_NONE); _unused(res);
   // TypedValue from TypedValue arrays should not actually be released.  This poses a problem for the wrapper object which will want to release it.  The solution is to copy these special TypedValues that don't release into new TypedValue objects that do.
   std::vector<TypedValue> temp_vals(count);
@@ -521,7 +556,7 @@ TypedValue& TypedValue::typed_value_array(std::vector<TypedValue> &typed_val_arr
   std::vector<SUTypedValueRef> refs{typed_val_array.size(), SU_INVALID };
   std::transform(typed_val_array.begin(), typed_val_array.end(), refs.begin(),
     [](const CW::TypedValue& typed_value) {return typed_value.ref(); });
-  res = SUTypedValueSetArrayItems(m_typed_value, refs.size(), refs.data());
+  res = CW_INSTRUMENT_SU(SUTypedValueSetArrayItems, m_typed_value, refs.size(), refs.data());
   assert(res == SU_ERROR_NONE); _unused(res);
   return *this;
 }
@@ -29,6 +29,7 @@
 #define _unused(x) ((void)(x))
 
 #include "SUAPI-CppWrapper/model/Vertex.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
 
 #include <cassert>
 #include <stdexcept>
@@ -77,11 +78,12 @@ Vertex& Vertex::operator=(const Vertex& other) {
 ** Public Methods **
 ********************/
 Point3D Vertex::position() const {
+  CW_INSTRUMENT_METHOD("CW::Vertex::position");
   if (!(*this)) {
     throw std::logic_error("CW::Vertex::position(): Vertex is null");
   }
   SUPoint3D point;
-  SUResult res = SUVertexGetPosition(this->ref(), &point);
+  SUResult res = CW_INSTRUMENT_SU(SUVertexGetPosition, this->ref(), &point);
   assert(res == SU_ERROR_NONE); _unused(res);
   return Point3D(point);
 }
@@ -0,0 +1,541 @@
+//
+//  Component.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MemoryAPI.hpp"
+
+using namespace SUMemory;
+
+SUResult SUComponentDefinitionCreate(SUComponentDefinitionRef* comp_def) {
+  return create<ComponentDefinition>(comp_def, SUComponentType_Normal);
+}
+
+
+SUResult SUComponentDefinitionRelease(SUComponentDefinitionRef* comp_def) {
+  return release_entity<ComponentDefinition>(comp_def);
+}
+
+
+SUEntityRef SUComponentDefinitionToEntity(SUComponentDefinitionRef comp_def) {
+  return convert<ComponentDefinition, SUEntityRef>(comp_def);
+}
+
+
+SUComponentDefinitionRef SUComponentDefinitionFromEntity(SUEntityRef entity) {
+  return convert<ComponentDefinition, SUComponentDefinitionRef>(entity);
+}
+
+
+SUDrawingElementRef SUComponentDefinitionToDrawingElement(SUComponentDefinitionRef comp_def) {
+  return convert<ComponentDefinition, SUDrawingElementRef>(comp_def);
+}
+
+
+SUResult SUComponentDefinitionGetName(SUComponentDefinitionRef comp_def, SUStringRef* name) {
+  const ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_string(name, definition->name);
+}
+
+
+SUResult SUComponentDefinitionSetName(SUComponentDefinitionRef comp_def, const char* name) {
+  ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  definition->name = name;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUComponentDefinitionGetType(SUComponentDefinitionRef comp_def, enum SUComponentType* type) {
+  const ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(type, definition->component_type);
+}
+
+
+SUResult SUComponentDefinitionGetBehavior(SUComponentDefinitionRef comp_def, struct SUComponentBehavior* behavior) {
+  const ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(behavior, definition->behavior);
+}
+
+
+SUResult SUComponentDefinitionSetBehavior(SUComponentDefinitionRef comp_def, const struct SUComponentBehavior* behavior) {
+  ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (behavior == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  definition->behavior = *behavior;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUComponentDefinitionGetEntities(SUComponentDefinitionRef comp_def, SUEntitiesRef* entities) {
+  ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(entities, to_ref<SUEntitiesRef>(&definition->entities));
+}
+
+
+SUResult SUComponentDefinitionCreateInstance(SUComponentDefinitionRef comp_def, SUComponentInstanceRef* instance) {
+  ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  SUResult result = create<ComponentInstance>(instance, SURefType_ComponentInstance);
+  if (result == SU_ERROR_NONE) {
+    ComponentInstance* created = get<ComponentInstance>(*instance);
+    created->definition = definition;
+    definition->instances.push_back(created);
+  }
+  return result;
+}
+
+
+SUResult SUComponentDefinitionGetNumInstances(SUComponentDefinitionRef comp_def, size_t* count) {
+  const ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(definition->instances, count);
+}
+
+
+SUResult SUComponentDefinitionGetNumUsedInstances(SUComponentDefinitionRef comp_def, size_t* count) {
+  const ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (count == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *count = size_t(std::count_if(definition->instances.begin(), definition->instances.end(), [](const ComponentInstance* instance) {
+    return instance->attached;
+  }));
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUComponentDefinitionGetInstances(SUComponentDefinitionRef comp_def, size_t len, SUComponentInstanceRef instances[], size_t* count) {
+  const ComponentDefinition* definition = get<ComponentDefinition>(comp_def);
+  if (definition == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(definition->instances, len, instances, count);
+}
+
+
+SUResult SUComponentInstanceRelease(SUComponentInstanceRef* instance) {
+  if (instance == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  ComponentInstance* instance_object = get<ComponentInstance>(*instance);
+  if (instance_object != nullptr && !instance_object->attached) {
+    std::vector<ComponentInstance*>& instances = instance_object->definition->instances;
+    instances.erase(std::remove(instances.begin(), instances.end(), instance_object), instances.end());
+  }
+  return release_entity<ComponentInstance>(instance);
+}
+
+
+SUEntityRef SUComponentInstanceToEntity(SUComponentInstanceRef instance) {
+  return convert<ComponentInstance, SUEntityRef>(instance);
+}
+
+
+SUComponentInstanceRef SUComponentInstanceFromEntity(SUEntityRef entity) {
+  return convert<ComponentInstance, SUComponentInstanceRef>(entity);
+}
+
+
+SUDrawingElementRef SUComponentInstanceToDrawingElement(SUComponentInstanceRef instance) {
+  return convert<ComponentInstance, SUDrawingElementRef>(instance);
+}
+
+
+SUResult SUComponentInstanceGetDefinition(SUComponentInstanceRef instance, SUComponentDefinitionRef* component) {
+  const ComponentInstance* instance_object = get<ComponentInstance>(instance);
+  if (instance_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(component, to_ref<SUComponentDefinitionRef>(instance_object->definition));
+}
+
+
+SUResult SUComponentInstanceGetName(SUComponentInstanceRef instance, SUStringRef* name) {
+  const ComponentInstance* instance_object = get<ComponentInstance>(instance);
+  if (instance_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_string(name, instance_object->name);
+}
+
+
+SUResult SUComponentInstanceSetName(SUComponentInstanceRef instance, const char* name) {
+  ComponentInstance* instance_object = get<ComponentInstance>(instance);
+  if (instance_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  instance_object->name = name;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUComponentInstanceGetTransform(SUComponentInstanceRef instance, struct SUTransformation* transform) {
+  const ComponentInstance* instance_object = get<ComponentInstance>(instance);
+  if (instance_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(transform, instance_object->transform);
+}
+
+
+SUResult SUComponentInstanceSetTransform(SUComponentInstanceRef instance, const struct SUTransformation* transform) {
+  ComponentInstance* instance_object = get<ComponentInstance>(instance);
+  if (instance_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  instance_object->transform = *transform;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGroupCreate(SUGroupRef* group) {
+  SUResult result = create<ComponentInstance>(group, SURefType_Group);
+  if (result == SU_ERROR_NONE) {
+    // A group owns its definition, which joins the model with the group.
+    ComponentInstance* created = get_group(*group);
+    ComponentDefinition* definition = new ComponentDefinition(SUComponentType_Group);
+    definition->name = "Group";
+    definition->attached = true;
+    definition->instances.push_back(created);
+    created->definition = definition;
+    created->take(definition);
+  }
+  return result;
+}
+
+
+SUGroupRef SUGroupFromEntity(SUEntityRef entity) {
+  return to_ref<SUGroupRef>(get_group(entity));
+}
+
+
+SUGroupRef SUGroupFromComponentInstance(SUComponentInstanceRef component_inst) {
+  return to_ref<SUGroupRef>(get_group(component_inst));
+}
+
+
+SUComponentInstanceRef SUGroupToComponentInstance(SUGroupRef group) {
+  return to_ref<SUComponentInstanceRef>(get_group(group));
+}
+
+
+SUResult SUGroupGetDefinition(SUGroupRef group, SUComponentDefinitionRef* component) {
+  const ComponentInstance* group_object = get_group(group);
+  if (group_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(component, to_ref<SUComponentDefinitionRef>(group_object->definition));
+}
+
+
+SUResult SUGroupGetEntities(SUGroupRef group, SUEntitiesRef* entities) {
+  const ComponentInstance* group_object = get_group(group);
+  if (group_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(entities, to_ref<SUEntitiesRef>(&group_object->definition->entities));
+}
+
+
+SUResult SUGroupGetName(SUGroupRef group, SUStringRef* name) {
+  return SUComponentInstanceGetName(SUGroupToComponentInstance(group), name);
+}
+
+
+SUResult SUGroupSetName(SUGroupRef group, const char* name) {
+  return SUComponentInstanceSetName(SUGroupToComponentInstance(group), name);
+}
+
+
+SUResult SUGroupGetTransform(SUGroupRef group, struct SUTransformation* transform) {
+  return SUComponentInstanceGetTransform(SUGroupToComponentInstance(group), transform);
+}
+
+
+SUResult SUGroupSetTransform(SUGroupRef group, const struct SUTransformation* transform) {
+  return SUComponentInstanceSetTransform(SUGroupToComponentInstance(group), transform);
+}
+
+
+namespace {
+
+/**
+* The instances of a path followed by its leaf, if it has one.
+*/
+std::vector<Object*> path_objects(const InstancePath& path) {
+  std::vector<Object*> objects(path.instances.begin(), path.instances.end());
+  if (path.leaf != nullptr) {
+    objects.push_back(path.leaf);
+  }
+  return objects;
+}
+
+std::string path_pid(const std::vector<Object*>& objects, size_t count) {
+  std::string pid;
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0) {
+      pid += ".";
+    }
+    pid += std::to_string(objects[i]->pid);
+  }
+  return pid;
+}
+
+SUTransformation path_transform(const InstancePath& path, size_t count) {
+  SUTransformation transform = identity();
+  for (size_t i = 0; i < count; ++i) {
+    transform = multiply(transform, path.instances[i]->transform);
+  }
+  return transform;
+}
+
+} // namespace
+
+
+SUResult SUInstancePathCreate(SUInstancePathRef* instance_path) {
+  return create<InstancePath>(instance_path);
+}
+
+
+SUResult SUInstancePathCreateCopy(SUInstancePathRef* instance_path, SUInstancePathRef source_path) {
+  const InstancePath* source = get<InstancePath>(source_path);
+  if (source == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  SUResult result = create<InstancePath>(instance_path);
+  if (result == SU_ERROR_NONE) {
+    InstancePath* copy = get<InstancePath>(*instance_path);
+    copy->instances = source->instances;
+    copy->leaf = source->leaf;
+  }
+  return result;
+}
+
+
+SUResult SUInstancePathRelease(SUInstancePathRef* instance_path) {
+  return release<InstancePath>(instance_path);
+}
+
+
+SUResult SUInstancePathPushInstance(SUInstancePathRef instance_path, SUComponentInstanceRef component_instance) {
+  InstancePath* path = get<InstancePath>(instance_path);
+  ComponentInstance* instance = get<ComponentInstance>(component_instance);
+  if (path == nullptr || instance == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  path->instances.push_back(instance);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUInstancePathPopInstance(SUInstancePathRef instance_path) {
+  InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (!path->instances.empty()) {
+    path->instances.pop_back();
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUInstancePathSetLeaf(SUInstancePathRef instance_path, SUEntityRef entity) {
+  InstancePath* path = get<InstancePath>(instance_path);
+  Object* leaf = get<Object>(entity);
+  if (path == nullptr || leaf == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  path->leaf = leaf;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUInstancePathGetPathDepth(SUInstancePathRef instance_path, size_t* depth) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(path->instances, depth);
+}
+
+
+SUResult SUInstancePathGetFullDepth(SUInstancePathRef instance_path, size_t* full_depth) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(path_objects(*path), full_depth);
+}
+
+
+SUResult SUInstancePathGetTransform(SUInstancePathRef instance_path, struct SUTransformation* transform) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(transform, path_transform(*path, path->instances.size()));
+}
+
+
+SUResult SUInstancePathGetTransformAtDepth(SUInstancePathRef instance_path, size_t depth, struct SUTransformation* transform) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (depth >= path->instances.size()) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  return set_value(transform, path_transform(*path, depth + 1));
+}
+
+
+SUResult SUInstancePathGetInstanceAtDepth(SUInstancePathRef instance_path, size_t depth, SUComponentInstanceRef* instance) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (depth >= path->instances.size()) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  return set_value(instance, to_ref<SUComponentInstanceRef>(path->instances[depth]));
+}
+
+
+SUResult SUInstancePathGetLeafAsEntity(SUInstancePathRef instance_path, SUEntityRef* entity) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(entity, to_ref<SUEntityRef>(path->leaf));
+}
+
+
+SUResult SUInstancePathGetLeaf(SUInstancePathRef instance_path, SUDrawingElementRef* drawing_element) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(drawing_element, to_ref<SUDrawingElementRef>(cast<DrawingElement>(path->leaf)));
+}
+
+
+SUResult SUInstancePathIsEmpty(SUInstancePathRef instance_path, bool* empty) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(empty, path->instances.empty() && path->leaf == nullptr);
+}
+
+
+SUResult SUInstancePathIsValid(SUInstancePathRef instance_path, bool* valid) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  // Each object must be in the entities of the instance before it, starting from the entities of a model.
+  const std::vector<Object*> objects = path_objects(*path);
+  bool result = !objects.empty();
+  const Entities* entities = nullptr;
+  for (const Object* object : objects) {
+    if (!result) {
+      break;
+    }
+    result = object->parent != nullptr && (entities == nullptr ? object->parent->definition == nullptr : object->parent == entities);
+    if (ComponentInstance::accepts(object->type)) {
+      entities = &static_cast<const ComponentInstance*>(object)->definition->entities;
+    }
+  }
+  return set_value(valid, result);
+}
+
+
+SUResult SUInstancePathContains(SUInstancePathRef instance_path, SUEntityRef entity, bool* contains) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  const std::vector<Object*> objects = path_objects(*path);
+  return set_value(contains, std::find(objects.begin(), objects.end(), get<Object>(entity)) != objects.end());
+}
+
+
+SUResult SUInstancePathGetPersistentID(SUInstancePathRef instance_path, SUStringRef* pid) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  const std::vector<Object*> objects = path_objects(*path);
+  return set_string(pid, path_pid(objects, objects.size()));
+}
+
+
+SUResult SUInstancePathGetPersistentIDAtDepth(SUInstancePathRef instance_path, size_t depth, SUStringRef* pid) {
+  const InstancePath* path = get<InstancePath>(instance_path);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  const std::vector<Object*> objects = path_objects(*path);
+  if (depth >= objects.size()) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  return set_string(pid, path_pid(objects, depth + 1));
+}
@@ -0,0 +1,269 @@
+//
+//  Edge.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MemoryAPI.hpp"
+
+namespace SUMemory {
+
+Edge* create_edge(const SUPoint3D& start, const SUPoint3D& end) {
+  Edge* edge = new Edge();
+  edge->start = new Vertex(start);
+  edge->end = new Vertex(end);
+  edge->start->attached = true;
+  edge->end->attached = true;
+  edge->take(edge->start);
+  edge->take(edge->end);
+  return edge;
+}
+
+} // namespace SUMemory
+
+using namespace SUMemory;
+
+
+SUResult SUEdgeCreate(SUEdgeRef* edge, const struct SUPoint3D* start, const struct SUPoint3D* end) {
+  if (start == nullptr || end == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  SUResult result = check_create(edge);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (same_position(*start, *end)) {
+    return SU_ERROR_GENERIC;
+  }
+  *edge = to_ref<SUEdgeRef>(create_edge(*start, *end));
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEdgeRelease(SUEdgeRef* edge) {
+  return release_entity<Edge>(edge);
+}
+
+
+SUEntityRef SUEdgeToEntity(SUEdgeRef edge) {
+  return convert<Edge, SUEntityRef>(edge);
+}
+
+
+SUEdgeRef SUEdgeFromEntity(SUEntityRef entity) {
+  return convert<Edge, SUEdgeRef>(entity);
+}
+
+
+SUDrawingElementRef SUEdgeToDrawingElement(SUEdgeRef edge) {
+  return convert<Edge, SUDrawingElementRef>(edge);
+}
+
+
+SUResult SUEdgeGetStartVertex(SUEdgeRef edge, SUVertexRef* vertex) {
+  const Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(vertex, to_ref<SUVertexRef>(edge_object->start));
+}
+
+
+SUResult SUEdgeGetEndVertex(SUEdgeRef edge, SUVertexRef* vertex) {
+  const Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(vertex, to_ref<SUVertexRef>(edge_object->end));
+}
+
+
+SUResult SUEdgeGetNumFaces(SUEdgeRef edge, size_t* count) {
+  const Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(edge_object->faces, count);
+}
+
+
+SUResult SUEdgeGetFaces(SUEdgeRef edge, size_t len, SUFaceRef faces[], size_t* count) {
+  const Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(edge_object->faces, len, faces, count);
+}
+
+
+SUResult SUEdgeGetSoft(SUEdgeRef edge, bool* soft_flag) {
+  const Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(soft_flag, edge_object->soft);
+}
+
+
+SUResult SUEdgeSetSoft(SUEdgeRef edge, bool soft_flag) {
+  Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  edge_object->soft = soft_flag;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEdgeGetSmooth(SUEdgeRef edge, bool* smooth_flag) {
+  const Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(smooth_flag, edge_object->smooth);
+}
+
+
+SUResult SUEdgeSetSmooth(SUEdgeRef edge, bool smooth_flag) {
+  Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  edge_object->smooth = smooth_flag;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEdgeGetColor(SUEdgeRef edge, SUColor* color) {
+  const Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(color, edge_object->color);
+}
+
+
+SUResult SUEdgeSetColor(SUEdgeRef edge, const SUColor* color) {
+  Edge* edge_object = get<Edge>(edge);
+  if (edge_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (color == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  edge_object->color = *color;
+  return SU_ERROR_NONE;
+}
+
+
+SUEntityRef SUVertexToEntity(SUVertexRef vertex) {
+  return convert<Vertex, SUEntityRef>(vertex);
+}
+
+
+SUVertexRef SUVertexFromEntity(SUEntityRef entity) {
+  return convert<Vertex, SUVertexRef>(entity);
+}
+
+
+SUResult SUVertexGetPosition(SUVertexRef vertex, struct SUPoint3D* position) {
+  const Vertex* vertex_object = get<Vertex>(vertex);
+  if (vertex_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(position, vertex_object->position);
+}
+
+
+SUResult SUCurveCreateWithEdges(SUCurveRef* curve, const SUEdgeRef edges[], size_t len) {
+  if (edges == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  SUResult result = check_create(curve);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (len == 0) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  for (size_t i = 0; i < len; ++i) {
+    const Edge* edge = get<Edge>(edges[i]);
+    if (edge == nullptr) {
+      return SU_ERROR_INVALID_INPUT;
+    }
+    if (!edge->faces.empty()) {
+      return SU_ERROR_GENERIC;
+    }
+  }
+  // The curve takes over the edges the caller owns.
+  Curve* created = new Curve();
+  for (size_t i = 0; i < len; ++i) {
+    Edge* edge = get<Edge>(edges[i]);
+    edge->curve = created;
+    if (!edge->attached) {
+      edge->attached = true;
+      created->take(edge);
+    }
+    created->edges.push_back(edge);
+  }
+  *curve = to_ref<SUCurveRef>(created);
+  return SU_ERROR_NONE;
+}
+
+
+SUEntityRef SUCurveToEntity(SUCurveRef curve) {
+  return convert<Curve, SUEntityRef>(curve);
+}
+
+
+SUCurveRef SUCurveFromEntity(SUEntityRef entity) {
+  return convert<Curve, SUCurveRef>(entity);
+}
+
+
+SUResult SUCurveGetType(SUCurveRef curve, enum SUCurveType* type) {
+  const Curve* curve_object = get<Curve>(curve);
+  if (curve_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(type, curve_object->curve_type);
+}
+
+
+SUResult SUCurveGetNumEdges(SUCurveRef curve, size_t* count) {
+  const Curve* curve_object = get<Curve>(curve);
+  if (curve_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(curve_object->edges, count);
+}
+
+
+SUResult SUCurveGetEdges(SUCurveRef curve, size_t len, SUEdgeRef edges[], size_t* count) {
+  const Curve* curve_object = get<Curve>(curve);
+  if (curve_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(curve_object->edges, len, edges, count);
+}
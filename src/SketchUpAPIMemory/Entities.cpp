@@ -0,0 +1,391 @@
+//
+//  Entities.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <unordered_map>
+
+#include "MemoryAPI.hpp"
+
+using namespace SUMemory;
+
+namespace {
+
+void set_edge_properties(Edge* edge, const LoopInput::EdgeInput& properties) {
+  edge->hidden = properties.hidden;
+  edge->soft = properties.soft;
+  edge->smooth = properties.smooth;
+  edge->layer = properties.layer;
+  edge->material = properties.material;
+}
+
+/**
+* Creates the faces of a geometry input. Faces whose loops do not lie on a plane are skipped.
+*/
+void fill_faces(Entities* entities, const GeometryInput& input) {
+  for (const GeometryInput::FaceInput& face_input : input.faces) {
+    std::vector<SUPoint3D> points;
+    for (size_t index : face_input.outer->vertex_indices) {
+      points.push_back(input.vertices[index]);
+    }
+    Face* face = nullptr;
+    if (create_face(points, *face_input.outer, &face) != SU_ERROR_NONE) {
+      continue;
+    }
+    for (const std::unique_ptr<LoopInput>& inner : face_input.inner) {
+      points.clear();
+      for (size_t index : inner->vertex_indices) {
+        points.push_back(input.vertices[index]);
+      }
+      add_inner_loop(face, points, *inner);
+    }
+    if (face_input.reverse) {
+      reverse_face(face);
+    }
+    face->material = face_input.front_material;
+    face->back_material = face_input.back_material;
+    face->layer = face_input.layer;
+    face->hidden = face_input.hidden;
+    entities->take(face);
+    entities->add_face(face);
+  }
+}
+
+/**
+* Creates the edges of a geometry input, reusing the edges of faces that join the same vertices.
+*/
+std::vector<Edge*> fill_edges(Entities* entities, const GeometryInput& input) {
+  std::vector<Edge*> edges;
+  edges.reserve(input.edges.size());
+  for (const GeometryInput::EdgeInput& edge_input : input.edges) {
+    const SUPoint3D& start = input.vertices[edge_input.start];
+    const SUPoint3D& end = input.vertices[edge_input.end];
+    const Vertex* start_vertex = entities->vertices.find(start);
+    const Vertex* end_vertex = entities->vertices.find(end);
+    Edge* edge = start_vertex != nullptr && end_vertex != nullptr ? entities->find_edge(start_vertex, end_vertex) : nullptr;
+    if (edge == nullptr) {
+      edge = create_edge(start, end);
+      entities->take(edge);
+      entities->add_edge(edge);
+    }
+    set_edge_properties(edge, edge_input.properties);
+    edges.push_back(edge);
+  }
+  return edges;
+}
+
+/**
+* Transforms one element of an entities collection, collecting the vertices it moves.
+*/
+void transform_element(Object* object, const SUTransformation& transform, std::unordered_map<Vertex*, SUPoint3D>& moves) {
+  auto move = [&transform, &moves](Vertex* vertex) {
+    if (moves.count(vertex) == 0) {
+      moves.emplace(vertex, transform_point(transform, vertex->position));
+    }
+  };
+  switch (object->type) {
+    case SURefType_Face: {
+      Face* face = static_cast<Face*>(object);
+      for (Vertex* vertex : face->outer->vertices) {
+        move(vertex);
+      }
+      for (Loop* loop : face->inner) {
+        for (Vertex* vertex : loop->vertices) {
+          move(vertex);
+        }
+      }
+      break;
+    }
+    case SURefType_Edge:
+      move(static_cast<Edge*>(object)->start);
+      move(static_cast<Edge*>(object)->end);
+      break;
+    case SURefType_ComponentInstance:
+    case SURefType_Group: {
+      ComponentInstance* instance = static_cast<ComponentInstance*>(object);
+      instance->transform = multiply(transform, instance->transform);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+SUResult transform_elements(SUEntitiesRef entities, size_t len, SUEntityRef elements[], const SUTransformation transforms[], bool one_transform) {
+  Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (elements == nullptr || transforms == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  for (size_t i = 0; i < len; ++i) {
+    const Object* object = get<Object>(elements[i]);
+    if (object == nullptr || object->parent != entities_object) {
+      return SU_ERROR_UNSUPPORTED;
+    }
+  }
+  std::unordered_map<Vertex*, SUPoint3D> moves;
+  for (size_t i = 0; i < len; ++i) {
+    transform_element(get<Object>(elements[i]), transforms[one_transform ? 0 : i], moves);
+  }
+  // Vertices are moved once all new positions are known, so shared vertices move only once.
+  for (const auto& move : moves) {
+    entities_object->move_vertex(move.first, move.second);
+  }
+  if (!moves.empty()) {
+    for (Face* face : entities_object->faces) {
+      update_plane(face);
+    }
+  }
+  return SU_ERROR_NONE;
+}
+
+} // namespace
+
+
+SUResult SUEntitiesFill(SUEntitiesRef entities, SUGeometryInputRef geom_input, bool weld_vertices) {
+  Entities* entities_object = get<Entities>(entities);
+  const GeometryInput* input = get<GeometryInput>(geom_input);
+  if (entities_object == nullptr || input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  // Coincident vertices are always welded, as SketchUp does for the vertices of faces.
+  static_cast<void>(weld_vertices);
+  fill_faces(entities_object, *input);
+  const std::vector<Edge*> edges = fill_edges(entities_object, *input);
+  for (const GeometryInput::CurveInput& curve_input : input->curves) {
+    Curve* curve = new Curve();
+    curve->curve_type = curve_input.curve_type;
+    for (size_t index : curve_input.edges) {
+      edges[index]->curve = curve;
+      curve->edges.push_back(edges[index]);
+    }
+    curve->parent = entities_object;
+    entities_object->take(curve);
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEntitiesAddFaces(SUEntitiesRef entities, size_t len, const SUFaceRef faces[]) {
+  Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (faces == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  for (size_t i = 0; i < len; ++i) {
+    Face* face = get<Face>(faces[i]);
+    if (face == nullptr || face->attached) {
+      return SU_ERROR_INVALID_INPUT;
+    }
+  }
+  for (size_t i = 0; i < len; ++i) {
+    Face* face = get<Face>(faces[i]);
+    entities_object->take(face);
+    entities_object->add_face(face);
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEntitiesAddEdges(SUEntitiesRef entities, size_t len, const SUEdgeRef edges[]) {
+  Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (edges == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  for (size_t i = 0; i < len; ++i) {
+    Edge* edge = get<Edge>(edges[i]);
+    if (edge == nullptr || edge->attached) {
+      return SU_ERROR_INVALID_INPUT;
+    }
+  }
+  for (size_t i = 0; i < len; ++i) {
+    Edge* edge = get<Edge>(edges[i]);
+    entities_object->take(edge);
+    entities_object->add_edge(edge);
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEntitiesAddGroup(SUEntitiesRef entities, SUGroupRef group) {
+  Entities* entities_object = get<Entities>(entities);
+  ComponentInstance* group_object = get_group(group);
+  if (entities_object == nullptr || group_object == nullptr || group_object->attached) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  group_object->parent = entities_object;
+  entities_object->take(group_object);
+  entities_object->groups.push_back(group_object);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEntitiesAddInstance(SUEntitiesRef entities, SUComponentInstanceRef instance, SUStringRef* name) {
+  Entities* entities_object = get<Entities>(entities);
+  ComponentInstance* instance_object = get<ComponentInstance>(instance);
+  if (entities_object == nullptr || instance_object == nullptr || instance_object->attached) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name != nullptr && get<String>(*name) == nullptr) {
+    return SU_ERROR_INVALID_OUTPUT;
+  }
+  // The definition of the instance joins the model of the entities if it is not in one yet.
+  ComponentDefinition* definition = instance_object->definition;
+  if (!definition->attached) {
+    if (entities_object->model != nullptr) {
+      add_definition(entities_object->model, definition);
+    }
+    else {
+      definition->attached = true;
+      give(entities_object->definition, definition);
+    }
+  }
+  instance_object->parent = entities_object;
+  entities_object->take(instance_object);
+  entities_object->instances.push_back(instance_object);
+  if (name != nullptr) {
+    set_string(name, definition->name);
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEntitiesGetBoundingBox(SUEntitiesRef entities, struct SUBoundingBox3D* bbox) {
+  const Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_bounds(bbox, entities_bounds(*entities_object));
+}
+
+
+SUResult SUEntitiesGetNumFaces(SUEntitiesRef entities, size_t* count) {
+  const Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(entities_object->faces, count);
+}
+
+
+SUResult SUEntitiesGetFaces(SUEntitiesRef entities, size_t len, SUFaceRef faces[], size_t* count) {
+  const Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(entities_object->faces, len, faces, count);
+}
+
+
+namespace {
+
+std::vector<Edge*> standalone_edges(const Entities& entities) {
+  std::vector<Edge*> edges;
+  for (Edge* edge : entities.edges) {
+    if (edge->faces.empty()) {
+      edges.push_back(edge);
+    }
+  }
+  return edges;
+}
+
+} // namespace
+
+
+SUResult SUEntitiesGetNumEdges(SUEntitiesRef entities, bool standalone_only, size_t* count) {
+  const Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (!standalone_only) {
+    return get_count(entities_object->edges, count);
+  }
+  return get_count(standalone_edges(*entities_object), count);
+}
+
+
+SUResult SUEntitiesGetEdges(SUEntitiesRef entities, bool standalone_only, size_t len, SUEdgeRef edges[], size_t* count) {
+  const Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (!standalone_only) {
+    return fill(entities_object->edges, len, edges, count);
+  }
+  return fill(standalone_edges(*entities_object), len, edges, count);
+}
+
+
+SUResult SUEntitiesGetNumInstances(SUEntitiesRef entities, size_t* count) {
+  const Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(entities_object->instances, count);
+}
+
+
+SUResult SUEntitiesGetInstances(SUEntitiesRef entities, size_t len, SUComponentInstanceRef instances[], size_t* count) {
+  const Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(entities_object->instances, len, instances, count);
+}
+
+
+SUResult SUEntitiesGetNumGroups(SUEntitiesRef entities, size_t* count) {
+  const Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(entities_object->groups, count);
+}
+
+
+SUResult SUEntitiesGetGroups(SUEntitiesRef entities, size_t len, SUGroupRef groups[], size_t* count) {
+  const Entities* entities_object = get<Entities>(entities);
+  if (entities_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(entities_object->groups, len, groups, count);
+}
+
+
+SUResult SUEntitiesTransform(SUEntitiesRef entities, size_t len, SUEntityRef elements[], const struct SUTransformation* trans) {
+  return transform_elements(entities, len, elements, trans, true);
+}
+
+
+SUResult SUEntitiesTransformMultiple(SUEntitiesRef entities, size_t len, SUEntityRef elements[], const struct SUTransformation tranforms[]) {
+  return transform_elements(entities, len, elements, tranforms, false);
+}
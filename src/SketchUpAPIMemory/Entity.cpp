@@ -0,0 +1,359 @@
+//
+//  Entity.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MemoryAPI.hpp"
+
+using namespace SUMemory;
+
+enum SURefType SUEntityGetType(SUEntityRef entity) {
+  const Object* object = get<Object>(entity);
+  return object == nullptr ? SURefType_Unknown : object->type;
+}
+
+
+SUResult SUEntityGetID(SUEntityRef entity, int32_t* entity_id) {
+  const Object* object = get<Object>(entity);
+  if (object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(entity_id, object->id);
+}
+
+
+SUResult SUEntityGetPersistentID(SUEntityRef entity, int64_t* entity_pid) {
+  const Object* object = get<Object>(entity);
+  if (object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(entity_pid, object->pid);
+}
+
+
+SUResult SUEntityGetModel(SUEntityRef entity, SUModelRef* model) {
+  const Object* object = get<Object>(entity);
+  if (object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (model == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (object->model == nullptr) {
+    return SU_ERROR_NO_DATA;
+  }
+  *model = to_ref<SUModelRef>(object->model);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEntityGetParentEntities(SUEntityRef entity, SUEntitiesRef* entities) {
+  const Object* object = get<Object>(entity);
+  if (object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (entities == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (object->parent == nullptr) {
+    return SU_ERROR_NO_DATA;
+  }
+  *entities = to_ref<SUEntitiesRef>(object->parent);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEntityAddAttributeDictionary(SUEntityRef entity, SUAttributeDictionaryRef dictionary) {
+  Object* object = get<Object>(entity);
+  AttributeDictionary* dictionary_object = get<AttributeDictionary>(dictionary);
+  if (object == nullptr || dictionary_object == nullptr || dictionary_object->attached) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (dictionary_object->name.empty()) {
+    return SU_ERROR_INVALID_ARGUMENT;
+  }
+  for (const AttributeDictionary* existing : object->dictionaries) {
+    if (existing->name == dictionary_object->name) {
+      return SU_ERROR_DUPLICATE;
+    }
+  }
+  dictionary_object->attached = true;
+  dictionary_object->model = object->model;
+  object->dictionaries.push_back(dictionary_object);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUEntityGetNumAttributeDictionaries(SUEntityRef entity, size_t* count) {
+  const Object* object = get<Object>(entity);
+  if (object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(object->dictionaries, count);
+}
+
+
+SUResult SUEntityGetAttributeDictionaries(SUEntityRef entity, size_t len, SUAttributeDictionaryRef dictionaries[], size_t* count) {
+  const Object* object = get<Object>(entity);
+  if (object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(object->dictionaries, len, dictionaries, count);
+}
+
+
+SUResult SUEntityGetAttributeDictionary(SUEntityRef entity, const char* name, SUAttributeDictionaryRef* dictionary) {
+  Object* object = get<Object>(entity);
+  if (object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (dictionary == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  for (AttributeDictionary* existing : object->dictionaries) {
+    if (existing->name == name) {
+      *dictionary = to_ref<SUAttributeDictionaryRef>(existing);
+      return SU_ERROR_NONE;
+    }
+  }
+  // As in SketchUp, a dictionary that does not exist yet is created.
+  AttributeDictionary* created = new AttributeDictionary();
+  created->name = name;
+  created->attached = true;
+  created->model = object->model;
+  object->dictionaries.push_back(created);
+  *dictionary = to_ref<SUAttributeDictionaryRef>(created);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUAttributeDictionaryCreate(SUAttributeDictionaryRef* dictionary, const char* name) {
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  SUResult result = create<AttributeDictionary>(dictionary);
+  if (result == SU_ERROR_NONE) {
+    get<AttributeDictionary>(*dictionary)->name = name;
+  }
+  return result;
+}
+
+
+SUResult SUAttributeDictionaryRelease(SUAttributeDictionaryRef* dictionary) {
+  return release_entity<AttributeDictionary>(dictionary);
+}
+
+
+SUEntityRef SUAttributeDictionaryToEntity(SUAttributeDictionaryRef dictionary) {
+  return convert<AttributeDictionary, SUEntityRef>(dictionary);
+}
+
+
+SUAttributeDictionaryRef SUAttributeDictionaryFromEntity(SUEntityRef entity) {
+  return convert<AttributeDictionary, SUAttributeDictionaryRef>(entity);
+}
+
+
+SUResult SUAttributeDictionaryGetName(SUAttributeDictionaryRef dictionary, SUStringRef* name) {
+  const AttributeDictionary* dictionary_object = get<AttributeDictionary>(dictionary);
+  if (dictionary_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_string(name, dictionary_object->name);
+}
+
+
+SUResult SUAttributeDictionaryGetNumKeys(SUAttributeDictionaryRef dictionary, size_t* count) {
+  const AttributeDictionary* dictionary_object = get<AttributeDictionary>(dictionary);
+  if (dictionary_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(dictionary_object->values.values, count);
+}
+
+
+SUResult SUAttributeDictionaryGetKeys(SUAttributeDictionaryRef dictionary, size_t len, SUStringRef keys[], size_t* count) {
+  const AttributeDictionary* dictionary_object = get<AttributeDictionary>(dictionary);
+  if (dictionary_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_keys(dictionary_object->values, len, keys, count);
+}
+
+
+SUResult SUAttributeDictionaryGetValue(SUAttributeDictionaryRef dictionary, const char* key, SUTypedValueRef* value_out) {
+  const AttributeDictionary* dictionary_object = get<AttributeDictionary>(dictionary);
+  if (dictionary_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_value(dictionary_object->values, key, value_out);
+}
+
+
+SUResult SUAttributeDictionarySetValue(SUAttributeDictionaryRef dictionary, const char* key, SUTypedValueRef value_in) {
+  AttributeDictionary* dictionary_object = get<AttributeDictionary>(dictionary);
+  if (dictionary_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(dictionary_object->values, key, value_in);
+}
+
+
+SUEntityRef SUDrawingElementToEntity(SUDrawingElementRef elem) {
+  return convert<DrawingElement, SUEntityRef>(elem);
+}
+
+
+SUDrawingElementRef SUDrawingElementFromEntity(SUEntityRef entity) {
+  return convert<DrawingElement, SUDrawingElementRef>(entity);
+}
+
+
+SUResult SUDrawingElementGetBoundingBox(SUDrawingElementRef elem, struct SUBoundingBox3D* bbox) {
+  const DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_bounds(bbox, element_bounds(element));
+}
+
+
+SUResult SUDrawingElementGetHidden(SUDrawingElementRef elem, bool* hide_flag) {
+  const DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(hide_flag, element->hidden);
+}
+
+
+SUResult SUDrawingElementSetHidden(SUDrawingElementRef elem, bool hide_flag) {
+  DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  element->hidden = hide_flag;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUDrawingElementGetCastsShadows(SUDrawingElementRef elem, bool* casts_shadows_flag) {
+  const DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(casts_shadows_flag, element->casts_shadows);
+}
+
+
+SUResult SUDrawingElementSetCastsShadows(SUDrawingElementRef elem, bool casts_shadows_flag) {
+  DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  element->casts_shadows = casts_shadows_flag;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUDrawingElementGetReceivesShadows(SUDrawingElementRef elem, bool* receives_shadows_flag) {
+  const DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(receives_shadows_flag, element->receives_shadows);
+}
+
+
+SUResult SUDrawingElementSetReceivesShadows(SUDrawingElementRef elem, bool receives_shadows_flag) {
+  DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  element->receives_shadows = receives_shadows_flag;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUDrawingElementGetLayer(SUDrawingElementRef elem, SULayerRef* layer) {
+  const DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (layer == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  // Elements in a model are on the default layer until another is set.
+  Layer* element_layer = element->layer;
+  if (element_layer == nullptr && element->model != nullptr) {
+    element_layer = element->model->layers.front();
+  }
+  if (element_layer == nullptr) {
+    return SU_ERROR_NO_DATA;
+  }
+  *layer = to_ref<SULayerRef>(element_layer);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUDrawingElementSetLayer(SUDrawingElementRef elem, SULayerRef layer) {
+  DrawingElement* element = get<DrawingElement>(elem);
+  Layer* layer_object = get<Layer>(layer);
+  if (element == nullptr || layer_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  element->layer = layer_object;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUDrawingElementGetMaterial(SUDrawingElementRef elem, SUMaterialRef* material) {
+  const DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (material == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (element->material == nullptr) {
+    return SU_ERROR_NO_DATA;
+  }
+  *material = to_ref<SUMaterialRef>(element->material);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUDrawingElementSetMaterial(SUDrawingElementRef elem, SUMaterialRef material) {
+  DrawingElement* element = get<DrawingElement>(elem);
+  if (element == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  // An invalid material clears the material of the element.
+  element->material = get<Material>(material);
+  return SU_ERROR_NONE;
+}
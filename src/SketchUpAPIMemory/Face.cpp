@@ -0,0 +1,499 @@
+//
+//  Face.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cmath>
+
+#include "MemoryAPI.hpp"
+
+namespace SUMemory {
+
+namespace {
+
+/**
+* Checks that a loop has at least three distinct points on one plane, within tolerance.
+*/
+SUResult check_loop(const std::vector<SUPoint3D>& points, const SUVector3D& normal) {
+  if (points.size() < 3) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (same_position(points[i], points[(i + 1) % points.size()])) {
+      return SU_ERROR_INVALID_INPUT;
+    }
+  }
+  if (length(normal) == 0.0) {
+    return SU_ERROR_GENERIC;
+  }
+  const SUVector3D unit_normal = normalize(normal);
+  for (const SUPoint3D& point : points) {
+    if (std::fabs(dot(unit_normal, sub(point, points[0]))) > TOLERANCE) {
+      return SU_ERROR_GENERIC;
+    }
+  }
+  return SU_ERROR_NONE;
+}
+
+/**
+* Creates a loop with its own vertices and edges, which the loop owns until it is given to a face.
+*/
+Loop* create_loop(Face* face, const std::vector<SUPoint3D>& points, const LoopInput& input) {
+  Loop* loop = new Loop();
+  loop->face = face;
+  loop->attached = true;
+  for (const SUPoint3D& point : points) {
+    Vertex* vertex = new Vertex(point);
+    vertex->attached = true;
+    loop->take(vertex);
+    loop->vertices.push_back(vertex);
+  }
+  for (size_t i = 0; i < points.size(); ++i) {
+    Edge* edge = new Edge();
+    edge->attached = true;
+    edge->start = loop->vertices[i];
+    edge->end = loop->vertices[(i + 1) % points.size()];
+    edge->faces.push_back(face);
+    if (i < input.edges.size()) {
+      const LoopInput::EdgeInput& properties = input.edges[i];
+      edge->hidden = properties.hidden;
+      edge->soft = properties.soft;
+      edge->smooth = properties.smooth;
+      edge->layer = properties.layer;
+      edge->material = properties.material;
+    }
+    loop->take(edge);
+    loop->edges.push_back(edge);
+  }
+  return loop;
+}
+
+void reverse_loop(Loop* loop) {
+  // Edge i joins vertices i and i + 1, so all but the closing edge swap places.
+  std::reverse(loop->vertices.begin(), loop->vertices.end());
+  std::reverse(loop->edges.begin(), loop->edges.end() - 1);
+}
+
+double loop_area(const Loop* loop) {
+  return 0.5 * length(polygon_normal(loop_points(loop)));
+}
+
+} // namespace
+
+
+SUResult create_face(const std::vector<SUPoint3D>& points, const LoopInput& outer, Face** face) {
+  SUResult result = check_loop(points, polygon_normal(points));
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  Face* created = new Face();
+  created->outer = create_loop(created, points, outer);
+  created->take(created->outer);
+  update_plane(created);
+  *face = created;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult add_inner_loop(Face* face, const std::vector<SUPoint3D>& points, const LoopInput& input) {
+  const SUVector3D normal{face->plane.a, face->plane.b, face->plane.c};
+  SUResult result = check_loop(points, polygon_normal(points));
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (std::fabs(dot(normal, sub(points[0], SUPoint3D{0.0, 0.0, 0.0})) + face->plane.d) > TOLERANCE) {
+    return SU_ERROR_GENERIC;
+  }
+  Loop* loop = create_loop(face, points, input);
+  // Inner loops wind the opposite way to the outer loop.
+  if (dot(polygon_normal(points), normal) > 0.0) {
+    reverse_loop(loop);
+  }
+  face->inner.push_back(loop);
+  give(face, loop);
+  if (face->parent != nullptr) {
+    face->parent->weld_loop(loop);
+  }
+  return SU_ERROR_NONE;
+}
+
+
+void reverse_face(Face* face) {
+  reverse_loop(face->outer);
+  for (Loop* loop : face->inner) {
+    reverse_loop(loop);
+  }
+  face->plane = SUPlane3D{-face->plane.a, -face->plane.b, -face->plane.c, -face->plane.d};
+}
+
+
+void update_plane(Face* face) {
+  const std::vector<SUPoint3D> points = loop_points(face->outer);
+  const SUVector3D normal = normalize(polygon_normal(points));
+  SUVector3D centroid{0.0, 0.0, 0.0};
+  for (const SUPoint3D& point : points) {
+    centroid.x += point.x / double(points.size());
+    centroid.y += point.y / double(points.size());
+    centroid.z += point.z / double(points.size());
+  }
+  face->plane = SUPlane3D{normal.x, normal.y, normal.z, -dot(normal, centroid)};
+}
+
+} // namespace SUMemory
+
+using namespace SUMemory;
+
+
+SUResult SUFaceCreate(SUFaceRef* face, const struct SUPoint3D vertices3d[], SULoopInputRef* outer_loop) {
+  if (vertices3d == nullptr || outer_loop == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  SUResult result = check_create(face);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  LoopInput* input = get<LoopInput>(*outer_loop);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  std::vector<SUPoint3D> points;
+  points.reserve(input->vertex_indices.size());
+  for (size_t index : input->vertex_indices) {
+    points.push_back(vertices3d[index]);
+  }
+  Face* created = nullptr;
+  result = create_face(points, *input, &created);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  // The face takes over the loop input.
+  delete input;
+  SUSetInvalid(*outer_loop);
+  *face = to_ref<SUFaceRef>(created);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUFaceAddInnerLoop(SUFaceRef face, const struct SUPoint3D vertices3d[], SULoopInputRef* loop) {
+  Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (vertices3d == nullptr || loop == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  LoopInput* input = get<LoopInput>(*loop);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  std::vector<SUPoint3D> points;
+  points.reserve(input->vertex_indices.size());
+  for (size_t index : input->vertex_indices) {
+    points.push_back(vertices3d[index]);
+  }
+  SUResult result = add_inner_loop(face_object, points, *input);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  delete input;
+  SUSetInvalid(*loop);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUFaceRelease(SUFaceRef* face) {
+  return release_entity<Face>(face);
+}
+
+
+SUEntityRef SUFaceToEntity(SUFaceRef face) {
+  return convert<Face, SUEntityRef>(face);
+}
+
+
+SUFaceRef SUFaceFromEntity(SUEntityRef entity) {
+  return convert<Face, SUFaceRef>(entity);
+}
+
+
+SUDrawingElementRef SUFaceToDrawingElement(SUFaceRef face) {
+  return convert<Face, SUDrawingElementRef>(face);
+}
+
+
+SUResult SUFaceGetArea(SUFaceRef face, double* area) {
+  const Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  double face_area = loop_area(face_object->outer);
+  for (const Loop* loop : face_object->inner) {
+    face_area -= loop_area(loop);
+  }
+  return set_value(area, face_area);
+}
+
+
+SUResult SUFaceGetPlane(SUFaceRef face, struct SUPlane3D* plane) {
+  const Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(plane, face_object->plane);
+}
+
+
+SUResult SUFaceGetNumVertices(SUFaceRef face, size_t* count) {
+  const Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (count == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *count = face_object->outer->vertices.size();
+  for (const Loop* loop : face_object->inner) {
+    *count += loop->vertices.size();
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUFaceGetVertices(SUFaceRef face, size_t len, SUVertexRef vertices[], size_t* count) {
+  const Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  std::vector<Vertex*> face_vertices = face_object->outer->vertices;
+  for (const Loop* loop : face_object->inner) {
+    face_vertices.insert(face_vertices.end(), loop->vertices.begin(), loop->vertices.end());
+  }
+  return fill(face_vertices, len, vertices, count);
+}
+
+
+SUResult SUFaceGetOuterLoop(SUFaceRef face, SULoopRef* loop) {
+  const Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(loop, to_ref<SULoopRef>(face_object->outer));
+}
+
+
+SUResult SUFaceGetNumInnerLoops(SUFaceRef face, size_t* count) {
+  const Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(face_object->inner, count);
+}
+
+
+SUResult SUFaceGetInnerLoops(SUFaceRef face, size_t len, SULoopRef loops[], size_t* count) {
+  const Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(face_object->inner, len, loops, count);
+}
+
+
+SUResult SUFaceGetFrontMaterial(SUFaceRef face, SUMaterialRef* material) {
+  return SUDrawingElementGetMaterial(SUFaceToDrawingElement(face), material);
+}
+
+
+SUResult SUFaceGetBackMaterial(SUFaceRef face, SUMaterialRef* material) {
+  const Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (material == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (face_object->back_material == nullptr) {
+    return SU_ERROR_NO_DATA;
+  }
+  *material = to_ref<SUMaterialRef>(face_object->back_material);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUFaceSetBackMaterial(SUFaceRef face, SUMaterialRef material) {
+  Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  face_object->back_material = get<Material>(material);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUFaceReverse(SUFaceRef face) {
+  Face* face_object = get<Face>(face);
+  if (face_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  reverse_face(face_object);
+  return SU_ERROR_NONE;
+}
+
+
+SUEntityRef SULoopToEntity(SULoopRef loop) {
+  return convert<Loop, SUEntityRef>(loop);
+}
+
+
+SULoopRef SULoopFromEntity(SUEntityRef entity) {
+  return convert<Loop, SULoopRef>(entity);
+}
+
+
+SUResult SULoopGetNumVertices(SULoopRef loop, size_t* count) {
+  const Loop* loop_object = get<Loop>(loop);
+  if (loop_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(loop_object->vertices, count);
+}
+
+
+SUResult SULoopGetVertices(SULoopRef loop, size_t len, SUVertexRef vertices[], size_t* count) {
+  const Loop* loop_object = get<Loop>(loop);
+  if (loop_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(loop_object->vertices, len, vertices, count);
+}
+
+
+SUResult SULoopGetEdges(SULoopRef loop, size_t len, SUEdgeRef edges[], size_t* count) {
+  const Loop* loop_object = get<Loop>(loop);
+  if (loop_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(loop_object->edges, len, edges, count);
+}
+
+
+SUResult SULoopIsOuterLoop(SULoopRef loop, bool* outer_loop) {
+  const Loop* loop_object = get<Loop>(loop);
+  if (loop_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(outer_loop, loop_object->face->outer == loop_object);
+}
+
+
+SUResult SULoopInputCreate(SULoopInputRef* loop_input) {
+  return create<LoopInput>(loop_input);
+}
+
+
+SUResult SULoopInputRelease(SULoopInputRef* loop_input) {
+  return release<LoopInput>(loop_input);
+}
+
+
+SUResult SULoopInputAddVertexIndex(SULoopInputRef loop_input, size_t vertex_index) {
+  LoopInput* input = get<LoopInput>(loop_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  input->vertex_indices.push_back(vertex_index);
+  input->edges.emplace_back();
+  return SU_ERROR_NONE;
+}
+
+
+namespace {
+
+/**
+* The properties of an edge of a loop input, for the SULoopInputEdgeSet* functions.
+*/
+SUResult loop_edge(SULoopInputRef loop_input, size_t edge_index, LoopInput::EdgeInput** edge) {
+  LoopInput* input = get<LoopInput>(loop_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (edge_index >= input->edges.size()) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  *edge = &input->edges[edge_index];
+  return SU_ERROR_NONE;
+}
+
+} // namespace
+
+
+SUResult SULoopInputEdgeSetHidden(SULoopInputRef loop_input, size_t edge_index, bool hidden) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = loop_edge(loop_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->hidden = hidden;
+  }
+  return result;
+}
+
+
+SUResult SULoopInputEdgeSetSoft(SULoopInputRef loop_input, size_t edge_index, bool soft) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = loop_edge(loop_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->soft = soft;
+  }
+  return result;
+}
+
+
+SUResult SULoopInputEdgeSetSmooth(SULoopInputRef loop_input, size_t edge_index, bool smooth) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = loop_edge(loop_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->smooth = smooth;
+  }
+  return result;
+}
+
+
+SUResult SULoopInputEdgeSetMaterial(SULoopInputRef loop_input, size_t edge_index, SUMaterialRef material) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = loop_edge(loop_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->material = get<Material>(material);
+  }
+  return result;
+}
+
+
+SUResult SULoopInputEdgeSetLayer(SULoopInputRef loop_input, size_t edge_index, SULayerRef layer) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = loop_edge(loop_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->layer = get<Layer>(layer);
+  }
+  return result;
+}
@@ -0,0 +1,244 @@
+//
+//  Geometry.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cmath>
+#include <limits>
+
+#include "MemoryAPI.hpp"
+
+namespace SUMemory {
+
+SUVector3D sub(const SUPoint3D& a, const SUPoint3D& b) {
+  return SUVector3D{a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+
+SUVector3D cross(const SUVector3D& a, const SUVector3D& b) {
+  return SUVector3D{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+
+double dot(const SUVector3D& a, const SUVector3D& b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+
+double length(const SUVector3D& vector) {
+  return std::sqrt(dot(vector, vector));
+}
+
+
+SUVector3D normalize(const SUVector3D& vector) {
+  const double vector_length = length(vector);
+  if (vector_length == 0.0) {
+    return vector;
+  }
+  return SUVector3D{vector.x / vector_length, vector.y / vector_length, vector.z / vector_length};
+}
+
+
+bool same_position(const SUPoint3D& a, const SUPoint3D& b) {
+  return length(sub(a, b)) <= TOLERANCE;
+}
+
+
+SUTransformation identity() {
+  SUTransformation transform = {{1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0}};
+  return transform;
+}
+
+
+SUPoint3D transform_point(const SUTransformation& transform, const SUPoint3D& point) {
+  const double* m = transform.values;
+  SUPoint3D result{
+    m[0] * point.x + m[4] * point.y + m[8] * point.z + m[12],
+    m[1] * point.x + m[5] * point.y + m[9] * point.z + m[13],
+    m[2] * point.x + m[6] * point.y + m[10] * point.z + m[14]
+  };
+  const double w = m[3] * point.x + m[7] * point.y + m[11] * point.z + m[15];
+  if (w != 1.0 && w != 0.0) {
+    result.x /= w;
+    result.y /= w;
+    result.z /= w;
+  }
+  return result;
+}
+
+
+SUVector3D transform_vector(const SUTransformation& transform, const SUVector3D& vector) {
+  const double* m = transform.values;
+  SUVector3D result{
+    m[0] * vector.x + m[4] * vector.y + m[8] * vector.z,
+    m[1] * vector.x + m[5] * vector.y + m[9] * vector.z,
+    m[2] * vector.x + m[6] * vector.y + m[10] * vector.z
+  };
+  // A vector has no w coordinate, so the projective row does not apply, but the overall scale in m[15] does.
+  const double w = m[15];
+  if (w != 1.0 && w != 0.0) {
+    result.x /= w;
+    result.y /= w;
+    result.z /= w;
+  }
+  return result;
+}
+
+
+SUTransformation multiply(const SUTransformation& a, const SUTransformation& b) {
+  SUTransformation result;
+  for (size_t column = 0; column < 4; ++column) {
+    for (size_t row = 0; row < 4; ++row) {
+      double value = 0.0;
+      for (size_t k = 0; k < 4; ++k) {
+        value += a.values[k * 4 + row] * b.values[column * 4 + k];
+      }
+      result.values[column * 4 + row] = value;
+    }
+  }
+  return result;
+}
+
+
+SUVector3D polygon_normal(const std::vector<SUPoint3D>& points) {
+  SUVector3D normal{0.0, 0.0, 0.0};
+  for (size_t i = 0; i < points.size(); ++i) {
+    const SUPoint3D& current = points[i];
+    const SUPoint3D& next = points[(i + 1) % points.size()];
+    normal.x += (current.y - next.y) * (current.z + next.z);
+    normal.y += (current.z - next.z) * (current.x + next.x);
+    normal.z += (current.x - next.x) * (current.y + next.y);
+  }
+  return normal;
+}
+
+
+std::vector<SUPoint3D> loop_points(const Loop* loop) {
+  std::vector<SUPoint3D> points;
+  points.reserve(loop->vertices.size());
+  for (const Vertex* vertex : loop->vertices) {
+    points.push_back(vertex->position);
+  }
+  return points;
+}
+
+
+SUBoundingBox3D empty_bounds() {
+  const double max = std::numeric_limits<double>::max();
+  return SUBoundingBox3D{{max, max, max}, {-max, -max, -max}};
+}
+
+
+void add_bounds(SUBoundingBox3D& bounds, const SUPoint3D& point) {
+  bounds.min_point.x = std::min(bounds.min_point.x, point.x);
+  bounds.min_point.y = std::min(bounds.min_point.y, point.y);
+  bounds.min_point.z = std::min(bounds.min_point.z, point.z);
+  bounds.max_point.x = std::max(bounds.max_point.x, point.x);
+  bounds.max_point.y = std::max(bounds.max_point.y, point.y);
+  bounds.max_point.z = std::max(bounds.max_point.z, point.z);
+}
+
+
+void add_bounds(SUBoundingBox3D& bounds, const SUBoundingBox3D& other, const SUTransformation& transform) {
+  if (other.min_point.x > other.max_point.x) {
+    return;
+  }
+  for (size_t corner = 0; corner < 8; ++corner) {
+    const SUPoint3D point{
+      corner & 1 ? other.max_point.x : other.min_point.x,
+      corner & 2 ? other.max_point.y : other.min_point.y,
+      corner & 4 ? other.max_point.z : other.min_point.z
+    };
+    add_bounds(bounds, transform_point(transform, point));
+  }
+}
+
+
+SUBoundingBox3D entities_bounds(const Entities& entities) {
+  SUBoundingBox3D bounds = empty_bounds();
+  // The edges include the edges of every face.
+  for (const Edge* edge : entities.edges) {
+    add_bounds(bounds, edge->start->position);
+    add_bounds(bounds, edge->end->position);
+  }
+  for (const ComponentInstance* instance : entities.instances) {
+    add_bounds(bounds, entities_bounds(instance->definition->entities), instance->transform);
+  }
+  for (const ComponentInstance* group : entities.groups) {
+    add_bounds(bounds, entities_bounds(group->definition->entities), group->transform);
+  }
+  return bounds;
+}
+
+
+SUBoundingBox3D element_bounds(const DrawingElement* element) {
+  SUBoundingBox3D bounds = empty_bounds();
+  switch (element->type) {
+    case SURefType_Face: {
+      const Face* face = static_cast<const Face*>(element);
+      for (const Vertex* vertex : face->outer->vertices) {
+        add_bounds(bounds, vertex->position);
+      }
+      break;
+    }
+    case SURefType_Edge: {
+      const Edge* edge = static_cast<const Edge*>(element);
+      add_bounds(bounds, edge->start->position);
+      add_bounds(bounds, edge->end->position);
+      break;
+    }
+    case SURefType_ComponentInstance:
+    case SURefType_Group: {
+      const ComponentInstance* instance = static_cast<const ComponentInstance*>(element);
+      add_bounds(bounds, entities_bounds(instance->definition->entities), instance->transform);
+      break;
+    }
+    case SURefType_ComponentDefinition:
+      bounds = entities_bounds(static_cast<const ComponentDefinition*>(element)->entities);
+      break;
+    case SURefType_Axes:
+      add_bounds(bounds, static_cast<const Axes*>(element)->origin);
+      break;
+    default:
+      break;
+  }
+  return bounds;
+}
+
+
+SUResult set_bounds(SUBoundingBox3D* out, const SUBoundingBox3D& bounds) {
+  if (out == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (bounds.min_point.x > bounds.max_point.x) {
+    *out = SUBoundingBox3D{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+  }
+  else {
+    *out = bounds;
+  }
+  return SU_ERROR_NONE;
+}
+
+} // namespace SUMemory
@@ -0,0 +1,387 @@
+//
+//  GeometryInput.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cmath>
+
+#include "MemoryAPI.hpp"
+
+using namespace SUMemory;
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+/**
+* Checks a loop input against the vertices of a geometry input.
+*/
+bool valid_loop(const GeometryInput& input, const LoopInput& loop) {
+  if (loop.vertex_indices.size() < 3) {
+    return false;
+  }
+  for (size_t index : loop.vertex_indices) {
+    if (index >= input.vertices.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+SUResult geometry_face(SUGeometryInputRef geom_input, size_t face_index, GeometryInput::FaceInput** face) {
+  GeometryInput* input = get<GeometryInput>(geom_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (face_index >= input->faces.size()) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  *face = &input->faces[face_index];
+  return SU_ERROR_NONE;
+}
+
+SUResult geometry_edge(SUGeometryInputRef geom_input, size_t edge_index, LoopInput::EdgeInput** edge) {
+  GeometryInput* input = get<GeometryInput>(geom_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (edge_index >= input->edges.size()) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  *edge = &input->edges[edge_index].properties;
+  return SU_ERROR_NONE;
+}
+
+} // namespace
+
+
+SUResult SUGeometryInputCreate(SUGeometryInputRef* geom_input) {
+  return create<GeometryInput>(geom_input);
+}
+
+
+SUResult SUGeometryInputRelease(SUGeometryInputRef* geom_input) {
+  return release<GeometryInput>(geom_input);
+}
+
+
+SUResult SUGeometryInputAddVertex(SUGeometryInputRef geom_input, const struct SUPoint3D* point) {
+  GeometryInput* input = get<GeometryInput>(geom_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (point == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  input->vertices.push_back(*point);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGeometryInputSetVertices(SUGeometryInputRef geom_input, size_t num_vertices, const struct SUPoint3D points[]) {
+  GeometryInput* input = get<GeometryInput>(geom_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (points == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  input->vertices.assign(points, points + num_vertices);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGeometryInputAddEdge(SUGeometryInputRef geom_input, size_t vertex0_index, size_t vertex1_index, size_t* added_edge_index) {
+  GeometryInput* input = get<GeometryInput>(geom_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (vertex0_index >= input->vertices.size() || vertex1_index >= input->vertices.size()) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  if (vertex0_index == vertex1_index) {
+    return SU_ERROR_INVALID_ARGUMENT;
+  }
+  if (added_edge_index != nullptr) {
+    *added_edge_index = input->edges.size();
+  }
+  GeometryInput::EdgeInput edge;
+  edge.start = vertex0_index;
+  edge.end = vertex1_index;
+  input->edges.push_back(edge);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGeometryInputEdgeSetHidden(SUGeometryInputRef geom_input, size_t edge_index, bool hidden) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = geometry_edge(geom_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->hidden = hidden;
+  }
+  return result;
+}
+
+
+SUResult SUGeometryInputEdgeSetSoft(SUGeometryInputRef geom_input, size_t edge_index, bool soft) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = geometry_edge(geom_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->soft = soft;
+  }
+  return result;
+}
+
+
+SUResult SUGeometryInputEdgeSetSmooth(SUGeometryInputRef geom_input, size_t edge_index, bool smooth) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = geometry_edge(geom_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->smooth = smooth;
+  }
+  return result;
+}
+
+
+SUResult SUGeometryInputEdgeSetMaterial(SUGeometryInputRef geom_input, size_t edge_index, SUMaterialRef material) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = geometry_edge(geom_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->material = get<Material>(material);
+  }
+  return result;
+}
+
+
+SUResult SUGeometryInputEdgeSetLayer(SUGeometryInputRef geom_input, size_t edge_index, SULayerRef layer) {
+  LoopInput::EdgeInput* edge = nullptr;
+  SUResult result = geometry_edge(geom_input, edge_index, &edge);
+  if (result == SU_ERROR_NONE) {
+    edge->layer = get<Layer>(layer);
+  }
+  return result;
+}
+
+
+SUResult SUGeometryInputAddCurve(SUGeometryInputRef geom_input, size_t num_edges, const size_t edge_indices[], size_t* added_curve_index) {
+  GeometryInput* input = get<GeometryInput>(geom_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (edge_indices == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  for (size_t i = 0; i < num_edges; ++i) {
+    if (edge_indices[i] >= input->edges.size()) {
+      return SU_ERROR_OUT_OF_RANGE;
+    }
+  }
+  if (added_curve_index != nullptr) {
+    *added_curve_index = input->curves.size();
+  }
+  GeometryInput::CurveInput curve;
+  curve.edges.assign(edge_indices, edge_indices + num_edges);
+  curve.curve_type = SUCurveType_Simple;
+  input->curves.push_back(curve);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGeometryInputAddArcCurve(SUGeometryInputRef geom_input, size_t start_point, size_t end_point, const struct SUPoint3D* center, const struct SUVector3D* normal, size_t num_segments, size_t* added_curve_index, size_t* control_edge_index) {
+  GeometryInput* input = get<GeometryInput>(geom_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (center == nullptr || normal == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (start_point >= input->vertices.size() || end_point >= input->vertices.size()) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  const SUVector3D axis = normalize(*normal);
+  const SUVector3D start_radius = sub(input->vertices[start_point], *center);
+  const SUVector3D end_radius = sub(input->vertices[end_point], *center);
+  if (num_segments == 0 || length(axis) == 0.0 || length(start_radius) <= TOLERANCE ||
+      std::fabs(length(start_radius) - length(end_radius)) > TOLERANCE) {
+    return SU_ERROR_INVALID_ARGUMENT;
+  }
+  // The arc runs counter-clockwise about the normal, and is a full circle when it ends where it starts.
+  double angle = std::atan2(dot(axis, cross(start_radius, end_radius)), dot(start_radius, end_radius));
+  if (angle <= 0.0) {
+    angle += 2.0 * PI;
+  }
+  const SUVector3D perpendicular = cross(axis, start_radius);
+  GeometryInput::CurveInput curve;
+  curve.curve_type = SUCurveType_Arc;
+  size_t previous = start_point;
+  for (size_t i = 1; i <= num_segments; ++i) {
+    size_t next = end_point;
+    if (i < num_segments) {
+      const double step = angle * double(i) / double(num_segments);
+      const double c = std::cos(step);
+      const double s = std::sin(step);
+      next = input->vertices.size();
+      input->vertices.push_back(SUPoint3D{
+        center->x + start_radius.x * c + perpendicular.x * s,
+        center->y + start_radius.y * c + perpendicular.y * s,
+        center->z + start_radius.z * c + perpendicular.z * s
+      });
+    }
+    curve.edges.push_back(input->edges.size());
+    GeometryInput::EdgeInput edge;
+    edge.start = previous;
+    edge.end = next;
+    input->edges.push_back(edge);
+    previous = next;
+  }
+  if (added_curve_index != nullptr) {
+    *added_curve_index = input->curves.size();
+  }
+  if (control_edge_index != nullptr) {
+    *control_edge_index = curve.edges.front();
+  }
+  input->curves.push_back(curve);
+  ++input->num_arcs;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGeometryInputAddFace(SUGeometryInputRef geom_input, SULoopInputRef* outer_loop, size_t* added_face_index) {
+  GeometryInput* input = get<GeometryInput>(geom_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (outer_loop == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  LoopInput* loop = get<LoopInput>(*outer_loop);
+  if (loop == nullptr || !valid_loop(*input, *loop)) {
+    return SU_ERROR_INVALID_ARGUMENT;
+  }
+  if (added_face_index != nullptr) {
+    *added_face_index = input->faces.size();
+  }
+  // The geometry input takes over the loop input.
+  GeometryInput::FaceInput face;
+  face.outer.reset(loop);
+  input->faces.push_back(std::move(face));
+  SUSetInvalid(*outer_loop);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGeometryInputFaceAddInnerLoop(SUGeometryInputRef geom_input, size_t face_index, SULoopInputRef* loop_input) {
+  GeometryInput::FaceInput* face = nullptr;
+  SUResult result = geometry_face(geom_input, face_index, &face);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (loop_input == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  LoopInput* loop = get<LoopInput>(*loop_input);
+  if (loop == nullptr || !valid_loop(*get<GeometryInput>(geom_input), *loop)) {
+    return SU_ERROR_INVALID_ARGUMENT;
+  }
+  face->inner.emplace_back(loop);
+  SUSetInvalid(*loop_input);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGeometryInputFaceSetReverse(SUGeometryInputRef geom_input, size_t face_index, bool reverse) {
+  GeometryInput::FaceInput* face = nullptr;
+  SUResult result = geometry_face(geom_input, face_index, &face);
+  if (result == SU_ERROR_NONE) {
+    face->reverse = reverse;
+  }
+  return result;
+}
+
+
+SUResult SUGeometryInputFaceSetLayer(SUGeometryInputRef geom_input, size_t face_index, SULayerRef layer) {
+  GeometryInput::FaceInput* face = nullptr;
+  SUResult result = geometry_face(geom_input, face_index, &face);
+  if (result == SU_ERROR_NONE) {
+    face->layer = get<Layer>(layer);
+  }
+  return result;
+}
+
+
+SUResult SUGeometryInputFaceSetHidden(SUGeometryInputRef geom_input, size_t face_index, bool hidden) {
+  GeometryInput::FaceInput* face = nullptr;
+  SUResult result = geometry_face(geom_input, face_index, &face);
+  if (result == SU_ERROR_NONE) {
+    face->hidden = hidden;
+  }
+  return result;
+}
+
+
+// Texture coordinates are not supported, so only the material of a material input is used.
+SUResult SUGeometryInputFaceSetFrontMaterial(SUGeometryInputRef geom_input, size_t face_index, const struct SUMaterialInput* material_input) {
+  GeometryInput::FaceInput* face = nullptr;
+  SUResult result = geometry_face(geom_input, face_index, &face);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (material_input == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  face->front_material = get<Material>(material_input->material);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGeometryInputFaceSetBackMaterial(SUGeometryInputRef geom_input, size_t face_index, const struct SUMaterialInput* material_input) {
+  GeometryInput::FaceInput* face = nullptr;
+  SUResult result = geometry_face(geom_input, face_index, &face);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (material_input == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  face->back_material = get<Material>(material_input->material);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUGeometryInputGetCounts(SUGeometryInputRef geom_input, size_t* vertices_count, size_t* faces_count, size_t* edge_count, size_t* curve_count, size_t* arc_count) {
+  const GeometryInput* input = get<GeometryInput>(geom_input);
+  if (input == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (vertices_count == nullptr || faces_count == nullptr || edge_count == nullptr || curve_count == nullptr || arc_count == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *vertices_count = input->vertices.size();
+  *faces_count = input->faces.size();
+  *edge_count = input->edges.size();
+  *curve_count = input->curves.size();
+  *arc_count = input->num_arcs;
+  return SU_ERROR_NONE;
+}
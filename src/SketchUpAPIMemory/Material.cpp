@@ -0,0 +1,341 @@
+//
+//  Material.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cmath>
+
+#include "MemoryAPI.hpp"
+
+using namespace SUMemory;
+
+SUResult SUMaterialCreate(SUMaterialRef* material) {
+  return create<Material>(material);
+}
+
+
+SUResult SUMaterialRelease(SUMaterialRef* material) {
+  return release_entity<Material>(material);
+}
+
+
+SUEntityRef SUMaterialToEntity(SUMaterialRef material) {
+  return convert<Material, SUEntityRef>(material);
+}
+
+
+SUMaterialRef SUMaterialFromEntity(SUEntityRef entity) {
+  return convert<Material, SUMaterialRef>(entity);
+}
+
+
+SUResult SUMaterialGetName(SUMaterialRef material, SUStringRef* name) {
+  const Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_string(name, material_object->name);
+}
+
+
+SUResult SUMaterialGetNameLegacyBehavior(SUMaterialRef material, SUStringRef* name) {
+  return SUMaterialGetName(material, name);
+}
+
+
+SUResult SUMaterialSetName(SUMaterialRef material, const char* name) {
+  Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  material_object->name = name;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUMaterialGetColor(SUMaterialRef material, SUColor* color) {
+  const Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (color == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (!material_object->has_color) {
+    return SU_ERROR_NO_DATA;
+  }
+  *color = material_object->color;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUMaterialSetColor(SUMaterialRef material, const SUColor* color) {
+  Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (color == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  material_object->color = *color;
+  material_object->has_color = true;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUMaterialGetOpacity(SUMaterialRef material, double* alpha) {
+  const Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(alpha, material_object->opacity);
+}
+
+
+SUResult SUMaterialSetOpacity(SUMaterialRef material, double alpha) {
+  Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (alpha < 0.0 || alpha > 1.0) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  material_object->opacity = alpha;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUMaterialGetUseOpacity(SUMaterialRef material, bool* use_opacity) {
+  const Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(use_opacity, material_object->use_opacity);
+}
+
+
+SUResult SUMaterialSetUseOpacity(SUMaterialRef material, bool use_opacity) {
+  Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  material_object->use_opacity = use_opacity;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUMaterialGetType(SUMaterialRef material, enum SUMaterialType* type) {
+  const Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(type, material_object->material_type);
+}
+
+
+SUResult SUMaterialSetType(SUMaterialRef material, enum SUMaterialType type) {
+  Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  material_object->material_type = type;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUMaterialGetTexture(SUMaterialRef material, SUTextureRef* texture) {
+  const Material* material_object = get<Material>(material);
+  if (material_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (texture == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (material_object->texture == nullptr) {
+    return SU_ERROR_NO_DATA;
+  }
+  *texture = to_ref<SUTextureRef>(material_object->texture);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUMaterialSetTexture(SUMaterialRef material, SUTextureRef texture) {
+  Material* material_object = get<Material>(material);
+  Texture* texture_object = get<Texture>(texture);
+  if (material_object == nullptr || texture_object == nullptr || texture_object->attached) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (texture_object->image.data.empty()) {
+    return SU_ERROR_GENERIC;
+  }
+  // The material takes over the texture, and releases the one it had.
+  delete material_object->texture;
+  texture_object->attached = true;
+  texture_object->model = material_object->model;
+  material_object->texture = texture_object;
+  material_object->material_type = SUMaterialType_Textured;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SULayerCreate(SULayerRef* layer) {
+  return create<Layer>(layer);
+}
+
+
+SUResult SULayerRelease(SULayerRef* layer) {
+  return release_entity<Layer>(layer);
+}
+
+
+SUEntityRef SULayerToEntity(SULayerRef layer) {
+  return convert<Layer, SUEntityRef>(layer);
+}
+
+
+SULayerRef SULayerFromEntity(SUEntityRef entity) {
+  return convert<Layer, SULayerRef>(entity);
+}
+
+
+SUResult SULayerGetName(SULayerRef layer, SUStringRef* name) {
+  const Layer* layer_object = get<Layer>(layer);
+  if (layer_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_string(name, layer_object->name);
+}
+
+
+SUResult SULayerSetName(SULayerRef layer, const char* name) {
+  Layer* layer_object = get<Layer>(layer);
+  if (layer_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  layer_object->name = name;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUAxesCreate(SUAxesRef* axes) {
+  return create<Axes>(axes);
+}
+
+
+SUResult SUAxesCreateCustom(SUAxesRef* axes, const struct SUPoint3D* origin, const struct SUVector3D* xaxis, const struct SUVector3D* yaxis, const struct SUVector3D* zaxis) {
+  if (origin == nullptr || xaxis == nullptr || yaxis == nullptr || zaxis == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  SUResult result = check_create(axes);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  const SUVector3D x_axis = normalize(*xaxis);
+  const SUVector3D y_axis = normalize(*yaxis);
+  const SUVector3D z_axis = normalize(*zaxis);
+  const double epsilon = 1.0e-10;
+  if (length(x_axis) == 0.0 || length(y_axis) == 0.0 || length(z_axis) == 0.0 ||
+      std::fabs(dot(x_axis, y_axis)) > epsilon || std::fabs(dot(y_axis, z_axis)) > epsilon || std::fabs(dot(z_axis, x_axis)) > epsilon) {
+    return SU_ERROR_GENERIC;
+  }
+  Axes* created = new Axes();
+  created->origin = *origin;
+  created->x_axis = x_axis;
+  created->y_axis = y_axis;
+  created->z_axis = z_axis;
+  *axes = to_ref<SUAxesRef>(created);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUAxesRelease(SUAxesRef* axes) {
+  return release_entity<Axes>(axes);
+}
+
+
+SUEntityRef SUAxesToEntity(SUAxesRef axes) {
+  return convert<Axes, SUEntityRef>(axes);
+}
+
+
+SUAxesRef SUAxesFromEntity(SUEntityRef entity) {
+  return convert<Axes, SUAxesRef>(entity);
+}
+
+
+SUDrawingElementRef SUAxesToDrawingElement(SUAxesRef axes) {
+  return convert<Axes, SUDrawingElementRef>(axes);
+}
+
+
+SUResult SUAxesGetOrigin(SUAxesRef axes, struct SUPoint3D* origin) {
+  const Axes* axes_object = get<Axes>(axes);
+  if (axes_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(origin, axes_object->origin);
+}
+
+
+SUResult SUAxesGetXAxis(SUAxesRef axes, struct SUVector3D* axis) {
+  const Axes* axes_object = get<Axes>(axes);
+  if (axes_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(axis, axes_object->x_axis);
+}
+
+
+SUResult SUAxesGetYAxis(SUAxesRef axes, struct SUVector3D* axis) {
+  const Axes* axes_object = get<Axes>(axes);
+  if (axes_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(axis, axes_object->y_axis);
+}
+
+
+SUResult SUAxesGetZAxis(SUAxesRef axes, struct SUVector3D* axis) {
+  const Axes* axes_object = get<Axes>(axes);
+  if (axes_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(axis, axes_object->z_axis);
+}
+
+
+SUResult SUAxesGetTransform(SUAxesRef axes, struct SUTransformation* transform) {
+  const Axes* axes_object = get<Axes>(axes);
+  if (axes_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return SUTransformationSetFromPointAndAxes(transform, &axes_object->origin, &axes_object->x_axis, &axes_object->y_axis, &axes_object->z_axis);
+}
@@ -0,0 +1,667 @@
+//
+//  MemoryAPI.hpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MemoryAPI_hpp
+#define MemoryAPI_hpp
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+/**
+* In-memory implementation of the subset of the SketchUp C API that the wrapper uses, for platforms without the
+* SketchUp binaries. Every SU*Ref points at one of the objects below. Ownership follows the SDK: objects the caller
+* creates are released by the caller until they are added to a model, entities or another object, which then owns them.
+* File import and export are not supported.
+*/
+namespace SUMemory {
+
+/**
+* Distance under which two positions are the same, as in SketchUp.
+*/
+const double TOLERANCE = 1.0e-3;
+
+/**
+* Reference types for API objects that have no SURefType of their own.
+*/
+const SURefType RefType_String = SURefType(1001);
+const SURefType RefType_GeometryInput = SURefType(1002);
+const SURefType RefType_LoopInput = SURefType(1003);
+const SURefType RefType_OptionsManager = SURefType(1004);
+const SURefType RefType_OptionsProvider = SURefType(1005);
+
+struct AttributeDictionary;
+struct ComponentDefinition;
+struct ComponentInstance;
+struct Curve;
+struct Edge;
+struct Entities;
+struct Face;
+struct Layer;
+struct Loop;
+struct Material;
+struct Model;
+struct Texture;
+struct Vertex;
+
+/**
+* Base of every object a reference can point at. The type is checked whenever a reference is converted back.
+*/
+struct Handle {
+  explicit Handle(SURefType ref_type): type(ref_type) {}
+  virtual ~Handle() = default;
+
+  Handle(const Handle&) = delete;
+  Handle& operator=(const Handle&) = delete;
+
+  const SURefType type;
+};
+
+/**
+* An entity. Until it is attached, an entity is owned by the caller or by the unattached object that holds it, and the
+* entities it owns are listed in `owned`. A model owns every attached entity directly, so the list is empty then.
+*/
+struct Object : Handle {
+  explicit Object(SURefType ref_type);
+  ~Object() override;
+
+  static bool accepts(SURefType ref_type);
+
+  /**
+  * Moves the object, and the objects it owns, into the objects owned by this one.
+  */
+  void take(Object* object);
+
+  int32_t id;
+  int64_t pid;
+  bool attached = false;
+  Model* model = nullptr;
+  Object* holder = nullptr;
+  Entities* parent = nullptr;
+  std::vector<Object*> owned;
+  std::vector<AttributeDictionary*> dictionaries;
+};
+
+/**
+* Hands an object to the owner of another, either its model or the unattached object at the top of its holders.
+*/
+void give(Object* owner, Object* object);
+
+/**
+* Removes an object from its owner and deletes it.
+*/
+void destroy(Object* object);
+
+struct TypedValue : Handle {
+  TypedValue(): Handle(SURefType_TypedValue) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_TypedValue; }
+
+  /**
+  * Deep copy of the type and value of another typed value.
+  */
+  void assign(const TypedValue& other);
+  void clear();
+
+  SUTypedValueType value_type = SUTypedValueType_Empty;
+  int64_t integer = 0;
+  double real = 0.0;
+  SUColor color{0, 0, 0, 0};
+  double vector[3] = {0.0, 0.0, 0.0};
+  std::string string;
+  std::vector<std::unique_ptr<TypedValue>> items;
+};
+
+/**
+* Key-value store of the attribute dictionaries and the option providers. Keys keep their insertion order.
+*/
+struct ValueMap {
+  const TypedValue* find(const std::string& key) const;
+  void set(const std::string& key, const TypedValue& value);
+
+  std::vector<std::pair<std::string, std::unique_ptr<TypedValue>>> values;
+  std::unordered_map<std::string, size_t> index;
+};
+
+struct String : Handle {
+  String(): Handle(RefType_String) {}
+  static bool accepts(SURefType ref_type) { return ref_type == RefType_String; }
+
+  std::string utf8;
+};
+
+struct AttributeDictionary : Object {
+  AttributeDictionary(): Object(SURefType_AttributeDictionary) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_AttributeDictionary; }
+
+  std::string name;
+  ValueMap values;
+};
+
+struct DrawingElement : Object {
+  explicit DrawingElement(SURefType ref_type): Object(ref_type) {}
+  static bool accepts(SURefType ref_type);
+
+  Material* material = nullptr;
+  Layer* layer = nullptr;
+  bool hidden = false;
+  bool casts_shadows = true;
+  bool receives_shadows = true;
+};
+
+struct Vertex : Object {
+  explicit Vertex(const SUPoint3D& point): Object(SURefType_Vertex), position(point) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Vertex; }
+
+  SUPoint3D position;
+};
+
+struct Edge : DrawingElement {
+  Edge(): DrawingElement(SURefType_Edge) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Edge; }
+
+  Vertex* start = nullptr;
+  Vertex* end = nullptr;
+  std::vector<Face*> faces;
+  Curve* curve = nullptr;
+  bool soft = false;
+  bool smooth = false;
+  SUColor color{0, 0, 0, 255};
+};
+
+struct Curve : Object {
+  Curve(): Object(SURefType_Curve) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Curve; }
+
+  SUCurveType curve_type = SUCurveType_Simple;
+  std::vector<Edge*> edges;
+};
+
+/**
+* A loop of a face. Edge i runs from vertex i to vertex i + 1.
+*/
+struct Loop : Object {
+  Loop(): Object(SURefType_Loop) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Loop; }
+
+  Face* face = nullptr;
+  std::vector<Vertex*> vertices;
+  std::vector<Edge*> edges;
+};
+
+struct Face : DrawingElement {
+  Face(): DrawingElement(SURefType_Face) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Face; }
+
+  Loop* outer = nullptr;
+  std::vector<Loop*> inner;
+  Material* back_material = nullptr;
+  SUPlane3D plane{0.0, 0.0, 1.0, 0.0};
+};
+
+/**
+* Index of the vertices in an entities collection by position, so that coincident vertices are welded.
+*/
+struct VertexIndex {
+  Vertex* find(const SUPoint3D& point) const;
+  void insert(Vertex* vertex);
+  void erase(Vertex* vertex);
+
+  std::unordered_map<uint64_t, std::vector<Vertex*>> cells;
+};
+
+struct Entities : Handle {
+  Entities(Model* entities_model, ComponentDefinition* entities_definition):
+    Handle(SURefType_Entities),
+    model(entities_model),
+    definition(entities_definition)
+  {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Entities; }
+
+  /**
+  * Takes ownership of an unattached entity, on behalf of the model or definition of these entities.
+  */
+  void take(Object* object);
+
+  /**
+  * Adds a face, merging its vertices and edges with those already in the entities.
+  */
+  void add_face(Face* face);
+  void add_edge(Edge* edge);
+  void weld_loop(Loop* loop);
+
+  /**
+  * The edge joining two vertices, or null if there is none.
+  */
+  Edge* find_edge(const Vertex* a, const Vertex* b) const;
+
+  /**
+  * Moves a vertex, keeping the vertex index up to date.
+  */
+  void move_vertex(Vertex* vertex, const SUPoint3D& point);
+
+  Model* model;
+  ComponentDefinition* definition;
+  std::vector<Face*> faces;
+  std::vector<Edge*> edges;
+  std::vector<ComponentInstance*> instances;
+  std::vector<ComponentInstance*> groups;
+  VertexIndex vertices;
+  std::unordered_map<uint64_t, Edge*> edge_index;
+};
+
+struct Layer : Object {
+  Layer(): Object(SURefType_Layer) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Layer; }
+
+  std::string name;
+};
+
+struct ImageData {
+  size_t width = 0;
+  size_t height = 0;
+  size_t bits_per_pixel = 0;
+  size_t row_padding = 0;
+  std::vector<SUByte> data;
+};
+
+struct ImageRep : Handle {
+  ImageRep(): Handle(SURefType_ImageRep) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_ImageRep; }
+
+  ImageData image;
+};
+
+struct Texture : Object {
+  Texture(): Object(SURefType_Texture) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Texture; }
+
+  ImageData image;
+  std::string file_name;
+  double s_scale = 1.0;
+  double t_scale = 1.0;
+};
+
+struct Material : Object {
+  Material(): Object(SURefType_Material) {}
+  ~Material() override;
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Material; }
+
+  std::string name;
+  SUColor color{0, 0, 0, 255};
+  bool has_color = false;
+  double opacity = 1.0;
+  bool use_opacity = false;
+  SUMaterialType material_type = SUMaterialType_Colored;
+  Texture* texture = nullptr;
+};
+
+struct Axes : DrawingElement {
+  Axes(): DrawingElement(SURefType_Axes) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Axes; }
+
+  SUPoint3D origin{0.0, 0.0, 0.0};
+  SUVector3D x_axis{1.0, 0.0, 0.0};
+  SUVector3D y_axis{0.0, 1.0, 0.0};
+  SUVector3D z_axis{0.0, 0.0, 1.0};
+};
+
+struct ComponentDefinition : DrawingElement {
+  explicit ComponentDefinition(SUComponentType definition_type);
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_ComponentDefinition; }
+
+  SUComponentType component_type;
+  std::string name;
+  SUComponentBehavior behavior;
+  Entities entities;
+  std::vector<ComponentInstance*> instances;
+};
+
+/**
+* A component instance, or a group when its type is SURefType_Group.
+*/
+struct ComponentInstance : DrawingElement {
+  explicit ComponentInstance(SURefType ref_type);
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_ComponentInstance || ref_type == SURefType_Group; }
+
+  ComponentDefinition* definition = nullptr;
+  SUTransformation transform;
+  std::string name;
+};
+
+struct InstancePath : Handle {
+  InstancePath(): Handle(SURefType_InstancePath) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_InstancePath; }
+
+  std::vector<ComponentInstance*> instances;
+  Object* leaf = nullptr;
+};
+
+struct LoopInput : Handle {
+  struct EdgeInput {
+    bool hidden = false;
+    bool soft = false;
+    bool smooth = false;
+    Layer* layer = nullptr;
+    Material* material = nullptr;
+  };
+
+  LoopInput(): Handle(RefType_LoopInput) {}
+  static bool accepts(SURefType ref_type) { return ref_type == RefType_LoopInput; }
+
+  std::vector<size_t> vertex_indices;
+  std::vector<EdgeInput> edges;
+};
+
+struct GeometryInput : Handle {
+  struct FaceInput {
+    std::unique_ptr<LoopInput> outer;
+    std::vector<std::unique_ptr<LoopInput>> inner;
+    Material* front_material = nullptr;
+    Material* back_material = nullptr;
+    Layer* layer = nullptr;
+    bool hidden = false;
+    bool reverse = false;
+  };
+
+  struct EdgeInput {
+    size_t start;
+    size_t end;
+    LoopInput::EdgeInput properties;
+  };
+
+  struct CurveInput {
+    std::vector<size_t> edges;
+    SUCurveType curve_type;
+  };
+
+  GeometryInput(): Handle(RefType_GeometryInput) {}
+  static bool accepts(SURefType ref_type) { return ref_type == RefType_GeometryInput; }
+
+  std::vector<SUPoint3D> vertices;
+  std::vector<FaceInput> faces;
+  std::vector<EdgeInput> edges;
+  std::vector<CurveInput> curves;
+  size_t num_arcs = 0;
+};
+
+struct MeshHelper : Handle {
+  MeshHelper(): Handle(SURefType_MeshHelper) {}
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_MeshHelper; }
+
+  std::vector<SUPoint3D> vertices;
+  std::vector<SUVector3D> normals;
+  std::vector<size_t> indices;
+};
+
+/**
+* The rendering options, shadow info and option providers of a model, which are all key-value stores.
+*/
+struct Options : Handle {
+  Options(SURefType ref_type, const std::string& options_name): Handle(ref_type), name(options_name) {}
+  static bool accepts(SURefType ref_type) {
+    return ref_type == SURefType_RenderingOptions || ref_type == SURefType_ShadowInfo || ref_type == RefType_OptionsProvider;
+  }
+
+  std::string name;
+  ValueMap values;
+};
+
+struct OptionsManager : Handle {
+  OptionsManager(): Handle(RefType_OptionsManager) {}
+  static bool accepts(SURefType ref_type) { return ref_type == RefType_OptionsManager; }
+
+  std::vector<std::unique_ptr<Options>> providers;
+};
+
+struct Model : Handle {
+  Model();
+  ~Model() override;
+  static bool accepts(SURefType ref_type) { return ref_type == SURefType_Model; }
+
+  /**
+  * Takes ownership of an entity and everything it owns.
+  */
+  void adopt(Object* object);
+
+  std::string name;
+  Entities entities;
+  std::unordered_set<Object*> objects;
+  std::vector<Material*> materials;
+  std::vector<Layer*> layers;
+  std::vector<ComponentDefinition*> definitions;
+  std::vector<ComponentDefinition*> group_definitions;
+  std::vector<AttributeDictionary*> dictionaries;
+  Axes* axes;
+  OptionsManager options_manager;
+  Options rendering_options;
+  Options shadow_info;
+};
+
+/**
+* The object a reference points at, or null if the reference is invalid or of another type.
+*/
+template <class T>
+T* cast(const void* ptr) {
+  Handle* handle = static_cast<Handle*>(const_cast<void*>(ptr));
+  if (handle == nullptr || !T::accepts(handle->type)) {
+    return nullptr;
+  }
+  return static_cast<T*>(handle);
+}
+
+template <class T, class Ref>
+T* get(Ref ref) {
+  return cast<T>(ref.ptr);
+}
+
+/**
+* The group a reference points at. Groups are component instances with their own reference type.
+*/
+template <class Ref>
+ComponentInstance* get_group(Ref ref) {
+  ComponentInstance* instance = get<ComponentInstance>(ref);
+  return instance != nullptr && instance->type == SURefType_Group ? instance : nullptr;
+}
+
+template <class Ref>
+Ref to_ref(Handle* handle) {
+  Ref ref = {handle};
+  return ref;
+}
+
+/**
+* Converts between two reference types, giving an invalid reference if the object is not of the target type.
+*/
+template <class T, class ToRef, class FromRef>
+ToRef convert(FromRef ref) {
+  return to_ref<ToRef>(get<T>(ref));
+}
+
+template <class Ref>
+SUResult check_create(Ref* ref) {
+  if (ref == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (SUIsValid(*ref)) {
+    return SU_ERROR_OVERWRITE_VALID;
+  }
+  return SU_ERROR_NONE;
+}
+
+/**
+* Creates an object for a reference that must be invalid.
+*/
+template <class T, class Ref, class... Args>
+SUResult create(Ref* ref, Args&&... args) {
+  SUResult result = check_create(ref);
+  if (result == SU_ERROR_NONE) {
+    *ref = to_ref<Ref>(new T(std::forward<Args>(args)...));
+  }
+  return result;
+}
+
+/**
+* Deletes an object the caller owns. Entities owned by a model or another object can not be released.
+*/
+template <class T, class Ref>
+SUResult release(Ref* ref) {
+  if (ref == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  T* object = get<T>(*ref);
+  if (object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  delete object;
+  SUSetInvalid(*ref);
+  return SU_ERROR_NONE;
+}
+
+template <class T, class Ref>
+SUResult release_entity(Ref* ref) {
+  if (ref == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  T* object = get<T>(*ref);
+  if (object == nullptr || object->attached) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  delete object;
+  SUSetInvalid(*ref);
+  return SU_ERROR_NONE;
+}
+
+/**
+* Copies the first `len` objects into an array of references, as the SU*Get* functions that fill arrays do.
+*/
+template <class Ref, class T>
+SUResult fill(const std::vector<T*>& objects, size_t len, Ref refs[], size_t* count) {
+  if (refs == nullptr || count == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *count = std::min(len, objects.size());
+  for (size_t i = 0; i < *count; ++i) {
+    refs[i] = to_ref<Ref>(objects[i]);
+  }
+  return SU_ERROR_NONE;
+}
+
+template <class T>
+SUResult get_count(const std::vector<T>& objects, size_t* count) {
+  if (count == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *count = objects.size();
+  return SU_ERROR_NONE;
+}
+
+template <class T>
+SUResult set_value(T* out, const T& value) {
+  if (out == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *out = value;
+  return SU_ERROR_NONE;
+}
+
+/**
+* Writes a string to an output string, which must be a valid string object.
+*/
+SUResult set_string(SUStringRef* out, const std::string& value);
+
+/**
+* Writes strings to an array of output strings.
+*/
+SUResult set_strings(const std::vector<std::string>& values, size_t len, SUStringRef out[], size_t* count);
+
+SUResult get_keys(const ValueMap& values, size_t len, SUStringRef keys[], size_t* count);
+SUResult get_value(const ValueMap& values, const char* key, SUTypedValueRef* value_out);
+SUResult set_value(ValueMap& values, const char* key, SUTypedValueRef value_in);
+
+/**
+* Adds a definition to a model, renaming it if another definition has its name.
+*/
+void add_definition(Model* model, ComponentDefinition* definition);
+
+/**
+* Geometry helpers.
+*/
+SUVector3D sub(const SUPoint3D& a, const SUPoint3D& b);
+SUVector3D cross(const SUVector3D& a, const SUVector3D& b);
+double dot(const SUVector3D& a, const SUVector3D& b);
+double length(const SUVector3D& vector);
+SUVector3D normalize(const SUVector3D& vector);
+bool same_position(const SUPoint3D& a, const SUPoint3D& b);
+SUTransformation identity();
+SUPoint3D transform_point(const SUTransformation& transform, const SUPoint3D& point);
+SUVector3D transform_vector(const SUTransformation& transform, const SUVector3D& vector);
+SUTransformation multiply(const SUTransformation& a, const SUTransformation& b);
+
+/**
+* The unnormalized normal of a polygon, from Newell's method. Its length is twice the polygon's area.
+*/
+SUVector3D polygon_normal(const std::vector<SUPoint3D>& points);
+std::vector<SUPoint3D> loop_points(const Loop* loop);
+
+/**
+* Creates an unattached face, owning its loops, vertices and edges, from the positions of its outer loop.
+*/
+SUResult create_face(const std::vector<SUPoint3D>& points, const LoopInput& outer, Face** face);
+SUResult add_inner_loop(Face* face, const std::vector<SUPoint3D>& points, const LoopInput& input);
+void reverse_face(Face* face);
+void update_plane(Face* face);
+
+/**
+* Creates an unattached edge, owning its two vertices.
+*/
+Edge* create_edge(const SUPoint3D& start, const SUPoint3D& end);
+
+/**
+* Bounding boxes are inverted while empty, and given to callers as a box at the origin.
+*/
+SUBoundingBox3D empty_bounds();
+void add_bounds(SUBoundingBox3D& bounds, const SUPoint3D& point);
+void add_bounds(SUBoundingBox3D& bounds, const SUBoundingBox3D& other, const SUTransformation& transform);
+SUBoundingBox3D entities_bounds(const Entities& entities);
+SUBoundingBox3D element_bounds(const DrawingElement* element);
+SUResult set_bounds(SUBoundingBox3D* out, const SUBoundingBox3D& bounds);
+
+/**
+* Triangulates a face for SUMeshHelper.
+*/
+void triangulate(const Face* face, MeshHelper& mesh);
+
+} // namespace SUMemory
+
+#endif /* MemoryAPI_hpp */
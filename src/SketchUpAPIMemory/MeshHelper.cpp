@@ -0,0 +1,304 @@
+//
+//  MeshHelper.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cmath>
+#include <limits>
+
+#include "MemoryAPI.hpp"
+
+namespace SUMemory {
+
+namespace {
+
+struct Point2D {
+  double x;
+  double y;
+};
+
+double orient(const Point2D& a, const Point2D& b, const Point2D& c) {
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+double signed_area(const std::vector<Point2D>& points, const std::vector<size_t>& polygon) {
+  double area = 0.0;
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const Point2D& current = points[polygon[i]];
+    const Point2D& next = points[polygon[(i + 1) % polygon.size()]];
+    area += current.x * next.y - next.x * current.y;
+  }
+  return 0.5 * area;
+}
+
+bool same_point(const Point2D& a, const Point2D& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+/**
+* Whether two segments cross at a point inside both of them. Segments that only share an end point do not cross.
+*/
+bool segments_cross(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+  if (same_point(a, c) || same_point(a, d) || same_point(b, c) || same_point(b, d)) {
+    return false;
+  }
+  const double d1 = orient(c, d, a);
+  const double d2 = orient(c, d, b);
+  const double d3 = orient(a, b, c);
+  const double d4 = orient(a, b, d);
+  return ((d1 > 0.0 && d2 < 0.0) || (d1 < 0.0 && d2 > 0.0)) && ((d3 > 0.0 && d4 < 0.0) || (d3 < 0.0 && d4 > 0.0));
+}
+
+bool crosses_polygon(const std::vector<Point2D>& points, const std::vector<size_t>& polygon, const Point2D& a, const Point2D& b) {
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    if (segments_cross(a, b, points[polygon[i]], points[polygon[(i + 1) % polygon.size()]])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+* Joins a hole to the polygon with a pair of coincident edges, from the hole's rightmost vertex to the nearest polygon
+* vertex it can see.
+*/
+void bridge_hole(const std::vector<Point2D>& points, std::vector<size_t>& polygon, const std::vector<size_t>& hole,
+                 const std::vector<std::vector<size_t>>& other_holes) {
+  size_t hole_start = 0;
+  for (size_t i = 1; i < hole.size(); ++i) {
+    if (points[hole[i]].x > points[hole[hole_start]].x) {
+      hole_start = i;
+    }
+  }
+  const Point2D& from = points[hole[hole_start]];
+  size_t bridge = 0;
+  double best_distance = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const Point2D& to = points[polygon[i]];
+    const double distance = (to.x - from.x) * (to.x - from.x) + (to.y - from.y) * (to.y - from.y);
+    if (distance >= best_distance) {
+      continue;
+    }
+    bool visible = !crosses_polygon(points, polygon, from, to) && !crosses_polygon(points, hole, from, to);
+    for (size_t j = 0; visible && j < other_holes.size(); ++j) {
+      visible = !crosses_polygon(points, other_holes[j], from, to);
+    }
+    if (visible) {
+      bridge = i;
+      best_distance = distance;
+    }
+  }
+  std::vector<size_t> joined;
+  joined.reserve(polygon.size() + hole.size() + 2);
+  joined.insert(joined.end(), polygon.begin(), polygon.begin() + bridge + 1);
+  for (size_t i = 0; i <= hole.size(); ++i) {
+    joined.push_back(hole[(hole_start + i) % hole.size()]);
+  }
+  joined.insert(joined.end(), polygon.begin() + bridge, polygon.end());
+  polygon.swap(joined);
+}
+
+bool inside_triangle(const Point2D& p, const Point2D& a, const Point2D& b, const Point2D& c) {
+  return orient(a, b, p) >= 0.0 && orient(b, c, p) >= 0.0 && orient(c, a, p) >= 0.0;
+}
+
+bool is_ear(const std::vector<Point2D>& points, const std::vector<size_t>& polygon, size_t prev, size_t current, size_t next) {
+  const Point2D& a = points[polygon[prev]];
+  const Point2D& b = points[polygon[current]];
+  const Point2D& c = points[polygon[next]];
+  if (orient(a, b, c) <= 0.0) {
+    return false;
+  }
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const Point2D& p = points[polygon[i]];
+    if (i == prev || i == current || i == next || same_point(p, a) || same_point(p, b) || same_point(p, c)) {
+      continue;
+    }
+    if (inside_triangle(p, a, b, c)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+* Ear clipping of a counter-clockwise polygon. A polygon with no ears left, which only happens when it is degenerate,
+* is finished as a fan.
+*/
+void clip_ears(const std::vector<Point2D>& points, std::vector<size_t> polygon, std::vector<size_t>& indices) {
+  size_t current = 0;
+  size_t misses = 0;
+  while (polygon.size() > 3) {
+    const size_t prev = (current + polygon.size() - 1) % polygon.size();
+    const size_t next = (current + 1) % polygon.size();
+    if (misses < polygon.size() && !is_ear(points, polygon, prev, current, next)) {
+      current = next;
+      ++misses;
+      continue;
+    }
+    indices.insert(indices.end(), {polygon[prev], polygon[current], polygon[next]});
+    polygon.erase(polygon.begin() + current);
+    current = current % polygon.size();
+    misses = 0;
+  }
+  indices.insert(indices.end(), polygon.begin(), polygon.end());
+}
+
+} // namespace
+
+
+void triangulate(const Face* face, MeshHelper& mesh) {
+  const SUVector3D normal{face->plane.a, face->plane.b, face->plane.c};
+  // Project onto the plane of the face, so that loops which wind about the normal are counter-clockwise.
+  const SUVector3D reference = std::fabs(normal.x) < 0.9 ? SUVector3D{1.0, 0.0, 0.0} : SUVector3D{0.0, 1.0, 0.0};
+  const SUVector3D u_axis = normalize(cross(reference, normal));
+  const SUVector3D v_axis = cross(normal, u_axis);
+  const SUPoint3D origin{0.0, 0.0, 0.0};
+
+  std::vector<Point2D> points;
+  std::vector<std::vector<size_t>> loops;
+  std::vector<const Loop*> face_loops(1, face->outer);
+  face_loops.insert(face_loops.end(), face->inner.begin(), face->inner.end());
+  for (const Loop* loop : face_loops) {
+    std::vector<size_t> polygon;
+    for (const Vertex* vertex : loop->vertices) {
+      const SUVector3D offset = sub(vertex->position, origin);
+      polygon.push_back(mesh.vertices.size());
+      mesh.vertices.push_back(vertex->position);
+      mesh.normals.push_back(normal);
+      points.push_back(Point2D{dot(offset, u_axis), dot(offset, v_axis)});
+    }
+    loops.push_back(std::move(polygon));
+  }
+  if (signed_area(points, loops[0]) < 0.0) {
+    std::reverse(loops[0].begin(), loops[0].end());
+  }
+  for (size_t i = 1; i < loops.size(); ++i) {
+    if (signed_area(points, loops[i]) > 0.0) {
+      std::reverse(loops[i].begin(), loops[i].end());
+    }
+  }
+
+  // Holes are bridged from right to left, so that each bridge only has to avoid the holes still to come.
+  std::vector<std::vector<size_t>> holes(loops.begin() + 1, loops.end());
+  std::sort(holes.begin(), holes.end(), [&points](const std::vector<size_t>& a, const std::vector<size_t>& b) {
+    double a_max = -std::numeric_limits<double>::max();
+    double b_max = a_max;
+    for (size_t index : a) { a_max = std::max(a_max, points[index].x); }
+    for (size_t index : b) { b_max = std::max(b_max, points[index].x); }
+    return a_max > b_max;
+  });
+  std::vector<size_t> polygon = loops[0];
+  for (size_t i = 0; i < holes.size(); ++i) {
+    const std::vector<std::vector<size_t>> remaining(holes.begin() + i + 1, holes.end());
+    bridge_hole(points, polygon, holes[i], remaining);
+  }
+  mesh.indices.reserve(3 * (polygon.size() - 2));
+  clip_ears(points, polygon, mesh.indices);
+}
+
+} // namespace SUMemory
+
+using namespace SUMemory;
+
+namespace {
+
+template <class T>
+SUResult fill_values(const std::vector<T>& values, size_t len, T out[], size_t* count) {
+  if (out == nullptr || count == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *count = std::min(len, values.size());
+  std::copy(values.begin(), values.begin() + *count, out);
+  return SU_ERROR_NONE;
+}
+
+} // namespace
+
+
+SUResult SUMeshHelperCreate(SUMeshHelperRef* mesh_ref, SUFaceRef face_ref) {
+  const Face* face = get<Face>(face_ref);
+  if (face == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  SUResult result = check_create(mesh_ref);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  MeshHelper* mesh = new MeshHelper();
+  triangulate(face, *mesh);
+  *mesh_ref = to_ref<SUMeshHelperRef>(mesh);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUMeshHelperRelease(SUMeshHelperRef* mesh_ref) {
+  return release<MeshHelper>(mesh_ref);
+}
+
+
+SUResult SUMeshHelperGetNumTriangles(SUMeshHelperRef mesh_ref, size_t* count) {
+  const MeshHelper* mesh = get<MeshHelper>(mesh_ref);
+  if (mesh == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(count, mesh->indices.size() / 3);
+}
+
+
+SUResult SUMeshHelperGetNumVertices(SUMeshHelperRef mesh_ref, size_t* count) {
+  const MeshHelper* mesh = get<MeshHelper>(mesh_ref);
+  if (mesh == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(mesh->vertices, count);
+}
+
+
+SUResult SUMeshHelperGetVertices(SUMeshHelperRef mesh_ref, size_t len, struct SUPoint3D vertices[], size_t* count) {
+  const MeshHelper* mesh = get<MeshHelper>(mesh_ref);
+  if (mesh == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill_values(mesh->vertices, len, vertices, count);
+}
+
+
+SUResult SUMeshHelperGetNormals(SUMeshHelperRef mesh_ref, size_t len, struct SUVector3D normals[], size_t* count) {
+  const MeshHelper* mesh = get<MeshHelper>(mesh_ref);
+  if (mesh == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill_values(mesh->normals, len, normals, count);
+}
+
+
+SUResult SUMeshHelperGetVertexIndices(SUMeshHelperRef mesh_ref, size_t len, size_t indices[], size_t* count) {
+  const MeshHelper* mesh = get<MeshHelper>(mesh_ref);
+  if (mesh == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill_values(mesh->indices, len, indices, count);
+}
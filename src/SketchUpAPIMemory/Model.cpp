@@ -0,0 +1,629 @@
+//
+//  Model.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <sstream>
+
+#include "MemoryAPI.hpp"
+
+namespace SUMemory {
+
+namespace {
+
+/**
+* The name, or the name followed by "#1", "#2" and so on if another object already has it, as SketchUp names copies.
+*/
+template <class T>
+std::string unique_name(const std::vector<T*>& objects, const std::string& name) {
+  auto taken = [&objects](const std::string& candidate) {
+    return std::any_of(objects.begin(), objects.end(), [&candidate](const T* object) { return object->name == candidate; });
+  };
+  if (!taken(name)) {
+    return name;
+  }
+  for (size_t i = 1; ; ++i) {
+    const std::string candidate = name + "#" + std::to_string(i);
+    if (!taken(candidate)) {
+      return candidate;
+    }
+  }
+}
+
+Object* find_pid(const Model* model, int64_t pid) {
+  for (Object* object : model->objects) {
+    if (object->pid == pid) {
+      return object;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace
+
+
+void add_definition(Model* model, ComponentDefinition* definition) {
+  definition->attached = true;
+  if (definition->component_type != SUComponentType_Group) {
+    definition->name = unique_name(model->definitions, definition->name);
+    model->definitions.push_back(definition);
+  }
+  model->adopt(definition);
+}
+
+} // namespace SUMemory
+
+using namespace SUMemory;
+
+
+SUResult SUModelCreate(SUModelRef* model) {
+  return create<Model>(model);
+}
+
+
+SUResult SUModelCreateFromFile(SUModelRef* model, const char* file_path) {
+  if (file_path == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  SUResult result = check_create(model);
+  return result == SU_ERROR_NONE ? SU_ERROR_UNSUPPORTED : result;
+}
+
+
+SUResult SUModelRelease(SUModelRef* model) {
+  return release<Model>(model);
+}
+
+
+SUResult SUModelSaveToFile(SUModelRef model, const char* file_path) {
+  if (get<Model>(model) == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (file_path == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return SU_ERROR_UNSUPPORTED;
+}
+
+
+SUResult SUModelSaveToFileWithVersion(SUModelRef model, const char* file_path, enum SUModelVersion) {
+  return SUModelSaveToFile(model, file_path);
+}
+
+
+SUResult SUModelGetVersion(SUModelRef model, int* major, int* minor, int* build) {
+  if (get<Model>(model) == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (major == nullptr || minor == nullptr || build == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  // The version of SketchUp whose API the headers describe.
+  *major = 18;
+  *minor = 0;
+  *build = 0;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUModelGetName(SUModelRef model, SUStringRef* name) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_string(name, model_object->name);
+}
+
+
+SUResult SUModelSetName(SUModelRef model, const char* name) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  model_object->name = name;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUModelGetEntities(SUModelRef model, SUEntitiesRef* entities) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(entities, to_ref<SUEntitiesRef>(&model_object->entities));
+}
+
+
+SUResult SUModelGetAxes(SUModelRef model, SUAxesRef* axes) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(axes, to_ref<SUAxesRef>(model_object->axes));
+}
+
+
+SUResult SUModelAddComponentDefinitions(SUModelRef model, size_t len, const SUComponentDefinitionRef components[]) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (components == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  for (size_t i = 0; i < len; ++i) {
+    if (get<ComponentDefinition>(components[i]) == nullptr) {
+      return SU_ERROR_INVALID_INPUT;
+    }
+  }
+  for (size_t i = 0; i < len; ++i) {
+    ComponentDefinition* definition = get<ComponentDefinition>(components[i]);
+    if (definition->model != model_object) {
+      add_definition(model_object, definition);
+    }
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUModelGetNumComponentDefinitions(SUModelRef model, size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(model_object->definitions, count);
+}
+
+
+SUResult SUModelGetComponentDefinitions(SUModelRef model, size_t len, SUComponentDefinitionRef definitions[], size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(model_object->definitions, len, definitions, count);
+}
+
+
+SUResult SUModelGetNumGroupDefinitions(SUModelRef model, size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(model_object->group_definitions, count);
+}
+
+
+SUResult SUModelGetGroupDefinitions(SUModelRef model, size_t len, SUComponentDefinitionRef definitions[], size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(model_object->group_definitions, len, definitions, count);
+}
+
+
+SUResult SUModelAddLayers(SUModelRef model, size_t len, const SULayerRef layers[]) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (layers == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  for (size_t i = 0; i < len; ++i) {
+    Layer* layer = get<Layer>(layers[i]);
+    if (layer == nullptr) {
+      return SU_ERROR_INVALID_INPUT;
+    }
+    if (layer->model != model_object) {
+      layer->attached = true;
+      model_object->adopt(layer);
+      model_object->layers.push_back(layer);
+    }
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUModelGetDefaultLayer(SUModelRef model, SULayerRef* layer) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(layer, to_ref<SULayerRef>(model_object->layers.front()));
+}
+
+
+SUResult SUModelGetNumLayers(SUModelRef model, size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(model_object->layers, count);
+}
+
+
+SUResult SUModelGetLayers(SUModelRef model, size_t len, SULayerRef layers[], size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(model_object->layers, len, layers, count);
+}
+
+
+SUResult SUModelAddMaterials(SUModelRef model, size_t len, const SUMaterialRef materials[]) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (materials == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  for (size_t i = 0; i < len; ++i) {
+    Material* material = get<Material>(materials[i]);
+    if (material == nullptr) {
+      return SU_ERROR_INVALID_INPUT;
+    }
+    if (material->model != model_object) {
+      material->name = unique_name(model_object->materials, material->name);
+      material->attached = true;
+      model_object->adopt(material);
+      model_object->materials.push_back(material);
+    }
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUModelGetNumMaterials(SUModelRef model, size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(model_object->materials, count);
+}
+
+
+SUResult SUModelGetMaterials(SUModelRef model, size_t len, SUMaterialRef materials[], size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(model_object->materials, len, materials, count);
+}
+
+
+SUResult SUModelGetNumAttributeDictionaries(SUModelRef model, size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(model_object->dictionaries, count);
+}
+
+
+SUResult SUModelGetAttributeDictionaries(SUModelRef model, size_t len, SUAttributeDictionaryRef dictionaries[], size_t* count) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return fill(model_object->dictionaries, len, dictionaries, count);
+}
+
+
+SUResult SUModelGetAttributeDictionary(SUModelRef model, const char* name, SUAttributeDictionaryRef* dictionary) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (dictionary == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  for (AttributeDictionary* existing : model_object->dictionaries) {
+    if (existing->name == name) {
+      *dictionary = to_ref<SUAttributeDictionaryRef>(existing);
+      return SU_ERROR_NONE;
+    }
+  }
+  // As in SketchUp, a dictionary that does not exist yet is created.
+  AttributeDictionary* created = new AttributeDictionary();
+  created->name = name;
+  created->attached = true;
+  created->model = model_object;
+  model_object->dictionaries.push_back(created);
+  *dictionary = to_ref<SUAttributeDictionaryRef>(created);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUModelGetStatistics(SUModelRef model, struct SUModelStatistics* statistics) {
+  const Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (statistics == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *statistics = SUModelStatistics();
+  for (const Object* object : model_object->objects) {
+    switch (object->type) {
+      case SURefType_Edge:
+        ++statistics->entity_counts[SUModelStatistics::SUEntityType_Edge];
+        break;
+      case SURefType_Face:
+        ++statistics->entity_counts[SUModelStatistics::SUEntityType_Face];
+        break;
+      case SURefType_ComponentInstance:
+        ++statistics->entity_counts[SUModelStatistics::SUEntityType_ComponentInstance];
+        break;
+      case SURefType_Group:
+        ++statistics->entity_counts[SUModelStatistics::SUEntityType_Group];
+        break;
+      default:
+        break;
+    }
+  }
+  statistics->entity_counts[SUModelStatistics::SUEntityType_ComponentDefinition] = int(model_object->definitions.size());
+  statistics->entity_counts[SUModelStatistics::SUEntityType_Layer] = int(model_object->layers.size());
+  statistics->entity_counts[SUModelStatistics::SUEntityType_Material] = int(model_object->materials.size());
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUModelGetInstancePathByPid(SUModelRef model, SUStringRef pid_ref, SUInstancePathRef* instance_path_ref) {
+  const Model* model_object = get<Model>(model);
+  const String* pid_string = get<String>(pid_ref);
+  if (model_object == nullptr || pid_string == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (instance_path_ref == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  InstancePath* path = get<InstancePath>(*instance_path_ref);
+  if (path == nullptr) {
+    return SU_ERROR_INVALID_OUTPUT;
+  }
+  // The persistent ID path is the persistent IDs of the instances and the leaf, joined by dots.
+  std::vector<Object*> objects;
+  std::istringstream stream(pid_string->utf8);
+  std::string token;
+  while (std::getline(stream, token, '.')) {
+    int64_t pid = 0;
+    std::istringstream token_stream(token);
+    if (!(token_stream >> pid) || !token_stream.eof()) {
+      return SU_ERROR_GENERIC;
+    }
+    Object* object = find_pid(model_object, pid);
+    if (object == nullptr) {
+      return SU_ERROR_GENERIC;
+    }
+    objects.push_back(object);
+  }
+  if (objects.empty()) {
+    return SU_ERROR_GENERIC;
+  }
+  Object* leaf = nullptr;
+  if (!ComponentInstance::accepts(objects.back()->type)) {
+    leaf = objects.back();
+    objects.pop_back();
+  }
+  std::vector<ComponentInstance*> instances;
+  for (Object* object : objects) {
+    if (!ComponentInstance::accepts(object->type)) {
+      return SU_ERROR_GENERIC;
+    }
+    instances.push_back(static_cast<ComponentInstance*>(object));
+  }
+  path->instances = instances;
+  path->leaf = leaf;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUModelGetOptionsManager(SUModelRef model, SUOptionsManagerRef* options_manager) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(options_manager, to_ref<SUOptionsManagerRef>(&model_object->options_manager));
+}
+
+
+SUResult SUModelGetRenderingOptions(SUModelRef model, SURenderingOptionsRef* rendering_options) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(rendering_options, to_ref<SURenderingOptionsRef>(&model_object->rendering_options));
+}
+
+
+SUResult SUModelGetShadowInfo(SUModelRef model, SUShadowInfoRef* shadow_info) {
+  Model* model_object = get<Model>(model);
+  if (model_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(shadow_info, to_ref<SUShadowInfoRef>(&model_object->shadow_info));
+}
+
+
+SUResult SUOptionsManagerGetNumOptionsProviders(SUOptionsManagerRef options_manager, size_t* count) {
+  const OptionsManager* manager = get<OptionsManager>(options_manager);
+  if (manager == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(manager->providers, count);
+}
+
+
+SUResult SUOptionsManagerGetOptionsProviderNames(SUOptionsManagerRef options_manager, size_t len, SUStringRef options_provider_names[], size_t* count) {
+  const OptionsManager* manager = get<OptionsManager>(options_manager);
+  if (manager == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  std::vector<std::string> names;
+  for (const std::unique_ptr<Options>& provider : manager->providers) {
+    names.push_back(provider->name);
+  }
+  return set_strings(names, len, options_provider_names, count);
+}
+
+
+SUResult SUOptionsManagerGetOptionsProviderByName(SUOptionsManagerRef options_manager, const char* name, SUOptionsProviderRef* options_provider) {
+  const OptionsManager* manager = get<OptionsManager>(options_manager);
+  if (manager == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (options_provider == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  for (const std::unique_ptr<Options>& provider : manager->providers) {
+    if (provider->name == name) {
+      *options_provider = to_ref<SUOptionsProviderRef>(provider.get());
+      return SU_ERROR_NONE;
+    }
+  }
+  return SU_ERROR_INVALID_INPUT;
+}
+
+
+namespace {
+
+/**
+* The rendering options, shadow info and option providers share one implementation, checked against their own type.
+*/
+template <class Ref>
+Options* get_options(Ref ref, SURefType ref_type) {
+  Options* options = get<Options>(ref);
+  return options != nullptr && options->type == ref_type ? options : nullptr;
+}
+
+template <class Ref>
+SUResult options_num_keys(Ref ref, SURefType ref_type, size_t* count) {
+  const Options* options = get_options(ref, ref_type);
+  if (options == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_count(options->values.values, count);
+}
+
+template <class Ref>
+SUResult options_keys(Ref ref, SURefType ref_type, size_t len, SUStringRef keys[], size_t* count) {
+  const Options* options = get_options(ref, ref_type);
+  if (options == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_keys(options->values, len, keys, count);
+}
+
+template <class Ref>
+SUResult options_get_value(Ref ref, SURefType ref_type, const char* key, SUTypedValueRef* value_out) {
+  const Options* options = get_options(ref, ref_type);
+  if (options == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return get_value(options->values, key, value_out);
+}
+
+template <class Ref>
+SUResult options_set_value(Ref ref, SURefType ref_type, const char* key, SUTypedValueRef value_in) {
+  Options* options = get_options(ref, ref_type);
+  if (options == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(options->values, key, value_in);
+}
+
+} // namespace
+
+
+SUResult SUOptionsProviderGetNumKeys(SUOptionsProviderRef options_provider, size_t* count) {
+  return options_num_keys(options_provider, RefType_OptionsProvider, count);
+}
+
+
+SUResult SUOptionsProviderGetKeys(SUOptionsProviderRef options_provider, size_t len, SUStringRef keys[], size_t* count) {
+  return options_keys(options_provider, RefType_OptionsProvider, len, keys, count);
+}
+
+
+SUResult SUOptionsProviderGetValue(SUOptionsProviderRef options_provider, const char* key, SUTypedValueRef* value) {
+  return options_get_value(options_provider, RefType_OptionsProvider, key, value);
+}
+
+
+SUResult SUOptionsProviderSetValue(SUOptionsProviderRef options_provider, const char* key, SUTypedValueRef value) {
+  return options_set_value(options_provider, RefType_OptionsProvider, key, value);
+}
+
+
+SUResult SURenderingOptionsGetNumKeys(SURenderingOptionsRef rendering_options, size_t* count) {
+  return options_num_keys(rendering_options, SURefType_RenderingOptions, count);
+}
+
+
+SUResult SURenderingOptionsGetKeys(SURenderingOptionsRef rendering_options, size_t len, SUStringRef keys[], size_t* count) {
+  return options_keys(rendering_options, SURefType_RenderingOptions, len, keys, count);
+}
+
+
+SUResult SURenderingOptionsGetValue(SURenderingOptionsRef rendering_options, const char* key, SUTypedValueRef* value_out) {
+  return options_get_value(rendering_options, SURefType_RenderingOptions, key, value_out);
+}
+
+
+SUResult SURenderingOptionsSetValue(SURenderingOptionsRef rendering_options, const char* key, SUTypedValueRef value_in) {
+  return options_set_value(rendering_options, SURefType_RenderingOptions, key, value_in);
+}
+
+
+SUResult SUShadowInfoGetNumKeys(SUShadowInfoRef shadow_info, size_t* count) {
+  return options_num_keys(shadow_info, SURefType_ShadowInfo, count);
+}
+
+
+SUResult SUShadowInfoGetKeys(SUShadowInfoRef shadow_info, size_t len, SUStringRef keys[], size_t* count) {
+  return options_keys(shadow_info, SURefType_ShadowInfo, len, keys, count);
+}
+
+
+SUResult SUShadowInfoGetValue(SUShadowInfoRef shadow_info, const char* key, SUTypedValueRef* value_out) {
+  return options_get_value(shadow_info, SURefType_ShadowInfo, key, value_out);
+}
+
+
+SUResult SUShadowInfoSetValue(SUShadowInfoRef shadow_info, const char* key, SUTypedValueRef value_in) {
+  return options_set_value(shadow_info, SURefType_ShadowInfo, key, value_in);
+}
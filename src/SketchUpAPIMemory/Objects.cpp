@@ -0,0 +1,510 @@
+//
+//  Objects.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <atomic>
+#include <cmath>
+
+#include "MemoryAPI.hpp"
+
+namespace SUMemory {
+
+namespace {
+
+std::atomic<int32_t> next_id(1);
+std::atomic<int64_t> next_pid(1);
+
+const double CELL_SIZE = 4.0 * TOLERANCE;
+
+int64_t cell(double value) {
+  return int64_t(std::floor(value / CELL_SIZE));
+}
+
+uint64_t cell_key(int64_t x, int64_t y, int64_t z) {
+  return uint64_t(x) * 73856093ULL ^ uint64_t(y) * 19349663ULL ^ uint64_t(z) * 83492791ULL;
+}
+
+/**
+* Edges are indexed by the IDs of their two vertices, in either order.
+*/
+uint64_t edge_key(const Vertex* start, const Vertex* end) {
+  const uint32_t a = uint32_t(start->id);
+  const uint32_t b = uint32_t(end->id);
+  return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+}
+
+uint64_t edge_key(const Edge* edge) {
+  return edge_key(edge->start, edge->end);
+}
+
+void add_default(ValueMap& values, const std::string& key, SUTypedValueType value_type, int64_t integer) {
+  TypedValue value;
+  value.value_type = value_type;
+  value.integer = integer;
+  values.set(key, value);
+}
+
+} // namespace
+
+
+Object::Object(SURefType ref_type):
+  Handle(ref_type),
+  id(next_id++),
+  pid(next_pid++)
+{}
+
+
+Object::~Object() {
+  for (Object* object : owned) {
+    delete object;
+  }
+  for (AttributeDictionary* dictionary : dictionaries) {
+    delete dictionary;
+  }
+}
+
+
+bool Object::accepts(SURefType ref_type) {
+  switch (ref_type) {
+    case SURefType_AttributeDictionary:
+    case SURefType_ComponentDefinition:
+    case SURefType_ComponentInstance:
+    case SURefType_Curve:
+    case SURefType_Edge:
+    case SURefType_Face:
+    case SURefType_Group:
+    case SURefType_Layer:
+    case SURefType_Loop:
+    case SURefType_Material:
+    case SURefType_Texture:
+    case SURefType_Vertex:
+    case SURefType_Axes:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+void Object::take(Object* object) {
+  object->holder = this;
+  owned.push_back(object);
+  for (Object* child : object->owned) {
+    child->holder = this;
+    owned.push_back(child);
+  }
+  object->owned.clear();
+}
+
+
+void give(Object* owner, Object* object) {
+  if (owner->model != nullptr) {
+    owner->model->adopt(object);
+    return;
+  }
+  Object* root = owner;
+  while (root->holder != nullptr) {
+    root = root->holder;
+  }
+  root->take(object);
+}
+
+
+void destroy(Object* object) {
+  if (object->model != nullptr) {
+    object->model->objects.erase(object);
+  }
+  else if (object->holder != nullptr) {
+    std::vector<Object*>& owned = object->holder->owned;
+    // Parts are usually destroyed just after they were added.
+    auto it = std::find(owned.rbegin(), owned.rend(), object);
+    if (it != owned.rend()) {
+      owned.erase(std::next(it).base());
+    }
+  }
+  delete object;
+}
+
+
+bool DrawingElement::accepts(SURefType ref_type) {
+  switch (ref_type) {
+    case SURefType_ComponentDefinition:
+    case SURefType_ComponentInstance:
+    case SURefType_Edge:
+    case SURefType_Face:
+    case SURefType_Group:
+    case SURefType_Axes:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+void TypedValue::assign(const TypedValue& other) {
+  if (&other == this) {
+    return;
+  }
+  value_type = other.value_type;
+  integer = other.integer;
+  real = other.real;
+  color = other.color;
+  std::copy(other.vector, other.vector + 3, vector);
+  string = other.string;
+  items.clear();
+  items.reserve(other.items.size());
+  for (const std::unique_ptr<TypedValue>& item : other.items) {
+    items.emplace_back(new TypedValue());
+    items.back()->assign(*item);
+  }
+}
+
+
+void TypedValue::clear() {
+  value_type = SUTypedValueType_Empty;
+  string.clear();
+  items.clear();
+}
+
+
+const TypedValue* ValueMap::find(const std::string& key) const {
+  auto it = index.find(key);
+  return it == index.end() ? nullptr : values[it->second].second.get();
+}
+
+
+void ValueMap::set(const std::string& key, const TypedValue& value) {
+  auto it = index.find(key);
+  if (it != index.end()) {
+    values[it->second].second->assign(value);
+    return;
+  }
+  index.emplace(key, values.size());
+  values.emplace_back(key, std::unique_ptr<TypedValue>(new TypedValue()));
+  values.back().second->assign(value);
+}
+
+
+Vertex* VertexIndex::find(const SUPoint3D& point) const {
+  // A point within tolerance of a cell boundary may match a vertex in the neighbouring cell.
+  const double coordinates[3] = {point.x, point.y, point.z};
+  int64_t low[3];
+  int64_t high[3];
+  for (size_t axis = 0; axis < 3; ++axis) {
+    const int64_t c = cell(coordinates[axis]);
+    low[axis] = coordinates[axis] - double(c) * CELL_SIZE < TOLERANCE ? c - 1 : c;
+    high[axis] = double(c + 1) * CELL_SIZE - coordinates[axis] < TOLERANCE ? c + 1 : c;
+  }
+  for (int64_t x = low[0]; x <= high[0]; ++x) {
+    for (int64_t y = low[1]; y <= high[1]; ++y) {
+      for (int64_t z = low[2]; z <= high[2]; ++z) {
+        auto it = cells.find(cell_key(x, y, z));
+        if (it == cells.end()) {
+          continue;
+        }
+        for (Vertex* vertex : it->second) {
+          if (same_position(vertex->position, point)) {
+            return vertex;
+          }
+        }
+      }
+    }
+  }
+  return nullptr;
+}
+
+
+void VertexIndex::insert(Vertex* vertex) {
+  const SUPoint3D& point = vertex->position;
+  cells[cell_key(cell(point.x), cell(point.y), cell(point.z))].push_back(vertex);
+}
+
+
+void VertexIndex::erase(Vertex* vertex) {
+  const SUPoint3D& point = vertex->position;
+  auto it = cells.find(cell_key(cell(point.x), cell(point.y), cell(point.z)));
+  if (it == cells.end()) {
+    return;
+  }
+  std::vector<Vertex*>& cell_vertices = it->second;
+  cell_vertices.erase(std::remove(cell_vertices.begin(), cell_vertices.end(), vertex), cell_vertices.end());
+  if (cell_vertices.empty()) {
+    cells.erase(it);
+  }
+}
+
+
+void Entities::take(Object* object) {
+  object->attached = true;
+  if (model != nullptr) {
+    model->adopt(object);
+  }
+  else {
+    give(definition, object);
+  }
+}
+
+
+void Entities::add_face(Face* face) {
+  face->parent = this;
+  faces.push_back(face);
+  weld_loop(face->outer);
+  for (Loop* loop : face->inner) {
+    weld_loop(loop);
+  }
+}
+
+
+void Entities::weld_loop(Loop* loop) {
+  for (size_t i = 0; i < loop->vertices.size(); ++i) {
+    Vertex* vertex = loop->vertices[i];
+    Vertex* existing = vertices.find(vertex->position);
+    if (existing == nullptr) {
+      vertices.insert(vertex);
+      continue;
+    }
+    if (existing == vertex) {
+      continue;
+    }
+    for (Edge* edge : loop->edges) {
+      if (edge->start == vertex) {
+        edge->start = existing;
+      }
+      if (edge->end == vertex) {
+        edge->end = existing;
+      }
+    }
+    loop->vertices[i] = existing;
+    destroy(vertex);
+  }
+  for (size_t i = 0; i < loop->edges.size(); ++i) {
+    Edge* edge = loop->edges[i];
+    auto inserted = edge_index.emplace(edge_key(edge), edge);
+    if (inserted.second) {
+      edge->parent = this;
+      edges.push_back(edge);
+      continue;
+    }
+    Edge* existing = inserted.first->second;
+    if (existing == edge) {
+      continue;
+    }
+    existing->faces.push_back(loop->face);
+    loop->edges[i] = existing;
+    destroy(edge);
+  }
+}
+
+
+void Entities::add_edge(Edge* edge) {
+  Vertex** ends[2] = {&edge->start, &edge->end};
+  for (Vertex** end : ends) {
+    Vertex* existing = vertices.find((*end)->position);
+    if (existing == nullptr) {
+      vertices.insert(*end);
+    }
+    else if (existing != *end) {
+      Vertex* vertex = *end;
+      *end = existing;
+      destroy(vertex);
+    }
+  }
+  edge->parent = this;
+  edge_index.emplace(edge_key(edge), edge);
+  edges.push_back(edge);
+}
+
+
+Edge* Entities::find_edge(const Vertex* a, const Vertex* b) const {
+  auto it = edge_index.find(edge_key(a, b));
+  return it == edge_index.end() ? nullptr : it->second;
+}
+
+
+void Entities::move_vertex(Vertex* vertex, const SUPoint3D& point) {
+  vertices.erase(vertex);
+  vertex->position = point;
+  vertices.insert(vertex);
+}
+
+
+Material::~Material() {
+  delete texture;
+}
+
+
+ComponentDefinition::ComponentDefinition(SUComponentType definition_type):
+  DrawingElement(SURefType_ComponentDefinition),
+  component_type(definition_type),
+  behavior(),
+  entities(nullptr, this)
+{}
+
+
+ComponentInstance::ComponentInstance(SURefType ref_type):
+  DrawingElement(ref_type),
+  transform(identity())
+{}
+
+
+Model::Model():
+  Handle(SURefType_Model),
+  entities(this, nullptr),
+  axes(new Axes()),
+  rendering_options(SURefType_RenderingOptions, "RenderingOptions"),
+  shadow_info(SURefType_ShadowInfo, "ShadowInfo")
+{
+  Layer* layer = new Layer();
+  layer->name = "Layer0";
+  layer->attached = true;
+  adopt(layer);
+  layers.push_back(layer);
+  axes->attached = true;
+  adopt(axes);
+
+  const char* provider_names[] = {"UnitsOptions", "PageOptions", "SlideshowOptions", "NamedOptions", "PrintOptions"};
+  for (const char* provider_name : provider_names) {
+    options_manager.providers.emplace_back(new Options(RefType_OptionsProvider, provider_name));
+  }
+  ValueMap& units = options_manager.providers[0]->values;
+  add_default(units, "LengthFormat", SUTypedValueType_Int32, 0);
+  add_default(units, "LengthUnit", SUTypedValueType_Int32, 0);
+  add_default(units, "LengthPrecision", SUTypedValueType_Int32, 1);
+  add_default(units, "AngleUnit", SUTypedValueType_Int32, 0);
+  add_default(units, "AnglePrecision", SUTypedValueType_Int32, 1);
+  add_default(rendering_options.values, "DisplayColorByLayer", SUTypedValueType_Bool, 0);
+  add_default(rendering_options.values, "DrawHidden", SUTypedValueType_Bool, 0);
+  add_default(rendering_options.values, "EdgeColorMode", SUTypedValueType_Int32, 1);
+  add_default(rendering_options.values, "FaceColorMode", SUTypedValueType_Int32, 0);
+  add_default(shadow_info.values, "DisplayShadows", SUTypedValueType_Bool, 0);
+  add_default(shadow_info.values, "Light", SUTypedValueType_Int32, 80);
+  add_default(shadow_info.values, "Dark", SUTypedValueType_Int32, 45);
+  add_default(shadow_info.values, "UseSunForAllShading", SUTypedValueType_Bool, 0);
+}
+
+
+Model::~Model() {
+  // Everything the model owns is in the set, so no object deletes another.
+  for (Object* object : objects) {
+    delete object;
+  }
+  for (AttributeDictionary* dictionary : dictionaries) {
+    delete dictionary;
+  }
+}
+
+
+void Model::adopt(Object* object) {
+  object->model = this;
+  object->holder = nullptr;
+  objects.insert(object);
+  if (object->type == SURefType_ComponentDefinition) {
+    ComponentDefinition* definition = static_cast<ComponentDefinition*>(object);
+    definition->entities.model = this;
+    if (definition->component_type == SUComponentType_Group) {
+      group_definitions.push_back(definition);
+    }
+  }
+  std::vector<Object*> owned;
+  owned.swap(object->owned);
+  for (Object* child : owned) {
+    adopt(child);
+  }
+}
+
+
+SUResult set_string(SUStringRef* out, const std::string& value) {
+  if (out == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  String* string = get<String>(*out);
+  if (string == nullptr) {
+    return SU_ERROR_INVALID_OUTPUT;
+  }
+  string->utf8 = value;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult set_strings(const std::vector<std::string>& values, size_t len, SUStringRef out[], size_t* count) {
+  if (out == nullptr || count == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  const size_t num_values = std::min(len, values.size());
+  for (size_t i = 0; i < num_values; ++i) {
+    SUResult result = set_string(&out[i], values[i]);
+    if (result != SU_ERROR_NONE) {
+      return result;
+    }
+  }
+  *count = num_values;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult get_keys(const ValueMap& values, size_t len, SUStringRef keys[], size_t* count) {
+  std::vector<std::string> names;
+  names.reserve(values.values.size());
+  for (const auto& value : values.values) {
+    names.push_back(value.first);
+  }
+  return set_strings(names, len, keys, count);
+}
+
+
+SUResult get_value(const ValueMap& values, const char* key, SUTypedValueRef* value_out) {
+  if (key == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (value_out == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  TypedValue* out = get<TypedValue>(*value_out);
+  if (out == nullptr) {
+    return SU_ERROR_INVALID_OUTPUT;
+  }
+  const TypedValue* value = values.find(key);
+  if (value == nullptr) {
+    return SU_ERROR_NO_DATA;
+  }
+  out->assign(*value);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult set_value(ValueMap& values, const char* key, SUTypedValueRef value_in) {
+  if (key == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  const TypedValue* value = get<TypedValue>(value_in);
+  if (value == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  values.set(key, *value);
+  return SU_ERROR_NONE;
+}
+
+} // namespace SUMemory
@@ -0,0 +1,109 @@
+//
+//  String.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cstring>
+
+#include "MemoryAPI.hpp"
+
+using namespace SUMemory;
+
+SUResult SUStringCreate(SUStringRef* out_string_ref) {
+  return create<String>(out_string_ref);
+}
+
+
+SUResult SUStringCreateFromUTF8(SUStringRef* out_string_ref, const char* char_array) {
+  if (char_array == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  SUResult result = create<String>(out_string_ref);
+  if (result == SU_ERROR_NONE) {
+    get<String>(*out_string_ref)->utf8 = char_array;
+  }
+  return result;
+}
+
+
+SUResult SUStringRelease(SUStringRef* string_ref) {
+  return release<String>(string_ref);
+}
+
+
+SUResult SUStringGetUTF8Length(SUStringRef string_ref, size_t* out_length) {
+  const String* string = get<String>(string_ref);
+  if (string == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(out_length, string->utf8.size());
+}
+
+
+SUResult SUStringGetUTF8(SUStringRef string_ref, size_t char_array_length, char* out_char_array, size_t* out_number_of_chars_copied) {
+  const String* string = get<String>(string_ref);
+  if (string == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (out_char_array == nullptr || out_number_of_chars_copied == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  // The array length includes the terminating null character.
+  const size_t num_chars = char_array_length == 0 ? 0 : std::min(char_array_length - 1, string->utf8.size());
+  std::memcpy(out_char_array, string->utf8.data(), num_chars);
+  if (char_array_length > 0) {
+    out_char_array[num_chars] = '\0';
+  }
+  *out_number_of_chars_copied = num_chars;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUStringSetUTF8(SUStringRef string_ref, const char* char_array) {
+  String* string = get<String>(string_ref);
+  if (string == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (char_array == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  string->utf8 = char_array;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUStringCompare(SUStringRef a, SUStringRef b, int* result) {
+  const String* string_a = get<String>(a);
+  const String* string_b = get<String>(b);
+  if (string_a == nullptr || string_b == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (result == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  const int comparison = string_a->utf8.compare(string_b->utf8);
+  *result = comparison < 0 ? -1 : (comparison > 0 ? 1 : 0);
+  return SU_ERROR_NONE;
+}
@@ -0,0 +1,493 @@
+//
+//  Texture.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "MemoryAPI.hpp"
+
+using namespace SUMemory;
+
+namespace {
+
+size_t row_size(const ImageData& image) {
+  return image.width * image.bits_per_pixel / 8 + image.row_padding;
+}
+
+SUResult get_image(SUImageRepRef image, ImageRep** image_object) {
+  *image_object = get<ImageRep>(image);
+  return *image_object == nullptr ? SU_ERROR_INVALID_INPUT : SU_ERROR_NONE;
+}
+
+/**
+* Image files are only read and written as uncompressed bitmaps, which is all the tests need.
+*/
+bool is_bitmap_path(const char* file_path) {
+  const size_t length = std::strlen(file_path);
+  return length > 4 && std::strcmp(file_path + length - 4, ".bmp") == 0;
+}
+
+void put_le(std::vector<SUByte>& out, uint32_t value, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out.push_back(static_cast<SUByte>(value >> (8 * i)));
+  }
+}
+
+uint32_t get_le(const std::vector<SUByte>& in, size_t offset, size_t size) {
+  uint32_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    value |= static_cast<uint32_t>(in[offset + i]) << (8 * i);
+  }
+  return value;
+}
+
+SUResult write_bitmap(const ImageData& image, const char* file_path) {
+  if (image.data.empty()) {
+    return SU_ERROR_NO_DATA;
+  }
+  if (!is_bitmap_path(file_path)) {
+    return SU_ERROR_UNSUPPORTED;
+  }
+  // Grey pixels are widened to BGR, as bitmaps without a palette have no grey format.
+  const size_t pixel_size = image.bits_per_pixel / 8;
+  const size_t file_pixel_size = pixel_size == 1 ? 3 : pixel_size;
+  const size_t file_row_size = (image.width * file_pixel_size + 3) & ~size_t(3);
+  const size_t data_offset = 54;
+  std::vector<SUByte> out;
+  out.reserve(data_offset + file_row_size * image.height);
+  out.push_back('B');
+  out.push_back('M');
+  put_le(out, static_cast<uint32_t>(data_offset + file_row_size * image.height), 4);
+  put_le(out, 0, 4);
+  put_le(out, data_offset, 4);
+  put_le(out, 40, 4);
+  put_le(out, static_cast<uint32_t>(image.width), 4);
+  put_le(out, static_cast<uint32_t>(image.height), 4);
+  put_le(out, 1, 2);
+  put_le(out, static_cast<uint32_t>(file_pixel_size * 8), 2);
+  put_le(out, 0, 4);
+  put_le(out, static_cast<uint32_t>(file_row_size * image.height), 4);
+  put_le(out, 2835, 4);
+  put_le(out, 2835, 4);
+  put_le(out, 0, 4);
+  put_le(out, 0, 4);
+  for (size_t y = 0; y < image.height; ++y) {
+    const SUByte* row = &image.data[y * row_size(image)];
+    const size_t row_start = out.size();
+    for (size_t x = 0; x < image.width; ++x) {
+      const SUByte* pixel = row + x * pixel_size;
+      if (pixel_size == 1) {
+        out.insert(out.end(), {pixel[0], pixel[0], pixel[0]});
+      }
+      else {
+        out.insert(out.end(), pixel, pixel + pixel_size);
+      }
+    }
+    out.resize(row_start + file_row_size, 0);
+  }
+  std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+  if (!file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+    return SU_ERROR_SERIALIZATION;
+  }
+  return SU_ERROR_NONE;
+}
+
+SUResult read_bitmap(const char* file_path, ImageData& image) {
+  if (!is_bitmap_path(file_path)) {
+    return SU_ERROR_UNSUPPORTED;
+  }
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file) {
+    return SU_ERROR_SERIALIZATION;
+  }
+  std::vector<SUByte> in((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  if (in.size() < 54 || in[0] != 'B' || in[1] != 'M') {
+    return SU_ERROR_SERIALIZATION;
+  }
+  const size_t data_offset = get_le(in, 10, 4);
+  const size_t width = get_le(in, 18, 4);
+  const size_t height = get_le(in, 22, 4);
+  const size_t bits_per_pixel = get_le(in, 28, 2);
+  if (width == 0 || height == 0 || (bits_per_pixel != 24 && bits_per_pixel != 32) || get_le(in, 30, 4) != 0) {
+    return SU_ERROR_SERIALIZATION;
+  }
+  const size_t file_row_size = (width * bits_per_pixel / 8 + 3) & ~size_t(3);
+  if (in.size() < data_offset + file_row_size * height) {
+    return SU_ERROR_SERIALIZATION;
+  }
+  ImageData loaded;
+  loaded.width = width;
+  loaded.height = height;
+  loaded.bits_per_pixel = bits_per_pixel;
+  loaded.data.reserve(width * height * bits_per_pixel / 8);
+  for (size_t y = 0; y < height; ++y) {
+    const SUByte* row = &in[data_offset + y * file_row_size];
+    loaded.data.insert(loaded.data.end(), row, row + width * bits_per_pixel / 8);
+  }
+  image = std::move(loaded);
+  return SU_ERROR_NONE;
+}
+
+} // namespace
+
+
+SUResult SUTextureCreateFromFile(SUTextureRef* texture, const char* file_path, double s_scale, double t_scale) {
+  if (file_path == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  SUResult result = check_create(texture);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  ImageData image;
+  result = read_bitmap(file_path, image);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  Texture* created = new Texture();
+  created->image = std::move(image);
+  created->file_name = file_path;
+  created->s_scale = s_scale;
+  created->t_scale = t_scale;
+  *texture = to_ref<SUTextureRef>(created);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTextureCreateFromImageRep(SUTextureRef* texture, SUImageRepRef image) {
+  const ImageRep* image_object = get<ImageRep>(image);
+  if (image_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  SUResult result = check_create(texture);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (image_object->image.data.empty()) {
+    return SU_ERROR_NO_DATA;
+  }
+  Texture* created = new Texture();
+  created->image = image_object->image;
+  *texture = to_ref<SUTextureRef>(created);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTextureRelease(SUTextureRef* texture) {
+  return release_entity<Texture>(texture);
+}
+
+
+SUEntityRef SUTextureToEntity(SUTextureRef texture) {
+  return convert<Texture, SUEntityRef>(texture);
+}
+
+
+SUTextureRef SUTextureFromEntity(SUEntityRef entity) {
+  return convert<Texture, SUTextureRef>(entity);
+}
+
+
+SUResult SUTextureGetDimensions(SUTextureRef texture, size_t* width, size_t* height, double* s_scale, double* t_scale) {
+  const Texture* texture_object = get<Texture>(texture);
+  if (texture_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (width == nullptr || height == nullptr || s_scale == nullptr || t_scale == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *width = texture_object->image.width;
+  *height = texture_object->image.height;
+  *s_scale = texture_object->s_scale;
+  *t_scale = texture_object->t_scale;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTextureGetImageRep(SUTextureRef texture, SUImageRepRef* image) {
+  const Texture* texture_object = get<Texture>(texture);
+  if (texture_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (image == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  ImageRep* image_object = get<ImageRep>(*image);
+  if (image_object == nullptr) {
+    return SU_ERROR_INVALID_OUTPUT;
+  }
+  if (texture_object->image.data.empty()) {
+    return SU_ERROR_NO_DATA;
+  }
+  image_object->image = texture_object->image;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTextureGetUseAlphaChannel(SUTextureRef texture, bool* alpha_channel_used) {
+  const Texture* texture_object = get<Texture>(texture);
+  if (texture_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(alpha_channel_used, texture_object->image.bits_per_pixel == 32);
+}
+
+
+SUResult SUTextureGetFileName(SUTextureRef texture, SUStringRef* file_name) {
+  const Texture* texture_object = get<Texture>(texture);
+  if (texture_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_string(file_name, texture_object->file_name);
+}
+
+
+SUResult SUTextureSetFileName(SUTextureRef texture, const char* name) {
+  Texture* texture_object = get<Texture>(texture);
+  if (texture_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (name == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  texture_object->file_name = name;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTextureWriteToFile(SUTextureRef texture, const char* file_path) {
+  const Texture* texture_object = get<Texture>(texture);
+  if (texture_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (file_path == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return write_bitmap(texture_object->image, file_path);
+}
+
+
+SUResult SUImageRepCreate(SUImageRepRef* image) {
+  return create<ImageRep>(image);
+}
+
+
+SUResult SUImageRepRelease(SUImageRepRef* image) {
+  return release<ImageRep>(image);
+}
+
+
+SUResult SUImageRepCopy(SUImageRepRef image, SUImageRepRef copy_image) {
+  ImageRep* image_object = get<ImageRep>(image);
+  const ImageRep* copy_object = get<ImageRep>(copy_image);
+  if (image_object == nullptr || copy_object == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  image_object->image = copy_object->image;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUImageRepSetData(SUImageRepRef image, size_t width, size_t height, size_t bits_per_pixel, size_t row_padding, const SUByte pixel_data[]) {
+  ImageRep* image_object = nullptr;
+  SUResult result = get_image(image, &image_object);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (pixel_data == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (width == 0 || height == 0 || (bits_per_pixel != 8 && bits_per_pixel != 24 && bits_per_pixel != 32)) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  ImageData& data = image_object->image;
+  data.width = width;
+  data.height = height;
+  data.bits_per_pixel = bits_per_pixel;
+  data.row_padding = row_padding;
+  data.data.assign(pixel_data, pixel_data + height * row_size(data));
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUImageRepLoadFile(SUImageRepRef image, const char* file_path) {
+  ImageRep* image_object = nullptr;
+  SUResult result = get_image(image, &image_object);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (file_path == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return read_bitmap(file_path, image_object->image);
+}
+
+
+SUResult SUImageRepSaveToFile(SUImageRepRef image, const char* file_path) {
+  ImageRep* image_object = nullptr;
+  SUResult result = get_image(image, &image_object);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (file_path == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return write_bitmap(image_object->image, file_path);
+}
+
+
+SUResult SUImageRepGetPixelDimensions(SUImageRepRef image, size_t* width, size_t* height) {
+  ImageRep* image_object = nullptr;
+  SUResult result = get_image(image, &image_object);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (width == nullptr || height == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *width = image_object->image.width;
+  *height = image_object->image.height;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUImageRepGetRowPadding(SUImageRepRef image, size_t* row_padding) {
+  ImageRep* image_object = nullptr;
+  SUResult result = get_image(image, &image_object);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  return set_value(row_padding, image_object->image.row_padding);
+}
+
+
+SUResult SUImageRepGetDataSize(SUImageRepRef image, size_t* data_size, size_t* bits_per_pixel) {
+  ImageRep* image_object = nullptr;
+  SUResult result = get_image(image, &image_object);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (data_size == nullptr || bits_per_pixel == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *data_size = image_object->image.data.size();
+  *bits_per_pixel = image_object->image.bits_per_pixel;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUImageRepGetData(SUImageRepRef image, size_t data_size, SUByte pixel_data[]) {
+  ImageRep* image_object = nullptr;
+  SUResult result = get_image(image, &image_object);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (pixel_data == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  const std::vector<SUByte>& data = image_object->image.data;
+  if (data_size < data.size()) {
+    return SU_ERROR_INSUFFICIENT_SIZE;
+  }
+  if (!data.empty()) {
+    std::memcpy(pixel_data, data.data(), data.size());
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUImageRepResize(SUImageRepRef image, size_t width, size_t height) {
+  ImageRep* image_object = nullptr;
+  SUResult result = get_image(image, &image_object);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (width == 0 || height == 0) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  const ImageData& source = image_object->image;
+  if (source.data.empty()) {
+    return SU_ERROR_NO_DATA;
+  }
+  // Nearest neighbour sampling, which keeps the pixel format.
+  ImageData resized;
+  resized.width = width;
+  resized.height = height;
+  resized.bits_per_pixel = source.bits_per_pixel;
+  resized.row_padding = source.row_padding;
+  resized.data.assign(height * row_size(resized), 0);
+  const size_t pixel_size = source.bits_per_pixel / 8;
+  for (size_t y = 0; y < height; ++y) {
+    const size_t source_y = y * source.height / height;
+    for (size_t x = 0; x < width; ++x) {
+      const size_t source_x = x * source.width / width;
+      std::memcpy(&resized.data[y * row_size(resized) + x * pixel_size],
+                  &source.data[source_y * row_size(source) + source_x * pixel_size], pixel_size);
+    }
+  }
+  image_object->image = std::move(resized);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUImageRepConvertTo32BitsPerPixel(SUImageRepRef image) {
+  ImageRep* image_object = nullptr;
+  SUResult result = get_image(image, &image_object);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  const ImageData& source = image_object->image;
+  if (source.data.empty()) {
+    return SU_ERROR_NO_DATA;
+  }
+  // Grey and BGR pixels become opaque BGRA pixels, without row padding.
+  ImageData converted;
+  converted.width = source.width;
+  converted.height = source.height;
+  converted.bits_per_pixel = 32;
+  converted.data.reserve(source.width * source.height * 4);
+  const size_t pixel_size = source.bits_per_pixel / 8;
+  for (size_t y = 0; y < source.height; ++y) {
+    const SUByte* row = &source.data[y * row_size(source)];
+    for (size_t x = 0; x < source.width; ++x) {
+      const SUByte* pixel = row + x * pixel_size;
+      if (pixel_size == 1) {
+        converted.data.insert(converted.data.end(), {pixel[0], pixel[0], pixel[0], 255});
+      }
+      else if (pixel_size == 3) {
+        converted.data.insert(converted.data.end(), {pixel[0], pixel[1], pixel[2], 255});
+      }
+      else {
+        converted.data.insert(converted.data.end(), pixel, pixel + 4);
+      }
+    }
+  }
+  image_object->image = std::move(converted);
+  return SU_ERROR_NONE;
+}
@@ -0,0 +1,319 @@
+//
+//  Transformation.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cmath>
+
+#include "MemoryAPI.hpp"
+
+using namespace SUMemory;
+
+namespace {
+
+SUTransformation from_axes(const SUPoint3D& origin, const SUVector3D& x_axis, const SUVector3D& y_axis, const SUVector3D& z_axis) {
+  SUTransformation transform = {{
+    x_axis.x, x_axis.y, x_axis.z, 0.0,
+    y_axis.x, y_axis.y, y_axis.z, 0.0,
+    z_axis.x, z_axis.y, z_axis.z, 0.0,
+    origin.x, origin.y, origin.z, 1.0
+  }};
+  return transform;
+}
+
+/**
+* Inverse of a 4x4 matrix by cofactor expansion. Returns false if the matrix is singular.
+*/
+bool invert(const double m[16], double inverse[16]) {
+  inverse[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+  inverse[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+  inverse[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+  inverse[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+  inverse[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+  inverse[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+  inverse[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+  inverse[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+  inverse[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+  inverse[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+  inverse[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+  inverse[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+  inverse[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+  inverse[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+  inverse[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+  inverse[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+  const double determinant = m[0] * inverse[0] + m[1] * inverse[4] + m[2] * inverse[8] + m[3] * inverse[12];
+  if (std::fabs(determinant) < 1.0e-12) {
+    return false;
+  }
+  for (size_t i = 0; i < 16; ++i) {
+    inverse[i] /= determinant;
+  }
+  return true;
+}
+
+} // namespace
+
+
+SUResult SUTransformationGetInverse(const struct SUTransformation* transform, struct SUTransformation* inverse) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (inverse == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  SUTransformation result;
+  if (!invert(transform->values, result.values)) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  *inverse = result;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTransformationGetOrigin(const struct SUTransformation* transform, struct SUPoint3D* origin) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return set_value(origin, transform_point(*transform, SUPoint3D{0.0, 0.0, 0.0}));
+}
+
+
+SUResult SUTransformationGetXAxis(const struct SUTransformation* transform, struct SUVector3D* x_axis) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return set_value(x_axis, SUVector3D{transform->values[0], transform->values[1], transform->values[2]});
+}
+
+
+SUResult SUTransformationGetYAxis(const struct SUTransformation* transform, struct SUVector3D* y_axis) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return set_value(y_axis, SUVector3D{transform->values[4], transform->values[5], transform->values[6]});
+}
+
+
+SUResult SUTransformationGetZAxis(const struct SUTransformation* transform, struct SUVector3D* z_axis) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return set_value(z_axis, SUVector3D{transform->values[8], transform->values[9], transform->values[10]});
+}
+
+
+SUResult SUTransformationGetZRotation(const struct SUTransformation* transform, double* z_rotation) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return set_value(z_rotation, std::atan2(transform->values[1], transform->values[0]));
+}
+
+
+SUResult SUTransformationInterpolate(struct SUTransformation* transform, const struct SUTransformation* t1, const struct SUTransformation* t2, double weight) {
+  if (t1 == nullptr || t2 == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (weight < 0.0 || weight > 1.0) {
+    return SU_ERROR_OUT_OF_RANGE;
+  }
+  // Blends the matrices element by element, which is exact for translations and scaling.
+  for (size_t i = 0; i < 16; ++i) {
+    transform->values[i] = t1->values[i] * (1.0 - weight) + t2->values[i] * weight;
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTransformationIsIdentity(const struct SUTransformation* transform, bool* is_identity) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  const SUTransformation unit = identity();
+  bool result = true;
+  for (size_t i = 0; i < 16; ++i) {
+    result = result && std::fabs(transform->values[i] - unit.values[i]) < 1.0e-10;
+  }
+  return set_value(is_identity, result);
+}
+
+
+SUResult SUTransformationMultiply(const struct SUTransformation* transform1, const struct SUTransformation* transform2, struct SUTransformation* out_transform) {
+  if (transform1 == nullptr || transform2 == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return set_value(out_transform, multiply(*transform1, *transform2));
+}
+
+
+SUResult SUTransformationNonUniformScale(struct SUTransformation* transform, double x_scale, double y_scale, double z_scale) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *transform = identity();
+  transform->values[0] = x_scale;
+  transform->values[5] = y_scale;
+  transform->values[10] = z_scale;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTransformationRotation(struct SUTransformation* transform, const struct SUPoint3D* point, const struct SUVector3D* vector, double angle) {
+  if (point == nullptr || vector == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if (length(*vector) == 0.0) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  // Rodrigues' rotation about an axis through the point.
+  const SUVector3D axis = normalize(*vector);
+  const double c = std::cos(angle);
+  const double s = std::sin(angle);
+  const double t = 1.0 - c;
+  const SUVector3D x_axis{t * axis.x * axis.x + c, t * axis.x * axis.y + s * axis.z, t * axis.x * axis.z - s * axis.y};
+  const SUVector3D y_axis{t * axis.x * axis.y - s * axis.z, t * axis.y * axis.y + c, t * axis.y * axis.z + s * axis.x};
+  const SUVector3D z_axis{t * axis.x * axis.z + s * axis.y, t * axis.y * axis.z - s * axis.x, t * axis.z * axis.z + c};
+  *transform = from_axes(SUPoint3D{0.0, 0.0, 0.0}, x_axis, y_axis, z_axis);
+  const SUPoint3D rotated = transform_point(*transform, *point);
+  transform->values[12] = point->x - rotated.x;
+  transform->values[13] = point->y - rotated.y;
+  transform->values[14] = point->z - rotated.z;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTransformationScale(struct SUTransformation* transform, double scale) {
+  return SUTransformationNonUniformScale(transform, scale, scale, scale);
+}
+
+
+SUResult SUTransformationScaleAboutPoint(struct SUTransformation* transform, const struct SUPoint3D* point, double scale) {
+  if (point == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  SUResult result = SUTransformationScale(transform, scale);
+  if (result == SU_ERROR_NONE) {
+    transform->values[12] = point->x * (1.0 - scale);
+    transform->values[13] = point->y * (1.0 - scale);
+    transform->values[14] = point->z * (1.0 - scale);
+  }
+  return result;
+}
+
+
+SUResult SUTransformationSetFromPointAndAxes(struct SUTransformation* transform, const struct SUPoint3D* point, const struct SUVector3D* x_axis, const struct SUVector3D* y_axis, const struct SUVector3D* z_axis) {
+  if (point == nullptr || x_axis == nullptr || y_axis == nullptr || z_axis == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  return set_value(transform, from_axes(*point, *x_axis, *y_axis, *z_axis));
+}
+
+
+SUResult SUTransformationSetFromPointAndNormal(struct SUTransformation* transform, const struct SUPoint3D* point, const struct SUVector3D* normal) {
+  if (point == nullptr || normal == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (length(*normal) == 0.0) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  // SketchUp's arbitrary axis algorithm.
+  const SUVector3D z_axis = normalize(*normal);
+  const double limit = 1.0 / 64.0;
+  const SUVector3D x_axis = std::fabs(z_axis.x) < limit && std::fabs(z_axis.y) < limit ?
+      normalize(cross(SUVector3D{0.0, 1.0, 0.0}, z_axis)) :
+      normalize(cross(SUVector3D{0.0, 0.0, 1.0}, z_axis));
+  const SUVector3D y_axis = normalize(cross(z_axis, x_axis));
+  return set_value(transform, from_axes(*point, x_axis, y_axis, z_axis));
+}
+
+
+SUResult SUTransformationTranslation(struct SUTransformation* transform, const struct SUVector3D* vector) {
+  if (vector == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *transform = identity();
+  transform->values[12] = vector->x;
+  transform->values[13] = vector->y;
+  transform->values[14] = vector->z;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUPoint3DTransform(const struct SUTransformation* transform, struct SUPoint3D* point) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (point == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *point = transform_point(*transform, *point);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUVector3DTransform(const struct SUTransformation* transform, struct SUVector3D* vector) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (vector == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  *vector = transform_vector(*transform, *vector);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUPlane3DTransform(const struct SUTransformation* transform, struct SUPlane3D* plane) {
+  if (transform == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  if (plane == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  // A point on the plane is transformed as a point, and the normal by the inverse transpose.
+  const SUVector3D normal{plane->a, plane->b, plane->c};
+  const SUPoint3D point{-plane->d * plane->a, -plane->d * plane->b, -plane->d * plane->c};
+  double inverse[16];
+  if (!invert(transform->values, inverse)) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  const SUVector3D new_normal = normalize(SUVector3D{
+    inverse[0] * normal.x + inverse[1] * normal.y + inverse[2] * normal.z,
+    inverse[4] * normal.x + inverse[5] * normal.y + inverse[6] * normal.z,
+    inverse[8] * normal.x + inverse[9] * normal.y + inverse[10] * normal.z
+  });
+  const SUPoint3D new_point = transform_point(*transform, point);
+  *plane = SUPlane3D{new_normal.x, new_normal.y, new_normal.z, -(new_normal.x * new_point.x + new_normal.y * new_point.y + new_normal.z * new_point.z)};
+  return SU_ERROR_NONE;
+}
@@ -0,0 +1,315 @@
+//
+//  TypedValue.cpp
+//
+// Sketchup C++ Wrapper for C API
+// MIT License
+//
+// Copyright (c) 2017 Tom Kaneko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MemoryAPI.hpp"
+
+using namespace SUMemory;
+
+namespace {
+
+/**
+* Looks up the value for one of the SUTypedValueGet* functions, which fail when the value has another type.
+*/
+SUResult get_typed(SUTypedValueRef typed_value, SUTypedValueType value_type, const void* out, const TypedValue** value) {
+  *value = get<TypedValue>(typed_value);
+  if (*value == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  if (out == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  if ((*value)->value_type != value_type) {
+    return SU_ERROR_NO_DATA;
+  }
+  return SU_ERROR_NONE;
+}
+
+/**
+* Clears a value for one of the SUTypedValueSet* functions, or returns null if the reference is invalid.
+*/
+TypedValue* set_typed(SUTypedValueRef typed_value, SUTypedValueType value_type) {
+  TypedValue* value = get<TypedValue>(typed_value);
+  if (value != nullptr) {
+    value->clear();
+    value->value_type = value_type;
+  }
+  return value;
+}
+
+template <class T>
+SUResult get_integer(SUTypedValueRef typed_value, SUTypedValueType value_type, T* out) {
+  const TypedValue* value = nullptr;
+  SUResult result = get_typed(typed_value, value_type, out, &value);
+  if (result == SU_ERROR_NONE) {
+    *out = T(value->integer);
+  }
+  return result;
+}
+
+SUResult set_integer(SUTypedValueRef typed_value, SUTypedValueType value_type, int64_t integer) {
+  TypedValue* value = set_typed(typed_value, value_type);
+  if (value == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  value->integer = integer;
+  return SU_ERROR_NONE;
+}
+
+template <class T>
+SUResult get_real(SUTypedValueRef typed_value, SUTypedValueType value_type, T* out) {
+  const TypedValue* value = nullptr;
+  SUResult result = get_typed(typed_value, value_type, out, &value);
+  if (result == SU_ERROR_NONE) {
+    *out = T(value->real);
+  }
+  return result;
+}
+
+SUResult set_real(SUTypedValueRef typed_value, SUTypedValueType value_type, double real) {
+  TypedValue* value = set_typed(typed_value, value_type);
+  if (value == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  value->real = real;
+  return SU_ERROR_NONE;
+}
+
+} // namespace
+
+
+SUResult SUTypedValueCreate(SUTypedValueRef* typed_value) {
+  return create<TypedValue>(typed_value);
+}
+
+
+SUResult SUTypedValueRelease(SUTypedValueRef* typed_value) {
+  return release<TypedValue>(typed_value);
+}
+
+
+SUResult SUTypedValueGetType(SUTypedValueRef typed_value, enum SUTypedValueType* type) {
+  const TypedValue* value = get<TypedValue>(typed_value);
+  if (value == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  return set_value(type, value->value_type);
+}
+
+
+SUResult SUTypedValueGetByte(SUTypedValueRef typed_value, char* byte_value) {
+  return get_integer(typed_value, SUTypedValueType_Byte, byte_value);
+}
+
+
+SUResult SUTypedValueSetByte(SUTypedValueRef typed_value, char byte_value) {
+  return set_integer(typed_value, SUTypedValueType_Byte, byte_value);
+}
+
+
+SUResult SUTypedValueGetInt16(SUTypedValueRef typed_value, int16_t* int16_value) {
+  return get_integer(typed_value, SUTypedValueType_Short, int16_value);
+}
+
+
+SUResult SUTypedValueSetInt16(SUTypedValueRef typed_value, int16_t int16_value) {
+  return set_integer(typed_value, SUTypedValueType_Short, int16_value);
+}
+
+
+SUResult SUTypedValueGetInt32(SUTypedValueRef typed_value, int32_t* int32_value) {
+  return get_integer(typed_value, SUTypedValueType_Int32, int32_value);
+}
+
+
+SUResult SUTypedValueSetInt32(SUTypedValueRef typed_value, int32_t int32_value) {
+  return set_integer(typed_value, SUTypedValueType_Int32, int32_value);
+}
+
+
+SUResult SUTypedValueGetBool(SUTypedValueRef typed_value, bool* bool_value) {
+  const TypedValue* value = nullptr;
+  SUResult result = get_typed(typed_value, SUTypedValueType_Bool, bool_value, &value);
+  if (result == SU_ERROR_NONE) {
+    *bool_value = value->integer != 0;
+  }
+  return result;
+}
+
+
+SUResult SUTypedValueSetBool(SUTypedValueRef typed_value, bool bool_value) {
+  return set_integer(typed_value, SUTypedValueType_Bool, bool_value ? 1 : 0);
+}
+
+
+SUResult SUTypedValueGetTime(SUTypedValueRef typed_value, int64_t* time_value) {
+  return get_integer(typed_value, SUTypedValueType_Time, time_value);
+}
+
+
+SUResult SUTypedValueSetTime(SUTypedValueRef typed_value, int64_t time_value) {
+  return set_integer(typed_value, SUTypedValueType_Time, time_value);
+}
+
+
+SUResult SUTypedValueGetFloat(SUTypedValueRef typed_value, float* float_value) {
+  return get_real(typed_value, SUTypedValueType_Float, float_value);
+}
+
+
+SUResult SUTypedValueSetFloat(SUTypedValueRef typed_value, float float_value) {
+  return set_real(typed_value, SUTypedValueType_Float, float_value);
+}
+
+
+SUResult SUTypedValueGetDouble(SUTypedValueRef typed_value, double* double_value) {
+  return get_real(typed_value, SUTypedValueType_Double, double_value);
+}
+
+
+SUResult SUTypedValueSetDouble(SUTypedValueRef typed_value, double double_value) {
+  return set_real(typed_value, SUTypedValueType_Double, double_value);
+}
+
+
+SUResult SUTypedValueGetColor(SUTypedValueRef typed_value, SUColor* color) {
+  const TypedValue* value = nullptr;
+  SUResult result = get_typed(typed_value, SUTypedValueType_Color, color, &value);
+  if (result == SU_ERROR_NONE) {
+    *color = value->color;
+  }
+  return result;
+}
+
+
+SUResult SUTypedValueSetColor(SUTypedValueRef typed_value, const SUColor* color) {
+  if (color == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  TypedValue* value = set_typed(typed_value, SUTypedValueType_Color);
+  if (value == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  value->color = *color;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTypedValueGetString(SUTypedValueRef typed_value, SUStringRef* string_value) {
+  const TypedValue* value = nullptr;
+  SUResult result = get_typed(typed_value, SUTypedValueType_String, string_value, &value);
+  if (result == SU_ERROR_NONE) {
+    result = set_string(string_value, value->string);
+  }
+  return result;
+}
+
+
+SUResult SUTypedValueSetString(SUTypedValueRef typed_value, const char* string_value) {
+  if (string_value == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  TypedValue* value = set_typed(typed_value, SUTypedValueType_String);
+  if (value == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  value->string = string_value;
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTypedValueGetVector3d(SUTypedValueRef typed_value, double vector3d_value[3]) {
+  const TypedValue* value = nullptr;
+  SUResult result = get_typed(typed_value, SUTypedValueType_Vector3D, vector3d_value, &value);
+  if (result == SU_ERROR_NONE) {
+    std::copy(value->vector, value->vector + 3, vector3d_value);
+  }
+  return result;
+}
+
+
+SUResult SUTypedValueSetVector3d(SUTypedValueRef typed_value, const double vector3d_value[3]) {
+  if (vector3d_value == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  TypedValue* value = set_typed(typed_value, SUTypedValueType_Vector3D);
+  if (value == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  std::copy(vector3d_value, vector3d_value + 3, value->vector);
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTypedValueGetNumArrayItems(SUTypedValueRef typed_value, size_t* count) {
+  const TypedValue* value = nullptr;
+  SUResult result = get_typed(typed_value, SUTypedValueType_Array, count, &value);
+  if (result == SU_ERROR_NONE) {
+    *count = value->items.size();
+  }
+  return result;
+}
+
+
+SUResult SUTypedValueGetArrayItems(SUTypedValueRef typed_value, size_t len, SUTypedValueRef values[], size_t* count) {
+  const TypedValue* value = nullptr;
+  SUResult result = get_typed(typed_value, SUTypedValueType_Array, values, &value);
+  if (result != SU_ERROR_NONE) {
+    return result;
+  }
+  if (count == nullptr) {
+    return SU_ERROR_NULL_POINTER_OUTPUT;
+  }
+  // The items stay owned by the array.
+  *count = std::min(len, value->items.size());
+  for (size_t i = 0; i < *count; ++i) {
+    values[i] = to_ref<SUTypedValueRef>(value->items[i].get());
+  }
+  return SU_ERROR_NONE;
+}
+
+
+SUResult SUTypedValueSetArrayItems(SUTypedValueRef typed_value, size_t len, SUTypedValueRef values[]) {
+  if (values == nullptr) {
+    return SU_ERROR_NULL_POINTER_INPUT;
+  }
+  std::vector<std::unique_ptr<TypedValue>> items;
+  items.reserve(len);
+  for (size_t i = 0; i < len; ++i) {
+    const TypedValue* item = get<TypedValue>(values[i]);
+    if (item == nullptr) {
+      return SU_ERROR_INVALID_INPUT;
+    }
+    items.emplace_back(new TypedValue());
+    items.back()->assign(*item);
+  }
+  TypedValue* value = set_typed(typed_value, SUTypedValueType_Array);
+  if (value == nullptr) {
+    return SU_ERROR_INVALID_INPUT;
+  }
+  value->items = std::move(items);
+  return SU_ERROR_NONE;
+}
@@ -0,0 +1,146 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/AttributeDictionary.hpp"
+#include "SUAPI-CppWrapper/model/AttributeSnapshot.hpp"
+#include "SUAPI-CppWrapper/model/TypedValue.hpp"
+
+TEST(AttributeSnapshot, set_and_find)
+{
+  CW::AttributeSnapshot attributes;
+  EXPECT_TRUE(attributes.empty());
+  EXPECT_EQ(nullptr, attributes.find("missing"));
+
+  // Enough keys to make the table grow several times.
+  for (int32_t i = 0; i < 1000; ++i) {
+    attributes.set("key" + std::to_string(i), CW::AttributeValue().int32_value(i));
+  }
+  attributes.set("name", "Wall");
+  ASSERT_EQ(1001, attributes.size());
+  for (int32_t i = 0; i < 1000; ++i) {
+    const CW::AttributeValue* value = attributes.find("key" + std::to_string(i));
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(i, value->int32_value());
+  }
+  EXPECT_EQ("Wall", attributes.find("name")->string_value());
+  EXPECT_FALSE(attributes.contains("key1000"));
+
+  // Setting an existing key replaces its value, and keeps its position.
+  attributes.set("key0", CW::AttributeValue().double_value(2.5));
+  EXPECT_EQ(1001, attributes.size());
+  EXPECT_EQ("key0", attributes.begin()->first);
+  EXPECT_EQ(2.5, attributes.find("key0")->double_value());
+
+  const CW::AttributeValue default_value("default");
+  EXPECT_EQ(default_value, attributes.get("missing", default_value));
+
+  attributes.clear();
+  EXPECT_TRUE(attributes.empty());
+  EXPECT_FALSE(attributes.contains("name"));
+  attributes.set("name", "Door");
+  EXPECT_EQ("Door", attributes.find("name")->string_value());
+}
+
+
+TEST(AttributeSnapshot, value_types)
+{
+  CW::AttributeValue value;
+  EXPECT_TRUE(value.empty());
+  EXPECT_THROW(value.int32_value(), std::logic_error);
+
+  value.string_value("a string");
+  EXPECT_EQ(SUTypedValueType_String, value.get_type());
+  value.vector_value(CW::Vector3D(1.0, 2.0, 3.0));
+  EXPECT_EQ(SUTypedValueType_Vector3D, value.get_type());
+  EXPECT_EQ(CW::Vector3D(1.0, 2.0, 3.0), value.vector_value());
+  EXPECT_THROW(value.string_value(), std::logic_error);
+
+  CW::AttributeValue array;
+  array.array_value({CW::AttributeValue().bool_value(true), CW::AttributeValue("item")});
+  CW::AttributeValue copy = array;
+  EXPECT_EQ(array, copy);
+  ASSERT_EQ(2, copy.array_value().size());
+  EXPECT_TRUE(copy.array_value()[0].bool_value());
+  EXPECT_NE(array, CW::AttributeValue().array_value({CW::AttributeValue().bool_value(false)}));
+  EXPECT_NE(CW::AttributeValue().int32_value(1), CW::AttributeValue().int16_value(1));
+}
+
+
+TEST(AttributeSnapshot, values_share_out_of_line_storage)
+{
+  static_assert(sizeof(CW::AttributeValue) <= 16, "AttributeValue must be compact");
+  CW::AttributeValue value("a string that is too long for the small string buffer");
+  CW::AttributeValue copy = value;
+  // Copies share the string, rather than copying it.
+  EXPECT_EQ(&value.string_value(), &copy.string_value());
+
+  // Changing one of the copies leaves the other unchanged.
+  copy.string_value("changed");
+  EXPECT_EQ("a string that is too long for the small string buffer", value.string_value());
+  EXPECT_EQ("changed", copy.string_value());
+  // A string that is not shared is changed in place.
+  const std::string* string = &copy.string_value();
+  copy.string_value("changed again");
+  EXPECT_EQ(string, &copy.string_value());
+
+  CW::AttributeValue moved(std::move(value));
+  EXPECT_TRUE(value.empty());
+  EXPECT_EQ("a string that is too long for the small string buffer", moved.string_value());
+  moved = moved;
+  EXPECT_EQ("a string that is too long for the small string buffer", moved.string_value());
+  // Assigning an item of a value's own array to it.
+  CW::AttributeValue array;
+  array.array_value({CW::AttributeValue("item"), CW::AttributeValue().int32_value(1)});
+  array = array.array_value()[0];
+  EXPECT_EQ("item", array.string_value());
+  moved = CW::AttributeValue().int32_value(7);
+  EXPECT_EQ(7, moved.int32_value());
+  EXPECT_EQ(0, moved.memory_size());
+  EXPECT_LT(0, copy.memory_size());
+}
+
+
+TEST(AttributeSnapshot, dictionary_snapshot_and_set_attributes)
+{
+  CW::initialize();
+  CW::AttributeDictionary dict("BIM");
+  CW::AttributeSnapshot batch;
+  batch.set("name", "Wall");
+  batch.set("storey", CW::AttributeValue().int32_value(3));
+  batch.set("thickness", CW::AttributeValue().double_value(0.25));
+  batch.set("load_bearing", CW::AttributeValue().bool_value(true));
+  batch.set("created", CW::AttributeValue().time_value(1500000000));
+  batch.set("normal", CW::AttributeValue().vector_value(CW::Vector3D(0.0, 1.0, 0.0)));
+  batch.set("tags", CW::AttributeValue().array_value({CW::AttributeValue("external"), CW::AttributeValue().int32_value(7)}));
+  EXPECT_TRUE(dict.set_attributes(batch));
+
+  // The values written in one batch can be read back one at a time.
+  EXPECT_EQ("Wall", dict.get_value("name").string_value().std_string());
+  EXPECT_EQ(3, dict.get_value("storey").int32_value());
+
+  CW::AttributeSnapshot attributes = dict.snapshot();
+  ASSERT_EQ(batch.size(), attributes.size());
+  for (const CW::AttributeSnapshot::value_type& attribute : batch) {
+    const CW::AttributeValue* value = attributes.find(attribute.first);
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(attribute.second, *value);
+  }
+
+  // Filling an existing snapshot replaces its contents.
+  CW::AttributeSnapshot reused;
+  reused.set("stale", "value");
+  dict.snapshot(reused);
+  EXPECT_FALSE(reused.contains("stale"));
+  EXPECT_EQ(attributes.size(), reused.size());
+
+  // Copying an unattached dictionary copies its values through a snapshot.
+  CW::AttributeDictionary copy(dict);
+  EXPECT_EQ(0.25, copy.snapshot().find("thickness")->double_value());
+}
@@ -0,0 +1,91 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/model/DefinitionGeometryCache.hpp"
+
+
+namespace {
+
+CW::ComponentDefinition add_square_definition(CW::Model& model, double size) {
+  CW::ComponentDefinition definition;
+  model.add_definition(definition);
+  std::vector<CW::Point3D> points = {
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(size, 0.0, 0.0),
+    CW::Point3D(size, size, 0.0),
+    CW::Point3D(0.0, size, 0.0)
+  };
+  CW::Face face(points);
+  definition.entities().add_face(face);
+  return definition;
+}
+
+} // namespace
+
+
+TEST(DefinitionGeometryCache, extracts_once_per_definition)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::ComponentDefinition definition = add_square_definition(model, 10.0);
+
+  CW::DefinitionGeometryCache cache;
+  CW::DefinitionMeshPtr first = cache.get(definition);
+  ASSERT_EQ(2, first->num_triangles());
+  ASSERT_EQ(first->positions.size(), first->normals.size());
+  ASSERT_EQ(2, first->material_ids.size());
+  for (size_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(first.get(), cache.get(definition).get());
+  }
+  ASSERT_EQ(1, cache.misses());
+  ASSERT_EQ(100, cache.hits());
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(first->memory_size(), cache.memory_size());
+
+  cache.invalidate(definition);
+  ASSERT_FALSE(cache.contains(definition));
+  ASSERT_EQ(0, cache.memory_size());
+  ASSERT_NE(first.get(), cache.get(definition).get());
+  ASSERT_EQ(2, cache.misses());
+}
+
+TEST(DefinitionGeometryCache, evicts_least_recently_used)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::ComponentDefinition definition1 = add_square_definition(model, 1.0);
+  CW::ComponentDefinition definition2 = add_square_definition(model, 2.0);
+  CW::ComponentDefinition definition3 = add_square_definition(model, 3.0);
+
+  CW::DefinitionGeometryCache cache;
+  CW::DefinitionMeshPtr mesh1 = cache.get(definition1);
+  cache.get(definition2);
+  // Room for two meshes only.
+  cache.max_memory_size(cache.memory_size());
+  cache.get(definition1);
+  cache.get(definition3);
+  ASSERT_EQ(1, cache.evictions());
+  ASSERT_TRUE(cache.contains(definition1));
+  ASSERT_FALSE(cache.contains(definition2));
+  ASSERT_TRUE(cache.contains(definition3));
+  ASSERT_LE(cache.memory_size(), cache.max_memory_size());
+
+  // Handles outlive eviction.
+  cache.clear();
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(2, mesh1->num_triangles());
+}
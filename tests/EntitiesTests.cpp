@@ -0,0 +1,158 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/Loop.hpp"
+#include "SUAPI-CppWrapper/model/LoopInput.hpp"
+#include "SUAPI-CppWrapper/model/MeshSnapshot.hpp"
+#include "SUAPI-CppWrapper/Triangulator.hpp"
+
+
+TEST(Entities, mesh_snapshot_empty)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::MeshSnapshot snapshot = model.entities().mesh_snapshot();
+  ASSERT_EQ(0, snapshot.num_faces());
+  ASSERT_EQ(0, snapshot.num_loops());
+  ASSERT_TRUE(snapshot.positions.empty());
+}
+
+TEST(Entities, mesh_snapshot_matches_faces)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::Entities entities = model.entities();
+  std::vector<CW::Point3D> outer_points = {
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(10.0, 0.0, 0.0),
+    CW::Point3D(10.0, 10.0, 0.0),
+    CW::Point3D(0.0, 10.0, 0.0)
+  };
+  CW::Face face(outer_points);
+  entities.add_face(face);
+
+  CW::MeshSnapshot snapshot = entities.mesh_snapshot();
+  std::vector<CW::Face> faces = entities.faces();
+  ASSERT_EQ(faces.size(), snapshot.num_faces());
+  ASSERT_EQ(1, snapshot.num_loops());
+  std::vector<CW::Point3D> points = faces[0].outer_loop().points();
+  ASSERT_EQ(points.size(), snapshot.loop_offsets[1] - snapshot.loop_offsets[0]);
+  for (size_t i = 0; i < points.size(); ++i) {
+    ASSERT_TRUE(points[i] == CW::Point3D(snapshot.positions[snapshot.loop_offsets[0] + i]));
+  }
+  ASSERT_EQ(CW::MeshSnapshot::NO_ID, snapshot.front_material_ids[0]);
+  ASSERT_EQ(CW::MeshSnapshot::NO_ID, snapshot.back_material_ids[0]);
+}
+
+TEST(Entities, triangulate_all)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::Entities entities = model.entities();
+  std::vector<CW::Point3D> outer_points = {
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(10.0, 0.0, 0.0),
+    CW::Point3D(10.0, 10.0, 0.0),
+    CW::Point3D(0.0, 10.0, 0.0)
+  };
+  CW::Face face(outer_points);
+  entities.add_face(face);
+
+  CW::TriangleMesh mesh = entities.triangulate_all();
+  ASSERT_EQ(1, mesh.num_polygons());
+  ASSERT_EQ(2, mesh.num_triangles());
+  ASSERT_EQ(4, mesh.positions.size());
+  CW::TriangleMesh face_mesh = entities.faces()[0].triangulate();
+  ASSERT_EQ(mesh.indices, face_mesh.indices);
+}
+
+TEST(Entities, triangulate_faces_reuses_buffers)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  std::vector<CW::Point3D> outer_points = {
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(10.0, 0.0, 0.0),
+    CW::Point3D(10.0, 10.0, 0.0),
+    CW::Point3D(0.0, 10.0, 0.0)
+  };
+  CW::Face face(outer_points);
+  std::vector<CW::Point3D> hole_points = {
+    CW::Point3D(2.0, 2.0, 0.0),
+    CW::Point3D(2.0, 8.0, 0.0),
+    CW::Point3D(8.0, 8.0, 0.0),
+    CW::Point3D(8.0, 2.0, 0.0)
+  };
+  CW::LoopInput hole;
+  for (size_t i = 0; i < hole_points.size(); ++i) {
+    hole.add_vertex_index(i);
+  }
+  face.add_inner_loop(hole_points, hole);
+  model.entities().add_face(face);
+
+  CW::Triangulator triangulator;
+  CW::Face::TriangulationBuffers buffers;
+  CW::TriangleMesh mesh;
+  ASSERT_EQ(8, face.triangulate(mesh, triangulator, buffers));
+  ASSERT_EQ(2, buffers.loops.size());
+  ASSERT_EQ(8, buffers.points.size());
+  const SUPoint3D* points_data = buffers.points.data();
+  ASSERT_EQ(8, face.triangulate(mesh, triangulator, buffers));
+  EXPECT_EQ(points_data, buffers.points.data());
+  EXPECT_EQ(2, mesh.num_polygons());
+  EXPECT_EQ(16, mesh.num_triangles());
+  CW::TriangleMesh face_mesh = face.triangulate();
+  EXPECT_EQ(std::vector<uint32_t>(mesh.indices.begin(), mesh.indices.begin() + 24), face_mesh.indices);
+}
+
+TEST(Entities, fill_vectors_reuse_memory)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::Entities entities = model.entities();
+  for (size_t i = 0; i < 3; ++i) {
+    std::vector<CW::Point3D> outer_points = {
+      CW::Point3D(double(i) * 20.0, 0.0, 0.0),
+      CW::Point3D(double(i) * 20.0 + 10.0, 0.0, 0.0),
+      CW::Point3D(double(i) * 20.0 + 10.0, 10.0, 0.0),
+      CW::Point3D(double(i) * 20.0, 10.0, 0.0)
+    };
+    CW::Face face(outer_points);
+    entities.add_face(face);
+  }
+
+  std::vector<CW::Face> faces;
+  std::vector<CW::Loop> loops;
+  std::vector<CW::Point3D> points;
+  entities.faces(faces);
+  ASSERT_EQ(entities.faces().size(), faces.size());
+  const CW::Face* faces_data = faces.data();
+  entities.faces(faces);
+  EXPECT_EQ(faces_data, faces.data());
+  for (const CW::Face& face : faces) {
+    face.loops(loops);
+    ASSERT_EQ(1, loops.size());
+    loops[0].points(points);
+    EXPECT_EQ(loops[0].points(), points);
+    EXPECT_EQ(4, points.size());
+  }
+}
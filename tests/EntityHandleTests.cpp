@@ -0,0 +1,74 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/EntityHandle.hpp"
+#include "SUAPI-CppWrapper/model/Edge.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/GeometryInput.hpp"
+
+
+TEST(EntityHandle, null_handles)
+{
+  CW::FaceHandle face;
+  EXPECT_TRUE(!face);
+  EXPECT_EQ(CW::FaceHandle(), face);
+  EXPECT_EQ(std::hash<CW::FaceHandle>()(face), std::hash<CW::FaceHandle>()(CW::FaceHandle()));
+}
+
+
+TEST(EntityHandle, face_handles_match_faces)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+
+  // Ten separate triangles.
+  std::vector<SUPoint3D> vertices;
+  std::vector<uint32_t> indices;
+  std::vector<uint32_t> face_offsets;
+  for (uint32_t i = 0; i < 10; ++i) {
+    face_offsets.push_back(uint32_t(indices.size()));
+    vertices.push_back(SUPoint3D{double(i) * 2.0, 0.0, 0.0});
+    vertices.push_back(SUPoint3D{double(i) * 2.0 + 1.0, 0.0, 0.0});
+    vertices.push_back(SUPoint3D{double(i) * 2.0, 1.0, 0.0});
+    indices.insert(indices.end(), {i * 3, i * 3 + 1, i * 3 + 2});
+  }
+  CW::GeometryInput geom_input(su_model);
+  geom_input.add_indexed_mesh(vertices, indices, face_offsets);
+  CW::Entities entities = model.entities();
+  SU(entities.fill(geom_input));
+
+  std::vector<CW::Face> faces = entities.faces();
+  std::vector<CW::FaceHandle> handles = entities.face_handles();
+  ASSERT_EQ(faces.size(), handles.size());
+  std::unordered_set<CW::FaceHandle> handle_set(handles.begin(), handles.end());
+  std::set<CW::FaceHandle> sorted_handles(handles.begin(), handles.end());
+  EXPECT_EQ(handles.size(), handle_set.size());
+  EXPECT_EQ(handles.size(), sorted_handles.size());
+  for (size_t i = 0; i < faces.size(); ++i) {
+    EXPECT_EQ(CW::FaceHandle(faces[i]), handles[i]);
+    CW::Face face = handles[i].get();
+    EXPECT_TRUE(face.attached());
+    EXPECT_EQ(faces[i], face);
+    EXPECT_EQ(1, handle_set.count(CW::FaceHandle(face)));
+  }
+
+  // Filling reuses the vector.
+  entities.face_handles(handles);
+  EXPECT_EQ(faces.size(), handles.size());
+
+  std::vector<CW::EdgeHandle> edge_handles = entities.edge_handles(false);
+  EXPECT_EQ(entities.edges(false).size(), edge_handles.size());
+  EXPECT_EQ(0, entities.edge_handles().size());
+  EXPECT_EQ(0, entities.instance_handles().size());
+}
@@ -0,0 +1,177 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Transformation.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/Group.hpp"
+#include "SUAPI-CppWrapper/model/LoopInput.hpp"
+#include "SUAPI-CppWrapper/model/FaceBVH.hpp"
+
+
+namespace {
+
+std::vector<CW::Point3D> square(double size, double z)
+{
+  return std::vector<CW::Point3D>{
+    CW::Point3D(0.0, 0.0, z),
+    CW::Point3D(size, 0.0, z),
+    CW::Point3D(size, size, z),
+    CW::Point3D(0.0, size, z)
+  };
+}
+
+} // namespace
+
+
+TEST(FaceBVH, empty)
+{
+  CW::FaceBVH bvh;
+  ASSERT_EQ(0, bvh.num_faces());
+  CW::RayTestResult result = bvh.raytest(CW::Point3D(0.0, 0.0, 0.0), CW::Vector3D(0.0, 0.0, 1.0));
+  ASSERT_TRUE(!result);
+}
+
+TEST(FaceBVH, raytest_nested_group)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::Entities entities = model.entities();
+  std::vector<CW::Point3D> ground_points = square(10.0, 0.0);
+  CW::Face ground(ground_points);
+  entities.add_face(ground);
+  CW::Group group = entities.add_group();
+  std::vector<CW::Point3D> roof_points = square(10.0, 0.0);
+  CW::Face roof(roof_points);
+  group.entities().add_face(roof);
+  group.transformation(CW::Transformation(CW::Vector3D(0.0, 0.0, 10.0)));
+
+  CW::FaceBVH bvh(entities);
+  ASSERT_EQ(2, bvh.num_faces());
+
+  // Ray from above hits the face in the group first.
+  CW::RayTestResult from_above = bvh.raytest(CW::Point3D(5.0, 5.0, 20.0), CW::Vector3D(0.0, 0.0, -1.0));
+  ASSERT_FALSE(!from_above);
+  ASSERT_NEAR(10.0, from_above.distance, CW::Point3D::EPSILON);
+  ASSERT_TRUE(CW::Point3D(5.0, 5.0, 10.0) == from_above.point);
+  ASSERT_EQ(1, from_above.instances.size());
+
+  // Ray from below hits the ungrouped face.
+  CW::RayTestResult from_below = bvh.raytest(CW::Point3D(5.0, 5.0, -5.0), CW::Vector3D(0.0, 0.0, 2.0));
+  ASSERT_FALSE(!from_below);
+  ASSERT_NEAR(5.0, from_below.distance, CW::Point3D::EPSILON);
+  ASSERT_EQ(0, from_below.instances.size());
+
+  // Ray beside the faces hits nothing.
+  CW::RayTestResult miss = bvh.raytest(CW::Point3D(15.0, 5.0, 20.0), CW::Vector3D(0.0, 0.0, -1.0));
+  ASSERT_TRUE(!miss);
+
+  // Model::raytest gives the same result.
+  CW::RayTestResult model_result = model.raytest(CW::Point3D(5.0, 5.0, 20.0), CW::Vector3D(0.0, 0.0, -1.0));
+  ASSERT_NEAR(from_above.distance, model_result.distance, CW::Point3D::EPSILON);
+}
+
+TEST(FaceBVH, raytest_through_hole)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::Entities entities = model.entities();
+  std::vector<CW::Point3D> outer_points = square(10.0, 0.0);
+  CW::Face face(outer_points);
+  std::vector<CW::Point3D> hole_points = {
+    CW::Point3D(2.0, 2.0, 0.0),
+    CW::Point3D(2.0, 8.0, 0.0),
+    CW::Point3D(8.0, 8.0, 0.0),
+    CW::Point3D(8.0, 2.0, 0.0)
+  };
+  CW::LoopInput hole;
+  for (size_t i = 0; i < hole_points.size(); ++i) {
+    hole.add_vertex_index(i);
+  }
+  face.add_inner_loop(hole_points, hole);
+  entities.add_face(face);
+
+  CW::FaceBVH bvh(entities);
+  ASSERT_EQ(1, bvh.num_faces());
+
+  // Ray through the hole misses the face.
+  CW::RayTestResult through_hole = bvh.raytest(CW::Point3D(5.0, 5.0, 5.0), CW::Vector3D(0.0, 0.0, -1.0));
+  ASSERT_TRUE(!through_hole);
+
+  // Ray between the hole and the outer edge hits it.
+  CW::RayTestResult beside_hole = bvh.raytest(CW::Point3D(1.0, 5.0, 5.0), CW::Vector3D(0.0, 0.0, -1.0));
+  ASSERT_FALSE(!beside_hole);
+  ASSERT_NEAR(5.0, beside_hole.distance, CW::Point3D::EPSILON);
+
+  // A face below the hole is hit through it.
+  std::vector<CW::Point3D> floor_points = square(10.0, -10.0);
+  CW::Face floor(floor_points);
+  entities.add_face(floor);
+  CW::FaceBVH with_floor(entities);
+  CW::RayTestResult to_floor = with_floor.raytest(CW::Point3D(5.0, 5.0, 5.0), CW::Vector3D(0.0, 0.0, -1.0));
+  ASSERT_FALSE(!to_floor);
+  ASSERT_NEAR(15.0, to_floor.distance, CW::Point3D::EPSILON);
+}
+
+TEST(FaceBVH, raytest_from_several_threads)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::Entities entities = model.entities();
+  for (size_t i = 0; i < 4; ++i) {
+    std::vector<CW::Point3D> points = square(10.0 - 2.0 * i, 5.0 * i);
+    CW::Face face(points);
+    entities.add_face(face);
+  }
+  CW::FaceBVH bvh(entities);
+  ASSERT_EQ(4, bvh.num_faces());
+
+  // Rays straight down over a grid, some of which miss every face.
+  std::vector<CW::Point3D> origins;
+  for (size_t x = 0; x < 12; ++x) {
+    for (size_t y = 0; y < 12; ++y) {
+      origins.push_back(CW::Point3D(x + 0.5, y + 0.5, 50.0));
+    }
+  }
+  const CW::Vector3D down(0.0, 0.0, -1.0);
+  std::vector<double> expected(origins.size(), -1.0);
+  for (size_t i = 0; i < origins.size(); ++i) {
+    CW::RayTestResult result = bvh.raytest(origins[i], down);
+    if (!!result) {
+      expected[i] = result.distance;
+    }
+  }
+
+  std::vector<std::vector<double>> found(4, std::vector<double>(origins.size(), -1.0));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < found.size(); ++t) {
+    threads.emplace_back([&bvh, &origins, &down, &found, t]() {
+      for (size_t repeat = 0; repeat < 20; ++repeat) {
+        for (size_t i = 0; i < origins.size(); ++i) {
+          CW::RayTestResult result = bvh.raytest(origins[i], down);
+          found[t][i] = !result ? -1.0 : result.distance;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (const std::vector<double>& distances : found) {
+    ASSERT_EQ(expected, distances);
+  }
+}
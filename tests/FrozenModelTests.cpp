@@ -0,0 +1,191 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/Transformation.hpp"
+#include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/FrozenModel.hpp"
+#include "SUAPI-CppWrapper/model/Group.hpp"
+#include "SUAPI-CppWrapper/model/Layer.hpp"
+#include "SUAPI-CppWrapper/model/Material.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/TypedValue.hpp"
+
+namespace {
+
+std::vector<CW::Point3D> square() {
+  return {CW::Point3D(0.0, 0.0, 0.0), CW::Point3D(1.0, 0.0, 0.0), CW::Point3D(1.0, 1.0, 0.0), CW::Point3D(0.0, 1.0, 0.0)};
+}
+
+/**
+* A model with a material and a layer, a definition holding one square face placed twice, and a group.
+*/
+void build_model(CW::Model& model) {
+  SUMaterialRef material_ref = SU_INVALID;
+  SU(SUMaterialCreate(&material_ref));
+  std::vector<CW::Material> materials;
+  materials.emplace_back(material_ref, false);
+  materials[0].name(CW::String("Red"));
+  model.add_materials(materials);
+  SULayerRef layer_ref = SU_INVALID;
+  SU(SULayerCreate(&layer_ref));
+  std::vector<CW::Layer> layers;
+  layers.emplace_back(layer_ref, false);
+  layers[0].name(std::string("Walls"));
+  model.add_layers(layers);
+
+  CW::ComponentDefinition definition;
+  definition.name("Tile");
+  model.add_definition(definition);
+  std::vector<CW::Point3D> points = square();
+  CW::Face face(points);
+  CW::Face added = definition.entities().add_face(face);
+  added.material(materials[0]);
+  added.set_attribute("Tags", "kind", CW::TypedValue("floor"));
+
+  CW::Entities entities = model.entities();
+  entities.add_instance(definition, CW::Transformation(CW::Vector3D(10.0, 0.0, 0.0)));
+  CW::ComponentInstance second = entities.add_instance(definition, CW::Transformation(CW::Vector3D(20.0, 0.0, 0.0)));
+  second.name(CW::String("second"));
+  second.layer(layers[0]);
+  entities.add_group();
+  CW::TypedValue id;
+  id.int32_value(42);
+  model.set_attribute("Project", "id", id);
+}
+
+} // namespace
+
+
+TEST(FrozenModel, copies_definitions_and_instances)
+{
+  CW::initialize();
+  CW::Model model;
+  build_model(model);
+  CW::FrozenModelPtr frozen = model.freeze();
+
+  // The root, the definition and the group's definition.
+  ASSERT_EQ(3, frozen->definitions().size());
+  const CW::FrozenModel::Definition& root = frozen->definitions()[CW::FrozenModel::ROOT];
+  EXPECT_EQ("", frozen->string(root.name).str());
+  ASSERT_EQ(3, root.instances.size());
+
+  const CW::FrozenModel::Index tile = frozen->find_definition("Tile");
+  ASSERT_NE(CW::FrozenModel::NO_INDEX, tile);
+  EXPECT_FALSE(frozen->definitions()[tile].group);
+  size_t num_tiles = 0;
+  size_t num_groups = 0;
+  for (const CW::FrozenModel::Instance& instance : frozen->instances(root.instances)) {
+    EXPECT_EQ(CW::FrozenModel::ROOT, instance.parent);
+    if (instance.definition == tile) {
+      ++num_tiles;
+    }
+    else if (frozen->definitions()[instance.definition].group) {
+      ++num_groups;
+    }
+  }
+  EXPECT_EQ(2, num_tiles);
+  EXPECT_EQ(1, num_groups);
+
+  const CW::FrozenModel::Instance& second = frozen->instances()[root.instances.begin + 1];
+  EXPECT_EQ("second", frozen->string(second.name).str());
+  EXPECT_DOUBLE_EQ(20.0, second.transformation.translation().x);
+  EXPECT_EQ(frozen->find_layer("Walls"), second.layer);
+  EXPECT_EQ(CW::FrozenModel::NO_INDEX, frozen->find_definition("Missing"));
+}
+
+
+TEST(FrozenModel, copies_geometry_materials_and_attributes)
+{
+  CW::initialize();
+  CW::Model model;
+  build_model(model);
+  CW::FrozenModelPtr frozen = model.freeze();
+
+  const CW::FrozenModel::Definition& tile = frozen->definitions()[frozen->find_definition("Tile")];
+  ASSERT_EQ(1, tile.faces.size());
+  ASSERT_EQ(4, tile.edges.size());
+  const CW::FrozenModel::Face& face = frozen->faces(tile.faces)[0];
+  EXPECT_DOUBLE_EQ(1.0, std::abs(face.normal.z));
+  ASSERT_EQ(1, face.loops.size());
+  const CW::FrozenModel::Loop& loop = frozen->loops(face.loops)[0];
+  ASSERT_EQ(4, frozen->loop_vertices(loop).size());
+  // Each edge of the loop joins the loop's vertex to the next one.
+  for (size_t i = 0; i < 4; ++i) {
+    const CW::FrozenModel::Index edge_index = frozen->loop_edges(loop)[i];
+    ASSERT_NE(CW::FrozenModel::NO_INDEX, edge_index);
+    const CW::FrozenModel::Edge& edge = frozen->edges()[edge_index];
+    const CW::FrozenModel::Index vertex = frozen->loop_vertices(loop)[i];
+    EXPECT_TRUE(edge.start == vertex || edge.end == vertex);
+  }
+  for (const CW::FrozenModel::Index vertex : frozen->loop_vertices(loop)) {
+    EXPECT_DOUBLE_EQ(0.0, frozen->vertices()[vertex].z);
+  }
+
+  ASSERT_EQ(frozen->find_material("Red"), face.front_material);
+  EXPECT_EQ("Red", frozen->string(frozen->materials()[face.front_material].name).str());
+  EXPECT_EQ(CW::FrozenModel::NO_INDEX, face.back_material);
+
+  const CW::AttributeValue* kind = frozen->attribute(face.attributes, "Tags", "kind");
+  ASSERT_NE(nullptr, kind);
+  EXPECT_EQ("floor", kind->string_value());
+  EXPECT_EQ(nullptr, frozen->attribute(face.attributes, "Tags", "missing"));
+  const CW::AttributeValue* id = frozen->attribute(frozen->model_attributes(), "Project", "id");
+  ASSERT_NE(nullptr, id);
+  EXPECT_EQ(42, id->int32_value());
+
+  // Strings are interned once each.
+  EXPECT_EQ(frozen->find_string("Tags"), frozen->attributes(face.attributes)[0].dictionary);
+  EXPECT_GT(frozen->memory_size(), frozen->num_strings());
+}
+
+
+TEST(FrozenModel, is_unchanged_by_later_edits)
+{
+  CW::initialize();
+  CW::Model model;
+  build_model(model);
+  CW::FrozenModelPtr frozen = model.freeze();
+  model.entities().add_group();
+  EXPECT_EQ(3, frozen->definitions()[CW::FrozenModel::ROOT].instances.size());
+  EXPECT_EQ(4, model.freeze()->definitions()[CW::FrozenModel::ROOT].instances.size());
+}
+
+
+TEST(FrozenModel, concurrent_queries)
+{
+  CW::initialize();
+  CW::Model model;
+  build_model(model);
+  CW::FrozenModelPtr frozen = model.freeze();
+
+  std::atomic<size_t> found(0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back([frozen, &found]() {
+      for (size_t j = 0; j < 1000; ++j) {
+        const CW::FrozenModel::Definition& tile = frozen->definitions()[frozen->find_definition("Tile")];
+        const CW::AttributeValue* kind = frozen->attribute(frozen->faces(tile.faces)[0].attributes, "Tags", "kind");
+        if (kind != nullptr && kind->string_value() == "floor") {
+          ++found;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(4000, found.load());
+}
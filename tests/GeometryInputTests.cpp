@@ -0,0 +1,183 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/GeometryInput.hpp"
+#include "SUAPI-CppWrapper/model/LoopInput.hpp"
+
+
+namespace {
+
+void add_square(CW::GeometryInput& geom_input, double offset) {
+  const size_t first = geom_input.add_vertex(CW::Point3D(offset, 0.0, 0.0));
+  geom_input.add_vertex(CW::Point3D(offset + 1.0, 0.0, 0.0));
+  geom_input.add_vertex(CW::Point3D(offset + 1.0, 1.0, 0.0));
+  geom_input.add_vertex(CW::Point3D(offset, 1.0, 0.0));
+  CW::LoopInput loop;
+  for (size_t i = 0; i < 4; ++i) {
+    loop.add_vertex_index(first + i);
+  }
+  geom_input.add_face(loop);
+}
+
+} // namespace
+
+
+TEST(GeometryInput, copies_share_geometry)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+
+  CW::GeometryInput geom_input(su_model);
+  CW::GeometryInput copy(geom_input);
+  EXPECT_EQ(geom_input.ref().ptr, copy.ref().ptr);
+  // Vertex indices carry on across copies.
+  EXPECT_EQ(0, geom_input.add_vertex(CW::Point3D(0.0, 0.0, 0.0)));
+  EXPECT_EQ(1, copy.add_vertex(CW::Point3D(1.0, 0.0, 0.0)));
+
+  CW::GeometryInput moved(std::move(copy));
+  EXPECT_TRUE(!copy);
+  EXPECT_EQ(geom_input.ref().ptr, moved.ref().ptr);
+  EXPECT_EQ(2, moved.add_vertex(CW::Point3D(1.0, 1.0, 0.0)));
+
+  CW::GeometryInput other(su_model);
+  other = moved;
+  EXPECT_EQ(geom_input.ref().ptr, other.ref().ptr);
+}
+
+
+TEST(GeometryInput, build_on_worker_threads)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+
+  const size_t num_threads = 4;
+  const size_t faces_per_thread = 25;
+  std::vector<CW::GeometryInput> inputs(num_threads, CW::GeometryInput(su_model));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&inputs, t, su_model]() {
+      CW::GeometryInput geom_input(su_model);
+      for (size_t i = 0; i < faces_per_thread; ++i) {
+        add_square(geom_input, double(t * faces_per_thread + i) * 2.0);
+        // Copies made and dropped while other threads do the same.
+        CW::GeometryInput copy(geom_input);
+        EXPECT_EQ(i + 1, copy.num_faces());
+      }
+      inputs[t] = std::move(geom_input);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  CW::Entities entities = model.entities();
+  for (CW::GeometryInput& geom_input : inputs) {
+    EXPECT_EQ(faces_per_thread, geom_input.num_faces());
+    SU(entities.fill(geom_input));
+  }
+  EXPECT_EQ(num_threads * faces_per_thread, entities.faces().size());
+}
+
+
+TEST(GeometryInput, weld_vertices)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+
+  // A 4 x 4 grid of unit squares has 25 distinct corners among its 64 loop points.
+  CW::GeometryInput geom_input(su_model);
+  geom_input.weld_vertices(true);
+  EXPECT_TRUE(geom_input.weld_vertices());
+  for (size_t row = 0; row < 4; ++row) {
+    for (size_t column = 0; column < 4; ++column) {
+      CW::LoopInput loop;
+      loop.add_vertex_index(geom_input.add_vertex(CW::Point3D(double(column), double(row), 0.0)));
+      loop.add_vertex_index(geom_input.add_vertex(CW::Point3D(double(column + 1), double(row), 0.0)));
+      loop.add_vertex_index(geom_input.add_vertex(CW::Point3D(double(column + 1), double(row + 1), 0.0)));
+      // Within tolerance of the grid corner.
+      loop.add_vertex_index(geom_input.add_vertex(CW::Point3D(double(column), double(row + 1) + CW::Point3D::EPSILON * 0.5, 0.0)));
+      geom_input.add_face(loop);
+    }
+  }
+  EXPECT_EQ(25, geom_input.counts()[0]);
+  EXPECT_EQ(39, geom_input.welded_vertices());
+
+  CW::Entities entities = model.entities();
+  SU(entities.fill(geom_input));
+  EXPECT_EQ(16, entities.faces().size());
+}
+
+
+TEST(GeometryInput, add_indexed_mesh)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+
+  // A unit square split into two triangles, followed by a degenerate triangle.
+  const std::vector<SUPoint3D> vertices{{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {1.0, 1.0, 0.0}, {0.0, 1.0, 0.0}};
+  const std::vector<uint32_t> indices{0, 1, 2, 0, 2, 3, 1, 1, 2};
+  const std::vector<uint32_t> face_offsets{0, 3, 6};
+  const std::vector<uint8_t> smooth_edges{1, 1, 0};
+  CW::IndexedMeshFaceProperties properties;
+  properties.smooth_edges = smooth_edges;
+
+  CW::GeometryInput geom_input(su_model);
+  EXPECT_EQ(2, geom_input.add_indexed_mesh(vertices, indices, face_offsets, properties));
+  EXPECT_EQ(4, geom_input.counts()[0]);
+  EXPECT_EQ(2, geom_input.counts()[1]);
+
+  // A second mesh is appended after the vertices of the first.
+  const std::vector<SUPoint3D> raised{{0.0, 0.0, 1.0}, {1.0, 0.0, 1.0}, {1.0, 1.0, 1.0}};
+  const std::vector<uint32_t> raised_indices{0, 1, 2};
+  const std::vector<uint32_t> raised_offsets{0};
+  EXPECT_EQ(1, geom_input.add_indexed_mesh(raised, raised_indices, raised_offsets));
+  EXPECT_EQ(7, geom_input.counts()[0]);
+
+  CW::Entities entities = model.entities();
+  SU(entities.fill(geom_input));
+  EXPECT_EQ(3, entities.faces().size());
+}
+
+
+TEST(GeometryInput, add_indexed_mesh_invalid)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+
+  const std::vector<SUPoint3D> vertices{{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {1.0, 1.0, 0.0}};
+  const std::vector<uint32_t> indices{0, 1, 2};
+  const std::vector<uint32_t> out_of_range{0, 1, 3};
+  const std::vector<uint32_t> one_face{0};
+  const std::vector<uint32_t> too_short{0, 1};
+  const std::vector<uint8_t> smooth_edges{1, 1};
+  CW::IndexedMeshFaceProperties properties;
+  properties.smooth_edges = smooth_edges;
+
+  CW::GeometryInput geom_input(su_model);
+  EXPECT_THROW(geom_input.add_indexed_mesh(vertices, out_of_range, one_face), std::invalid_argument);
+  EXPECT_THROW(geom_input.add_indexed_mesh(vertices, indices, too_short), std::invalid_argument);
+  EXPECT_THROW(geom_input.add_indexed_mesh(vertices, indices, one_face, properties), std::invalid_argument);
+  // Nothing was added by the failed calls.
+  EXPECT_EQ(0, geom_input.counts()[0]);
+}
@@ -0,0 +1,45 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/model/ImageRep.hpp"
+
+
+TEST(ImageRep, read_and_write_pixels)
+{
+  CW::initialize();
+  SUImageRepRef image_ref = SU_INVALID;
+  SU(SUImageRepCreate(&image_ref));
+  CW::ImageRep image(image_ref, false);
+  std::vector<SUByte> pixels(6 * 4 * 4);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = SUByte(i);
+  }
+  image.set_data(6, 4, 32, 0, pixels);
+  ASSERT_EQ(pixels.size(), image.data_size());
+
+  // pixel_data() returns a filled vector.
+  EXPECT_EQ(pixels, image.pixel_data());
+
+  std::vector<SUByte> buffer(image.data_size());
+  image.read_pixels(buffer);
+  EXPECT_EQ(pixels, buffer);
+
+  for (SUByte& byte : buffer) {
+    byte = SUByte(255 - byte);
+  }
+  image.write_pixels(buffer);
+  EXPECT_EQ(6, image.width());
+  EXPECT_EQ(4, image.height());
+  EXPECT_EQ(buffer, image.pixel_data());
+
+  std::vector<SUByte> small(buffer.size() - 1);
+  EXPECT_THROW(image.read_pixels(small), std::invalid_argument);
+  EXPECT_THROW(image.write_pixels(small), std::invalid_argument);
+  EXPECT_THROW(image.set_data(6, 4, 32, 0, small), std::invalid_argument);
+}
@@ -0,0 +1,161 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/Instrumentation.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/Loop.hpp"
+#include "SUAPI-CppWrapper/model/Material.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+
+namespace {
+
+const CW::InstrumentationCounter* find_counter(const std::string& name) {
+  for (const CW::InstrumentationCounter* counter : CW::Instrumentation::counters()) {
+    if (name == counter->name) {
+      return counter;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace
+
+TEST(Instrumentation, counter_records_calls)
+{
+  CW::Instrumentation::reset();
+  CW::InstrumentationCounter* counter = CW::Instrumentation::counter("Test::counter_records_calls", CW::CounterKind::Method);
+  EXPECT_EQ(counter, CW::Instrumentation::counter("Test::counter_records_calls", CW::CounterKind::Method));
+  counter->record(1);
+  counter->record(1000);
+  counter->record(1500);
+  EXPECT_EQ(3, counter->calls.load());
+  EXPECT_EQ(2501, counter->total_ns.load());
+  EXPECT_EQ(1500, counter->max_ns.load());
+  EXPECT_EQ(1, counter->histogram[0].load());
+  // 1000ns falls in the bucket from 2^9 to 2^10-1, and 1500ns in the bucket from 2^10 to 2^11-1.
+  EXPECT_EQ(1, counter->histogram[9].load());
+  EXPECT_EQ(1, counter->histogram[10].load());
+  EXPECT_EQ(counter, find_counter("Test::counter_records_calls"));
+
+  CW::Instrumentation::reset();
+  EXPECT_EQ(0, counter->calls.load());
+  EXPECT_EQ(nullptr, find_counter("Test::counter_records_calls"));
+}
+
+
+TEST(Instrumentation, json_and_chrome_trace)
+{
+  CW::Instrumentation::reset();
+  CW::Instrumentation::start_trace();
+  {
+    CW::ScopedInstrumentation scope(CW::Instrumentation::counter("Test::json_and_chrome_trace", CW::CounterKind::Method));
+  }
+  CW::Instrumentation::stop_trace();
+  {
+    // Not traced, but still counted.
+    CW::ScopedInstrumentation scope(CW::Instrumentation::counter("Test::json_and_chrome_trace", CW::CounterKind::Method));
+  }
+  CW::Instrumentation::counter("Test::bytes", CW::CounterKind::Bytes)->add_bytes(42);
+
+  std::ostringstream json;
+  CW::Instrumentation::write_json(json);
+  EXPECT_NE(std::string::npos, json.str().find("{\"name\": \"Test::json_and_chrome_trace\", \"kind\": \"method\", \"calls\": 2"));
+  EXPECT_NE(std::string::npos, json.str().find("{\"name\": \"Test::bytes\", \"kind\": \"bytes\", \"calls\": 1, \"bytes\": 42}"));
+
+  std::ostringstream trace;
+  CW::Instrumentation::write_chrome_trace(trace);
+  const std::string trace_string = trace.str();
+  EXPECT_NE(std::string::npos, trace_string.find("\"name\": \"Test::json_and_chrome_trace\", \"cat\": \"method\", \"ph\": \"X\""));
+  // Only the call made while tracing is in the trace.
+  const size_t first = trace_string.find("Test::json_and_chrome_trace");
+  EXPECT_EQ(std::string::npos, trace_string.find("Test::json_and_chrome_trace", first + 1));
+  CW::Instrumentation::reset();
+}
+
+
+TEST(Instrumentation, wrapper_calls_are_counted)
+{
+  if (!CW::Instrumentation::compiled_in()) {
+    return;
+  }
+  CW::initialize();
+  std::vector<CW::Point3D> points = {CW::Point3D(0.0, 0.0, 0.0), CW::Point3D(1.0, 0.0, 0.0), CW::Point3D(1.0, 1.0, 0.0), CW::Point3D(0.0, 1.0, 0.0)};
+  CW::Face face(points);
+  CW::Instrumentation::reset();
+  std::vector<CW::Point3D> loop_points = face.outer_loop().points();
+  EXPECT_EQ(4, loop_points.size());
+
+  const CW::InstrumentationCounter* method = find_counter("CW::Loop::points");
+  ASSERT_NE(nullptr, method);
+  EXPECT_EQ(1, method->calls.load());
+  const CW::InstrumentationCounter* su_function = find_counter("SUVertexGetPosition");
+  ASSERT_NE(nullptr, su_function);
+  EXPECT_EQ(CW::CounterKind::SUFunction, su_function->kind);
+  EXPECT_EQ(4, su_function->calls.load());
+  // The method's time includes the time of the SketchUp API calls it makes.
+  EXPECT_GE(method->total_ns.load(), su_function->total_ns.load());
+}
+
+
+TEST(Instrumentation, trace_collects_events_of_every_thread)
+{
+  CW::Instrumentation::reset();
+  CW::Instrumentation::start_trace(10);
+  CW::InstrumentationCounter* counter = CW::Instrumentation::counter("Test::trace_collects_events_of_every_thread", CW::CounterKind::Method);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back([counter]() {
+      for (size_t j = 0; j < 2; ++j) {
+        CW::ScopedInstrumentation scope(counter);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  // Events past the limit are counted, but not traced.
+  for (size_t j = 0; j < 4; ++j) {
+    CW::ScopedInstrumentation scope(counter);
+  }
+  CW::Instrumentation::stop_trace();
+  EXPECT_EQ(12, counter->calls.load());
+
+  std::ostringstream trace;
+  CW::Instrumentation::write_chrome_trace(trace);
+  const std::string trace_string = trace.str();
+  size_t num_events = 0;
+  for (size_t found = trace_string.find("Test::trace_collects_events_of_every_thread"); found != std::string::npos;
+       found = trace_string.find("Test::trace_collects_events_of_every_thread", found + 1)) {
+    ++num_events;
+  }
+  EXPECT_EQ(10, num_events);
+  CW::Instrumentation::reset();
+}
+
+
+TEST(Instrumentation, material_calls_are_counted)
+{
+  if (!CW::Instrumentation::compiled_in()) {
+    return;
+  }
+  CW::initialize();
+  SUMaterialRef material_ref = SU_INVALID;
+  SU(SUMaterialCreate(&material_ref));
+  CW::Material material(material_ref, false);
+  CW::Instrumentation::reset();
+  material.name(CW::String("brick"));
+  EXPECT_EQ("brick", material.name().std_string());
+  const CW::InstrumentationCounter* set_name = find_counter("SUMaterialSetName");
+  ASSERT_NE(nullptr, set_name);
+  EXPECT_EQ(1, set_name->calls.load());
+  EXPECT_NE(nullptr, find_counter("SUMaterialGetName"));
+}
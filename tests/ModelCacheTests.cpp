@@ -0,0 +1,236 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/Transformation.hpp"
+#include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/model/ComponentInstance.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/FrozenModel.hpp"
+#include "SUAPI-CppWrapper/model/Material.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/ModelCache.hpp"
+#include "SUAPI-CppWrapper/model/TypedValue.hpp"
+
+namespace {
+
+std::string cache_path(const std::string& name) {
+  return ::testing::TempDir() + name;
+}
+
+/**
+* A model with a material, a definition holding one square face with attributes, placed twice.
+*/
+void build_model(CW::Model& model) {
+  SUMaterialRef material_ref = SU_INVALID;
+  SU(SUMaterialCreate(&material_ref));
+  std::vector<CW::Material> materials;
+  materials.emplace_back(material_ref, false);
+  materials[0].name(CW::String("Red"));
+  model.add_materials(materials);
+
+  CW::ComponentDefinition definition;
+  definition.name("Tile");
+  model.add_definition(definition);
+  std::vector<CW::Point3D> points = {CW::Point3D(0.0, 0.0, 0.0), CW::Point3D(1.0, 0.0, 0.0), CW::Point3D(1.0, 1.0, 0.0), CW::Point3D(0.0, 1.0, 0.0)};
+  CW::Face face(points);
+  CW::Face added = definition.entities().add_face(face);
+  added.material(materials[0]);
+  added.set_attribute("Tags", "kind", CW::TypedValue("floor"));
+  std::vector<CW::TypedValue> items(2);
+  items[0].double_value(0.5);
+  items[1] = CW::TypedValue("second");
+  CW::TypedValue array;
+  array.typed_value_array(items);
+  added.set_attribute("Tags", "list", array);
+
+  CW::Entities entities = model.entities();
+  entities.add_instance(definition, CW::Transformation(CW::Vector3D(10.0, 0.0, 0.0)));
+  CW::ComponentInstance second = entities.add_instance(definition, CW::Transformation(CW::Vector3D(20.0, 0.0, 0.0)));
+  second.name(CW::String("second"));
+  CW::TypedValue id;
+  id.int32_value(42);
+  model.set_attribute("Project", "id", id);
+}
+
+} // namespace
+
+
+TEST(ModelCache, round_trip)
+{
+  CW::initialize();
+  CW::Model model;
+  build_model(model);
+  CW::FrozenModelPtr frozen = model.freeze();
+  const std::string path = cache_path("round_trip.cwcache");
+  ASSERT_TRUE(CW::ModelCache::write(*frozen, 1234, path));
+
+  CW::ModelCachePtr cache = CW::ModelCache::open(path, 1234);
+  ASSERT_NE(nullptr, cache);
+  EXPECT_EQ(1234, cache->source_hash());
+  ASSERT_EQ(frozen->definitions().size(), cache->definitions().size());
+  ASSERT_EQ(frozen->instances().size(), cache->instances().size());
+  ASSERT_EQ(frozen->vertices().size(), cache->vertices().size());
+  EXPECT_EQ(frozen->num_strings(), cache->num_strings());
+
+  const CW::ModelCache::Index tile = cache->find_definition("Tile");
+  ASSERT_EQ(frozen->find_definition("Tile"), tile);
+  const CW::ModelCache::Definition& definition = cache->definitions()[tile];
+  const CW::ModelCache::Definition& root = cache->definitions()[CW::ModelCache::ROOT];
+  ASSERT_EQ(2, root.instances.size());
+  const CW::ModelCache::Instance& second = cache->instances(root.instances)[1];
+  EXPECT_EQ(tile, second.definition);
+  EXPECT_EQ("second", cache->string(second.name).str());
+  EXPECT_DOUBLE_EQ(20.0, second.transformation.translation().x);
+
+  // The square face is stored with its loop, and as two triangles over the definition's vertices.
+  ASSERT_EQ(1, definition.faces.size());
+  const CW::ModelCache::Face& face = cache->faces(definition.faces)[0];
+  EXPECT_EQ(cache->find_material("Red"), face.front_material);
+  EXPECT_EQ(4, cache->loop_vertices(cache->loops(face.loops)[0]).size());
+  const CW::Span<const CW::ModelCache::Index> triangles = cache->triangles(definition.faces);
+  ASSERT_EQ(6, triangles.size());
+  double area = 0.0;
+  for (size_t i = 0; i < triangles.size(); i += 3) {
+    const SUPoint3D& a = cache->vertices()[triangles[i]];
+    const SUPoint3D& b = cache->vertices()[triangles[i + 1]];
+    const SUPoint3D& c = cache->vertices()[triangles[i + 2]];
+    area += 0.5 * std::abs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+  }
+  EXPECT_DOUBLE_EQ(1.0, area);
+
+  EXPECT_EQ("floor", cache->attribute(face.attributes, "Tags", "kind").string_value());
+  const CW::AttributeValue list = cache->attribute(face.attributes, "Tags", "list");
+  ASSERT_EQ(SUTypedValueType_Array, list.get_type());
+  ASSERT_EQ(2, list.array_value().size());
+  EXPECT_DOUBLE_EQ(0.5, list.array_value()[0].double_value());
+  EXPECT_EQ("second", list.array_value()[1].string_value());
+  EXPECT_TRUE(cache->attribute(face.attributes, "Tags", "missing").empty());
+  EXPECT_EQ(42, cache->attribute(cache->model_attributes(), "Project", "id").int32_value());
+
+  cache.reset();
+  std::remove(path.c_str());
+}
+
+
+TEST(ModelCache, rejects_stale_and_foreign_files)
+{
+  CW::initialize();
+  CW::Model model;
+  build_model(model);
+  const std::string path = cache_path("stale.cwcache");
+  ASSERT_TRUE(CW::ModelCache::write(*model.freeze(), 1234, path));
+  EXPECT_EQ(nullptr, CW::ModelCache::open(path, 4321));
+  EXPECT_EQ(nullptr, CW::ModelCache::open(cache_path("missing.cwcache"), 1234));
+
+  // A file written with another version is refused.
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(8);
+    const uint32_t version = CW::ModelCache::VERSION + 1;
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  }
+  EXPECT_EQ(nullptr, CW::ModelCache::open(path, 1234));
+
+  // So is a file cut short.
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "CWMCACHE";
+  }
+  EXPECT_EQ(nullptr, CW::ModelCache::open(path, 1234));
+  std::remove(path.c_str());
+}
+
+
+TEST(ModelCache, rejects_ranges_outside_sections)
+{
+  CW::initialize();
+  CW::Model model;
+  build_model(model);
+  const std::string path = cache_path("corrupt.cwcache");
+  // The header starts with the magic, version, byte order, key and file size, then the model's attribute range and the section table.
+  const std::streamoff model_attributes_offset = 32;
+  const std::streamoff definitions_offset = 56;
+  const uint32_t past_end = 1000000;
+
+  ASSERT_TRUE(CW::ModelCache::write(*model.freeze(), 1234, path));
+  ASSERT_NE(nullptr, CW::ModelCache::open(path, 1234));
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(model_attributes_offset + std::streamoff(sizeof(CW::ModelCache::Index)));
+    file.write(reinterpret_cast<const char*>(&past_end), sizeof(past_end));
+  }
+  EXPECT_EQ(nullptr, CW::ModelCache::open(path, 1234));
+
+  ASSERT_TRUE(CW::ModelCache::write(*model.freeze(), 1234, path));
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    uint64_t definitions = 0;
+    file.seekg(definitions_offset);
+    file.read(reinterpret_cast<char*>(&definitions), sizeof(definitions));
+    file.seekp(static_cast<std::streamoff>(definitions + offsetof(CW::ModelCache::Definition, faces) + sizeof(CW::ModelCache::Index)));
+    file.write(reinterpret_cast<const char*>(&past_end), sizeof(past_end));
+  }
+  EXPECT_EQ(nullptr, CW::ModelCache::open(path, 1234));
+  std::remove(path.c_str());
+}
+
+
+TEST(ModelCache, concurrent_writers_do_not_share_a_temporary_file)
+{
+  CW::initialize();
+  CW::Model model;
+  build_model(model);
+  const std::shared_ptr<const CW::FrozenModel> frozen = model.freeze();
+  const std::string path = cache_path("concurrent.cwcache");
+  std::vector<char> written(4, false);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < written.size(); ++i) {
+    threads.emplace_back([&frozen, &path, &written, i]() {
+      for (size_t j = 0; j < 10; ++j) {
+        if (!CW::ModelCache::write(*frozen, 1234, path)) {
+          return;
+        }
+      }
+      written[i] = true;
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (char thread_written : written) {
+    EXPECT_TRUE(thread_written);
+  }
+  std::shared_ptr<const CW::ModelCache> cache = CW::ModelCache::open(path, 1234);
+  ASSERT_NE(nullptr, cache);
+  EXPECT_EQ(frozen->definitions().size(), cache->definitions().size());
+  std::remove(path.c_str());
+}
+
+TEST(ModelCache, hash_file)
+{
+  const std::string first = cache_path("first.skp");
+  const std::string second = cache_path("second.skp");
+  {
+    std::ofstream(first, std::ios::binary) << "model contents";
+    std::ofstream(second, std::ios::binary) << "model contents!";
+  }
+  EXPECT_EQ(CW::ModelCache::hash_file(first), CW::ModelCache::hash_file(first));
+  EXPECT_NE(CW::ModelCache::hash_file(first), CW::ModelCache::hash_file(second));
+  EXPECT_THROW(CW::ModelCache::hash_file(cache_path("missing.skp")), std::invalid_argument);
+  std::remove(first.c_str());
+  std::remove(second.c_str());
+}
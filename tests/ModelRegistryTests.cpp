@@ -0,0 +1,156 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/ModelRegistry.hpp"
+#include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/model/Layer.hpp"
+#include "SUAPI-CppWrapper/model/Material.hpp"
+
+
+namespace {
+
+std::vector<CW::Material> add_materials(CW::Model& model, size_t count) {
+  std::vector<CW::Material> materials;
+  materials.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    SUMaterialRef material_ref = SU_INVALID;
+    SU(SUMaterialCreate(&material_ref));
+    materials.emplace_back(material_ref, false);
+    materials.back().name(CW::String("Material " + std::to_string(i)));
+  }
+  model.add_materials(materials);
+  return materials;
+}
+
+} // namespace
+
+
+TEST(ModelRegistry, finds_materials_by_ref_and_name)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  std::vector<CW::Material> materials = add_materials(model, 50);
+
+  std::shared_ptr<CW::ModelRegistry> registry = model.registry();
+  EXPECT_EQ(registry, CW::ModelRegistry::get(su_model));
+  EXPECT_EQ(50, registry->num_materials());
+  for (const CW::Material& material : materials) {
+    EXPECT_TRUE(model.material_exists(material));
+  }
+  CW::Material found = registry->material("Material 17");
+  ASSERT_FALSE(!found);
+  EXPECT_EQ(materials[17], found);
+  EXPECT_TRUE(!registry->material("Material 50"));
+  EXPECT_FALSE(model.material_exists(CW::Material()));
+
+  SUMaterialRef other_ref = SU_INVALID;
+  SU(SUMaterialCreate(&other_ref));
+  CW::Material other(other_ref, false);
+  EXPECT_FALSE(model.material_exists(other));
+}
+
+
+TEST(ModelRegistry, rebuilds_only_after_wrapper_edits)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  std::vector<CW::Material> materials = add_materials(model, 10);
+
+  std::shared_ptr<CW::ModelRegistry> registry = model.registry();
+  const size_t rebuilds_before = registry->rebuilds();
+  for (int repeat = 0; repeat < 100; ++repeat) {
+    // Temporary Model objects share the registry of the SUModelRef they wrap.
+    EXPECT_TRUE(CW::Model(su_model, false).material_exists(materials[repeat % 10]));
+  }
+  EXPECT_EQ(rebuilds_before + 1, registry->rebuilds());
+
+  std::vector<CW::Material> more = add_materials(model, 5);
+  EXPECT_TRUE(model.material_exists(more[4]));
+  EXPECT_EQ(15, registry->num_materials());
+  EXPECT_EQ(rebuilds_before + 2, registry->rebuilds());
+
+  materials[3].name(CW::String("Renamed"));
+  EXPECT_EQ(materials[3], registry->material("Renamed"));
+  EXPECT_TRUE(!registry->material("Material 3"));
+}
+
+
+TEST(ModelRegistry, finds_layers_and_definitions)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+
+  SULayerRef layer_ref = SU_INVALID;
+  SU(SULayerCreate(&layer_ref));
+  std::vector<CW::Layer> layers;
+  layers.emplace_back(layer_ref, false);
+  layers[0].name(std::string("Walls"));
+  model.add_layers(layers);
+  EXPECT_TRUE(model.layer_exists(layers[0]));
+  EXPECT_EQ(layers[0], model.registry()->layer("Walls"));
+  EXPECT_TRUE(model.layer_exists(model.active_layer()));
+
+  CW::ComponentDefinition definition;
+  definition.name(CW::String("Chair"));
+  model.add_definition(definition);
+  EXPECT_TRUE(model.registry()->contains(definition));
+  EXPECT_EQ(definition, model.registry()->definition("Chair"));
+  EXPECT_EQ(1, model.registry()->num_definitions());
+}
+
+
+TEST(ModelRegistry, sees_edits_made_through_the_c_api)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  std::vector<CW::Material> materials = add_materials(model, 3);
+  std::shared_ptr<CW::ModelRegistry> registry = model.registry();
+  EXPECT_EQ(materials[1], registry->material("Material 1"));
+
+  // A rename that the wrapper does not know about is caught when the object is found.
+  SU(SUMaterialSetName(materials[1].ref(), "Renamed"));
+  EXPECT_TRUE(!registry->material("Material 1"));
+  EXPECT_EQ(materials[1], registry->material("Renamed"));
+
+  // So is an object added without going through Model::add_materials().
+  SUMaterialRef added_ref = SU_INVALID;
+  SU(SUMaterialCreate(&added_ref));
+  SU(SUMaterialSetName(added_ref, "Added"));
+  SU(SUModelAddMaterials(su_model, 1, &added_ref));
+  EXPECT_EQ(4, registry->num_materials());
+  EXPECT_TRUE(model.material_exists(CW::Material(added_ref)));
+  EXPECT_EQ(added_ref.ptr, registry->material("Added").ref().ptr);
+}
+
+
+TEST(ModelRegistry, held_registry_outlives_its_model)
+{
+  CW::initialize();
+  std::shared_ptr<CW::ModelRegistry> registry;
+  {
+    CW::Model model;
+    add_materials(model, 2);
+    registry = model.registry();
+    EXPECT_EQ(2, registry->num_materials());
+  }
+  // The model has been released, so the registry it held is detached and finds nothing.
+  EXPECT_EQ(0, registry->num_materials());
+  EXPECT_TRUE(!registry->material("Material 0"));
+}
@@ -0,0 +1,100 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Transformation.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/Group.hpp"
+#include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/model/ComponentInstance.hpp"
+#include "SUAPI-CppWrapper/model/ModelWalker.hpp"
+
+
+TEST(ModelWalker, visits_definitions_once_and_every_placement)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::Entities entities = model.entities();
+
+  // A component definition placed three times, and a group.
+  CW::ComponentDefinition definition;
+  model.add_definition(definition);
+  std::vector<CW::Point3D> points = {
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(1.0, 0.0, 0.0),
+    CW::Point3D(1.0, 1.0, 0.0)
+  };
+  CW::Face face(points);
+  definition.entities().add_face(face);
+  for (size_t i = 0; i < 3; ++i) {
+    entities.add_instance(definition, CW::Transformation(CW::Vector3D(double(i) * 10.0, 0.0, 0.0)));
+  }
+  entities.add_group();
+
+  CW::ModelWalker walker(model, 4);
+  ASSERT_EQ(3, walker.num_definitions());
+  ASSERT_EQ(4, walker.num_threads());
+
+  std::atomic<size_t> num_definitions(0);
+  std::atomic<size_t> num_model_entities(0);
+  std::atomic<size_t> num_placements(0);
+  std::atomic<size_t> num_root_placements(0);
+  std::mutex origins_mutex;
+  std::vector<double> instance_origins;
+  walker.walk(
+    [&num_definitions, &num_model_entities](const CW::Entities&, const CW::ComponentDefinition* definition) {
+      ++num_definitions;
+      if (definition == nullptr) {
+        ++num_model_entities;
+      }
+    },
+    [&](const CW::ModelWalker::Placement& placement) {
+      ++num_placements;
+      if (!placement.has_definition()) {
+        ++num_root_placements;
+        EXPECT_TRUE(placement.instances.empty());
+        EXPECT_THROW(placement.definition(), std::logic_error);
+        // Copying the model's placement must not create a definition.
+        CW::ModelWalker::Placement copy = placement;
+        EXPECT_TRUE(SUIsInvalid(copy.definition_ref));
+        return;
+      }
+      if (placement.instances.size() == 1 && placement.definition().ref().ptr == definition.ref().ptr) {
+        std::lock_guard<std::mutex> lock(origins_mutex);
+        instance_origins.push_back(placement.transformation.translation().x);
+      }
+    });
+  ASSERT_EQ(3, num_definitions.load());
+  ASSERT_EQ(1, num_model_entities.load());
+  ASSERT_EQ(5, num_placements.load());
+  ASSERT_EQ(1, num_root_placements.load());
+  std::sort(instance_origins.begin(), instance_origins.end());
+  ASSERT_EQ(3, instance_origins.size());
+  ASSERT_DOUBLE_EQ(0.0, instance_origins[0]);
+  ASSERT_DOUBLE_EQ(20.0, instance_origins[2]);
+}
+
+TEST(ModelWalker, rethrows_visitor_exception)
+{
+  CW::initialize();
+  SUModelRef su_model = SU_INVALID;
+  SU(SUModelCreate(&su_model));
+  CW::Model model(su_model);
+  CW::ModelWalker walker(model, 2);
+  ASSERT_THROW(walker.walk(nullptr, [](const CW::ModelWalker::Placement&) {
+    throw std::runtime_error("visitor failed");
+  }), std::runtime_error);
+}
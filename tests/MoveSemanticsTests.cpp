@@ -0,0 +1,220 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/AttributeDictionary.hpp"
+#include "SUAPI-CppWrapper/model/ComponentDefinition.hpp"
+#include "SUAPI-CppWrapper/model/ComponentInstance.hpp"
+#include "SUAPI-CppWrapper/model/Edge.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/GeometryInput.hpp"
+#include "SUAPI-CppWrapper/model/ImageRep.hpp"
+#include "SUAPI-CppWrapper/model/InstancePath.hpp"
+#include "SUAPI-CppWrapper/model/Layer.hpp"
+#include "SUAPI-CppWrapper/model/Loop.hpp"
+#include "SUAPI-CppWrapper/model/Material.hpp"
+#include "SUAPI-CppWrapper/model/TypedValue.hpp"
+
+// std::vector only moves its elements when it grows if the move constructor cannot throw.
+static_assert(std::is_nothrow_move_constructible<CW::Face>::value, "CW::Face must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::Edge>::value, "CW::Edge must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::Material>::value, "CW::Material must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::Layer>::value, "CW::Layer must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::ComponentDefinition>::value, "CW::ComponentDefinition must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::ComponentInstance>::value, "CW::ComponentInstance must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::AttributeDictionary>::value, "CW::AttributeDictionary must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::TypedValue>::value, "CW::TypedValue must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::String>::value, "CW::String must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::ImageRep>::value, "CW::ImageRep must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::InstancePath>::value, "CW::InstancePath must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<CW::GeometryInput>::value, "CW::GeometryInput must be nothrow movable");
+static_assert(std::is_nothrow_move_assignable<CW::Face>::value, "CW::Face must be nothrow move assignable");
+static_assert(std::is_nothrow_move_assignable<CW::String>::value, "CW::String must be nothrow move assignable");
+
+namespace {
+
+std::vector<CW::Point3D> square(double offset) {
+  return {CW::Point3D(offset, 0.0, 0.0), CW::Point3D(offset + 1.0, 0.0, 0.0), CW::Point3D(offset + 1.0, 1.0, 0.0), CW::Point3D(offset, 1.0, 0.0)};
+}
+
+} // namespace
+
+/**
+* Copying an unattached object creates a new SketchUp object, so a move that keeps the same reference shows no copy was made.
+*/
+TEST(MoveSemantics, face_moves_reference)
+{
+  CW::initialize();
+  std::vector<CW::Point3D> points = square(0.0);
+  CW::Face face(points);
+  const SUFaceRef face_ref = face.ref();
+
+  CW::Face moved(std::move(face));
+  EXPECT_EQ(face_ref.ptr, moved.ref().ptr);
+  EXPECT_FALSE(moved.attached());
+  EXPECT_TRUE(!face);
+
+  CW::Face assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(face_ref.ptr, assigned.ref().ptr);
+  EXPECT_TRUE(!moved);
+  EXPECT_EQ(4, assigned.outer_loop().points().size());
+}
+
+
+TEST(MoveSemantics, vector_growth_keeps_unattached_faces)
+{
+  CW::initialize();
+  std::vector<CW::Face> faces;
+  std::vector<void*> face_refs;
+  for (size_t i = 0; i < 64; ++i) {
+    std::vector<CW::Point3D> points = square(double(i) * 2.0);
+    faces.push_back(CW::Face(points));
+    face_refs.push_back(faces.back().ref().ptr);
+  }
+  // Growing the vector moves every face, so each keeps its original SUFaceRef.
+  faces.reserve(faces.capacity() * 2);
+  for (size_t i = 0; i < faces.size(); ++i) {
+    EXPECT_EQ(face_refs[i], faces[i].ref().ptr);
+  }
+}
+
+
+TEST(MoveSemantics, edge_and_material_move_reference)
+{
+  CW::initialize();
+  CW::Edge edge(CW::Point3D(0.0, 0.0, 0.0), CW::Point3D(1.0, 0.0, 0.0));
+  const void* edge_ref = edge.ref().ptr;
+  CW::Edge moved_edge(std::move(edge));
+  EXPECT_EQ(edge_ref, moved_edge.ref().ptr);
+  EXPECT_TRUE(!edge);
+
+  SUMaterialRef material_ref = SU_INVALID;
+  SU(SUMaterialCreate(&material_ref));
+  CW::Material material(material_ref, false);
+  CW::Material moved_material(std::move(material));
+  EXPECT_EQ(material_ref.ptr, moved_material.ref().ptr);
+  EXPECT_FALSE(moved_material.attached());
+  EXPECT_TRUE(!material);
+
+  // Move assigning releases the material that was held before.
+  SUMaterialRef other_ref = SU_INVALID;
+  SU(SUMaterialCreate(&other_ref));
+  CW::Material other(other_ref, false);
+  other = std::move(moved_material);
+  EXPECT_EQ(material_ref.ptr, other.ref().ptr);
+}
+
+
+TEST(MoveSemantics, string_and_typed_value_move_reference)
+{
+  CW::initialize();
+  CW::String string("A string that would otherwise be copied");
+  const SUStringRef string_ref = string.ref();
+  const size_t size = string.size();
+  CW::String moved(std::move(string));
+  EXPECT_EQ(string_ref.ptr, moved.ref().ptr);
+  EXPECT_EQ(size, moved.size());
+  EXPECT_TRUE(SUIsInvalid(string.ref()));
+
+  CW::String assigned("Replaced");
+  assigned = std::move(moved);
+  EXPECT_EQ(string_ref.ptr, assigned.ref().ptr);
+  EXPECT_EQ("A string that would otherwise be copied", assigned.std_string());
+
+  CW::TypedValue value("value");
+  const SUTypedValueRef value_ref = value.ref();
+  CW::TypedValue moved_value(std::move(value));
+  EXPECT_EQ(value_ref.ptr, moved_value.ref().ptr);
+  EXPECT_EQ("value", moved_value.string_value().std_string());
+  EXPECT_TRUE(!value);
+}
+
+
+TEST(MoveSemantics, image_rep_and_instance_path_move_reference)
+{
+  CW::initialize();
+  SUImageRepRef image_ref = SU_INVALID;
+  SU(SUImageRepCreate(&image_ref));
+  CW::ImageRep image(image_ref, false);
+  CW::ImageRep moved_image(std::move(image));
+  EXPECT_EQ(image_ref.ptr, moved_image.ref().ptr);
+  EXPECT_TRUE(!image);
+
+  CW::InstancePath path;
+  const SUInstancePathRef path_ref = path.ref();
+  CW::InstancePath moved_path(std::move(path));
+  EXPECT_EQ(path_ref.ptr, moved_path.ref().ptr);
+  CW::InstancePath assigned_path;
+  assigned_path = std::move(moved_path);
+  EXPECT_EQ(path_ref.ptr, assigned_path.ref().ptr);
+}
+
+
+/**
+* A move hands the reference over, so no reference is acquired or released, except the one a move assignment replaces.
+*/
+TEST(MoveSemantics, moves_keep_live_reference_counts)
+{
+  CW::initialize();
+  std::vector<CW::Point3D> points = square(0.0);
+  CW::Face face(points);
+  const int64_t faces = CW::RefTracker::live(CW::RefKind::Face);
+  CW::Face moved_face(std::move(face));
+  EXPECT_EQ(faces, CW::RefTracker::live(CW::RefKind::Face));
+  CW::Face assigned_face;
+  const int64_t faces_before_assign = CW::RefTracker::live(CW::RefKind::Face);
+  assigned_face = std::move(moved_face);
+  EXPECT_EQ(faces_before_assign, CW::RefTracker::live(CW::RefKind::Face));
+
+  CW::String string("moved");
+  const int64_t strings = CW::RefTracker::live(CW::RefKind::String);
+  CW::String moved_string(std::move(string));
+  EXPECT_EQ(strings, CW::RefTracker::live(CW::RefKind::String));
+  CW::String assigned_string("replaced");
+  EXPECT_EQ(strings + 1, CW::RefTracker::live(CW::RefKind::String));
+  assigned_string = std::move(moved_string);
+  // Only the replaced string is released.
+  EXPECT_EQ(strings, CW::RefTracker::live(CW::RefKind::String));
+
+  CW::TypedValue value("moved");
+  const int64_t typed_values = CW::RefTracker::live(CW::RefKind::TypedValue);
+  CW::TypedValue moved_value(std::move(value));
+  EXPECT_EQ(typed_values, CW::RefTracker::live(CW::RefKind::TypedValue));
+
+  SUMaterialRef material_ref = SU_INVALID;
+  SU(SUMaterialCreate(&material_ref));
+  CW::Material material(material_ref, false);
+  SUMaterialRef other_ref = SU_INVALID;
+  SU(SUMaterialCreate(&other_ref));
+  CW::Material other(other_ref, false);
+  const int64_t materials = CW::RefTracker::live(CW::RefKind::Material);
+  CW::Material moved_material(std::move(material));
+  EXPECT_EQ(materials, CW::RefTracker::live(CW::RefKind::Material));
+  other = std::move(moved_material);
+  EXPECT_EQ(materials - 1, CW::RefTracker::live(CW::RefKind::Material));
+
+  SUImageRepRef image_ref = SU_INVALID;
+  SU(SUImageRepCreate(&image_ref));
+  CW::ImageRep image(image_ref, false);
+  const int64_t images = CW::RefTracker::live(CW::RefKind::ImageRep);
+  CW::ImageRep moved_image(std::move(image));
+  EXPECT_EQ(images, CW::RefTracker::live(CW::RefKind::ImageRep));
+
+  CW::InstancePath path;
+  const int64_t paths = CW::RefTracker::live(CW::RefKind::InstancePath);
+  CW::InstancePath moved_path(std::move(path));
+  EXPECT_EQ(paths, CW::RefTracker::live(CW::RefKind::InstancePath));
+  CW::InstancePath assigned_path;
+  EXPECT_EQ(paths + 1, CW::RefTracker::live(CW::RefKind::InstancePath));
+  assigned_path = std::move(moved_path);
+  EXPECT_EQ(paths, CW::RefTracker::live(CW::RefKind::InstancePath));
+}
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "SUAPI-CppWrapper/PixelConversion.hpp"
+
+
+namespace {
+
+std::vector<SUByte> make_bytes(size_t count) {
+  std::vector<SUByte> bytes(count);
+  for (size_t i = 0; i < count; ++i) {
+    bytes[i] = static_cast<SUByte>((i * 37 + 11) ^ (i >> 3));
+  }
+  return bytes;
+}
+
+} // namespace
+
+
+TEST(PixelConversion, bgra_to_rgba_swaps_red_and_blue)
+{
+  // Odd sizes exercise the scalar tail after the vector loop.
+  for (size_t num_pixels : {0, 1, 3, 4, 7, 8, 9, 31, 100}) {
+    const std::vector<SUByte> in = make_bytes(num_pixels * 4);
+    std::vector<SUByte> out(in.size());
+    CW::bgra_to_rgba(in, out);
+    for (size_t i = 0; i < num_pixels; ++i) {
+      EXPECT_EQ(in[i * 4 + 2], out[i * 4 + 0]);
+      EXPECT_EQ(in[i * 4 + 1], out[i * 4 + 1]);
+      EXPECT_EQ(in[i * 4 + 0], out[i * 4 + 2]);
+      EXPECT_EQ(in[i * 4 + 3], out[i * 4 + 3]);
+    }
+    // Swapping again in place restores the original.
+    CW::bgra_to_rgba(out, out);
+    EXPECT_EQ(in, out);
+  }
+}
+
+
+TEST(PixelConversion, expands_24_to_32_bits)
+{
+  for (size_t num_pixels : {0, 1, 5, 6, 9, 10, 17, 33, 100}) {
+    const std::vector<SUByte> in = make_bytes(num_pixels * 3);
+    std::vector<SUByte> bgra(num_pixels * 4);
+    std::vector<SUByte> rgba(num_pixels * 4);
+    CW::bgr_to_bgra(in, bgra, 200);
+    CW::bgr_to_rgba(in, rgba);
+    for (size_t i = 0; i < num_pixels; ++i) {
+      EXPECT_EQ(in[i * 3 + 0], bgra[i * 4 + 0]);
+      EXPECT_EQ(in[i * 3 + 1], bgra[i * 4 + 1]);
+      EXPECT_EQ(in[i * 3 + 2], bgra[i * 4 + 2]);
+      EXPECT_EQ(200, bgra[i * 4 + 3]);
+      EXPECT_EQ(in[i * 3 + 2], rgba[i * 4 + 0]);
+      EXPECT_EQ(in[i * 3 + 1], rgba[i * 4 + 1]);
+      EXPECT_EQ(in[i * 3 + 0], rgba[i * 4 + 2]);
+      EXPECT_EQ(255, rgba[i * 4 + 3]);
+    }
+  }
+}
+
+
+TEST(PixelConversion, premultiply_alpha_rounds_exactly)
+{
+  // Every channel value against every alpha value.
+  std::vector<SUByte> pixels;
+  for (unsigned alpha = 0; alpha < 256; ++alpha) {
+    for (unsigned value = 0; value < 256; ++value) {
+      pixels.push_back(SUByte(value));
+      pixels.push_back(SUByte(255 - value));
+      pixels.push_back(SUByte(value ^ 0x5A));
+      pixels.push_back(SUByte(alpha));
+    }
+  }
+  pixels.resize(pixels.size() - 4 * 3); // leave a tail for the scalar loop
+  const std::vector<SUByte> original = pixels;
+  CW::premultiply_alpha(pixels);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    const unsigned alpha = original[i | 3];
+    if ((i & 3) == 3) {
+      EXPECT_EQ(original[i], pixels[i]);
+    }
+    else {
+      const unsigned expected = (original[i] * alpha * 2 + 255) / 510;
+      ASSERT_EQ(expected, pixels[i]) << "value " << unsigned(original[i]) << " alpha " << alpha;
+    }
+  }
+}
+
+
+TEST(PixelConversion, strip_row_padding)
+{
+  const size_t width = 5;
+  const size_t height = 3;
+  const size_t padding = 3;
+  std::vector<SUByte> padded = make_bytes((width * 3 + padding) * height);
+  std::vector<SUByte> out(width * 3 * height);
+  CW::strip_row_padding(padded, out, width, height, 3, padding);
+  for (size_t row = 0; row < height; ++row) {
+    for (size_t byte = 0; byte < width * 3; ++byte) {
+      EXPECT_EQ(padded[row * (width * 3 + padding) + byte], out[row * width * 3 + byte]);
+    }
+  }
+  // In place gives the same result.
+  CW::strip_row_padding(padded, padded, width, height, 3, padding);
+  EXPECT_TRUE(std::equal(out.begin(), out.end(), padded.begin()));
+}
+
+
+TEST(PixelConversion, rejects_mismatched_sizes)
+{
+  std::vector<SUByte> in(12);
+  std::vector<SUByte> small(8);
+  EXPECT_THROW(CW::bgra_to_rgba(in, small), std::invalid_argument);
+  EXPECT_THROW(CW::bgr_to_rgba(in, small), std::invalid_argument);
+  EXPECT_THROW(CW::premultiply_alpha(CW::Span<SUByte>(in.data(), 10)), std::invalid_argument);
+  EXPECT_THROW(CW::strip_row_padding(in, small, 2, 2, 3, 0), std::invalid_argument);
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+
+
+TEST(Point3D, SameSizeAsSUPoint3D)
+{
+  ASSERT_EQ(sizeof(SUPoint3D), sizeof(CW::Point3D));
+  ASSERT_EQ(sizeof(SUVector3D), sizeof(CW::Vector3D));
+  ASSERT_EQ(sizeof(SUPlane3D), sizeof(CW::Plane3D));
+}
+
+TEST(Point3D, NullPoint)
+{
+  CW::Point3D point;
+  ASSERT_TRUE(!point);
+  CW::Point3D null_point(false);
+  ASSERT_TRUE(!null_point);
+  CW::Point3D zero_point(true);
+  ASSERT_FALSE(!zero_point);
+  ASSERT_DOUBLE_EQ(0.0, zero_point.x);
+}
+
+TEST(Point3D, CopyKeepsNull)
+{
+  CW::Point3D null_point(false);
+  CW::Point3D copy = null_point;
+  ASSERT_TRUE(!copy);
+  ASSERT_TRUE(copy == null_point);
+  CW::Vector3D vector(null_point);
+  ASSERT_TRUE(!vector);
+}
+
+TEST(Point3D, MemcpyToSUPoint3D)
+{
+  std::vector<CW::Point3D> points = {
+    CW::Point3D(1.0, 2.0, 3.0),
+    CW::Point3D(4.0, 5.0, 6.0)
+  };
+  std::vector<SUPoint3D> su_points(points.size());
+  std::memcpy(su_points.data(), points.data(), points.size() * sizeof(SUPoint3D));
+  ASSERT_DOUBLE_EQ(3.0, su_points[0].z);
+  ASSERT_DOUBLE_EQ(4.0, su_points[1].x);
+  const SUPoint3D* su_point = points[1];
+  ASSERT_DOUBLE_EQ(5.0, su_point->y);
+}
+
+TEST(Point3D, Arithmetic)
+{
+  CW::Point3D point(1.0, 2.0, 3.0);
+  CW::Vector3D vector(1.0, 1.0, 1.0);
+  ASSERT_TRUE(CW::Point3D(2.0, 3.0, 4.0) == point + vector);
+  ASSERT_TRUE(CW::Vector3D(0.0, 1.0, 2.0) == point - CW::Point3D(1.0, 1.0, 1.0));
+  ASSERT_TRUE(CW::Point3D(2.0, 4.0, 6.0) == point * 2.0);
+}
+
+TEST(Plane3D, NullPlane)
+{
+  CW::Plane3D plane;
+  ASSERT_TRUE(!plane);
+  CW::Plane3D null_plane(false);
+  ASSERT_TRUE(!null_plane);
+  CW::Plane3D valid_plane(true);
+  ASSERT_FALSE(!valid_plane);
+  ASSERT_FALSE(!CW::Plane3D(0.0, 0.0, 1.0, -5.0));
+}
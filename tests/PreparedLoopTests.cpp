@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/model/Loop.hpp"
+#include "SUAPI-CppWrapper/model/PreparedLoop.hpp"
+
+
+namespace {
+
+/**
+* Returns a comb shaped loop on the plane z = height, with the given number of teeth along the x axis.
+*/
+std::vector<CW::Point3D> comb(size_t num_teeth, double height = 0.0) {
+  std::vector<CW::Point3D> points;
+  points.push_back(CW::Point3D(0.0, 0.0, height));
+  points.push_back(CW::Point3D(2.0 * num_teeth, 0.0, height));
+  for (size_t i = num_teeth; i-- > 0;) {
+    points.push_back(CW::Point3D(2.0 * i + 2.0, 10.0, height));
+    points.push_back(CW::Point3D(2.0 * i + 1.0, 10.0, height));
+    points.push_back(CW::Point3D(2.0 * i + 1.0, 2.0, height));
+    points.push_back(CW::Point3D(2.0 * i, 2.0, height));
+  }
+  return points;
+}
+
+} // namespace
+
+
+TEST(PreparedLoop, square)
+{
+  std::vector<CW::Point3D> points = {
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(10.0, 0.0, 0.0),
+    CW::Point3D(10.0, 10.0, 0.0),
+    CW::Point3D(0.0, 10.0, 0.0)
+  };
+  CW::PreparedLoop loop(points);
+  ASSERT_FALSE(loop.indexed());
+  ASSERT_EQ(4, loop.size());
+  ASSERT_EQ(CW::PointLoopClassify::PointInside, loop.classify_point(CW::Point3D(5.0, 5.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOutside, loop.classify_point(CW::Point3D(15.0, 5.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOnVertex, loop.classify_point(CW::Point3D(10.0, 10.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOnEdge, loop.classify_point(CW::Point3D(10.0, 5.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointNotOnPlane, loop.classify_point(CW::Point3D(5.0, 5.0, 1.0)));
+}
+
+TEST(PreparedLoop, indexed_comb)
+{
+  CW::PreparedLoop loop(comb(50));
+  ASSERT_TRUE(loop.indexed());
+  // Between the teeth.
+  ASSERT_EQ(CW::PointLoopClassify::PointInside, loop.classify_point(CW::Point3D(1.5, 5.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOutside, loop.classify_point(CW::Point3D(2.5, 5.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointInside, loop.classify_point(CW::Point3D(51.0, 1.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOutside, loop.classify_point(CW::Point3D(-1.0, 1.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOutside, loop.classify_point(CW::Point3D(50.0, 11.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOnVertex, loop.classify_point(CW::Point3D(41.0, 2.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOnEdge, loop.classify_point(CW::Point3D(41.0, 4.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOnEdge, loop.classify_point(CW::Point3D(40.5, 2.0, 0.0)));
+  ASSERT_EQ(CW::PointLoopClassify::PointOnEdge, loop.classify_point(CW::Point3D(60.0, 0.0, 0.0)));
+}
+
+TEST(PreparedLoop, matches_loop_classify_point)
+{
+  // A comb turned onto a vertical plane.
+  std::vector<CW::Point3D> points;
+  for (const CW::Point3D& point : comb(20, 3.0)) {
+    points.push_back(CW::Point3D(point.x, point.z, point.y));
+  }
+  CW::PreparedLoop loop(points);
+  ASSERT_TRUE(loop.indexed());
+  for (double x = -1.25; x < 42.0; x += 0.5) {
+    for (double z = -1.25; z < 12.0; z += 0.5) {
+      CW::Point3D point(x, 3.0, z);
+      ASSERT_EQ(CW::Loop::classify_point(points, point), loop.classify_point(point));
+    }
+  }
+}
+
+TEST(PreparedLoop, invalid_loops)
+{
+  std::vector<CW::Point3D> points = {
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(10.0, 0.0, 0.0),
+    CW::Point3D(10.0, 0.0, 0.0)
+  };
+  ASSERT_THROW(CW::PreparedLoop loop(points), std::invalid_argument);
+  points.push_back(CW::Point3D(10.0, 10.0, 0.0));
+  CW::PreparedLoop loop(points);
+  ASSERT_EQ(3, loop.size());
+  ASSERT_THROW(loop.classify_point(CW::Point3D(false)), std::invalid_argument);
+}
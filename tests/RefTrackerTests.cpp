@@ -0,0 +1,131 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/RefTracker.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+#include "SUAPI-CppWrapper/model/Entities.hpp"
+#include "SUAPI-CppWrapper/model/Face.hpp"
+#include "SUAPI-CppWrapper/model/Model.hpp"
+#include "SUAPI-CppWrapper/model/TypedValue.hpp"
+
+namespace {
+
+size_t live_at_site(CW::RefKind kind, const char* site) {
+  for (const CW::RefSite& ref_site : CW::RefTracker::live_sites()) {
+    if (ref_site.kind == kind && std::string(ref_site.site) == site) {
+      return ref_site.live;
+    }
+  }
+  return 0;
+}
+
+std::vector<CW::Point3D> square() {
+  return {CW::Point3D(0.0, 0.0, 0.0), CW::Point3D(1.0, 0.0, 0.0), CW::Point3D(1.0, 1.0, 0.0), CW::Point3D(0.0, 1.0, 0.0)};
+}
+
+} // namespace
+
+TEST(RefTracker, counts_and_high_water)
+{
+  int objects[3];
+  const CW::RefCounts before = CW::RefTracker::counts(CW::RefKind::OtherEntity);
+  CW::RefTracker::reset_high_water();
+  for (int& object : objects) {
+    CW::RefTracker::acquired(CW::RefKind::OtherEntity, &object);
+  }
+  CW::RefTracker::released(CW::RefKind::OtherEntity, &objects[0]);
+  CW::RefTracker::released(CW::RefKind::OtherEntity, &objects[1]);
+
+  const CW::RefCounts after = CW::RefTracker::counts(CW::RefKind::OtherEntity);
+  EXPECT_EQ(before.acquired + 3, after.acquired);
+  EXPECT_EQ(before.released + 2, after.released);
+  EXPECT_EQ(before.live + 1, after.live);
+  EXPECT_EQ(before.live + 3, after.high_water);
+
+  CW::RefTracker::released(CW::RefKind::OtherEntity, &objects[2]);
+  CW::RefTracker::reset_high_water();
+  EXPECT_EQ(before.live, CW::RefTracker::counts(CW::RefKind::OtherEntity).high_water);
+  EXPECT_STREQ("OtherEntity", CW::RefTracker::kind_name(CW::RefKind::OtherEntity));
+  EXPECT_EQ(CW::RefKind::Face, CW::RefTracker::entity_kind(SURefType_Face));
+}
+
+
+TEST(RefTracker, counters_are_cache_line_aligned)
+{
+  for (size_t i = 0; i < static_cast<size_t>(CW::RefKind::NUM_KINDS); ++i) {
+    const void* counters = CW::RefTracker::counters_address(static_cast<CW::RefKind>(i));
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(counters) % 64) << CW::RefTracker::kind_name(static_cast<CW::RefKind>(i));
+  }
+}
+
+
+TEST(RefTracker, sites_record_live_objects)
+{
+  int objects[3];
+  CW::RefTracker::track_sites(true);
+  {
+    CW::RefTracker::Site outer("Test::outer");
+    CW::RefTracker::acquired(CW::RefKind::OtherEntity, &objects[0]);
+    {
+      CW::RefTracker::Site inner("Test::inner");
+      CW::RefTracker::acquired(CW::RefKind::OtherEntity, &objects[1]);
+      CW::RefTracker::acquired(CW::RefKind::OtherEntity, &objects[2]);
+    }
+  }
+  EXPECT_EQ(1, live_at_site(CW::RefKind::OtherEntity, "Test::outer"));
+  EXPECT_EQ(2, live_at_site(CW::RefKind::OtherEntity, "Test::inner"));
+
+  CW::RefTracker::released(CW::RefKind::OtherEntity, &objects[1]);
+  EXPECT_EQ(1, live_at_site(CW::RefKind::OtherEntity, "Test::inner"));
+  std::ostringstream report;
+  CW::RefTracker::write_report(report);
+  EXPECT_NE(std::string::npos, report.str().find("OtherEntity Test::inner 1"));
+
+  CW::RefTracker::released(CW::RefKind::OtherEntity, &objects[0]);
+  CW::RefTracker::released(CW::RefKind::OtherEntity, &objects[2]);
+  EXPECT_EQ(0, live_at_site(CW::RefKind::OtherEntity, "Test::outer"));
+  CW::RefTracker::track_sites(false);
+  EXPECT_TRUE(CW::RefTracker::live_sites().empty());
+}
+
+
+TEST(RefTracker, wrappers_balance_their_references)
+{
+  CW::initialize();
+  const int64_t strings = CW::RefTracker::live(CW::RefKind::String);
+  const int64_t typed_values = CW::RefTracker::live(CW::RefKind::TypedValue);
+  const int64_t faces = CW::RefTracker::live(CW::RefKind::Face);
+  {
+    CW::String string("tracked");
+    CW::String copy(string);
+    CW::TypedValue value("tracked");
+    EXPECT_EQ(strings + 2, CW::RefTracker::live(CW::RefKind::String));
+    EXPECT_EQ(typed_values + 1, CW::RefTracker::live(CW::RefKind::TypedValue));
+
+    std::vector<CW::Point3D> points = square();
+    CW::Face face(points);
+    CW::Face face_copy(face);
+    EXPECT_EQ(faces + 2, CW::RefTracker::live(CW::RefKind::Face));
+  }
+  EXPECT_EQ(strings, CW::RefTracker::live(CW::RefKind::String));
+  EXPECT_EQ(typed_values, CW::RefTracker::live(CW::RefKind::TypedValue));
+  EXPECT_EQ(faces, CW::RefTracker::live(CW::RefKind::Face));
+
+  // A face added to a model is owned by the model.
+  CW::Model model;
+  std::vector<CW::Point3D> points = square();
+  std::vector<CW::Face> new_faces;
+  new_faces.push_back(CW::Face(points));
+  EXPECT_EQ(faces + 1, CW::RefTracker::live(CW::RefKind::Face));
+  model.entities().add_faces(new_faces);
+  EXPECT_EQ(faces, CW::RefTracker::live(CW::RefKind::Face));
+}
@@ -3,8 +3,12 @@
 
 #include <SketchUpAPI/sketchup.h>
 
+#include <atomic>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "SUAPI-CppWrapper/Initialize.hpp"
 #include "SUAPI-CppWrapper/String.hpp"
 
 
@@ -26,3 +30,118 @@ TEST(String, std_string)
 
   ASSERT_STREQ(expected.c_str(), std_string.c_str());
 }
+
+TEST(String, empty)
+{
+  CW::String empty_string;
+  ASSERT_TRUE(empty_string.empty());
+  ASSERT_EQ(0, empty_string.size());
+  CW::String string("Hello");
+  ASSERT_FALSE(string.empty());
+}
+
+TEST(String, view_and_copy_utf8)
+{
+  CW::String string("Hello World");
+  const CW::StringBuffer buffer_view = string.view();
+  const CW::StringView view = buffer_view.view();
+  ASSERT_EQ(11, view.size);
+  ASSERT_TRUE(view == std::string("Hello World"));
+  ASSERT_EQ('\0', view.data[view.size]);
+
+  // Each view owns its characters, so holding two at once is safe, and so is a string too long to be held inline.
+  const std::string long_string(CW::StringBuffer::INLINE_SIZE * 2, 'a');
+  const CW::StringBuffer other_view = CW::String(long_string).view();
+  ASSERT_EQ("Hello World", buffer_view.str());
+  ASSERT_EQ(long_string, other_view.str());
+  ASSERT_EQ(0, CW::String().view().size());
+
+  char small[4] = {'x', 'x', 'x', 'x'};
+  ASSERT_EQ(11, string.copy_utf8(small, sizeof(small)));
+  ASSERT_EQ('x', small[0]);
+  char buffer[12];
+  ASSERT_EQ(11, string.copy_utf8(buffer, sizeof(buffer)));
+  ASSERT_STREQ("Hello World", buffer);
+
+  std::string out;
+  out.reserve(64);
+  const char* data = out.data();
+  string.std_string(out);
+  ASSERT_EQ("Hello World", out);
+  ASSERT_EQ(data, out.data());
+}
+
+TEST(String, equality_and_hash)
+{
+  CW::String a("Material1");
+  CW::String b(std::string("Material1"));
+  CW::String c("Material2");
+  ASSERT_TRUE(a == b);
+  ASSERT_TRUE(a != c);
+  ASSERT_EQ(a.hash(), b.hash());
+  ASSERT_NE(a.hash(), c.hash());
+  ASSERT_EQ(a.hash(), std::hash<CW::String>()(b));
+  CW::String copy(a);
+  ASSERT_TRUE(copy == a);
+  ASSERT_EQ(a.hash(), copy.hash());
+}
+
+TEST(String, cache_cleared_on_write)
+{
+  CW::String string("Short");
+  ASSERT_EQ(5, string.size());
+  size_t hash = string.hash();
+  SUStringRef* string_ref = string;
+  SU(SUStringSetUTF8(*string_ref, "A longer string"));
+  ASSERT_EQ(15, string.size());
+  ASSERT_NE(hash, string.hash());
+  ASSERT_EQ("A longer string", string.std_string());
+}
+
+
+TEST(String, const_string_shared_across_threads)
+{
+  CW::initialize();
+  const CW::String string("A string read from several threads at once");
+  const CW::String copy("A string read from several threads at once");
+  std::atomic<size_t> matches(0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back([&string, &copy, &matches]() {
+      for (size_t j = 0; j < 1000; ++j) {
+        if (string.size() == copy.size() && string.hash() == copy.hash() && string == copy && string.view().str() == copy.std_string()) {
+          ++matches;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(4000, matches.load());
+}
+
+
+TEST(String, default_and_moved_from_strings_are_empty)
+{
+  CW::initialize();
+  const CW::String empty_string;
+  ASSERT_EQ(0, empty_string.size());
+  ASSERT_TRUE(empty_string.empty());
+  ASSERT_EQ(0, empty_string.view().size());
+  ASSERT_EQ('\0', empty_string.view().data()[0]);
+
+  CW::String string("A string that is moved away");
+  CW::String moved(std::move(string));
+  ASSERT_EQ(0, string.size());
+  ASSERT_TRUE(string.empty());
+  ASSERT_EQ("", string.view().str());
+  ASSERT_EQ(27, moved.size());
+
+  CW::String assigned;
+  assigned = std::move(moved);
+  ASSERT_EQ(0, moved.size());
+  ASSERT_TRUE(moved.empty());
+  ASSERT_EQ("", moved.view().str());
+  ASSERT_EQ("A string that is moved away", assigned.view().str());
+}
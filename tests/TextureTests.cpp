@@ -0,0 +1,93 @@
+#include "SketchUpAPITests.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <SketchUpAPI/sketchup.h>
+
+#include "SUAPI-CppWrapper/Initialize.hpp"
+#include "SUAPI-CppWrapper/model/ImageRep.hpp"
+#include "SUAPI-CppWrapper/model/Material.hpp"
+#include "SUAPI-CppWrapper/model/Texture.hpp"
+#include "SUAPI-CppWrapper/String.hpp"
+
+
+namespace {
+
+CW::Texture make_texture(size_t width, size_t height) {
+  SUImageRepRef image_ref = SU_INVALID;
+  SU(SUImageRepCreate(&image_ref));
+  CW::ImageRep image(image_ref, false);
+  std::vector<SUByte> pixels(width * height * 4);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = SUByte(i * 7);
+  }
+  image.set_data(width, height, 32, 0, pixels);
+  return CW::Texture(image);
+}
+
+} // namespace
+
+
+TEST(Texture, copy_keeps_pixels_and_scale)
+{
+  CW::initialize();
+  CW::Texture texture = make_texture(8, 4);
+  CW::Texture copy = texture.copy();
+  ASSERT_FALSE(!copy);
+  EXPECT_NE(texture.ref().ptr, copy.ref().ptr);
+  EXPECT_EQ(texture.width(), copy.width());
+  EXPECT_EQ(texture.height(), copy.height());
+  EXPECT_DOUBLE_EQ(texture.s_scale(), copy.s_scale());
+  EXPECT_DOUBLE_EQ(texture.t_scale(), copy.t_scale());
+  EXPECT_EQ(texture.image_rep().data_size(), copy.image_rep().data_size());
+}
+
+
+TEST(Texture, copy_keeps_scale_of_scaled_texture)
+{
+  CW::initialize();
+  std::string file_path = ::testing::TempDir() + "scaled_texture.bmp";
+  ASSERT_EQ(SU_ERROR_NONE, make_texture(6, 3).image_rep().save_to_file(file_path));
+  CW::Texture texture(file_path, 0.5, 0.25);
+  std::remove(file_path.c_str());
+  ASSERT_FALSE(!texture);
+  ASSERT_DOUBLE_EQ(0.5, texture.s_scale());
+
+  CW::Texture copy = texture.copy();
+  ASSERT_FALSE(!copy);
+  EXPECT_NE(texture.ref().ptr, copy.ref().ptr);
+  EXPECT_EQ(6, copy.width());
+  EXPECT_EQ(3, copy.height());
+  EXPECT_DOUBLE_EQ(0.5, copy.s_scale());
+  EXPECT_DOUBLE_EQ(0.25, copy.t_scale());
+  EXPECT_EQ(texture.file_name().std_string(), copy.file_name().std_string());
+  CW::ImageRep original = texture.image_rep();
+  CW::ImageRep copied = copy.image_rep();
+  ASSERT_EQ(original.data_size(), copied.data_size());
+  EXPECT_EQ(original.pixel_data(), copied.pixel_data());
+}
+
+
+TEST(Texture, copy_textures_reuses_scratch_buffer)
+{
+  CW::initialize();
+  std::vector<CW::Material> materials;
+  materials.reserve(3);
+  for (size_t i = 0; i < 3; ++i) {
+    SUMaterialRef material_ref = SU_INVALID;
+    SU(SUMaterialCreate(&material_ref));
+    materials.emplace_back(material_ref, false);
+  }
+  materials[0].texture(make_texture(16, 16));
+  materials[2].texture(make_texture(2, 8));
+
+  std::vector<CW::Texture> copies = CW::Texture::copy_textures(materials);
+  ASSERT_EQ(3, copies.size());
+  EXPECT_EQ(16, copies[0].width());
+  EXPECT_TRUE(!copies[1]);
+  EXPECT_EQ(2, copies[2].width());
+  EXPECT_EQ(8, copies[2].height());
+}
@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Transformation.hpp"
+
+
+namespace {
+
+// Rotates 90 degrees about Z, scales Y by 2 and Z by 3, and translates by (10, 20, 30).
+CW::Transformation test_transformation()
+{
+  SUTransformation transformation = {
+    0.0, 1.0, 0.0, 0.0,
+    -2.0, 0.0, 0.0, 0.0,
+    0.0, 0.0, 3.0, 0.0,
+    10.0, 20.0, 30.0, 1.0
+  };
+  return CW::Transformation(transformation);
+}
+
+} // namespace
+
+
+TEST(Transformation, apply_points)
+{
+  CW::Transformation transformation = test_transformation();
+  std::vector<SUPoint3D> points;
+  for (size_t i = 0; i < 17; ++i) {
+    points.push_back(SUPoint3D{double(i), 1.0, 2.0});
+  }
+  std::vector<SUPoint3D> transformed(points.size());
+  transformation.apply(points.data(), transformed.data(), points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    ASSERT_DOUBLE_EQ(-2.0 * points[i].y + 10.0, transformed[i].x);
+    ASSERT_DOUBLE_EQ(points[i].x + 20.0, transformed[i].y);
+    ASSERT_DOUBLE_EQ(3.0 * points[i].z + 30.0, transformed[i].z);
+  }
+}
+
+TEST(Transformation, apply_points_in_place)
+{
+  CW::Transformation transformation = test_transformation();
+  std::vector<CW::Point3D> points = {CW::Point3D(1.0, 2.0, 3.0), CW::Point3D(0.0, 0.0, 0.0)};
+  transformation.apply(points);
+  ASSERT_TRUE(CW::Point3D(6.0, 21.0, 39.0) == points[0]);
+  ASSERT_TRUE(CW::Point3D(10.0, 20.0, 30.0) == points[1]);
+}
+
+TEST(Transformation, apply_vectors)
+{
+  CW::Transformation transformation = test_transformation();
+  std::vector<CW::Vector3D> vectors = {CW::Vector3D(1.0, 0.0, 0.0), CW::Vector3D(0.0, 1.0, 1.0)};
+  transformation.apply(vectors);
+  ASSERT_TRUE(CW::Vector3D(0.0, 1.0, 0.0) == vectors[0]);
+  ASSERT_TRUE(CW::Vector3D(-2.0, 0.0, 3.0) == vectors[1]);
+}
+
+TEST(Transformation, apply_normals)
+{
+  CW::Transformation transformation = test_transformation();
+  // The normal of a plane sloping in Y and Z must remain perpendicular to the plane after non-uniform scaling.
+  SUVector3D normal{0.0, 1.0, 1.0};
+  SUVector3D transformed;
+  transformation.apply_normals(&normal, &transformed, 1);
+  CW::Vector3D surface_vector(0.0, 1.0, -1.0);
+  std::vector<CW::Vector3D> surface_vectors = {surface_vector};
+  transformation.apply(surface_vectors);
+  ASSERT_NEAR(0.0, CW::Vector3D(transformed).dot(surface_vectors[0]), 1e-12);
+  ASSERT_NEAR(1.0, CW::Vector3D(transformed).length(), 1e-12);
+}
+
+TEST(Transformation, apply_matches_sdk_with_w_scale)
+{
+  // SketchUp holds a uniform scale in m[15], and perspective in m[3], m[7] and m[11].
+  SUTransformation scaled = test_transformation().ref();
+  scaled.values[15] = 0.5;
+  SUTransformation projective = scaled;
+  projective.values[3] = 0.25;
+  for (const SUTransformation& su_transformation : {scaled, projective}) {
+    CW::Transformation transformation(su_transformation);
+    std::vector<CW::Point3D> points;
+    std::vector<CW::Vector3D> vectors;
+    for (size_t i = 0; i < 9; ++i) {
+      points.push_back(CW::Point3D(double(i), 1.0, 2.0));
+      vectors.push_back(CW::Vector3D(double(i), 1.0, 2.0));
+    }
+    std::vector<CW::Point3D> transformed_points = points;
+    std::vector<CW::Vector3D> transformed_vectors = vectors;
+    transformation.apply(transformed_points);
+    transformation.apply(transformed_vectors);
+    for (size_t i = 0; i < points.size(); ++i) {
+      const CW::Point3D point = transformation * points[i];
+      const CW::Vector3D vector = transformation * vectors[i];
+      ASSERT_DOUBLE_EQ(point.x, transformed_points[i].x);
+      ASSERT_DOUBLE_EQ(point.y, transformed_points[i].y);
+      ASSERT_DOUBLE_EQ(point.z, transformed_points[i].z);
+      ASSERT_DOUBLE_EQ(vector.x, transformed_vectors[i].x);
+      ASSERT_DOUBLE_EQ(vector.y, transformed_vectors[i].y);
+      ASSERT_DOUBLE_EQ(vector.z, transformed_vectors[i].z);
+    }
+  }
+  // A scale of 0.5 in m[15] doubles the size.
+  std::vector<CW::Vector3D> unit = {CW::Vector3D(1.0, 0.0, 0.0)};
+  CW::Transformation(scaled).apply(unit);
+  ASSERT_DOUBLE_EQ(2.0, unit[0].y);
+}
+
+TEST(Transformation, apply_empty)
+{
+  CW::Transformation transformation = test_transformation();
+  std::vector<CW::Point3D> points;
+  transformation.apply(points);
+  ASSERT_TRUE(points.empty());
+}
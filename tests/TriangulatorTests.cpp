@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/Triangulator.hpp"
+
+
+namespace {
+
+/**
+* Returns the area of the triangles of polygon p of the mesh, counted negative for triangles wound clockwise around the normal.
+*/
+double signed_area(const CW::TriangleMesh& mesh, size_t p, const CW::Vector3D& normal) {
+  double area = 0.0;
+  for (size_t t = mesh.polygon_offsets[p]; t < mesh.polygon_offsets[p + 1]; ++t) {
+    CW::Point3D a(mesh.positions[mesh.indices[3 * t]]);
+    CW::Point3D b(mesh.positions[mesh.indices[3 * t + 1]]);
+    CW::Point3D c(mesh.positions[mesh.indices[3 * t + 2]]);
+    area += CW::Vector3D(b - a).cross(CW::Vector3D(c - a)).dot(normal) / 2.0;
+  }
+  return area;
+}
+
+std::vector<CW::Point3D> square(double x, double y, double size, bool clockwise = false) {
+  std::vector<CW::Point3D> points = {
+    CW::Point3D(x, y, 0.0),
+    CW::Point3D(x + size, y, 0.0),
+    CW::Point3D(x + size, y + size, 0.0),
+    CW::Point3D(x, y + size, 0.0)
+  };
+  if (clockwise) {
+    std::reverse(points.begin(), points.end());
+  }
+  return points;
+}
+
+} // namespace
+
+
+TEST(Triangulator, square)
+{
+  CW::Triangulator triangulator;
+  CW::TriangleMesh mesh;
+  const CW::Vector3D normal(0.0, 0.0, 1.0);
+  ASSERT_EQ(2, triangulator.triangulate({square(0.0, 0.0, 10.0)}, normal, mesh));
+  ASSERT_EQ(4, mesh.positions.size());
+  ASSERT_EQ(1, mesh.num_polygons());
+  ASSERT_DOUBLE_EQ(100.0, signed_area(mesh, 0, normal));
+}
+
+TEST(Triangulator, winding_follows_normal)
+{
+  CW::Triangulator triangulator;
+  CW::TriangleMesh mesh;
+  // The same loop, given either way round, is wound around the given normal.
+  triangulator.triangulate({square(0.0, 0.0, 10.0, true)}, CW::Vector3D(0.0, 0.0, 1.0), mesh);
+  triangulator.triangulate({square(0.0, 0.0, 10.0)}, CW::Vector3D(0.0, 0.0, -1.0), mesh);
+  ASSERT_EQ(2, mesh.num_polygons());
+  ASSERT_DOUBLE_EQ(100.0, signed_area(mesh, 0, CW::Vector3D(0.0, 0.0, 1.0)));
+  ASSERT_DOUBLE_EQ(100.0, signed_area(mesh, 1, CW::Vector3D(0.0, 0.0, -1.0)));
+}
+
+TEST(Triangulator, vertical_plane)
+{
+  CW::Triangulator triangulator;
+  CW::TriangleMesh mesh;
+  std::vector<CW::Point3D> loop = {
+    CW::Point3D(0.0, 5.0, 0.0),
+    CW::Point3D(4.0, 5.0, 0.0),
+    CW::Point3D(4.0, 5.0, 3.0),
+    CW::Point3D(0.0, 5.0, 3.0)
+  };
+  const CW::Vector3D normal(0.0, -1.0, 0.0);
+  ASSERT_EQ(2, triangulator.triangulate({loop}, normal, mesh));
+  ASSERT_DOUBLE_EQ(12.0, signed_area(mesh, 0, normal));
+}
+
+TEST(Triangulator, concave)
+{
+  CW::Triangulator triangulator;
+  CW::TriangleMesh mesh;
+  std::vector<CW::Point3D> l_shape = {
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(10.0, 0.0, 0.0),
+    CW::Point3D(10.0, 2.0, 0.0),
+    CW::Point3D(2.0, 2.0, 0.0),
+    CW::Point3D(2.0, 10.0, 0.0),
+    CW::Point3D(0.0, 10.0, 0.0)
+  };
+  const CW::Vector3D normal(0.0, 0.0, 1.0);
+  ASSERT_EQ(4, triangulator.triangulate({l_shape}, normal, mesh));
+  ASSERT_DOUBLE_EQ(36.0, signed_area(mesh, 0, normal));
+}
+
+TEST(Triangulator, holes)
+{
+  CW::Triangulator triangulator;
+  CW::TriangleMesh mesh;
+  const CW::Vector3D normal(0.0, 0.0, 1.0);
+  std::vector<std::vector<CW::Point3D>> loops = {
+    square(0.0, 0.0, 10.0),
+    square(2.0, 2.0, 2.0, true),
+    square(6.0, 6.0, 2.0)
+  };
+  // n points and h holes give n + 2h - 2 triangles.
+  ASSERT_EQ(14, triangulator.triangulate(loops, normal, mesh));
+  ASSERT_EQ(12, mesh.positions.size());
+  ASSERT_DOUBLE_EQ(92.0, signed_area(mesh, 0, normal));
+}
+
+TEST(Triangulator, flat_array_input)
+{
+  CW::Triangulator triangulator;
+  CW::TriangleMesh mesh;
+  const CW::Vector3D normal(0.0, 0.0, 1.0);
+  std::vector<SUPoint3D> points;
+  for (const CW::Point3D& point : square(0.0, 0.0, 1.0)) {
+    points.push_back(point);
+  }
+  for (const CW::Point3D& point : square(0.0, 0.0, 10.0)) {
+    points.push_back(point);
+  }
+  // The second loop alone, given by its offsets into the shared array.
+  std::vector<size_t> loop_offsets = {0, 4, 8};
+  ASSERT_EQ(2, triangulator.triangulate(points.data(), &loop_offsets[1], 1, normal, mesh));
+  ASSERT_EQ(4, mesh.positions.size());
+  ASSERT_DOUBLE_EQ(100.0, signed_area(mesh, 0, normal));
+}
+
+TEST(Triangulator, degenerate)
+{
+  CW::Triangulator triangulator;
+  CW::TriangleMesh mesh;
+  const CW::Vector3D normal(0.0, 0.0, 1.0);
+  std::vector<CW::Point3D> line = {
+    CW::Point3D(0.0, 0.0, 0.0),
+    CW::Point3D(1.0, 0.0, 0.0)
+  };
+  ASSERT_EQ(0, triangulator.triangulate({line}, normal, mesh));
+  ASSERT_EQ(1, mesh.num_polygons());
+  ASSERT_EQ(0, mesh.num_triangles());
+  mesh.clear();
+  ASSERT_EQ(0, mesh.num_polygons());
+}
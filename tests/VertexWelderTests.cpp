@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "SUAPI-CppWrapper/Geometry.hpp"
+#include "SUAPI-CppWrapper/VertexWelder.hpp"
+
+
+TEST(VertexWelder, welds_points_within_tolerance)
+{
+  CW::VertexWelder welder;
+  EXPECT_EQ(0, welder.weld(CW::Point3D(1.0, 2.0, 3.0), 0));
+  EXPECT_EQ(1, welder.weld(CW::Point3D(4.0, 5.0, 6.0), 1));
+  // Within tolerance on every axis, including across a cell boundary.
+  const double nudge = CW::Point3D::EPSILON * 0.9;
+  EXPECT_EQ(0, welder.weld(CW::Point3D(1.0 + nudge, 2.0 - nudge, 3.0 + nudge), 2));
+  EXPECT_EQ(1, welder.weld(CW::Point3D(4.0, 5.0, 6.0), 2));
+  // Outside the tolerance on one axis.
+  EXPECT_EQ(2, welder.weld(CW::Point3D(1.0, 2.0, 3.0 + CW::Point3D::EPSILON * 1.1), 2));
+  EXPECT_EQ(3, welder.size());
+  EXPECT_EQ(2, welder.duplicates());
+  EXPECT_EQ(CW::VertexWelder::NOT_FOUND, welder.find(CW::Point3D(10.0, 0.0, 0.0)));
+}
+
+
+TEST(VertexWelder, matches_point_equality)
+{
+  // Points on a jittered lattice: welding must agree with Point3D::operator== against the earliest match.
+  CW::VertexWelder welder;
+  std::vector<CW::Point3D> unique_points;
+  const double step = CW::Point3D::EPSILON * 0.37;
+  for (int i = 0; i < 2000; ++i) {
+    const CW::Point3D point(step * (i % 7), step * ((i / 7) % 5), -step * (i % 3) + 1.0e4);
+    size_t expected = unique_points.size();
+    for (size_t j = 0; j < unique_points.size(); ++j) {
+      if (unique_points[j] == point) {
+        expected = j;
+        break;
+      }
+    }
+    const size_t index = welder.weld(point, unique_points.size());
+    ASSERT_EQ(expected, index) << "point " << i;
+    if (index == unique_points.size()) {
+      unique_points.push_back(point);
+    }
+  }
+  EXPECT_EQ(unique_points.size(), welder.size());
+  EXPECT_EQ(2000 - unique_points.size(), welder.duplicates());
+}
+
+
+TEST(VertexWelder, skips_non_finite_points)
+{
+  CW::VertexWelder welder;
+  const double nan = std::nan("");
+  EXPECT_EQ(0, welder.weld(CW::Point3D(nan, 0.0, 0.0), 0));
+  EXPECT_EQ(1, welder.weld(CW::Point3D(nan, 0.0, 0.0), 1));
+  EXPECT_EQ(0, welder.size());
+  EXPECT_EQ(0, welder.duplicates());
+
+  welder.weld(CW::Point3D(0.0, 0.0, 0.0), 0);
+  welder.clear();
+  EXPECT_EQ(0, welder.size());
+  EXPECT_EQ(CW::VertexWelder::NOT_FOUND, welder.find(CW::Point3D(0.0, 0.0, 0.0)));
+  EXPECT_THROW(CW::VertexWelder(0.0), std::invalid_argument);
+}